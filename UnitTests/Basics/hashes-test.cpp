@@ -423,6 +423,101 @@ BOOST_AUTO_TEST_CASE (tst_crc32_utf8) {
   BOOST_CHECK_EQUAL((uint64_t) 2590070434ULL,   TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), buffer.c_str(), strlen(buffer.c_str()))));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test crc32c
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_simple) {
+  std::string buffer;
+
+  buffer = "";
+  BOOST_CHECK_EQUAL((uint64_t) 0ULL, TRI_FinalCrc32(TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = " ";
+  BOOST_CHECK_EQUAL((uint64_t) 1925242255ULL, TRI_FinalCrc32(TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "a";
+  BOOST_CHECK_EQUAL((uint64_t) 3251651376ULL, TRI_FinalCrc32(TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "123456789";
+  BOOST_CHECK_EQUAL((uint64_t) 3808858755ULL, TRI_FinalCrc32(TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "the quick brown fox jumped over the lazy dog";
+  BOOST_CHECK_EQUAL((uint64_t) 3928504206ULL, TRI_FinalCrc32(TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "The Quick Brown Fox Jumped Over The Lazy Dog";
+  BOOST_CHECK_EQUAL((uint64_t) 4053635637ULL, TRI_FinalCrc32(TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test crc32c with unaligned data and in multiple blocks
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_blocks) {
+  std::string buffer = "xThe Quick Brown Fox Jumped Over The Lazy Dog";
+  char const* data = buffer.c_str() + 1;
+  size_t const length = buffer.size() - 1;
+
+  for (size_t i = 0; i <= length; ++i) {
+    uint32_t crc = TRI_InitialCrc32();
+    crc = TRI_BlockCrc32C(crc, data, i);
+    crc = TRI_BlockCrc32C(crc, data + i, length - i);
+
+    BOOST_CHECK_EQUAL((uint64_t) 4053635637ULL, TRI_FinalCrc32(crc));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the software crc32c implementation
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_software) {
+  std::string buffer;
+
+  buffer = "";
+  BOOST_CHECK_EQUAL((uint64_t) 0ULL, TRI_FinalCrc32(TRI_SoftwareBlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = " ";
+  BOOST_CHECK_EQUAL((uint64_t) 1925242255ULL, TRI_FinalCrc32(TRI_SoftwareBlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "a";
+  BOOST_CHECK_EQUAL((uint64_t) 3251651376ULL, TRI_FinalCrc32(TRI_SoftwareBlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "123456789";
+  BOOST_CHECK_EQUAL((uint64_t) 3808858755ULL, TRI_FinalCrc32(TRI_SoftwareBlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "the quick brown fox jumped over the lazy dog";
+  BOOST_CHECK_EQUAL((uint64_t) 3928504206ULL, TRI_FinalCrc32(TRI_SoftwareBlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+  buffer = "The Quick Brown Fox Jumped Over The Lazy Dog";
+  BOOST_CHECK_EQUAL((uint64_t) 4053635637ULL, TRI_FinalCrc32(TRI_SoftwareBlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the software and the used crc32c implementations agree
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_software_matches) {
+  std::string buffer;
+
+  for (size_t i = 0; i < 1024; ++i) {
+    buffer.push_back(static_cast<char>((i * 7919) & 0xFF));
+  }
+
+  // all lengths and alignments up to a few words
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t length = 0; length < 64; ++length) {
+      char const* data = buffer.c_str() + offset;
+
+      BOOST_CHECK_EQUAL(TRI_SoftwareBlockCrc32C(TRI_InitialCrc32(), data, length),
+                        TRI_BlockCrc32C(TRI_InitialCrc32(), data, length));
+    }
+  }
+
+  BOOST_CHECK_EQUAL(TRI_SoftwareBlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size()),
+                    TRI_BlockCrc32C(TRI_InitialCrc32(), buffer.c_str(), buffer.size()));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -737,5 +737,209 @@ describe ArangoDB do
 
     end
 
+################################################################################
+## plan cache
+################################################################################
+
+    context "testing the plan cache:" do
+      before do
+        ArangoDB.delete("/_api/query-cache/plans")
+      end
+
+      it "testing plan cache figures" do
+        doc = ArangoDB.log_get("#{prefix}-plan-cache", "/_api/query-cache/plans")
+        doc.code.should eq(200)
+        doc.parsed_response['plans'].should be_kind_of(Integer)
+        doc.parsed_response['maxPlans'].should be_kind_of(Integer)
+        hits = doc.parsed_response['hits']
+        misses = doc.parsed_response['misses']
+
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..@max RETURN i\", \"bindVars\" : { \"max\" : 3 } }"
+        doc = ArangoDB.log_post("#{prefix}-plan-cache", cmd, :body => body)
+        doc.code.should eq(201)
+        doc.parsed_response['result'].should eq([ 1, 2, 3 ])
+
+        doc = ArangoDB.log_post("#{prefix}-plan-cache", cmd, :body => body)
+        doc.code.should eq(201)
+        doc.parsed_response['result'].should eq([ 1, 2, 3 ])
+
+        doc = ArangoDB.log_get("#{prefix}-plan-cache", "/_api/query-cache/plans")
+        doc.code.should eq(200)
+        doc.parsed_response['plans'].should be >= 1
+        doc.parsed_response['hits'].should be >= hits + 1
+        doc.parsed_response['misses'].should be >= misses + 1
+      end
+
+      it "testing plan cache with different bind values" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..@max RETURN i\", \"bindVars\" : { \"max\" : 3 } }"
+        doc = ArangoDB.log_post("#{prefix}-plan-cache", cmd, :body => body)
+        doc.code.should eq(201)
+        doc.parsed_response['result'].should eq([ 1, 2, 3 ])
+
+        body = "{ \"query\" : \"FOR i IN 1..@max RETURN i\", \"bindVars\" : { \"max\" : 2 } }"
+        doc = ArangoDB.log_post("#{prefix}-plan-cache", cmd, :body => body)
+        doc.code.should eq(201)
+        doc.parsed_response['result'].should eq([ 1, 2 ])
+        
+        doc = ArangoDB.log_get("#{prefix}-plan-cache", "/_api/query-cache/plans")
+        doc.code.should eq(200)
+        doc.parsed_response['plans'].should be >= 2
+      end
+
+      it "testing clearing the plan cache" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..5 RETURN i\" }"
+        doc = ArangoDB.log_post("#{prefix}-plan-cache", cmd, :body => body)
+        doc.code.should eq(201)
+
+        doc = ArangoDB.log_get("#{prefix}-plan-cache", "/_api/query-cache/plans")
+        doc.parsed_response['plans'].should be >= 1
+
+        doc = ArangoDB.log_delete("#{prefix}-plan-cache", "/_api/query-cache/plans")
+        doc.code.should eq(200)
+
+        doc = ArangoDB.log_get("#{prefix}-plan-cache", "/_api/query-cache/plans")
+        doc.parsed_response['plans'].should eq(0)
+      end
+
+    end
+
+################################################################################
+## streaming cursors
+################################################################################
+
+    context "testing streaming cursors:" do
+      it "returns a small result in a single batch" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..5 RETURN i\", \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-stream-single", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(201)
+        doc.parsed_response['id'].should be_nil
+        doc.parsed_response['hasMore'].should eq(false)
+        doc.parsed_response['count'].should be_nil
+        doc.parsed_response['cached'].should eq(false)
+        doc.parsed_response['result'].should eq([ 1, 2, 3, 4, 5 ])
+        doc.parsed_response['extra']['stats'].should be_kind_of(Hash)
+        doc.parsed_response['extra']['warnings'].should eq([ ])
+      end
+
+      it "returns a big result in multiple batches" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..2500 RETURN i\", \"batchSize\" : 1000, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-stream-batches", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(201)
+        doc.parsed_response['id'].should be_kind_of(String)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].length.should eq(1000)
+        doc.parsed_response['result'][0].should eq(1)
+        doc.parsed_response['extra'].should be_nil
+
+        id = doc.parsed_response['id']
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_put("#{prefix}-stream-batches", cmd)
+
+        doc.code.should eq(200)
+        doc.parsed_response['id'].should eq(id)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].length.should eq(1000)
+        doc.parsed_response['result'][0].should eq(1001)
+        doc.parsed_response['extra'].should be_nil
+
+        doc = ArangoDB.log_put("#{prefix}-stream-batches", cmd)
+
+        doc.code.should eq(200)
+        doc.parsed_response['id'].should be_nil
+        doc.parsed_response['hasMore'].should eq(false)
+        doc.parsed_response['result'].length.should eq(500)
+        doc.parsed_response['result'][499].should eq(2500)
+        doc.parsed_response['extra']['stats'].should be_kind_of(Hash)
+
+        doc = ArangoDB.log_put("#{prefix}-stream-batches", cmd)
+
+        doc.code.should eq(404)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1600)
+      end
+
+      it "deletes a streaming cursor" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..2500 RETURN i\", \"batchSize\" : 100, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-stream-delete", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['hasMore'].should eq(true)
+
+        id = doc.parsed_response['id']
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_delete("#{prefix}-stream-delete", cmd)
+
+        doc.code.should eq(202)
+        doc.parsed_response['error'].should eq(false)
+
+        doc = ArangoDB.log_put("#{prefix}-stream-delete", cmd)
+        doc.code.should eq(404)
+      end
+
+      it "returns an error for an invalid streaming query" do
+        cmd = api
+        body = "{ \"query\" : \"FOR u IN nonExistingCollection RETURN u\", \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-stream-error", cmd, :body => body)
+
+        doc.code.should eq(404)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1203)
+      end
+
+      it "keeps a streaming cursor usable and collects it after its ttl" do
+        cmd = api
+        body = "{ \"query\" : \"FOR i IN 1..2500 RETURN i\", \"batchSize\" : 10, \"ttl\" : 2, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-stream-ttl", cmd, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].length.should eq(10)
+
+        id = doc.parsed_response['id']
+        cmd = api + "/#{id}"
+
+        # the cursor buffers the rest of the first block produced by the query.
+        # accessing it extends its lifetime
+        3.times do |i|
+          sleep 1
+          doc = ArangoDB.log_put("#{prefix}-stream-ttl", cmd)
+
+          doc.code.should eq(200)
+          doc.parsed_response['hasMore'].should eq(true)
+          doc.parsed_response['result'].length.should eq(10)
+          doc.parsed_response['result'][0].should eq((i + 1) * 10 + 1)
+        end
+
+        sleep 6 # this should delete the cursor and its query on the server
+
+        doc = ArangoDB.log_put("#{prefix}-stream-ttl", cmd)
+        doc.code.should eq(404)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1600)
+
+        # the server must still be able to run streaming queries
+        body = "{ \"query\" : \"FOR i IN 1..5 RETURN i\", \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-stream-ttl", api, :body => body)
+
+        doc.code.should eq(201)
+        doc.parsed_response['result'].should eq([ 1, 2, 3, 4, 5 ])
+      end
+    end
+
   end
 end
@@ -0,0 +1,389 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, incremental aggregate functions for COLLECT
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/Aggregator.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+#include "Basics/json-utilities.h"
+#include "Utils/AqlTransaction.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private classes
+// -----------------------------------------------------------------------------
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a number can be added to a sum
+////////////////////////////////////////////////////////////////////////////////
+
+  inline bool IsValidNumber (double number) {
+    return (! std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL);
+  }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief LENGTH, counts the group members
+////////////////////////////////////////////////////////////////////////////////
+
+  class AggregatorLength : public Aggregator {
+    public:
+
+      AggregatorLength (triagens::arango::AqlTransaction* trx,
+                        Query* query)
+        : Aggregator(trx, query),
+          _count(0) {
+      }
+
+      char const* name () const override final {
+        return "LENGTH";
+      }
+
+      void reset () override final {
+        _count = 0;
+      }
+
+      void reduce (AqlValue const&,
+                   TRI_document_collection_t const*) override final {
+        ++_count;
+      }
+
+      AqlValue stealValue () override final {
+        uint64_t const count = _count;
+        reset();
+        return AqlValue(new Json(static_cast<double>(count)));
+      }
+
+    private:
+
+      uint64_t _count;
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief MIN and MAX, keep a copy of the smallest / largest non-null value
+////////////////////////////////////////////////////////////////////////////////
+
+  class AggregatorMinMax : public Aggregator {
+    public:
+
+      AggregatorMinMax (triagens::arango::AqlTransaction* trx,
+                        Query* query,
+                        bool isMin)
+        : Aggregator(trx, query),
+          _value(nullptr),
+          _isMin(isMin) {
+      }
+
+      ~AggregatorMinMax () {
+        reset();
+      }
+
+      char const* name () const override final {
+        return _isMin ? "MIN" : "MAX";
+      }
+
+      void reset () override final {
+        if (_value != nullptr) {
+          TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _value);
+          _value = nullptr;
+        }
+      }
+
+      void reduce (AqlValue const& value,
+                   TRI_document_collection_t const* document) override final {
+        Json json(value.toJson(_trx, document, false));
+        TRI_json_t const* current = json.json();
+
+        if (current == nullptr || TRI_IsNullJson(current)) {
+          return;
+        }
+
+        if (_value != nullptr) {
+          int const cmp = TRI_CompareValuesJson(current, _value);
+
+          if ((_isMin && cmp >= 0) || (! _isMin && cmp <= 0)) {
+            return;
+          }
+        }
+
+        TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, current);
+
+        if (copy == nullptr) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+        }
+
+        reset();
+        _value = copy;
+      }
+
+      AqlValue stealValue () override final {
+        if (_value == nullptr) {
+          return AqlValue(new Json(Json::Null));
+        }
+
+        auto result = new Json(TRI_UNKNOWN_MEM_ZONE, _value);
+        _value = nullptr;
+        return AqlValue(result);
+      }
+
+    private:
+
+      TRI_json_t* _value;
+
+      bool const _isMin;
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief SUM and AVERAGE, ignore null values and produce null if any other
+/// non-numeric value is found
+////////////////////////////////////////////////////////////////////////////////
+
+  class AggregatorSum : public Aggregator {
+    public:
+
+      AggregatorSum (triagens::arango::AqlTransaction* trx,
+                     Query* query,
+                     bool isAverage)
+        : Aggregator(trx, query),
+          _sum(0.0),
+          _count(0),
+          _invalid(false),
+          _isAverage(isAverage) {
+      }
+
+      char const* name () const override final {
+        return _isAverage ? "AVERAGE" : "SUM";
+      }
+
+      void reset () override final {
+        _sum = 0.0;
+        _count = 0;
+        _invalid = false;
+      }
+
+      void reduce (AqlValue const& value,
+                   TRI_document_collection_t const* document) override final {
+        if (_invalid) {
+          return;
+        }
+
+        Json json(value.toJson(_trx, document, false));
+        TRI_json_t const* current = json.json();
+
+        if (current == nullptr || TRI_IsNullJson(current)) {
+          return;
+        }
+
+        if (! TRI_IsNumberJson(current)) {
+          registerInvalidArgumentWarning();
+          _invalid = true;
+          return;
+        }
+
+        double const number = current->_value._number;
+
+        if (IsValidNumber(number)) {
+          _sum += number;
+          ++_count;
+        }
+      }
+
+      AqlValue stealValue () override final {
+        bool const valid = (! _invalid && 
+                            (! _isAverage || _count > 0) &&
+                            IsValidNumber(_sum));
+        double const result = (_isAverage && valid) ? _sum / static_cast<double>(_count) : _sum;
+
+        reset();
+
+        if (! valid) {
+          return AqlValue(new Json(Json::Null));
+        }
+        return AqlValue(new Json(result));
+      }
+
+    private:
+
+      double _sum;
+
+      uint64_t _count;
+
+      bool _invalid;
+
+      bool const _isAverage;
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief COUNT_DISTINCT, counts the distinct values of the group members.
+/// this is the equivalent of LENGTH(UNIQUE(...)) and needs memory for each
+/// distinct value
+////////////////////////////////////////////////////////////////////////////////
+
+  class AggregatorCountDistinct : public Aggregator {
+    public:
+
+      AggregatorCountDistinct (triagens::arango::AqlTransaction* trx,
+                               Query* query)
+        : Aggregator(trx, query),
+          _seen(512, triagens::basics::JsonHash(), triagens::basics::JsonEqual()) {
+      }
+
+      ~AggregatorCountDistinct () {
+        reset();
+      }
+
+      char const* name () const override final {
+        return "COUNT_DISTINCT";
+      }
+
+      void reset () override final {
+        for (auto& it : _seen) {
+          TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, const_cast<TRI_json_t*>(it));
+        }
+        _seen.clear();
+      }
+
+      void reduce (AqlValue const& value,
+                   TRI_document_collection_t const* document) override final {
+        Json json(value.toJson(_trx, document, false));
+        TRI_json_t const* current = json.json();
+
+        if (current == nullptr || _seen.find(current) != _seen.end()) {
+          return;
+        }
+
+        TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, current);
+
+        if (copy == nullptr) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+        }
+
+        try {
+          _seen.emplace(copy);
+        }
+        catch (...) {
+          TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, copy);
+          throw;
+        }
+      }
+
+      AqlValue stealValue () override final {
+        size_t const count = _seen.size();
+        reset();
+        return AqlValue(new Json(static_cast<double>(count)));
+      }
+
+    private:
+
+      std::unordered_set<TRI_json_t const*, triagens::basics::JsonHash, triagens::basics::JsonEqual> _seen;
+  };
+
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an aggregator from its type name
+////////////////////////////////////////////////////////////////////////////////
+
+Aggregator* Aggregator::fromTypeString (triagens::arango::AqlTransaction* trx,
+                                        Query* query,
+                                        std::string const& type) {
+  if (type == "LENGTH") {
+    return new AggregatorLength(trx, query);
+  }
+  if (type == "MIN") {
+    return new AggregatorMinMax(trx, query, true);
+  }
+  if (type == "MAX") {
+    return new AggregatorMinMax(trx, query, false);
+  }
+  if (type == "SUM") {
+    return new AggregatorSum(trx, query, false);
+  }
+  if (type == "AVERAGE") {
+    return new AggregatorSum(trx, query, true);
+  }
+  if (type == "COUNT_DISTINCT") {
+    return new AggregatorCountDistinct(trx, query);
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid aggregator type");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an aggregator type name is known
+////////////////////////////////////////////////////////////////////////////////
+
+bool Aggregator::isSupported (std::string const& type) {
+  return (type == "LENGTH" ||
+          type == "MIN" ||
+          type == "MAX" ||
+          type == "SUM" ||
+          type == "AVERAGE" ||
+          type == "COUNT_DISTINCT");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an aggregator type needs an input value per row
+////////////////////////////////////////////////////////////////////////////////
+
+bool Aggregator::requiresInput (std::string const& type) {
+  return (type != "LENGTH");
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 protected methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register an invalid argument warning for the aggregate function
+////////////////////////////////////////////////////////////////////////////////
+
+void Aggregator::registerInvalidArgumentWarning () const {
+  if (_query == nullptr) {
+    return;
+  }
+
+  std::string const msg = triagens::basics::Exception::FillExceptionString(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, name());
+  _query->registerWarning(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, msg.c_str());
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, incremental aggregate functions for COLLECT
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_AGGREGATOR_H
+#define ARANGODB_AQL_AGGREGATOR_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+
+struct TRI_document_collection_t;
+
+namespace triagens {
+  namespace arango {
+    class AqlTransaction;
+  }
+
+  namespace aql {
+
+    class Query;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  class Aggregator
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief an aggregate function that is computed incrementally for the rows
+/// of a COLLECT group, so that the group members need not be materialized
+////////////////////////////////////////////////////////////////////////////////
+
+    class Aggregator {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        Aggregator (triagens::arango::AqlTransaction* trx,
+                    Query* query)
+          : _trx(trx),
+            _query(query) {
+        }
+
+        virtual ~Aggregator () {
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief name of the aggregate function
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual char const* name () const = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reset the aggregator for a new group
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual void reset () = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add the value of one group member
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual void reduce (AqlValue const&,
+                             TRI_document_collection_t const*) = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the result for the current group and reset the aggregator.
+/// the caller takes over ownership of the returned value
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual AqlValue stealValue () = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an aggregator from its type name
+////////////////////////////////////////////////////////////////////////////////
+
+        static Aggregator* fromTypeString (triagens::arango::AqlTransaction*,
+                                           Query*,
+                                           std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an aggregator type name is known
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool isSupported (std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an aggregator type needs an input value per row.
+/// LENGTH only counts the group members
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool requiresInput (std::string const&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 protected methods
+// -----------------------------------------------------------------------------
+
+      protected:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register an invalid argument warning for the aggregate function,
+/// using the same message as the AQL function of the same name
+////////////////////////////////////////////////////////////////////////////////
+
+        void registerInvalidArgumentWarning () const;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               protected variables
+// -----------------------------------------------------------------------------
+
+      protected:
+
+        triagens::arango::AqlTransaction* _trx;
+
+        Query* _query;
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -45,10 +45,14 @@ using JsonHelper = triagens::basics::JsonHelper;
 /// @brief create the block
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlItemBlock::AqlItemBlock (size_t nrItems, 
+AqlItemBlock::AqlItemBlock (ResourceMonitor* resourceMonitor,
+                            size_t nrItems, 
                             RegisterId nrRegs)
   : _nrItems(nrItems),  
-    _nrRegs(nrRegs) {
+    _nrRegs(nrRegs),
+    _resourceMonitor(resourceMonitor),
+    _chargedMemory(0),
+    _chargedValueMemory(0) {
 
   TRI_ASSERT(nrItems > 0);  // no, empty AqlItemBlocks are not allowed!
 
@@ -64,13 +68,20 @@ AqlItemBlock::AqlItemBlock (size_t nrItems,
       _docColls.emplace_back(nullptr);
     }
   }
+
+  chargeRegisters();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create the block from Json, note that this can throw
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlItemBlock::AqlItemBlock (Json const& json) {
+AqlItemBlock::AqlItemBlock (ResourceMonitor* resourceMonitor,
+                            Json const& json) 
+  : _resourceMonitor(resourceMonitor),
+    _chargedMemory(0),
+    _chargedValueMemory(0) {
+
   bool exhausted = JsonHelper::getBooleanValue(json.json(), "exhausted", false);
 
   if (exhausted) {
@@ -93,6 +104,8 @@ AqlItemBlock::AqlItemBlock (Json const& json) {
     }
   }
 
+  chargeRegisters();
+
   // Now put in the data:
   Json data(json.get("data"));
   Json raw(json.get("raw"));
@@ -178,6 +191,7 @@ AqlItemBlock::AqlItemBlock (Json const& json) {
 
 void AqlItemBlock::destroy () {
   if (_valueCount.empty()) {
+    releaseValueMemory();
     return;
   }
 
@@ -208,12 +222,31 @@ void AqlItemBlock::destroy () {
   }
 
   _valueCount.clear();
+  releaseValueMemory();
 }
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    public methods
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of bytes occupied by the block and the values
+/// it is responsible for. values that occur multiple times in the block are
+/// counted only once
+////////////////////////////////////////////////////////////////////////////////
+
+size_t AqlItemBlock::memoryUsage () const {
+  size_t total = sizeof(AqlItemBlock) + 
+                 _data.capacity() * sizeof(AqlValue) + 
+                 _docColls.capacity() * sizeof(TRI_document_collection_t const*);
+
+  for (auto const& it : _valueCount) {
+    total += it.first.memoryUsage();
+  }
+
+  return total;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief shrink the block to the specified number of rows
 ////////////////////////////////////////////////////////////////////////////////
@@ -243,6 +276,7 @@ void AqlItemBlock::shrink (size_t nrItems) {
           TRI_ASSERT_EXPENSIVE(it->second > 0);
 
           if (--it->second == 0) {
+            releaseValue(a);
             a.destroy();
             try {
               _valueCount.erase(it);
@@ -277,6 +311,7 @@ void AqlItemBlock::clearRegisters (std::unordered_set<RegisterId> const& toClear
           TRI_ASSERT_EXPENSIVE(it->second > 0);
 
           if (--it->second == 0) {
+            releaseValue(a);
             a.destroy();
             try {
               _valueCount.erase(it);
@@ -303,7 +338,7 @@ AqlItemBlock* AqlItemBlock::slice (size_t from,
   std::unordered_map<AqlValue, AqlValue> cache;
   cache.reserve((to - from) * _nrRegs / 4 + 1);
 
-  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(to - from, _nrRegs));
+  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(_resourceMonitor, to - from, _nrRegs));
 
   for (RegisterId col = 0; col < _nrRegs; col++) {
     res->_docColls[col] = _docColls[col];
@@ -345,7 +380,7 @@ AqlItemBlock* AqlItemBlock::slice (size_t row,
                                    std::unordered_set<RegisterId> const& registers) const {
   std::unordered_map<AqlValue, AqlValue> cache;
 
-  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(1, _nrRegs));
+  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(_resourceMonitor, 1, _nrRegs));
 
   for (RegisterId col = 0; col < _nrRegs; col++) {
     if (registers.find(col) == registers.end()) {
@@ -392,7 +427,7 @@ AqlItemBlock* AqlItemBlock::slice (std::vector<size_t>& chosen,
   std::unordered_map<AqlValue, AqlValue> cache;
   cache.reserve((to - from) * _nrRegs / 4 + 1);
 
-  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(to - from, _nrRegs));
+  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(_resourceMonitor, to - from, _nrRegs));
 
   for (RegisterId col = 0; col < _nrRegs; col++) {
     res->_docColls[col] = _docColls[col];
@@ -440,7 +475,7 @@ AqlItemBlock* AqlItemBlock::steal (std::vector<size_t>& chosen,
                                    size_t to) {
   TRI_ASSERT(from < to && to <= chosen.size());
 
-  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(to - from, _nrRegs));
+  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(_resourceMonitor, to - from, _nrRegs));
 
   for (RegisterId col = 0; col < _nrRegs; col++) {
     res->_docColls[col] = _docColls[col];
@@ -491,7 +526,7 @@ AqlItemBlock* AqlItemBlock::concatenate (std::vector<AqlItemBlock*> const& block
   TRI_ASSERT(totalSize > 0);
   TRI_ASSERT(nrRegs > 0);
 
-  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(totalSize, nrRegs));
+  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(blocks[0]->_resourceMonitor, totalSize, nrRegs));
 
   size_t pos = 0;
   for (it = blocks.begin(); it != blocks.end(); ++it) {
@@ -616,6 +651,28 @@ Json AqlItemBlock::toJson (triagens::arango::AqlTransaction* trx) const {
   return json;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief charge the memory for the registers to the resource monitor
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlItemBlock::chargeRegisters () {
+  if (_resourceMonitor == nullptr) {
+    return;
+  }
+
+  size_t const size = sizeof(AqlItemBlock) + 
+                      _data.capacity() * sizeof(AqlValue) + 
+                      _docColls.capacity() * sizeof(TRI_document_collection_t const*);
+
+  // if this throws, nothing has been charged
+  _resourceMonitor->increaseMemoryUsage(size);
+  _chargedMemory = size;
+}
+
 // Local Variables:
 // mode: outline-minor
 // outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
@@ -32,6 +32,7 @@
 #include "Basics/JsonHelper.h"
 #include "Aql/AqlValue.h"
 #include "Aql/Range.h"
+#include "Aql/ResourceUsage.h"
 #include "Aql/types.h"
 #include "VocBase/document-collection.h"
 
@@ -59,6 +60,12 @@ namespace triagens {
 // copies. Furthermore, when parts of an AqlItemBlock are handed on
 // to another AqlItemBlock, then the <AqlValue>s inside must be copied
 // (deep copy) to make the blocks independent.
+//
+// An AqlItemBlock charges the memory for its registers and for the
+// <AqlValue>s it is responsible for to the <ResourceMonitor> of its query.
+// The memory for a value is released again as soon as the block is no
+// longer responsible for it, i.e. when it is destroyed, stolen or erased
+// for the last time.
 
     class AqlItemBlock {
 
@@ -71,13 +78,16 @@ namespace triagens {
       public:
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief create the block
+/// @brief create the block. the memory used by the block is charged to the
+/// resource monitor, which may be a nullptr if nothing is to be accounted
 ////////////////////////////////////////////////////////////////////////////////
 
-        AqlItemBlock (size_t nrItems, 
+        AqlItemBlock (ResourceMonitor*,
+                      size_t nrItems, 
                       RegisterId nrRegs);
 
-        AqlItemBlock (triagens::basics::Json const& json);
+        AqlItemBlock (ResourceMonitor*,
+                      triagens::basics::Json const& json);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the block
@@ -85,6 +95,10 @@ namespace triagens {
 
         ~AqlItemBlock () {
           destroy();
+
+          if (_chargedMemory > 0) {
+            _resourceMonitor->decreaseMemoryUsage(_chargedMemory);
+          }
         }
 
       private:
@@ -131,6 +145,11 @@ namespace triagens {
             TRI_IF_FAILURE("AqlItemBlock::setValue") {
               THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
             }
+            if (_resourceMonitor != nullptr) {
+              size_t const size = value.ownMemoryUsage();
+              _resourceMonitor->increaseMemoryUsage(size);
+              _chargedValueMemory += size;
+            }
             _valueCount.emplace(value, 1);
           }
           else {
@@ -174,6 +193,7 @@ namespace triagens {
               if (--(it->second) == 0) {
                 try {
                   _valueCount.erase(it);
+                  releaseValue(element);
                   element.destroy();
                   return; // no need for an extra element.erase() in this case
                 }
@@ -200,6 +220,7 @@ namespace triagens {
 
             if (it != _valueCount.end()) {
               if (--(it->second) == 0) {
+                releaseValue(element);
                 try {
                   _valueCount.erase(it);
                 }
@@ -225,6 +246,7 @@ namespace triagens {
           }
 
           _valueCount.clear();
+          releaseValueMemory();
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -253,6 +275,7 @@ namespace triagens {
             auto it = _valueCount.find(v);
 
             if (it != _valueCount.end()) {
+              releaseValue(v);
               _valueCount.erase(it);
             }
           }
@@ -298,6 +321,21 @@ namespace triagens {
           return _docColls;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the resource monitor the block charges its memory to
+////////////////////////////////////////////////////////////////////////////////
+
+        inline ResourceMonitor* resourceMonitor () const {
+          return _resourceMonitor;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of bytes occupied by the block and the values
+/// it is responsible for
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t memoryUsage () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief shrink the block to the specified number of rows
 ////////////////////////////////////////////////////////////////////////////////
@@ -360,6 +398,43 @@ namespace triagens {
 
         triagens::basics::Json toJson (triagens::arango::AqlTransaction* trx) const;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief charge the memory for the registers to the resource monitor
+////////////////////////////////////////////////////////////////////////////////
+
+        void chargeRegisters ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release the memory charged for a value the block is no longer
+/// responsible for
+////////////////////////////////////////////////////////////////////////////////
+
+        void releaseValue (AqlValue const& value) {
+          if (_chargedValueMemory > 0) {
+            size_t const size = std::min(value.ownMemoryUsage(), _chargedValueMemory);
+            _resourceMonitor->decreaseMemoryUsage(size);
+            _chargedValueMemory -= size;
+          }
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release the memory charged for values, called when the block is
+/// no longer responsible for any of its values
+////////////////////////////////////////////////////////////////////////////////
+
+        void releaseValueMemory () {
+          if (_chargedValueMemory > 0) {
+            _resourceMonitor->decreaseMemoryUsage(_chargedValueMemory);
+            _chargedValueMemory = 0;
+          }
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -403,6 +478,25 @@ namespace triagens {
 
         RegisterId _nrRegs;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the resource monitor of the query, may be a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceMonitor* _resourceMonitor;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of bytes charged for the registers
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _chargedMemory;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of bytes charged for the values the block is or was
+/// responsible for
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _chargedValueMemory;
+
     };
 
   }  // namespace triagens::aql
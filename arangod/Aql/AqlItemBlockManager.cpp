@@ -37,11 +37,13 @@ using namespace triagens::aql;
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief create the manager
+/// @brief create the manager, the blocks it creates charge their memory
+/// to the resource monitor
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlItemBlockManager::AqlItemBlockManager ()
-  : _last(nullptr) {
+AqlItemBlockManager::AqlItemBlockManager (ResourceMonitor* resourceMonitor)
+  : _last(nullptr),
+    _resourceMonitor(resourceMonitor) {
 
 }
 
@@ -71,7 +73,7 @@ AqlItemBlock* AqlItemBlockManager::requestBlock (size_t nrItems,
     return block;
   }
 
-  return new AqlItemBlock(nrItems, nrRegs);
+  return new AqlItemBlock(_resourceMonitor, nrItems, nrRegs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -37,6 +37,7 @@ namespace triagens {
   namespace aql {
 
     class AqlItemBlock;
+    class ResourceMonitor;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                         class AqlItemBlockManager
@@ -51,10 +52,11 @@ namespace triagens {
       public:
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief create the manager
+/// @brief create the manager, the blocks it creates charge their memory
+/// to the resource monitor
 ////////////////////////////////////////////////////////////////////////////////
 
-        AqlItemBlockManager ();
+        explicit AqlItemBlockManager (ResourceMonitor*);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the manager
@@ -94,6 +96,12 @@ namespace triagens {
 
         AqlItemBlock* _last;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the resource monitor of the query
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceMonitor* _resourceMonitor;
+
     };
 
   }
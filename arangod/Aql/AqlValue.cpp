@@ -27,6 +27,7 @@
 
 #include "Aql/AqlValue.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/JsonArena.h"
 #include "Basics/json-utilities.h"
 #include "V8/v8-conv.h"
 #include "V8Server/v8-wrapshapedjson.h"
@@ -75,7 +76,12 @@ bool AqlValue::isTrue () const {
 void AqlValue::destroy () {
   switch (_type) {
     case JSON: {
-      delete _json;
+      if (_fromArena) {
+        JsonArena::release(_json);
+      }
+      else {
+        delete _json;
+      }
       _json = nullptr;
       break;
     }
@@ -106,6 +112,8 @@ void AqlValue::destroy () {
  
   // to avoid double freeing     
   _type = EMPTY;
+  _fromArena = false;
+  _memoryUsage = UnknownMemoryUsage;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -136,7 +144,10 @@ std::string AqlValue::getTypeString () const {
 AqlValue AqlValue::clone () const {
   switch (_type) {
     case JSON: {
-      return AqlValue(new Json(_json->copy()));
+      AqlValue result(new Json(_json->copy()));
+      // the copy is as large as the original, so keep the estimate
+      result._memoryUsage = _memoryUsage;
+      return result;
     }
 
     case SHAPED: {
@@ -186,6 +197,75 @@ AqlValue AqlValue::shallowClone () const {
   return clone();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of bytes occupied by the value's payload
+/// SHAPED values point into the datafiles, but are estimated with the size of
+/// their marker because they are materialized when a sort spills them
+////////////////////////////////////////////////////////////////////////////////
+
+size_t AqlValue::memoryUsage () const {
+  switch (_type) {
+    case JSON: {
+      return ownMemoryUsage();
+    }
+
+    case DOCVEC: {
+      size_t total = sizeof(std::vector<AqlItemBlock*>);
+      for (auto const& it : *_vector) {
+        total += it->memoryUsage();
+      }
+      return total;
+    }
+
+    case RANGE: {
+      return sizeof(Range);
+    }
+
+    case SHAPED: {
+      return static_cast<size_t>(_marker->_size);
+    }
+
+    case EMPTY: {
+      return 0;
+    }
+  }
+
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of bytes occupied by the value's payload,
+/// without the AqlItemBlocks of a DOCVEC, which account for themselves
+////////////////////////////////////////////////////////////////////////////////
+
+size_t AqlValue::ownMemoryUsage () const {
+  switch (_type) {
+    case JSON: {
+      if (_memoryUsage == UnknownMemoryUsage) {
+        size_t const size = sizeof(Json) + TRI_MemoryUsageJson(_json->json());
+        _memoryUsage = static_cast<uint32_t>((std::min)(size, static_cast<size_t>(UnknownMemoryUsage - 1)));
+      }
+      return static_cast<size_t>(_memoryUsage);
+    }
+
+    case DOCVEC: {
+      return sizeof(std::vector<AqlItemBlock*>) + 
+             _vector->capacity() * sizeof(AqlItemBlock*);
+    }
+
+    case RANGE: {
+      return sizeof(Range);
+    }
+
+    case SHAPED:
+    case EMPTY: {
+      return 0;
+    }
+  }
+
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not the AqlValue contains a string value
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,7 +62,7 @@ namespace triagens {
 /// @brief AqlValueType, indicates what sort of value we have
 ////////////////////////////////////////////////////////////////////////////////
 
-      enum AqlValueType {
+      enum AqlValueType : uint8_t {
         EMPTY,     // contains no data
         JSON,      // Json*
         SHAPED,    // TRI_df_marker_t*
@@ -81,27 +81,37 @@ namespace triagens {
 
       AqlValue () 
         : _json(nullptr), 
-          _type(EMPTY) {
+          _type(EMPTY),
+          _fromArena(false),
+          _memoryUsage(UnknownMemoryUsage) {
       }
 
       explicit AqlValue (triagens::basics::Json* json)
         : _json(json), 
-          _type(JSON) {
+          _type(JSON),
+          _fromArena(false),
+          _memoryUsage(UnknownMemoryUsage) {
       }
       
       explicit AqlValue (TRI_df_marker_t const* marker)
         : _marker(marker), 
-          _type(SHAPED) {
+          _type(SHAPED),
+          _fromArena(false),
+          _memoryUsage(UnknownMemoryUsage) {
       }
       
       explicit AqlValue (std::vector<AqlItemBlock*>* vector)
         : _vector(vector), 
-          _type(DOCVEC) {
+          _type(DOCVEC),
+          _fromArena(false),
+          _memoryUsage(UnknownMemoryUsage) {
       }
 
       AqlValue (int64_t low, int64_t high) 
         : _range(nullptr),
-          _type(RANGE) {
+          _type(RANGE),
+          _fromArena(false),
+          _memoryUsage(UnknownMemoryUsage) {
         _range = new Range(low, high);
       }
 
@@ -198,6 +208,8 @@ namespace triagens {
       inline void erase () throw() {
         _type = EMPTY;
         _json = nullptr;
+        _fromArena = false;
+        _memoryUsage = UnknownMemoryUsage;
       }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -224,6 +236,20 @@ namespace triagens {
 
       AqlValue shallowClone () const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of bytes occupied by the value's payload
+////////////////////////////////////////////////////////////////////////////////
+
+      size_t memoryUsage () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of bytes occupied by the value's payload,
+/// without the AqlItemBlocks of a DOCVEC, which account for themselves.
+/// the estimate for a JSON value is computed once and then kept in the value
+////////////////////////////////////////////////////////////////////////////////
+
+      size_t ownMemoryUsage () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not the AqlValue contains a string value
 ////////////////////////////////////////////////////////////////////////////////
@@ -404,6 +430,28 @@ namespace triagens {
 
       AqlValueType _type;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the Json handle of a JSON value was created by a query's
+/// JsonArena and must be given back to it instead of being deleted
+////////////////////////////////////////////////////////////////////////////////
+
+      bool _fromArena;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the estimated memory usage of a JSON value, or UnknownMemoryUsage
+/// if it was not computed yet. copies of the value carry the estimate along,
+/// so the Json is walked only once, not every time the value is stored in or
+/// released from an AqlItemBlock
+////////////////////////////////////////////////////////////////////////////////
+
+      mutable uint32_t _memoryUsage;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marker for a memory usage that was not computed yet
+////////////////////////////////////////////////////////////////////////////////
+
+      static uint32_t const UnknownMemoryUsage = UINT32_MAX;
+
     };
 
   } //closes namespace triagens::aql
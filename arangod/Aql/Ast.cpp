@@ -34,6 +34,7 @@
 #include "Basics/tri-strings.h"
 #include "Basics/Exceptions.h"
 #include "VocBase/collection.h"
+#include "VocBase/edge-collection.h"
 
 using namespace triagens::aql;
 
@@ -120,7 +121,8 @@ Ast::Ast (Query* query)
     _root(nullptr),
     _queries(),
     _writeCollection(nullptr),
-    _functionsMayAccessDocuments(false) {
+    _functionsMayAccessDocuments(false),
+    _bindParameterValues(nullptr) {
 
   TRI_ASSERT(_query != nullptr);
 
@@ -240,6 +242,74 @@ AstNode* Ast::createNodeFor (char const* variableName,
   return node;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST traversal node
+/// the graph info node is an array containing the direction, the start vertex,
+/// the edge collection and the options of the traversal. the edge and path
+/// variable names are optional
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::createNodeTraversal (char const* vertexVariableName,
+                                   char const* edgeVariableName,
+                                   char const* pathVariableName,
+                                   AstNode const* depth,
+                                   AstNode const* graphInfo) {
+  if (vertexVariableName == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  TRI_ASSERT(graphInfo != nullptr);
+  TRI_ASSERT(graphInfo->type == NODE_TYPE_ARRAY);
+  TRI_ASSERT(graphInfo->numMembers() == 4);
+
+  AstNode* node = createNode(NODE_TYPE_TRAVERSAL);
+
+  node->addMember(depth);
+  // direction, start vertex, edge collection, options
+  for (size_t i = 0; i < 4; ++i) {
+    node->addMember(graphInfo->getMember(i));
+  }
+
+  node->addMember(createNodeVariable(vertexVariableName, true));
+
+  if (edgeVariableName != nullptr) {
+    node->addMember(createNodeVariable(edgeVariableName, true));
+
+    if (pathVariableName != nullptr) {
+      node->addMember(createNodeVariable(pathVariableName, true));
+    }
+  }
+
+  // the traversal will read vertex documents from collections that are
+  // not known in advance
+  _functionsMayAccessDocuments = true;
+
+  return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST value node for a traversal direction, returns a
+/// nullptr if the direction name is invalid
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::createNodeTraversalDirection (char const* name) {
+  if (name == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  if (TRI_CaseEqualString(name, "OUTBOUND")) {
+    return createNodeValueInt(static_cast<int64_t>(TRI_EDGE_OUT));
+  }
+  if (TRI_CaseEqualString(name, "INBOUND")) {
+    return createNodeValueInt(static_cast<int64_t>(TRI_EDGE_IN));
+  }
+  if (TRI_CaseEqualString(name, "ANY")) {
+    return createNodeValueInt(static_cast<int64_t>(TRI_EDGE_ANY));
+  }
+
+  return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an AST let node, without an IF condition
 ////////////////////////////////////////////////////////////////////////////////
@@ -1091,11 +1161,90 @@ AstNode* Ast::createNodeNop () {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief injects bind parameters into the AST
+/// if a set is passed, value bind parameters are kept as parameter nodes
+/// unless their values are needed to build the execution plan. the names of
+/// the bind parameters injected nevertheless are added to the set
 ////////////////////////////////////////////////////////////////////////////////
 
-void Ast::injectBindParameters (BindParameters& parameters) {
+void Ast::injectBindParameters (BindParameters& parameters,
+                                std::unordered_set<std::string>* injected) {
   auto p = parameters();
 
+  // sub-trees whose values are read when the execution plan is built
+  std::unordered_set<AstNode const*> planSubtrees;
+  int planDepth = 0;
+
+  // examples are turned into one condition per attribute, which requires
+  // knowing whether an attribute value is an object
+  std::function<void(AstNode const*)> addExampleValues = [&] (AstNode const* value) -> void {
+    if (value->type == NODE_TYPE_PARAMETER) {
+      planSubtrees.emplace(value);
+    }
+    else if (value->type == NODE_TYPE_OBJECT) {
+      size_t const n = value->numMembers();
+
+      for (size_t i = 0; i < n; ++i) {
+        auto member = value->getMember(i);
+
+        if (member->type == NODE_TYPE_OBJECT_ELEMENT) {
+          addExampleValues(member->getMember(0));
+        }
+      }
+    }
+  };
+
+  auto preVisitor = [&](AstNode const* node, void*) -> bool {
+    if (injected == nullptr) {
+      return true;
+    }
+
+    switch (node->type) {
+      case NODE_TYPE_LIMIT:
+        planSubtrees.emplace(node);
+        break;
+      case NODE_TYPE_EXAMPLE:
+        addExampleValues(node->getMember(0));
+        break;
+      case NODE_TYPE_SORT_ELEMENT:
+      case NODE_TYPE_BOUND_ATTRIBUTE_ACCESS:
+        // sort direction or attribute name
+        planSubtrees.emplace(node->getMember(1));
+        break;
+      case NODE_TYPE_TRAVERSAL:
+        // everything but the start vertex
+        planSubtrees.emplace(node->getMember(0));
+        planSubtrees.emplace(node->getMember(1));
+        planSubtrees.emplace(node->getMember(3));
+        planSubtrees.emplace(node->getMember(4));
+        break;
+      case NODE_TYPE_REMOVE:
+      case NODE_TYPE_INSERT:
+      case NODE_TYPE_UPDATE:
+      case NODE_TYPE_REPLACE:
+      case NODE_TYPE_UPSERT:
+      case NODE_TYPE_COLLECT:
+      case NODE_TYPE_COLLECT_COUNT:
+      case NODE_TYPE_COLLECT_EXPRESSION:
+        // options
+        planSubtrees.emplace(node->getMember(0));
+        break;
+      default:
+        break;
+    }
+
+    if (planSubtrees.find(node) != planSubtrees.end()) {
+      ++planDepth;
+    }
+    return true;
+  };
+
+  auto postVisitor = [&](AstNode const* node, void*) -> void {
+    if (injected != nullptr && 
+        planSubtrees.find(node) != planSubtrees.end()) {
+      --planDepth;
+    }
+  };
+
   auto func = [&](AstNode* node, void*) -> AstNode* {
     if (node->type == NODE_TYPE_PARAMETER) {
       // found a bind parameter in the query string
@@ -1139,25 +1288,15 @@ void Ast::injectBindParameters (BindParameters& parameters) {
           _writeCollection = node;
         }
       }
-      else {
-        node = nodeFromJson(value, false);
-
-        if (node != nullptr) {
-          // already mark node as constant here
-          node->setFlag(DETERMINED_CONSTANT, VALUE_CONSTANT);
-          // mark node as simple
-          node->setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
-          // mark node as executable on db-server
-          node->setFlag(DETERMINED_RUNONDBSERVER, VALUE_RUNONDBSERVER);
-          // mark node as non-throwing
-          node->setFlag(DETERMINED_THROWS);
-          // mark node as deterministic
-          node->setFlag(DETERMINED_NONDETERMINISTIC);
-          
-          // finally note that the node was created from a bind parameter
-          node->setFlag(FLAG_BIND_PARAMETER);
+      else if (injected == nullptr || planDepth > 0) {
+        node = nodeFromBindParameter(value);
+
+        if (injected != nullptr) {
+          injected->emplace(param);
         }
       }
+      // else: keep the parameter node. its value is put in when the plan
+      // is instanciated from JSON
     }
 
     else if (node->type == NODE_TYPE_BOUND_ATTRIBUTE_ACCESS) {
@@ -1177,7 +1316,7 @@ void Ast::injectBindParameters (BindParameters& parameters) {
     return node;
   };
 
-  _root = traverseAndModify(_root, func, &p); 
+  _root = traverseAndModify(_root, preVisitor, func, postVisitor, &p); 
   
   if (_writeCollection != nullptr &&
       _writeCollection->type == NODE_TYPE_COLLECTION) {
@@ -1192,6 +1331,31 @@ void Ast::injectBindParameters (BindParameters& parameters) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST node from its JSON representation in an execution
+/// plan. parameter nodes are replaced with the bind parameter values if
+/// these have been set
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::nodeFromPlanJson (triagens::basics::Json const& json) {
+  if (_bindParameterValues != nullptr &&
+      AstNode::getNodeTypeFromJson(json) == NODE_TYPE_PARAMETER) {
+    std::string const name = triagens::basics::JsonHelper::checkAndGetStringValue(json.json(), "name");
+
+    auto const& p = (*_bindParameterValues)();
+    auto it = p.find(name);
+
+    if (it == p.end()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_BIND_PARAMETER_MISSING, name.c_str());
+    }
+
+    return nodeFromBindParameter((*it).second.first);
+  }
+
+  // ast will remember the node and delete it
+  return new AstNode(this, json);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief replace variables
 ////////////////////////////////////////////////////////////////////////////////
@@ -2444,6 +2608,34 @@ AstNode* Ast::nodeFromJson (TRI_json_t const* json,
   return createNodeValueNull();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST node from a bind parameter value
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::nodeFromBindParameter (TRI_json_t const* value) {
+  // bind parameter values live as long as the query, so string values do not
+  // need to be copied
+  AstNode* node = nodeFromJson(value, false);
+
+  if (node != nullptr) {
+    // already mark node as constant here
+    node->setFlag(DETERMINED_CONSTANT, VALUE_CONSTANT);
+    // mark node as simple
+    node->setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
+    // mark node as executable on db-server
+    node->setFlag(DETERMINED_RUNONDBSERVER, VALUE_RUNONDBSERVER);
+    // mark node as non-throwing
+    node->setFlag(DETERMINED_THROWS);
+    // mark node as deterministic
+    node->setFlag(DETERMINED_NONDETERMINISTIC);
+    
+    // finally note that the node was created from a bind parameter
+    node->setFlag(FLAG_BIND_PARAMETER);
+  }
+
+  return node;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief traverse the AST, using pre- and post-order visitors
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,6 +242,23 @@ namespace triagens {
                                 AstNode const*,
                                 bool = false);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST traversal node
+////////////////////////////////////////////////////////////////////////////////
+
+        AstNode* createNodeTraversal (char const*,
+                                      char const*,
+                                      char const*,
+                                      AstNode const*,
+                                      AstNode const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST value node for a traversal direction, returns a
+/// nullptr if the direction name is invalid
+////////////////////////////////////////////////////////////////////////////////
+
+        AstNode* createNodeTraversalDirection (char const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an AST let node, without an IF condition
 ////////////////////////////////////////////////////////////////////////////////
@@ -561,9 +578,30 @@ namespace triagens {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief injects bind parameters into the AST
+/// if a set is passed, value bind parameters are kept as parameter nodes
+/// unless their values are needed to build the execution plan. the names of
+/// the bind parameters injected nevertheless are added to the set
 ////////////////////////////////////////////////////////////////////////////////
 
-        void injectBindParameters (BindParameters&);
+        void injectBindParameters (BindParameters&,
+                                   std::unordered_set<std::string>* = nullptr);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the bind parameters whose values replace the parameter nodes
+/// found when instanciating nodes from JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        void setBindParameterValues (BindParameters* parameters) {
+          _bindParameterValues = parameters;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST node from its JSON representation in an execution
+/// plan. parameter nodes are replaced with the bind parameter values if
+/// these have been set
+////////////////////////////////////////////////////////////////////////////////
+
+        AstNode* nodeFromPlanJson (triagens::basics::Json const&);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief replace variables
@@ -732,6 +770,12 @@ namespace triagens {
         AstNode* nodeFromJson (TRI_json_t const*,
                                bool);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST node from a bind parameter value
+////////////////////////////////////////////////////////////////////////////////
+
+        AstNode* nodeFromBindParameter (TRI_json_t const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief traverse the AST, using pre- and post-order visitors
 ////////////////////////////////////////////////////////////////////////////////
@@ -852,6 +896,12 @@ namespace triagens {
 
         bool                               _functionsMayAccessDocuments;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bind parameter values used when instanciating a cached plan
+////////////////////////////////////////////////////////////////////////////////
+
+        BindParameters*                    _bindParameterValues;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief a singleton no-op node instance
 ////////////////////////////////////////////////////////////////////////////////
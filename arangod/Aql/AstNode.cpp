@@ -148,7 +148,8 @@ std::unordered_map<int, std::string const> const AstNode::TypeNames{
   { static_cast<int>(NODE_TYPE_CALCULATED_OBJECT_ELEMENT),"calculated object element" },
   { static_cast<int>(NODE_TYPE_EXAMPLE),                  "example" },
   { static_cast<int>(NODE_TYPE_PASSTHRU),                 "passthru" },
-  { static_cast<int>(NODE_TYPE_ARRAY_LIMIT),              "array limit" }
+  { static_cast<int>(NODE_TYPE_ARRAY_LIMIT),              "array limit" },
+  { static_cast<int>(NODE_TYPE_TRAVERSAL),                "traversal" }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -569,6 +570,7 @@ AstNode::AstNode (Ast* ast,
     case NODE_TYPE_EXAMPLE:
     case NODE_TYPE_PASSTHRU:
     case NODE_TYPE_ARRAY_LIMIT:
+    case NODE_TYPE_TRAVERSAL:
       break;
   }
 
@@ -578,7 +580,7 @@ AstNode::AstNode (Ast* ast,
     size_t const len = subNodes.size();
     for (size_t i = 0; i < len; i++) {
       Json subNode(subNodes.at(static_cast<int>(i)));
-      addMember(new AstNode(ast, subNode));
+      addMember(ast->nodeFromPlanJson(subNode));
     }
   }
 
@@ -1565,6 +1567,12 @@ bool AstNode::isCacheable () const {
     return false;
   }
 
+  if (type == NODE_TYPE_TRAVERSAL) {
+    // the vertex collections of a traversal are only known at runtime, so
+    // the query result cannot be invalidated properly
+    return false;
+  }
+
   // everything else is cacheable
   return true;
 }
@@ -29,6 +29,7 @@
 
 #include "AttributeAccessor.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/JsonArena.h"
 #include "Aql/Variable.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/json.h"
@@ -36,7 +37,6 @@
 #include "VocBase/document-collection.h"
 
 using namespace triagens::aql;
-using Json = triagens::basics::Json;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                        constructors / destructors
@@ -47,10 +47,12 @@ using Json = triagens::basics::Json;
 ////////////////////////////////////////////////////////////////////////////////
 
 AttributeAccessor::AttributeAccessor (std::vector<char const*> const& attributeParts,
-                                      Variable const* variable)
+                                      Variable const* variable,
+                                      JsonArena* jsonArena)
   : _attributeParts(attributeParts),
     _combinedName(),
     _variable(variable),
+    _jsonArena(jsonArena),
     _buffer(TRI_UNKNOWN_MEM_ZONE),
     _shaper(nullptr),
     _pid(0),
@@ -58,6 +60,7 @@ AttributeAccessor::AttributeAccessor (std::vector<char const*> const& attributeP
     _attributeType(ATTRIBUTE_TYPE_REGULAR) {
 
   TRI_ASSERT(_variable != nullptr);
+  TRI_ASSERT(_jsonArena != nullptr);
 
   if (_attributeParts.size() == 1) {
     char const* n = _attributeParts[0];
@@ -120,7 +123,8 @@ AqlValue AttributeAccessor::get (triagens::arango::AqlTransaction* trx,
       if (result.isShaped()) {
         switch (_attributeType) {
           case ATTRIBUTE_TYPE_KEY: {
-            return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, TRI_EXTRACT_MARKER_KEY(result._marker)));
+            char const* key = TRI_EXTRACT_MARKER_KEY(result._marker);
+            return _jsonArena->createString(key, strlen(key));
           }
 
           case ATTRIBUTE_TYPE_REV: {
@@ -165,15 +169,7 @@ AqlValue AttributeAccessor::get (triagens::arango::AqlTransaction* trx,
 
           if (i == n) {
             // reached the end
-            std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json));
-            
-            if (copy == nullptr) {
-              THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-            }
-
-            auto result = new Json(TRI_UNKNOWN_MEM_ZONE, copy.get());
-            copy.release();
-            return AqlValue(result);
+            return _jsonArena->createCopy(json);
           }
         }
 
@@ -185,7 +181,7 @@ AqlValue AttributeAccessor::get (triagens::arango::AqlTransaction* trx,
     // fall-through intentional
   }
   
-  return AqlValue(new Json(Json::Null));
+  return _jsonArena->createNull();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -196,9 +192,7 @@ AqlValue AttributeAccessor::extractRev (AqlValue const& src) {
   _buffer.reset();
   _buffer.appendInteger(TRI_EXTRACT_MARKER_RID(src._marker));
 
-  auto json = new Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
-
-  return AqlValue(json);
+  return _jsonArena->createString(_buffer.c_str(), _buffer.length());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -217,9 +211,7 @@ AqlValue AttributeAccessor::extractId (AqlValue const& src,
   _buffer.appendChar('/');
   _buffer.appendText(TRI_EXTRACT_MARKER_KEY(src._marker));
 
-  auto json = new Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
-
-  return AqlValue(json);
+  return _jsonArena->createString(_buffer.c_str(), _buffer.length());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -230,7 +222,7 @@ AqlValue AttributeAccessor::extractFrom (AqlValue const& src,
                                          triagens::arango::AqlTransaction* trx) {
   if (src._marker->_type != TRI_DOC_MARKER_KEY_EDGE &&
       src._marker->_type != TRI_WAL_MARKER_EDGE) {
-    return AqlValue(new Json(Json::Null));
+    return _jsonArena->createNull();
   }
   
   auto cid = TRI_EXTRACT_MARKER_FROM_CID(src._marker);
@@ -245,9 +237,7 @@ AqlValue AttributeAccessor::extractFrom (AqlValue const& src,
   _buffer.appendChar('/');
   _buffer.appendText(TRI_EXTRACT_MARKER_FROM_KEY(src._marker));
   
-  auto json = new Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
-
-  return AqlValue(json);
+  return _jsonArena->createString(_buffer.c_str(), _buffer.length());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -258,7 +248,7 @@ AqlValue AttributeAccessor::extractTo (AqlValue const& src,
                                        triagens::arango::AqlTransaction* trx) {
   if (src._marker->_type != TRI_DOC_MARKER_KEY_EDGE &&
       src._marker->_type != TRI_WAL_MARKER_EDGE) {
-    return AqlValue(new Json(Json::Null));
+    return _jsonArena->createNull();
   }
 
   auto cid = TRI_EXTRACT_MARKER_TO_CID(src._marker);
@@ -273,9 +263,7 @@ AqlValue AttributeAccessor::extractTo (AqlValue const& src,
   _buffer.appendChar('/');
   _buffer.appendText(TRI_EXTRACT_MARKER_TO_KEY(src._marker));
   
-  auto json = new Json(TRI_UNKNOWN_MEM_ZONE, _buffer.c_str(), _buffer.length());
-
-  return AqlValue(json);
+  return _jsonArena->createString(_buffer.c_str(), _buffer.length());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -309,13 +297,11 @@ AqlValue AttributeAccessor::extractRegular (AqlValue const& src,
         THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
       }
 
-      auto j = new Json(TRI_UNKNOWN_MEM_ZONE, extracted.get());
-      extracted.release();
-      return AqlValue(j);
+      return _jsonArena->createOwned(extracted.release());
     }
   }
     
-  return AqlValue(new Json(Json::Null));
+  return _jsonArena->createNull();
 }
 
 // -----------------------------------------------------------------------------
@@ -41,6 +41,7 @@ namespace triagens {
   namespace aql {
 
     class AqlItemBlock;
+    class JsonArena;
     struct Variable;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -69,7 +70,8 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
       
         AttributeAccessor (std::vector<char const*> const&,
-                           Variable const*);
+                           Variable const*,
+                           JsonArena*);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destructor
@@ -91,6 +93,14 @@ namespace triagens {
                       std::vector<Variable*> const&,
                       std::vector<RegisterId> const&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the arena the accessor creates its results from
+////////////////////////////////////////////////////////////////////////////////
+
+        void setJsonArena (JsonArena* jsonArena) {
+          _jsonArena = jsonArena;
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -157,6 +167,12 @@ namespace triagens {
 
         Variable const* _variable;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the query's arena, the accessor creates its results from it
+////////////////////////////////////////////////////////////////////////////////
+
+        JsonArena* _jsonArena;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief buffer for temporary strings
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,657 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, binary transfer format for item blocks
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/BinaryBlockFormat.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionStats.h"
+#include "Basics/Exceptions.h"
+#include "Basics/StringBuffer.h"
+#include "Utils/AqlTransaction.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+using StringBuffer = triagens::basics::StringBuffer;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private classes
+// -----------------------------------------------------------------------------
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief format version
+////////////////////////////////////////////////////////////////////////////////
+
+  uint8_t const FormatVersion = 2;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief value tags
+////////////////////////////////////////////////////////////////////////////////
+
+  enum ValueTag : uint8_t {
+    ValueEmpty    = 0,
+    ValueEmptyRun = 1,
+    ValueRange    = 2,
+    ValueJson     = 3,
+    ValueRepeated = 4
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief JSON tags
+////////////////////////////////////////////////////////////////////////////////
+
+  enum JsonTag : uint8_t {
+    JsonNull   = 0,
+    JsonFalse  = 1,
+    JsonTrue   = 2,
+    JsonNumber = 3,
+    JsonString = 4,
+    JsonArray  = 5,
+    JsonObject = 6
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief appends binary data to a string buffer
+////////////////////////////////////////////////////////////////////////////////
+
+  class BinaryWriter {
+
+    public:
+
+      explicit BinaryWriter (StringBuffer& buffer)
+        : _buffer(buffer) {
+      }
+
+      void appendByte (uint8_t value) {
+        _buffer.appendChar(static_cast<char>(value));
+      }
+
+      void appendUInt32 (uint32_t value) {
+        char data[4];
+        for (size_t i = 0; i < 4; ++i) {
+          data[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+        _buffer.appendText(data, sizeof(data));
+      }
+
+      void appendUInt64 (uint64_t value) {
+        char data[8];
+        for (size_t i = 0; i < 8; ++i) {
+          data[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+        _buffer.appendText(data, sizeof(data));
+      }
+
+      void appendInt64 (int64_t value) {
+        appendUInt64(static_cast<uint64_t>(value));
+      }
+
+      void appendDouble (double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        appendUInt64(bits);
+      }
+
+      void appendString (char const* value, size_t length) {
+        if (length > UINT32_MAX) {
+          THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "string too long for binary AQL block");
+        }
+        appendUInt32(static_cast<uint32_t>(length));
+        _buffer.appendText(value, length);
+      }
+
+      void appendJson (TRI_json_t const* json) {
+        if (json == nullptr) {
+          appendByte(JsonNull);
+          return;
+        }
+
+        switch (json->_type) {
+          case TRI_JSON_UNUSED:
+          case TRI_JSON_NULL: {
+            appendByte(JsonNull);
+            break;
+          }
+
+          case TRI_JSON_BOOLEAN: {
+            appendByte(json->_value._boolean ? JsonTrue : JsonFalse);
+            break;
+          }
+
+          case TRI_JSON_NUMBER: {
+            appendByte(JsonNumber);
+            appendDouble(json->_value._number);
+            break;
+          }
+
+          case TRI_JSON_STRING:
+          case TRI_JSON_STRING_REFERENCE: {
+            appendByte(JsonString);
+            // the stored length includes the terminating NUL byte
+            appendString(json->_value._string.data, json->_value._string.length - 1);
+            break;
+          }
+
+          case TRI_JSON_ARRAY: {
+            size_t const n = TRI_LengthVector(&json->_value._objects);
+            appendByte(JsonArray);
+            appendUInt32(static_cast<uint32_t>(n));
+
+            for (size_t i = 0; i < n; ++i) {
+              appendJson(static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i)));
+            }
+            break;
+          }
+
+          case TRI_JSON_OBJECT: {
+            size_t const n = TRI_LengthVector(&json->_value._objects);
+            TRI_ASSERT(n % 2 == 0);
+            appendByte(JsonObject);
+            appendUInt32(static_cast<uint32_t>(n / 2));
+
+            for (size_t i = 0; i < n; i += 2) {
+              auto name = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+              TRI_ASSERT(TRI_IsStringJson(name));
+              appendString(name->_value._string.data, name->_value._string.length - 1);
+              appendJson(static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i + 1)));
+            }
+            break;
+          }
+        }
+      }
+
+    private:
+
+      StringBuffer& _buffer;
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads binary data, checking the bounds
+////////////////////////////////////////////////////////////////////////////////
+
+  class BinaryReader {
+
+    public:
+
+      BinaryReader (char const* data,
+                    size_t length)
+        : _position(data),
+          _end(data + length) {
+      }
+
+      void expect (size_t length) const {
+        if (static_cast<size_t>(_end - _position) < length) {
+          invalid();
+        }
+      }
+
+      uint8_t readByte () {
+        expect(1);
+        return static_cast<uint8_t>(*_position++);
+      }
+
+      uint32_t readUInt32 () {
+        expect(4);
+        uint32_t value = 0;
+        for (size_t i = 0; i < 4; ++i) {
+          value |= static_cast<uint32_t>(static_cast<uint8_t>(_position[i])) << (8 * i);
+        }
+        _position += 4;
+        return value;
+      }
+
+      uint64_t readUInt64 () {
+        expect(8);
+        uint64_t value = 0;
+        for (size_t i = 0; i < 8; ++i) {
+          value |= static_cast<uint64_t>(static_cast<uint8_t>(_position[i])) << (8 * i);
+        }
+        _position += 8;
+        return value;
+      }
+
+      int64_t readInt64 () {
+        return static_cast<int64_t>(readUInt64());
+      }
+
+      double readDouble () {
+        uint64_t bits = readUInt64();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+
+      char const* readString (size_t& length) {
+        length = readUInt32();
+        expect(length);
+        char const* value = _position;
+        _position += length;
+        return value;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read a JSON value into <result>, which must be initialized. if
+/// this throws, <result> is still valid and can be freed
+////////////////////////////////////////////////////////////////////////////////
+
+      void readJson (TRI_json_t* result) {
+        switch (readByte()) {
+          case JsonNull: {
+            TRI_InitNullJson(result);
+            break;
+          }
+
+          case JsonFalse: {
+            TRI_InitBooleanJson(result, false);
+            break;
+          }
+
+          case JsonTrue: {
+            TRI_InitBooleanJson(result, true);
+            break;
+          }
+
+          case JsonNumber: {
+            TRI_InitNumberJson(result, readDouble());
+            break;
+          }
+
+          case JsonString: {
+            size_t length;
+            char const* value = readString(length);
+
+            if (TRI_InitStringCopyJson(TRI_UNKNOWN_MEM_ZONE, result, value, length) != TRI_ERROR_NO_ERROR) {
+              THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+            }
+            break;
+          }
+
+          case JsonArray: {
+            size_t const n = readUInt32();
+            // each member needs at least one byte
+            expect(n);
+            TRI_InitArrayJson(TRI_UNKNOWN_MEM_ZONE, result, n);
+
+            for (size_t i = 0; i < n; ++i) {
+              readMember(result);
+            }
+            break;
+          }
+
+          case JsonObject: {
+            size_t const n = readUInt32();
+            // each attribute needs at least five bytes
+            expect(n * 5);
+            TRI_InitObjectJson(TRI_UNKNOWN_MEM_ZONE, result, 2 * n);
+
+            for (size_t i = 0; i < n; ++i) {
+              auto name = nextMember(result);
+              size_t length;
+              char const* value = readString(length);
+
+              if (TRI_InitStringCopyJson(TRI_UNKNOWN_MEM_ZONE, name, value, length) != TRI_ERROR_NO_ERROR) {
+                THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+              }
+
+              readMember(result);
+            }
+            break;
+          }
+
+          default: {
+            invalid();
+            break;
+          }
+        }
+      }
+
+      bool atEnd () const {
+        return _position == _end;
+      }
+
+      static void invalid () {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_AQL_COMMUNICATION, "invalid binary AQL block received");
+      }
+
+    private:
+
+      TRI_json_t* nextMember (TRI_json_t* parent) {
+        auto member = static_cast<TRI_json_t*>(TRI_NextVector(&parent->_value._objects));
+
+        if (member == nullptr) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+        }
+
+        TRI_InitNullJson(member);
+        return member;
+      }
+
+      void readMember (TRI_json_t* parent) {
+        readJson(nextMember(parent));
+      }
+
+      char const* _position;
+
+      char const* const _end;
+  };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read a complete JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+  Json* ReadJsonValue (BinaryReader& reader) {
+    auto json = static_cast<TRI_json_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(TRI_json_t), false));
+
+    if (json == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_InitNullJson(json);
+
+    try {
+      reader.readJson(json);
+    }
+    catch (...) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+      throw;
+    }
+
+    try {
+      return new Json(TRI_UNKNOWN_MEM_ZONE, json);
+    }
+    catch (...) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+      throw;
+    }
+  }
+
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public constants
+// -----------------------------------------------------------------------------
+
+char const* const BinaryBlockFormat::FormatHeader = "x-arango-aql-format";
+
+char const* const BinaryBlockFormat::FormatName = "binary";
+
+char const* const BinaryBlockFormat::ContentType = "application/x-arango-aql-block";
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the header value requests the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+bool BinaryBlockFormat::isRequested (char const* value) {
+  return (value != nullptr && strcmp(value, FormatName) == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the content type denotes the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+bool BinaryBlockFormat::isContentType (std::string const& value) {
+  size_t const length = strlen(ContentType);
+
+  return (value.compare(0, length, ContentType) == 0 &&
+          (value.size() == length || value[length] == ';' || value[length] == ' '));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief serialize the result of getSome
+////////////////////////////////////////////////////////////////////////////////
+
+void BinaryBlockFormat::encodeGetSome (StringBuffer& buffer,
+                                       triagens::arango::AqlTransaction* trx,
+                                       AqlItemBlock const* items,
+                                       ExecutionStats const& stats) {
+  BinaryWriter writer(buffer);
+
+  buffer.appendText("AQB", 3);
+  writer.appendByte(FormatVersion);
+  writer.appendByte(items == nullptr ? 1 : 0);
+
+  writer.appendInt64(stats.writesExecuted);
+  writer.appendInt64(stats.writesIgnored);
+  writer.appendInt64(stats.scannedFull);
+  writer.appendInt64(stats.scannedIndex);
+  writer.appendInt64(stats.filtered);
+  writer.appendInt64(stats.fullCount);
+  writer.appendInt64(stats.spilledRuns);
+  writer.appendInt64(stats.spilledBytes);
+  writer.appendInt64(stats.peakMemoryUsage);
+
+  if (items == nullptr) {
+    return;
+  }
+
+  size_t const nrItems = items->size();
+  RegisterId const nrRegs = items->getNrRegs();
+
+  writer.appendUInt64(static_cast<uint64_t>(nrItems));
+  writer.appendUInt32(static_cast<uint32_t>(nrRegs));
+
+  std::unordered_map<AqlValue, uint64_t> table;   // remember duplicates
+  uint64_t emptyCount = 0;
+
+  auto commitEmpties = [&] () {
+    if (emptyCount == 1) {
+      writer.appendByte(ValueEmpty);
+    }
+    else if (emptyCount > 1) {
+      writer.appendByte(ValueEmptyRun);
+      writer.appendUInt64(emptyCount);
+    }
+    emptyCount = 0;
+  };
+
+  for (RegisterId column = 0; column < nrRegs; ++column) {
+    auto document = items->getDocumentCollection(column);
+
+    for (size_t i = 0; i < nrItems; ++i) {
+      AqlValue const& a = items->getValueReference(i, column);
+
+      if (a.isEmpty()) {
+        ++emptyCount;
+        continue;
+      }
+
+      commitEmpties();
+
+      if (a._type == AqlValue::RANGE) {
+        writer.appendByte(ValueRange);
+        writer.appendInt64(a._range->_low);
+        writer.appendInt64(a._range->_high);
+        continue;
+      }
+
+      auto it = table.find(a);
+
+      if (it != table.end()) {
+        writer.appendByte(ValueRepeated);
+        writer.appendUInt64((*it).second);
+        continue;
+      }
+
+      writer.appendByte(ValueJson);
+      Json json(a.toJson(trx, document, false));
+      writer.appendJson(json.json());
+      table.emplace(a, static_cast<uint64_t>(table.size()));
+    }
+  }
+
+  commitEmpties();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief deserialize the result of getSome
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* BinaryBlockFormat::decodeGetSome (ResourceMonitor* resourceMonitor,
+                                                char const* data,
+                                                size_t length,
+                                                ExecutionStats& stats) {
+  BinaryReader reader(data, length);
+
+  reader.expect(3);
+  if (memcmp(data, "AQB", 3) != 0) {
+    BinaryReader::invalid();
+  }
+  reader.readByte();
+  reader.readByte();
+  reader.readByte();
+
+  if (reader.readByte() != FormatVersion) {
+    BinaryReader::invalid();
+  }
+
+  bool const exhausted = (reader.readByte() != 0);
+
+  stats.writesExecuted = reader.readInt64();
+  stats.writesIgnored  = reader.readInt64();
+  stats.scannedFull    = reader.readInt64();
+  stats.scannedIndex   = reader.readInt64();
+  stats.filtered       = reader.readInt64();
+  stats.fullCount      = reader.readInt64();
+  stats.spilledRuns    = reader.readInt64();
+  stats.spilledBytes   = reader.readInt64();
+  stats.peakMemoryUsage = reader.readInt64();
+
+  if (exhausted) {
+    return nullptr;
+  }
+
+  uint64_t const nrItems = reader.readUInt64();
+  uint32_t const nrRegs = reader.readUInt32();
+
+  if (nrItems == 0) {
+    BinaryReader::invalid();
+  }
+
+  std::unique_ptr<AqlItemBlock> items(new AqlItemBlock(resourceMonitor, static_cast<size_t>(nrItems), static_cast<RegisterId>(nrRegs)));
+  std::vector<AqlValue> madeHere;
+  uint64_t emptyRun = 0;
+
+  for (RegisterId column = 0; column < nrRegs; ++column) {
+    for (size_t i = 0; i < nrItems; ++i) {
+      if (emptyRun > 0) {
+        --emptyRun;
+        continue;
+      }
+
+      switch (reader.readByte()) {
+        case ValueEmpty: {
+          break;
+        }
+
+        case ValueEmptyRun: {
+          emptyRun = reader.readUInt64();
+
+          if (emptyRun < 2) {
+            BinaryReader::invalid();
+          }
+          --emptyRun;
+          break;
+        }
+
+        case ValueRange: {
+          int64_t const low = reader.readInt64();
+          int64_t const high = reader.readInt64();
+          AqlValue a(low, high);
+
+          try {
+            items->setValue(i, column, a);
+          }
+          catch (...) {
+            a.destroy();
+            throw;
+          }
+          break;
+        }
+
+        case ValueJson: {
+          AqlValue a(ReadJsonValue(reader));
+
+          try {
+            madeHere.emplace_back(a);
+          }
+          catch (...) {
+            a.destroy();
+            throw;
+          }
+
+          try {
+            items->setValue(i, column, a);
+          }
+          catch (...) {
+            madeHere.pop_back();
+            a.destroy();
+            throw;
+          }
+          break;
+        }
+
+        case ValueRepeated: {
+          uint64_t const index = reader.readUInt64();
+
+          if (index >= madeHere.size()) {
+            BinaryReader::invalid();
+          }
+
+          // the value is already owned by the block
+          items->setValue(i, column, madeHere[static_cast<size_t>(index)]);
+          break;
+        }
+
+        default: {
+          BinaryReader::invalid();
+          break;
+        }
+      }
+    }
+  }
+
+  if (emptyRun > 0 || ! reader.atEnd()) {
+    BinaryReader::invalid();
+  }
+
+  return items.release();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, binary transfer format for item blocks
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_BINARY_BLOCK_FORMAT_H
+#define ARANGODB_AQL_BINARY_BLOCK_FORMAT_H 1
+
+#include "Basics/Common.h"
+
+namespace triagens {
+  namespace arango {
+    class AqlTransaction;
+  }
+
+  namespace basics {
+    class StringBuffer;
+  }
+
+  namespace aql {
+
+    class AqlItemBlock;
+    struct ExecutionStats;
+    class ResourceMonitor;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           class BinaryBlockFormat
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief binary serialization of the result of a getSome call, used between
+/// coordinator and DB servers instead of JSON if both sides support it.
+///
+/// The coordinator announces that it can read the binary format by sending
+/// the request header `x-arango-aql-format: binary`. A DB server that
+/// understands the header answers with content type
+/// `application/x-arango-aql-block`, otherwise it answers with JSON as
+/// before.
+///
+/// The body has the following layout. All integers are little endian,
+/// numbers are IEEE 754 doubles stored like uint64:
+///
+///   "AQB" version:uint8 exhausted:uint8
+///   stats: 9 x int64 (writesExecuted, writesIgnored, scannedFull,
+///          scannedIndex, filtered, fullCount, spilledRuns, spilledBytes,
+///          peakMemoryUsage)
+///   if not exhausted: nrItems:uint64 nrRegs:uint32, followed by the values
+///   of the block column by column. each value starts with a tag:
+///     0: empty value
+///     1: run of empty values, followed by the length:uint64
+///     2: range, followed by low:int64 and high:int64
+///     3: JSON value, followed by the encoded value
+///     4: repetition of an earlier JSON value in the block, followed by
+///        its index:uint64 (counting the JSON values in order, from 0)
+///
+/// JSON values start with a tag, too:
+///     0: null, 1: false, 2: true, 3: number, followed by the double
+///     4: string, followed by length:uint32 and the bytes
+///     5: array, followed by the number of members:uint32 and the members
+///     6: object, followed by the number of attributes:uint32 and the
+///        attributes, each encoded as string name and value
+////////////////////////////////////////////////////////////////////////////////
+
+    class BinaryBlockFormat {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        BinaryBlockFormat () = delete;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the header value requests the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool isRequested (char const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the content type denotes the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool isContentType (std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief serialize the result of getSome. items is a nullptr if the
+/// execution is exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+        static void encodeGetSome (triagens::basics::StringBuffer&,
+                                   triagens::arango::AqlTransaction*,
+                                   AqlItemBlock const*,
+                                   ExecutionStats const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief deserialize the result of getSome. returns a nullptr if the
+/// execution is exhausted. throws if the data is invalid. the block
+/// charges its memory to the resource monitor
+////////////////////////////////////////////////////////////////////////////////
+
+        static AqlItemBlock* decodeGetSome (ResourceMonitor*,
+                                            char const*,
+                                            size_t,
+                                            ExecutionStats&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public constants
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief name of the request header used for negotiating the format
+////////////////////////////////////////////////////////////////////////////////
+
+        static char const* const FormatHeader;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief header value for the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+        static char const* const FormatName;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief content type of responses in binary format
+////////////////////////////////////////////////////////////////////////////////
+
+        static char const* const ContentType;
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
@@ -81,6 +81,14 @@ namespace triagens {
           return _parameters;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the parameter json
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t const* json () const {
+          return _json;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create a hash value for the bind parameters
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "CollectionScanner.h"
+#include "Basics/Barrier.h"
+#include "Basics/ThreadPool.h"
+#include "VocBase/server.h"
 
 using namespace triagens::aql;
 
@@ -120,6 +123,164 @@ void LinearCollectionScanner::reset () {
   position = 0;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                  struct ParallelCollectionScanner
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum number of primary index slots per partition. each call to
+/// scan() inspects at least this many slots per partition, so the cost of
+/// handing work to the thread pool is spread over enough documents
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const MinSlotsPerPartition = 4096;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+ParallelCollectionScanner::ParallelCollectionScanner (triagens::arango::AqlTransaction* trx,
+                                                      TRI_transaction_collection_t* trxCollection,
+                                                      size_t parallelism,
+                                                      FilterFunction const& filter) 
+  : CollectionScanner(trx, trxCollection),
+    filter(filter),
+    partitions(parallelism),
+    scanned(0) {
+
+  TRI_ASSERT(parallelism > 0);
+}
+
+int ParallelCollectionScanner::scan (std::vector<TRI_doc_mptr_copy_t>& docs,
+                                     size_t batchSize) {
+  scanned = 0;
+  
+  size_t const slots = (std::max)(batchSize, MinSlotsPerPartition) * partitions.size();
+
+  while (true) {
+    TRI_voc_size_t const previous = position;
+
+    int res = trx->readSlots(trxCollection,
+                             position,
+                             static_cast<TRI_voc_size_t>(slots),
+                             [this] (void** beg, void** end) -> int {
+                               return scanPartitions(beg, end);
+                             },
+                             &totalCount);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+
+    if (position == previous) {
+      // end of primary index reached
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    // concatenate the partitions' results in slot order
+    for (auto& it : partitions) {
+      docs.insert(docs.end(), it.begin(), it.end());
+      it.clear();
+    }
+
+    if (! docs.empty()) {
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    // no document in this range passed the filter. continue with the next range
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply the filter to the slots in the range [beg, end). the range
+/// is split into one partition per thread. the last partition is processed
+/// in the calling thread, the others are handed to the thread pool
+////////////////////////////////////////////////////////////////////////////////
+
+int ParallelCollectionScanner::scanPartitions (void** beg,
+                                               void** end) {
+  size_t const n = partitions.size();
+  size_t const perPartition = ((end - beg) + n - 1) / n;
+
+  std::vector<std::exception_ptr> errors(n);
+  std::atomic<uint64_t> inspected(0);
+
+  {
+    triagens::basics::Barrier barrier(n);
+
+    auto work = [&] (size_t i) -> void {
+      void** from = (std::min)(beg + i * perPartition, end);
+      void** to   = (std::min)(from + perPartition, end);
+      auto& found = partitions[i];
+      uint64_t count = 0;
+
+      try {
+        for (void** ptr = from; ptr < to; ++ptr) {
+          if (*ptr != nullptr) {
+            auto d = static_cast<TRI_doc_mptr_t const*>(*ptr);
+            ++count;
+
+            if (filter(i, d)) {
+              found.emplace_back(*d);
+            }
+          }
+        }
+      }
+      catch (...) {
+        errors[i] = std::current_exception();
+      }
+
+      inspected += count;
+      barrier.join();
+    };
+
+    auto pool = static_cast<triagens::basics::ThreadPool*>(trx->vocbase()->_server->_indexPool);
+
+    for (size_t i = 0; i < n; ++i) {
+      // pool threads must come first, otherwise this thread will block the loop and
+      // prevent distribution to threads
+      if (pool != nullptr && i != (n - 1)) {
+        try {
+          pool->enqueue([&work, i] () -> void {
+            work(i);
+          });
+          continue;
+        }
+        catch (...) {
+          // fall back to processing the partition in this thread
+        }
+      }
+
+      work(i);
+    }
+
+    // barrier waits here until all partitions have been processed
+  }
+
+  scanned += inspected.load();
+
+  for (auto& it : errors) {
+    if (it != nullptr) {
+      std::rethrow_exception(it);
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+void ParallelCollectionScanner::reset () {
+  position = 0;
+  scanned = 0;
+
+  for (auto& it : partitions) {
+    it.clear();
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #include "VocBase/document-collection.h"
 #include "VocBase/transaction.h"
 #include "VocBase/vocbase.h"
+#include <functional>
 
 namespace triagens {
   namespace aql {
@@ -109,6 +110,48 @@ namespace triagens {
       void reset () override;
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                  struct ParallelCollectionScanner
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief linear collection scanner that partitions the primary index into
+/// slot ranges and applies a filter function to the documents of each range
+/// in a separate thread. only documents that pass the filter are returned,
+/// in the same order as they would be returned by a LinearCollectionScanner
+////////////////////////////////////////////////////////////////////////////////
+
+    struct ParallelCollectionScanner final : public CollectionScanner {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief filter function, called with the number of the partition and the
+/// document. must be safe to call concurrently for different partitions
+////////////////////////////////////////////////////////////////////////////////
+
+      typedef std::function<bool(size_t, TRI_doc_mptr_t const*)> FilterFunction;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+  
+      ParallelCollectionScanner (triagens::arango::AqlTransaction*,
+                                 TRI_transaction_collection_t*,
+                                 size_t,
+                                 FilterFunction const&); 
+
+      int scan (std::vector<TRI_doc_mptr_copy_t>&,
+                size_t) override;
+      
+      void reset () override;
+
+      int scanPartitions (void**,
+                          void**);
+
+      FilterFunction const filter;
+      std::vector<std::vector<TRI_doc_mptr_copy_t>> partitions;
+      uint64_t scanned;
+    };
+
   }
 }
 
@@ -0,0 +1,704 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, column-wise evaluation of simple conditions
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ColumnarExpression.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/Ast.h"
+#include "Aql/Variable.h"
+#include "Basics/json.h"
+#include "ShapedJson/shape-accessor.h"
+#include "VocBase/document-collection.h"
+#include "VocBase/voc-shaper.h"
+
+using namespace triagens::aql;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the column type of a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t ColumnType (TRI_json_t const* json) {
+  if (json != nullptr) {
+    switch (json->_type) {
+      case TRI_JSON_BOOLEAN:
+        return AqlColumn::TypeBoolean;
+      case TRI_JSON_NUMBER:
+        return AqlColumn::TypeNumber;
+      case TRI_JSON_STRING:
+      case TRI_JSON_STRING_REFERENCE:
+        return AqlColumn::TypeString;
+      case TRI_JSON_ARRAY:
+        return AqlColumn::TypeArray;
+      case TRI_JSON_OBJECT:
+        return AqlColumn::TypeObject;
+      case TRI_JSON_NULL:
+      case TRI_JSON_UNUSED:
+        break;
+    }
+  }
+  return AqlColumn::TypeNull;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the attribute name is a system attribute whose value
+/// is not stored in the shaped JSON of a document
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsComputedAttribute (char const* name) {
+  return (strcmp(name, TRI_VOC_ATTRIBUTE_ID) == 0 ||
+          strcmp(name, TRI_VOC_ATTRIBUTE_REV) == 0 ||
+          strcmp(name, TRI_VOC_ATTRIBUTE_FROM) == 0 ||
+          strcmp(name, TRI_VOC_ATTRIBUTE_TO) == 0);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the expression
+////////////////////////////////////////////////////////////////////////////////
+
+ColumnarExpression::ColumnarExpression () 
+  : _operations() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the expression
+////////////////////////////////////////////////////////////////////////////////
+
+ColumnarExpression::~ColumnarExpression () {
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a columnar expression for the AST node, returns a nullptr
+/// if the node cannot be evaluated column-wise
+////////////////////////////////////////////////////////////////////////////////
+
+ColumnarExpression* ColumnarExpression::create (AstNode const* node) {
+  std::unique_ptr<ColumnarExpression> expression(new ColumnarExpression());
+
+  size_t root;
+  if (! expression->build(node, root)) {
+    return nullptr;
+  }
+
+  TRI_ASSERT(root == expression->_operations.size() - 1);
+
+  if (expression->_operations[root].type == NODE_TYPE_OPERATOR_BINARY_AND) {
+    expression->collectConjuncts(root);
+  }
+
+  return expression.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the expression for all rows of the block
+////////////////////////////////////////////////////////////////////////////////
+
+bool ColumnarExpression::execute (triagens::arango::AqlTransaction* trx,
+                                  AqlItemBlock const* argv,
+                                  std::vector<Variable*> const& vars,
+                                  std::vector<RegisterId> const& regs,
+                                  std::vector<uint8_t>& result) {
+  TRI_ASSERT(! _operations.empty());
+
+  if (! _conjuncts.empty()) {
+    return evaluateConjuncts(trx, argv, vars, regs, result);
+  }
+
+  size_t const root = _operations.size() - 1;
+
+  if (! evaluate(root, trx, argv, vars, regs, nullptr)) {
+    return false;
+  }
+
+  result.swap(_operations[root].result);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief recursively build the operations for the AST node
+////////////////////////////////////////////////////////////////////////////////
+
+bool ColumnarExpression::build (AstNode const* node,
+                                size_t& position) {
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR: {
+      size_t left, right;
+
+      // the operands must be comparisons or logical operations, which
+      // produce booleans. only then the result of AND and OR is a boolean
+      if (! build(node->getMember(0), left) ||
+          ! build(node->getMember(1), right)) {
+        return false;
+      }
+
+      _operations.emplace_back();
+      auto& operation = _operations.back();
+      operation.type  = node->type;
+      operation.left  = left;
+      operation.right = right;
+      break;
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      size_t left;
+
+      if (! build(node->getMember(0), left)) {
+        return false;
+      }
+
+      _operations.emplace_back();
+      auto& operation = _operations.back();
+      operation.type  = node->type;
+      operation.left  = left;
+      break;
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      auto lhs = node->getMember(0);
+      auto rhs = node->getMember(1);
+
+      if (lhs->type == NODE_TYPE_VALUE) {
+        // turn 1 < a.b into a.b > 1
+        return buildComparison(Ast::ReverseOperator(node->type), rhs, lhs, position);
+      }
+
+      return buildComparison(node->type, lhs, rhs, position);
+    }
+
+    default: {
+      return false;
+    }
+  }
+
+  position = _operations.size() - 1;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect the operands of the top-level AND operations
+////////////////////////////////////////////////////////////////////////////////
+
+void ColumnarExpression::collectConjuncts (size_t position) {
+  auto const& operation = _operations[position];
+
+  if (operation.type == NODE_TYPE_OPERATOR_BINARY_AND) {
+    collectConjuncts(operation.left);
+    collectConjuncts(operation.right);
+    return;
+  }
+
+  _conjuncts.emplace_back(position);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a comparison operation
+////////////////////////////////////////////////////////////////////////////////
+
+bool ColumnarExpression::buildComparison (AstNodeType type,
+                                          AstNode const* attribute,
+                                          AstNode const* value,
+                                          size_t& position) {
+  if (value->type != NODE_TYPE_VALUE ||
+      attribute->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+    return false;
+  }
+
+  // collect the attribute names, from the innermost to the outermost
+  std::vector<char const*> parts;
+
+  while (attribute->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    parts.emplace_back(attribute->getStringValue());
+    attribute = attribute->getMember(0);
+  }
+
+  if (attribute->type != NODE_TYPE_REFERENCE) {
+    return false;
+  }
+
+  std::reverse(parts.begin(), parts.end());
+
+  // _id, _rev, _from and _to are computed from the document marker
+  if (IsComputedAttribute(parts[0])) {
+    return false;
+  }
+
+  bool const isKey = (strcmp(parts[0], TRI_VOC_ATTRIBUTE_KEY) == 0);
+
+  if (isKey && parts.size() > 1) {
+    return false;
+  }
+
+  uint8_t constantType;
+  double constantNumber = 0.0;
+  char const* constantString = nullptr;
+
+  switch (value->value.type) {
+    case VALUE_TYPE_NULL: {
+      constantType = AqlColumn::TypeNull;
+      break;
+    }
+    case VALUE_TYPE_BOOL: {
+      constantType = AqlColumn::TypeBoolean;
+      constantNumber = value->getBoolValue() ? 1.0 : 0.0;
+      break;
+    }
+    case VALUE_TYPE_INT: {
+      constantType = AqlColumn::TypeNumber;
+      constantNumber = static_cast<double>(value->getIntValue());
+      break;
+    }
+    case VALUE_TYPE_DOUBLE: {
+      constantType = AqlColumn::TypeNumber;
+      constantNumber = value->getDoubleValue();
+      break;
+    }
+    case VALUE_TYPE_STRING: {
+      // strings are ordered using ICU collation, so only == and != can be
+      // evaluated with a binary comparison
+      if (type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+          type != NODE_TYPE_OPERATOR_BINARY_NE) {
+        return false;
+      }
+      constantType = AqlColumn::TypeString;
+      constantString = value->getStringValue();
+      break;
+    }
+    default: {
+      return false;
+    }
+  }
+
+  _operations.emplace_back();
+  auto& operation = _operations.back();
+
+  operation.type           = type;
+  operation.variable       = static_cast<Variable const*>(attribute->getData());
+  operation.attributeParts = parts;
+  operation.isKey          = isKey;
+  operation.constantType   = constantType;
+  operation.constantNumber = constantNumber;
+  operation.constantString = constantString;
+  operation.shaper         = nullptr;
+  operation.pid            = 0;
+  operation.sid            = 0;
+  operation.accessor       = nullptr;
+  operation.resultShape    = nullptr;
+
+  for (auto const& it : parts) {
+    if (! operation.combinedName.empty()) {
+      operation.combinedName.push_back('.');
+    }
+    operation.combinedName.append(it);
+  }
+
+  position = _operations.size() - 1;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief recursively evaluate an operation
+////////////////////////////////////////////////////////////////////////////////
+
+bool ColumnarExpression::evaluate (size_t position,
+                                   triagens::arango::AqlTransaction* trx,
+                                   AqlItemBlock const* argv,
+                                   std::vector<Variable*> const& vars,
+                                   std::vector<RegisterId> const& regs,
+                                   std::vector<size_t> const* rows) {
+  size_t const n = (rows == nullptr ? argv->size() : rows->size());
+  auto& operation = _operations[position];
+  operation.result.resize(n);
+
+  switch (operation.type) {
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR: {
+      if (! evaluate(operation.left, trx, argv, vars, regs, rows) ||
+          ! evaluate(operation.right, trx, argv, vars, regs, rows)) {
+        return false;
+      }
+
+      uint8_t* out = operation.result.data();
+      uint8_t const* left = _operations[operation.left].result.data();
+      uint8_t const* right = _operations[operation.right].result.data();
+
+      if (operation.type == NODE_TYPE_OPERATOR_BINARY_AND) {
+        for (size_t i = 0; i < n; ++i) {
+          out[i] = left[i] & right[i];
+        }
+      }
+      else {
+        for (size_t i = 0; i < n; ++i) {
+          out[i] = left[i] | right[i];
+        }
+      }
+      return true;
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      if (! evaluate(operation.left, trx, argv, vars, regs, rows)) {
+        return false;
+      }
+
+      uint8_t* out = operation.result.data();
+      uint8_t const* left = _operations[operation.left].result.data();
+
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = left[i] ^ 1;
+      }
+      return true;
+    }
+
+    default: {
+      if (! fillColumn(operation, argv, vars, regs, rows)) {
+        return false;
+      }
+
+      compareColumn(operation, n);
+      return true;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the operands of a top-level AND one after the other. each
+/// operand is only evaluated for the rows selected by the previous ones, so 
+/// a selective first comparison saves extracting the attribute values of the
+/// other comparisons for most rows
+////////////////////////////////////////////////////////////////////////////////
+
+bool ColumnarExpression::evaluateConjuncts (triagens::arango::AqlTransaction* trx,
+                                            AqlItemBlock const* argv,
+                                            std::vector<Variable*> const& vars,
+                                            std::vector<RegisterId> const& regs,
+                                            std::vector<uint8_t>& result) {
+  size_t const n = argv->size();
+
+  _selection.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    _selection[i] = i;
+  }
+
+  for (auto const& it : _conjuncts) {
+    if (_selection.empty()) {
+      break;
+    }
+
+    if (! evaluate(it, trx, argv, vars, regs, &_selection)) {
+      return false;
+    }
+
+    // keep the rows for which the operand is true
+    uint8_t const* matches = _operations[it].result.data();
+    size_t const m = _selection.size();
+    size_t k = 0;
+
+    for (size_t i = 0; i < m; ++i) {
+      _selection[k] = _selection[i];
+      k += matches[i];
+    }
+
+    _selection.resize(k);
+  }
+
+  result.assign(n, 0);
+  for (auto const& it : _selection) {
+    result[it] = 1;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the attribute values of a comparison into its column
+////////////////////////////////////////////////////////////////////////////////
+
+bool ColumnarExpression::fillColumn (Operation& operation,
+                                     AqlItemBlock const* argv,
+                                     std::vector<Variable*> const& vars,
+                                     std::vector<RegisterId> const& regs,
+                                     std::vector<size_t> const* rows) {
+  RegisterId reg = 0;
+  bool found = false;
+
+  size_t const m = vars.size();
+  for (size_t j = 0; j < m; ++j) {
+    if (vars[j]->id == operation.variable->id) {
+      reg = regs[j];
+      found = true;
+      break;
+    }
+  }
+
+  if (! found) {
+    return false;
+  }
+
+  size_t const n = (rows == nullptr ? argv->size() : rows->size());
+  auto& column = operation.column;
+  column.resize(n);
+
+  TRI_document_collection_t const* document = argv->getDocumentCollection(reg);
+  size_t const numParts = operation.attributeParts.size();
+
+  for (size_t i = 0; i < n; ++i) {
+    auto const& value = argv->getValueReference(rows == nullptr ? i : (*rows)[i], reg);
+
+    column.types[i]   = AqlColumn::TypeNull;
+    column.numbers[i] = 0.0;
+    column.strings[i] = nullptr;
+
+    if (value.isShaped()) {
+      if (operation.isKey) {
+        column.types[i]   = AqlColumn::TypeString;
+        column.strings[i] = TRI_EXTRACT_MARKER_KEY(value._marker);
+        continue;
+      }
+
+      if (document == nullptr) {
+        return false;
+      }
+
+      auto shaper = document->getShaper();
+
+      if (shaper != operation.shaper) {
+        operation.shaper = shaper;
+        operation.pid = shaper->lookupAttributePathByName(shaper, operation.combinedName.c_str());
+        operation.sid = 0;
+      }
+
+      if (operation.pid == 0) {
+        // attribute does not exist in any document
+        continue;
+      }
+
+      TRI_shaped_json_t shapedJson;
+      TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, value._marker);
+
+      if (shapedJson._sid != operation.sid) {
+        // the documents of a collection mostly share a few shapes, so the
+        // accessor and the result shape are only looked up when the shape
+        // changes, and not for each row
+        operation.sid = shapedJson._sid;
+        operation.accessor = TRI_FindAccessorVocShaper(shaper, shapedJson._sid, operation.pid);
+        operation.resultShape = nullptr;
+
+        if (operation.accessor != nullptr &&
+            operation.accessor->_resultSid != TRI_SHAPE_ILLEGAL) {
+          operation.resultShape = shaper->lookupShapeId(shaper, operation.accessor->_resultSid);
+        }
+      }
+
+      if (operation.resultShape == nullptr) {
+        // attribute does not exist in documents of this shape
+        continue;
+      }
+
+      TRI_shaped_json_t json;
+      TRI_shape_t const* shape = operation.resultShape;
+
+      if (! TRI_ExecuteShapeAccessor(operation.accessor, &shapedJson, &json)) {
+        continue;
+      }
+
+      switch (shape->_type) {
+        case TRI_SHAPE_BOOLEAN: {
+          column.types[i]   = AqlColumn::TypeBoolean;
+          column.numbers[i] = (* (TRI_shape_boolean_t const*) json._data.data) != 0 ? 1.0 : 0.0;
+          break;
+        }
+        case TRI_SHAPE_NUMBER: {
+          column.types[i]   = AqlColumn::TypeNumber;
+          column.numbers[i] = * (TRI_shape_number_t const*) (void const*) json._data.data;
+          break;
+        }
+        case TRI_SHAPE_SHORT_STRING:
+        case TRI_SHAPE_LONG_STRING: {
+          char* data;
+          size_t length;
+          TRI_StringValueShapedJson(shape, json._data.data, &data, &length);
+          column.types[i]   = AqlColumn::TypeString;
+          column.strings[i] = data;
+          break;
+        }
+        case TRI_SHAPE_ARRAY: {
+          column.types[i] = AqlColumn::TypeObject;
+          break;
+        }
+        case TRI_SHAPE_LIST:
+        case TRI_SHAPE_HOMOGENEOUS_LIST:
+        case TRI_SHAPE_HOMOGENEOUS_SIZED_LIST: {
+          column.types[i] = AqlColumn::TypeArray;
+          break;
+        }
+        default: {
+          break;
+        }
+      }
+    }
+    else if (value.isJson()) {
+      TRI_json_t const* json = value._json->json();
+
+      for (size_t j = 0; j < numParts; ++j) {
+        if (! TRI_IsObjectJson(json)) {
+          json = nullptr;
+          break;
+        }
+
+        json = TRI_LookupObjectJson(json, operation.attributeParts[j]);
+
+        if (json == nullptr) {
+          break;
+        }
+      }
+
+      uint8_t const type = ColumnType(json);
+      column.types[i] = type;
+
+      if (type == AqlColumn::TypeBoolean) {
+        column.numbers[i] = json->_value._boolean ? 1.0 : 0.0;
+      }
+      else if (type == AqlColumn::TypeNumber) {
+        column.numbers[i] = json->_value._number;
+      }
+      else if (type == AqlColumn::TypeString) {
+        column.strings[i] = json->_value._string.data;
+      }
+    }
+    else {
+      // documents from a subquery or ranges
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compare the column of a comparison with its constant. values of 
+/// different types are ordered by their type weights
+////////////////////////////////////////////////////////////////////////////////
+
+void ColumnarExpression::compareColumn (Operation& operation,
+                                        size_t n) {
+  uint8_t* out = operation.result.data();
+  uint8_t const* types = operation.column.types.data();
+  uint8_t const type = operation.constantType;
+
+  if (type == AqlColumn::TypeString) {
+    char const* const* strings = operation.column.strings.data();
+    char const* value = operation.constantString;
+
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = (types[i] == type && strcmp(strings[i], value) == 0) ? 1 : 0;
+    }
+
+    if (operation.type == NODE_TYPE_OPERATOR_BINARY_NE) {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] ^= 1;
+      }
+    }
+    return;
+  }
+
+  double const* numbers = operation.column.numbers.data();
+  double const value = operation.constantNumber;
+
+  switch (operation.type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ: {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = (types[i] == type) & (numbers[i] == value);
+      }
+      break;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_NE: {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = (types[i] != type) | (numbers[i] != value);
+      }
+      break;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_LT: {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = (types[i] < type) | ((types[i] == type) & (numbers[i] < value));
+      }
+      break;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_LE: {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = (types[i] < type) | ((types[i] == type) & (numbers[i] <= value));
+      }
+      break;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_GT: {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = (types[i] > type) | ((types[i] == type) & (numbers[i] > value));
+      }
+      break;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = (types[i] > type) | ((types[i] == type) & (numbers[i] >= value));
+      }
+      break;
+    }
+    default: {
+      TRI_ASSERT(false);
+      break;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, column-wise evaluation of simple conditions
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_COLUMNAR_EXPRESSION_H
+#define ARANGODB_AQL_COLUMNAR_EXPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AstNode.h"
+#include "Aql/types.h"
+#include "ShapedJson/shaped-json.h"
+#include "Utils/AqlTransaction.h"
+
+struct TRI_shape_access_s;
+struct TRI_shaper_s;
+
+namespace triagens {
+  namespace aql {
+
+    class AqlItemBlock;
+    struct Variable;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  struct AqlColumn
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief typed values of one attribute for all rows of an AqlItemBlock,
+/// stored as contiguous arrays. the type of a value is stored as its sort
+/// weight, which is the same as in TRI_CompareValuesJson. numbers and 
+/// booleans are stored as doubles, strings as pointers into the underlying 
+/// documents or JSON values
+////////////////////////////////////////////////////////////////////////////////
+
+    struct AqlColumn {
+
+      static uint8_t const TypeNull    = 0;
+      static uint8_t const TypeBoolean = 1;
+      static uint8_t const TypeNumber  = 2;
+      static uint8_t const TypeString  = 3;
+      static uint8_t const TypeArray   = 4;
+      static uint8_t const TypeObject  = 5;
+
+      void resize (size_t n) {
+        types.resize(n);
+        numbers.resize(n);
+        strings.resize(n);
+      }
+
+      std::vector<uint8_t> types;
+      std::vector<double> numbers;
+      std::vector<char const*> strings;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          class ColumnarExpression
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a condition that is evaluated for all rows of an AqlItemBlock at
+/// once. supported are comparisons of an attribute of a variable with a 
+/// constant number, boolean or null value (or a string constant for == and 
+/// !=), and logical combinations of these. the attribute values are extracted
+/// into typed columns first, which are then compared in tight loops. the
+/// operands of a top-level AND are evaluated one after the other, each only
+/// for the rows that the previous ones have selected
+////////////////////////////////////////////////////////////////////////////////
+
+    class ColumnarExpression {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        ColumnarExpression (ColumnarExpression const&) = delete;
+        ColumnarExpression& operator= (ColumnarExpression const&) = delete;
+
+        ColumnarExpression ();
+
+        ~ColumnarExpression ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a columnar expression for the AST node, returns a nullptr
+/// if the node cannot be evaluated column-wise
+////////////////////////////////////////////////////////////////////////////////
+
+        static ColumnarExpression* create (AstNode const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the expression for all rows of the block. the result
+/// contains 1 for each row for which the condition is true, and 0 otherwise.
+/// returns false if the block contains values that cannot be evaluated 
+/// column-wise. the caller must then evaluate the rows one by one
+////////////////////////////////////////////////////////////////////////////////
+
+        bool execute (triagens::arango::AqlTransaction*,
+                      AqlItemBlock const*,
+                      std::vector<Variable*> const&,
+                      std::vector<RegisterId> const&,
+                      std::vector<uint8_t>&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a single operation, either a comparison of an attribute with a
+/// constant or a logical operation on the results of other operations
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Operation {
+          AstNodeType type;
+          size_t left;
+          size_t right;
+
+          Variable const* variable;
+          std::vector<char const*> attributeParts;
+          std::string combinedName;
+          bool isKey;
+
+          uint8_t constantType;
+          double constantNumber;
+          char const* constantString;
+
+          struct TRI_shaper_s* shaper;
+          TRI_shape_pid_t pid;
+
+          TRI_shape_sid_t sid;
+          struct TRI_shape_access_s const* accessor;
+          TRI_shape_t const* resultShape;
+
+          AqlColumn column;
+          std::vector<uint8_t> result;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief recursively build the operations for the AST node, returns the
+/// index of the operation or false if the node is not supported
+////////////////////////////////////////////////////////////////////////////////
+
+        bool build (AstNode const*,
+                    size_t&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect the operands of the top-level AND operations
+////////////////////////////////////////////////////////////////////////////////
+
+        void collectConjuncts (size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a comparison operation
+////////////////////////////////////////////////////////////////////////////////
+
+        bool buildComparison (AstNodeType,
+                              AstNode const*,
+                              AstNode const*,
+                              size_t&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief recursively evaluate an operation, either for all rows of the
+/// block or only for the rows in the selection
+////////////////////////////////////////////////////////////////////////////////
+
+        bool evaluate (size_t,
+                       triagens::arango::AqlTransaction*,
+                       AqlItemBlock const*,
+                       std::vector<Variable*> const&,
+                       std::vector<RegisterId> const&,
+                       std::vector<size_t> const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the operands of a top-level AND one after the other,
+/// narrowing down the selection of rows
+////////////////////////////////////////////////////////////////////////////////
+
+        bool evaluateConjuncts (triagens::arango::AqlTransaction*,
+                                AqlItemBlock const*,
+                                std::vector<Variable*> const&,
+                                std::vector<RegisterId> const&,
+                                std::vector<uint8_t>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the attribute values of a comparison into its column
+////////////////////////////////////////////////////////////////////////////////
+
+        bool fillColumn (Operation&,
+                         AqlItemBlock const*,
+                         std::vector<Variable*> const&,
+                         std::vector<RegisterId> const&,
+                         std::vector<size_t> const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compare the column of a comparison with its constant
+////////////////////////////////////////////////////////////////////////////////
+
+        void compareColumn (Operation&,
+                            size_t);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief all operations. the last operation is the root of the expression
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Operation> _operations;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the operands of the top-level AND operations, empty if the root
+/// is not an AND
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<size_t> _conjuncts;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the rows selected by the conjuncts evaluated so far
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<size_t> _selection;
+    };
+
+  }   // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -26,6 +26,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Aql/ExecutionBlock.h"
+#include "Aql/BinaryBlockFormat.h"
 #include "Aql/CollectionScanner.h"
 #include "Aql/ExecutionEngine.h"
 #include "Basics/ScopeGuard.h"
@@ -33,6 +34,7 @@
 #include "Basics/StringBuffer.h"
 #include "Basics/json-utilities.h"
 #include "Basics/Exceptions.h"
+#include "Basics/files.h"
 #include "Dispatcher/DispatcherThread.h"
 #include "Cluster/ClusterMethods.h"
 #include "Indexes/EdgeIndex.h"
@@ -372,6 +374,14 @@ void ExecutionBlock::returnBlock (AqlItemBlock*& block) {
   _engine->_itemBlockManager.returnBlock(block);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the resource monitor the query's memory is charged to
+////////////////////////////////////////////////////////////////////////////////
+
+ResourceMonitor* ExecutionBlock::resourceMonitor () const {
+  return _engine->getQuery()->resourceMonitor();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief resolve a collection name and return cid and document key
 /// this is used for parsing _from, _to and _id values
@@ -489,12 +499,47 @@ bool ExecutionBlock::getBlock (size_t atLeast, size_t atMost) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
   }
 
+  TRI_IF_FAILURE("BinaryBlockFormat::roundTrip") {
+    // pass the block through the binary transfer format, as if it had
+    // been fetched from a DB server by a RemoteBlock
+    docs.reset(roundTripBinaryBlock(docs.get()));
+  }
+
   _buffer.emplace_back(docs.get());
   docs.release();
 
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief encode a block in the binary transfer format and decode it again,
+/// used for testing the format without a cluster
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* ExecutionBlock::roundTripBinaryBlock (AqlItemBlock const* items) {
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  ExecutionStats stats;
+
+  BinaryBlockFormat::encodeGetSome(buffer, _trx, items, stats);
+
+  size_t length = buffer.length();
+
+  TRI_IF_FAILURE("BinaryBlockFormat::truncated") {
+    // cut off the last byte
+    --length;
+  }
+
+  TRI_IF_FAILURE("BinaryBlockFormat::invalidTag") {
+    // overwrite the tag of the first value, which follows the header with
+    // the statistics, the number of items and the number of registers
+    size_t const offset = 3 + 2 + 9 * sizeof(int64_t) + sizeof(uint64_t) + sizeof(uint32_t);
+    TRI_ASSERT(offset < length);
+    const_cast<char*>(buffer.begin())[offset] = static_cast<char>(0x7f);
+  }
+
+  return BinaryBlockFormat::decodeGetSome(resourceMonitor(), buffer.c_str(), length, stats);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief getSomeWithoutRegisterClearout, same as above, however, this
 /// is the actual worker which does not clear out registers at the end
@@ -764,7 +809,7 @@ int SingletonBlock::getOrSkipSome (size_t,   // atLeast,
   }
 
   if (! skipping) {
-    result = new AqlItemBlock(1, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]);
+    result = new AqlItemBlock(resourceMonitor(), 1, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]);
 
     try {
       if (_inputRegisterValues != nullptr) {
@@ -818,6 +863,27 @@ int SingletonBlock::getOrSkipSome (size_t,   // atLeast,
 // --SECTION--                                    class EnumerateCollectionBlock
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build an object with just the projected attributes of a document,
+/// reading the attribute values directly from the marker
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue projectDocument (triagens::arango::AqlTransaction* trx,
+                                 TRI_document_collection_t const* document,
+                                 TRI_df_marker_t const* marker,
+                                 std::vector<std::string> const& projection,
+                                 StringBuffer& buffer) {
+  AqlValue const value(marker);
+
+  std::unique_ptr<Json> json(new Json(Json::Object, projection.size()));
+
+  for (auto const& name : projection) {
+    json->set(name.c_str(), value.extractObjectMember(trx, document, name.c_str(), true, buffer));
+  }
+
+  return AqlValue(json.release());
+}
+
 EnumerateCollectionBlock::EnumerateCollectionBlock (ExecutionEngine* engine,
                                                     EnumerateCollectionNode const* ep)
   : ExecutionBlock(engine, ep),
@@ -825,7 +891,10 @@ EnumerateCollectionBlock::EnumerateCollectionBlock (ExecutionEngine* engine,
     _scanner(nullptr),
     _posInDocuments(0),
     _random(ep->_random),
-    _mustStoreResult(true) {
+    _mustStoreResult(true),
+    _projection(ep->_projection),
+    _parallelDocumentReg(ExecutionNode::MaxRegisterId),
+    _parallelFilterReg(ExecutionNode::MaxRegisterId) {
 
   auto trxCollection = _trx->trxCollection(_collection->cid());
   if (trxCollection != nullptr) {
@@ -843,6 +912,7 @@ EnumerateCollectionBlock::EnumerateCollectionBlock (ExecutionEngine* engine,
 }
 
 EnumerateCollectionBlock::~EnumerateCollectionBlock () {
+  freeParallelScan();
   delete _scanner;
 }
 
@@ -860,17 +930,32 @@ bool EnumerateCollectionBlock::moreDocuments (size_t hint) {
   std::vector<TRI_doc_mptr_copy_t> newDocs;
   newDocs.reserve(hint);
 
+  bool const isParallel = ! _parallelContexts.empty();
+
+  if (isParallel) {
+    prepareParallelScan();
+  }
+
   int res = _scanner->scan(newDocs, hint);
 
   if (res != TRI_ERROR_NO_ERROR) {
     THROW_ARANGO_EXCEPTION(res);
   }
+
+  if (isParallel) {
+    // the scanner has already removed the documents that do not pass the filter
+    auto scanner = static_cast<ParallelCollectionScanner const*>(_scanner);
+    _engine->_stats.scannedFull += static_cast<int64_t>(scanner->scanned);
+    _engine->_stats.filtered += static_cast<int64_t>(scanner->scanned - newDocs.size());
+  }
   
   if (newDocs.empty()) {
     return false;
   }
 
-  _engine->_stats.scannedFull += static_cast<int64_t>(newDocs.size());
+  if (! isParallel) {
+    _engine->_stats.scannedFull += static_cast<int64_t>(newDocs.size());
+  }
 
   _documents.swap(newDocs);
   _posInDocuments = 0;
@@ -881,10 +966,301 @@ bool EnumerateCollectionBlock::moreDocuments (size_t hint) {
 int EnumerateCollectionBlock::initialize () {
   auto ep = static_cast<EnumerateCollectionNode const*>(_exeNode);
   _mustStoreResult = ep->isVarUsedLater(ep->_outVariable);
+
+  setupParallelScan();
   
   return ExecutionBlock::initialize();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up a parallel scan if the query allows it and the collection
+/// scan is directly followed by calculations and a filter that can be 
+/// evaluated by multiple threads
+////////////////////////////////////////////////////////////////////////////////
+
+void EnumerateCollectionBlock::setupParallelScan () {
+  size_t const parallelism = (std::min)(_engine->getQuery()->maxParallelism(), TRI_numberProcessors());
+
+  if (parallelism <= 1 || 
+      _random || 
+      ! _mustStoreResult ||
+      ! _parallelContexts.empty()) {
+    return;
+  }
+
+  auto trxCollection = _trx->trxCollection(_collection->cid());
+  auto document = _trx->documentCollection(_collection->cid());
+
+  if (trxCollection == nullptr || 
+      document == nullptr ||
+      document->_info._type == TRI_COL_TYPE_EDGE) {
+    // edge documents may require collection name lookups for _from and _to,
+    // which must not be performed concurrently
+    return;
+  }
+
+  // find the calculations and the filter directly following the scan
+  std::vector<CalculationNode const*> calculations;
+  FilterNode const* filter = nullptr;
+  ExecutionNode const* node = _exeNode;
+
+  while (filter == nullptr) {
+    auto parents = node->getParents();
+
+    if (parents.size() != 1) {
+      return;
+    }
+
+    node = parents[0];
+
+    if (node->getType() == ExecutionNode::CALCULATION) {
+      auto calculation = static_cast<CalculationNode const*>(node);
+      auto expression = calculation->expression();
+
+      if (expression->isV8() || 
+          ! expression->isDeterministic() || 
+          ! expression->canRunOnDBServer()) {
+        // V8 is single-threaded, and expressions that access other collections
+        // cannot be evaluated concurrently
+        return;
+      }
+
+      calculations.emplace_back(calculation);
+    }
+    else if (node->getType() == ExecutionNode::FILTER) {
+      filter = static_cast<FilterNode const*>(node);
+    }
+    else {
+      return;
+    }
+  }
+
+  if (calculations.empty()) {
+    return;
+  }
+
+  auto ep = static_cast<EnumerateCollectionNode const*>(_exeNode);
+  auto registerPlan = filter->getRegisterPlan();
+  
+  auto it = registerPlan->varInfo.find(ep->_outVariable->id);
+  TRI_ASSERT(it != registerPlan->varInfo.end());
+  _parallelDocumentReg = it->second.registerId;
+
+  it = registerPlan->varInfo.find(filter->_inVariable->id);
+  TRI_ASSERT(it != registerPlan->varInfo.end());
+  _parallelFilterReg = it->second.registerId;
+
+  try {
+    auto ast = _engine->getQuery()->ast();
+    std::unordered_set<RegisterId> produced{ _parallelDocumentReg };
+    std::unordered_set<RegisterId> inputs;
+
+    // the partitions are evaluated concurrently, so each gets its own arena
+    _parallelArenas.reserve(parallelism);
+
+    for (size_t i = 0; i < parallelism; ++i) {
+      std::unique_ptr<JsonArena> arena(new JsonArena(128));
+      _parallelArenas.emplace_back(arena.get());
+      arena.release();
+    }
+
+    _parallelCalculations.reserve(calculations.size());
+
+    for (auto const& calculation : calculations) {
+      _parallelCalculations.emplace_back();
+      auto& current = _parallelCalculations.back();
+      current.conditionReg = ExecutionNode::MaxRegisterId;
+
+      for (auto const& v : calculation->expression()->variables()) {
+        auto it2 = registerPlan->varInfo.find(v->id);
+        TRI_ASSERT(it2 != registerPlan->varInfo.end());
+
+        current.inVars.emplace_back(v);
+        current.inRegs.emplace_back(it2->second.registerId);
+      }
+
+      if (calculation->_conditionVariable != nullptr) {
+        auto it2 = registerPlan->varInfo.find(calculation->_conditionVariable->id);
+        TRI_ASSERT(it2 != registerPlan->varInfo.end());
+        current.conditionReg = it2->second.registerId;
+
+        if (produced.find(current.conditionReg) == produced.end()) {
+          inputs.emplace(current.conditionReg);
+        }
+      }
+
+      for (auto const& reg : current.inRegs) {
+        if (produced.find(reg) == produced.end()) {
+          inputs.emplace(reg);
+        }
+      }
+
+      auto it2 = registerPlan->varInfo.find(calculation->_outVariable->id);
+      TRI_ASSERT(it2 != registerPlan->varInfo.end());
+      current.outReg = it2->second.registerId;
+      produced.emplace(current.outReg);
+
+      // each partition gets its own copy of the expression, as expressions
+      // and AST nodes cache data during execution
+      current.expressions.reserve(parallelism);
+
+      for (size_t i = 0; i < parallelism; ++i) {
+        std::unique_ptr<Expression> expression(new Expression(ast, ast->clone(calculation->expression()->node())));
+        expression->setJsonArena(_parallelArenas[i]);
+        current.expressions.emplace_back(expression.get());
+        expression.release();
+      }
+    }
+
+    if (produced.find(_parallelFilterReg) == produced.end()) {
+      inputs.emplace(_parallelFilterReg);
+    }
+
+    _parallelInRegs.insert(_parallelInRegs.end(), inputs.begin(), inputs.end());
+
+    RegisterId const nrRegs = registerPlan->nrRegs[filter->getDepth()];
+    _parallelContexts.reserve(parallelism);
+
+    for (size_t i = 0; i < parallelism; ++i) {
+      std::unique_ptr<AqlItemBlock> context(new AqlItemBlock(resourceMonitor(), 1, nrRegs));
+      context->setDocumentCollection(_parallelDocumentReg, document);
+      _parallelContexts.emplace_back(context.get());
+      context.release();
+    }
+
+    // resolve the collection name once, so the resolver's cache is populated
+    // before it is accessed by multiple threads
+    _trx->resolver()->getCollectionName(_collection->cid());
+
+    std::unique_ptr<CollectionScanner> scanner(new ParallelCollectionScanner(_trx, trxCollection, parallelism, [this] (size_t partition, TRI_doc_mptr_t const* doc) -> bool {
+      return parallelFilter(partition, doc);
+    }));
+
+    delete _scanner;
+    _scanner = scanner.release();
+  }
+  catch (...) {
+    freeParallelScan();
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copy the current input row into the evaluation contexts of the
+/// parallel scan
+////////////////////////////////////////////////////////////////////////////////
+
+void EnumerateCollectionBlock::prepareParallelScan () {
+  TRI_ASSERT(! _buffer.empty());
+
+  AqlItemBlock* cur = _buffer.front();
+
+  for (auto& context : _parallelContexts) {
+    for (auto const& reg : _parallelInRegs) {
+      context->destroyValue(0, reg);
+      context->setDocumentCollection(reg, cur->getDocumentCollection(reg));
+
+      AqlValue const& value = cur->getValueReference(_pos, reg);
+
+      if (value.isEmpty()) {
+        continue;
+      }
+
+      AqlValue a = value.clone();
+
+      try {
+        context->setValue(0, reg, a);
+      }
+      catch (...) {
+        a.destroy();
+        throw;
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the calculations and the filter of the parallel scan for
+/// a document, using the evaluation context of the given partition. this is
+/// called concurrently for different partitions
+////////////////////////////////////////////////////////////////////////////////
+
+bool EnumerateCollectionBlock::parallelFilter (size_t partition,
+                                               TRI_doc_mptr_t const* doc) {
+  throwIfKilled(); // check if we were aborted
+
+  AqlItemBlock* context = _parallelContexts[partition];
+  
+  auto cleanup = [&] () -> void {
+    for (auto const& calculation : _parallelCalculations) {
+      context->destroyValue(0, calculation.outReg);
+    }
+    context->eraseValue(0, _parallelDocumentReg);
+  };
+
+  context->setShaped(0, 
+                     _parallelDocumentReg, 
+                     reinterpret_cast<TRI_df_marker_t const*>(doc->getDataPtr()));
+
+  bool result = false;
+
+  try {
+    for (auto const& calculation : _parallelCalculations) {
+      if (calculation.conditionReg != ExecutionNode::MaxRegisterId &&
+          ! context->getValueReference(0, calculation.conditionReg).isTrue()) {
+        context->setValue(0, calculation.outReg, _parallelArenas[partition]->createReference(&Expression::NullJson));
+        continue;
+      }
+
+      TRI_document_collection_t const* myCollection = nullptr;
+      AqlValue a = calculation.expressions[partition]->execute(_trx, context, 0, calculation.inVars, calculation.inRegs, &myCollection);
+
+      try {
+        context->setValue(0, calculation.outReg, a);
+      }
+      catch (...) {
+        a.destroy();
+        throw;
+      }
+    }
+
+    result = context->getValueReference(0, _parallelFilterReg).isTrue();
+  }
+  catch (...) {
+    cleanup();
+    throw;
+  }
+
+  cleanup();
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release the parallel scan's evaluation contexts
+////////////////////////////////////////////////////////////////////////////////
+
+void EnumerateCollectionBlock::freeParallelScan () {
+  for (auto& calculation : _parallelCalculations) {
+    for (auto& expression : calculation.expressions) {
+      delete expression;
+    }
+  }
+  _parallelCalculations.clear();
+
+  for (auto& context : _parallelContexts) {
+    delete context;
+  }
+  _parallelContexts.clear();
+  _parallelInRegs.clear();
+
+  // the values of the contexts may come from the arenas, so free these last
+  for (auto& arena : _parallelArenas) {
+    delete arena;
+  }
+  _parallelArenas.clear();
+}
+
 int EnumerateCollectionBlock::initializeCursor (AqlItemBlock* items, 
                                                 size_t pos) {
   int res = ExecutionBlock::initializeCursor(items, pos);
@@ -949,7 +1325,10 @@ AqlItemBlock* EnumerateCollectionBlock::getSome (size_t, // atLeast,
   inheritRegisters(cur, res.get(), _pos);
 
   // set our collection for our output register
-  res->setDocumentCollection(static_cast<triagens::aql::RegisterId>(curRegs), _trx->documentCollection(_collection->cid()));
+  auto document = _trx->documentCollection(_collection->cid());
+  res->setDocumentCollection(static_cast<triagens::aql::RegisterId>(curRegs), document);
+
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
 
   for (size_t j = 0; j < toSend; j++) {
     if (j > 0) {
@@ -965,9 +1344,22 @@ AqlItemBlock* EnumerateCollectionBlock::getSome (size_t, // atLeast,
       // The result is in the first variable of this depth,
       // we do not need to do a lookup in getPlanNode()->_registerPlan->varInfo,
       // but can just take cur->getNrRegs() as registerId:
-      res->setShaped(j, 
-                     static_cast<triagens::aql::RegisterId>(curRegs),
-                     reinterpret_cast<TRI_df_marker_t const*>(_documents[_posInDocuments].getDataPtr()));
+      auto marker = reinterpret_cast<TRI_df_marker_t const*>(_documents[_posInDocuments].getDataPtr());
+
+      if (_projection.empty()) {
+        res->setShaped(j, static_cast<triagens::aql::RegisterId>(curRegs), marker);
+      }
+      else {
+        // only produce the attributes that are used later
+        AqlValue a = projectDocument(_trx, document, marker, _projection, buffer);
+        try {
+          res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs), a);
+        }
+        catch (...) {
+          a.destroy();
+          throw;
+        }
+      }
       // No harm done, if the setValue throws!
     }
 
@@ -1051,6 +1443,14 @@ size_t EnumerateCollectionBlock::skipSome (size_t atLeast, size_t atMost) {
 // --SECTION--                                             class IndexRangeBlock
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief special positions of _key and _rev in a projection that is read
+/// from the index elements
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const CoveringKeyPosition = std::numeric_limits<size_t>::max();
+static size_t const CoveringRevPosition = std::numeric_limits<size_t>::max() - 1;
+
 IndexRangeBlock::IndexRangeBlock (ExecutionEngine* engine,
                                   IndexRangeNode const* en)
   : ExecutionBlock(engine, en),
@@ -1065,7 +1465,11 @@ IndexRangeBlock::IndexRangeBlock (ExecutionEngine* engine,
     _posInRanges(0),
     _sortCoords(),
     _freeCondition(true),
-    _hasV8Expression(false) {
+    _hasV8Expression(false),
+    _useBatchedLookups(false),
+    _projection(en->_projection),
+    _covering(en->_covering),
+    _coveringFields(en->_index->fields.size()) {
 
   auto trxCollection = _trx->trxCollection(_collection->cid());
 
@@ -1104,6 +1508,39 @@ IndexRangeBlock::IndexRangeBlock (ExecutionEngine* engine,
     _anyBoundVariable |= ! isConstant;
     _allBoundsConstant.push_back(isConstant); // note: emplace_back() is not supported in C++11 but only from C++14
   }
+
+  // hash and edge indexes only support equality lookups, so the documents
+  // found for a specific set of bound values can be reused for all input
+  // rows that produce the same bound values
+  auto const type = en->_index->type;
+  _useBatchedLookups = (_anyBoundVariable &&
+                        (type == triagens::arango::Index::TRI_IDX_TYPE_HASH_INDEX ||
+                         type == triagens::arango::Index::TRI_IDX_TYPE_EDGE_INDEX));
+
+  if (_covering) {
+    TRI_ASSERT(type == triagens::arango::Index::TRI_IDX_TYPE_HASH_INDEX ||
+               type == triagens::arango::Index::TRI_IDX_TYPE_SKIPLIST_INDEX);
+
+    auto const& fields = en->_index->fields;
+
+    for (auto const& name : _projection) {
+      if (name == TRI_VOC_ATTRIBUTE_KEY) {
+        _coveringPositions.emplace_back(CoveringKeyPosition);
+      }
+      else if (name == TRI_VOC_ATTRIBUTE_REV) {
+        _coveringPositions.emplace_back(CoveringRevPosition);
+      }
+      else {
+        auto it = std::find(fields.begin(), fields.end(), name);
+
+        if (it == fields.end()) {
+          THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "projected attribute not covered by index");
+        }
+
+        _coveringPositions.emplace_back(static_cast<size_t>(it - fields.begin()));
+      }
+    }
+  }
 }
 
 IndexRangeBlock::~IndexRangeBlock () {
@@ -1179,7 +1616,13 @@ void IndexRangeBlock::buildExpressions () {
 
         Json bound;
         if (a._type == AqlValue::JSON) {
-          bound = *(a._json);
+          if (a._fromArena) {
+            // the slot of an arena value is recycled, so we must copy it
+            bound = a._json->copy();
+          }
+          else {
+            bound = *(a._json);
+          }
           a.destroy();  // the TRI_json_t* of a._json has been stolen
         } 
         else if (a._type == AqlValue::SHAPED || a._type == AqlValue::DOCVEC) {
@@ -1249,7 +1692,13 @@ void IndexRangeBlock::buildExpressions () {
 
           Json bound;
           if (a._type == AqlValue::JSON) {
-            bound = *(a._json);
+            if (a._fromArena) {
+              // the slot of an arena value is recycled, so we must copy it
+              bound = a._json->copy();
+            }
+            else {
+              bound = *(a._json);
+            }
             a.destroy();  // the TRI_json_t* of a._json has been stolen
           } 
           else if (a._type == AqlValue::SHAPED || a._type == AqlValue::DOCVEC) {
@@ -1338,55 +1787,165 @@ void IndexRangeBlock::buildExpressions () {
   }
 }
 
-int IndexRangeBlock::initialize () {
-  ENTER_BLOCK
-  int res = ExecutionBlock::initialize();
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the bounds for all rows of the current input block and
+/// probe the index once per distinct lookup key
+////////////////////////////////////////////////////////////////////////////////
 
-  if (res == TRI_ERROR_NO_ERROR) {
-    if (_trx->orderDitch(_trx->trxCollection(_collection->cid())) == nullptr) {
-      res = TRI_ERROR_OUT_OF_MEMORY;
-    }
-  }
+void IndexRangeBlock::buildBatchedLookups () {
+  AqlItemBlock* cur = _buffer.front();
+  size_t const n = cur->size();
 
-  _allVariableBoundExpressions.clear();
+  auto en = static_cast<IndexRangeNode const*>(getPlanNode());
+  bool const isEdgeIndex = (en->_index->type == triagens::arango::Index::TRI_IDX_TYPE_EDGE_INDEX);
 
-  // instanciate expressions:
-  auto instanciateExpression = [&] (RangeInfoBound const& b) -> void {
-    AstNode const* a = b.getExpressionAst(_engine->getQuery()->ast());
-    Expression* expression = nullptr;
- 
-    {
-      // all new AstNodes are registered with the Ast in the Query
-      std::unique_ptr<Expression> e(new Expression(_engine->getQuery()->ast(), a));
+  _batchedResults.clear();
+  _batchedSubObjects.clear();
+  _batchedRows.clear();
+  _batchedRows.reserve(n);
 
-      TRI_IF_FAILURE("IndexRangeBlock::initialize") {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-      }
+  // lookup key => position in _batchedResults
+  std::unordered_map<std::string, size_t> distinct;
 
-      _allVariableBoundExpressions.emplace_back(e.get());
-      expression = e.release();
-    }
+  size_t const oldPos = _pos;
 
-    // Prepare _inVars and _inRegs:
-    _inVars.emplace_back();
-    std::vector<Variable*>& inVarsCur = _inVars.back();
-    _inRegs.emplace_back();
-    std::vector<RegisterId>& inRegsCur = _inRegs.back();
+  try {
+    for (_pos = 0; _pos < n; ++_pos) {
+      buildExpressions();
 
-    std::unordered_set<Variable*>&& inVars = expression->variables();
+      std::string const key = batchedLookupKey();
+      auto it = distinct.find(key);
 
-    for (auto const& v : inVars) {
-      inVarsCur.emplace_back(v);
-      auto it = getPlanNode()->getRegisterPlan()->varInfo.find(v->id);
-      TRI_ASSERT(it != getPlanNode()->getRegisterPlan()->varInfo.end());
-      TRI_ASSERT(it->second.registerId < ExecutionNode::MaxRegisterId);
-      inRegsCur.emplace_back(it->second.registerId);
-    }
-  };
+      if (it != distinct.end()) {
+        // same bounds as an earlier row in this block
+        _batchedRows.emplace_back((*it).second);
+        continue;
+      }
 
-  // Get the ranges from the node:
-  auto en = static_cast<IndexRangeNode const*>(getPlanNode());
-  std::vector<std::vector<RangeInfo>> const& orRanges = en->_ranges;
+      // first occurrence of these bounds: fetch all matching documents now
+      _documents.clear();
+      _coveringSubObjects.clear();
+
+      if (_condition != nullptr && ! _condition->empty()) {
+        _posInRanges = 0;
+
+        if (isEdgeIndex) {
+          getEdgeIndexIterator(_condition->at(_posInRanges));
+
+          while (_edgeIndexIterator != nullptr) {
+            readEdgeIndex(DefaultBatchSize);
+          }
+        }
+        else {
+          getHashIndexIterator(_condition->at(_posInRanges));
+
+          while (_hashIndexSearchValue._values != nullptr) {
+            readHashIndex(DefaultBatchSize);
+          }
+        }
+      }
+
+      size_t const position = _batchedResults.size();
+      _batchedResults.emplace_back(std::move(_documents));
+      _documents.clear();
+      _batchedSubObjects.emplace_back(std::move(_coveringSubObjects));
+      _coveringSubObjects.clear();
+
+      distinct.emplace(key, position);
+      _batchedRows.emplace_back(position);
+    }
+  }
+  catch (...) {
+    _pos = oldPos;
+    throw;
+  }
+
+  _pos = oldPos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a string key identifying the evaluated _condition
+////////////////////////////////////////////////////////////////////////////////
+
+std::string IndexRangeBlock::batchedLookupKey () const {
+  std::string key;
+
+  if (_condition == nullptr) {
+    return key;
+  }
+
+  // only the low bounds are relevant because hash and edge indexes
+  // support equality conditions only
+  for (auto const& andCondition : *_condition) {
+    for (auto const& ri : andCondition) {
+      key.append(ri._attr);
+      key.push_back('=');
+
+      auto const json = ri._lowConst.bound().json();
+
+      if (json == nullptr) {
+        key.push_back('-');
+      }
+      else {
+        key.append(JsonHelper::toString(json));
+      }
+      key.push_back('&');
+    }
+    key.push_back('|');
+  }
+
+  return key;
+}
+
+int IndexRangeBlock::initialize () {
+  ENTER_BLOCK
+  int res = ExecutionBlock::initialize();
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    if (_trx->orderDitch(_trx->trxCollection(_collection->cid())) == nullptr) {
+      res = TRI_ERROR_OUT_OF_MEMORY;
+    }
+  }
+
+  _allVariableBoundExpressions.clear();
+
+  // instanciate expressions:
+  auto instanciateExpression = [&] (RangeInfoBound const& b) -> void {
+    AstNode const* a = b.getExpressionAst(_engine->getQuery()->ast());
+    Expression* expression = nullptr;
+ 
+    {
+      // all new AstNodes are registered with the Ast in the Query
+      std::unique_ptr<Expression> e(new Expression(_engine->getQuery()->ast(), a));
+
+      TRI_IF_FAILURE("IndexRangeBlock::initialize") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+
+      _allVariableBoundExpressions.emplace_back(e.get());
+      expression = e.release();
+    }
+
+    // Prepare _inVars and _inRegs:
+    _inVars.emplace_back();
+    std::vector<Variable*>& inVarsCur = _inVars.back();
+    _inRegs.emplace_back();
+    std::vector<RegisterId>& inRegsCur = _inRegs.back();
+
+    std::unordered_set<Variable*>&& inVars = expression->variables();
+
+    for (auto const& v : inVars) {
+      inVarsCur.emplace_back(v);
+      auto it = getPlanNode()->getRegisterPlan()->varInfo.find(v->id);
+      TRI_ASSERT(it != getPlanNode()->getRegisterPlan()->varInfo.end());
+      TRI_ASSERT(it->second.registerId < ExecutionNode::MaxRegisterId);
+      inRegsCur.emplace_back(it->second.registerId);
+    }
+  };
+
+  // Get the ranges from the node:
+  auto en = static_cast<IndexRangeNode const*>(getPlanNode());
+  std::vector<std::vector<RangeInfo>> const& orRanges = en->_ranges;
   
   for (size_t i = 0; i < orRanges.size(); i++) {
     if (! _allBoundsConstant[i]) {
@@ -1442,9 +2001,11 @@ bool IndexRangeBlock::initRanges () {
   ENTER_BLOCK
   _flag = true; 
 
-  // Find out about the actual values for the bounds in the variable bound case:
+  // Find out about the actual values for the bounds in the variable bound case.
+  // In batched mode, this is done for all rows at once when a new input block
+  // is started, and the results for the following rows are already known
 
-  if (_anyBoundVariable) {
+  if (_anyBoundVariable && (! _useBatchedLookups || _pos == 0)) {
     if (_hasV8Expression) {
       bool const isRunningInCluster = triagens::arango::ServerState::instance()->isRunningInCluster();
 
@@ -1472,13 +2033,30 @@ bool IndexRangeBlock::initRanges () {
       ISOLATE;
       v8::HandleScope scope(isolate); // do not delete this!
     
-      buildExpressions();
+      if (_useBatchedLookups) {
+        buildBatchedLookups();
+      }
+      else {
+        buildExpressions();
+      }
     }
     else {
       // no V8 context required!
-      buildExpressions();
+      if (_useBatchedLookups) {
+        buildBatchedLookups();
+      }
+      else {
+        buildExpressions();
+      }
     }
   }
+
+  if (_useBatchedLookups) {
+    // the documents for the current row have already been looked up.
+    // an empty result for a row does not mean that later rows are empty, too
+    TRI_ASSERT(_pos < _batchedRows.size());
+    return true;
+  }
   
   auto en = static_cast<IndexRangeNode const*>(getPlanNode());
   TRI_ASSERT(en->_index != nullptr);
@@ -1778,10 +2356,24 @@ bool IndexRangeBlock::readIndex (size_t atMost) {
   else { 
     _documents.clear();
   }
+  _coveringSubObjects.clear();
   
   auto en = static_cast<IndexRangeNode const*>(getPlanNode());
   
-  if (en->_index->type == triagens::arango::Index::TRI_IDX_TYPE_PRIMARY_INDEX) {
+  if (_useBatchedLookups) {
+    // the whole result for the current row was fetched in initRanges
+    if (_flag) {
+      TRI_ASSERT(_pos < _batchedRows.size());
+      auto const& found = _batchedResults[_batchedRows[_pos]];
+      _documents.assign(found.begin(), found.end());
+
+      if (_covering) {
+        auto const& subObjects = _batchedSubObjects[_batchedRows[_pos]];
+        _coveringSubObjects.assign(subObjects.begin(), subObjects.end());
+      }
+    }
+  }
+  else if (en->_index->type == triagens::arango::Index::TRI_IDX_TYPE_PRIMARY_INDEX) {
     if (_flag && _condition != nullptr) {
       readPrimaryIndex(*_condition);
     }
@@ -1887,7 +2479,7 @@ AqlItemBlock* IndexRangeBlock::getSome (size_t atLeast,
 
     if (toSend > 0) {
 
-      res.reset(new AqlItemBlock(toSend,
+      res.reset(new AqlItemBlock(resourceMonitor(), toSend,
             getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
       // automatically freed should we throw
@@ -1897,8 +2489,11 @@ AqlItemBlock* IndexRangeBlock::getSome (size_t atLeast,
       inheritRegisters(cur, res.get(), _pos);
 
       // set our collection for our output register
-      res->setDocumentCollection(static_cast<triagens::aql::RegisterId>(curRegs),
-          _trx->documentCollection(_collection->cid()));
+      auto document = _trx->documentCollection(_collection->cid());
+      res->setDocumentCollection(static_cast<triagens::aql::RegisterId>(curRegs), document);
+
+      StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+      TRI_ASSERT(! _covering || _coveringSubObjects.size() == _documents.size() * _coveringFields);
 
       for (size_t j = 0; j < toSend; j++) {
         if (j > 0) {
@@ -1913,9 +2508,30 @@ AqlItemBlock* IndexRangeBlock::getSome (size_t atLeast,
         // The result is in the first variable of this depth,
         // we do not need to do a lookup in getPlanNode()->_registerPlan->varInfo,
         // but can just take cur->getNrRegs() as registerId:
-        res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs),
-                      AqlValue(reinterpret_cast<TRI_df_marker_t
-                               const*>(_documents[_posInDocs++].getDataPtr())));
+        size_t const position = _posInDocs++;
+        auto marker = reinterpret_cast<TRI_df_marker_t const*>(_documents[position].getDataPtr());
+
+        if (_projection.empty()) {
+          res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs), AqlValue(marker));
+        }
+        else {
+          // only produce the attributes that are used later
+          AqlValue a;
+          if (_covering) {
+            // read them from the index element, not from the document
+            a = coverDocument(&_documents[position], &_coveringSubObjects[position * _coveringFields], document->getShaper(), buffer);
+          }
+          else {
+            a = projectDocument(_trx, document, marker, _projection, buffer);
+          }
+          try {
+            res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs), a);
+          }
+          catch (...) {
+            a.destroy();
+            throw;
+          }
+        }
         // No harm done, if the setValue throws!
       }
     }
@@ -2292,7 +2908,12 @@ void IndexRangeBlock::readHashIndex (size_t atMost) {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
 
-    static_cast<triagens::arango::HashIndex*>(idx)->lookup(&_hashIndexSearchValue, _documents, _hashNextElement, atMost);
+    if (_covering) {
+      static_cast<triagens::arango::HashIndex*>(idx)->lookup(&_hashIndexSearchValue, _documents, _coveringSubObjects, _hashNextElement, atMost);
+    }
+    else {
+      static_cast<triagens::arango::HashIndex*>(idx)->lookup(&_hashIndexSearchValue, _documents, _hashNextElement, atMost);
+    }
     size_t const numRead = _documents.size() - n;
 
     _engine->_stats.scannedIndex += static_cast<int64_t>(numRead);
@@ -2464,6 +3085,12 @@ void IndexRangeBlock::readSkiplistIndex (size_t atMost) {
         }
         
         _documents.emplace_back(*(indexElement->_document));
+
+        if (_covering) {
+          // copy the sub-objects, the element may be freed by a modification
+          TRI_shaped_sub_t const* subObjects = SkiplistIndex_Subobjects(indexElement);
+          _coveringSubObjects.insert(_coveringSubObjects.end(), subObjects, subObjects + _coveringFields);
+        }
         ++nrSent;
         ++_engine->_stats.scannedIndex;
       }
@@ -2479,6 +3106,57 @@ void IndexRangeBlock::readSkiplistIndex (size_t atMost) {
   LEAVE_BLOCK;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the projection of a document from the sub-objects of its
+/// index element. short values are stored inline in the sub-objects, so only
+/// longer values and the _key are read from the document
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue IndexRangeBlock::coverDocument (TRI_doc_mptr_t const* mptr,
+                                         TRI_shaped_sub_t const* subObjects,
+                                         TRI_shaper_t* shaper,
+                                         StringBuffer& buffer) const {
+  size_t const n = _projection.size();
+  TRI_ASSERT(_coveringPositions.size() == n);
+
+  std::unique_ptr<Json> json(new Json(Json::Object, n));
+
+  for (size_t i = 0; i < n; ++i) {
+    char const* name = _projection[i].c_str();
+    size_t const position = _coveringPositions[i];
+
+    if (position == CoveringKeyPosition) {
+      json->set(name, Json(TRI_UNKNOWN_MEM_ZONE, TRI_EXTRACT_MARKER_KEY(mptr)));
+    }
+    else if (position == CoveringRevPosition) {
+      buffer.reset();
+      buffer.appendInteger(mptr->_rid);
+      json->set(name, Json(TRI_UNKNOWN_MEM_ZONE, buffer.c_str(), buffer.length()));
+    }
+    else {
+      TRI_shaped_sub_t const* sub = &subObjects[position];
+      char const* data;
+      size_t length;
+      TRI_InspectShapedSub(sub, mptr, data, length);
+
+      TRI_shaped_json_t shaped;
+      shaped._sid = sub->_sid;
+      shaped._data.data = const_cast<char*>(data);
+      shaped._data.length = static_cast<uint32_t>(length);
+
+      TRI_json_t* value = TRI_JsonShapedJson(shaper, &shaped);
+
+      if (value == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      json->set(name, Json(TRI_UNKNOWN_MEM_ZONE, value));
+    }
+  }
+
+  return AqlValue(json.release());
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                          class EnumerateListBlock
 // -----------------------------------------------------------------------------
@@ -2603,7 +3281,7 @@ AqlItemBlock* EnumerateListBlock::getSome (size_t, size_t atMost) {
       size_t toSend = (std::min)(atMost, sizeInVar - _index);
 
       // create the result
-      res.reset(new AqlItemBlock(toSend, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+      res.reset(new AqlItemBlock(resourceMonitor(), toSend, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
       inheritRegisters(cur, res.get(), _pos);
 
@@ -2783,106 +3461,935 @@ void EnumerateListBlock::throwArrayExpectedException () {
 }
 
 // -----------------------------------------------------------------------------
-// --SECTION--                                            class CalculationBlock
+// --SECTION--                                               class HashJoinBlock
 // -----------------------------------------------------------------------------
-        
-CalculationBlock::CalculationBlock (ExecutionEngine* engine,
-                                    CalculationNode const* en)
-  : ExecutionBlock(engine, en),
-    _expression(en->expression()),
-    _inVars(),
-    _inRegs(),
-    _outReg(ExecutionNode::MaxRegisterId) {
 
-  std::unordered_set<Variable*> const& inVars = _expression->variables();
-  _inVars.reserve(inVars.size());
-  _inRegs.reserve(inVars.size());
+HashJoinBlock::HashJoinBlock (ExecutionEngine* engine,
+                              HashJoinNode const* en)
+  : ExecutionBlock(engine, en),
+    _collection(en->_collection),
+    _attribute(en->_attribute),
+    _inRegister(ExecutionNode::MaxRegisterId),
+    _hashTable(1024, JoinKeyHash(_trx), JoinKeyEqual(_trx)),
+    _hashTableMemory(resourceMonitor()),
+    _hashTableBuilt(false),
+    _matches(nullptr),
+    _noMatches(),
+    _posInMatches(0),
+    _mustStoreResult(true) {
 
-  for (auto it = inVars.begin(); it != inVars.end(); ++it) {
-    _inVars.emplace_back(*it);
-    auto it2 = en->getRegisterPlan()->varInfo.find((*it)->id);
+  auto it = en->getRegisterPlan()->varInfo.find(en->_inVariable->id);
 
-    TRI_ASSERT(it2 != en->getRegisterPlan()->varInfo.end());
-    TRI_ASSERT(it2->second.registerId < ExecutionNode::MaxRegisterId);
-    _inRegs.emplace_back(it2->second.registerId);
+  if (it == en->getRegisterPlan()->varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
   }
 
-  // check if the expression is "only" a reference to another variable
-  // this allows further optimizations inside doEvaluation
-  _isReference = (_expression->node()->type == NODE_TYPE_REFERENCE);
+  _inRegister = (*it).second.registerId;
+  TRI_ASSERT(_inRegister < ExecutionNode::MaxRegisterId);
 
-  if (_isReference) {
-    TRI_ASSERT(_inRegs.size() == 1);
+  auto trxCollection = _trx->trxCollection(_collection->cid());
+  if (trxCollection != nullptr) {
+    _trx->orderDitch(trxCollection);
   }
+}
 
-  auto it3 = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
-  TRI_ASSERT(it3 != en->getRegisterPlan()->varInfo.end());
-  _outReg = it3->second.registerId;
-  TRI_ASSERT(_outReg < ExecutionNode::MaxRegisterId);
-  
-  if (en->_conditionVariable != nullptr) {
-    auto it = en->getRegisterPlan()->varInfo.find(en->_conditionVariable->id);
-    TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
-    _conditionReg = it->second.registerId;
-    TRI_ASSERT(_conditionReg < ExecutionNode::MaxRegisterId);
+HashJoinBlock::~HashJoinBlock () {
+  for (auto& it : _hashTable) {
+    // we own the keys
+    const_cast<AqlValue&>(it.first).destroy();
   }
 }
 
-CalculationBlock::~CalculationBlock () {
-}
+int HashJoinBlock::initialize () {
+  auto ep = static_cast<HashJoinNode const*>(_exeNode);
+  _mustStoreResult = ep->isVarUsedLater(ep->_outVariable);
 
-int CalculationBlock::initialize () {
   return ExecutionBlock::initialize();
 }
 
+int HashJoinBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
+  int res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  // the hash table is kept, as the collection does not change during the query
+  _matches = nullptr;
+  _posInMatches = 0;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief fill the target register in the item block with a reference to 
-/// another variable
+/// @brief read all documents of the collection into the hash table
 ////////////////////////////////////////////////////////////////////////////////
 
-void CalculationBlock::fillBlockWithReference (AqlItemBlock* result) {
-  result->setDocumentCollection(_outReg, result->getDocumentCollection(_inRegs[0]));
+void HashJoinBlock::buildHashTable () {
+  TRI_ASSERT(! _hashTableBuilt);
 
-  size_t const n = result->size();
-  for (size_t i = 0; i < n; i++) {
-    // need not clone to avoid a copy, the AqlItemBlock's hash takes
-    // care of correct freeing:
-    auto a = result->getValueReference(i, _inRegs[0]);
+  auto trxCollection = _trx->trxCollection(_collection->cid());
+  auto document = _trx->documentCollection(_collection->cid());
+  LinearCollectionScanner scanner(_trx, trxCollection);
 
-    try {
-      TRI_IF_FAILURE("CalculationBlock::fillBlockWithReference") {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-      }
-      result->setValue(i, _outReg, a);
+  std::vector<TRI_doc_mptr_copy_t> documents;
+  documents.reserve(DefaultBatchSize);
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+
+  while (true) {
+    throwIfKilled(); // check if we were aborted
+
+    TRI_IF_FAILURE("HashJoinBlock::buildHashTable") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
-    catch (...) {
-      a.destroy();
-      throw;
+
+    documents.clear();
+    int res = scanner.scan(documents, DefaultBatchSize);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
     }
+
+    if (documents.empty()) {
+      break;
+    }
+
+    _engine->_stats.scannedFull += static_cast<int64_t>(documents.size());
+
+    // the memory for the batch is charged at once
+    size_t batchMemory = documents.size() * sizeof(TRI_df_marker_t const*);
+
+    for (auto const& it : documents) {
+      auto marker = reinterpret_cast<TRI_df_marker_t const*>(it.getDataPtr());
+      AqlValue key(new Json(extractKey(marker, document, buffer)));
+
+      auto found = _hashTable.find(key);
+
+      if (found != _hashTable.end()) {
+        key.destroy();
+        (*found).second.emplace_back(marker);
+        continue;
+      }
+
+      batchMemory += sizeof(HashTable::value_type) + key.ownMemoryUsage();
+
+      try {
+        _hashTable.emplace(key, std::vector<TRI_df_marker_t const*>{ marker });
+      }
+      catch (...) {
+        key.destroy();
+        throw;
+      }
+    }
+
+    _hashTableMemory.increase(batchMemory);
   }
+
+  _hashTableBuilt = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief shared code for executing a simple or a V8 expression
+/// @brief extract the join attribute value from a document
+/// returns null if the attribute does not exist
 ////////////////////////////////////////////////////////////////////////////////
 
-void CalculationBlock::executeExpression (AqlItemBlock* result) {
-  result->setDocumentCollection(_outReg, nullptr);
+Json HashJoinBlock::extractKey (TRI_df_marker_t const* marker,
+                                TRI_document_collection_t const* document,
+                                StringBuffer& buffer) {
+  AqlValue value(marker);
+  Json json = value.extractObjectMember(_trx, document, _attribute[0].c_str(), true, buffer);
 
-  bool const hasCondition = (static_cast<CalculationNode const*>(_exeNode)->_conditionVariable != nullptr);
+  if (_attribute.size() == 1) {
+    return json;
+  }
 
-  size_t const n = result->size();
+  // sub-attributes
+  TRI_json_t const* sub = json.json();
 
-  for (size_t i = 0; i < n; i++) {
-    // check the condition variable (if any)
-    if (hasCondition) {
-      AqlValue conditionResult = result->getValueReference(i, _conditionReg);
+  for (size_t i = 1; i < _attribute.size(); ++i) {
+    if (! TRI_IsObjectJson(sub)) {
+      return Json(Json::Null);
+    }
 
-      if (! conditionResult.isTrue()) {
+    sub = TRI_LookupObjectJson(sub, _attribute[i].c_str());
+
+    if (sub == nullptr) {
+      return Json(Json::Null);
+    }
+  }
+
+  return Json(TRI_UNKNOWN_MEM_ZONE, TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, sub));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the documents matching a value
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<TRI_df_marker_t const*> const* HashJoinBlock::lookup (AqlValue const& value,
+                                                                  TRI_document_collection_t const* document) {
+  if (value._type == AqlValue::JSON) {
+    auto it = _hashTable.find(value);
+
+    if (it == _hashTable.end()) {
+      return &_noMatches;
+    }
+    return &((*it).second);
+  }
+
+  // all other value types are converted to JSON first, so they are hashed
+  // and compared in the same way as the keys in the hash table
+  AqlValue key(new Json(value.toJson(_trx, document, true)));
+  std::vector<TRI_df_marker_t const*> const* result = &_noMatches;
+
+  try {
+    auto it = _hashTable.find(key);
+
+    if (it != _hashTable.end()) {
+      result = &((*it).second);
+    }
+  }
+  catch (...) {
+    key.destroy();
+    throw;
+  }
+
+  key.destroy();
+  return result;
+}
+
+AqlItemBlock* HashJoinBlock::getSome (size_t, // atLeast
+                                      size_t atMost) {
+  if (_done) {
+    return nullptr;
+  }
+
+  if (! _hashTableBuilt) {
+    buildHashTable();
+  }
+
+  std::unique_ptr<AqlItemBlock> res;
+  size_t send = 0;
+  RegisterId const nrRegs = getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()];
+
+  while (send < atMost) {
+    if (_buffer.empty()) {
+      size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+      if (! ExecutionBlock::getBlock(toFetch, toFetch)) {
+        _done = true;
+        break;
+      }
+      _pos = 0;           // this is in the first block
+      _matches = nullptr;
+    }
+
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    RegisterId const curRegs = cur->getNrRegs();
+
+    if (_matches == nullptr) {
+      _matches = lookup(cur->getValueReference(_pos, _inRegister), cur->getDocumentCollection(_inRegister));
+      _posInMatches = 0;
+    }
+
+    if (_posInMatches < _matches->size()) {
+      if (res.get() == nullptr) {
+        res.reset(requestBlock(atMost, nrRegs));
+        TRI_ASSERT(curRegs <= res->getNrRegs());
+        // set our collection for our output register
+        res->setDocumentCollection(curRegs, _trx->documentCollection(_collection->cid()));
+      }
+
+      size_t const toSend = (std::min)(atMost - send, _matches->size() - _posInMatches);
+      size_t const first = send;
+
+      for (size_t j = 0; j < toSend; j++) {
+        if (j == 0) {
+          inheritRegisters(cur, res.get(), _pos, send);
+        }
+        else {
+          // re-use already copied aqlvalues
+          for (RegisterId i = 0; i < curRegs; i++) {
+            res->setValue(send, i, res->getValueReference(first, i));
+            // Note: if this throws, then all values will be deleted
+            // properly since the first one is.
+          }
+        }
+
+        if (_mustStoreResult) {
+          res->setShaped(send, curRegs, (*_matches)[_posInMatches]);
+        }
+
+        ++_posInMatches;
+        ++send;
+      }
+    }
+
+    if (_posInMatches >= _matches->size()) {
+      // advance read position in the current block
+      _matches = nullptr;
+
+      if (++_pos >= cur->size()) {
+        _buffer.pop_front();  // does not throw
+        returnBlock(cur);
+        _pos = 0;
+      }
+    }
+  }
+
+  if (send == 0) {
+    return nullptr;
+  }
+
+  if (send < atMost) {
+    res->shrink(send);
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+
+  return res.release();
+}
+
+size_t HashJoinBlock::skipSome (size_t atLeast, size_t atMost) {
+  size_t skipped = 0;
+
+  while (skipped < atLeast) {
+    std::unique_ptr<AqlItemBlock> res(getSome(atLeast - skipped, atMost - skipped));
+
+    if (res.get() == nullptr) {
+      break;
+    }
+
+    skipped += res->size();
+  }
+
+  return skipped;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              class TraversalBlock
+// -----------------------------------------------------------------------------
+
+TraversalBlock::TraversalBlock (ExecutionEngine* engine,
+                                TraversalNode const* en)
+  : ExecutionBlock(engine, en),
+    _edgeCollection(en->_edgeCollection),
+    _edgeDocument(nullptr),
+    _direction(en->_direction),
+    _options(en->_options),
+    _inRegister(ExecutionNode::MaxRegisterId),
+    _vertexRegister(ExecutionNode::MaxRegisterId),
+    _edgeRegister(ExecutionNode::MaxRegisterId),
+    _pathRegister(ExecutionNode::MaxRegisterId),
+    _pathConditions(),
+    _conditionVariables(),
+    _conditionRegisters(),
+    _path(),
+    _traversalStarted(false),
+    _hasVertex(false),
+    _mustStoreVertex(true),
+    _mustStoreEdge(false),
+    _mustStorePath(false) {
+
+  auto const& varInfo = en->getRegisterPlan()->varInfo;
+
+  auto findRegister = [&varInfo] (Variable const* variable) -> RegisterId {
+    auto it = varInfo.find(variable->id);
+
+    if (it == varInfo.end()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+    }
+
+    TRI_ASSERT((*it).second.registerId < ExecutionNode::MaxRegisterId);
+    return (*it).second.registerId;
+  };
+
+  _inRegister = findRegister(en->_inVariable);
+  _vertexRegister = findRegister(en->_vertexOutVariable);
+
+  if (en->_edgeOutVariable != nullptr) {
+    _edgeRegister = findRegister(en->_edgeOutVariable);
+  }
+  if (en->_pathOutVariable != nullptr) {
+    _pathRegister = findRegister(en->_pathOutVariable);
+  }
+
+  // group the path conditions by the path length at which they are checked.
+  // conditions that refer to a path longer than the maximum depth can never
+  // be checked and are ignored
+  for (auto const& it : en->_pathConditions) {
+    if (it.depth > _options.maxDepth) {
+      continue;
+    }
+    if (_pathConditions.size() <= it.depth) {
+      _pathConditions.resize(it.depth + 1);
+    }
+    it.expression->setJsonArena(engine->getQuery()->jsonArena());
+    _pathConditions[it.depth].emplace_back(it.expression);
+  }
+
+  if (! _pathConditions.empty()) {
+    TRI_ASSERT(en->_pathOutVariable != nullptr);
+    // the conditions are evaluated against a block with a single register
+    // containing the path
+    _conditionVariables.emplace_back(const_cast<Variable*>(en->_pathOutVariable));
+    _conditionRegisters.emplace_back(0);
+  }
+
+  if (! _edgeCollection->isEdgeCollection()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID, 
+                                   "collection '" + _edgeCollection->getName() + "' used in traversal is not an edge collection");
+  }
+
+  auto trxCollection = _trx->trxCollection(_edgeCollection->cid());
+  if (trxCollection != nullptr) {
+    _trx->orderDitch(trxCollection);
+  }
+
+  _edgeDocument = _trx->documentCollection(_edgeCollection->cid());
+}
+
+TraversalBlock::~TraversalBlock () {
+  clearPath();
+}
+
+int TraversalBlock::initialize () {
+  auto ep = static_cast<TraversalNode const*>(_exeNode);
+  _mustStoreVertex = ep->isVarUsedLater(ep->_vertexOutVariable);
+  _mustStoreEdge = (ep->_edgeOutVariable != nullptr && ep->isVarUsedLater(ep->_edgeOutVariable));
+  _mustStorePath = (ep->_pathOutVariable != nullptr && ep->isVarUsedLater(ep->_pathOutVariable));
+
+  return ExecutionBlock::initialize();
+}
+
+int TraversalBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
+  int res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  clearPath();
+  _traversalStarted = false;
+  _hasVertex = false;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start a new traversal from the vertex in the current input row.
+/// the start vertex can be specified as a document id string or as a 
+/// document with an _id attribute. returns false if the value does not 
+/// denote a vertex
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::startTraversal (AqlValue const& value,
+                                     TRI_document_collection_t const* document) {
+  clearPath();
+
+  Json start = value.toJson(_trx, document, false);
+  TRI_json_t const* json = start.json();
+
+  if (TRI_IsObjectJson(json)) {
+    json = TRI_LookupObjectJson(json, TRI_VOC_ATTRIBUTE_ID);
+  }
+
+  if (! TRI_IsStringJson(json)) {
+    return false;
+  }
+
+  std::string const id(json->_value._string.data, json->_value._string.length - 1);
+  size_t const split = id.find('/');
+
+  if (split == std::string::npos ||
+      split == 0 ||
+      split + 1 == id.size()) {
+    return false;
+  }
+
+  TRI_voc_cid_t cid = _trx->resolver()->getCollectionId(id.substr(0, split));
+
+  if (cid == 0) {
+    return false;
+  }
+
+  return pushStep(cid, id.c_str() + split + 1, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advance the traversal to the next vertex that must be returned.
+/// the traversal is depth-first, so only the edges of the vertices on the
+/// current path are kept in memory
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::nextVertex () {
+  while (! _path.empty()) {
+    auto& step = _path.back();
+
+    if (_path.size() - 1 < _options.maxDepth) {
+      if (! step.edgesLoaded) {
+        step.edges = TRI_LookupEdgesDocumentCollection(_edgeDocument, _direction, step.cid, const_cast<char*>(step.key.c_str()));
+        step.edgesLoaded = true;
+        _engine->_stats.scannedIndex += static_cast<int64_t>(step.edges.size());
+      }
+
+      if (step.position < step.edges.size()) {
+        auto edge = static_cast<TRI_df_marker_t const*>(step.edges[step.position++].getDataPtr());
+
+        TRI_voc_cid_t cid;
+        char const* key;
+
+        if (_direction == TRI_EDGE_OUT ||
+            (_direction == TRI_EDGE_ANY && 
+             TRI_EXTRACT_MARKER_FROM_CID(edge) == step.cid &&
+             step.key == TRI_EXTRACT_MARKER_FROM_KEY(edge))) {
+          cid = TRI_EXTRACT_MARKER_TO_CID(edge);
+          key = TRI_EXTRACT_MARKER_TO_KEY(edge);
+        }
+        else {
+          cid = TRI_EXTRACT_MARKER_FROM_CID(edge);
+          key = TRI_EXTRACT_MARKER_FROM_KEY(edge);
+        }
+
+        // note: step must not be used after this call, as the path may
+        // have been reallocated
+        if (pushStep(cid, key, edge) && 
+            _path.size() - 1 >= _options.minDepth) {
+          return true;
+        }
+        continue;
+      }
+    }
+
+    // all edges of the vertex have been followed
+    popStep();
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief try to extend the current path with a vertex, returns false if
+/// this is prohibited by the uniqueness options or a path condition
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::pushStep (TRI_voc_cid_t cid,
+                               char const* key,
+                               TRI_df_marker_t const* edge) {
+  if (edge != nullptr &&
+      _options.uniqueEdges == TraversalOptions::UNIQUENESS_PATH) {
+    for (auto const& it : _path) {
+      if (it.edge == edge) {
+        return false;
+      }
+    }
+  }
+
+  if (_options.uniqueVertices == TraversalOptions::UNIQUENESS_PATH) {
+    for (auto const& it : _path) {
+      if (it.cid == cid && it.key == key) {
+        return false;
+      }
+    }
+  }
+
+  _path.emplace_back(cid, key, edge);
+
+  if (! checkPathConditions()) {
+    popStep();
+    return false;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove the last step from the current path
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::popStep () {
+  TRI_ASSERT(! _path.empty());
+
+  auto& step = _path.back();
+
+  if (step.vertex != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, step.vertex);
+  }
+
+  _path.pop_back();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all steps from the current path
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::clearPath () {
+  while (! _path.empty()) {
+    popStep();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check the path conditions for the current path length. the 
+/// conditions only refer to path elements up to the current length, so if 
+/// they fail, no longer path with the same prefix can satisfy them either
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::checkPathConditions () {
+  size_t const depth = _path.size() - 1;
+
+  if (depth >= _pathConditions.size() ||
+      _pathConditions[depth].empty()) {
+    return true;
+  }
+
+  std::unique_ptr<AqlItemBlock> block(new AqlItemBlock(resourceMonitor(), 1, 1));
+  AqlValue path(new Json(buildPath()));
+
+  try {
+    block->setValue(0, 0, path);
+  }
+  catch (...) {
+    path.destroy();
+    throw;
+  }
+
+  for (auto const& expression : _pathConditions[depth]) {
+    TRI_document_collection_t const* myCollection = nullptr;
+    AqlValue result = expression->execute(_trx, block.get(), 0, _conditionVariables, _conditionRegisters, &myCollection);
+    bool const isTrue = result.isTrue();
+    result.destroy();
+
+    if (! isTrue) {
+      _engine->_stats.filtered++;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the vertex document of a path step, null if the vertex
+/// does not exist. the vertex collection is added to the transaction on
+/// first use
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t const* TraversalBlock::vertexDocument (PathStep& step) {
+  if (step.vertex != nullptr) {
+    return step.vertex;
+  }
+
+  auto trxCollection = _trx->trxCollectionAtRuntime(step.cid);
+
+  if (trxCollection == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_TRANSACTION_UNREGISTERED_COLLECTION, 
+                                   "vertex collection '" + _trx->resolver()->getCollectionName(step.cid) + "' cannot be used in traversal");
+  }
+
+  TRI_doc_mptr_copy_t mptr;
+  int res = _trx->readSingle(trxCollection, &mptr, step.key);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    AqlValue value(static_cast<TRI_df_marker_t const*>(mptr.getDataPtr()));
+    step.vertex = value.toJson(_trx, trxCollection->_collection->_collection, true).steal();
+  }
+  else if (res == TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
+    // dangling edge
+    step.vertex = TRI_CreateNullJson(TRI_UNKNOWN_MEM_ZONE);
+  }
+  else {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  if (step.vertex == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return step.vertex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the path object for the current path
+////////////////////////////////////////////////////////////////////////////////
+
+Json TraversalBlock::buildPath () {
+  Json vertices(Json::Array, _path.size());
+  Json edges(Json::Array, _path.size());
+
+  for (auto& step : _path) {
+    vertices(Json(TRI_UNKNOWN_MEM_ZONE, TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, vertexDocument(step))));
+
+    if (step.edge != nullptr) {
+      AqlValue edge(step.edge);
+      edges(edge.toJson(_trx, _edgeDocument, true));
+    }
+  }
+
+  Json path(Json::Object, 2);
+  path("vertices", vertices)
+      ("edges", edges);
+
+  return path;
+}
+
+AqlItemBlock* TraversalBlock::getSome (size_t, // atLeast
+                                       size_t atMost) {
+  if (_done) {
+    return nullptr;
+  }
+
+  std::unique_ptr<AqlItemBlock> res;
+  size_t send = 0;
+  // first output row produced for the current input row in res
+  size_t first = send;
+  bool inherited = false;
+  RegisterId const nrRegs = getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()];
+
+  while (send < atMost) {
+    if (_buffer.empty()) {
+      size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+      if (! ExecutionBlock::getBlock(toFetch, toFetch)) {
+        _done = true;
+        break;
+      }
+      _pos = 0;           // this is in the first block
+      _traversalStarted = false;
+    }
+
+    // if we make it here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    RegisterId const curRegs = cur->getNrRegs();
+
+    throwIfKilled(); // check if we were aborted
+
+    if (! _traversalStarted) {
+      _traversalStarted = true;
+      _hasVertex = startTraversal(cur->getValueReference(_pos, _inRegister), cur->getDocumentCollection(_inRegister));
+
+      if (_hasVertex && _options.minDepth > 0) {
+        _hasVertex = nextVertex();
+      }
+    }
+
+    if (_hasVertex) {
+      if (res.get() == nullptr) {
+        res.reset(requestBlock(atMost, nrRegs));
+        TRI_ASSERT(curRegs <= res->getNrRegs());
+
+        if (_edgeRegister != ExecutionNode::MaxRegisterId) {
+          res->setDocumentCollection(_edgeRegister, _edgeDocument);
+        }
+      }
+
+      if (! inherited) {
+        inheritRegisters(cur, res.get(), _pos, send);
+        first = send;
+        inherited = true;
+      }
+      else {
+        // re-use already copied aqlvalues
+        for (RegisterId i = 0; i < curRegs; i++) {
+          res->setValue(send, i, res->getValueReference(first, i));
+          // Note: if this throws, then all values will be deleted
+          // properly since the first one is.
+        }
+      }
+
+      auto& step = _path.back();
+
+      if (_mustStoreVertex) {
+        AqlValue vertex(new Json(TRI_UNKNOWN_MEM_ZONE, TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, vertexDocument(step))));
+
+        try {
+          res->setValue(send, _vertexRegister, vertex);
+        }
+        catch (...) {
+          vertex.destroy();
+          throw;
+        }
+      }
+
+      if (_mustStoreEdge) {
+        if (step.edge != nullptr) {
+          res->setShaped(send, _edgeRegister, step.edge);
+        }
+        else {
+          // the start vertex has no edge
+          res->setValue(send, _edgeRegister, AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &Expression::NullJson, Json::NOFREE)));
+        }
+      }
+
+      if (_mustStorePath) {
+        AqlValue path(new Json(buildPath()));
+
+        try {
+          res->setValue(send, _pathRegister, path);
+        }
+        catch (...) {
+          path.destroy();
+          throw;
+        }
+      }
+
+      ++send;
+      _hasVertex = nextVertex();
+    }
+
+    if (! _hasVertex) {
+      // traversal for the current input row is exhausted
+      clearPath();
+      _traversalStarted = false;
+      inherited = false;
+
+      if (++_pos >= cur->size()) {
+        _buffer.pop_front();  // does not throw
+        returnBlock(cur);
+        _pos = 0;
+      }
+    }
+  }
+
+  if (send == 0) {
+    return nullptr;
+  }
+
+  if (send < atMost) {
+    res->shrink(send);
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+
+  return res.release();
+}
+
+size_t TraversalBlock::skipSome (size_t atLeast, size_t atMost) {
+  size_t skipped = 0;
+
+  while (skipped < atLeast) {
+    std::unique_ptr<AqlItemBlock> res(getSome(atLeast - skipped, atMost - skipped));
+
+    if (res.get() == nullptr) {
+      break;
+    }
+
+    skipped += res->size();
+  }
+
+  return skipped;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                            class CalculationBlock
+// -----------------------------------------------------------------------------
+        
+CalculationBlock::CalculationBlock (ExecutionEngine* engine,
+                                    CalculationNode const* en)
+  : ExecutionBlock(engine, en),
+    _expression(en->expression()),
+    _inVars(),
+    _inRegs(),
+    _outReg(ExecutionNode::MaxRegisterId) {
+
+  // the node may belong to the plan of another query (coordinator query
+  // parts), but the values must come from the arena of the executing query
+  _expression->setJsonArena(engine->getQuery()->jsonArena());
+
+  std::unordered_set<Variable*> const& inVars = _expression->variables();
+  _inVars.reserve(inVars.size());
+  _inRegs.reserve(inVars.size());
+
+  for (auto it = inVars.begin(); it != inVars.end(); ++it) {
+    _inVars.emplace_back(*it);
+    auto it2 = en->getRegisterPlan()->varInfo.find((*it)->id);
+
+    TRI_ASSERT(it2 != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT(it2->second.registerId < ExecutionNode::MaxRegisterId);
+    _inRegs.emplace_back(it2->second.registerId);
+  }
+
+  // check if the expression is "only" a reference to another variable
+  // this allows further optimizations inside doEvaluation
+  _isReference = (_expression->node()->type == NODE_TYPE_REFERENCE);
+
+  if (_isReference) {
+    TRI_ASSERT(_inRegs.size() == 1);
+  }
+
+  auto it3 = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
+  TRI_ASSERT(it3 != en->getRegisterPlan()->varInfo.end());
+  _outReg = it3->second.registerId;
+  TRI_ASSERT(_outReg < ExecutionNode::MaxRegisterId);
+  
+  if (en->_conditionVariable != nullptr) {
+    auto it = en->getRegisterPlan()->varInfo.find(en->_conditionVariable->id);
+    TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
+    _conditionReg = it->second.registerId;
+    TRI_ASSERT(_conditionReg < ExecutionNode::MaxRegisterId);
+  }
+}
+
+CalculationBlock::~CalculationBlock () {
+}
+
+int CalculationBlock::initialize () {
+  return ExecutionBlock::initialize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fill the target register in the item block with a reference to 
+/// another variable
+////////////////////////////////////////////////////////////////////////////////
+
+void CalculationBlock::fillBlockWithReference (AqlItemBlock* result) {
+  result->setDocumentCollection(_outReg, result->getDocumentCollection(_inRegs[0]));
+
+  size_t const n = result->size();
+  for (size_t i = 0; i < n; i++) {
+    // need not clone to avoid a copy, the AqlItemBlock's hash takes
+    // care of correct freeing:
+    auto a = result->getValueReference(i, _inRegs[0]);
+
+    try {
+      TRI_IF_FAILURE("CalculationBlock::fillBlockWithReference") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+      result->setValue(i, _outReg, a);
+    }
+    catch (...) {
+      a.destroy();
+      throw;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shared code for executing a simple or a V8 expression
+////////////////////////////////////////////////////////////////////////////////
+
+void CalculationBlock::executeExpression (AqlItemBlock* result) {
+  result->setDocumentCollection(_outReg, nullptr);
+
+  bool const hasCondition = (static_cast<CalculationNode const*>(_exeNode)->_conditionVariable != nullptr);
+
+  if (! hasCondition && executeColumnar(result)) {
+    throwIfKilled(); // check if we were aborted
+    return;
+  }
+
+  size_t const n = result->size();
+
+  for (size_t i = 0; i < n; i++) {
+    // check the condition variable (if any)
+    if (hasCondition) {
+      AqlValue conditionResult = result->getValueReference(i, _conditionReg);
+
+      if (! conditionResult.isTrue()) {
         TRI_IF_FAILURE("CalculationBlock::executeExpressionWithCondition") {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
         }
-        result->setValue(i, _outReg, AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &Expression::NullJson, Json::NOFREE)));
+        result->setValue(i, _outReg, _engine->getQuery()->jsonArena()->createReference(&Expression::NullJson));
         continue;
       }
     }
@@ -2905,6 +4412,44 @@ void CalculationBlock::executeExpression (AqlItemBlock* result) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the expression for all rows of the block at once. all rows
+/// share one true and one false value, so at most two values are allocated
+////////////////////////////////////////////////////////////////////////////////
+
+bool CalculationBlock::executeColumnar (AqlItemBlock* result) {
+  if (! _expression->executeColumnar(_trx, result, _inVars, _inRegs, _columnResults)) {
+    return false;
+  }
+
+  TRI_ASSERT(_columnResults.size() == result->size());
+
+  AqlValue values[2];
+  size_t const n = result->size();
+
+  for (size_t i = 0; i < n; i++) {
+    auto& value = values[_columnResults[i]];
+    bool const isNew = value.isEmpty();
+
+    if (isNew) {
+      value = AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, _columnResults[i] ? &Expression::TrueJson : &Expression::FalseJson, Json::NOFREE));
+    }
+
+    try {
+      result->setValue(i, _outReg, value);
+    }
+    catch (...) {
+      if (isNew) {
+        // the value is not yet owned by the block
+        value.destroy();
+      }
+      throw;
+    }
+  }
+
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief doEvaluation, private helper to do the work
 ////////////////////////////////////////////////////////////////////////////////
@@ -2981,7 +4526,9 @@ SubqueryBlock::SubqueryBlock (ExecutionEngine* engine,
                               ExecutionBlock* subquery)
   : ExecutionBlock(engine, en), 
     _outReg(ExecutionNode::MaxRegisterId),
-    _subquery(subquery) {
+    _subquery(subquery),
+    _subqueryIsConst(const_cast<SubqueryNode*>(en)->isConst()),
+    _constSubqueryResults(nullptr) {
   
   auto it = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
   TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
@@ -2994,6 +4541,9 @@ SubqueryBlock::SubqueryBlock (ExecutionEngine* engine,
 ////////////////////////////////////////////////////////////////////////////////
 
 SubqueryBlock::~SubqueryBlock () {
+  if (_constSubqueryResults != nullptr) {
+    destroySubqueryResults(_constSubqueryResults);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3022,10 +4572,45 @@ AqlItemBlock* SubqueryBlock::getSome (size_t atLeast,
     return nullptr;
   }
 
-  // TODO: constant and deterministic subqueries only need to be executed once
-  bool const subqueryIsConst = false; // TODO 
+  if (_subqueryIsConst) {
+    // a constant subquery is executed only once per query. its result does
+    // not depend on the input rows
+    if (_constSubqueryResults == nullptr) {
+      int ret = _subquery->initializeCursor(res.get(), 0);
+
+      if (ret != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(ret);
+      }
+
+      _constSubqueryResults = executeSubquery();
+      TRI_ASSERT(_constSubqueryResults != nullptr);
+    }
+
+    // the output block owns a copy of the result, which is shared by all of
+    // its rows
+    AqlValue copy = AqlValue(_constSubqueryResults).clone();
+
+    try {
+      TRI_IF_FAILURE("SubqueryBlock::getSome") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+      res->setValue(0, _outReg, copy);
+    }
+    catch (...) {
+      copy.destroy();
+      throw;
+    }
+
+    for (size_t i = 1; i < res->size(); i++) {
+      res->setValue(i, _outReg, copy);
+    }
+
+    throwIfKilled(); // check if we were aborted
 
-  std::vector<AqlItemBlock*>* subqueryResults = nullptr;
+    // Clear out registers no longer needed later:
+    clearRegisters(res.get());
+    return res.release();
+  }
 
   for (size_t i = 0; i < res->size(); i++) {
     int ret = _subquery->initializeCursor(res.get(), i);
@@ -3034,29 +4619,20 @@ AqlItemBlock* SubqueryBlock::getSome (size_t atLeast,
       THROW_ARANGO_EXCEPTION(ret);
     }
 
-    if (i > 0 && subqueryIsConst) {
-      // re-use already calculated subquery result
-      TRI_ASSERT(subqueryResults != nullptr);
-      res->setValue(i, _outReg, AqlValue(subqueryResults));
-    }
-    else {
-      // initial subquery execution or subquery is not constant
-
-      // execute the subquery
-      subqueryResults = executeSubquery();
-      TRI_ASSERT(subqueryResults != nullptr);
+    // execute the subquery
+    auto subqueryResults = executeSubquery();
+    TRI_ASSERT(subqueryResults != nullptr);
 
-      try {
-        TRI_IF_FAILURE("SubqueryBlock::getSome") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-        }
-        res->setValue(i, _outReg, AqlValue(subqueryResults));
-      }
-      catch (...) {
-        destroySubqueryResults(subqueryResults);
-        throw;
+    try {
+      TRI_IF_FAILURE("SubqueryBlock::getSome") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
       }
-    } 
+      res->setValue(i, _outReg, AqlValue(subqueryResults));
+    }
+    catch (...) {
+      destroySubqueryResults(subqueryResults);
+      throw;
+    }
       
     throwIfKilled(); // check if we were aborted
   }
@@ -3352,6 +4928,23 @@ SortedAggregateBlock::SortedAggregateBlock (ExecutionEngine* engine,
     _aggregateRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
   }
 
+  for (auto const& p : en->_aggregateFunctions) {
+    auto itOut = en->getRegisterPlan()->varInfo.find(p.first->id);
+    TRI_ASSERT(itOut != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT((*itOut).second.registerId < ExecutionNode::MaxRegisterId);
+
+    RegisterId inRegister = ExecutionNode::MaxRegisterId;
+
+    if (p.second.first != nullptr) {
+      auto itIn = en->getRegisterPlan()->varInfo.find(p.second.first->id);
+      TRI_ASSERT(itIn != en->getRegisterPlan()->varInfo.end());
+      TRI_ASSERT((*itIn).second.registerId < ExecutionNode::MaxRegisterId);
+      inRegister = (*itIn).second.registerId;
+    }
+
+    _aggregatorRegisters.emplace_back(make_pair((*itOut).second.registerId, inRegister));
+  }
+
   if (en->_outVariable != nullptr) {
     auto const& registerPlan = en->getRegisterPlan()->varInfo;
     auto it = registerPlan.find(en->_outVariable->id);
@@ -3408,6 +5001,9 @@ SortedAggregateBlock::SortedAggregateBlock (ExecutionEngine* engine,
 }
 
 SortedAggregateBlock::~SortedAggregateBlock () {
+  for (auto& it : _aggregators) {
+    delete it;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3424,6 +5020,19 @@ int SortedAggregateBlock::initialize () {
   // reserve space for the current row
   _currentGroup.initialize(_aggregateRegisters.size());
 
+  for (auto& it : _aggregators) {
+    delete it;
+  }
+  _aggregators.clear();
+
+  auto en = static_cast<AggregateNode const*>(getPlanNode());
+
+  for (auto const& p : en->_aggregateFunctions) {
+    std::unique_ptr<Aggregator> aggregator(Aggregator::fromTypeString(_trx, _engine->getQuery(), p.second.second));
+    _aggregators.emplace_back(aggregator.get());
+    aggregator.release();
+  }
+
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -3447,7 +5056,7 @@ int SortedAggregateBlock::getOrSkipSome (size_t atLeast,
 
       if (isTotalAggregation && _currentGroup.groupLength == 0) {
         // total aggregation, but have not yet emitted a group
-        res.reset(new AqlItemBlock(1, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+        res.reset(new AqlItemBlock(resourceMonitor(), 1, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
         emitGroup(nullptr, res.get(), skipped);
         result = res.release();
       }
@@ -3461,7 +5070,7 @@ int SortedAggregateBlock::getOrSkipSome (size_t atLeast,
   AqlItemBlock* cur = _buffer.front();
 
   if (! skipping) {
-    res.reset(new AqlItemBlock(atMost, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+    res.reset(new AqlItemBlock(resourceMonitor(), atMost, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
     TRI_ASSERT(cur->getNrRegs() <= res->getNrRegs());
     inheritRegisters(cur, res.get(), _pos);
@@ -3531,12 +5140,29 @@ int SortedAggregateBlock::getOrSkipSome (size_t atLeast,
       if (! skipping) {
         _currentGroup.setFirstRow(_pos);
       }
+
+      for (auto& aggregator : _aggregators) {
+        aggregator->reset();
+      }
     }
 
     if (! skipping) {
       _currentGroup.setLastRow(_pos);
     }
 
+    // feed the current row into the aggregate functions of the group
+    for (size_t j = 0; j < _aggregators.size(); ++j) {
+      RegisterId const inRegister = _aggregatorRegisters[j].second;
+
+      if (inRegister == ExecutionNode::MaxRegisterId) {
+        _aggregators[j]->reduce(AqlValue(), nullptr);
+      }
+      else {
+        _aggregators[j]->reduce(cur->getValueReference(_pos, inRegister), 
+                                cur->getDocumentCollection(inRegister));
+      }
+    }
+
     if (++_pos >= cur->size()) {
       _buffer.pop_front();
       _pos = 0;
@@ -3638,6 +5264,18 @@ void SortedAggregateBlock::emitGroup (AqlItemBlock const* cur,
     ++i;
   }
 
+  for (size_t j = 0; j < _aggregators.size(); ++j) {
+    AqlValue value = _aggregators[j]->stealValue();
+
+    try {
+      res->setValue(row, _aggregatorRegisters[j].first, value);
+    }
+    catch (...) {
+      value.destroy();
+      throw;
+    }
+  }
+
   if (_groupRegister != ExecutionNode::MaxRegisterId) {
     // set the group values
     _currentGroup.addValues(cur, _groupRegister);
@@ -3686,7 +5324,24 @@ HashedAggregateBlock::HashedAggregateBlock (ExecutionEngine* engine,
     TRI_ASSERT(itIn != en->getRegisterPlan()->varInfo.end());
     TRI_ASSERT((*itIn).second.registerId < ExecutionNode::MaxRegisterId);
     TRI_ASSERT((*itOut).second.registerId < ExecutionNode::MaxRegisterId);
-    _aggregateRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
+    _aggregateRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
+  }
+
+  for (auto const& p : en->_aggregateFunctions) {
+    auto itOut = en->getRegisterPlan()->varInfo.find(p.first->id);
+    TRI_ASSERT(itOut != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT((*itOut).second.registerId < ExecutionNode::MaxRegisterId);
+
+    RegisterId inRegister = ExecutionNode::MaxRegisterId;
+
+    if (p.second.first != nullptr) {
+      auto itIn = en->getRegisterPlan()->varInfo.find(p.second.first->id);
+      TRI_ASSERT(itIn != en->getRegisterPlan()->varInfo.end());
+      TRI_ASSERT((*itIn).second.registerId < ExecutionNode::MaxRegisterId);
+      inRegister = (*itIn).second.registerId;
+    }
+
+    _aggregatorRegisters.emplace_back(make_pair((*itOut).second.registerId, inRegister));
   }
 
   if (en->_outVariable != nullptr) {
@@ -3708,6 +5363,32 @@ HashedAggregateBlock::HashedAggregateBlock (ExecutionEngine* engine,
 HashedAggregateBlock::~HashedAggregateBlock () {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the aggregate functions for a new group
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<Aggregator*> HashedAggregateBlock::createAggregators () const {
+  auto en = static_cast<AggregateNode const*>(getPlanNode());
+
+  std::vector<Aggregator*> aggregators;
+  aggregators.reserve(en->_aggregateFunctions.size());
+
+  try {
+    for (auto const& p : en->_aggregateFunctions) {
+      aggregators.emplace_back(nullptr);
+      aggregators.back() = Aggregator::fromTypeString(_trx, _engine->getQuery(), p.second.second);
+    }
+  }
+  catch (...) {
+    for (auto& it : aggregators) {
+      delete it;
+    }
+    throw;
+  }
+
+  return aggregators;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief initialize
 ////////////////////////////////////////////////////////////////////////////////
@@ -3752,17 +5433,35 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
     colls.emplace_back(cur->getDocumentCollection(it.second));
   }
 
-  std::unordered_map<std::vector<AqlValue>, size_t, GroupKeyHash, GroupKeyEqual> allGroups(
+  // group values => (number of group members, aggregate functions)
+  std::unordered_map<std::vector<AqlValue>, std::pair<size_t, std::vector<Aggregator*>>, GroupKeyHash, GroupKeyEqual> allGroups(
     1024, 
     GroupKeyHash(_trx, colls), 
     GroupKeyEqual(_trx, colls)
   );
 
+  // memory for the groups, which live outside of any AqlItemBlock until
+  // the result is built
+  ResourceUsageScope groupMemory(resourceMonitor());
+
+  auto destroyAggregators = [&allGroups] () -> void {
+    for (auto& it : allGroups) {
+      for (auto& aggregator : it.second.second) {
+        delete aggregator;
+      }
+      it.second.second.clear();
+    }
+  };
+
   auto buildResult = [&] (AqlItemBlock const* src) {
+    // the group values are handed over to the result block, which
+    // accounts for them itself
+    groupMemory.release();
+
     auto planNode = static_cast<AggregateNode const*>(getPlanNode());
     auto nrRegs = planNode->getRegisterPlan()->nrRegs[planNode->getDepth()];
 
-    std::unique_ptr<AqlItemBlock> result(new AqlItemBlock(allGroups.size(), nrRegs));
+    std::unique_ptr<AqlItemBlock> result(new AqlItemBlock(resourceMonitor(), allGroups.size(), nrRegs));
     
     if (src != nullptr) {
       inheritRegisters(src, result.get(), 0);
@@ -3790,7 +5489,21 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
     
       if (planNode->_count) {
         // set group count in result register
-        result->setValue(row, _groupRegister, AqlValue(new Json(static_cast<double>(it.second))));
+        result->setValue(row, _groupRegister, AqlValue(new Json(static_cast<double>(it.second.first))));
+      }
+
+      // set the results of the aggregate functions
+      auto const& aggregators = it.second.second;
+      for (size_t j = 0; j < aggregators.size(); ++j) {
+        AqlValue value = aggregators[j]->stealValue();
+
+        try {
+          result->setValue(row, _aggregatorRegisters[j].first, value);
+        }
+        catch (...) {
+          value.destroy();
+          throw;
+        }
       }
 
       ++row;
@@ -3824,16 +5537,48 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
         // new group
         group.clear();
 
+        size_t groupSize = sizeof(std::vector<AqlValue>) + 
+                           n * sizeof(AqlValue) + 
+                           _aggregatorRegisters.size() * sizeof(Aggregator*);
+        for (size_t i = 0; i < n; ++i) {
+          groupSize += groupValues[i].ownMemoryUsage();
+        }
+        groupMemory.increase(groupSize);
+
         // copy the group values before they get invalidated
         for (size_t i = 0; i < n; ++i) {
           group.emplace_back(cur->getValueReference(_pos, _aggregateRegisters[i].second).clone());
         }
 
-        allGroups.emplace(group, 1);
+        std::vector<Aggregator*> aggregators(createAggregators());
+
+        try {
+          it = allGroups.emplace(group, std::make_pair(static_cast<size_t>(1), aggregators)).first;
+        }
+        catch (...) {
+          for (auto& aggregator : aggregators) {
+            delete aggregator;
+          }
+          throw;
+        }
       }
       else {
         // existing group. simply increase the counter
-        (*it).second++;
+        (*it).second.first++;
+      }
+
+      // feed the current row into the aggregate functions of the group
+      auto& aggregators = (*it).second.second;
+      for (size_t j = 0; j < aggregators.size(); ++j) {
+        RegisterId const inRegister = _aggregatorRegisters[j].second;
+
+        if (inRegister == ExecutionNode::MaxRegisterId) {
+          aggregators[j]->reduce(AqlValue(), nullptr);
+        }
+        else {
+          aggregators[j]->reduce(cur->getValueReference(_pos, inRegister), 
+                                 cur->getDocumentCollection(inRegister));
+        }
       }
 
       if (++_pos >= cur->size()) {
@@ -3862,6 +5607,7 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
             returnBlock(cur);         
             _done = true;
     
+            destroyAggregators();
             allGroups.clear();  
             groupValues.clear();
 
@@ -3887,10 +5633,12 @@ int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
         const_cast<AqlValue*>(&it2)->destroy();
       }
     }
+    destroyAggregators();
     allGroups.clear();
     throw;
   }
   
+  destroyAggregators();
   allGroups.clear();  
   groupValues.clear();
 
@@ -3944,7 +5692,13 @@ SortBlock::SortBlock (ExecutionEngine* engine,
                       SortNode const* en)
   : ExecutionBlock(engine, en),
     _sortRegisters(),
-    _stable(en->_stable) {
+    _stable(en->_stable),
+    _limit(en->_limit),
+    _memoryLimit(engine->getQuery()->sortMemoryLimit()),
+    _runs(),
+    _runBuffer(),
+    _runPos(),
+    _runRowsLeft(0) {
   
   for (auto const& p : en->_elements) {
     auto it = en->getRegisterPlan()->varInfo.find(p.first->id);
@@ -3955,6 +5709,7 @@ SortBlock::SortBlock (ExecutionEngine* engine,
 }
 
 SortBlock::~SortBlock () {
+  removeRuns();
 }
 
 int SortBlock::initialize () {
@@ -3966,16 +5721,68 @@ int SortBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
   if (res != TRI_ERROR_NO_ERROR) {
     return res;
   }
-  // suck all blocks into _buffer
+
+  removeRuns();
+
+  // suck all blocks into _buffer. if a memory limit is set and the buffered
+  // blocks exceed it, they are sorted and written to disk as a run
+  // if the sort is limited, the buffer is reduced to the top _limit rows
+  // whenever it has accumulated enough rows that will never be returned
+  size_t bufferedBytes = 0;
+  size_t bufferedRows = 0;
+  size_t const compactThreshold = _limit + (std::max)(_limit, DefaultBatchSize);
+
   while (getBlock(DefaultBatchSize, DefaultBatchSize)) {
+    if (_limit > 0) {
+      bufferedRows += _buffer.back()->size();
+
+      if (bufferedRows >= compactThreshold) {
+        doSorting();
+        bufferedRows = _limit;
+
+        if (_memoryLimit > 0) {
+          bufferedBytes = 0;
+          for (auto const& block : _buffer) {
+            bufferedBytes += block->memoryUsage();
+          }
+          continue;
+        }
+      }
+    }
+
+    if (_memoryLimit > 0) {
+      bufferedBytes += _buffer.back()->memoryUsage();
+
+      if (bufferedBytes > _memoryLimit) {
+        spillRun();
+        bufferedBytes = 0;
+        bufferedRows = 0;
+      }
+    }
   }
 
-  if (_buffer.empty()) {
+  if (! _runs.empty()) {
+    if (! _buffer.empty()) {
+      // spill the remainder, too, so that all runs can be merged uniformly
+      spillRun();
+    }
+
+    // set up the merge
+    _runBuffer.resize(_runs.size());
+    _runPos.reserve(_runs.size());
+
+    for (size_t i = 0; i < _runs.size(); ++i) {
+      _runPos.emplace_back(make_pair(i, 0));
+      readRun(i);
+    }
+  }
+  else if (_buffer.empty()) {
     _done = true;
     return TRI_ERROR_NO_ERROR;
   }
-
-  doSorting();
+  else {
+    doSorting();
+  }
 
   _done = false;
   _pos = 0;
@@ -3983,6 +5790,57 @@ int SortBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
   return TRI_ERROR_NO_ERROR;
 }
 
+int SortBlock::shutdown (int errorCode) {
+  removeRuns();
+
+  return ExecutionBlock::shutdown(errorCode);
+}
+
+bool SortBlock::hasMore () {
+  if (_runs.empty()) {
+    return ExecutionBlock::hasMore();
+  }
+
+  if (_done) {
+    return false;
+  }
+
+  if (_buffer.empty()) {
+    mergeRuns(DefaultBatchSize);
+
+    if (_buffer.empty()) {
+      _done = true;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int64_t SortBlock::remaining () {
+  return ExecutionBlock::remaining() + static_cast<int64_t>(_runRowsLeft);
+}
+
+int SortBlock::getOrSkipSome (size_t atLeast,
+                              size_t atMost,
+                              bool skipping,
+                              AqlItemBlock*& result,
+                              size_t& skipped) {
+
+  if (! _runs.empty() && ! _done) {
+    // make sure _buffer contains enough merged rows, so the generic
+    // implementation never has to ask the (exhausted) dependency
+    mergeRuns(atMost);
+
+    if (_buffer.empty()) {
+      _done = true;
+      return TRI_ERROR_NO_ERROR;
+    }
+  }
+
+  return ExecutionBlock::getOrSkipSome(atLeast, atMost, skipping, result, skipped);
+}
+
 void SortBlock::doSorting () {
   // coords[i][j] is the <j>th row of the <i>th block
   std::vector<std::pair<size_t, size_t>> coords;
@@ -4015,8 +5873,42 @@ void SortBlock::doSorting () {
   // comparison function
   OurLessThan ourLessThan(_trx, _buffer, _sortRegisters, colls);
 
-  // sort coords
-  if (_stable) {
+  if (_limit > 0 && sum > _limit) {
+    // top-k: keep the smallest _limit rows in a max-heap. ties are broken
+    // by input position, so the result is the same as the first _limit
+    // rows of a stable sort
+    auto heapLessThan = [&ourLessThan] (std::pair<size_t, size_t> const& a,
+                                        std::pair<size_t, size_t> const& b) -> bool {
+      if (ourLessThan(a, b)) {
+        return true;
+      }
+      if (ourLessThan(b, a)) {
+        return false;
+      }
+      return a < b;
+    };
+
+    std::vector<std::pair<size_t, size_t>> heap;
+    heap.reserve(_limit);
+
+    for (auto const& coord : coords) {
+      if (heap.size() < _limit) {
+        heap.emplace_back(coord);
+        std::push_heap(heap.begin(), heap.end(), heapLessThan);
+      }
+      else if (heapLessThan(coord, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), heapLessThan);
+        heap.back() = coord;
+        std::push_heap(heap.begin(), heap.end(), heapLessThan);
+      }
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), heapLessThan);
+    coords.swap(heap);
+    sum = coords.size();
+  }
+  else if (_stable) {
+    // sort coords
     std::stable_sort(coords.begin(), coords.end(), ourLessThan);
   }
   else {
@@ -4036,7 +5928,7 @@ void SortBlock::doSorting () {
 
     while (count < sum) {
       size_t sizeNext = (std::min)(sum - count, DefaultBatchSize);
-      AqlItemBlock* next = new AqlItemBlock(sizeNext, nrregs);
+      AqlItemBlock* next = new AqlItemBlock(resourceMonitor(), sizeNext, nrregs);
 
       try {
         TRI_IF_FAILURE("SortBlock::doSortingInner") {
@@ -4151,6 +6043,218 @@ void SortBlock::doSorting () {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sort the blocks in _buffer and write them into a new run file
+/// each block is stored as its JSON serialization (see AqlItemBlock::toJson),
+/// prefixed with the length of the serialization
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::spillRun () {
+  TRI_ASSERT(! _buffer.empty());
+
+  doSorting();
+
+  char* filename = nullptr;
+  long systemError;
+  std::string errorMessage;
+
+  if (TRI_GetTempName("aql-sort", &filename, false, systemError, errorMessage) != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_CREATE_TEMP_FILE, errorMessage);
+  }
+
+  // register the run first so the file is removed in case of an error
+  _runs.emplace_back();
+  SortRun& run = _runs.back();
+  run.filename = filename;
+  TRI_Free(TRI_CORE_MEM_ZONE, filename);
+
+  run.fd = TRI_CREATE(run.filename.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+
+  if (run.fd < 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_CREATE_TEMP_FILE, run.filename);
+  }
+
+  TRI_IF_FAILURE("SortBlock::spillRun") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+
+  while (! _buffer.empty()) {
+    AqlItemBlock* cur = _buffer.front();
+
+    buffer.clear();
+    cur->toJson(_trx).dump(buffer);
+
+    uint64_t const length = static_cast<uint64_t>(buffer.length());
+
+    if (! TRI_WritePointer(run.fd, &length, sizeof(length)) ||
+        ! TRI_WritePointer(run.fd, buffer.c_str(), buffer.length())) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, run.filename);
+    }
+
+    ++run.blocks;
+    _runRowsLeft += cur->size();
+    _engine->_stats.spilledBytes += static_cast<int64_t>(sizeof(length) + length);
+
+    delete cur;
+    _buffer.pop_front();
+  }
+
+  // the run will be read from the beginning when merging
+  if (TRI_LSEEK(run.fd, 0, SEEK_SET) != 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_SYS_ERROR, run.filename);
+  }
+
+  _engine->_stats.spilledRuns++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the next block of a run into its merge buffer. returns false
+/// if the run is exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+bool SortBlock::readRun (size_t i) {
+  SortRun& run = _runs[i];
+
+  if (run.blocks == 0) {
+    return false;
+  }
+
+  uint64_t length;
+
+  if (! TRI_ReadPointer(run.fd, &length, sizeof(length))) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_SYS_ERROR, run.filename);
+  }
+
+  std::string data;
+  data.resize(static_cast<size_t>(length));
+
+  if (! TRI_ReadPointer(run.fd, &data[0], static_cast<size_t>(length))) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_SYS_ERROR, run.filename);
+  }
+
+  Json json(TRI_UNKNOWN_MEM_ZONE, TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, data.c_str()));
+
+  if (json.isEmpty()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid sort run data");
+  }
+
+  std::unique_ptr<AqlItemBlock> block(new AqlItemBlock(resourceMonitor(), json));
+  _runBuffer[i].emplace_back(block.get());
+  block.release();
+  --run.blocks;
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merge rows from the spilled runs into _buffer, so that _buffer
+/// holds at least atMost rows or all runs are exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::mergeRuns (size_t atMost) {
+  size_t available = 0;
+  for (auto const& it : _buffer) {
+    available += it->size();
+  }
+  if (! _buffer.empty()) {
+    available -= _pos;
+  }
+
+  // all spilled values are JSON, so there are no collections to compare
+  MergeLessThan ourLessThan(_trx, _runBuffer, _sortRegisters);
+
+  while (available < atMost && _runRowsLeft > 0) {
+    throwIfKilled();
+
+    AqlItemBlock const* example = nullptr;
+    for (auto const& it : _runBuffer) {
+      if (! it.empty()) {
+        example = it.front();
+        break;
+      }
+    }
+    TRI_ASSERT(example != nullptr);
+
+    RegisterId const nrRegs = example->getNrRegs();
+    size_t const toSend = (std::min)(_runRowsLeft, DefaultBatchSize);
+
+    std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(resourceMonitor(), toSend, nrRegs));
+    std::unordered_map<AqlValue, AqlValue> cache;
+
+    for (size_t i = 0; i < toSend; i++) {
+      // get the next smallest row from the heads of the runs . . .
+      std::pair<size_t, size_t> val = *(std::min_element(_runPos.begin(),
+            _runPos.end(), ourLessThan));
+      AqlItemBlock* cur = _runBuffer[val.first].front();
+
+      // copy the row into the outgoing block . . .
+      for (RegisterId col = 0; col < nrRegs; col++) {
+        AqlValue const& x(cur->getValueReference(val.second, col));
+
+        if (! x.isEmpty()) {
+          auto it = cache.find(x);
+
+          if (it == cache.end()) {
+            AqlValue y = x.clone();
+            try {
+              res->setValue(i, col, y);
+            }
+            catch (...) {
+              y.destroy();
+              throw;
+            }
+            cache.emplace(x, y);
+          }
+          else {
+            res->setValue(i, col, it->second);
+          }
+        }
+      }
+
+      // advance the run and fetch its next block if necessary
+      if (++_runPos[val.first].second == cur->size()) {
+        delete cur;
+        _runBuffer[val.first].pop_front();
+        _runPos[val.first].second = 0;
+        // the values of the freed block must not be looked up any more
+        cache.clear();
+        readRun(val.first);
+      }
+    }
+
+    _runRowsLeft -= toSend;
+    _buffer.emplace_back(res.get());
+    res.release();
+    available += toSend;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief close and remove all run files and free the merge buffers
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::removeRuns () {
+  for (auto& x : _runBuffer) {
+    for (auto& y : x) {
+      delete y;
+    }
+  }
+  _runBuffer.clear();
+  _runPos.clear();
+
+  for (auto& run : _runs) {
+    if (run.fd >= 0) {
+      TRI_CLOSE(run.fd);
+      run.fd = -1;
+    }
+    TRI_UnlinkFile(run.filename.c_str());
+  }
+  _runs.clear();
+  _runRowsLeft = 0;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      class SortBlock::OurLessThan
 // -----------------------------------------------------------------------------
@@ -4182,6 +6286,43 @@ bool SortBlock::OurLessThan::operator() (std::pair<size_t, size_t> const& a,
   return false;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                    class SortBlock::MergeLessThan
+// -----------------------------------------------------------------------------
+
+bool SortBlock::MergeLessThan::operator() (std::pair<size_t, size_t> const& a,
+                                           std::pair<size_t, size_t> const& b) {
+  // an exhausted run is maximum!
+  if (_runBuffer[a.first].empty()) {
+    return false;
+  }
+  if (_runBuffer[b.first].empty()) {
+    return true;
+  }
+
+  for (auto const& reg : _sortRegisters) {
+    int cmp = AqlValue::Compare(
+      _trx,
+      _runBuffer[a.first].front()->getValueReference(a.second, reg.first),
+      nullptr,
+      _runBuffer[b.first].front()->getValueReference(b.second, reg.first),
+      nullptr,
+      true
+    );
+
+    if (cmp < 0) {
+      return reg.second;
+    } 
+    else if (cmp > 0) {
+      return ! reg.second;
+    }
+  }
+
+  // ties are resolved by run order (std::min_element returns the first
+  // minimum), which keeps the merge stable
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  class LimitBlock
 // -----------------------------------------------------------------------------
@@ -4314,7 +6455,7 @@ AqlItemBlock* ReturnBlock::getSome (size_t atLeast,
   TRI_ASSERT(it != ep->getRegisterPlan()->varInfo.end());
   RegisterId const registerId = it->second.registerId;
 
-  std::unique_ptr<AqlItemBlock> stripped(new AqlItemBlock(n, 1));
+  std::unique_ptr<AqlItemBlock> stripped(new AqlItemBlock(resourceMonitor(), n, 1));
 
   for (size_t i = 0; i < n; i++) {
     auto a = res->getValueReference(i, registerId);
@@ -4622,7 +6763,7 @@ AqlItemBlock* RemoveBlock::work (std::vector<AqlItemBlock*>& blocks) {
   bool const ignoreDocumentNotFound = ep->getOptions().ignoreDocumentNotFound;
   bool const producesOutput = (ep->_outVariableOld != nullptr);
 
-  result.reset(new AqlItemBlock(count,
+  result.reset(new AqlItemBlock(resourceMonitor(), count,
                                 getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
   if (producesOutput) {
@@ -4755,7 +6896,7 @@ AqlItemBlock* InsertBlock::work (std::vector<AqlItemBlock*>& blocks) {
   std::string from;
   std::string to;
 
-  result.reset(new AqlItemBlock(count, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+  result.reset(new AqlItemBlock(resourceMonitor(), count, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
   if (producesOutput) {
     result->setDocumentCollection(_outRegNew, trxCollection->_collection->_collection);
@@ -4893,7 +7034,7 @@ AqlItemBlock* UpdateBlock::work (std::vector<AqlItemBlock*>& blocks) {
   
   auto trxCollection = _trx->trxCollection(_collection->cid());
 
-  result.reset(new AqlItemBlock(count, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+  result.reset(new AqlItemBlock(resourceMonitor(), count, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
   if (ep->_outVariableOld != nullptr) {
     result->setDocumentCollection(_outRegOld, trxCollection->_collection->_collection);
@@ -5084,7 +7225,7 @@ AqlItemBlock* UpsertBlock::work (std::vector<AqlItemBlock*>& blocks) {
   auto trxCollection = _trx->trxCollection(_collection->cid());
   bool const isEdgeCollection = _collection->isEdgeCollection();
 
-  result.reset(new AqlItemBlock(count, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+  result.reset(new AqlItemBlock(resourceMonitor(), count, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
   if (ep->_outVariableNew != nullptr) {
     result->setDocumentCollection(_outRegNew, trxCollection->_collection->_collection);
@@ -5317,7 +7458,7 @@ AqlItemBlock* ReplaceBlock::work (std::vector<AqlItemBlock*>& blocks) {
 
   auto trxCollection = _trx->trxCollection(_collection->cid());
 
-  result.reset(new AqlItemBlock(count, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+  result.reset(new AqlItemBlock(resourceMonitor(), count, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
   if (ep->_outVariableOld != nullptr) {
     result->setDocumentCollection(_outRegOld, trxCollection->_collection->_collection);
@@ -5500,6 +7641,23 @@ int GatherBlock::initialize () {
     return res;
   }
 
+  _remoteDependencies = ! _dependencies.empty();
+  for (auto const& x : _dependencies) {
+    if (dynamic_cast<RemoteBlock*>(x) == nullptr) {
+      _remoteDependencies = false;
+      break;
+    }
+  }
+
+  _depExhausted.assign(_dependencies.size(), false);
+
+  if (_remoteDependencies) {
+    _coordTransactionID = TRI_NewTickServer();
+    for (auto const& x : _dependencies) {
+      static_cast<RemoteBlock*>(x)->setCoordTransactionID(_coordTransactionID);
+    }
+  }
+
   return TRI_ERROR_NO_ERROR;
   LEAVE_BLOCK
 }
@@ -5548,6 +7706,7 @@ int GatherBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
   }
   
   _atDep = 0;
+  _depExhausted.assign(_dependencies.size(), false);
   
   if (! _isSimple) {
     for (std::deque<AqlItemBlock*>& x : _gatherBlockBuffer) {
@@ -5652,8 +7811,17 @@ AqlItemBlock* GatherBlock::getSome (size_t atLeast, size_t atMost) {
     return nullptr;
   }
 
-  // the simple case . . .  
-  if (_isSimple) {
+  // the simple case . . .  
+  if (_isSimple) {
+    if (_remoteDependencies) {
+      // take the rows of whichever shard answers first . . .
+      auto res = getSomeFromAnyRemote(atLeast, atMost);
+      if (res == nullptr) {
+        _done = true;
+      }
+      return res;
+    }
+
     auto res = _dependencies.at(_atDep)->getSome(atLeast, atMost);
     while (res == nullptr && _atDep < _dependencies.size() - 1) {
       _atDep++;
@@ -5669,6 +7837,11 @@ AqlItemBlock* GatherBlock::getSome (size_t atLeast, size_t atMost) {
   size_t available = 0; // nr of available rows
   size_t index = 0;     // an index of a non-empty buffer
   
+  // let the remote dependencies fetch in parallel . . .
+  if (_remoteDependencies) {
+    prefetchAll(atLeast, atMost);
+  }
+
   // pull more blocks from dependencies . . .
   for (size_t i = 0; i < _dependencies.size(); i++) {
     
@@ -5713,7 +7886,7 @@ AqlItemBlock* GatherBlock::getSome (size_t atLeast, size_t atMost) {
   AqlItemBlock* example =_gatherBlockBuffer.at(index).front();
   size_t nrRegs = example->getNrRegs();
 
-  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(toSend,
+  std::unique_ptr<AqlItemBlock> res(new AqlItemBlock(resourceMonitor(), toSend,
         static_cast<triagens::aql::RegisterId>(nrRegs)));  
   // automatically deleted if things go wrong
     
@@ -5792,6 +7965,11 @@ size_t GatherBlock::skipSome (size_t atLeast, size_t atMost) {
   size_t index = 0;     // an index of a non-empty buffer
   TRI_ASSERT(_dependencies.size() != 0); 
 
+  // let the remote dependencies fetch in parallel . . .
+  if (_remoteDependencies) {
+    prefetchAll(atLeast, atMost);
+  }
+
   // pull more blocks from dependencies . . .
   for (size_t i = 0; i < _dependencies.size(); i++) {
     if (_gatherBlockBuffer.at(i).empty()) {
@@ -5875,6 +8053,88 @@ bool GatherBlock::getBlock (size_t i, size_t atLeast, size_t atMost) {
   LEAVE_BLOCK
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prefetchAll: let all remote dependencies with an empty buffer read
+/// ahead, non-simple case only
+////////////////////////////////////////////////////////////////////////////////
+
+void GatherBlock::prefetchAll (size_t atLeast, size_t atMost) {
+  ENTER_BLOCK
+  TRI_ASSERT(_remoteDependencies);
+  TRI_ASSERT(! _isSimple);
+  for (size_t i = 0; i < _dependencies.size(); i++) {
+    if (_gatherBlockBuffer.at(i).empty()) {
+      static_cast<RemoteBlock*>(_dependencies.at(i))->prefetch(atLeast, atMost);
+    }
+  }
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSomeFromAnyRemote: return the block of whichever remote
+/// dependency answers first, simple case only
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* GatherBlock::getSomeFromAnyRemote (size_t atLeast, size_t atMost) {
+  ENTER_BLOCK
+  TRI_ASSERT(_remoteDependencies);
+  TRI_ASSERT(_isSimple);
+
+  while (true) {
+    bool waiting = false;
+
+    for (size_t i = 0; i < _dependencies.size(); i++) {
+      if (_depExhausted.at(i)) {
+        continue;
+      }
+
+      auto remote = static_cast<RemoteBlock*>(_dependencies.at(i));
+      if (remote->prefetch(atLeast, atMost)) {
+        // the request is still in flight
+        waiting = true;
+        continue;
+      }
+
+      // the answer has already arrived or the dependency cannot read ahead
+      auto res = remote->getSome(atLeast, atMost);
+      if (res != nullptr) {
+        return res;
+      }
+      _depExhausted.at(i) = true;
+    }
+
+    if (! waiting) {
+      return nullptr;
+    }
+
+    // wait for the first answer to any of our requests . . .
+    std::unique_ptr<ClusterCommResult> res(ClusterComm::instance()->wait("AQL",
+                                                                         _coordTransactionID,
+                                                                         0,
+                                                                         "",
+                                                                         RemoteBlock::defaultTimeOut));
+    
+    bool found = false;
+    for (auto const& x : _dependencies) {
+      auto remote = static_cast<RemoteBlock*>(x);
+      if (remote->prefetchOperationID() != 0 &&
+          remote->prefetchOperationID() == res->operationID) {
+        remote->receivePrefetch(res.release());
+        found = true;
+        break;
+      }
+    }
+
+    if (! found) {
+      if (res->status == CL_COMM_TIMEOUT) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_TIMEOUT);
+      }
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
+    }
+  }
+  LEAVE_BLOCK
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief OurLessThan: comparison method for elements of _gatherBlockPos
 ////////////////////////////////////////////////////////////////////////////////
@@ -6679,6 +8939,57 @@ std::string DistributeBlock::createKey () const {
 // --SECTION--                                                 class RemoteBlock
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local helper to extract the error number and message from the
+/// body of an error response sent by a DB server
+////////////////////////////////////////////////////////////////////////////////
+
+static int extractErrorFromResponse (ClusterCommResult const* res,
+                                     char const* responseBody,
+                                     std::string& errorMessage) {
+  // extract error number and message from response
+  int errorNum = TRI_ERROR_NO_ERROR;
+  TRI_json_t* json = TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, responseBody);
+
+  if (JsonHelper::getBooleanValue(json, "error", true)) {
+    errorNum = TRI_ERROR_INTERNAL;
+    errorMessage = std::string("Error message received from shard '") + 
+      std::string(res->shardID) + 
+      std::string("' on cluster node '") +
+      std::string(res->serverID) +
+      std::string("': ");
+  }
+
+  if (TRI_IsObjectJson(json)) {
+    TRI_json_t const* v = TRI_LookupObjectJson(json, "errorNum");
+
+    if (TRI_IsNumberJson(v)) {
+      if (static_cast<int>(v->_value._number) != TRI_ERROR_NO_ERROR) {
+        /* if we've got an error num, error has to be true. */
+        TRI_ASSERT(errorNum == TRI_ERROR_INTERNAL);
+        errorNum = static_cast<int>(v->_value._number);
+      }
+    }
+
+    v = TRI_LookupObjectJson(json, "errorMessage");
+    if (TRI_IsStringJson(v)) {
+      errorMessage += std::string(v->_value._string.data, v->_value._string.length - 1);
+    }
+    else {
+      errorMessage += std::string("(no valid error in response)");
+    }
+  }
+  else {
+    errorMessage += std::string("(no valid response)");
+  }
+
+  if (json != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+  }
+
+  return errorNum;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief local helper to throw an exception if a HTTP request went wrong
 ////////////////////////////////////////////////////////////////////////////////
@@ -6713,46 +9024,7 @@ static bool throwExceptionAfterBadSyncRequest (ClusterCommResult* res,
     }
       
     StringBuffer const& responseBodyBuf(res->result->getBody());
- 
-    // extract error number and message from response
-    int errorNum = TRI_ERROR_NO_ERROR;
-    TRI_json_t* json = TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, responseBodyBuf.c_str());
-
-    if (JsonHelper::getBooleanValue(json, "error", true)) {
-      errorNum = TRI_ERROR_INTERNAL;
-      errorMessage = std::string("Error message received from shard '") + 
-        std::string(res->shardID) + 
-        std::string("' on cluster node '") +
-        std::string(res->serverID) +
-        std::string("': ");
-    }
-
-    if (TRI_IsObjectJson(json)) {
-      TRI_json_t const* v = TRI_LookupObjectJson(json, "errorNum");
-
-      if (TRI_IsNumberJson(v)) {
-        if (static_cast<int>(v->_value._number) != TRI_ERROR_NO_ERROR) {
-          /* if we've got an error num, error has to be true. */
-          TRI_ASSERT(errorNum == TRI_ERROR_INTERNAL);
-          errorNum = static_cast<int>(v->_value._number);
-        }
-      }
-
-      v = TRI_LookupObjectJson(json, "errorMessage");
-      if (TRI_IsStringJson(v)) {
-        errorMessage += std::string(v->_value._string.data, v->_value._string.length - 1);
-      }
-      else {
-        errorMessage += std::string("(no valid error in response)");
-      }
-    }
-    else {
-      errorMessage += std::string("(no valid response)");
-    }
-
-    if (json != nullptr) {
-      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
-    }
+    int errorNum = extractErrorFromResponse(res, responseBodyBuf.c_str(), errorMessage);
 
     if (isShutdown && 
         errorNum == TRI_ERROR_QUERY_NOT_FOUND) {
@@ -6774,6 +9046,43 @@ static bool throwExceptionAfterBadSyncRequest (ClusterCommResult* res,
   LEAVE_BLOCK
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local helper to throw an exception if an asynchronous HTTP request
+/// went wrong. the answer of an asynchronous request is delivered in
+/// res->answer, but errors that occur while sending are reported in
+/// res->result just like for synchronous requests
+////////////////////////////////////////////////////////////////////////////////
+
+static void throwExceptionAfterBadAsyncRequest (ClusterCommResult* res) {
+  ENTER_BLOCK
+  if (res->status == CL_COMM_RECEIVED) {
+    TRI_ASSERT(res->answer != nullptr);
+
+    if (res->answer_code == triagens::rest::HttpResponse::OK) {
+      return;
+    }
+
+    std::string errorMessage;
+    int errorNum = extractErrorFromResponse(res, res->answer->body(), errorMessage);
+
+    if (errorNum > 0 && ! errorMessage.empty()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(errorNum, errorMessage);
+    }
+
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
+  }
+
+  if (res->status == CL_COMM_DROPPED) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
+  }
+
+  throwExceptionAfterBadSyncRequest(res, false);
+
+  // any other status means the request has not been answered
+  THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
+  LEAVE_BLOCK
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief timeout
 ////////////////////////////////////////////////////////////////////////////////
@@ -6792,7 +9101,14 @@ RemoteBlock::RemoteBlock (ExecutionEngine* engine,
   : ExecutionBlock(engine, en),
     _server(server),
     _ownName(ownName),
-    _queryId(queryId) {
+    _queryId(queryId),
+    _usePrefetch(ownName.empty()),
+    _exhausted(false),
+    _coordTransactionID(0),
+    _prefetchOperationID(0),
+    _hasPrefetched(false),
+    _prefetched(),
+    _prefetchedPos(0) {
 
   TRI_ASSERT(! queryId.empty());
   TRI_ASSERT_EXPENSIVE((triagens::arango::ServerState::instance()->isCoordinator() && ownName.empty()) ||
@@ -6800,6 +9116,10 @@ RemoteBlock::RemoteBlock (ExecutionEngine* engine,
 }
 
 RemoteBlock::~RemoteBlock () {
+  if (_prefetchOperationID != 0) {
+    // nobody is interested in the answer anymore
+    ClusterComm::instance()->drop("", 0, _prefetchOperationID, "");
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -6809,7 +9129,8 @@ RemoteBlock::~RemoteBlock () {
 ClusterCommResult* RemoteBlock::sendRequest (
           triagens::rest::HttpRequest::HttpRequestType type,
           std::string const& urlPart,
-          std::string const& body) const {
+          std::string const& body,
+          bool binaryFormat) const {
   ENTER_BLOCK
   ClusterComm* cc = ClusterComm::instance();
 
@@ -6820,6 +9141,9 @@ ClusterCommResult* RemoteBlock::sendRequest (
   if (! _ownName.empty()) {
     headers.emplace(make_pair("Shard-Id", _ownName));
   }
+  if (binaryFormat) {
+    headers.emplace(make_pair(BinaryBlockFormat::FormatHeader, BinaryBlockFormat::FormatName));
+  }
 
   auto currentThread = triagens::rest::DispatcherThread::currentDispatcherThread;
 
@@ -6846,6 +9170,145 @@ ClusterCommResult* RemoteBlock::sendRequest (
   LEAVE_BLOCK
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start an asynchronous getSome request for the next block
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteBlock::prefetch (size_t atLeast,
+                            size_t atMost) {
+  ENTER_BLOCK
+  if (_prefetchOperationID != 0) {
+    return true;
+  }
+
+  if (! _usePrefetch || _exhausted || _hasPrefetched) {
+    return false;
+  }
+
+  Json body(Json::Object, 2);
+  body("atLeast", Json(static_cast<double>(atLeast)))
+      ("atMost", Json(static_cast<double>(atMost)));
+
+  std::unique_ptr<std::string> bodyString(new std::string(body.toString()));
+  std::unique_ptr<std::map<std::string, std::string>> headers(new std::map<std::string, std::string>());
+  headers->emplace(make_pair(BinaryBlockFormat::FormatHeader, BinaryBlockFormat::FormatName));
+
+  CoordTransactionID const coordTransactionId = (_coordTransactionID != 0 ? _coordTransactionID : TRI_NewTickServer());
+  
+  // ClusterComm takes over the body and the headers 
+  std::unique_ptr<ClusterCommResult> res(ClusterComm::instance()->asyncRequest(
+                                "AQL",
+                                coordTransactionId,
+                                _server,
+                                rest::HttpRequest::HTTP_REQUEST_PUT,
+                                std::string("/_db/") 
+                                + triagens::basics::StringUtils::urlEncode(_engine->getQuery()->trx()->vocbase()->_name)
+                                + "/_api/aql/getSome/" + _queryId,
+                                bodyString.release(),
+                                true,
+                                headers.release(),
+                                nullptr,
+                                defaultTimeOut));
+
+  _prefetchOperationID = res->operationID;
+  return true;
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hand over the answer to the read-ahead request in flight
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::receivePrefetch (ClusterCommResult* result) {
+  ENTER_BLOCK
+  std::unique_ptr<ClusterCommResult> res(result);
+
+  TRI_ASSERT(_prefetchOperationID != 0);
+  TRI_ASSERT(res->operationID == _prefetchOperationID);
+  TRI_ASSERT(! _hasPrefetched);
+  _prefetchOperationID = 0;
+
+  throwExceptionAfterBadAsyncRequest(res.get());
+
+  bool found;
+  char const* contentType = res->answer->header("content-type", found);
+  bool const isBinary = (found && BinaryBlockFormat::isContentType(contentType));
+
+  _prefetched.reset(decodeGetSome(res->answer->body(), res->answer->bodySize(), isBinary));
+  _prefetchedPos = 0;
+  _hasPrefetched = true;
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the result of getSome from a response body
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* RemoteBlock::decodeGetSome (char const* body,
+                                          size_t length,
+                                          bool isBinary) {
+  ENTER_BLOCK
+  if (isBinary) {
+    // the server has answered in binary format
+    ExecutionStats newStats;
+    std::unique_ptr<AqlItemBlock> items(BinaryBlockFormat::decodeGetSome(resourceMonitor(), body, length, newStats));
+
+    _engine->_stats.addDelta(_deltaStats, newStats);
+    _deltaStats = newStats;
+
+    return items.release();
+  }
+
+  // JSON, sent by servers that do not support the binary format
+  Json responseBodyJson(TRI_UNKNOWN_MEM_ZONE,
+                        TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, body));
+
+  ExecutionStats newStats(responseBodyJson.get("stats"));
+  
+  _engine->_stats.addDelta(_deltaStats, newStats);
+  _deltaStats = newStats;
+  
+  if (JsonHelper::getBooleanValue(responseBodyJson.json(), "exhausted", true)) {
+    return nullptr;
+  }
+    
+  return new triagens::aql::AqlItemBlock(resourceMonitor(), responseBodyJson);
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait for the read-ahead request in flight, if any
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::waitForPrefetch () {
+  ENTER_BLOCK
+  if (_prefetchOperationID == 0) {
+    return;
+  }
+
+  receivePrefetch(ClusterComm::instance()->wait("", 0, _prefetchOperationID, "", defaultTimeOut));
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief throw away the read-ahead state
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::discardPrefetch () {
+  ENTER_BLOCK
+  if (_prefetchOperationID != 0) {
+    // wait for the answer, so that the query on the DB server is free again
+    // for our next request
+    std::unique_ptr<ClusterCommResult> res(ClusterComm::instance()->wait("", 0, _prefetchOperationID, "", defaultTimeOut));
+    _prefetchOperationID = 0;
+  }
+
+  _prefetched.reset();
+  _prefetchedPos = 0;
+  _hasPrefetched = false;
+  LEAVE_BLOCK
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief initialize
 ////////////////////////////////////////////////////////////////////////////////
@@ -6868,6 +9331,9 @@ int RemoteBlock::initialize () {
 
 int RemoteBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
   ENTER_BLOCK
+  discardPrefetch();
+  _exhausted = false;
+
   // For every call we simply forward via HTTP
 
   Json body(Json::Object, 4);
@@ -6908,6 +9374,8 @@ int RemoteBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
 
 int RemoteBlock::shutdown (int errorCode) {
   ENTER_BLOCK
+  discardPrefetch();
+
   // For every call we simply forward via HTTP
 
   std::unique_ptr<ClusterCommResult> res;
@@ -6955,36 +9423,64 @@ int RemoteBlock::shutdown (int errorCode) {
 AqlItemBlock* RemoteBlock::getSome (size_t atLeast,
                                     size_t atMost) {
   ENTER_BLOCK
-  // For every call we simply forward via HTTP
+  waitForPrefetch();
 
-  Json body(Json::Object, 2);
-  body("atLeast", Json(static_cast<double>(atLeast)))
-      ("atMost", Json(static_cast<double>(atMost)));
-  std::string bodyString(body.toString());
+  std::unique_ptr<AqlItemBlock> items;
 
-  std::unique_ptr<ClusterCommResult> res;
-  res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_PUT,
-                        "/_api/aql/getSome/",
-                        bodyString));
-  throwExceptionAfterBadSyncRequest(res.get(), false);
+  if (_hasPrefetched) {
+    // hand out (the rest of) the block we have read ahead
+    if (_prefetched != nullptr &&
+        (_prefetchedPos > 0 || _prefetched->size() > atMost)) {
+      size_t const to = (std::min)(_prefetched->size(), _prefetchedPos + atMost);
+      items.reset(_prefetched->slice(_prefetchedPos, to));
+      _prefetchedPos = to;
+      if (_prefetchedPos < _prefetched->size()) {
+        return items.release();
+      }
+    }
+    else {
+      items.reset(_prefetched.release());
+    }
+    _prefetched.reset();
+    _prefetchedPos = 0;
+    _hasPrefetched = false;
+  }
+  else if (! _exhausted) {
+    // For every call we simply forward via HTTP
 
-  // If we get here, then res->result is the response which will be
-  // a serialized AqlItemBlock:
-  StringBuffer const& responseBodyBuf(res->result->getBody());
-  Json responseBodyJson(TRI_UNKNOWN_MEM_ZONE,
-                        TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, 
-                                       responseBodyBuf.begin()));
+    Json body(Json::Object, 2);
+    body("atLeast", Json(static_cast<double>(atLeast)))
+        ("atMost", Json(static_cast<double>(atMost)));
+    std::string bodyString(body.toString());
 
-  ExecutionStats newStats(responseBodyJson.get("stats"));
-  
-  _engine->_stats.addDelta(_deltaStats, newStats);
-  _deltaStats = newStats;
-  
-  if (JsonHelper::getBooleanValue(responseBodyJson.json(), "exhausted", true)) {
+    std::unique_ptr<ClusterCommResult> res;
+    res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_PUT,
+                          "/_api/aql/getSome/",
+                          bodyString,
+                          true));
+    throwExceptionAfterBadSyncRequest(res.get(), false);
+
+    // If we get here, then res->result is the response which will be
+    // a serialized AqlItemBlock:
+    StringBuffer const& responseBodyBuf(res->result->getBody());
+
+    bool found;
+    std::string const contentType(res->result->getHeaderField("content-type", found));
+
+    items.reset(decodeGetSome(responseBodyBuf.c_str(),
+                              responseBodyBuf.length(),
+                              found && BinaryBlockFormat::isContentType(contentType)));
+  }
+
+  if (items == nullptr) {
+    _exhausted = true;
     return nullptr;
   }
-    
-  return new triagens::aql::AqlItemBlock(responseBodyJson);
+
+  // read ahead the next block while our caller is busy with this one
+  prefetch(atLeast, atMost);
+
+  return items.release();
   LEAVE_BLOCK
 }
 
@@ -6994,6 +9490,32 @@ AqlItemBlock* RemoteBlock::getSome (size_t atLeast,
 
 size_t RemoteBlock::skipSome (size_t atLeast, size_t atMost) {
   ENTER_BLOCK
+  waitForPrefetch();
+
+  size_t skippedAhead = 0;
+
+  if (_hasPrefetched) {
+    // skip the rows we have read ahead first
+    if (_prefetched == nullptr) {
+      return 0;
+    }
+    skippedAhead = (std::min)(prefetchedRows(), atMost);
+    _prefetchedPos += skippedAhead;
+    if (prefetchedRows() == 0) {
+      _prefetched.reset();
+      _prefetchedPos = 0;
+      _hasPrefetched = false;
+    }
+    if (skippedAhead >= atLeast) {
+      return skippedAhead;
+    }
+    atLeast -= skippedAhead;
+    atMost -= skippedAhead;
+  }
+  else if (_exhausted) {
+    return 0;
+  }
+
   // For every call we simply forward via HTTP
 
   Json body(Json::Object, 2);
@@ -7018,7 +9540,7 @@ size_t RemoteBlock::skipSome (size_t atLeast, size_t atMost) {
   }
   size_t skipped = JsonHelper::getNumericValue<size_t>(responseBodyJson.json(),
                                                        "skipped", 0);
-  return skipped;
+  return skippedAhead + skipped;
   LEAVE_BLOCK
 }
 
@@ -7028,6 +9550,15 @@ size_t RemoteBlock::skipSome (size_t atLeast, size_t atMost) {
 
 bool RemoteBlock::hasMore () {
   ENTER_BLOCK
+  waitForPrefetch();
+
+  if (_hasPrefetched) {
+    return (_prefetched != nullptr);
+  }
+  if (_exhausted) {
+    return false;
+  }
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res;
   res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_GET,
@@ -7054,6 +9585,10 @@ bool RemoteBlock::hasMore () {
 
 int64_t RemoteBlock::count () const {
   ENTER_BLOCK
+  // the answer to a read-ahead request does not change the count, but we
+  // must not send a request while it is in flight
+  const_cast<RemoteBlock*>(this)->waitForPrefetch();
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res;
   res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_GET,
@@ -7081,6 +9616,8 @@ int64_t RemoteBlock::count () const {
 
 int64_t RemoteBlock::remaining () {
   ENTER_BLOCK
+  waitForPrefetch();
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res;
   res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_GET,
@@ -7097,8 +9634,14 @@ int64_t RemoteBlock::remaining () {
   if (JsonHelper::getBooleanValue(responseBodyJson.json(), "error", true)) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
   }
-  return JsonHelper::getNumericValue<int64_t>
+  int64_t remaining = JsonHelper::getNumericValue<int64_t>
                (responseBodyJson.json(), "remaining", 0);
+
+  if (remaining == -1) {
+    return -1;
+  }
+  // rows we have read ahead are no longer counted on the remote side
+  return remaining + static_cast<int64_t>(prefetchedRows());
   LEAVE_BLOCK
 }
 
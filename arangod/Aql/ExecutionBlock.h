@@ -29,6 +29,7 @@
 #define ARANGODB_AQL_EXECUTION_BLOCK_H 1
 
 #include "Basics/JsonHelper.h"
+#include "Aql/Aggregator.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/Collection.h"
 #include "Aql/CollectionScanner.h"
@@ -255,6 +256,12 @@ namespace triagens {
 
         void returnBlock (AqlItemBlock*&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the resource monitor the query's memory is charged to
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceMonitor* resourceMonitor () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief resolve a collection name and return cid and document key
 /// this is used for parsing _from, _to and _id values
@@ -286,6 +293,13 @@ namespace triagens {
 
         bool getBlock (size_t atLeast, size_t atMost);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief encode a block in the binary transfer format and decode it again,
+/// used for testing the format without a cluster
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock* roundTripBinaryBlock (AqlItemBlock const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief getSomeWithoutRegisterClearout, same as above, however, this
 /// is the actual worker which does not clear out registers at the end
@@ -529,11 +543,57 @@ namespace triagens {
         size_t skipSome (size_t atLeast, size_t atMost) override final;
 
 // -----------------------------------------------------------------------------
-// --SECTION--                                                 private variables
+// --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
 
       private:
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up a parallel scan if the query allows it and the collection
+/// scan is directly followed by calculations and a filter that can be 
+/// evaluated by multiple threads
+////////////////////////////////////////////////////////////////////////////////
+
+        void setupParallelScan ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copy the current input row into the evaluation contexts of the
+/// parallel scan
+////////////////////////////////////////////////////////////////////////////////
+
+        void prepareParallelScan ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the calculations and the filter of the parallel scan for
+/// a document, using the evaluation context of the given partition
+////////////////////////////////////////////////////////////////////////////////
+
+        bool parallelFilter (size_t,
+                             TRI_doc_mptr_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release the parallel scan's evaluation contexts
+////////////////////////////////////////////////////////////////////////////////
+
+        void freeParallelScan ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a calculation that is evaluated during a parallel scan, with one
+/// copy of the expression per partition
+////////////////////////////////////////////////////////////////////////////////
+
+        struct ParallelCalculation {
+          std::vector<Expression*> expressions;
+          std::vector<Variable*> inVars;
+          std::vector<RegisterId> inRegs;
+          RegisterId outReg;
+          RegisterId conditionReg;
+        };
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -569,6 +629,51 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _mustStoreResult;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the attributes to extract from the documents. if empty, the
+/// documents are produced as a whole
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> const _projection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief calculations evaluated during a parallel scan, in plan order
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<ParallelCalculation> _parallelCalculations;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluation contexts of a parallel scan, one single-row block per
+/// partition
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<AqlItemBlock*> _parallelContexts;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief arenas for the values created by the calculations of a parallel
+/// scan, one per partition
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<JsonArena*> _parallelArenas;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief input registers read by the calculations of a parallel scan
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<RegisterId> _parallelInRegs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register of the enumerated document in a parallel scan
+////////////////////////////////////////////////////////////////////////////////
+
+        RegisterId _parallelDocumentReg;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register of the filter condition of a parallel scan
+////////////////////////////////////////////////////////////////////////////////
+
+        RegisterId _parallelFilterReg;
     };
 
 // -----------------------------------------------------------------------------
@@ -632,6 +737,19 @@ namespace triagens {
 
         void buildExpressions ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the bounds for all rows of the current input block and
+/// probe the index once per distinct lookup key
+////////////////////////////////////////////////////////////////////////////////
+
+        void buildBatchedLookups ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a string key identifying the evaluated _condition
+////////////////////////////////////////////////////////////////////////////////
+
+        std::string batchedLookupKey () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief free _condition if it belongs to us
 ////////////////////////////////////////////////////////////////////////////////
@@ -705,6 +823,16 @@ namespace triagens {
 
         void readSkiplistIndex (size_t atMost);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the projection of a document from the sub-objects of its
+/// index element
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue coverDocument (TRI_doc_mptr_t const*,
+                                TRI_shaped_sub_t const*,
+                                TRI_shaper_t*,
+                                triagens::basics::StringBuffer&) const;
+
 ////////////////////////////////////////////////////////////////////////////////
 // @brief: sorts the index range conditions and resets _posInRanges to 0
 ////////////////////////////////////////////////////////////////////////////////
@@ -868,103 +996,524 @@ namespace triagens {
 
         bool _hasV8Expression;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not lookups are batched per input block. this is the
+/// case for hash and edge indexes with variable bounds, i.e. when the block
+/// is the inner side of an index nested loop join
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _useBatchedLookups;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the attributes to extract from the documents. if empty, the
+/// documents are produced as a whole
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> const _projection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief index lookup results for the distinct keys of the current input
+/// block
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::vector<TRI_doc_mptr_copy_t>> _batchedResults;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position in _batchedResults for each row of the current input block
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<size_t> _batchedRows;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the projection is read from the index elements instead of
+/// the documents
+////////////////////////////////////////////////////////////////////////////////
+
+        bool const _covering;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of sub-objects per index element, i.e. the number of
+/// indexed fields
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t const _coveringFields;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position of each projected attribute in the index elements' 
+/// sub-objects, or one of the special positions for _key and _rev
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<size_t> _coveringPositions;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copies of the sub-objects of the index elements of the documents in
+/// _documents, _coveringFields per document. only filled for covering index
+/// reads. these are copies because the index elements may be freed by a
+/// modification in the same query while the block still holds the documents
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<TRI_shaped_sub_t> _coveringSubObjects;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sub-objects of the index elements for _batchedResults
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::vector<TRI_shaped_sub_t>> _batchedSubObjects;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                EnumerateListBlock
+// -----------------------------------------------------------------------------
+
+    class EnumerateListBlock : public ExecutionBlock {
+
+      public:
+
+        EnumerateListBlock (ExecutionEngine*,
+                            EnumerateListNode const*);
+
+        ~EnumerateListBlock ();
+
+        int initialize () override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initializeCursor, here we release our docs from this collection
+////////////////////////////////////////////////////////////////////////////////
+
+        int initializeCursor (AqlItemBlock* items, size_t pos) override;
+
+        AqlItemBlock* getSome (size_t atLeast, size_t atMost) override final;
+
+////////////////////////////////////////////////////////////////////////////////
+// skip between atLeast and atMost returns the number actually skipped . . .
+// will only return less than atLeast if there aren't atLeast many
+// things to skip overall.
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t skipSome (size_t atLeast, size_t atMost) override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from the inVariable using the current _index
+////////////////////////////////////////////////////////////////////////////////
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from the inVariable using the current _index
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue getAqlValue (AqlValue const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief throws an "array expected" exception
+////////////////////////////////////////////////////////////////////////////////
+
+        void throwArrayExpectedException ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current position in the _inVariable
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _index;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current block in DOCVEC
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _thisblock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of elements in DOCVEC before the current block
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _seen;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief total number of elements in DOCVEC
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _DOCVECsize;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief document collection from DOCVEC
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_document_collection_t const* _collection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the register index containing the inVariable of the EnumerateListNode
+////////////////////////////////////////////////////////////////////////////////
+
+        RegisterId _inVarRegId;
+
     };
 
-// -----------------------------------------------------------------------------
-// --SECTION--                                                EnumerateListBlock
-// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     HashJoinBlock
+// -----------------------------------------------------------------------------
+
+    class HashJoinBlock : public ExecutionBlock {
+
+      public:
+
+        HashJoinBlock (ExecutionEngine*,
+                       HashJoinNode const*);
+
+        ~HashJoinBlock ();
+
+        int initialize () override;
+
+        int initializeCursor (AqlItemBlock* items, size_t pos) override;
+
+        AqlItemBlock* getSome (size_t atLeast, size_t atMost) override final;
+
+////////////////////////////////////////////////////////////////////////////////
+// skip between atLeast and atMost returns the number actually skipped . . .
+// will only return less than atLeast if there aren't atLeast many
+// things to skip overall.
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t skipSome (size_t atLeast, size_t atMost) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read all documents of the collection into the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+        void buildHashTable ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the join attribute value from a document
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Json extractKey (TRI_df_marker_t const*,
+                                           TRI_document_collection_t const*,
+                                           triagens::basics::StringBuffer&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the documents matching a value
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<TRI_df_marker_t const*> const* lookup (AqlValue const&,
+                                                           TRI_document_collection_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hasher for the join values, works like 
+/// HashedAggregateBlock::GroupKeyHash
+////////////////////////////////////////////////////////////////////////////////
+
+        struct JoinKeyHash {
+          JoinKeyHash (triagens::arango::AqlTransaction* trx)
+            : _trx(trx) {
+          }
+
+          size_t operator() (AqlValue const& value) const {
+            return static_cast<size_t>(value.hash(_trx, nullptr));
+          }
+          
+          triagens::arango::AqlTransaction* _trx;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief comparator for the join values, works like 
+/// HashedAggregateBlock::GroupKeyEqual
+////////////////////////////////////////////////////////////////////////////////
+        
+        struct JoinKeyEqual {
+          JoinKeyEqual (triagens::arango::AqlTransaction* trx)
+            : _trx(trx) {
+          }
+
+          bool operator() (AqlValue const& lhs,
+                           AqlValue const& rhs) const {
+            return AqlValue::Compare(_trx, lhs, nullptr, rhs, nullptr, false) == 0;
+          }
+          
+          triagens::arango::AqlTransaction* _trx;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+        typedef std::unordered_map<AqlValue, 
+                                   std::vector<TRI_df_marker_t const*>, 
+                                   JoinKeyHash, 
+                                   JoinKeyEqual> HashTable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection* _collection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief attribute path of the join attribute
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> const _attribute;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register containing the values to look up
+////////////////////////////////////////////////////////////////////////////////
+
+        RegisterId _inRegister;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the hash table, mapping join values (JSON) to documents
+////////////////////////////////////////////////////////////////////////////////
+
+        HashTable _hashTable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief memory charged for the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceUsageScope _hashTableMemory;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the hash table was already built
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _hashTableBuilt;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents matching the current input row, nullptr if the current
+/// input row has not been looked up yet
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<TRI_df_marker_t const*> const* _matches;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief empty match list, used for values not contained in the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<TRI_df_marker_t const*> const _noMatches;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current position in _matches
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _posInMatches;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the joined documents need to be stored
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _mustStoreResult;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    TraversalBlock
+// -----------------------------------------------------------------------------
+
+    class TraversalBlock : public ExecutionBlock {
+
+      public:
+
+        TraversalBlock (ExecutionEngine*,
+                        TraversalNode const*);
+
+        ~TraversalBlock ();
+
+        int initialize () override;
+
+        int initializeCursor (AqlItemBlock* items, size_t pos) override;
+
+        AqlItemBlock* getSome (size_t atLeast, size_t atMost) override final;
+
+////////////////////////////////////////////////////////////////////////////////
+// skip between atLeast and atMost returns the number actually skipped . . .
+// will only return less than atLeast if there aren't atLeast many
+// things to skip overall.
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t skipSome (size_t atLeast, size_t atMost) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief one step of the current path: the vertex reached, the edge that
+/// led to it and the edges of the vertex that still need to be followed
+////////////////////////////////////////////////////////////////////////////////
+
+        struct PathStep {
+          PathStep (TRI_voc_cid_t cid,
+                    char const* key,
+                    TRI_df_marker_t const* edge)
+            : cid(cid),
+              key(key),
+              edge(edge),
+              edges(),
+              position(0),
+              edgesLoaded(false),
+              vertex(nullptr) {
+          }
+
+          TRI_voc_cid_t                    cid;
+          std::string                      key;
+          TRI_df_marker_t const*           edge;
+          std::vector<TRI_doc_mptr_copy_t> edges;
+          size_t                           position;
+          bool                             edgesLoaded;
+          TRI_json_t*                      vertex;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start a new traversal from the vertex in the current input row.
+/// returns false if the value does not denote a vertex
+////////////////////////////////////////////////////////////////////////////////
+
+        bool startTraversal (AqlValue const&,
+                             TRI_document_collection_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advance the traversal to the next vertex that must be returned.
+/// returns false if the traversal is exhausted
+////////////////////////////////////////////////////////////////////////////////
 
-    class EnumerateListBlock : public ExecutionBlock {
+        bool nextVertex ();
 
-      public:
+////////////////////////////////////////////////////////////////////////////////
+/// @brief try to extend the current path with a vertex, returns false if
+/// this is prohibited by the uniqueness options or a path condition
+////////////////////////////////////////////////////////////////////////////////
 
-        EnumerateListBlock (ExecutionEngine*,
-                            EnumerateListNode const*);
+        bool pushStep (TRI_voc_cid_t,
+                       char const*,
+                       TRI_df_marker_t const*);
 
-        ~EnumerateListBlock ();
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove the last step from the current path
+////////////////////////////////////////////////////////////////////////////////
 
-        int initialize () override;
+        void popStep ();
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief initializeCursor, here we release our docs from this collection
+/// @brief remove all steps from the current path
 ////////////////////////////////////////////////////////////////////////////////
 
-        int initializeCursor (AqlItemBlock* items, size_t pos) override;
+        void clearPath ();
 
-        AqlItemBlock* getSome (size_t atLeast, size_t atMost) override final;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check the path conditions for the current path length
+////////////////////////////////////////////////////////////////////////////////
+
+        bool checkPathConditions ();
 
 ////////////////////////////////////////////////////////////////////////////////
-// skip between atLeast and atMost returns the number actually skipped . . .
-// will only return less than atLeast if there aren't atLeast many
-// things to skip overall.
+/// @brief return the vertex document of a path step, null if the vertex
+/// does not exist
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t skipSome (size_t atLeast, size_t atMost) override final;
+        TRI_json_t const* vertexDocument (PathStep&);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief create an AqlValue from the inVariable using the current _index
+/// @brief build the path object for the current path
 ////////////////////////////////////////////////////////////////////////////////
 
+        triagens::basics::Json buildPath ();
+
 // -----------------------------------------------------------------------------
-// --SECTION--                                                 private functions
+// --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
 
-      private:
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the edge collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection* _edgeCollection;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief create an AqlValue from the inVariable using the current _index
+/// @brief the edge collection's document collection
 ////////////////////////////////////////////////////////////////////////////////
 
-        AqlValue getAqlValue (AqlValue const&);
+        TRI_document_collection_t* _edgeDocument;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief throws an "array expected" exception
+/// @brief the direction in which edges are followed
 ////////////////////////////////////////////////////////////////////////////////
 
-        void throwArrayExpectedException ();
+        TRI_edge_direction_e const _direction;
 
-// -----------------------------------------------------------------------------
-// --SECTION--                                                 private variables
-// -----------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+/// @brief depth and uniqueness options
+////////////////////////////////////////////////////////////////////////////////
 
-      private:
+        TraversalOptions const _options;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief current position in the _inVariable
+/// @brief register containing the start vertex
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _index;
+        RegisterId _inRegister;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief current block in DOCVEC
+/// @brief output registers for vertex, edge and path. the registers for
+/// the edge and the path are MaxRegisterId if not used
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _thisblock;
+        RegisterId _vertexRegister;
+        RegisterId _edgeRegister;
+        RegisterId _pathRegister;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief number of elements in DOCVEC before the current block
+/// @brief path conditions, indexed by path length
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _seen;
+        std::vector<std::vector<Expression*>> _pathConditions;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief total number of elements in DOCVEC
+/// @brief variables and registers used when evaluating path conditions
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _DOCVECsize;
+        std::vector<Variable*> _conditionVariables;
+        std::vector<RegisterId> _conditionRegisters;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief document collection from DOCVEC
+/// @brief the current path, the first step contains the start vertex
 ////////////////////////////////////////////////////////////////////////////////
 
-        TRI_document_collection_t const* _collection;
+        std::vector<PathStep> _path;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief the register index containing the inVariable of the EnumerateListNode
+/// @brief whether or not a traversal for the current input row is running,
+/// and whether the current vertex has already been returned
 ////////////////////////////////////////////////////////////////////////////////
 
-        RegisterId _inVarRegId;
+        bool _traversalStarted;
+        bool _hasVertex;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the outputs need to be stored
+////////////////////////////////////////////////////////////////////////////////
 
+        bool _mustStoreVertex;
+        bool _mustStoreEdge;
+        bool _mustStorePath;
     };
 
 // -----------------------------------------------------------------------------
@@ -997,6 +1546,13 @@ namespace triagens {
 
         void executeExpression (AqlItemBlock*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the expression for all rows of the block at once, returns
+/// false if the expression cannot be executed column-wise
+////////////////////////////////////////////////////////////////////////////////
+
+        bool executeColumnar (AqlItemBlock*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief doEvaluation, private helper to do the work
 ////////////////////////////////////////////////////////////////////////////////
@@ -1050,6 +1606,12 @@ namespace triagens {
 
         bool _isReference;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief results of a column-wise expression execution
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<uint8_t> _columnResults;
+
     };
 
 // -----------------------------------------------------------------------------
@@ -1122,6 +1684,20 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         ExecutionBlock* _subquery;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the subquery is constant and deterministic, so it
+/// needs to be executed only once per query
+////////////////////////////////////////////////////////////////////////////////
+
+        bool const _subqueryIsConst;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the result of a constant subquery, owned by the block. each 
+/// output block gets its own copy, which is shared by all rows of the block
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<AqlItemBlock*>* _constSubqueryResults;
     };
 
 // -----------------------------------------------------------------------------
@@ -1227,6 +1803,19 @@ namespace triagens {
 
         std::vector<std::pair<RegisterId, RegisterId>> _aggregateRegisters;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pairs of out register and in register for the aggregate functions.
+/// the in register is MaxRegisterId for functions without input
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<RegisterId, RegisterId>> _aggregatorRegisters;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief aggregate functions for the current group
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Aggregator*> _aggregators;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief details about the current group
 ////////////////////////////////////////////////////////////////////////////////
@@ -1279,6 +1868,12 @@ namespace triagens {
                            AqlItemBlock*& result,
                            size_t& skipped);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the aggregate functions for a new group
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Aggregator*> createAggregators () const;
+
       private:
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1287,6 +1882,13 @@ namespace triagens {
 
         std::vector<std::pair<RegisterId, RegisterId>> _aggregateRegisters;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pairs of out register and in register for the aggregate functions.
+/// the in register is MaxRegisterId for functions without input
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<RegisterId, RegisterId>> _aggregatorRegisters;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the optional register that contains the values for each group
 /// if no values should be returned, then this has a value of MaxRegisterId
@@ -1351,14 +1953,68 @@ namespace triagens {
 
         int initializeCursor (AqlItemBlock* items, size_t pos) override final;
 
+        int shutdown (int) override final;
+
+        bool hasMore () override final;
+
+        int64_t remaining () override final;
+
+      private:
+
+        int getOrSkipSome (size_t atLeast,
+                           size_t atMost,
+                           bool skipping,
+                           AqlItemBlock*& result,
+                           size_t& skipped) override;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief dosorting
 ////////////////////////////////////////////////////////////////////////////////
 
-      private:
-
         void doSorting ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sort the blocks in _buffer and write them into a new run file
+////////////////////////////////////////////////////////////////////////////////
+
+        void spillRun ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the next block of a run into its merge buffer. returns false
+/// if the run is exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+        bool readRun (size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merge rows from the spilled runs into _buffer, so that _buffer
+/// holds at least atMost rows or all runs are exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+        void mergeRuns (size_t atMost);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief close and remove all run files and free the merge buffers
+////////////////////////////////////////////////////////////////////////////////
+
+        void removeRuns ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a sorted run that was written to a temporary file
+////////////////////////////////////////////////////////////////////////////////
+
+        struct SortRun {
+          SortRun ()
+            : filename(),
+              fd(-1),
+              blocks(0) {
+          }
+
+          std::string filename;
+          int fd;
+          size_t blocks;
+        };
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief OurLessThan
 ////////////////////////////////////////////////////////////////////////////////
@@ -1393,12 +2049,75 @@ namespace triagens {
 
         std::vector<std::pair<RegisterId, bool>> _sortRegisters;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief MergeLessThan: comparison method for the heads of the spilled runs,
+/// works like GatherBlock::OurLessThan
+////////////////////////////////////////////////////////////////////////////////
+
+        class MergeLessThan {
+
+          public:
+            MergeLessThan (triagens::arango::AqlTransaction* trx,
+                           std::vector<std::deque<AqlItemBlock*>>& runBuffer,
+                           std::vector<std::pair<RegisterId, bool>>& sortRegisters)
+              : _trx(trx),
+                _runBuffer(runBuffer),
+                _sortRegisters(sortRegisters) {
+            }
+
+            bool operator() (std::pair<size_t, size_t> const& a,
+                             std::pair<size_t, size_t> const& b);
+
+          private:
+            triagens::arango::AqlTransaction* _trx;
+            std::vector<std::deque<AqlItemBlock*>>& _runBuffer;
+            std::vector<std::pair<RegisterId, bool>>& _sortRegisters;
+        };
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not the sort should be stable
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _stable;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of rows the sort needs to produce, 0 means all rows.
+/// if set, only the top _limit rows are kept in _buffer
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _limit;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of bytes buffered before a sorted run is spilled to
+/// disk. a value of 0 means the sort is done completely in memory
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _memoryLimit;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the runs spilled to disk, in input order
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<SortRun> _runs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the current block of each run during the merge
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::deque<AqlItemBlock*>> _runBuffer;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pairs (i, position in _runBuffer[i]), one per run
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<size_t, size_t>> _runPos;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of rows not yet handed out by the merge
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _runRowsLeft;
+
     };
 
 // -----------------------------------------------------------------------------
@@ -1945,6 +2664,20 @@ namespace triagens {
         
         bool getBlock (size_t i, size_t atLeast, size_t atMost);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prefetchAll: let all remote dependencies with an empty buffer read
+/// ahead, so that the shards work in parallel, non-simple case only
+////////////////////////////////////////////////////////////////////////////////
+
+        void prefetchAll (size_t atLeast, size_t atMost);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSomeFromAnyRemote: return the block of whichever remote
+/// dependency answers first, simple case only
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock* getSomeFromAnyRemote (size_t atLeast, size_t atMost);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief _gatherBlockBuffer: buffer the incoming block from each dependency
 /// separately 
@@ -1968,6 +2701,27 @@ namespace triagens {
 
         size_t _atDep = 0;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief _remoteDependencies: true if all dependencies are RemoteBlocks,
+/// which can read ahead asynchronously
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _remoteDependencies = false;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief _coordTransactionID: shared by all remote dependencies, so that we
+/// can wait for the first answer of any of them
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::arango::CoordTransactionID _coordTransactionID = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief _depExhausted: remote dependencies which have returned their last
+/// block, simple case only
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<bool> _depExhausted;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief pairs, consisting of variable and sort direction
 /// (true = ascending | false = descending)
@@ -2450,7 +3204,52 @@ namespace triagens {
         int64_t remaining () override final;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief internal method to send a request
+/// @brief set the coordinator transaction id used for read-ahead requests.
+/// a GatherBlock sets the same id for all its dependencies so that it can
+/// wait for whichever of them answers first
+////////////////////////////////////////////////////////////////////////////////
+
+        void setCoordTransactionID (triagens::arango::CoordTransactionID id) {
+          _coordTransactionID = id;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start an asynchronous getSome request for the next block, unless
+/// one is already in flight. returns true if a request is in flight after
+/// the call, and false if no read-ahead is possible (because a result has
+/// already been received, the remote side is exhausted or we are not on a
+/// coordinator)
+////////////////////////////////////////////////////////////////////////////////
+
+        bool prefetch (size_t atLeast, size_t atMost);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the operation id of the read-ahead request in flight, or 0
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::arango::OperationID prefetchOperationID () const {
+          return _prefetchOperationID;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the answer of a read-ahead request has been
+/// received and not yet handed out via getSome or skipSome
+////////////////////////////////////////////////////////////////////////////////
+
+        bool hasPrefetchedResult () const {
+          return _hasPrefetched;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hand over the answer to the read-ahead request in flight. the
+/// block takes ownership of the result and throws if it is an error
+////////////////////////////////////////////////////////////////////////////////
+
+        void receivePrefetch (triagens::arango::ClusterCommResult*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief internal method to send a request. if binaryFormat is set, the
+/// response may use the binary block format instead of JSON
 ////////////////////////////////////////////////////////////////////////////////
 
       private:
@@ -2458,7 +3257,43 @@ namespace triagens {
         triagens::arango::ClusterCommResult* sendRequest (
                   rest::HttpRequest::HttpRequestType type,
                   std::string const& urlPart,
-                  std::string const& body) const;
+                  std::string const& body,
+                  bool binaryFormat = false) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the result of getSome from a response body, which may be
+/// in JSON or in the binary block format
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock* decodeGetSome (char const* body,
+                                     size_t length,
+                                     bool isBinary);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait for the read-ahead request in flight, if any. the query on
+/// the DB server can only serve one request at a time, so this must be
+/// called before sending any other request
+////////////////////////////////////////////////////////////////////////////////
+
+        void waitForPrefetch ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait for the read-ahead request in flight and throw away its
+/// result and the rest of a received block
+////////////////////////////////////////////////////////////////////////////////
+
+        void discardPrefetch ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of rows of the received block not yet handed out
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t prefetchedRows () const {
+          if (_prefetched == nullptr) {
+            return 0;
+          }
+          return _prefetched->size() - _prefetchedPos;
+        }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief our server, can be like "shard:S1000" or like "server:Claus"
@@ -2484,7 +3319,48 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         ExecutionStats _deltaStats;
-        
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not we read ahead. this is only done on a coordinator,
+/// which waits for the answers in ClusterComm
+////////////////////////////////////////////////////////////////////////////////
+
+        bool const _usePrefetch;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the remote side has reported to be exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _exhausted;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief coordinator transaction id for read-ahead requests, 0 means that
+/// a new id is used for each request
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::arango::CoordTransactionID _coordTransactionID;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief operation id of the read-ahead request in flight, or 0
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::arango::OperationID _prefetchOperationID;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a read-ahead answer has been received. if so,
+/// _prefetched contains the block, or a nullptr if the remote side is
+/// exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _hasPrefetched;
+
+        std::unique_ptr<AqlItemBlock> _prefetched;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of rows of _prefetched already handed out
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _prefetchedPos;
 
     };
 
@@ -64,6 +64,14 @@ static ExecutionBlock* CreateBlock (ExecutionEngine* engine,
       return new EnumerateListBlock(engine,
                                     static_cast<EnumerateListNode const*>(en));
     }
+    case ExecutionNode::HASH_JOIN: {
+      return new HashJoinBlock(engine,
+                               static_cast<HashJoinNode const*>(en));
+    }
+    case ExecutionNode::TRAVERSAL: {
+      return new TraversalBlock(engine,
+                                static_cast<TraversalNode const*>(en));
+    }
     case ExecutionNode::CALCULATION: {
       return new CalculationBlock(engine,
                                   static_cast<CalculationNode const*>(en));
@@ -175,6 +183,7 @@ static ExecutionBlock* CreateBlock (ExecutionEngine* engine,
 
 ExecutionEngine::ExecutionEngine (Query* query)
   : _stats(),
+    _itemBlockManager(query->resourceMonitor()),
     _blocks(),
     _root(nullptr),
     _query(query),
@@ -537,6 +546,11 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
     optimizerOptionsRules.add(Json("-all"));
     optimizerOptions.set("rules", optimizerOptionsRules);
     options.set("optimizer", optimizerOptions);
+
+    // each part of the query is subject to the same memory limit
+    if (query->memoryLimit() > 0) {
+      options.set("memoryLimit", Json(static_cast<double>(query->memoryLimit())));
+    }
     result.set("options", options);
     std::unique_ptr<std::string> body(new std::string(triagens::basics::JsonHelper::toString(result.json())));
     
@@ -77,7 +77,9 @@ std::unordered_map<int, std::string const> const ExecutionNode::TypeNames{
   { static_cast<int>(DISTRIBUTE),                   "DistributeNode" },
   { static_cast<int>(GATHER),                       "GatherNode" },
   { static_cast<int>(NORESULTS),                    "NoResultsNode" },
-  { static_cast<int>(UPSERT),                       "UpsertNode" }
+  { static_cast<int>(UPSERT),                       "UpsertNode" },
+  { static_cast<int>(HASH_JOIN),                    "HashJoinNode" },
+  { static_cast<int>(TRAVERSAL),                    "TraversalNode" }
 };
           
 // -----------------------------------------------------------------------------
@@ -145,6 +147,10 @@ ExecutionNode* ExecutionNode::fromJsonFactory (ExecutionPlan* plan,
       return new EnumerateCollectionNode(plan, oneNode);
     case ENUMERATE_LIST:
       return new EnumerateListNode(plan, oneNode);
+    case HASH_JOIN:
+      return new HashJoinNode(plan, oneNode);
+    case TRAVERSAL:
+      return new TraversalNode(plan, oneNode);
     case FILTER:
       return new FilterNode(plan, oneNode);
     case LIMIT:
@@ -193,14 +199,31 @@ ExecutionNode* ExecutionNode::fromJsonFactory (ExecutionPlan* plan,
 
       bool count = JsonHelper::checkAndGetBooleanValue(oneNode.json(), "count");
 
-      return new AggregateNode(plan,
-                               oneNode,
-                               expressionVariable,
-                               outVariable,
-                               keepVariables,
-                               plan->getAst()->variables()->variables(false),
-                               aggregateVariables,  
-                               count);
+      std::unique_ptr<AggregateNode> node(new AggregateNode(plan,
+                                                            oneNode,
+                                                            expressionVariable,
+                                                            outVariable,
+                                                            keepVariables,
+                                                            plan->getAst()->variables()->variables(false),
+                                                            aggregateVariables,  
+                                                            count));
+
+      triagens::basics::Json jsonFunctions = oneNode.get("aggregateFunctions");
+
+      if (jsonFunctions.isArray()) {
+        size_t const n = jsonFunctions.size();
+
+        for (size_t i = 0; i < n; i++) {
+          triagens::basics::Json oneJsonFunction = jsonFunctions.at(static_cast<int>(i));
+          Variable* outVar = varFromJson(plan->getAst(), oneJsonFunction, "outVariable");
+          Variable* inVar = varFromJson(plan->getAst(), oneJsonFunction, "inVariable", true);
+          std::string const type = JsonHelper::checkAndGetStringValue(oneJsonFunction.json(), "type");
+
+          node->addAggregateFunction(outVar, inVar, type);
+        }
+      }
+
+      return node.release();
     }
     case INSERT:
       return new InsertNode(plan, oneNode);
@@ -918,6 +941,40 @@ void ExecutionNode::RegisterPlan::after (ExecutionNode *en) {
       break;
     }
 
+    case ExecutionNode::HASH_JOIN: {
+      depth++;
+      nrRegsHere.emplace_back(1);
+      // create a copy of the last value here
+      // this is requried because back returns a reference and emplace/push_back may invalidate all references
+      RegisterId registerId = 1 + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      auto ep = static_cast<HashJoinNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(make_pair(ep->_outVariable->id,
+                               VarInfo(depth, totalNrRegs)));
+      totalNrRegs++;
+      break;
+    }
+
+    case ExecutionNode::TRAVERSAL: {
+      depth++;
+      auto ep = static_cast<TraversalNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      auto vars = ep->getVariablesSetHere();
+      nrRegsHere.emplace_back(static_cast<RegisterId>(vars.size()));
+      // create a copy of the last value here
+      // this is requried because back returns a reference and emplace/push_back may invalidate all references
+      RegisterId registerId = static_cast<RegisterId>(vars.size()) + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      for (auto const& v : vars) {
+        varInfo.emplace(make_pair(v->id, VarInfo(depth, totalNrRegs)));
+        totalNrRegs++;
+      }
+      break;
+    }
+
     case ExecutionNode::CALCULATION: {
       nrRegsHere[depth]++;
       nrRegs[depth]++;
@@ -961,6 +1018,14 @@ void ExecutionNode::RegisterPlan::after (ExecutionNode *en) {
                                  VarInfo(depth, totalNrRegs)));
         totalNrRegs++;
       }
+      for (auto const& p : ep->_aggregateFunctions) {
+        // one output register for the result of each aggregate function
+        nrRegsHere[depth]++;
+        nrRegs[depth]++;
+        varInfo.emplace(make_pair(p.first->id,
+                                 VarInfo(depth, totalNrRegs)));
+        totalNrRegs++;
+      }
       if (ep->_outVariable != nullptr) {
         nrRegsHere[depth]++;
         nrRegs[depth]++;
@@ -1173,13 +1238,53 @@ double SingletonNode::estimateCost (size_t& nrItems) const {
 // --SECTION--                                methods of EnumerateCollectionNode
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the (optional) projection of a collection scan from JSON
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string> projectionFromJson (triagens::basics::Json const& base) {
+  std::vector<std::string> projection;
+
+  triagens::basics::Json jsonProjection = base.get("projection");
+
+  if (jsonProjection.isArray()) {
+    size_t const n = jsonProjection.size();
+    projection.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      projection.emplace_back(JsonHelper::getStringValue(jsonProjection.at(static_cast<int>(i)).json(), ""));
+    }
+  }
+
+  return projection;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add the projection of a collection scan to its JSON, if there is one
+////////////////////////////////////////////////////////////////////////////////
+
+static void projectionToJson (triagens::basics::Json& json,
+                              std::vector<std::string> const& projection) {
+  if (projection.empty()) {
+    return;
+  }
+
+  triagens::basics::Json attributes(triagens::basics::Json::Array, projection.size());
+  for (auto const& name : projection) {
+    attributes(triagens::basics::Json(name));
+  }
+
+  json("projection", attributes);
+}
+
 EnumerateCollectionNode::EnumerateCollectionNode (ExecutionPlan* plan,
                                                   triagens::basics::Json const& base)
   : ExecutionNode(plan, base),
     _vocbase(plan->getAst()->query()->vocbase()),
     _collection(plan->getAst()->query()->collections()->get(JsonHelper::checkAndGetStringValue(base.json(), "collection"))),
     _outVariable(varFromJson(plan->getAst(), base, "outVariable")),
-    _random(JsonHelper::checkAndGetBooleanValue(base.json(), "random")) {
+    _random(JsonHelper::checkAndGetBooleanValue(base.json(), "random")),
+    _projection(projectionFromJson(base)) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1201,6 +1306,8 @@ void EnumerateCollectionNode::toJsonHelper (triagens::basics::Json& nodes,
       ("outVariable", _outVariable->toJson())
       ("random", triagens::basics::Json(_random));
 
+  projectionToJson(json, _projection);
+
   // And add it:
   nodes(json);
 }
@@ -1219,6 +1326,7 @@ ExecutionNode* EnumerateCollectionNode::clone (ExecutionPlan* plan,
   }
     
   auto c = new EnumerateCollectionNode(plan, _id, _vocbase, _collection, outVariable, _random);
+  c->setProjection(_projection);
 
   cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -1501,6 +1609,11 @@ void IndexRangeNode::toJsonHelper (triagens::basics::Json& nodes,
  
   json("index", _index->toJson()); 
   json("reverse", triagens::basics::Json(_reverse));
+  projectionToJson(json, _projection);
+
+  if (_covering) {
+    json("covering", triagens::basics::Json(true));
+  }
 
   // And add it:
   nodes(json);
@@ -1526,6 +1639,8 @@ ExecutionNode* IndexRangeNode::clone (ExecutionPlan* plan,
 
   auto c = new IndexRangeNode(plan, _id, _vocbase, _collection, 
                               outVariable, _index, ranges, _reverse);
+  c->setProjection(_projection);
+  c->setCovering(_covering);
 
   cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -1544,7 +1659,9 @@ IndexRangeNode::IndexRangeNode (ExecutionPlan* plan,
     _outVariable(varFromJson(plan->getAst(), json, "outVariable")),
     _index(nullptr), 
     _ranges(),
-    _reverse(false) {
+    _reverse(false),
+    _projection(projectionFromJson(json)),
+    _covering(JsonHelper::getBooleanValue(json.json(), "covering", false)) {
 
   triagens::basics::Json rangeArrayJson(TRI_UNKNOWN_MEM_ZONE, JsonHelper::checkAndGetArrayValue(json.json(), "ranges"));
 
@@ -1798,6 +1915,251 @@ bool IndexRangeNode::estimateItemsWithIndexSelectivity (size_t incoming,
   return true;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                           methods of HashJoinNode
+// -----------------------------------------------------------------------------
+
+HashJoinNode::HashJoinNode (ExecutionPlan* plan,
+                            triagens::basics::Json const& base)
+  : ExecutionNode(plan, base),
+    _vocbase(plan->getAst()->query()->vocbase()),
+    _collection(plan->getAst()->query()->collections()->get(JsonHelper::checkAndGetStringValue(base.json(), "collection"))),
+    _outVariable(varFromJson(plan->getAst(), base, "outVariable")),
+    _attribute(),
+    _inVariable(varFromJson(plan->getAst(), base, "inVariable")) {
+
+  triagens::basics::Json jsonAttribute = base.get("attribute");
+
+  if (! jsonAttribute.isArray()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_BAD_JSON_PLAN, "missing attribute in HashJoinNode");
+  }
+
+  size_t const n = jsonAttribute.size();
+  _attribute.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    _attribute.emplace_back(JsonHelper::getStringValue(jsonAttribute.at(static_cast<int>(i)).json(), ""));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toJson, for HashJoinNode
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinNode::toJsonHelper (triagens::basics::Json& nodes,
+                                 TRI_memory_zone_t* zone,
+                                 bool verbose) const {
+  triagens::basics::Json json(ExecutionNode::toJsonHelperGeneric(nodes, zone, verbose));  // call base class method
+
+  if (json.isEmpty()) {
+    return;
+  }
+
+  triagens::basics::Json attribute(triagens::basics::Json::Array, _attribute.size());
+  for (auto const& name : _attribute) {
+    attribute(triagens::basics::Json(name));
+  }
+
+  json("database", triagens::basics::Json(_vocbase->_name))
+      ("collection", triagens::basics::Json(_collection->getName()))
+      ("outVariable", _outVariable->toJson())
+      ("attribute", attribute)
+      ("inVariable", _inVariable->toJson());
+
+  // And add it:
+  nodes(json);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* HashJoinNode::clone (ExecutionPlan* plan,
+                                    bool withDependencies,
+                                    bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto inVariable = _inVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    inVariable = plan->getAst()->variables()->createVariable(inVariable);
+  }
+
+  auto c = new HashJoinNode(plan, _id, _vocbase, _collection, outVariable, _attribute, inVariable);
+
+  cloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a hash join node
+////////////////////////////////////////////////////////////////////////////////
+
+double HashJoinNode::estimateCost (size_t& nrItems) const {
+  size_t incoming;
+  double depCost = _dependencies.at(0)->getCost(incoming);
+  size_t count = _collection->count();
+  // the collection is scanned only once to build the hash table. inserting
+  // a document is considered more expensive than a lookup, so that the plan
+  // building the hash table on the smaller collection wins. as we do not know
+  // the selectivity of the join attribute, we assume that each lookup
+  // produces one document
+  nrItems = incoming;
+  return depCost + 3.0 * count + incoming;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          methods of TraversalNode
+// -----------------------------------------------------------------------------
+
+TraversalNode::TraversalNode (ExecutionPlan* plan,
+                              triagens::basics::Json const& base)
+  : ExecutionNode(plan, base),
+    _vocbase(plan->getAst()->query()->vocbase()),
+    _edgeCollection(plan->getAst()->query()->collections()->get(JsonHelper::checkAndGetStringValue(base.json(), "edgeCollection"))),
+    _direction(static_cast<TRI_edge_direction_e>(JsonHelper::checkAndGetNumericValue<int>(base.json(), "direction"))),
+    _options(base),
+    _inVariable(varFromJson(plan->getAst(), base, "inVariable")),
+    _vertexOutVariable(varFromJson(plan->getAst(), base, "vertexOutVariable")),
+    _edgeOutVariable(varFromJson(plan->getAst(), base, "edgeOutVariable", Optional)),
+    _pathOutVariable(varFromJson(plan->getAst(), base, "pathOutVariable", Optional)),
+    _pathConditions() {
+
+  triagens::basics::Json jsonConditions = base.get("pathConditions");
+
+  if (jsonConditions.isArray()) {
+    size_t const n = jsonConditions.size();
+    _pathConditions.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      triagens::basics::Json condition = jsonConditions.at(static_cast<int>(i));
+      auto depth = JsonHelper::checkAndGetNumericValue<uint64_t>(condition.json(), "depth");
+      addPathCondition(depth, new Expression(plan->getAst(), condition));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the TraversalNode
+////////////////////////////////////////////////////////////////////////////////
+
+TraversalNode::~TraversalNode () {
+  for (auto& it : _pathConditions) {
+    delete it.expression;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toJson, for TraversalNode
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalNode::toJsonHelper (triagens::basics::Json& nodes,
+                                  TRI_memory_zone_t* zone,
+                                  bool verbose) const {
+  triagens::basics::Json json(ExecutionNode::toJsonHelperGeneric(nodes, zone, verbose));  // call base class method
+
+  if (json.isEmpty()) {
+    return;
+  }
+
+  json("database", triagens::basics::Json(_vocbase->_name))
+      ("edgeCollection", triagens::basics::Json(_edgeCollection->getName()))
+      ("direction", triagens::basics::Json(static_cast<double>(_direction)))
+      ("inVariable", _inVariable->toJson())
+      ("vertexOutVariable", _vertexOutVariable->toJson());
+
+  if (_edgeOutVariable != nullptr) {
+    json("edgeOutVariable", _edgeOutVariable->toJson());
+  }
+  if (_pathOutVariable != nullptr) {
+    json("pathOutVariable", _pathOutVariable->toJson());
+  }
+
+  _options.toJson(json, zone);
+
+  if (! _pathConditions.empty()) {
+    triagens::basics::Json conditions(triagens::basics::Json::Array, _pathConditions.size());
+
+    for (auto const& it : _pathConditions) {
+      triagens::basics::Json condition(triagens::basics::Json::Object, 2);
+      condition("depth", triagens::basics::Json(static_cast<double>(it.depth)))
+               ("expression", it.expression->toJson(TRI_UNKNOWN_MEM_ZONE, verbose));
+      conditions(condition);
+    }
+
+    json("pathConditions", conditions);
+  }
+
+  // And add it:
+  nodes(json);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* TraversalNode::clone (ExecutionPlan* plan,
+                                     bool withDependencies,
+                                     bool withProperties) const {
+  auto inVariable = _inVariable;
+  auto vertexOutVariable = _vertexOutVariable;
+  auto edgeOutVariable = _edgeOutVariable;
+  auto pathOutVariable = _pathOutVariable;
+
+  if (withProperties) {
+    inVariable = plan->getAst()->variables()->createVariable(inVariable);
+    vertexOutVariable = plan->getAst()->variables()->createVariable(vertexOutVariable);
+    if (edgeOutVariable != nullptr) {
+      edgeOutVariable = plan->getAst()->variables()->createVariable(edgeOutVariable);
+    }
+    if (pathOutVariable != nullptr) {
+      pathOutVariable = plan->getAst()->variables()->createVariable(pathOutVariable);
+    }
+  }
+
+  auto c = new TraversalNode(plan, _id, _vocbase, _edgeCollection, _direction, _options, 
+                             inVariable, vertexOutVariable, edgeOutVariable, pathOutVariable);
+
+  for (auto const& it : _pathConditions) {
+    c->addPathCondition(it.depth, it.expression->clone());
+  }
+
+  cloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a traversal node
+////////////////////////////////////////////////////////////////////////////////
+
+double TraversalNode::estimateCost (size_t& nrItems) const {
+  size_t incoming;
+  double depCost = _dependencies.at(0)->getCost(incoming);
+
+  // we do not know the number of edges per vertex. we assume a small
+  // constant fan-out per vertex and sum up the vertices on all depths
+  // that are visited
+  double const fanOut = 3.0;
+  double perStart = 0.0;
+  double reached = 1.0;
+
+  for (uint64_t depth = 0; depth <= _options.maxDepth; ++depth) {
+    if (depth >= _options.minDepth) {
+      perStart += reached;
+    }
+    if (depth < _options.maxDepth) {
+      reached *= fanOut;
+    }
+  }
+
+  // path conditions may prune some of the branches, but we cannot tell
+  // how many
+  nrItems = static_cast<size_t>(incoming * perStart);
+  return depCost + incoming * reached * fanOut;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                              methods of LimitNode
 // -----------------------------------------------------------------------------
@@ -1935,7 +2297,8 @@ void SubqueryNode::toJsonHelper (triagens::basics::Json& nodes,
     return;
   }
   json("subquery",  _subquery->toJson(TRI_UNKNOWN_MEM_ZONE, verbose))
-      ("outVariable", _outVariable->toJson());
+      ("outVariable", _outVariable->toJson())
+      ("isConst", triagens::basics::Json(const_cast<SubqueryNode*>(this)->isConst()));
 
   // And add it:
   nodes(json);
@@ -2013,7 +2376,7 @@ struct SubqueryVarUsageFinder : public WalkerWorker<ExecutionNode> {
      
     // create the set difference. note: cannot use std::set_difference as our sets are NOT sorted
     for (auto it = subfinder._usedLater.begin(); it != subfinder._usedLater.end(); ++it) {
-      if (_valid.find(*it) != _valid.end()) {
+      if (subfinder._valid.find(*it) == subfinder._valid.end()) {
         _usedLater.emplace((*it));
       }
     }
@@ -2073,6 +2436,68 @@ bool SubqueryNode::canThrow () {
   return finder._canThrow;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief helper struct to find non-deterministic nodes in a subquery, 
+/// including all nested subqueries
+////////////////////////////////////////////////////////////////////////////////
+
+struct DeterministicFinder : public WalkerWorker<ExecutionNode> {
+  bool _isDeterministic;
+
+  DeterministicFinder () 
+    : _isDeterministic(true) {
+  }
+
+  ~DeterministicFinder () {
+  }
+
+  bool before (ExecutionNode* node) override final {
+    switch (node->getType()) {
+      case ExecutionNode::INSERT:
+      case ExecutionNode::REMOVE:
+      case ExecutionNode::REPLACE:
+      case ExecutionNode::UPDATE:
+      case ExecutionNode::UPSERT: {
+        _isDeterministic = false;
+        break;
+      }
+      case ExecutionNode::CALCULATION: {
+        if (! static_cast<CalculationNode*>(node)->expression()->isDeterministic()) {
+          _isDeterministic = false;
+        }
+        break;
+      }
+      case ExecutionNode::ENUMERATE_COLLECTION: {
+        if (static_cast<EnumerateCollectionNode*>(node)->isRandom()) {
+          _isDeterministic = false;
+        }
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+
+    // abort the walk as soon as a non-deterministic node was found
+    return ! _isDeterministic;
+  }
+
+};
+
+bool SubqueryNode::isDeterministic () {
+  DeterministicFinder finder;
+  _subquery->walk(&finder);
+  return finder._isDeterministic;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the subquery is constant
+////////////////////////////////////////////////////////////////////////////////
+
+bool SubqueryNode::isConst () {
+  return (getVariablesUsedHere().empty() && isDeterministic());
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                             methods of FilterNode
 // -----------------------------------------------------------------------------
@@ -2144,7 +2569,8 @@ SortNode::SortNode (ExecutionPlan* plan,
                     bool stable)
   : ExecutionNode(plan, base),
     _elements(elements),
-    _stable(stable) {
+    _stable(stable),
+    _limit(JsonHelper::getNumericValue<decltype(_limit)>(base.json(), "limit", 0)) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2169,6 +2595,10 @@ void SortNode::toJsonHelper (triagens::basics::Json& nodes,
   json("elements", values);
   json("stable", triagens::basics::Json(_stable));
 
+  if (_limit > 0) {
+    json("limit", triagens::basics::Json(static_cast<double>(_limit)));
+  }
+
   // And add it:
   nodes(json);
 }
@@ -2305,6 +2735,12 @@ double SortNode::estimateCost (size_t& nrItems) const {
   if (nrItems <= 3.0) {
     return depCost + nrItems;
   }
+  if (_limit > 0 && _limit < nrItems) {
+    // top-k: each row is compared against a heap of size _limit
+    double cost = depCost + nrItems * log(static_cast<double>(_limit) + 1.0);
+    nrItems = _limit;
+    return cost;
+  }
   return depCost + nrItems * log(nrItems);
 }
 
@@ -2355,6 +2791,23 @@ void AggregateNode::toJsonHelper (triagens::basics::Json& nodes,
   }
   json("aggregates", values);
 
+  if (! _aggregateFunctions.empty()) {
+    triagens::basics::Json functions(triagens::basics::Json::Array, _aggregateFunctions.size());
+
+    for (auto const& it : _aggregateFunctions) {
+      triagens::basics::Json function(triagens::basics::Json::Object);
+      function("outVariable", it.first->toJson());
+
+      // the input variable is empty for LENGTH
+      if (it.second.first != nullptr) {
+        function("inVariable", it.second.first->toJson());
+      }
+      function("type", triagens::basics::Json(it.second.second));
+      functions(function);
+    }
+    json("aggregateFunctions", functions);
+  }
+
   // expression variable might be empty
   if (_expressionVariable != nullptr) {
     json("expressionVariable", _expressionVariable->toJson());
@@ -2393,6 +2846,7 @@ ExecutionNode* AggregateNode::clone (ExecutionPlan* plan,
   auto outVariable = _outVariable;
   auto expressionVariable = _expressionVariable;
   auto aggregateVariables = _aggregateVariables;
+  auto aggregateFunctions = _aggregateFunctions;
 
   if (withProperties) {
     if (expressionVariable != nullptr) {
@@ -2411,6 +2865,17 @@ ExecutionNode* AggregateNode::clone (ExecutionPlan* plan,
       auto in  = plan->getAst()->variables()->createVariable(it.second);
       aggregateVariables.emplace_back(std::make_pair(out, in));
     }
+
+    aggregateFunctions.clear();
+
+    for (auto& it : _aggregateFunctions) {
+      auto out = plan->getAst()->variables()->createVariable(it.first);
+      Variable* in = nullptr;
+      if (it.second.first != nullptr) {
+        in = plan->getAst()->variables()->createVariable(it.second.first);
+      }
+      aggregateFunctions.emplace_back(std::make_pair(out, std::make_pair(in, it.second.second)));
+    }
   }
 
   auto c = new AggregateNode(plan, 
@@ -2423,6 +2888,10 @@ ExecutionNode* AggregateNode::clone (ExecutionPlan* plan,
                              _variableMap,
                              _count);
 
+  for (auto const& it : aggregateFunctions) {
+    c->addAggregateFunction(it.first, it.second.first, it.second.second);
+  }
+
   cloneHelper(c, plan, withDependencies, withProperties);
 
   return static_cast<ExecutionNode*>(c);
@@ -2450,6 +2919,8 @@ struct UserVarFinder : public WalkerWorker<ExecutionNode> {
     else if (en->getType() == ExecutionNode::ENUMERATE_COLLECTION ||
              en->getType() == ExecutionNode::INDEX_RANGE ||
              en->getType() == ExecutionNode::ENUMERATE_LIST ||
+             en->getType() == ExecutionNode::HASH_JOIN ||
+             en->getType() == ExecutionNode::TRAVERSAL ||
              en->getType() == ExecutionNode::AGGREGATE) {
       depth += 1;
     }
@@ -2471,6 +2942,12 @@ std::vector<Variable const*> AggregateNode::getVariablesUsedHere () const {
     v.emplace(p.second);
   }
 
+  for (auto const& p : _aggregateFunctions) {
+    if (p.second.first != nullptr) {
+      v.emplace(p.second.first);
+    }
+  }
+
   if (_expressionVariable != nullptr) {
     v.emplace(_expressionVariable);
   }
@@ -38,11 +38,13 @@
 #include "Aql/Query.h"
 #include "Aql/RangeInfo.h"
 #include "Aql/Range.h"
+#include "Aql/TraversalOptions.h"
 #include "Aql/types.h"
 #include "Aql/Variable.h"
 #include "Aql/WalkerWorker.h"
 #include "Basics/JsonHelper.h"
 #include "lib/Basics/json-utilities.h"
+#include "VocBase/edge-collection.h"
 #include "VocBase/voc-types.h"
 #include "VocBase/vocbase.h"
 
@@ -101,7 +103,9 @@ namespace triagens {
           RETURN                  = 18,
           NORESULTS               = 19,
           DISTRIBUTE              = 20,
-          UPSERT                  = 21
+          UPSERT                  = 21,
+          HASH_JOIN               = 22,
+          TRAVERSAL               = 23
         };
 
 // -----------------------------------------------------------------------------
@@ -874,7 +878,8 @@ namespace triagens {
             _vocbase(vocbase), 
             _collection(collection),
             _outVariable(outVariable),  
-            _random(random) {
+            _random(random),
+            _projection() {
 
           TRI_ASSERT(_vocbase != nullptr);
           TRI_ASSERT(_collection != nullptr);
@@ -955,6 +960,14 @@ namespace triagens {
           _random = true;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the documents are iterated in random order
+////////////////////////////////////////////////////////////////////////////////
+
+        bool isRandom () const {
+          return _random;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the database
 ////////////////////////////////////////////////////////////////////////////////
@@ -979,6 +992,23 @@ namespace triagens {
           return _outVariable;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the projection, i.e. the top-level attributes of the
+/// documents that are used later on. if empty, whole documents are produced
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> const& projection () const {
+          return _projection;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the projection
+////////////////////////////////////////////////////////////////////////////////
+
+        void setProjection (std::vector<std::string> const& projection) {
+          _projection = projection;
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -1008,6 +1038,13 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _random;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the top-level attributes extracted from the documents, empty
+/// means whole documents
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> _projection;
     };
 
 // -----------------------------------------------------------------------------
@@ -1143,7 +1180,9 @@ namespace triagens {
             _outVariable(outVariable),
             _index(index),
             _ranges(ranges),
-            _reverse(reverse) {
+            _reverse(reverse),
+            _projection(),
+            _covering(false) {
 
           TRI_ASSERT(_vocbase != nullptr);
           TRI_ASSERT(_collection != nullptr);
@@ -1188,6 +1227,40 @@ namespace triagens {
           return _outVariable;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the projection, i.e. the top-level attributes of the
+/// documents that are used later on. if empty, whole documents are produced
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> const& projection () const {
+          return _projection;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the projection
+////////////////////////////////////////////////////////////////////////////////
+
+        void setProjection (std::vector<std::string> const& projection) {
+          _projection = projection;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the projection is read from the index elements
+/// instead of the documents
+////////////////////////////////////////////////////////////////////////////////
+
+        bool isCovering () const {
+          return _covering;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set whether or not the projection is read from the index elements
+////////////////////////////////////////////////////////////////////////////////
+
+        void setCovering (bool value) {
+          _covering = value;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the ranges
 ////////////////////////////////////////////////////////////////////////////////
@@ -1309,6 +1382,424 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _reverse;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the top-level attributes extracted from the documents, empty
+/// means whole documents
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> _projection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the projection is read from the index elements
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _covering;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class HashJoinNode
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief class HashJoinNode
+/// enumerates the documents of a collection whose attribute value is equal
+/// to the value of the input variable. the documents of the collection are
+/// put into an in-memory hash table once, which is then probed for each
+/// incoming row
+////////////////////////////////////////////////////////////////////////////////
+
+    class HashJoinNode : public ExecutionNode {
+      friend class ExecutionNode;
+      friend class ExecutionBlock;
+      friend class HashJoinBlock;
+      
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor with a vocbase and a collection
+////////////////////////////////////////////////////////////////////////////////
+
+      public:
+
+        HashJoinNode (ExecutionPlan* plan,
+                      size_t id,
+                      TRI_vocbase_t* vocbase, 
+                      Collection* collection,
+                      Variable const* outVariable,
+                      std::vector<std::string> const& attribute,
+                      Variable const* inVariable)
+          : ExecutionNode(plan, id), 
+            _vocbase(vocbase), 
+            _collection(collection),
+            _outVariable(outVariable),
+            _attribute(attribute),
+            _inVariable(inVariable) {
+
+          TRI_ASSERT(_vocbase != nullptr);
+          TRI_ASSERT(_collection != nullptr);
+          TRI_ASSERT(_outVariable != nullptr);
+          TRI_ASSERT(! _attribute.empty());
+          TRI_ASSERT(_inVariable != nullptr);
+        }
+
+        HashJoinNode (ExecutionPlan* plan,
+                      triagens::basics::Json const& base);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the type of the node
+////////////////////////////////////////////////////////////////////////////////
+
+        NodeType getType () const override final {
+          return HASH_JOIN;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief export to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        void toJsonHelper (triagens::basics::Json&,
+                           TRI_memory_zone_t*,
+                           bool) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+        ExecutionNode* clone (ExecutionPlan* plan,
+                              bool withDependencies,
+                              bool withProperties) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a hash join node is the cost of building the hash
+/// table once plus one lookup per incoming item
+////////////////////////////////////////////////////////////////////////////////
+        
+        double estimateCost (size_t&) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getVariablesUsedHere
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> getVariablesUsedHere () const override final {
+          return std::vector<Variable const*>{ _inVariable };
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getVariablesSetHere
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> getVariablesSetHere () const override final {
+          return std::vector<Variable const*>{ _outVariable };
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the database
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_vocbase_t* vocbase () const {
+          return _vocbase;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* collection () const {
+          return _collection;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the out variable
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* outVariable () const {
+          return _outVariable;
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the database
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_vocbase_t* _vocbase;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection* _collection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief output variable, the joined document
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _outVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief attribute path of the documents used as the hash key (e.g. for
+/// `b.x.y`, this contains `x` and `y`)
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::string> _attribute;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief input variable, its value is looked up in the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _inVariable;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               class TraversalNode
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief class TraversalNode
+/// walks the edges of an edge collection, starting at the vertex produced by
+/// the input variable, and produces one row for each vertex reached within
+/// the configured depth range
+////////////////////////////////////////////////////////////////////////////////
+
+    class TraversalNode : public ExecutionNode {
+      friend class ExecutionNode;
+      friend class ExecutionBlock;
+      friend class TraversalBlock;
+      friend class RedundantCalculationsReplacer;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a condition on the path variable that can be evaluated as soon
+/// as the path has reached the given depth
+////////////////////////////////////////////////////////////////////////////////
+
+      public:
+
+        struct PathCondition {
+          PathCondition (uint64_t depth,
+                         Expression* expression)
+            : depth(depth),
+              expression(expression) {
+          }
+
+          uint64_t    depth;
+          Expression* expression;
+        };
+      
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor with a vocbase and an edge collection
+////////////////////////////////////////////////////////////////////////////////
+
+        TraversalNode (ExecutionPlan* plan,
+                       size_t id,
+                       TRI_vocbase_t* vocbase, 
+                       Collection* edgeCollection,
+                       TRI_edge_direction_e direction,
+                       TraversalOptions const& options,
+                       Variable const* inVariable,
+                       Variable const* vertexOutVariable,
+                       Variable const* edgeOutVariable,
+                       Variable const* pathOutVariable)
+          : ExecutionNode(plan, id), 
+            _vocbase(vocbase), 
+            _edgeCollection(edgeCollection),
+            _direction(direction),
+            _options(options),
+            _inVariable(inVariable),
+            _vertexOutVariable(vertexOutVariable),
+            _edgeOutVariable(edgeOutVariable),
+            _pathOutVariable(pathOutVariable),
+            _pathConditions() {
+
+          TRI_ASSERT(_vocbase != nullptr);
+          TRI_ASSERT(_edgeCollection != nullptr);
+          TRI_ASSERT(_inVariable != nullptr);
+          TRI_ASSERT(_vertexOutVariable != nullptr);
+        }
+
+        TraversalNode (ExecutionPlan* plan,
+                       triagens::basics::Json const& base);
+
+        ~TraversalNode ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the type of the node
+////////////////////////////////////////////////////////////////////////////////
+
+        NodeType getType () const override final {
+          return TRAVERSAL;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief export to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        void toJsonHelper (triagens::basics::Json&,
+                           TRI_memory_zone_t*,
+                           bool) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+        ExecutionNode* clone (ExecutionPlan* plan,
+                              bool withDependencies,
+                              bool withProperties) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a traversal node grows with the number of depths that
+/// are visited for each incoming item
+////////////////////////////////////////////////////////////////////////////////
+        
+        double estimateCost (size_t&) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getVariablesUsedHere
+/// path conditions are not reported here, because they only refer to the
+/// path variable which is produced by this node itself
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> getVariablesUsedHere () const override final {
+          return std::vector<Variable const*>{ _inVariable };
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getVariablesSetHere
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> getVariablesSetHere () const override final {
+          std::vector<Variable const*> v{ _vertexOutVariable };
+
+          if (_edgeOutVariable != nullptr) {
+            v.emplace_back(_edgeOutVariable);
+          }
+          if (_pathOutVariable != nullptr) {
+            v.emplace_back(_pathOutVariable);
+          }
+          return v;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the database
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_vocbase_t* vocbase () const {
+          return _vocbase;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the edge collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* edgeCollection () const {
+          return _edgeCollection;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the traversal options
+////////////////////////////////////////////////////////////////////////////////
+
+        TraversalOptions const& options () const {
+          return _options;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the path out variable, may be a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* pathOutVariable () const {
+          return _pathOutVariable;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the path conditions
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<PathCondition> const& pathConditions () const {
+          return _pathConditions;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a path condition, the node takes over the ownership of the
+/// expression
+////////////////////////////////////////////////////////////////////////////////
+
+        void addPathCondition (uint64_t depth,
+                               Expression* expression) {
+          TRI_ASSERT(_pathOutVariable != nullptr);
+          TRI_ASSERT(expression != nullptr);
+
+          try {
+            _pathConditions.emplace_back(depth, expression);
+          }
+          catch (...) {
+            delete expression;
+            throw;
+          }
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the database
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_vocbase_t* _vocbase;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the edge collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection* _edgeCollection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the direction in which edges are followed
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_edge_direction_e _direction;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief depth and uniqueness options
+////////////////////////////////////////////////////////////////////////////////
+
+        TraversalOptions _options;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief input variable, the start vertex (id string or document)
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _inVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief output variable for the vertex
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _vertexOutVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief output variable for the edge, may be a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _edgeOutVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief output variable for the path, may be a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _pathOutVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief conditions on the path variable that are used to prune the
+/// traversal early
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<PathCondition> _pathConditions;
     };
 
 // -----------------------------------------------------------------------------
@@ -1393,6 +1884,30 @@ namespace triagens {
         
         double estimateCost (size_t&) const override final;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the offset
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t offset () const {
+          return _offset;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the limit
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t limit () const {
+          return _limit;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the node fully counts what it limits
+////////////////////////////////////////////////////////////////////////////////
+
+        inline bool fullCount () const {
+          return _fullCount;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tell the node to fully count what it will limit
 ////////////////////////////////////////////////////////////////////////////////
@@ -1436,6 +1951,7 @@ namespace triagens {
       friend class ExecutionNode;
       friend class ExecutionBlock;
       friend class CalculationBlock;
+      friend class EnumerateCollectionBlock;
       friend class RedundantCalculationsReplacer;
 
       public:
@@ -1511,6 +2027,14 @@ namespace triagens {
           return _outVariable;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the condition variable (might be null)
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* conditionVariable () const {
+          return _conditionVariable;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the expression
 ////////////////////////////////////////////////////////////////////////////////
@@ -1707,6 +2231,21 @@ namespace triagens {
 
         bool canThrow ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the subquery is deterministic, i.e. does not modify
+/// documents and does not use any non-deterministic functions
+////////////////////////////////////////////////////////////////////////////////
+
+        bool isDeterministic ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the subquery is constant, i.e. deterministic and
+/// does not use any variables from the outer query. the result of a constant
+/// subquery is the same for all input rows
+////////////////////////////////////////////////////////////////////////////////
+
+        bool isConst ();
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -1739,6 +2278,7 @@ namespace triagens {
       
       friend class ExecutionBlock;
       friend class FilterBlock;
+      friend class EnumerateCollectionBlock;
       friend class RedundantCalculationsReplacer;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1892,7 +2432,8 @@ namespace triagens {
                   bool stable) 
           : ExecutionNode(plan, id),
             _elements(elements),
-            _stable(stable) {
+            _stable(stable),
+            _limit(0) {
 
         }
         
@@ -1917,6 +2458,23 @@ namespace triagens {
           return _stable;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the maximum number of rows the sort has to produce (0 = all rows)
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t limit () const {
+          return _limit;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restrict the sort to the first <limit> rows of its output. this is
+/// set by the optimizer if the sort is followed by a LIMIT
+////////////////////////////////////////////////////////////////////////////////
+
+        void setLimit (size_t limit) {
+          _limit = limit;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief export to JSON
 ////////////////////////////////////////////////////////////////////////////////
@@ -1933,6 +2491,7 @@ namespace triagens {
                               bool withDependencies,
                               bool withProperties) const override final {
           auto c = new SortNode(plan, _id, _elements, _stable);
+          c->setLimit(_limit);
 
           cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -2003,6 +2562,13 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool _stable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of rows to produce, 0 means unlimited. if set, the
+/// SortBlock will only keep the top <limit> rows
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _limit;
     };
 
 
@@ -2175,6 +2741,14 @@ namespace triagens {
           _expressionVariable = variable;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the expression variable (might be null)
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* expressionVariable () const {
+          return _expressionVariable;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the variable map
 ////////////////////////////////////////////////////////////////////////////////
@@ -2183,6 +2757,14 @@ namespace triagens {
           return _variableMap;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the variables to keep (INTO ... KEEP ...)
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> const& keepVariables () const {
+          return _keepVariables;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get all aggregate variables (out, in)
 ////////////////////////////////////////////////////////////////////////////////
@@ -2191,6 +2773,26 @@ namespace triagens {
           return _aggregateVariables;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get all aggregate functions (out, (in, type))
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> const& aggregateFunctions () const {
+          return _aggregateFunctions;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add an aggregate function that is computed per group. the input
+/// variable is a nullptr for LENGTH, which only counts the group members
+////////////////////////////////////////////////////////////////////////////////
+
+        void addAggregateFunction (Variable const* outVariable,
+                                   Variable const* inVariable,
+                                   std::string const& type) {
+          TRI_ASSERT(outVariable != nullptr);
+          _aggregateFunctions.emplace_back(std::make_pair(outVariable, std::make_pair(inVariable, type)));
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief getVariablesUsedHere
 ////////////////////////////////////////////////////////////////////////////////
@@ -2203,12 +2805,15 @@ namespace triagens {
 
         std::vector<Variable const*> getVariablesSetHere () const override final {
           std::vector<Variable const*> v;
-          size_t const n = _aggregateVariables.size() + (_outVariable == nullptr ? 0 : 1);
+          size_t const n = _aggregateVariables.size() + _aggregateFunctions.size() + (_outVariable == nullptr ? 0 : 1);
           v.reserve(n);
 
           for (auto const& p : _aggregateVariables) {
             v.emplace_back(p.first);
           }
+          for (auto const& p : _aggregateFunctions) {
+            v.emplace_back(p.first);
+          }
           if (_outVariable != nullptr) {
             v.emplace_back(_outVariable);
           }
@@ -2233,6 +2838,13 @@ namespace triagens {
 
         std::vector<std::pair<Variable const*, Variable const*>> _aggregateVariables;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief aggregate functions computed incrementally for each group
+/// (out, (in, type))
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<Variable const*, std::pair<Variable const*, std::string>>> _aggregateFunctions;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief input expression variable (might be null)
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,7 @@
 #include "Aql/WalkerWorker.h"
 #include "Basics/JsonHelper.h"
 #include "Basics/Exceptions.h"
+#include "Cluster/ServerState.h"
 
 using namespace triagens::aql;
 using namespace triagens::basics;
@@ -336,6 +337,45 @@ AggregationOptions ExecutionPlan::createAggregationOptions (AstNode const* node)
   return options;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create traversal options from an AST node
+////////////////////////////////////////////////////////////////////////////////
+
+TraversalOptions ExecutionPlan::createTraversalOptions (AstNode const* node) {
+  TraversalOptions options;
+
+  // parse the traversal options we got
+  if (node != nullptr && 
+      node->type == NODE_TYPE_OBJECT) {
+    size_t n = node->numMembers();
+
+    for (size_t i = 0; i < n; ++i) {
+      auto member = node->getMember(i);
+
+      if (member != nullptr && 
+          member->type == NODE_TYPE_OBJECT_ELEMENT) {
+        auto name = member->getStringValue();
+        auto value = member->getMember(0);
+
+        TRI_ASSERT(value->isConstant());
+
+        if (strcmp(name, "uniqueVertices") == 0) {
+          if (value->isStringValue()) {
+            options.uniqueVertices = TraversalOptions::uniquenessFromString(value->getStringValue());
+          }
+        }
+        else if (strcmp(name, "uniqueEdges") == 0) {
+          if (value->isStringValue()) {
+            options.uniqueEdges = TraversalOptions::uniquenessFromString(value->getStringValue());
+          }
+        }
+      }
+    }
+  }
+
+  return options;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief register a node with the plan, will delete node if addition fails
 ////////////////////////////////////////////////////////////////////////////////
@@ -444,6 +484,97 @@ ExecutionNode* ExecutionPlan::fromNodeFor (ExecutionNode* previous,
   return addDependency(previous, en);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an execution plan element from an AST traversal FOR node
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* ExecutionPlan::fromNodeTraversal (ExecutionNode* previous,
+                                                 AstNode const* node) {
+  TRI_ASSERT(node != nullptr && node->type == NODE_TYPE_TRAVERSAL);
+  TRI_ASSERT(node->numMembers() >= 6);
+  TRI_ASSERT(node->numMembers() <= 8);
+
+  if (triagens::arango::ServerState::instance()->isCoordinator()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_UNSUPPORTED, "graph traversals are not supported in a cluster");
+  }
+
+  auto depth = node->getMember(0);
+  auto direction = node->getMember(1);
+  auto start = node->getMember(2);
+  auto edgeCollection = node->getMember(3);
+
+  TraversalOptions options = createTraversalOptions(node->getMember(4));
+
+  // determine the depth range
+  int64_t minDepth;
+  int64_t maxDepth;
+
+  if (depth->isConstant() && 
+      (depth->isValueType(VALUE_TYPE_INT) || depth->isValueType(VALUE_TYPE_DOUBLE))) {
+    minDepth = maxDepth = depth->getIntValue();
+  }
+  else if (depth->type == NODE_TYPE_RANGE &&
+           depth->getMember(0)->isConstant() && 
+           depth->getMember(1)->isConstant()) {
+    minDepth = depth->getMember(0)->getIntValue();
+    maxDepth = depth->getMember(1)->getIntValue();
+  }
+  else {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_PARSE, "traversal depth must be a constant number or range");
+  }
+
+  if (minDepth < 0 || minDepth > maxDepth) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_PARSE, "invalid traversal depth range");
+  }
+
+  options.minDepth = static_cast<uint64_t>(minDepth);
+  options.maxDepth = static_cast<uint64_t>(maxDepth);
+
+  TRI_ASSERT(direction->isValueType(VALUE_TYPE_INT));
+  
+  if (edgeCollection->type != NODE_TYPE_COLLECTION) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "no edge collection for traversal");
+  }
+
+  auto collection = _ast->query()->collections()->get(edgeCollection->getStringValue());
+
+  if (collection == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "no edge collection for traversal");
+  }
+
+  // fetch the output variables
+  Variable const* outVariables[] = { nullptr, nullptr, nullptr };
+
+  for (size_t i = 5; i < node->numMembers(); ++i) {
+    auto variable = node->getMember(i);
+    TRI_ASSERT(variable->type == NODE_TYPE_VARIABLE);
+    outVariables[i - 5] = static_cast<Variable const*>(variable->getData());
+    TRI_ASSERT(outVariables[i - 5] != nullptr);
+  }
+
+  Variable const* inVariable = nullptr;
+
+  if (start->type == NODE_TYPE_REFERENCE) {
+    // start vertex is already a variable
+    inVariable = static_cast<Variable const*>(start->getData());
+    TRI_ASSERT(inVariable != nullptr);
+  }
+  else {
+    // start vertex is some misc. expression
+    auto calc = createTemporaryCalculation(start);
+
+    calc->addDependency(previous);
+    inVariable = calc->outVariable();
+    previous = calc;
+  }
+
+  auto en = registerNode(new TraversalNode(this, nextId(), _ast->query()->vocbase(), collection, 
+                                           static_cast<TRI_edge_direction_e>(direction->getIntValue()), 
+                                           options, inVariable, outVariables[0], outVariables[1], outVariables[2]));
+  
+  return addDependency(previous, en);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an execution plan element from an AST FILTER node
 ////////////////////////////////////////////////////////////////////////////////
@@ -1255,6 +1386,11 @@ ExecutionNode* ExecutionPlan::fromNode (AstNode const* node) {
         break;
       }
 
+      case NODE_TYPE_TRAVERSAL: {
+        en = fromNodeTraversal(en, member);
+        break;
+      }
+
       case NODE_TYPE_FILTER: {
         en = fromNodeFilter(en, member);
         break;
@@ -1742,7 +1878,9 @@ bool ExecutionPlan::isDeadSimple () const {
     if (nodeType == ExecutionNode::SUBQUERY ||
         nodeType == ExecutionNode::ENUMERATE_COLLECTION ||
         nodeType == ExecutionNode::ENUMERATE_LIST ||
-        nodeType == ExecutionNode::INDEX_RANGE) {
+        nodeType == ExecutionNode::INDEX_RANGE ||
+        nodeType == ExecutionNode::HASH_JOIN ||
+        nodeType == ExecutionNode::TRAVERSAL) {
       // these node types are not simple
       return false;
     }
@@ -34,6 +34,7 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/AggregationOptions.h"
 #include "Aql/ModificationOptions.h"
+#include "Aql/TraversalOptions.h"
 #include "Aql/Query.h"
 #include "Aql/types.h"
 #include "Basics/json.h"
@@ -351,6 +352,12 @@ namespace triagens {
 
         AggregationOptions createAggregationOptions (AstNode const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create traversal options from an AST node
+////////////////////////////////////////////////////////////////////////////////
+
+        TraversalOptions createTraversalOptions (AstNode const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief adds "previous" as dependency to "plan", returns "plan"
 ////////////////////////////////////////////////////////////////////////////////
@@ -365,6 +372,13 @@ namespace triagens {
         ExecutionNode* fromNodeFor (ExecutionNode*,
                                     AstNode const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an execution plan element from an AST traversal FOR node
+////////////////////////////////////////////////////////////////////////////////
+
+        ExecutionNode* fromNodeTraversal (ExecutionNode*,
+                                          AstNode const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an execution plan element from an AST FILTER node
 ////////////////////////////////////////////////////////////////////////////////
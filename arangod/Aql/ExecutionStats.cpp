@@ -43,13 +43,24 @@ using JsonHelper = triagens::basics::JsonHelper;
 ////////////////////////////////////////////////////////////////////////////////
 
 Json ExecutionStats::toJson () const {
-  Json json(Json::Object, 5);
+  Json json(Json::Object, 9);
   json.set("writesExecuted", Json(static_cast<double>(writesExecuted)));
   json.set("writesIgnored",  Json(static_cast<double>(writesIgnored)));
   json.set("scannedFull",    Json(static_cast<double>(scannedFull)));
   json.set("scannedIndex",   Json(static_cast<double>(scannedIndex)));
   json.set("filtered",       Json(static_cast<double>(filtered)));
 
+  if (peakMemoryUsage > 0) {
+    // queries that never tracked any memory do not report their peak usage
+    json.set("peakMemoryUsage", Json(static_cast<double>(peakMemoryUsage)));
+  }
+
+  if (spilledRuns > 0) {
+    // the spill statistics are only reported if a sort spilled to disk
+    json.set("spilledRuns",    Json(static_cast<double>(spilledRuns)));
+    json.set("spilledBytes",   Json(static_cast<double>(spilledBytes)));
+  }
+
   if (fullCount > -1) {
     // fullCount is exceptional. it has a default value of -1 and is
     // not reported with this value
@@ -60,7 +71,7 @@ Json ExecutionStats::toJson () const {
 }
 
 Json ExecutionStats::toJsonStatic () {
-  Json json(Json::Object, 7);
+  Json json(Json::Object, 10);
   json.set("writesExecuted", Json(0.0));
   json.set("writesIgnored",  Json(0.0));
   json.set("scannedFull",    Json(0.0));
@@ -78,7 +89,10 @@ ExecutionStats::ExecutionStats()
    scannedFull(0),
    scannedIndex(0),
    filtered(0),
-   fullCount(-1) {
+   fullCount(-1),
+   spilledRuns(0),
+   spilledBytes(0),
+   peakMemoryUsage(0) {
 }
 
 ExecutionStats::ExecutionStats (triagens::basics::Json const& jsonStats) {
@@ -94,6 +108,12 @@ ExecutionStats::ExecutionStats (triagens::basics::Json const& jsonStats) {
 
   // note: fullCount is an optional attribute!
   fullCount      = JsonHelper::getNumericValue<int64_t>(jsonStats.json(), "fullCount", -1);
+
+  // note: the spill statistics are optional, too, as they are not sent by
+  // older servers
+  spilledRuns    = JsonHelper::getNumericValue<int64_t>(jsonStats.json(), "spilledRuns", 0);
+  spilledBytes   = JsonHelper::getNumericValue<int64_t>(jsonStats.json(), "spilledBytes", 0);
+  peakMemoryUsage = JsonHelper::getNumericValue<int64_t>(jsonStats.json(), "peakMemoryUsage", 0);
 }
 
 // -----------------------------------------------------------------------------
@@ -69,6 +69,9 @@ namespace triagens {
         scannedIndex   += summand.scannedIndex;
         fullCount      += summand.fullCount;
         filtered       += summand.filtered;
+        spilledRuns    += summand.spilledRuns;
+        spilledBytes   += summand.spilledBytes;
+        peakMemoryUsage += summand.peakMemoryUsage;
       }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +85,9 @@ namespace triagens {
         scannedIndex   += newStats.scannedIndex   - lastStats.scannedIndex;
         fullCount      += newStats.fullCount      - lastStats.fullCount;
         filtered       += newStats.filtered       - lastStats.filtered;
+        spilledRuns    += newStats.spilledRuns    - lastStats.spilledRuns;
+        spilledBytes   += newStats.spilledBytes   - lastStats.spilledBytes;
+        peakMemoryUsage += newStats.peakMemoryUsage - lastStats.peakMemoryUsage;
       }
 
 
@@ -121,6 +127,25 @@ namespace triagens {
 
       int64_t fullCount; 
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of sorted runs written to temporary files by SortBlocks
+////////////////////////////////////////////////////////////////////////////////
+
+      int64_t spilledRuns;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of bytes written to temporary files by SortBlocks
+////////////////////////////////////////////////////////////////////////////////
+
+      int64_t spilledBytes;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief peak number of bytes used by the query. for a distributed query,
+/// this is the sum of the peaks of the coordinator and DB server parts
+////////////////////////////////////////////////////////////////////////////////
+
+      int64_t peakMemoryUsage;
+
     };
 
   }
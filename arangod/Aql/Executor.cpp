@@ -111,21 +111,21 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   
   // string functions
   { "CONCAT",                      Function("CONCAT",                      "AQL_CONCAT", "szl|+", true, true, false, true, true, &Functions::Concat) },
-  { "CONCAT_SEPARATOR",            Function("CONCAT_SEPARATOR",            "AQL_CONCAT_SEPARATOR", "s,szl|+", true, true, false, true, true) },
-  { "CHAR_LENGTH",                 Function("CHAR_LENGTH",                 "AQL_CHAR_LENGTH", "s", true, true, false, true, true) },
-  { "LOWER",                       Function("LOWER",                       "AQL_LOWER", "s", true, true, false, true, true) },
-  { "UPPER",                       Function("UPPER",                       "AQL_UPPER", "s", true, true, false, true, true) },
-  { "SUBSTRING",                   Function("SUBSTRING",                   "AQL_SUBSTRING", "s,n|n", true, true, false, true, true) },
-  { "CONTAINS",                    Function("CONTAINS",                    "AQL_CONTAINS", "s,s|b", true, true, false, true, true) },
-  { "LIKE",                        Function("LIKE",                        "AQL_LIKE", "s,r|b", true, true, false, true, true) },
-  { "LEFT",                        Function("LEFT",                        "AQL_LEFT", "s,n", true, true, false, true, true) },
-  { "RIGHT",                       Function("RIGHT",                       "AQL_RIGHT", "s,n", true, true, false, true, true) },
-  { "TRIM",                        Function("TRIM",                        "AQL_TRIM", "s|ns", true, true, false, true, true) },
-  { "LTRIM",                       Function("LTRIM",                       "AQL_LTRIM", "s|s", true, true, false, true, true) },
-  { "RTRIM",                       Function("RTRIM",                       "AQL_RTRIM", "s|s", true, true, false, true, true) },
+  { "CONCAT_SEPARATOR",            Function("CONCAT_SEPARATOR",            "AQL_CONCAT_SEPARATOR", "s,szl|+", true, true, false, true, true, &Functions::ConcatSeparator) },
+  { "CHAR_LENGTH",                 Function("CHAR_LENGTH",                 "AQL_CHAR_LENGTH", "s", true, true, false, true, true, &Functions::CharLength) },
+  { "LOWER",                       Function("LOWER",                       "AQL_LOWER", "s", true, true, false, true, true, &Functions::Lower) },
+  { "UPPER",                       Function("UPPER",                       "AQL_UPPER", "s", true, true, false, true, true, &Functions::Upper) },
+  { "SUBSTRING",                   Function("SUBSTRING",                   "AQL_SUBSTRING", "s,n|n", true, true, false, true, true, &Functions::Substring) },
+  { "CONTAINS",                    Function("CONTAINS",                    "AQL_CONTAINS", "s,s|b", true, true, false, true, true, &Functions::Contains) },
+  { "LIKE",                        Function("LIKE",                        "AQL_LIKE", "s,r|b", true, true, false, true, true, &Functions::Like) },
+  { "LEFT",                        Function("LEFT",                        "AQL_LEFT", "s,n", true, true, false, true, true, &Functions::Left) },
+  { "RIGHT",                       Function("RIGHT",                       "AQL_RIGHT", "s,n", true, true, false, true, true, &Functions::Right) },
+  { "TRIM",                        Function("TRIM",                        "AQL_TRIM", "s|ns", true, true, false, true, true, &Functions::Trim) },
+  { "LTRIM",                       Function("LTRIM",                       "AQL_LTRIM", "s|s", true, true, false, true, true, &Functions::LTrim) },
+  { "RTRIM",                       Function("RTRIM",                       "AQL_RTRIM", "s|s", true, true, false, true, true, &Functions::RTrim) },
   { "FIND_FIRST",                  Function("FIND_FIRST",                  "AQL_FIND_FIRST", "s,s|zn,zn", true, true, false, true, true) },
   { "FIND_LAST",                   Function("FIND_LAST",                   "AQL_FIND_LAST", "s,s|zn,zn", true, true, false, true, true) },
-  { "SPLIT",                       Function("SPLIT",                       "AQL_SPLIT", "s|sl,n", true, true, false, true, true) },
+  { "SPLIT",                       Function("SPLIT",                       "AQL_SPLIT", "s|sl,n", true, true, false, true, true, &Functions::Split) },
   { "SUBSTITUTE",                  Function("SUBSTITUTE",                  "AQL_SUBSTITUTE", "s,las|lsn,n", true, true, false, true, true) },
   { "MD5",                         Function("MD5",                         "AQL_MD5", "s", true, true, false, true, true, &Functions::Md5) },
   { "SHA1",                        Function("SHA1",                        "AQL_SHA1", "s", true, true, false, true, true, &Functions::Sha1) },
@@ -145,24 +145,24 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   { "UNION_DISTINCT",              Function("UNION_DISTINCT",              "AQL_UNION_DISTINCT", "l,l|+", true, true, false, true, true, &Functions::UnionDistinct) },
   { "MINUS",                       Function("MINUS",                       "AQL_MINUS", "l,l|+", true, true, false, true, true) },
   { "INTERSECTION",                Function("INTERSECTION",                "AQL_INTERSECTION", "l,l|+", true, true, false, true, true, &Functions::Intersection) },
-  { "FLATTEN",                     Function("FLATTEN",                     "AQL_FLATTEN", "l|n", true, true, false, true, true) },
+  { "FLATTEN",                     Function("FLATTEN",                     "AQL_FLATTEN", "l|n", true, true, false, true, true, &Functions::Flatten) },
   { "LENGTH",                      Function("LENGTH",                      "AQL_LENGTH", "las", true, true, false, true, true, &Functions::Length) },
   { "MIN",                         Function("MIN",                         "AQL_MIN", "l", true, true, false, true, true, &Functions::Min) },
   { "MAX",                         Function("MAX",                         "AQL_MAX", "l", true, true, false, true, true, &Functions::Max) },
   { "SUM",                         Function("SUM",                         "AQL_SUM", "l", true, true, false, true, true, &Functions::Sum) },
-  { "MEDIAN",                      Function("MEDIAN",                      "AQL_MEDIAN", "l", true, true, false, true, true) }, 
-  { "PERCENTILE",                  Function("PERCENTILE",                  "AQL_PERCENTILE", "l,n|s", true, true, false, true, true) }, 
+  { "MEDIAN",                      Function("MEDIAN",                      "AQL_MEDIAN", "l", true, true, false, true, true, &Functions::Median) }, 
+  { "PERCENTILE",                  Function("PERCENTILE",                  "AQL_PERCENTILE", "l,n|s", true, true, false, true, true, &Functions::Percentile) }, 
   { "AVERAGE",                     Function("AVERAGE",                     "AQL_AVERAGE", "l", true, true, false, true, true, &Functions::Average) },
-  { "VARIANCE_SAMPLE",             Function("VARIANCE_SAMPLE",             "AQL_VARIANCE_SAMPLE", "l", true, true, false, true, true) },
-  { "VARIANCE_POPULATION",         Function("VARIANCE_POPULATION",         "AQL_VARIANCE_POPULATION", "l", true, true, false, true, true) },
-  { "STDDEV_SAMPLE",               Function("STDDEV_SAMPLE",               "AQL_STDDEV_SAMPLE", "l", true, true, false, true, true) },
-  { "STDDEV_POPULATION",           Function("STDDEV_POPULATION",           "AQL_STDDEV_POPULATION", "l", true, true, false, true, true) },
+  { "VARIANCE_SAMPLE",             Function("VARIANCE_SAMPLE",             "AQL_VARIANCE_SAMPLE", "l", true, true, false, true, true, &Functions::VarianceSample) },
+  { "VARIANCE_POPULATION",         Function("VARIANCE_POPULATION",         "AQL_VARIANCE_POPULATION", "l", true, true, false, true, true, &Functions::VariancePopulation) },
+  { "STDDEV_SAMPLE",               Function("STDDEV_SAMPLE",               "AQL_STDDEV_SAMPLE", "l", true, true, false, true, true, &Functions::StdDevSample) },
+  { "STDDEV_POPULATION",           Function("STDDEV_POPULATION",           "AQL_STDDEV_POPULATION", "l", true, true, false, true, true, &Functions::StdDevPopulation) },
   { "UNIQUE",                      Function("UNIQUE",                      "AQL_UNIQUE", "l", true, true, false, true, true, &Functions::Unique) },
-  { "SLICE",                       Function("SLICE",                       "AQL_SLICE", "l,n|n", true, true, false, true, true) },
+  { "SLICE",                       Function("SLICE",                       "AQL_SLICE", "l,n|n", true, true, false, true, true, &Functions::Slice) },
   { "REVERSE",                     Function("REVERSE",                     "AQL_REVERSE", "ls", true, true, false, true, true) },    // note: REVERSE() can be applied on strings, too
-  { "FIRST",                       Function("FIRST",                       "AQL_FIRST", "l", true, true, false, true, true) },
-  { "LAST",                        Function("LAST",                        "AQL_LAST", "l", true, true, false, true, true) },
-  { "NTH",                         Function("NTH",                         "AQL_NTH", "l,n", true, true, false, true, true) },
+  { "FIRST",                       Function("FIRST",                       "AQL_FIRST", "l", true, true, false, true, true, &Functions::First) },
+  { "LAST",                        Function("LAST",                        "AQL_LAST", "l", true, true, false, true, true, &Functions::Last) },
+  { "NTH",                         Function("NTH",                         "AQL_NTH", "l,n", true, true, false, true, true, &Functions::Nth) },
   { "POSITION",                    Function("POSITION",                    "AQL_POSITION", "l,.|b", true, true, false, true, true) },
   { "CALL",                        Function("CALL",                        "AQL_CALL", "s|.+", false, false, true, false, true) },
   { "APPLY",                       Function("APPLY",                       "AQL_APPLY", "s|l", false, false, true, false, false) },
@@ -185,8 +185,8 @@ std::unordered_map<std::string, Function const> const Executor::FunctionNames{
   { "MATCHES",                     Function("MATCHES",                     "AQL_MATCHES", ".,l|b", true, true, false, true, true) },
   { "UNSET",                       Function("UNSET",                       "AQL_UNSET", "a,sl|+", true, true, false, true, true, &Functions::Unset) },
   { "KEEP",                        Function("KEEP",                        "AQL_KEEP", "a,sl|+", true, true, false, true, true, &Functions::Keep) },
-  { "TRANSLATE",                   Function("TRANSLATE",                   "AQL_TRANSLATE", ".,a|.", true, true, false, true, true) },
-  { "ZIP",                         Function("ZIP",                         "AQL_ZIP", "l,l", true, true, false, true, true) },
+  { "TRANSLATE",                   Function("TRANSLATE",                   "AQL_TRANSLATE", ".,a|.", true, true, false, true, true, &Functions::Translate) },
+  { "ZIP",                         Function("ZIP",                         "AQL_ZIP", "l,l", true, true, false, true, true, &Functions::Zip) },
 
   // geo functions
   { "NEAR",                        Function("NEAR",                        "AQL_NEAR", "h,n,n|nz,s", true, false, true, false, true) },
@@ -32,6 +32,7 @@
 #include "Aql/AqlValue.h"
 #include "Aql/Ast.h"
 #include "Aql/AttributeAccessor.h"
+#include "Aql/ColumnarExpression.h"
 #include "Aql/Executor.h"
 #include "Aql/V8Expression.h"
 #include "Aql/Variable.h"
@@ -83,13 +84,16 @@ Expression::Expression (Ast* ast,
                         AstNode const* node)
   : _ast(ast),
     _executor(_ast->query()->executor()),
+    _jsonArena(_ast->query()->jsonArena()),
     _node(node),
+    _columnar(nullptr),
     _type(UNPROCESSED),
     _canThrow(true),
     _canRunOnDBServer(false),
     _isDeterministic(false),
     _hasDeterminedAttributes(false),
     _built(false),
+    _columnarBuilt(false),
     _attributes(),
     _buffer(TRI_UNKNOWN_MEM_ZONE) {
 
@@ -104,7 +108,7 @@ Expression::Expression (Ast* ast,
 
 Expression::Expression (Ast* ast,
                         triagens::basics::Json const& json)
-  : Expression(ast, new AstNode(ast, json.get("expression"))) {
+  : Expression(ast, ast->nodeFromPlanJson(json.get("expression"))) {
 
 }
 
@@ -113,6 +117,8 @@ Expression::Expression (Ast* ast,
 ////////////////////////////////////////////////////////////////////////////////
 
 Expression::~Expression () {
+  delete _columnar;
+
   if (_built) {
     switch (_type) {
       case JSON:
@@ -152,6 +158,21 @@ std::unordered_set<Variable*> Expression::variables () const {
   return Ast::getReferencedVariables(_node);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the arena for the values created by the expression
+////////////////////////////////////////////////////////////////////////////////
+
+void Expression::setJsonArena (JsonArena* jsonArena) {
+  TRI_ASSERT(jsonArena != nullptr);
+  _jsonArena = jsonArena;
+
+  if (_built && _type == ATTRIBUTE) {
+    // the accessor may have been created already during optimization
+    TRI_ASSERT(_accessor != nullptr);
+    _accessor->setJsonArena(jsonArena);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief execute the expression
 ////////////////////////////////////////////////////////////////////////////////
@@ -174,7 +195,7 @@ AqlValue Expression::execute (triagens::arango::AqlTransaction* trx,
   switch (_type) {
     case JSON: {
       TRI_ASSERT(_data != nullptr);
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, _data, Json::NOFREE));
+      return _jsonArena->createReference(_data);
     }
 
     case SIMPLE: {
@@ -192,7 +213,7 @@ AqlValue Expression::execute (triagens::arango::AqlTransaction* trx,
         ISOLATE;
         // Dump the expression in question  
         // std::cout << triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, _node->toJson(TRI_UNKNOWN_MEM_ZONE, true)).toString()<< "\n";
-        return _func->execute(isolate, _ast->query(), trx, argv, startPos, vars, regs);
+        return _func->execute(isolate, _ast->query(), _jsonArena, trx, argv, startPos, vars, regs);
       }
       catch (triagens::basics::Exception& ex) {
         if (_ast->query()->verboseErrors()) {
@@ -216,6 +237,35 @@ AqlValue Expression::execute (triagens::arango::AqlTransaction* trx,
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid simple expression");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the expression for all rows of a block at once
+////////////////////////////////////////////////////////////////////////////////
+
+bool Expression::executeColumnar (triagens::arango::AqlTransaction* trx,
+                                  AqlItemBlock const* argv,
+                                  std::vector<Variable*> const& vars,
+                                  std::vector<RegisterId> const& regs,
+                                  std::vector<uint8_t>& result) {
+  if (_type == UNPROCESSED) {
+    analyzeExpression();
+  }
+
+  if (_type != SIMPLE) {
+    return false;
+  }
+
+  if (! _columnarBuilt) {
+    _columnar = ColumnarExpression::create(_node);
+    _columnarBuilt = true;
+  }
+
+  if (_columnar == nullptr) {
+    return false;
+  }
+
+  return _columnar->execute(trx, argv, vars, regs, result);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief replace variables in the expression with other variables
 ////////////////////////////////////////////////////////////////////////////////
@@ -226,6 +276,7 @@ void Expression::replaceVariables (std::unordered_map<VariableId, Variable const
 
   _node = _ast->replaceVariables(const_cast<AstNode*>(_node), replacements);
   invalidate(); 
+  invalidateColumnar();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -241,6 +292,7 @@ void Expression::replaceVariableReference (Variable const* variable,
 
   _node = _ast->replaceVariableReference(const_cast<AstNode*>(_node), variable, node);
   invalidate(); 
+  invalidateColumnar();
 
   if (_type == ATTRIBUTE) {
     if (_built) {
@@ -281,6 +333,17 @@ void Expression::invalidate () {
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the column-wise evaluator, so it is rebuilt for the modified
+/// expression
+////////////////////////////////////////////////////////////////////////////////
+
+void Expression::invalidateColumnar () {
+  delete _columnar;
+  _columnar = nullptr;
+  _columnarBuilt = false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief find a value in an AQL list node
 /// this performs either a binary search (if the node is sorted) or a
@@ -386,7 +449,7 @@ void Expression::analyzeExpression () {
         auto v = static_cast<Variable const*>(member->getData());
 
         // specialize the simple expression into an attribute accessor
-        _accessor = new AttributeAccessor(parts, v);
+        _accessor = new AttributeAccessor(parts, v, _jsonArena);
         _type = ATTRIBUTE;
         _built = true;
       }
@@ -477,7 +540,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
 
     auto j = result.extractObjectMember(trx, myCollection, name, true, _buffer);
     result.destroy();
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+    return _jsonArena->createOwned(j.steal());
   }
   
   else if (node->type == NODE_TYPE_INDEXED_ACCESS) {
@@ -503,7 +566,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
         auto j = result.extractArrayMember(trx, myCollection, indexResult.toInt64(), true);
         indexResult.destroy();
         result.destroy();
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+        return _jsonArena->createOwned(j.steal());
       }
       else if (indexResult.isString()) {
         auto&& value = indexResult.toString();
@@ -514,7 +577,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
           int64_t position = static_cast<int64_t>(std::stoll(value.c_str()));
           auto j = result.extractArrayMember(trx, myCollection, position, true);
           result.destroy();
-          return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+          return _jsonArena->createOwned(j.steal());
         }
         catch (...) {
           // no number found. 
@@ -535,7 +598,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
         auto j = result.extractObjectMember(trx, myCollection, indexString.c_str(), true, _buffer);
         indexResult.destroy();
         result.destroy();
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+        return _jsonArena->createOwned(j.steal());
       }
       else if (indexResult.isString()) {
         auto&& value = indexResult.toString();
@@ -543,7 +606,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
 
         auto j = result.extractObjectMember(trx, myCollection, value.c_str(), true, _buffer);
         result.destroy();
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+        return _jsonArena->createOwned(j.steal());
       }
       else {
         indexResult.destroy();
@@ -553,7 +616,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     }
     result.destroy();
       
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &NullJson, Json::NOFREE));
+    return _jsonArena->createReference(&NullJson);
   }
   
   else if (node->type == NODE_TYPE_ARRAY) {
@@ -565,7 +628,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
       }
 
       // we do not own the JSON but the node does!
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, json, Json::NOFREE));
+      return _jsonArena->createReference(json);
     }
 
     size_t const n = node->numMembers();
@@ -592,7 +655,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
       }
 
       // we do not own the JSON but the node does!
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, json, Json::NOFREE));
+      return _jsonArena->createReference(json);
     }
 
     size_t const n = node->numMembers();
@@ -621,7 +684,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     }
 
     // we do not own the JSON but the node does!
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, json, Json::NOFREE)); 
+    return _jsonArena->createReference(json); 
   }
 
   else if (node->type == NODE_TYPE_REFERENCE) {
@@ -631,7 +694,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
       auto it = _variables.find(v);
       if (it != _variables.end()) {
         *collection = nullptr;
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, (*it).second))); //, Json::NOFREE));
+        return _jsonArena->createCopy((*it).second);
       }
     }
 
@@ -644,13 +707,22 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
         // save the collection info
         *collection = argv->getDocumentCollection(regs[i]); 
 
+        auto const& value = argv->getValueReference(startPos, regs[i]);
+
+        if (value.isJson()) {
+          if (doCopy) {
+            return _jsonArena->createCopy(value._json->json());
+          }
+          return _jsonArena->createReference(value._json->json());
+        }
+
         if (doCopy) {
-          return argv->getValueReference(startPos, regs[i]).clone();
+          return value.clone();
         }
         
         // AqlValue.destroy() will be called for the returned value soon,
         // so we must not return the original AqlValue from the AqlItemBlock here 
-        return argv->getValueReference(startPos, regs[i]).shallowClone();
+        return value.shallowClone();
       }
     }
     // fall-through to exception
@@ -713,7 +785,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     
     bool const operandIsTrue = operand.isTrue();
     operand.destroy();
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, operandIsTrue ? &FalseJson : &TrueJson, Json::NOFREE));
+    return _jsonArena->createReference(operandIsTrue ? &FalseJson : &TrueJson);
   }
   
   else if (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
@@ -770,7 +842,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
         left.destroy();
         right.destroy();
         // do not throw, but return "false" instead
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &FalseJson, Json::NOFREE));
+        return _jsonArena->createReference(&FalseJson);
       }
    
       bool result = findInArray(left, right, leftCollection, rightCollection, trx, node); 
@@ -783,7 +855,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
       left.destroy();
       right.destroy();
     
-      return AqlValue(new triagens::basics::Json(result));
+      return _jsonArena->createReference(result ? &TrueJson : &FalseJson);
     }
 
     // all other comparison operators...
@@ -796,22 +868,22 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     right.destroy();
 
     if (node->type == NODE_TYPE_OPERATOR_BINARY_EQ) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult == 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return _jsonArena->createReference((compareResult == 0) ? &TrueJson : &FalseJson);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_NE) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult != 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return _jsonArena->createReference((compareResult != 0) ? &TrueJson : &FalseJson);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_LT) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult < 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return _jsonArena->createReference((compareResult < 0) ? &TrueJson : &FalseJson);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_LE) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult <= 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return _jsonArena->createReference((compareResult <= 0) ? &TrueJson : &FalseJson);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_GT) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult > 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return _jsonArena->createReference((compareResult > 0) ? &TrueJson : &FalseJson);
     }
     else if (node->type == NODE_TYPE_OPERATOR_BINARY_GE) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (compareResult >= 0) ? &TrueJson : &FalseJson, Json::NOFREE));
+      return _jsonArena->createReference((compareResult >= 0) ? &TrueJson : &FalseJson);
     }
     // fall-through intentional
   }
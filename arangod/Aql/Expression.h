@@ -51,7 +51,9 @@ namespace triagens {
     struct AqlValue;
     class Ast;
     class AttributeAccessor;
+    class ColumnarExpression;
     class Executor;
+    class JsonArena;
     struct V8Expression;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -179,6 +181,20 @@ namespace triagens {
                           std::vector<RegisterId> const&,
                           TRI_document_collection_t const**);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute the expression for all rows of a block at once. this is
+/// only supported for simple conditions, see ColumnarExpression. the result
+/// contains 1 for each row for which the expression is true and 0 otherwise.
+/// returns false if the expression cannot be executed column-wise, in which
+/// case it must be executed for each row using execute()
+////////////////////////////////////////////////////////////////////////////////
+
+        bool executeColumnar (triagens::arango::AqlTransaction*,
+                              AqlItemBlock const*,
+                              std::vector<Variable*> const&,
+                              std::vector<RegisterId> const&,
+                              std::vector<uint8_t>&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief check whether this is a JSON expression
 ////////////////////////////////////////////////////////////////////////////////
@@ -290,6 +306,15 @@ namespace triagens {
 
         void invalidate ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the arena for the values created by the expression. this is
+/// needed when the expression is not executed by the query that owns its AST
+/// (e.g. coordinator query parts), or by multiple threads concurrently, as
+/// arenas are not thread-safe
+////////////////////////////////////////////////////////////////////////////////
+
+        void setJsonArena (JsonArena*);
+
         void setVariable (Variable const* variable, TRI_json_t const* value) {
           _variables.emplace(variable, value);
         }
@@ -303,6 +328,13 @@ namespace triagens {
 
       private:
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the column-wise evaluator, so it is rebuilt for the modified
+/// expression
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidateColumnar ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief find a value in an array
 ////////////////////////////////////////////////////////////////////////////////
@@ -358,6 +390,12 @@ namespace triagens {
 
         Executor*                 _executor;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the query's arena for the values created by the expression
+////////////////////////////////////////////////////////////////////////////////
+
+        JsonArena*                _jsonArena;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the AST node that contains the expression to execute
 ////////////////////////////////////////////////////////////////////////////////
@@ -377,6 +415,13 @@ namespace triagens {
           AttributeAccessor*      _accessor;
         };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief column-wise evaluator for the expression, if the expression is a
+/// simple condition
+////////////////////////////////////////////////////////////////////////////////
+
+        ColumnarExpression*       _columnar;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief type of expression
 ////////////////////////////////////////////////////////////////////////////////
@@ -414,6 +459,12 @@ namespace triagens {
 
         bool                      _built;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the column-wise evaluator has been built
+////////////////////////////////////////////////////////////////////////////////
+
+        bool                      _columnarBuilt;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the top-level attributes used in the expression, grouped 
 /// by variable name
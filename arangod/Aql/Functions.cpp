@@ -301,6 +301,508 @@ static void AppendAsString (triagens::basics::StringBuffer& buffer,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract a function parameter and convert it into a string
+////////////////////////////////////////////////////////////////////////////////
+
+static std::string ExtractStringParameter (triagens::arango::AqlTransaction* trx,
+                                           FunctionParameters const& parameters,
+                                           size_t position) {
+  auto const value = ExtractFunctionParameter(trx, parameters, position, false);
+  TRI_json_t const* json = value.json();
+
+  if (TRI_IsStringJson(json)) {
+    // no conversion required
+    return std::string(json->_value._string.data, json->_value._string.length - 1);
+  }
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  AppendAsString(buffer, json);
+
+  return std::string(buffer.c_str(), buffer.length());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a result value from a number, turning NaN and +/- infinity
+/// into null
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue NumberValue (double value) {
+  if (std::isnan(value) || value == HUGE_VAL || value == -HUGE_VAL) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return AqlValue(new Json(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a result value from a string
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue StringValue (char const* value,
+                             size_t length) {
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, value, length));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the byte offset of the UTF-8 character following the one
+/// at the given offset
+////////////////////////////////////////////////////////////////////////////////
+
+static inline size_t NextCharOffset (char const* p,
+                                     size_t length,
+                                     size_t offset) {
+  ++offset;
+  while (offset < length && 
+         (static_cast<uint8_t>(p[offset]) & 0xC0) == 0x80) {
+    ++offset;
+  }
+  return offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of UTF-16 code units a UTF-8 encoded character
+/// occupies, given its first byte. characters outside the BMP are stored as
+/// surrogate pairs in JavaScript
+////////////////////////////////////////////////////////////////////////////////
+
+static inline size_t CharUnits (uint8_t c) {
+  return ((c & 0xF8) == 0xF0 ? 2 : 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of characters (not bytes) in a UTF-8 string.
+/// characters are counted as UTF-16 code units, as in the JavaScript
+/// implementation of the string functions
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t CharLength (char const* p,
+                          size_t length) {
+  size_t chars = 0;
+
+  for (size_t i = 0; i < length; ++i) {
+    uint8_t const c = static_cast<uint8_t>(p[i]);
+
+    if ((c & 0xC0) != 0x80) {
+      // not a continuation byte
+      chars += CharUnits(c);
+    }
+  }
+
+  return chars;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief decodes the UTF-8 character at the given byte offset and moves the
+/// offset to the following character
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t DecodeChar (char const* p,
+                            size_t length,
+                            size_t& offset) {
+  uint8_t const c = static_cast<uint8_t>(p[offset]);
+  size_t const end = NextCharOffset(p, length, offset);
+  uint32_t cp;
+
+  if (c < 0x80) {
+    cp = c;
+  }
+  else if ((c & 0xE0) == 0xC0) {
+    cp = c & 0x1F;
+  }
+  else if ((c & 0xF0) == 0xE0) {
+    cp = c & 0x0F;
+  }
+  else {
+    cp = c & 0x07;
+  }
+
+  for (size_t i = offset + 1; i < end; ++i) {
+    cp = (cp << 6) | (static_cast<uint8_t>(p[i]) & 0x3F);
+  }
+
+  offset = end;
+  return cp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief decodes a UTF-8 string into a vector of characters
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<uint32_t> DecodeChars (std::string const& value) {
+  std::vector<uint32_t> result;
+  result.reserve(value.size());
+
+  char const* p = value.c_str();
+  size_t const length = value.size();
+  size_t offset = 0;
+
+  while (offset < length) {
+    result.emplace_back(DecodeChar(p, length, offset));
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a character is whitespace, using the same set of
+/// characters as the JavaScript implementation of the string functions
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsWhitespaceChar (uint32_t c) {
+  return (c == 0x20 || (c >= 0x09 && c <= 0x0D) || 
+          c == 0xA0 || c == 0x1680 || c == 0x180E || 
+          (c >= 0x2000 && c <= 0x200A) ||
+          c == 0x2028 || c == 0x2029 || c == 0x202F || 
+          c == 0x205F || c == 0x3000 || c == 0xFEFF);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a character is a line terminator. line terminators
+/// are not matched by the wildcards in LIKE
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsLineTerminatorChar (uint32_t c) {
+  return (c == 0x0A || c == 0x0D || c == 0x2028 || c == 0x2029);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract a substring from a UTF-8 string, with the semantics of
+/// JavaScript's String.prototype.substr. start and length are in UTF-16
+/// code units. if the substring boundaries split a surrogate pair, the
+/// remaining half is returned as U+FFFD, as it cannot be encoded in UTF-8
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue Substring (std::string const& value,
+                           double start,
+                           double length) {
+  char const* p = value.c_str();
+  double const size = static_cast<double>(CharLength(p, value.size()));
+
+  start  = (std::isnan(start) ? 0.0 : std::trunc(start));
+  length = (std::isnan(length) ? 0.0 : std::trunc(length));
+
+  if (start < 0.0) {
+    start = (std::max)(size + start, 0.0);
+  }
+
+  length = (std::min)((std::max)(length, 0.0), size - start);
+
+  if (length <= 0.0) {
+    return StringValue("", 0);
+  }
+
+  size_t const from = static_cast<size_t>(start);
+  size_t const to   = from + static_cast<size_t>(length);
+  size_t const n    = value.size();
+
+  std::string result;
+  size_t units = 0;
+  size_t offset = 0;
+
+  while (offset < n && units < to) {
+    size_t const next = NextCharOffset(p, n, offset);
+    size_t const end  = units + CharUnits(static_cast<uint8_t>(p[offset]));
+
+    if (units >= from && end <= to) {
+      result.append(p + offset, next - offset);
+    }
+    else if (end > from) {
+      // only one half of a surrogate pair is part of the substring
+      result.append("\xEF\xBF\xBD");
+    }
+
+    units = end;
+    offset = next;
+  }
+
+  return StringValue(result.c_str(), result.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief trim characters from the left and/or right of a UTF-8 string.
+/// if chars is a nullptr, whitespace will be trimmed
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue TrimString (std::string const& value,
+                            std::vector<uint32_t> const* chars,
+                            bool left,
+                            bool right) {
+  auto isTrimChar = [&chars] (uint32_t c) -> bool {
+    if (chars == nullptr) {
+      return IsWhitespaceChar(c);
+    }
+    return std::find(chars->begin(), chars->end(), c) != chars->end();
+  };
+
+  char const* p = value.c_str();
+  size_t start = 0;
+  size_t end = value.size();
+
+  if (left) {
+    while (start < end) {
+      size_t next = start;
+      if (! isTrimChar(DecodeChar(p, end, next))) {
+        break;
+      }
+      start = next;
+    }
+  }
+
+  if (right) {
+    while (end > start) {
+      // find start of previous character
+      size_t prev = end - 1;
+      while (prev > start && 
+             (static_cast<uint8_t>(p[prev]) & 0xC0) == 0x80) {
+        --prev;
+      }
+      size_t next = prev;
+      if (! isTrimChar(DecodeChar(p, end, next))) {
+        break;
+      }
+      end = prev;
+    }
+  }
+
+  return StringValue(p + start, end - start);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compile a LIKE pattern into a sequence of characters and wildcards
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t const LikeAnySequence = 0xFFFFFFFF;
+static uint32_t const LikeAnyChar     = 0xFFFFFFFE;
+
+static std::vector<uint32_t> CompileLikePattern (std::string const& pattern) {
+  std::vector<uint32_t> result;
+  result.reserve(pattern.size());
+
+  char const* p = pattern.c_str();
+  size_t const length = pattern.size();
+  size_t offset = 0;
+  bool escaped = false;
+
+  while (offset < length) {
+    uint32_t c = DecodeChar(p, length, offset);
+
+    if (c == '\\') {
+      if (escaped) {
+        // literal backslash
+        result.emplace_back(c);
+      }
+      escaped = ! escaped;
+      continue;
+    }
+
+    if (c == '%' || c == '_') {
+      if (escaped) {
+        // literal % or _
+        result.emplace_back(c);
+      }
+      else {
+        result.emplace_back(c == '%' ? LikeAnySequence : LikeAnyChar);
+      }
+    }
+    else if (escaped && 
+             (c == 0 || c >= 0x80 || strchr(".*+?^=!:${}()|[]/", static_cast<int>(c)) == nullptr)) {
+      // a backslash followed by a character without special meaning
+      // is taken literally
+      result.emplace_back('\\');
+      result.emplace_back(c);
+    }
+    else {
+      result.emplace_back(c);
+    }
+
+    escaped = false;
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief match a string against a compiled LIKE pattern. this simulates the
+/// pattern as an NFA so runtime is bounded by O(string length * pattern length)
+////////////////////////////////////////////////////////////////////////////////
+
+static bool MatchLikePattern (std::vector<uint32_t> const& value,
+                              std::vector<uint32_t> const& pattern) {
+  size_t const m = pattern.size();
+
+  std::vector<char> current(m + 1, 0);
+  std::vector<char> next(m + 1, 0);
+
+  auto closure = [&pattern, &m] (std::vector<char>& states) -> bool {
+    bool any = false;
+    for (size_t i = 0; i <= m; ++i) {
+      if (states[i]) {
+        any = true;
+        if (i < m && pattern[i] == LikeAnySequence) {
+          // a wildcard sequence may also match nothing
+          states[i + 1] = 1;
+        }
+      }
+    }
+    return any;
+  };
+
+  current[0] = 1;
+  closure(current);
+
+  for (auto const c : value) {
+    std::fill(next.begin(), next.end(), 0);
+
+    for (size_t i = 0; i < m; ++i) {
+      if (! current[i]) {
+        continue;
+      }
+
+      uint32_t const token = pattern[i];
+
+      if (token == LikeAnySequence) {
+        if (! IsLineTerminatorChar(c)) {
+          next[i] = 1;
+        }
+      }
+      else if (token == LikeAnyChar) {
+        if (! IsLineTerminatorChar(c)) {
+          next[i + 1] = 1;
+        }
+      }
+      else if (token == c) {
+        next[i + 1] = 1;
+      }
+    }
+
+    if (! closure(next)) {
+      // no more active states
+      return false;
+    }
+
+    current.swap(next);
+  }
+
+  return (current[m] != 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the numeric members of an array, ignoring nulls. returns
+/// false and registers a warning if the array contains non-numeric members
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ExtractNumbers (triagens::aql::Query* query,
+                            char const* functionName,
+                            TRI_json_t const* json,
+                            std::vector<double>& numbers) {
+  size_t const n = TRI_LengthArrayJson(json);
+  numbers.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (TRI_IsNullJson(value)) {
+      continue;
+    }
+
+    if (! TRI_IsNumberJson(value)) {
+      RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+      return false;
+    }
+
+    numbers.emplace_back(value->_value._number);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes the sum of squared differences from the mean of the
+/// array members, using Welford's algorithm. returns false if the input 
+/// was invalid
+////////////////////////////////////////////////////////////////////////////////
+
+static bool Variance (triagens::aql::Query* query,
+                      triagens::arango::AqlTransaction* trx,
+                      FunctionParameters const& parameters,
+                      char const* functionName,
+                      double& value,
+                      size_t& count) {
+  auto const list = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! list.isArray()) {
+    RegisterWarning(query, functionName, TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return false;
+  }
+
+  std::vector<double> numbers;
+
+  if (! ExtractNumbers(query, functionName, list.json(), numbers)) {
+    return false;
+  }
+
+  double mean = 0.0;
+  value = 0.0;
+  count = 0;
+
+  for (auto const& it : numbers) {
+    double const delta = it - mean;
+    mean += delta / static_cast<double>(++count);
+    value += delta * (it - mean);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief recursively flatten an array into the result array
+////////////////////////////////////////////////////////////////////////////////
+
+static void FlattenArray (TRI_json_t* result,
+                          TRI_json_t const* json,
+                          double maxDepth,
+                          double depth) {
+  size_t const n = TRI_LengthArrayJson(json);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (depth < maxDepth && TRI_IsArrayJson(value)) {
+      FlattenArray(result, value, maxDepth, depth + 1.0);
+      continue;
+    }
+
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result, copy);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return a copy of a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue CopyValue (TRI_json_t const* json) {
+  if (json == nullptr) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  std::unique_ptr<TRI_json_t> copy(TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json));
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, copy.get());
+  copy.release();
+  return AqlValue(jr);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                             AQL function bindings
 // -----------------------------------------------------------------------------
@@ -1489,6 +1991,880 @@ AqlValue Functions::Intersection (triagens::aql::Query* query,
   return AqlValue(jr);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONCAT_SEPARATOR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ConcatSeparator (triagens::aql::Query*,
+                                     triagens::arango::AqlTransaction* trx,
+                                     FunctionParameters const& parameters) {
+  std::string const separator = ExtractStringParameter(trx, parameters, 0);
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+
+  size_t const n = parameters.size();
+  bool found = false;
+
+  for (size_t i = 1; i < n; ++i) {
+    auto const member = ExtractFunctionParameter(trx, parameters, i, false);
+
+    if (member.isEmpty() || member.isNull()) {
+      continue;
+    }
+
+    if (found) {
+      buffer.appendText(separator);
+    }
+      
+    TRI_json_t const* json = member.json();
+    
+    if (member.isArray()) {
+      // append each member individually
+      size_t const subLength = TRI_LengthArrayJson(json);
+      found = false;
+
+      for (size_t j = 0; j < subLength; ++j) {
+        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
+
+        if (sub == nullptr || sub->_type == TRI_JSON_NULL) {
+          continue;
+        }
+
+        if (found) {
+          buffer.appendText(separator);
+        }
+
+        AppendAsString(buffer, sub);
+        found = true;
+      }
+    }
+    else {
+      // convert member to a string and append
+      AppendAsString(buffer, json);
+      found = true;
+    }
+  }
+  
+  size_t length = buffer.length();
+  std::unique_ptr<TRI_json_t> j(TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length));
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CHAR_LENGTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::CharLength (triagens::aql::Query*,
+                                triagens::arango::AqlTransaction* trx,
+                                FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+
+  return AqlValue(new Json(static_cast<double>(::CharLength(value.c_str(), value.size()))));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LOWER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Lower (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+
+  return AqlValue(new Json(triagens::basics::Utf8Helper::DefaultUtf8Helper.toLowerCase(value)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UPPER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Upper (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+
+  return AqlValue(new Json(triagens::basics::Utf8Helper::DefaultUtf8Helper.toUpperCase(value)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SUBSTRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Substring (triagens::aql::Query*,
+                               triagens::arango::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+
+  auto const offsetJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  bool isValid;
+  double offset = ValueToNumber(offsetJson.json(), isValid);
+
+  if (! isValid) {
+    offset = 0.0;
+  }
+
+  double length = HUGE_VAL;
+
+  if (parameters.size() > 2) {
+    auto const lengthJson = ExtractFunctionParameter(trx, parameters, 2, false);
+    length = ValueToNumber(lengthJson.json(), isValid);
+
+    if (! isValid) {
+      length = 0.0;
+    }
+  }
+
+  return ::Substring(value, offset, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONTAINS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Contains (triagens::aql::Query*,
+                              triagens::arango::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
+  std::string const value  = ExtractStringParameter(trx, parameters, 0);
+  std::string const search = ExtractStringParameter(trx, parameters, 1);
+  bool const returnIndex   = GetBooleanParameter(trx, parameters, 2, false);
+
+  double result = -1.0;
+
+  if (! search.empty()) {
+    size_t const pos = value.find(search);
+
+    if (pos != std::string::npos) {
+      // return the position in characters, not bytes
+      result = static_cast<double>(::CharLength(value.c_str(), pos));
+    }
+  }
+
+  if (returnIndex) {
+    return AqlValue(new Json(result));
+  }
+
+  return AqlValue(new Json(result != -1.0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LIKE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Like (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  std::string value   = ExtractStringParameter(trx, parameters, 0);
+  std::string pattern = ExtractStringParameter(trx, parameters, 1);
+  bool const caseInsensitive = GetBooleanParameter(trx, parameters, 2, false);
+
+  if (caseInsensitive) {
+    value   = triagens::basics::Utf8Helper::DefaultUtf8Helper.toLowerCase(value);
+    pattern = triagens::basics::Utf8Helper::DefaultUtf8Helper.toLowerCase(pattern);
+  }
+
+  bool const result = MatchLikePattern(DecodeChars(value), CompileLikePattern(pattern));
+  
+  return AqlValue(new Json(result));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LEFT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Left (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+
+  auto const lengthJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  bool isValid;
+  double length = ValueToNumber(lengthJson.json(), isValid);
+
+  if (! isValid) {
+    length = 0.0;
+  }
+
+  return ::Substring(value, 0.0, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RIGHT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Right (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+
+  auto const lengthJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  bool isValid;
+  double length = ValueToNumber(lengthJson.json(), isValid);
+
+  if (! isValid) {
+    length = 0.0;
+  }
+
+  double left = static_cast<double>(::CharLength(value.c_str(), value.size())) - std::trunc(length);
+
+  if (left < 0.0) {
+    left = 0.0;
+  }
+
+  return ::Substring(value, left, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TRIM
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Trim (triagens::aql::Query*,
+                          triagens::arango::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+  auto const chars = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (chars.isNull()) {
+    return TrimString(value, nullptr, true, true);
+  }
+
+  if (chars.isNumber()) {
+    double const type = chars.json()->_value._number;
+
+    if (type == 0.0) {
+      return TrimString(value, nullptr, true, true);
+    }
+    if (type == 1.0) {
+      return TrimString(value, nullptr, true, false);
+    }
+    if (type == 2.0) {
+      return TrimString(value, nullptr, false, true);
+    }
+  }
+
+  auto const trimChars = DecodeChars(ExtractStringParameter(trx, parameters, 1));
+  return TrimString(value, &trimChars, true, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LTRIM
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::LTrim (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+  auto const chars = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (chars.isNull()) {
+    return TrimString(value, nullptr, true, false);
+  }
+
+  auto const trimChars = DecodeChars(ExtractStringParameter(trx, parameters, 1));
+  return TrimString(value, &trimChars, true, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RTRIM
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::RTrim (triagens::aql::Query*,
+                           triagens::arango::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+  auto const chars = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (chars.isNull()) {
+    return TrimString(value, nullptr, false, true);
+  }
+
+  auto const trimChars = DecodeChars(ExtractStringParameter(trx, parameters, 1));
+  return TrimString(value, &trimChars, false, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SPLIT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Split (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+  std::string const value = ExtractStringParameter(trx, parameters, 0);
+  auto const separator = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (separator.isNull()) {
+    // no separator given. return the value as a single-element array
+    Json result(Json::Array, 1);
+    result.add(Json(value));
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+
+  size_t limit = SIZE_MAX;
+  auto const limitJson = ExtractFunctionParameter(trx, parameters, 2, false);
+
+  if (! limitJson.isNull()) {
+    bool isValid;
+    double const l = ValueToNumber(limitJson.json(), isValid);
+
+    if (isValid && l < 0.0) {
+      RegisterInvalidArgumentWarning(query, "SPLIT");
+      return AqlValue(new Json(Json::Null));
+    }
+
+    limit = (isValid && l >= 1.0) ? static_cast<size_t>((std::min)(l, 4294967295.0)) : 0;
+  }
+
+  // list of alternative separators. the first one that matches wins
+  std::vector<std::string> separators;
+
+  if (separator.isArray()) {
+    TRI_json_t const* json = separator.json();
+    size_t const n = TRI_LengthArrayJson(json);
+    separators.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+      AppendAsString(buffer, static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i)));
+      separators.emplace_back(std::string(buffer.c_str(), buffer.length()));
+    }
+  }
+  else {
+    separators.emplace_back(ExtractStringParameter(trx, parameters, 1));
+  }
+
+  char const* p = value.c_str();
+  size_t const length = value.size();
+
+  // returns the byte length of the separator matching at the position, or 
+  // SIZE_MAX if none matches
+  auto matchSeparator = [&] (size_t position) -> size_t {
+    for (auto const& it : separators) {
+      if (it.size() <= length - position &&
+          memcmp(p + position, it.c_str(), it.size()) == 0) {
+        return it.size();
+      }
+    }
+    return SIZE_MAX;
+  };
+
+  Json result(Json::Array);
+
+  if (limit == 0) {
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+
+  if (length == 0) {
+    if (matchSeparator(0) == SIZE_MAX) {
+      result.add(Json(value));
+    }
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+
+  size_t start = 0;
+  size_t position = 0;
+
+  while (position < length) {
+    size_t const matchLength = matchSeparator(position);
+
+    if (matchLength == SIZE_MAX || 
+        position + matchLength == start) {
+      // no match, or an empty match at the start of the current part
+      position = NextCharOffset(p, length, position);
+      continue;
+    }
+
+    result.add(Json(TRI_UNKNOWN_MEM_ZONE, p + start, position - start));
+
+    if (result.size() == limit) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+    }
+
+    start = position + matchLength;
+    position = start;
+  }
+
+  result.add(Json(TRI_UNKNOWN_MEM_ZONE, p + start, length - start));
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FLATTEN
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Flatten (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! value.isArray()) {
+    RegisterWarning(query, "FLATTEN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  double maxDepth = 1.0;
+
+  if (parameters.size() > 1) {
+    auto const depthJson = ExtractFunctionParameter(trx, parameters, 1, false);
+    bool isValid;
+    maxDepth = ValueToNumber(depthJson.json(), isValid);
+
+    if (! isValid || maxDepth < 1.0) {
+      maxDepth = 1.0;
+    }
+  }
+
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, value.size()));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  FlattenArray(result.get(), value.json(), maxDepth, 0.0);
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MEDIAN
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Median (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! value.isArray()) {
+    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  std::vector<double> numbers;
+
+  if (! ExtractNumbers(query, "MEDIAN", value.json(), numbers) ||
+      numbers.empty()) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  size_t const midpoint = numbers.size() / 2;
+  std::nth_element(numbers.begin(), numbers.begin() + midpoint, numbers.end());
+
+  if (numbers.size() % 2 == 0) {
+    // the lower middle element is the largest one of the lower half
+    double const lower = *std::max_element(numbers.begin(), numbers.begin() + midpoint);
+    return NumberValue((lower + numbers[midpoint]) / 2.0);
+  }
+
+  return NumberValue(numbers[midpoint]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function PERCENTILE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Percentile (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                FunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! value.isArray()) {
+    RegisterWarning(query, "PERCENTILE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  auto const percentile = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (! percentile.isNumber()) {
+    RegisterInvalidArgumentWarning(query, "PERCENTILE");
+    return AqlValue(new Json(Json::Null));
+  }
+
+  double const p = percentile.json()->_value._number;
+
+  if (! (p > 0.0 && p <= 100.0)) {
+    RegisterInvalidArgumentWarning(query, "PERCENTILE");
+    return AqlValue(new Json(Json::Null));
+  }
+
+  bool useInterpolation = false;
+  auto const method = ExtractFunctionParameter(trx, parameters, 2, false);
+
+  if (! method.isNull()) {
+    TRI_json_t const* json = method.json();
+
+    if (TRI_IsStringJson(json) && 
+        strcmp(json->_value._string.data, "interpolation") == 0) {
+      useInterpolation = true;
+    }
+    else if (! TRI_IsStringJson(json) || 
+             strcmp(json->_value._string.data, "rank") != 0) {
+      RegisterInvalidArgumentWarning(query, "PERCENTILE");
+      return AqlValue(new Json(Json::Null));
+    }
+  }
+
+  std::vector<double> numbers;
+
+  if (! ExtractNumbers(query, "PERCENTILE", value.json(), numbers) ||
+      numbers.empty()) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  if (numbers.size() == 1) {
+    return NumberValue(numbers[0]);
+  }
+
+  std::sort(numbers.begin(), numbers.end());
+
+  double const n = static_cast<double>(numbers.size());
+
+  if (useInterpolation) {
+    double const idx = p * (n + 1.0) / 100.0;
+    double const pos = std::floor(idx);
+
+    if (pos >= n) {
+      return NumberValue(numbers.back());
+    }
+    if (pos < 1.0) {
+      // there is no element before the first one to interpolate with
+      return AqlValue(new Json(Json::Null));
+    }
+
+    size_t const i = static_cast<size_t>(pos);
+    double const delta = idx - pos;
+    return NumberValue(delta * (numbers[i] - numbers[i - 1]) + numbers[i - 1]);
+  }
+
+  // rank method
+  double const pos = std::ceil(p * n / 100.0);
+
+  if (pos >= n) {
+    return NumberValue(numbers.back());
+  }
+
+  return NumberValue(numbers[static_cast<size_t>(pos) - 1]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function VARIANCE_SAMPLE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::VarianceSample (triagens::aql::Query* query,
+                                    triagens::arango::AqlTransaction* trx,
+                                    FunctionParameters const& parameters) {
+  double value;
+  size_t count;
+
+  if (! Variance(query, trx, parameters, "VARIANCE_SAMPLE", value, count) ||
+      count < 2) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return NumberValue(value / static_cast<double>(count - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function VARIANCE_POPULATION
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::VariancePopulation (triagens::aql::Query* query,
+                                        triagens::arango::AqlTransaction* trx,
+                                        FunctionParameters const& parameters) {
+  double value;
+  size_t count;
+
+  if (! Variance(query, trx, parameters, "VARIANCE_POPULATION", value, count) ||
+      count < 1) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return NumberValue(value / static_cast<double>(count));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function STDDEV_SAMPLE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::StdDevSample (triagens::aql::Query* query,
+                                  triagens::arango::AqlTransaction* trx,
+                                  FunctionParameters const& parameters) {
+  double value;
+  size_t count;
+
+  if (! Variance(query, trx, parameters, "STDDEV_SAMPLE", value, count) ||
+      count < 2) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return NumberValue(std::sqrt(value / static_cast<double>(count - 1)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function STDDEV_POPULATION
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::StdDevPopulation (triagens::aql::Query* query,
+                                      triagens::arango::AqlTransaction* trx,
+                                      FunctionParameters const& parameters) {
+  double value;
+  size_t count;
+
+  if (! Variance(query, trx, parameters, "STDDEV_POPULATION", value, count) ||
+      count < 1) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return NumberValue(std::sqrt(value / static_cast<double>(count)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SLICE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Slice (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! value.isArray()) {
+    RegisterInvalidArgumentWarning(query, "SLICE");
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  double const length = static_cast<double>(TRI_LengthArrayJson(valueJson));
+
+  auto const fromJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  bool isValid;
+  double from = ValueToNumber(fromJson.json(), isValid);
+
+  if (! isValid) {
+    from = 0.0;
+  }
+
+  double to = length;
+
+  if (parameters.size() > 2) {
+    auto const toJson = ExtractFunctionParameter(trx, parameters, 2, false);
+    double const count = ValueToNumber(toJson.json(), isValid);
+
+    if (isValid) {
+      // a non-negative third parameter is the number of elements to return,
+      // a negative one is a position counted from the end of the array
+      to = (count >= 0.0 ? count + from : count);
+    }
+  }
+
+  // normalize start and end positions
+  auto normalize = [&length] (double position) -> size_t {
+    position = std::trunc(position);
+    if (position < 0.0) {
+      position = (std::max)(length + position, 0.0);
+    }
+    return static_cast<size_t>((std::min)(position, length));
+  };
+
+  size_t const start = normalize(from);
+  size_t const end   = normalize(to);
+
+  std::unique_ptr<TRI_json_t> result(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, end > start ? end - start : 0));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (size_t i = start; i < end; ++i) {
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, TRI_LookupArrayJson(valueJson, i));
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIRST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::First (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! value.isArray()) {
+    RegisterWarning(query, "FIRST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* valueJson = value.json();
+
+  if (TRI_LengthArrayJson(valueJson) == 0) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return CopyValue(TRI_LookupArrayJson(valueJson, 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LAST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Last (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! value.isArray()) {
+    RegisterWarning(query, "LAST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+
+  if (n == 0) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return CopyValue(TRI_LookupArrayJson(valueJson, n - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Nth (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (! value.isArray()) {
+    RegisterWarning(query, "NTH", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  auto const positionJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  bool isValid;
+  double const position = ValueToNumber(positionJson.json(), isValid);
+
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+
+  if (! isValid || 
+      position < 0.0 || 
+      position >= static_cast<double>(n) ||
+      position != std::trunc(position)) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return CopyValue(TRI_LookupArrayJson(valueJson, static_cast<size_t>(position)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ZIP
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Zip (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
+  auto const keys   = ExtractFunctionParameter(trx, parameters, 0, false);
+  auto const values = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (! keys.isArray() || 
+      ! values.isArray() ||
+      keys.size() != values.size()) {
+    RegisterInvalidArgumentWarning(query, "ZIP");
+    return AqlValue(new Json(Json::Null));
+  }
+
+  TRI_json_t const* keysJson   = keys.json();
+  TRI_json_t const* valuesJson = values.json();
+  size_t const n = TRI_LengthArrayJson(keysJson);
+
+  // later keys overwrite earlier ones with the same name
+  std::unordered_map<std::string, size_t> positions;
+  std::vector<std::string> names;
+  names.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+    AppendAsString(buffer, TRI_LookupArrayJson(keysJson, i));
+
+    std::string name(buffer.c_str(), buffer.length());
+    auto it = positions.find(name);
+
+    if (it == positions.end()) {
+      positions.emplace(name, i);
+      names.emplace_back(name);
+    }
+    else {
+      (*it).second = i;
+    }
+  }
+
+  std::unique_ptr<TRI_json_t> result(TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, names.size()));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (auto const& name : names) {
+    auto copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, TRI_LookupArrayJson(valuesJson, positions[name]));
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, result.get(), name.c_str(), copy);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TRANSLATE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Translate (triagens::aql::Query* query,
+                               triagens::arango::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
+  auto const lookup = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (! lookup.isObject()) {
+    RegisterInvalidArgumentWarning(query, "TRANSLATE");
+    return AqlValue(new Json(Json::Null));
+  }
+
+  std::string const key = ExtractStringParameter(trx, parameters, 0);
+  TRI_json_t const* found = TRI_LookupObjectJson(lookup.json(), key.c_str());
+
+  if (found != nullptr) {
+    return CopyValue(found);
+  }
+
+  if (parameters.size() > 2) {
+    // return the default value
+    auto defaultValue = ExtractFunctionParameter(trx, parameters, 2, true);
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, defaultValue.steal()));
+  }
+
+  // return the original value
+  auto original = ExtractFunctionParameter(trx, parameters, 0, true);
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, original.steal()));
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, arena for the JSON values created while executing a query
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/JsonArena.h"
+#include "Basics/Exceptions.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an arena
+////////////////////////////////////////////////////////////////////////////////
+
+JsonArena::JsonArena (size_t slotsPerBlock)
+  : _blocks(),
+    _slotsPerBlock(slotsPerBlock),
+    _current(nullptr),
+    _end(nullptr),
+    _freeList(nullptr) {
+
+  TRI_ASSERT(slotsPerBlock > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy an arena, freeing all slots at once
+////////////////////////////////////////////////////////////////////////////////
+
+JsonArena::~JsonArena () {
+  for (auto& it : _blocks) {
+    delete[] it;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a value that refers to a JSON value owned by someone else
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createReference (TRI_json_t const* json) {
+  return createValue(allocateSlot(), const_cast<TRI_json_t*>(json), Json::NOFREE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a value that takes over ownership of a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createOwned (TRI_json_t* json) {
+  Slot* slot;
+
+  try {
+    slot = allocateSlot();
+  }
+  catch (...) {
+    if (json != nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+    }
+    throw;
+  }
+
+  return createValue(slot, json, Json::AUTOFREE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a value that holds a copy of a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createCopy (TRI_json_t const* json) {
+  Slot* slot = allocateSlot();
+
+  int res = TRI_CopyToJson(TRI_UNKNOWN_MEM_ZONE, &slot->node, json);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    freeSlot(slot);
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  return createNodeValue(slot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a null value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createNull () {
+  Slot* slot = allocateSlot();
+  TRI_InitNullJson(&slot->node);
+
+  return createNodeValue(slot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a boolean value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createBoolean (bool value) {
+  Slot* slot = allocateSlot();
+  TRI_InitBooleanJson(&slot->node, value);
+
+  return createNodeValue(slot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a number value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createNumber (double value) {
+  Slot* slot = allocateSlot();
+  TRI_InitNumberJson(&slot->node, value);
+
+  return createNodeValue(slot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a string value, copying the string
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createString (char const* value,
+                                  size_t length) {
+  Slot* slot = allocateSlot();
+
+  int res = TRI_InitStringCopyJson(TRI_UNKNOWN_MEM_ZONE, &slot->node, value, length);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    freeSlot(slot);
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  return createNodeValue(slot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a Json handle created by an arena and return its slot
+////////////////////////////////////////////////////////////////////////////////
+
+void JsonArena::release (Json* json) {
+  auto slot = reinterpret_cast<Slot*>(reinterpret_cast<char*>(json) - offsetof(Slot, handle));
+
+  json->~Json();
+
+  if (slot->hasNode) {
+    TRI_DestroyJson(TRI_UNKNOWN_MEM_ZONE, &slot->node);
+  }
+
+  slot->arena->freeSlot(slot);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a slot from the free list or from the current block
+////////////////////////////////////////////////////////////////////////////////
+
+JsonArena::Slot* JsonArena::allocateSlot () {
+  Slot* slot = _freeList;
+
+  if (slot != nullptr) {
+    _freeList = slot->next;
+  }
+  else {
+    if (_current == _end) {
+      allocateBlock();
+    }
+
+    slot = _current++;
+    slot->arena = this;
+  }
+
+  slot->next    = nullptr;
+  slot->hasNode = false;
+
+  return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief put a slot onto the free list
+////////////////////////////////////////////////////////////////////////////////
+
+void JsonArena::freeSlot (Slot* slot) {
+  TRI_ASSERT(slot->arena == this);
+
+  slot->next = _freeList;
+  _freeList  = slot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief construct the Json handle in a slot and create the value
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createValue (Slot* slot,
+                                 TRI_json_t* json,
+                                 Json::autofree_e autofree) {
+  auto handle = new (&slot->handle) Json(TRI_UNKNOWN_MEM_ZONE, json, autofree);
+
+  AqlValue value(handle);
+  value._fromArena = true;
+
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a value for the embedded node of a slot
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue JsonArena::createNodeValue (Slot* slot) {
+  slot->hasNode = true;
+
+  return createValue(slot, &slot->node, Json::NOFREE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief allocate a new block of slots
+////////////////////////////////////////////////////////////////////////////////
+
+void JsonArena::allocateBlock () {
+  Slot* block = new Slot[_slotsPerBlock];
+
+  try {
+    _blocks.emplace_back(block);
+    _current = block;
+    _end     = _current + _slotsPerBlock;
+  }
+  catch (...) {
+    delete[] block;
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, arena for the JSON values created while executing a query
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_JSON_ARENA_H
+#define ARANGODB_AQL_JSON_ARENA_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Basics/JsonHelper.h"
+#include "Basics/json.h"
+
+namespace triagens {
+  namespace aql {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   class JsonArena
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief arena for the JSON values created while executing a query
+///
+/// Every JSON AqlValue needs a heap-allocated Json handle, and scalar results
+/// additionally need a TRI_json_t node. Allocating both per row and freeing
+/// them again when the register is cleared is expensive in calculation-heavy
+/// queries. The arena hands out fixed-size slots that contain the handle and
+/// an embedded TRI_json_t node. Slots of destroyed values go to a free list
+/// and are reused by the next value, and the memory of all slots is given
+/// back at once when the query is destroyed.
+///
+/// Values created by the arena must not outlive the query. Only the embedded
+/// node of a slot is recycled: nested arrays, objects and strings are still
+/// allocated from TRI_UNKNOWN_MEM_ZONE and freed when the value is destroyed.
+/// The arena is not thread-safe, which is fine because a query is only ever
+/// executed by one thread at a time.
+////////////////////////////////////////////////////////////////////////////////
+
+    class JsonArena {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a slot, holding the Json handle of one AqlValue
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Slot {
+          JsonArena*  arena;
+          Slot*       next;
+          bool        hasNode;
+          TRI_json_t  node;
+          std::aligned_storage<sizeof(triagens::basics::Json), 
+                               alignof(triagens::basics::Json)>::type handle;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        JsonArena (JsonArena const&) = delete;
+        JsonArena& operator= (JsonArena const&) = delete;
+
+        explicit JsonArena (size_t);
+
+        ~JsonArena ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a value that refers to a JSON value owned by someone else
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createReference (TRI_json_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a value that takes over ownership of a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createOwned (TRI_json_t*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a value that holds a copy of a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createCopy (TRI_json_t const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a null value
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createNull ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a boolean value
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createBoolean (bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a number value
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createNumber (double);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a string value, copying the string
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createString (char const*, 
+                               size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a Json handle created by an arena and return its slot
+////////////////////////////////////////////////////////////////////////////////
+
+        static void release (triagens::basics::Json*);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a slot from the free list or from the current block
+////////////////////////////////////////////////////////////////////////////////
+
+        Slot* allocateSlot ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief put a slot onto the free list
+////////////////////////////////////////////////////////////////////////////////
+
+        void freeSlot (Slot*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief construct the Json handle in a slot and create the value
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createValue (Slot*,
+                              TRI_json_t*,
+                              triagens::basics::Json::autofree_e);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a value for the embedded node of a slot
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlValue createNodeValue (Slot*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief allocate a new block of slots
+////////////////////////////////////////////////////////////////////////////////
+
+        void allocateBlock ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief already allocated blocks of slots
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Slot*> _blocks;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of slots in each block
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t const _slotsPerBlock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief next unused slot in the current block
+////////////////////////////////////////////////////////////////////////////////
+
+        Slot* _current;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief end of current block
+////////////////////////////////////////////////////////////////////////////////
+
+        Slot* _end;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief slots of destroyed values, ready for reuse
+////////////////////////////////////////////////////////////////////////////////
+
+        Slot* _freeList;
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
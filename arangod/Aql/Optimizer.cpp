@@ -403,6 +403,12 @@ void Optimizer::setupRules () {
 #endif
        
    
+  // compute aggregates of COLLECT ... INTO groups incrementally
+  registerRule("use-collect-aggregates",
+               useCollectAggregatesRule,
+               useCollectAggregatesRule_pass1,
+               true);
+
   // determine the "right" type of AggregateNode and 
   // add a sort node for each COLLECT (may be removed later) 
   // this rule cannot be turned off (otherwise, the query result might be wrong!)
@@ -574,6 +580,18 @@ void Optimizer::setupRules () {
                useIndexForSortRule_pass6,
                true);
 
+  // use a hash join for equi-joins that cannot use an index
+  registerRule("use-hash-join",
+               useHashJoinRule,
+               useHashJoinRule_pass6,
+               true);
+
+  // check filters on the path of a traversal during the traversal
+  registerRule("move-filters-into-traversal",
+               moveFiltersIntoTraversalRule,
+               moveFiltersIntoTraversalRule_pass6,
+               true);
+
   // finally, push calculations as far down as possible
   registerRule("move-calculations-down",
                moveCalculationsDownRule,
@@ -588,6 +606,12 @@ void Optimizer::setupRules () {
                true);
 #endif
 
+  // turn SORT + LIMIT into a top-k sort
+  registerRule("sort-limit",
+               applySortLimitRule,
+               applySortLimitRule_pass9,
+               true);
+
   if (triagens::arango::ServerState::instance()->isCoordinator()) {
     // distribute operations in cluster
     registerRule("scatter-in-cluster",
@@ -621,6 +645,16 @@ void Optimizer::setupRules () {
                  undistributeRemoveAfterEnumCollRule_pass10,
                  true);
 
+    registerRule("use-covering-index",
+                 useCoveringIndexRule,
+                 useCoveringIndexRule_pass10,
+                 true);
+
+    registerRule("reduce-extraction-to-projection",
+                 reduceExtractionToProjectionRule,
+                 reduceExtractionToProjectionRule_pass10,
+                 true);
+
   }
 }
 
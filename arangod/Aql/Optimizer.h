@@ -84,6 +84,10 @@ namespace triagens {
 
         pass1                                         = 100,
        
+        // compute aggregates of COLLECT ... INTO groups incrementally, so
+        // the groups need not be built
+        useCollectAggregatesRule_pass1                = 102,
+
         // determine the "right" type of AggregateNode and 
         // add a sort node for each COLLECT (may be removed later) 
         specializeCollectRule_pass1                   = 105,
@@ -192,6 +196,12 @@ namespace triagens {
         // try to find sort blocks which are superseeded by indexes
         useIndexForSortRule_pass6                     = 850,
 
+        // use a hash join for equi-joins that cannot use an index
+        useHashJoinRule_pass6                         = 860,
+
+        // check filters on the path of a traversal during the traversal
+        moveFiltersIntoTraversalRule_pass6            = 870,
+
 //////////////////////////////////////////////////////////////////////////////
 /// Pass 9: push down calculations beyond FILTERs and LIMITs
 //////////////////////////////////////////////////////////////////////////////
@@ -204,6 +214,12 @@ namespace triagens {
 
         fuseCalculationsRule_pass9                    = 901,
 
+//////////////////////////////////////////////////////////////////////////////
+/// Pass 9: let SORT produce only the rows required by a following LIMIT
+//////////////////////////////////////////////////////////////////////////////
+
+        applySortLimitRule_pass9                      = 910,
+
 //////////////////////////////////////////////////////////////////////////////
 /// "Pass 10": final transformations for the cluster
 //////////////////////////////////////////////////////////////////////////////
@@ -228,7 +244,15 @@ namespace triagens {
         removeUnnecessaryRemoteScatterRule_pass10     = 1040,
 
         //recognise that a RemoveNode can be moved to the shards
-        undistributeRemoveAfterEnumCollRule_pass10    = 1050
+        undistributeRemoveAfterEnumCollRule_pass10    = 1050,
+
+        // let index range scans read the attributes that are sent to the
+        // coordinator from the index elements instead of the documents
+        useCoveringIndexRule_pass10                   = 1055,
+
+        // let collection scans only produce the attributes that are used
+        // after the documents have been sent to the coordinator
+        reduceExtractionToProjectionRule_pass10       = 1060
       };
     
       public:
@@ -27,6 +27,7 @@
 
 #include "Aql/OptimizerRules.h"
 #include "Aql/AggregationOptions.h"
+#include "Aql/Aggregator.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/Function.h"
@@ -145,7 +146,9 @@ int triagens::aql::removeRedundantSortsRule (Optimizer* opt,
           }
         }
         else if (current->getType() == EN::ENUMERATE_LIST ||
-                 current->getType() == EN::ENUMERATE_COLLECTION) {
+                 current->getType() == EN::ENUMERATE_COLLECTION ||
+                 current->getType() == EN::HASH_JOIN ||
+                 current->getType() == EN::TRAVERSAL) {
           // ok, but we cannot remove two different sorts if one of these node types is between them
           // example: in the following query, the one sort will be optimized away:
           //   FOR i IN [ { a: 1 }, { a: 2 } , { a: 3 } ] SORT i.a ASC SORT i.a DESC RETURN i
@@ -510,6 +513,468 @@ int triagens::aql::removeCollectIntoRule (Optimizer* opt,
   return TRI_ERROR_NO_ERROR;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                     helper functions for useCollectAggregatesRule
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the iterator variable if the node is a plain expansion of
+/// the group variable of a COLLECT, i.e. `g[*]...` without FILTER, LIMIT or
+/// RETURN. returns a nullptr otherwise
+////////////////////////////////////////////////////////////////////////////////
+
+static Variable const* GroupExpansionIterator (AstNode const* node,
+                                               Variable const* groupVariable) {
+  if (node == nullptr ||
+      node->type != NODE_TYPE_EXPANSION ||
+      node->numMembers() != 5 ||
+      node->getIntValue(true) != 1) {
+    return nullptr;
+  }
+
+  for (size_t i = 2; i < 5; ++i) {
+    if (node->getMember(i)->type != NODE_TYPE_NOP) {
+      // FILTER, LIMIT or RETURN used
+      return nullptr;
+    }
+  }
+
+  auto iterator = node->getMember(0);
+
+  if (iterator->type != NODE_TYPE_ITERATOR ||
+      iterator->numMembers() != 2) {
+    return nullptr;
+  }
+
+  auto variable = iterator->getMember(0);
+  auto expanded = iterator->getMember(1);
+
+  if (variable->type != NODE_TYPE_VARIABLE ||
+      expanded->type != NODE_TYPE_REFERENCE ||
+      static_cast<Variable const*>(expanded->getData()) != groupVariable) {
+    return nullptr;
+  }
+
+  return static_cast<Variable const*>(variable->getData());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check if the node is a function call that can be computed by an
+/// aggregate function of the COLLECT, e.g. `SUM(g[*].x.amount)`, `LENGTH(g)`
+/// or `LENGTH(UNIQUE(g[*].x))`. returns the expansion of the group variable
+/// (or the group variable reference for LENGTH) and sets the aggregator type.
+/// returns a nullptr if the node cannot be computed by an aggregator
+////////////////////////////////////////////////////////////////////////////////
+
+static AstNode const* MatchGroupAggregate (AstNode const* node,
+                                           Variable const* groupVariable,
+                                           std::string& type) {
+  if (node->type != NODE_TYPE_FCALL ||
+      node->getMember(0)->numMembers() != 1) {
+    return nullptr;
+  }
+
+  auto func = static_cast<Function const*>(node->getData());
+  auto arg = node->getMember(0)->getMember(0);
+
+  if (func->externalName == "LENGTH") {
+    if ((arg->type == NODE_TYPE_REFERENCE && static_cast<Variable const*>(arg->getData()) == groupVariable) ||
+        GroupExpansionIterator(arg, groupVariable) != nullptr) {
+      // an expansion without FILTER or LIMIT has as many members as the group
+      type = "LENGTH";
+      return arg;
+    }
+
+    if (arg->type == NODE_TYPE_FCALL &&
+        static_cast<Function const*>(arg->getData())->externalName == "UNIQUE" &&
+        arg->getMember(0)->numMembers() == 1 &&
+        GroupExpansionIterator(arg->getMember(0)->getMember(0), groupVariable) != nullptr) {
+      type = "COUNT_DISTINCT";
+      return arg->getMember(0)->getMember(0);
+    }
+
+    return nullptr;
+  }
+
+  if ((func->externalName == "SUM" ||
+       func->externalName == "AVERAGE" ||
+       func->externalName == "MIN" ||
+       func->externalName == "MAX") &&
+      GroupExpansionIterator(arg, groupVariable) != nullptr) {
+    type = func->externalName;
+    return arg;
+  }
+
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check if the expanded expression of a group expansion can be
+/// computed for each input row of the COLLECT. this is the case if the
+/// iterator variable is only used to access the group members' attributes,
+/// which are the variables visible to the COLLECT. if the COLLECT has an INTO
+/// expression, the group members are the values of that expression
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CanBuildAggregateInput (AstNode const* node,
+                                    Variable const* iterator,
+                                    Variable const* expressionVariable,
+                                    std::unordered_map<std::string, Variable const*> const& members) {
+  if (node == nullptr) {
+    return true;
+  }
+
+  if (expressionVariable == nullptr &&
+      node->type == NODE_TYPE_ATTRIBUTE_ACCESS &&
+      node->getMember(0)->type == NODE_TYPE_REFERENCE &&
+      static_cast<Variable const*>(node->getMember(0)->getData()) == iterator) {
+    auto it = members.find(std::string(node->getStringValue()));
+    return (it != members.end() && (*it).second != nullptr);
+  }
+
+  if (node->type == NODE_TYPE_REFERENCE &&
+      static_cast<Variable const*>(node->getData()) == iterator) {
+    return (expressionVariable != nullptr);
+  }
+
+  size_t const n = node->numMembers();
+
+  for (size_t i = 0; i < n; ++i) {
+    if (! CanBuildAggregateInput(node->getMember(i), iterator, expressionVariable, members)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rewrite a (cloned) expanded expression so it can be computed for
+/// each input row of the COLLECT
+////////////////////////////////////////////////////////////////////////////////
+
+static AstNode* BuildAggregateInput (Ast* ast,
+                                     AstNode* node,
+                                     Variable const* iterator,
+                                     Variable const* expressionVariable,
+                                     std::unordered_map<std::string, Variable const*> const& members) {
+  if (node == nullptr) {
+    return nullptr;
+  }
+
+  if (expressionVariable == nullptr &&
+      node->type == NODE_TYPE_ATTRIBUTE_ACCESS &&
+      node->getMember(0)->type == NODE_TYPE_REFERENCE &&
+      static_cast<Variable const*>(node->getMember(0)->getData()) == iterator) {
+    // g[*].x => x
+    return ast->createNodeReference(members.at(std::string(node->getStringValue())));
+  }
+
+  if (node->type == NODE_TYPE_REFERENCE &&
+      static_cast<Variable const*>(node->getData()) == iterator) {
+    // g[*] => INTO expression
+    TRI_ASSERT(expressionVariable != nullptr);
+    return ast->createNodeReference(expressionVariable);
+  }
+
+  size_t const n = node->numMembers();
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = node->getMember(i);
+    auto result = BuildAggregateInput(ast, member, iterator, expressionVariable, members);
+
+    if (result != member) {
+      node->changeMember(i, result);
+    }
+  }
+
+  return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check if all usages of the group variable in an expression can be
+/// replaced with aggregate functions of the COLLECT
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CanReplaceGroupUsage (AstNode const* node,
+                                  Variable const* groupVariable,
+                                  Variable const* expressionVariable,
+                                  std::unordered_map<std::string, Variable const*> const& members,
+                                  std::unordered_set<Variable const*> const& varsValid) {
+  if (node == nullptr) {
+    return true;
+  }
+
+  std::string type;
+  auto input = MatchGroupAggregate(node, groupVariable, type);
+
+  if (input != nullptr) {
+    if (! Aggregator::requiresInput(type)) {
+      return true;
+    }
+
+    auto iterator = GroupExpansionIterator(input, groupVariable);
+    TRI_ASSERT(iterator != nullptr);
+    auto expanded = input->getMember(1);
+
+    if (! CanBuildAggregateInput(expanded, iterator, expressionVariable, members)) {
+      return false;
+    }
+
+    // all other variables used must be available in front of the COLLECT
+    std::unordered_set<Variable*>&& variables = Ast::getReferencedVariables(expanded);
+
+    for (auto const& variable : variables) {
+      if (variable != iterator &&
+          varsValid.find(variable) == varsValid.end()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  if (node->type == NODE_TYPE_REFERENCE &&
+      static_cast<Variable const*>(node->getData()) == groupVariable) {
+    // group variable used in some other way
+    return false;
+  }
+
+  size_t const n = node->numMembers();
+
+  for (size_t i = 0; i < n; ++i) {
+    if (! CanReplaceGroupUsage(node->getMember(i), groupVariable, expressionVariable, members, varsValid)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace the group aggregates in a (cloned) expression with
+/// references to the results of new aggregate functions of the COLLECT.
+/// for each aggregate function, a calculation of its input value is inserted
+/// in front of the COLLECT
+////////////////////////////////////////////////////////////////////////////////
+
+static AstNode* ReplaceGroupAggregates (ExecutionPlan* plan,
+                                        AggregateNode* collectNode,
+                                        AstNode* node,
+                                        Variable const* groupVariable,
+                                        Variable const* expressionVariable,
+                                        std::unordered_map<std::string, Variable const*> const& members,
+                                        Variable const*& lengthVariable) {
+  if (node == nullptr) {
+    return nullptr;
+  }
+
+  auto ast = plan->getAst();
+  std::string type;
+  auto input = MatchGroupAggregate(node, groupVariable, type);
+
+  if (input != nullptr) {
+    if (! Aggregator::requiresInput(type)) {
+      // the group length is only computed once
+      if (lengthVariable == nullptr) {
+        lengthVariable = ast->variables()->createTemporaryVariable();
+        collectNode->addAggregateFunction(lengthVariable, nullptr, type);
+      }
+      return ast->createNodeReference(lengthVariable);
+    }
+
+    auto iterator = GroupExpansionIterator(input, groupVariable);
+    TRI_ASSERT(iterator != nullptr);
+
+    auto expanded = BuildAggregateInput(ast, ast->clone(input->getMember(1)), iterator, expressionVariable, members);
+    auto inVariable = ast->variables()->createTemporaryVariable();
+    auto expression = new Expression(ast, expanded);
+
+    ExecutionNode* calculationNode = nullptr;
+
+    try {
+      calculationNode = new CalculationNode(plan, plan->nextId(), expression, inVariable);
+    }
+    catch (...) {
+      delete expression;
+      throw;
+    }
+
+    plan->registerNode(calculationNode);
+    plan->insertDependency(collectNode, calculationNode);
+
+    auto outVariable = ast->variables()->createTemporaryVariable();
+    collectNode->addAggregateFunction(outVariable, inVariable, type);
+
+    return ast->createNodeReference(outVariable);
+  }
+
+  size_t const n = node->numMembers();
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = node->getMember(i);
+    auto result = ReplaceGroupAggregates(plan, collectNode, member, groupVariable, expressionVariable, members, lengthVariable);
+
+    if (result != member) {
+      node->changeMember(i, result);
+    }
+  }
+
+  return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute aggregates of COLLECT ... INTO groups incrementally
+/// this rewrites `COLLECT ... INTO g RETURN SUM(g[*].x.amount)` so that the
+/// sum is computed per group while the COLLECT reads its input, and the
+/// group members need not be kept in memory
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::useCollectAggregatesRule (Optimizer* opt,
+                                             ExecutionPlan* plan,
+                                             Optimizer::Rule const* rule) {
+  bool modified = false;
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::AGGREGATE, true);
+
+  if (! nodes.empty() && ! plan->varUsageComputed()) {
+    plan->findVarUsage();
+  }
+
+  for (auto const& n : nodes) {
+    auto collectNode = static_cast<AggregateNode*>(n);
+    TRI_ASSERT(collectNode != nullptr);
+
+    auto groupVariable = collectNode->outVariable();
+
+    if (groupVariable == nullptr || collectNode->count()) {
+      // no groups to aggregate
+      continue;
+    }
+
+    auto deps = collectNode->getDependencies();
+
+    if (deps.size() != 1) {
+      continue;
+    }
+
+    auto const& varsValid = deps[0]->getVarsValid();
+    auto expressionVariable = collectNode->expressionVariable();
+
+    // the attribute names of the group members, if no INTO expression is used
+    std::unordered_map<std::string, Variable const*> members;
+
+    if (expressionVariable == nullptr) {
+      std::unordered_set<Variable const*> groupInputs;
+      for (auto const& p : collectNode->aggregateVariables()) {
+        groupInputs.emplace(p.second);
+      }
+
+      std::vector<Variable const*> candidates(collectNode->keepVariables());
+
+      if (candidates.empty()) {
+        candidates = collectNode->getVariablesUsedHere();
+      }
+
+      for (auto const& variable : candidates) {
+        if (! variable->isUserDefined() ||
+            groupInputs.find(variable) != groupInputs.end()) {
+          continue;
+        }
+
+        auto it = members.find(variable->name);
+
+        if (it == members.end()) {
+          members.emplace(variable->name, variable);
+        }
+        else {
+          // ambiguous name
+          (*it).second = nullptr;
+        }
+      }
+    }
+
+    // find all calculations that use the group variable. other usages of
+    // the group variable prevent the optimization
+    std::vector<CalculationNode*> calculations;
+    bool canOptimize = true;
+    ExecutionNode* current = collectNode;
+
+    while (canOptimize) {
+      auto parents = current->getParents();
+
+      if (parents.empty()) {
+        break;
+      }
+
+      if (parents.size() != 1) {
+        canOptimize = false;
+        break;
+      }
+
+      current = parents[0];
+      std::vector<Variable const*>&& used = current->getVariablesUsedHere();
+
+      if (std::find(used.begin(), used.end(), groupVariable) == used.end()) {
+        continue;
+      }
+
+      if (current->getType() != EN::CALCULATION) {
+        canOptimize = false;
+        break;
+      }
+
+      auto calculationNode = static_cast<CalculationNode*>(current);
+
+      if (calculationNode->conditionVariable() != nullptr ||
+          ! CanReplaceGroupUsage(calculationNode->expression()->node(), groupVariable, expressionVariable, members, varsValid)) {
+        canOptimize = false;
+        break;
+      }
+
+      calculations.emplace_back(calculationNode);
+    }
+
+    if (! canOptimize || calculations.empty()) {
+      continue;
+    }
+
+    // now replace the calculations
+    auto ast = plan->getAst();
+    Variable const* lengthVariable = nullptr;
+
+    for (auto const& calculationNode : calculations) {
+      auto root = ast->clone(calculationNode->expression()->node());
+      root = ReplaceGroupAggregates(plan, collectNode, root, groupVariable, expressionVariable, members, lengthVariable);
+
+      auto expression = new Expression(ast, root);
+      ExecutionNode* newNode = nullptr;
+
+      try {
+        newNode = new CalculationNode(plan, plan->nextId(), expression, calculationNode->outVariable());
+      }
+      catch (...) {
+        delete expression;
+        throw;
+      }
+
+      plan->registerNode(newNode);
+      plan->replaceNode(calculationNode, newNode);
+    }
+
+    // the groups are not needed anymore
+    collectNode->clearOutVariable();
+    modified = true;
+  }
+
+  if (modified) {
+    plan->findVarUsage();
+  }
+
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                  helper class for propagateConstantAttributesRule
 // -----------------------------------------------------------------------------
@@ -847,9 +1312,11 @@ int triagens::aql::removeSortRandRule (Optimizer* opt,
         case EN::FILTER: 
         case EN::SUBQUERY:
         case EN::ENUMERATE_LIST:
-        case EN::INDEX_RANGE: {
+        case EN::INDEX_RANGE:
+        case EN::HASH_JOIN:
+        case EN::TRAVERSAL: {
           // if we found another SortNode, an AggregateNode, FilterNode, a SubqueryNode, 
-          // an EnumerateListNode or an IndexRangeNode
+          // an EnumerateListNode, an IndexRangeNode, a HashJoinNode or a TraversalNode
           // this means we cannot apply our optimization
           collectionNode = nullptr;
           current = nullptr;
@@ -1056,6 +1523,8 @@ int triagens::aql::moveCalculationsDownRule (Optimizer* opt,
       else if (currentType == EN::INDEX_RANGE ||
                currentType == EN::ENUMERATE_COLLECTION ||
                currentType == EN::ENUMERATE_LIST ||
+               currentType == EN::HASH_JOIN ||
+               currentType == EN::TRAVERSAL ||
                currentType == EN::AGGREGATE ||
                currentType == EN::NORESULTS) {
         // we will not push further down than such nodes
@@ -1202,28 +1671,197 @@ int triagens::aql::fuseCalculationsRule (Optimizer* opt,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief determine the "right" type of AggregateNode and 
-/// add a sort node for each COLLECT (note: the sort may be removed later) 
-/// this rule cannot be turned off (otherwise, the query result might be wrong!)
+/// @brief restrict a SORT that is followed by a LIMIT to the top
+/// offset + limit rows
+/// this rule modifies the plan in place
+/// only CalculationNodes may be located between the SORT and the LIMIT, as
+/// these do not change the number or order of rows. a LIMIT with fullCount
+/// is left alone, because it needs to see all rows produced by the SORT
 ////////////////////////////////////////////////////////////////////////////////
- 
-int triagens::aql::specializeCollectRule (Optimizer* opt, 
-                                          ExecutionPlan* plan, 
-                                          Optimizer::Rule const* rule) {
-  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::AGGREGATE, true);
+
+int triagens::aql::applySortLimitRule (Optimizer* opt,
+                                       ExecutionPlan* plan,
+                                       Optimizer::Rule const* rule) {
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::LIMIT, true);
   bool modified = false;
-  
+
   for (auto const& n : nodes) {
-    auto collectNode = static_cast<AggregateNode*>(n);
-    auto const& aggregateVariables = collectNode->aggregateVariables();
+    auto limitNode = static_cast<LimitNode const*>(n);
 
-    // test if we can use an alternative version of COLLECT with a hash table
-    bool const canUseHashAggregation = (! aggregateVariables.empty() &&
-                                        (! collectNode->hasOutVariable() || collectNode->count()) &&
-                                        collectNode->getOptions().canUseHashMethod());
-  
-    if (canUseHashAggregation) {
-      // create a new plan with the adjusted COLLECT node
+    if (limitNode->fullCount()) {
+      continue;
+    }
+
+    size_t const offset = limitNode->offset();
+    size_t const limit  = limitNode->limit();
+
+    if (limit == 0 ||
+        offset + limit < offset) {
+      // nothing to restrict, or overflow
+      continue;
+    }
+
+    auto current = n;
+
+    while (true) {
+      auto const& deps = current->getDependencies();
+      if (deps.size() != 1) {
+        break;
+      }
+
+      current = deps[0];
+      auto const currentType = current->getType();
+
+      if (currentType == EN::SORT) {
+        auto sortNode = static_cast<SortNode*>(current);
+
+        if (sortNode->limit() == 0 ||
+            sortNode->limit() > offset + limit) {
+          sortNode->setLimit(offset + limit);
+          modified = true;
+        }
+        break;
+      }
+
+      if (currentType != EN::CALCULATION) {
+        break;
+      }
+    }
+  }
+
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief auxilliary struct for collecting all nodes of a plan, including the
+/// nodes of subqueries
+////////////////////////////////////////////////////////////////////////////////
+
+class AllNodesCollector : public WalkerWorker<ExecutionNode> {
+
+  public:
+
+    std::vector<ExecutionNode*> nodes;
+
+    bool before (ExecutionNode* en) override final {
+      nodes.emplace_back(en);
+      return false;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect the top-level attributes of <variable> that are accessed
+/// in the expression <node>. returns false if the variable is used in any
+/// other way than `variable.attribute`, e.g. as a whole or via `variable[...]`
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CollectProjection (AstNode const* node,
+                               Variable const* variable,
+                               std::unordered_set<std::string>& attributes) {
+  if (node == nullptr) {
+    return true;
+  }
+
+  if (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    auto member = node->getMember(0);
+
+    if (member->type == NODE_TYPE_REFERENCE &&
+        static_cast<Variable const*>(member->getData()) == variable) {
+      char const* name = node->getStringValue();
+
+      if (strchr(name, '.') != nullptr) {
+        // attribute names with dots would be interpreted as paths when
+        // extracting them from the shaped document
+        return false;
+      }
+
+      attributes.emplace(name);
+      return true;
+    }
+  }
+  else if (node->type == NODE_TYPE_REFERENCE) {
+    // reference to the complete value
+    return (static_cast<Variable const*>(node->getData()) != variable);
+  }
+
+  size_t const n = node->numMembers();
+
+  for (size_t i = 0; i < n; ++i) {
+    if (! CollectProjection(node->getMember(i), variable, attributes)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief determine the top-level attributes of <variable>, which is set by
+/// <scan>, that are used by the plan's <nodes>. returns false if the variable
+/// is used as a whole anywhere, or if no attributes are used. the attribute
+/// names are returned sorted
+////////////////////////////////////////////////////////////////////////////////
+
+static bool FindProjection (std::vector<ExecutionNode*> const& nodes,
+                            ExecutionNode const* scan,
+                            Variable const* variable,
+                            std::vector<std::string>& projection) {
+  std::unordered_set<std::string> attributes;
+
+  for (auto const& current : nodes) {
+    if (current == scan ||
+        current->getType() == EN::SUBQUERY) {
+      // the nodes of subqueries are inspected individually
+      continue;
+    }
+
+    auto&& varsUsed = current->getVariablesUsedHere();
+
+    if (std::find(varsUsed.begin(), varsUsed.end(), variable) == varsUsed.end()) {
+      continue;
+    }
+
+    if (current->getType() != EN::CALCULATION ||
+        ! CollectProjection(static_cast<CalculationNode const*>(current)->expression()->node(), variable, attributes)) {
+      return false;
+    }
+  }
+
+  if (attributes.empty()) {
+    return false;
+  }
+
+  projection.assign(attributes.begin(), attributes.end());
+  std::sort(projection.begin(), projection.end());
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief determine the "right" type of AggregateNode and 
+/// add a sort node for each COLLECT (note: the sort may be removed later) 
+/// this rule cannot be turned off (otherwise, the query result might be wrong!)
+////////////////////////////////////////////////////////////////////////////////
+ 
+int triagens::aql::specializeCollectRule (Optimizer* opt, 
+                                          ExecutionPlan* plan, 
+                                          Optimizer::Rule const* rule) {
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::AGGREGATE, true);
+  bool modified = false;
+  
+  for (auto const& n : nodes) {
+    auto collectNode = static_cast<AggregateNode*>(n);
+    auto const& aggregateVariables = collectNode->aggregateVariables();
+
+    // test if we can use an alternative version of COLLECT with a hash table
+    bool const canUseHashAggregation = (! aggregateVariables.empty() &&
+                                        (! collectNode->hasOutVariable() || collectNode->count()) &&
+                                        collectNode->getOptions().canUseHashMethod());
+  
+    if (canUseHashAggregation) {
+      // create a new plan with the adjusted COLLECT node
       std::unique_ptr<ExecutionPlan> newPlan(plan->clone());
    
       // use the cloned COLLECT node 
@@ -1492,6 +2130,11 @@ class triagens::aql::RedundantCalculationsReplacer : public WalkerWorker<Executi
           replaceInVariable<EnumerateListNode>(en);
           break;
         }
+
+        case EN::TRAVERSAL: {
+          replaceInVariable<TraversalNode>(en);
+          break;
+        }
       
         case EN::RETURN: {
           replaceInVariable<ReturnNode>(en);
@@ -2147,6 +2790,8 @@ class FilterToEnumCollFinder : public WalkerWorker<ExecutionNode> {
           return true;
         case EN::SORT:
         case EN::INDEX_RANGE:
+        case EN::HASH_JOIN:
+        case EN::TRAVERSAL:
           break;
         case EN::ENUMERATE_COLLECTION: {
           auto node = static_cast<EnumerateCollectionNode*>(en);
@@ -2825,7 +3470,9 @@ class SortToIndexNode : public WalkerWorker<ExecutionNode> {
 
         if (node->getType() == EN::ENUMERATE_COLLECTION ||
             node->getType() == EN::INDEX_RANGE ||
-            node->getType() == EN::ENUMERATE_LIST) {
+            node->getType() == EN::ENUMERATE_LIST ||
+            node->getType() == EN::HASH_JOIN ||
+            node->getType() == EN::TRAVERSAL) {
           // we are contained in an outer loop
           return true;
 
@@ -2837,159 +3484,550 @@ class SortToIndexNode : public WalkerWorker<ExecutionNode> {
       return false;
     }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief if the sort is already done by an indexrange, remove the sort.
-////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/// @brief if the sort is already done by an indexrange, remove the sort.
+////////////////////////////////////////////////////////////////////////////////
+
+    bool handleIndexRangeNode (IndexRangeNode* node) {
+      if (isInnerLoop(node)) {
+        // index range contained in an outer loop. must not optimize away the sort!
+        return true;
+      }
+
+      auto variableName = node->getVariablesSetHere()[0]->name;
+      auto result = _sortNode->getAttrsForVariableName(variableName);
+
+      auto const& match = node->matchesIndex(result.first);
+
+      if (match.doesMatch) {
+        if (match.reverse) {
+          node->reverse(true); 
+        } 
+        _sortNode->removeSortNodeFromPlan(_plan);
+        _modified = true;
+      }
+      return true;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether we can sort via an index.
+////////////////////////////////////////////////////////////////////////////////
+
+    bool handleEnumerateCollectionNode (EnumerateCollectionNode* node, 
+                                        Optimizer::RuleLevel level) {
+      if (isInnerLoop(node)) {
+        // index range contained in an outer loop. must not optimize away the sort!
+        return true;
+      }
+
+      auto variableName = node->getVariablesSetHere()[0]->name;
+      auto result = _sortNode->getAttrsForVariableName(variableName);
+
+      if (result.first.size() == 0) {
+        return true; // we didn't find anything replaceable by index
+      }
+
+      // get all candidate indexes
+      // note: can only use the index if it is a skip list (or a hash and we
+      // are checking equality)
+
+      auto const& indexes = node->getIndicesOrdered(result.first);
+
+      EnumerateCollectionNode::IndexMatch const* preferredIndex = nullptr;
+ 
+      // enumerate all indexes and pick the first one that covers the condition
+      for (auto const& idx : indexes) {
+        if (idx.doesMatch) {
+          preferredIndex = &idx;
+          break;
+        }
+      }
+
+      if (preferredIndex == nullptr && ! indexes.empty()) {
+        // did not find an index which covers the condition. now pick the first one
+        preferredIndex = &indexes[0];
+      }
+
+      if (preferredIndex != nullptr) { 
+        ExecutionNode* newNode = new IndexRangeNode(_plan,
+                                                    _plan->nextId(),
+                                                    node->vocbase(), 
+                                                    node->collection(),
+                                                    node->outVariable(),
+                                                    preferredIndex->index,
+                                                    result.second,
+                                                    (preferredIndex->doesMatch && preferredIndex->reverse));
+        _plan->registerNode(newNode);
+        _plan->replaceNode(node, newNode);
+
+        if (preferredIndex->doesMatch) { // if the index superseedes the sort, remove it.
+          _sortNode->removeSortNodeFromPlan(_plan);
+        }
+        
+        _modified = true;
+      }
+      
+      return true;
+    }
+
+    bool enterSubquery (ExecutionNode*, ExecutionNode*) override final { 
+      return false; 
+    }
+
+    bool before (ExecutionNode* en) override final {
+      switch (en->getType()) {
+      case EN::ENUMERATE_LIST:
+      case EN::CALCULATION:
+      case EN::SUBQUERY:
+      case EN::FILTER:
+        return false;                           // skip. we don't care.
+
+      case EN::SINGLETON:
+      case EN::AGGREGATE:
+      case EN::INSERT:
+      case EN::REMOVE:
+      case EN::REPLACE:
+      case EN::UPDATE:
+      case EN::UPSERT:
+      case EN::RETURN:
+      case EN::NORESULTS:
+      case EN::SCATTER:
+      case EN::DISTRIBUTE:
+      case EN::GATHER:
+      case EN::REMOTE:
+      case EN::HASH_JOIN:
+      case EN::TRAVERSAL:
+      case EN::ILLEGAL:
+      case EN::LIMIT:                      // LIMIT is criterion to stop
+        return true;  // abort.
+
+      case EN::SORT:     // pulling two sorts together is done elsewhere.
+        return en->id() != _sortNode->sortNodeID;    // ignore ourselves.
+
+      case EN::INDEX_RANGE:
+        return handleIndexRangeNode(static_cast<IndexRangeNode*>(en));
+
+      case EN::ENUMERATE_COLLECTION:
+        return handleEnumerateCollectionNode(static_cast<EnumerateCollectionNode*>(en), _level);
+      }
+      return true;
+    }
+};
+
+int triagens::aql::useIndexForSortRule (Optimizer* opt, 
+                                        ExecutionPlan* plan,
+                                        Optimizer::Rule const* rule) {
+  bool modified = false;
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::SORT, true);
+
+  for (auto const& n : nodes) {
+    auto thisSortNode = static_cast<SortNode*>(n);
+    SortAnalysis node(thisSortNode);
+
+    if (node.isAnalyzeable() && ! n->getDependencies().empty()) {
+      SortToIndexNode finder(plan, &node, rule->level);
+      thisSortNode->getDependencies()[0]->walk(&finder);
+
+      if (finder.modified()) {
+        modified = true;
+      }
+    }
+  }
+    
+  if (modified) {
+    plan->findVarUsage();
+  }
+        
+  opt->addPlan(plan, rule, modified, modified ? Optimizer::RuleLevel::pass5 : 0);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the variable and the attribute path from an attribute 
+/// access (e.g. `a.b.c` will return variable `a` and the path `b`, `c`)
+////////////////////////////////////////////////////////////////////////////////
+
+static bool GetAttributePath (AstNode const* node,
+                              Variable const*& variable,
+                              std::vector<std::string>& path) {
+  TRI_ASSERT(path.empty());
+
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    path.emplace(path.begin(), node->getStringValue());
+    node = node->getMember(0);
+  }
+
+  if (node->type != NODE_TYPE_REFERENCE) {
+    return false;
+  }
+
+  variable = static_cast<Variable const*>(node->getData());
+  TRI_ASSERT(variable != nullptr);
+
+  return ! path.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the SubqueryNode whose subquery starts with <singleton>.
+/// returns a nullptr if <singleton> is the start of the main query
+////////////////////////////////////////////////////////////////////////////////
+
+static ExecutionNode const* FindEnclosingSubquery (ExecutionPlan* plan,
+                                                   ExecutionNode const* singleton) {
+  std::vector<ExecutionNode*>&& subqueries = plan->findNodesOfType(EN::SUBQUERY, true);
+
+  for (auto const& sq : subqueries) {
+    ExecutionNode const* current = static_cast<SubqueryNode const*>(sq)->getSubquery();
+
+    while (current != nullptr) {
+      auto const& deps = current->getDependencies();
+
+      if (deps.empty()) {
+        break;
+      }
+
+      current = deps[0];
+    }
+
+    if (current == singleton) {
+      return sq;
+    }
+  }
+
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether a hash join can replace the enumeration <enumerate>
+/// for the join condition in <filter>
+/// only FILTERs and calculations may be located between the enumeration 
+/// and the filter, and the enumeration must be located in an inner loop.
+/// an enumeration in a subquery counts as an inner loop if the subquery is
+/// executed for each row of an outer loop. the hash table is then built once
+/// and only probed for each execution of the subquery
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CanUseHashJoin (ExecutionPlan* plan,
+                            ExecutionNode const* filter,
+                            ExecutionNode const* enumerate) {
+  auto current = filter;
+
+  while (current != enumerate) {
+    auto const& deps = current->getDependencies();
+
+    if (deps.size() != 1) {
+      return false;
+    }
+
+    current = deps[0];
+    auto const currentType = current->getType();
+
+    if (current != enumerate &&
+        currentType != EN::CALCULATION &&
+        currentType != EN::FILTER) {
+      return false;
+    }
+  }
+
+  // look for an outer loop
+  while (true) {
+    auto const& deps = current->getDependencies();
+
+    if (deps.empty() && current->getType() == EN::SINGLETON) {
+      // start of a subquery. continue in front of the subquery
+      current = FindEnclosingSubquery(plan, current);
+
+      if (current == nullptr) {
+        // start of the main query
+        return false;
+      }
+      continue;
+    }
+
+    if (deps.size() != 1) {
+      return false;
+    }
+
+    current = deps[0];
+    auto const currentType = current->getType();
+
+    if (currentType == EN::ENUMERATE_COLLECTION ||
+        currentType == EN::INDEX_RANGE ||
+        currentType == EN::ENUMERATE_LIST ||
+        currentType == EN::HASH_JOIN ||
+        currentType == EN::TRAVERSAL) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a hash join for equi-joins between an outer loop and a 
+/// collection enumeration in an inner loop, if no index can be used for the
+/// inner loop
+/// the enumeration is replaced with a HashJoinNode, which puts all documents 
+/// of the collection into a hash table once and then only looks up the 
+/// documents matching the value from the outer loop. the original FILTER is 
+/// left in place
+/// this rule modifies the plan in place
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::useHashJoinRule (Optimizer* opt, 
+                                    ExecutionPlan* plan,
+                                    Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  // the hash table is built once per query, so we must not use it if the
+  // query modifies documents. hash joins are also not supported in the cluster
+  std::vector<ExecutionNode::NodeType> const modificationTypes = {
+    EN::INSERT,
+    EN::UPDATE,
+    EN::REPLACE,
+    EN::REMOVE,
+    EN::UPSERT
+  };
+
+  if (! triagens::arango::ServerState::instance()->isCoordinator() &&
+      plan->findNodesOfType(modificationTypes, true).empty()) {
+    std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::FILTER, true);
+
+    for (auto const& n : nodes) {
+      auto&& varsUsed = n->getVariablesUsedHere();
+      TRI_ASSERT(varsUsed.size() == 1);
+
+      auto setter = plan->getVarSetBy(varsUsed[0]->id);
+
+      if (setter == nullptr || 
+          setter->getType() != EN::CALCULATION) {
+        continue;
+      }
+
+      auto expression = static_cast<CalculationNode const*>(setter)->expression();
+      AstNode const* condition = expression->node();
+
+      if (condition->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+        continue;
+      }
+
+      for (size_t i = 0; i < 2; ++i) {
+        AstNode const* buildSide = condition->getMember(i);
+        AstNode const* probeSide = condition->getMember(1 - i);
+
+        if (buildSide->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+          continue;
+        }
+
+        Variable const* variable = nullptr;
+        std::vector<std::string> attribute;
+
+        if (! GetAttributePath(buildSide, variable, attribute)) {
+          continue;
+        }
+
+        auto enumerate = plan->getVarSetBy(variable->id);
+
+        if (enumerate == nullptr ||
+            enumerate->getType() != EN::ENUMERATE_COLLECTION ||
+            ! CanUseHashJoin(plan, n, enumerate)) {
+          continue;
+        }
+
+        // the value to look up must be computable before the enumeration 
+        // and must depend on the outer loop
+        auto&& probeVariables = Ast::getReferencedVariables(probeSide);
+
+        if (probeVariables.empty() ||
+            probeSide->canThrow() ||
+            ! probeSide->isDeterministic()) {
+          continue;
+        }
+
+        auto const& varsValid = enumerate->getDependencies()[0]->getVarsValid();
+        bool valid = true;
+
+        for (auto const& v : probeVariables) {
+          if (varsValid.find(v) == varsValid.end()) {
+            valid = false;
+            break;
+          }
+        }
+
+        if (! valid) {
+          continue;
+        }
+
+        // calculate the lookup value before the enumeration
+        auto probeVariable = plan->getAst()->variables()->createTemporaryVariable();
+        auto probeExpression = new Expression(plan->getAst(), plan->getAst()->clone(probeSide));
+        ExecutionNode* calculationNode = nullptr;
+
+        try {
+          calculationNode = new CalculationNode(plan, plan->nextId(), probeExpression, probeVariable);
+        }
+        catch (...) {
+          delete probeExpression;
+          throw;
+        }
+        plan->registerNode(calculationNode);
+
+        auto enumerateNode = static_cast<EnumerateCollectionNode*>(enumerate);
+        ExecutionNode* hashJoinNode = new HashJoinNode(plan, 
+                                                       plan->nextId(),
+                                                       enumerateNode->vocbase(),
+                                                       const_cast<Collection*>(enumerateNode->collection()),
+                                                       enumerateNode->outVariable(),
+                                                       attribute,
+                                                       probeVariable);
+        plan->registerNode(hashJoinNode);
+        plan->replaceNode(enumerate, hashJoinNode);
+        plan->insertDependency(hashJoinNode, calculationNode);
 
-    bool handleIndexRangeNode (IndexRangeNode* node) {
-      if (isInnerLoop(node)) {
-        // index range contained in an outer loop. must not optimize away the sort!
-        return true;
+        modified = true;
+        break;
       }
+    }
+  }
 
-      auto variableName = node->getVariablesSetHere()[0]->name;
-      auto result = _sortNode->getAttrsForVariableName(variableName);
+  if (modified) {
+    plan->findVarUsage();
+  }
 
-      auto const& match = node->matchesIndex(result.first);
+  opt->addPlan(plan, rule, modified);
 
-      if (match.doesMatch) {
-        if (match.reverse) {
-          node->reverse(true); 
-        } 
-        _sortNode->removeSortNodeFromPlan(_plan);
-        _modified = true;
-      }
-      return true;
-    }
+  return TRI_ERROR_NO_ERROR;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief check whether we can sort via an index.
+/// @brief check whether an expression only refers to the path variable of
+/// a traversal via `path.edges[<constant>]` or `path.vertices[<constant>]`.
+/// if so, depth is set to the minimum path length at which the expression
+/// can be evaluated
 ////////////////////////////////////////////////////////////////////////////////
 
-    bool handleEnumerateCollectionNode (EnumerateCollectionNode* node, 
-                                        Optimizer::RuleLevel level) {
-      if (isInnerLoop(node)) {
-        // index range contained in an outer loop. must not optimize away the sort!
-        return true;
-      }
+static bool IsPathCondition (AstNode const* node,
+                             Variable const* pathVariable,
+                             uint64_t& depth,
+                             bool& found) {
+  if (node == nullptr) {
+    return true;
+  }
 
-      auto variableName = node->getVariablesSetHere()[0]->name;
-      auto result = _sortNode->getAttrsForVariableName(variableName);
+  if (node->type == NODE_TYPE_REFERENCE) {
+    // any other variable, or the path variable without a constant index
+    return false;
+  }
 
-      if (result.first.size() == 0) {
-        return true; // we didn't find anything replaceable by index
-      }
+  if (node->type == NODE_TYPE_INDEXED_ACCESS) {
+    auto object = node->getMember(0);
+    auto index = node->getMember(1);
 
-      // get all candidate indexes
-      // note: can only use the index if it is a skip list (or a hash and we
-      // are checking equality)
+    if (object->type == NODE_TYPE_ATTRIBUTE_ACCESS &&
+        object->getMember(0)->type == NODE_TYPE_REFERENCE &&
+        static_cast<Variable const*>(object->getMember(0)->getData()) == pathVariable) {
+      if (! index->isConstant() ||
+          ! (index->isValueType(VALUE_TYPE_INT) || index->isValueType(VALUE_TYPE_DOUBLE)) ||
+          index->getIntValue() < 0) {
+        return false;
+      }
 
-      auto const& indexes = node->getIndicesOrdered(result.first);
+      uint64_t position = static_cast<uint64_t>(index->getIntValue());
+      char const* name = object->getStringValue();
 
-      EnumerateCollectionNode::IndexMatch const* preferredIndex = nullptr;
- 
-      // enumerate all indexes and pick the first one that covers the condition
-      for (auto const& idx : indexes) {
-        if (idx.doesMatch) {
-          preferredIndex = &idx;
-          break;
-        }
+      if (strcmp(name, "edges") == 0) {
+        // the n-th edge is known once the path has length n + 1
+        depth = (std::max)(depth, position + 1);
       }
-
-      if (preferredIndex == nullptr && ! indexes.empty()) {
-        // did not find an index which covers the condition. now pick the first one
-        preferredIndex = &indexes[0];
+      else if (strcmp(name, "vertices") == 0) {
+        depth = (std::max)(depth, position);
       }
-
-      if (preferredIndex != nullptr) { 
-        ExecutionNode* newNode = new IndexRangeNode(_plan,
-                                                    _plan->nextId(),
-                                                    node->vocbase(), 
-                                                    node->collection(),
-                                                    node->outVariable(),
-                                                    preferredIndex->index,
-                                                    result.second,
-                                                    (preferredIndex->doesMatch && preferredIndex->reverse));
-        _plan->registerNode(newNode);
-        _plan->replaceNode(node, newNode);
-
-        if (preferredIndex->doesMatch) { // if the index superseedes the sort, remove it.
-          _sortNode->removeSortNodeFromPlan(_plan);
-        }
-        
-        _modified = true;
+      else {
+        return false;
       }
-      
+
+      found = true;
       return true;
     }
+  }
 
-    bool enterSubquery (ExecutionNode*, ExecutionNode*) override final { 
-      return false; 
+  size_t const n = node->numMembers();
+
+  for (size_t i = 0; i < n; ++i) {
+    if (! IsPathCondition(node->getMember(i), pathVariable, depth, found)) {
+      return false;
     }
+  }
 
-    bool before (ExecutionNode* en) override final {
-      switch (en->getType()) {
-      case EN::ENUMERATE_LIST:
-      case EN::CALCULATION:
-      case EN::SUBQUERY:
-      case EN::FILTER:
-        return false;                           // skip. we don't care.
+  return true;
+}
 
-      case EN::SINGLETON:
-      case EN::AGGREGATE:
-      case EN::INSERT:
-      case EN::REMOVE:
-      case EN::REPLACE:
-      case EN::UPDATE:
-      case EN::UPSERT:
-      case EN::RETURN:
-      case EN::NORESULTS:
-      case EN::SCATTER:
-      case EN::DISTRIBUTE:
-      case EN::GATHER:
-      case EN::REMOTE:
-      case EN::ILLEGAL:
-      case EN::LIMIT:                      // LIMIT is criterion to stop
-        return true;  // abort.
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move filters on the path of a traversal into the traversal
+/// a FILTER following a traversal that only refers to fixed positions of 
+/// the path (e.g. `p.edges[1].type == 'friend'`) is copied into the 
+/// TraversalNode as a path condition. the traversal checks the condition as
+/// soon as the path has reached the required length, and does not follow
+/// any further edges from paths that do not satisfy it. the original FILTER
+/// is left in place
+/// this rule modifies the plan in place
+////////////////////////////////////////////////////////////////////////////////
 
-      case EN::SORT:     // pulling two sorts together is done elsewhere.
-        return en->id() != _sortNode->sortNodeID;    // ignore ourselves.
+int triagens::aql::moveFiltersIntoTraversalRule (Optimizer* opt, 
+                                                 ExecutionPlan* plan,
+                                                 Optimizer::Rule const* rule) {
+  bool modified = false;
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::TRAVERSAL, true);
 
-      case EN::INDEX_RANGE:
-        return handleIndexRangeNode(static_cast<IndexRangeNode*>(en));
+  for (auto const& n : nodes) {
+    auto traversal = static_cast<TraversalNode*>(n);
+    auto pathVariable = traversal->pathOutVariable();
 
-      case EN::ENUMERATE_COLLECTION:
-        return handleEnumerateCollectionNode(static_cast<EnumerateCollectionNode*>(en), _level);
-      }
-      return true;
+    if (pathVariable == nullptr) {
+      continue;
     }
-};
 
-int triagens::aql::useIndexForSortRule (Optimizer* opt, 
-                                        ExecutionPlan* plan,
-                                        Optimizer::Rule const* rule) {
-  bool modified = false;
-  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::SORT, true);
+    // inspect the FILTERs directly following the traversal. only 
+    // calculations may be placed between them
+    auto parents = n->getParents();
 
-  for (auto const& n : nodes) {
-    auto thisSortNode = static_cast<SortNode*>(n);
-    SortAnalysis node(thisSortNode);
+    while (parents.size() == 1) {
+      auto current = parents[0];
+      auto const currentType = current->getType();
 
-    if (node.isAnalyzeable() && ! n->getDependencies().empty()) {
-      SortToIndexNode finder(plan, &node, rule->level);
-      thisSortNode->getDependencies()[0]->walk(&finder);
+      if (currentType == EN::FILTER) {
+        auto&& varsUsed = current->getVariablesUsedHere();
+        TRI_ASSERT(varsUsed.size() == 1);
 
-      if (finder.modified()) {
-        modified = true;
+        auto setter = plan->getVarSetBy(varsUsed[0]->id);
+
+        if (setter != nullptr && 
+            setter->getType() == EN::CALCULATION) {
+          auto expression = static_cast<CalculationNode*>(setter)->expression();
+          uint64_t depth = 0;
+          bool found = false;
+
+          if (! expression->isV8() &&
+              ! expression->canThrow() &&
+              expression->isDeterministic() &&
+              IsPathCondition(expression->node(), pathVariable, depth, found) &&
+              found &&
+              depth <= traversal->options().maxDepth) {
+            traversal->addPathCondition(depth, expression->clone());
+            modified = true;
+          }
+        }
+      }
+      else if (currentType != EN::CALCULATION) {
+        break;
       }
+
+      parents = current->getParents();
     }
   }
-    
-  if (modified) {
-    plan->findVarUsage();
-  }
-        
-  opt->addPlan(plan, rule, modified, modified ? Optimizer::RuleLevel::pass5 : 0);
+
+  opt->addPlan(plan, rule, modified);
 
   return TRI_ERROR_NO_ERROR;
 }
@@ -3770,6 +4808,8 @@ int triagens::aql::distributeFilternCalcToClusterRule (Optimizer* opt,
         case EN::SORT:
         case EN::INDEX_RANGE:
         case EN::ENUMERATE_COLLECTION:
+        case EN::HASH_JOIN:
+        case EN::TRAVERSAL:
           //do break
           stopSearching = true;
           break;
@@ -3863,6 +4903,8 @@ int triagens::aql::distributeSortToClusterRule (Optimizer* opt,
         case EN::LIMIT:
         case EN::INDEX_RANGE:
         case EN::ENUMERATE_COLLECTION:
+        case EN::HASH_JOIN:
+        case EN::TRAVERSAL:
           // For all these, we do not want to pull a SortNode further down
           // out to the DBservers, note that potential FilterNodes and
           // CalculationNodes that can be moved to the DBservers have 
@@ -4136,7 +5178,9 @@ class RemoveToEnumCollFinder : public WalkerWorker<ExecutionNode> {
         case EN::ILLEGAL:
         case EN::LIMIT:           
         case EN::SORT:
-        case EN::INDEX_RANGE: {
+        case EN::INDEX_RANGE:
+        case EN::HASH_JOIN:
+        case EN::TRAVERSAL: {
           // if we meet any of the above, then we abort . . .
         }
     }
@@ -4172,6 +5216,158 @@ int triagens::aql::undistributeRemoveAfterEnumCollRule (Optimizer* opt,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the documents produced by <node> are sent to another
+/// server, i.e. whether <variable> is still used after the first RemoteNode
+/// following <node>
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsUsedAfterRemote (ExecutionNode const* node,
+                               Variable const* variable) {
+  while (true) {
+    auto&& parents = node->getParents();
+
+    if (parents.size() != 1) {
+      return false;
+    }
+
+    node = parents[0];
+
+    if (node->getType() == EN::REMOTE) {
+      return node->isVarUsedLater(variable);
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the attributes used from a document directly from the elements
+/// of a hash or skiplist index if the index covers all of them, and the
+/// documents are sent to another server. _key and _rev are covered by all
+/// indexes
+/// this rule modifies the plan in place
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::useCoveringIndexRule (Optimizer* opt,
+                                         ExecutionPlan* plan,
+                                         Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(EN::INDEX_RANGE, true);
+
+  if (! nodes.empty()) {
+    plan->findVarUsage();
+
+    AllNodesCollector collector;
+    plan->root()->walk(&collector);
+
+    for (auto const& n : nodes) {
+      auto node = static_cast<IndexRangeNode*>(n);
+      auto const index = node->getIndex();
+
+      if (node->isCovering() ||
+          (index->type != triagens::arango::Index::TRI_IDX_TYPE_HASH_INDEX &&
+           index->type != triagens::arango::Index::TRI_IDX_TYPE_SKIPLIST_INDEX)) {
+        continue;
+      }
+
+      if (! IsUsedAfterRemote(n, node->outVariable())) {
+        // the attributes are read directly from the shaped documents, which
+        // is cheaper than building an object from the index element
+        continue;
+      }
+
+      std::vector<std::string> projection;
+
+      if (! FindProjection(collector.nodes, n, node->outVariable(), projection)) {
+        continue;
+      }
+
+      bool covered = true;
+
+      for (auto const& name : projection) {
+        if (name != TRI_VOC_ATTRIBUTE_KEY &&
+            name != TRI_VOC_ATTRIBUTE_REV &&
+            std::find(index->fields.begin(), index->fields.end(), name) == index->fields.end()) {
+          covered = false;
+          break;
+        }
+      }
+
+      if (covered) {
+        node->setProjection(projection);
+        node->setCovering(true);
+        modified = true;
+      }
+    }
+  }
+
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief let collection scans only produce the attributes of the documents
+/// that are used later, if the documents are shipped to another server
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::reduceExtractionToProjectionRule (Optimizer* opt, 
+                                                     ExecutionPlan* plan, 
+                                                     Optimizer::Rule const* rule) {
+  bool modified = false;
+  std::vector<ExecutionNode::NodeType> const types = {
+    EN::ENUMERATE_COLLECTION,
+    EN::INDEX_RANGE
+  };
+
+  std::vector<ExecutionNode*>&& nodes = plan->findNodesOfType(types, true);
+
+  if (! nodes.empty()) {
+    plan->findVarUsage();
+
+    AllNodesCollector collector;
+    plan->root()->walk(&collector);
+
+    for (auto const& n : nodes) {
+      if (n->getType() == EN::INDEX_RANGE &&
+          static_cast<IndexRangeNode const*>(n)->isCovering()) {
+        // the projection has already been set up for reading from the index
+        continue;
+      }
+
+      auto&& varsSet = n->getVariablesSetHere();
+      TRI_ASSERT(varsSet.size() == 1);
+      Variable const* outVariable = varsSet[0];
+
+      if (! IsUsedAfterRemote(n, outVariable)) {
+        // documents are not transferred, and single attributes are already
+        // read directly from the shaped documents
+        continue;
+      }
+
+      std::vector<std::string> projection;
+
+      if (! FindProjection(collector.nodes, n, outVariable, projection)) {
+        continue;
+      }
+
+      if (n->getType() == EN::ENUMERATE_COLLECTION) {
+        static_cast<EnumerateCollectionNode*>(n)->setProjection(projection);
+      }
+      else {
+        static_cast<IndexRangeNode*>(n)->setProjection(projection);
+      }
+      modified = true;
+    }
+  }
+
+  opt->addPlan(plan, rule, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief auxilliary struct for finding common nodes in OR conditions
 ////////////////////////////////////////////////////////////////////////////////
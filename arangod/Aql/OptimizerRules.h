@@ -68,6 +68,12 @@ namespace triagens {
     
     int removeCollectIntoRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute aggregates of COLLECT ... INTO groups incrementally
+////////////////////////////////////////////////////////////////////////////////
+    
+    int useCollectAggregatesRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief propagate constant attributes in FILTERs
 ////////////////////////////////////////////////////////////////////////////////
@@ -105,6 +111,14 @@ namespace triagens {
 
     int fuseCalculationsRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restrict a SORT that is followed by a LIMIT to the top 
+/// offset + limit rows
+/// this rule modifies the plan in place
+////////////////////////////////////////////////////////////////////////////////
+
+    int applySortLimitRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief determine the "right" type of AggregateNode and 
 /// add a sort node for each COLLECT (may be removed later) 
@@ -153,6 +167,19 @@ namespace triagens {
 
     int useIndexForSortRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a hash join for equi-joins with a collection in an inner loop
+////////////////////////////////////////////////////////////////////////////////
+
+    int useHashJoinRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move filters on fixed positions of a traversal path into the 
+/// traversal
+////////////////////////////////////////////////////////////////////////////////
+
+    int moveFiltersIntoTraversalRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief try to remove filters which are covered by indexes
 ////////////////////////////////////////////////////////////////////////////////
@@ -225,6 +252,29 @@ namespace triagens {
 
     int undistributeRemoveAfterEnumCollRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief let an index range scan produce only the attributes of the documents
+/// that are sent from the DB servers to the coordinator, reading them from the
+/// index elements instead of the documents if the index covers all of them
+/// this rule modifies the plan in place
+////////////////////////////////////////////////////////////////////////////////
+
+    int useCoveringIndexRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief let collection scans produce only the attributes of the documents
+/// that are used later, if the documents are sent from the DB servers to the
+/// coordinator. this is the case if the document variable is only used in
+/// attribute accesses of the form `doc.attribute`, e.g. in
+///
+///   FOR doc IN coll SORT doc.value RETURN doc.name
+///
+/// the attribute values are then extracted directly from the shaped
+/// documents, and only they are transferred
+////////////////////////////////////////////////////////////////////////////////
+
+    int reduceExtractionToProjectionRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief this rule replaces expressions of the type: 
 ///   x.val == 1 || x.val == 2 || x.val == 3
@@ -36,9 +36,11 @@
 #include "Aql/Parser.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryList.h"
+#include "Aql/QueryPlanCache.h"
 #include "Aql/ShortStringStorage.h"
 #include "Basics/fasthash.h"
 #include "Basics/JsonHelper.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/json.h"
 #include "Basics/tri-strings.h"
 #include "Basics/Exceptions.h"
@@ -193,6 +195,7 @@ Query::Query (triagens::arango::ApplicationV8* applicationV8,
     _collections(vocbase),
     _strings(),
     _shortStringStorage(1024),
+    _jsonArena(128),
     _ast(nullptr),
     _profile(nullptr),
     _state(INVALID_STATE),
@@ -200,16 +203,20 @@ Query::Query (triagens::arango::ApplicationV8* applicationV8,
     _parser(nullptr),
     _trx(nullptr),
     _engine(nullptr),
+    _resourceMonitor(),
     _maxWarningCount(10),
     _warnings(),
     _part(part),
     _contextOwnedByExterior(contextOwnedByExterior),
     _killed(false),
-    _isModificationQuery(false) {
+    _isModificationQuery(false),
+    _isCacheable(false) {
 
   // std::cout << TRI_CurrentThreadId() << ", QUERY " << this << " CTOR: " << queryString << "\n";
 
   TRI_ASSERT(_vocbase != nullptr);
+
+  _resourceMonitor.setMemoryLimit(memoryLimit());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -235,6 +242,7 @@ Query::Query (triagens::arango::ApplicationV8* applicationV8,
     _collections(vocbase),
     _strings(),
     _shortStringStorage(1024),
+    _jsonArena(128),
     _ast(nullptr),
     _profile(nullptr),
     _state(INVALID_STATE),
@@ -242,16 +250,20 @@ Query::Query (triagens::arango::ApplicationV8* applicationV8,
     _parser(nullptr),
     _trx(nullptr),
     _engine(nullptr),
+    _resourceMonitor(),
     _maxWarningCount(10),
     _warnings(),
     _part(part),
     _contextOwnedByExterior(contextOwnedByExterior),
     _killed(false),
-    _isModificationQuery(false) {
+    _isModificationQuery(false),
+    _isCacheable(false) {
 
   // std::cout << TRI_CurrentThreadId() << ", QUERY " << this << " CTOR (JSON): " << _queryJson.toString() << "\n";
 
   TRI_ASSERT(_vocbase != nullptr);
+
+  _resourceMonitor.setMemoryLimit(memoryLimit());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -479,6 +491,8 @@ void Query::registerWarning (int code,
 
   TRI_ASSERT(code != TRI_ERROR_NO_ERROR);
 
+  MUTEX_LOCKER(_warningsLock);
+
   if (_warnings.size() > _maxWarningCount) {
     return;
   }
@@ -505,21 +519,39 @@ QueryResult Query::prepare (QueryRegistry* registry) {
 
     std::unique_ptr<Parser> parser(new Parser(this));
     std::unique_ptr<ExecutionPlan> plan;
+    std::shared_ptr<QueryPlanCacheEntry const> cachedPlan;
+    std::string cacheKey;
+    uint64_t cacheGeneration = 0;
+    std::unordered_set<std::string> planParameters;
+
+    if (canUsePlanCache()) {
+      // check the plan cache for an optimized plan of the same query
+      cacheKey = planCacheKey();
+      cachedPlan = QueryPlanCache::instance()->lookup(_vocbase, cacheKey, _bindParameters.json(), cacheGeneration);
+    }
     
-    if (_queryString != nullptr) {
-      parser->parse(false);
-      // put in bind parameters
-      parser->ast()->injectBindParameters(_bindParameters);
+    if (cachedPlan != nullptr) {
+      _isModificationQuery = cachedPlan->_isModificationQuery;
+      _isCacheable = cachedPlan->_isCacheable;
     }
+    else {
+      if (_queryString != nullptr) {
+        parser->parse(false);
+        // put in bind parameters. if the plan is going to be cached, value bind
+        // parameters are kept as parameter nodes, so the plan can be reused for
+        // other values
+        parser->ast()->injectBindParameters(_bindParameters, cacheKey.empty() ? nullptr : &planParameters);
+      }
       
-    _isModificationQuery = parser->isModificationQuery();
+      _isModificationQuery = parser->isModificationQuery();
+    }
 
     // create the transaction object, but do not start it yet
     _trx = new triagens::arango::AqlTransaction(createTransactionContext(), _vocbase, _collections.collections(), _part == PART_MAIN);
 
     bool planRegisters;
 
-    if (_queryString != nullptr) {
+    if (_queryString != nullptr && cachedPlan == nullptr) {
       // we have an AST
       int res = _trx->begin();
 
@@ -531,6 +563,7 @@ QueryResult Query::prepare (QueryRegistry* registry) {
       enterState(AST_OPTIMIZATION);
 
       parser->ast()->validateAndOptimize();
+      _isCacheable = parser->ast()->root()->isCacheable();
       // std::cout << "AST: " << triagens::basics::JsonHelper::toString(parser->ast()->toJson(TRI_UNKNOWN_MEM_ZONE, false)) << "\n";
 
       enterState(PLAN_INSTANCIATION);
@@ -549,12 +582,47 @@ QueryResult Query::prepare (QueryRegistry* registry) {
       // Now plan and all derived plans belong to the optimizer
       plan.reset(opt.stealBest()); // Now we own the best one again
       planRegisters = true;
+
+      if (! cacheKey.empty()) {
+        // plan the registers now, so they are part of the cached plan
+        plan->findVarUsage();
+        plan->planRegisters();
+        planRegisters = false;
+
+        auto json = plan->toJson(parser->ast(), TRI_UNKNOWN_MEM_ZONE, true);
+
+        if (hasValueParameters(planParameters)) {
+          // the plan still contains parameter nodes, which cannot be executed.
+          // instanciate it again, now with the bind parameter values
+          std::unique_ptr<Parser> valueParser(new Parser(this));
+          valueParser->ast()->setBindParameterValues(&_bindParameters);
+          valueParser->ast()->variables()->fromJson(json);
+
+          plan.reset(ExecutionPlan::instanciateFromJson(valueParser->ast(), json));
+          parser.reset(valueParser.release());
+        }
+
+        if (_warnings.empty()) {
+          // store the optimized plan including its registers, so the next execution 
+          // of the same query can skip parsing and optimization. queries that produced
+          // warnings are not stored because the warnings would get lost
+          storePlan(cacheKey, json, planParameters, cacheGeneration);
+        }
+      }
     }
-    else {   // no queryString, we are instanciating from _queryJson
+    else {   // no queryString, we are instanciating from _queryJson or from a cached plan
+      triagens::basics::Json const cachedJson(TRI_UNKNOWN_MEM_ZONE, cachedPlan != nullptr ? cachedPlan->_plan : nullptr, triagens::basics::Json::NOFREE);
+      triagens::basics::Json const& planJson = (cachedPlan != nullptr ? cachedJson : _queryJson);
+
       enterState(PLAN_INSTANCIATION);
-      ExecutionPlan::getCollectionsFromJson(parser->ast(), _queryJson);
 
-      parser->ast()->variables()->fromJson(_queryJson);
+      if (cachedPlan != nullptr) {
+        // put in the values of the bind parameters kept in the cached plan
+        parser->ast()->setBindParameterValues(&_bindParameters);
+      }
+      ExecutionPlan::getCollectionsFromJson(parser->ast(), planJson);
+
+      parser->ast()->variables()->fromJson(planJson);
       // creating the plan may have produced some collections
       // we need to add them to the transaction now (otherwise the query will fail)
 
@@ -569,7 +637,7 @@ QueryResult Query::prepare (QueryRegistry* registry) {
       }
 
       // we have an execution plan in JSON format
-      plan.reset(ExecutionPlan::instanciateFromJson(parser->ast(), _queryJson));
+      plan.reset(ExecutionPlan::instanciateFromJson(parser->ast(), planJson));
       if (plan.get() == nullptr) {
         // oops
         return QueryResult(TRI_ERROR_INTERNAL);
@@ -662,13 +730,16 @@ QueryResult Query::execute (QueryRegistry* registry) {
       return res;
     }
 
-    if (useQueryCache && (_isModificationQuery || ! _warnings.empty() || ! _ast->root()->isCacheable())) {
+    if (useQueryCache && (_isModificationQuery || ! _warnings.empty() || ! _isCacheable)) {
       useQueryCache = false;
     }
 
     triagens::basics::Json jsonResult(triagens::basics::Json::Array, 16);
     triagens::basics::Json stats;
 
+    // the result is built in memory, so it counts against the query's limit
+    ResourceUsageScope resultMemory(&_resourceMonitor);
+
     // this is the RegisterId our results can be found in
     auto const resultRegister = _engine->resultRegister();
     
@@ -688,7 +759,9 @@ QueryResult Query::execute (QueryRegistry* registry) {
             auto val = value->getValueReference(i, resultRegister);
 
             if (! val.isEmpty()) {
-              jsonResult.add(val.toJson(_trx, doc, true)); 
+              triagens::basics::Json row(val.toJson(_trx, doc, true));
+              resultMemory.increase(TRI_MemoryUsageJson(row.json()));
+              jsonResult.add(row.steal()); 
             }
           }
           delete value;
@@ -720,7 +793,9 @@ QueryResult Query::execute (QueryRegistry* registry) {
             auto val = value->getValueReference(i, resultRegister);
 
             if (! val.isEmpty()) {
-              jsonResult.add(val.toJson(_trx, doc, true)); 
+              triagens::basics::Json row(val.toJson(_trx, doc, true));
+              resultMemory.increase(TRI_MemoryUsageJson(row.json()));
+              jsonResult.add(row.steal()); 
             }
           }
           delete value;
@@ -733,7 +808,7 @@ QueryResult Query::execute (QueryRegistry* registry) {
       throw;
     }
 
-    stats = _engine->_stats.toJson();
+    stats = executionStats().toJson();
 
     _trx->commit();
     
@@ -804,7 +879,7 @@ QueryResultV8 Query::executeV8 (v8::Isolate* isolate,
       return res;
     }
 
-    if (useQueryCache && (_isModificationQuery || ! _warnings.empty() || ! _ast->root()->isCacheable())) {
+    if (useQueryCache && (_isModificationQuery || ! _warnings.empty() || ! _isCacheable)) {
       useQueryCache = false;
     }
 
@@ -879,7 +954,7 @@ QueryResultV8 Query::executeV8 (v8::Isolate* isolate,
       throw;
     }
 
-    stats = _engine->_stats.toJson();
+    stats = executionStats().toJson();
 
     _trx->commit();
     
@@ -1160,11 +1235,27 @@ void Query::exitContext () {
 
 triagens::basics::Json Query::getStats() {
   if (_engine) {
-    return _engine->_stats.toJson();
+    return executionStats().toJson();
   }
   return ExecutionStats::toJsonStatic();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the execution statistics of the prepared query, including
+/// the peak memory usage of this part of the query
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionStats Query::executionStats () const {
+  TRI_ASSERT(_engine != nullptr);
+
+  // the engine's statistics contain the peak memory usage reported by
+  // remote parts of the query, if any
+  ExecutionStats stats(_engine->_stats);
+  stats.peakMemoryUsage += static_cast<int64_t>(_resourceMonitor.peakMemoryUsage());
+
+  return stats;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief fetch a boolean value from the options
 ////////////////////////////////////////////////////////////////////////////////
@@ -1295,6 +1386,141 @@ bool Query::canUseQueryCache () const {
   return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the plan cache can be used for the query
+////////////////////////////////////////////////////////////////////////////////
+
+bool Query::canUsePlanCache () const {
+  if (_queryString == nullptr || _part != PART_MAIN) {
+    return false;
+  }
+
+  if (! QueryPlanCache::instance()->isActive() || ! getBooleanOption("planCache", true)) {
+    return false;
+  }
+
+  // cannot use plan cache on a coordinator at the moment, because instanciating
+  // the plan distributes its parts to the DB servers
+  return ! triagens::arango::ServerState::instance()->isCoordinator();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the plan cache key for the query, consisting of the query 
+/// string, the names and types of the bind parameters and all options that 
+/// influence the plan. the values of collection bind parameters are part of
+/// the key, too, because they determine the collections used by the plan
+////////////////////////////////////////////////////////////////////////////////
+
+std::string Query::planCacheKey () const {
+  TRI_ASSERT(_queryString != nullptr);
+
+  std::string key(_queryString, _queryLength);
+  key.push_back('\0');
+
+  auto bindParameters = _bindParameters.json();
+
+  if (TRI_IsObjectJson(bindParameters)) {
+    std::vector<std::pair<std::string, TRI_json_t const*>> parameters;
+    size_t const n = TRI_LengthVector(&bindParameters->_value._objects);
+    parameters.reserve(n / 2);
+
+    for (size_t i = 0; i < n; i += 2) {
+      auto name = static_cast<TRI_json_t const*>(TRI_AddressVector(&bindParameters->_value._objects, i));
+      auto value = static_cast<TRI_json_t const*>(TRI_AddressVector(&bindParameters->_value._objects, i + 1));
+
+      if (TRI_IsStringJson(name)) {
+        parameters.emplace_back(std::string(name->_value._string.data, name->_value._string.length - 1), value);
+      }
+    }
+
+    std::sort(parameters.begin(), parameters.end(), [] (std::pair<std::string, TRI_json_t const*> const& lhs,
+                                                        std::pair<std::string, TRI_json_t const*> const& rhs) {
+      return lhs.first < rhs.first;
+    });
+
+    for (auto const& it : parameters) {
+      key.append(it.first);
+      key.push_back(':');
+
+      if (it.first[0] == '@') {
+        // collection parameter
+        key.append(triagens::basics::JsonHelper::toString(it.second));
+      }
+      else {
+        // the plan is independent of the value, so only the type matters
+        key.append(TRI_IsStringJson(it.second) ? "string" : TRI_GetTypeStringJson(it.second));
+      }
+      key.push_back(',');
+    }
+  }
+  key.push_back('\0');
+
+  if (getBooleanOption("fullCount", false)) {
+    key.append("fullCount:true");
+  }
+  key.append("maxNumberOfPlans:");
+  key.append(std::to_string(maxNumberOfPlans()));
+
+  if (TRI_IsObjectJson(_options)) {
+    auto optimizer = TRI_LookupObjectJson(_options, "optimizer");
+
+    if (optimizer != nullptr) {
+      key.append("optimizer:");
+      key.append(triagens::basics::JsonHelper::toString(optimizer));
+    }
+  }
+
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query has value bind parameters that were not
+/// injected into the plan
+////////////////////////////////////////////////////////////////////////////////
+
+bool Query::hasValueParameters (std::unordered_set<std::string> const& planParameters) {
+  size_t n = 0;
+
+  for (auto const& it : _bindParameters()) {
+    if (it.first[0] != '@') {
+      ++n;
+    }
+  }
+
+  return (n > planParameters.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store an optimized plan in the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+void Query::storePlan (std::string const& cacheKey,
+                       triagens::basics::Json& plan,
+                       std::unordered_set<std::string> const& planParameters,
+                       uint64_t cacheGeneration) {
+  try {
+    // the values of the bind parameters that were injected into the plan
+    triagens::basics::Json values(triagens::basics::Json::Object, planParameters.size());
+
+    for (auto const& name : planParameters) {
+      auto value = TRI_LookupObjectJson(_bindParameters.json(), name.c_str());
+
+      if (value != nullptr) {
+        values.set(name, triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value)));
+      }
+    }
+
+    auto entry = std::make_shared<QueryPlanCacheEntry const>(cacheKey, plan.json(), values.json(), _trx->collectionNames(), _isModificationQuery, _isCacheable);
+    plan.steal();
+    values.steal();
+
+    QueryPlanCache::instance()->store(_vocbase, entry, cacheGeneration);
+  }
+  catch (...) {
+    // storing the plan is not essential for the query
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief fetch a numeric value from the options
 ////////////////////////////////////////////////////////////////////////////////
@@ -32,9 +32,13 @@
 
 #include "Basics/Common.h"
 #include "Basics/JsonHelper.h"
+#include "Basics/Mutex.h"
 #include "Aql/BindParameters.h"
 #include "Aql/Collections.h"
+#include "Aql/ExecutionStats.h"
+#include "Aql/JsonArena.h"
 #include "Aql/QueryResultV8.h"
+#include "Aql/ResourceUsage.h"
 #include "Aql/ShortStringStorage.h"
 #include "Aql/types.h"
 #include "Utils/AqlTransaction.h"
@@ -309,6 +313,46 @@ namespace triagens {
           return -1;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of bytes a SORT may buffer before it writes sorted
+/// runs to temporary files. 0 means SORT is always performed in memory
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t sortMemoryLimit () const { 
+          double value = getNumericOption("sortMemoryLimit", 0.0);
+          if (value > 0) {
+            return static_cast<size_t>(value);
+          }
+          return 0;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of bytes the query may use. 0 means the memory
+/// usage of the query is tracked but not limited
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t memoryLimit () const { 
+          double value = getNumericOption("memoryLimit", 0.0);
+          if (value > 0) {
+            return static_cast<size_t>(value);
+          }
+          return 0;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of threads a full collection scan may use for
+/// evaluating its directly following filter conditions. 1 means collection
+/// scans are performed sequentially
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t maxParallelism () const { 
+          double value = getNumericOption("maxParallelism", 1.0);
+          if (value > 1) {
+            return static_cast<size_t>(value);
+          }
+          return 1;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extract a region from the query
 ////////////////////////////////////////////////////////////////////////////////
@@ -412,6 +456,30 @@ namespace triagens {
           _engine = engine;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the arena for the JSON values created by the query
+////////////////////////////////////////////////////////////////////////////////
+
+        JsonArena* jsonArena () {
+          return &_jsonArena;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the resource monitor that tracks the query's memory usage
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceMonitor* resourceMonitor () {
+          return &_resourceMonitor;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the resource monitor that tracks the query's memory usage
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceMonitor const* resourceMonitor () const {
+          return &_resourceMonitor;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the transaction, if prepared
 ////////////////////////////////////////////////////////////////////////////////
@@ -460,6 +528,13 @@ namespace triagens {
 
         triagens::basics::Json getStats();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the execution statistics of the prepared query, including
+/// the peak memory usage of this part of the query
+////////////////////////////////////////////////////////////////////////////////
+
+        ExecutionStats executionStats () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief fetch a boolean value from the options
 ////////////////////////////////////////////////////////////////////////////////
@@ -513,6 +588,36 @@ namespace triagens {
 
         bool canUseQueryCache () const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the plan cache can be used for the query
+////////////////////////////////////////////////////////////////////////////////
+
+        bool canUsePlanCache () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the plan cache key for the query, consisting of the query 
+/// string, the names and types of the bind parameters and all options that 
+/// influence the plan
+////////////////////////////////////////////////////////////////////////////////
+
+        std::string planCacheKey () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query has value bind parameters that were not
+/// injected into the plan
+////////////////////////////////////////////////////////////////////////////////
+
+        bool hasValueParameters (std::unordered_set<std::string> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store an optimized plan in the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        void storePlan (std::string const&,
+                        triagens::basics::Json&,
+                        std::unordered_set<std::string> const&,
+                        uint64_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief fetch a numeric value from the options
 ////////////////////////////////////////////////////////////////////////////////
@@ -652,6 +757,12 @@ namespace triagens {
 
         ShortStringStorage                _shortStringStorage;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief arena for the JSON values created while executing the query
+////////////////////////////////////////////////////////////////////////////////
+
+        JsonArena                         _jsonArena;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief _ast, we need an ast to manage the memory for AstNodes, even
 /// if we do not have a parser, because AstNodes occur in plans and engines
@@ -697,6 +808,13 @@ namespace triagens {
 
         ExecutionEngine*                  _engine;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief memory accounting for the query, the engine's blocks charge their
+/// memory to it
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceMonitor                   _resourceMonitor;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief maximum number of warnings
 ////////////////////////////////////////////////////////////////////////////////
@@ -709,6 +827,13 @@ namespace triagens {
 
         std::vector<std::pair<int, std::string>> _warnings;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock protecting the warnings, which may be registered by multiple
+/// threads of a parallel collection scan
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Mutex           _warningsLock;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the query part
 ////////////////////////////////////////////////////////////////////////////////
@@ -733,6 +858,12 @@ namespace triagens {
 
         bool                              _isModificationQuery;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query result may be stored in the query cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool                              _isCacheable;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not query tracking is disabled globally
 ////////////////////////////////////////////////////////////////////////////////
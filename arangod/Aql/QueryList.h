@@ -61,12 +61,14 @@ namespace triagens {
       QueryEntryCopy (TRI_voc_tick_t,
                       std::string const&,
                       double,
-                      double);
+                      double,
+                      size_t);
 
       TRI_voc_tick_t  id;
       std::string     queryString;
       double          started;
       double          runTime;
+      size_t          peakMemoryUsage;
     };
 
 // -----------------------------------------------------------------------------
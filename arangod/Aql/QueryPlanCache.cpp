@@ -0,0 +1,398 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, query plan cache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/QueryPlanCache.h"
+#include "Basics/json.h"
+#include "Basics/json-utilities.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+#include "VocBase/vocbase.h"
+
+using namespace triagens::aql;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief singleton instance of the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+static triagens::aql::QueryPlanCache Instance;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        struct QueryPlanCacheEntry
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a plan cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCacheEntry::QueryPlanCacheEntry (std::string const& key,
+                                          TRI_json_t* plan,
+                                          TRI_json_t* planParameters,
+                                          std::vector<std::string> const& collections,
+                                          bool isModificationQuery,
+                                          bool isCacheable)
+  : _key(key),
+    _plan(plan),
+    _planParameters(planParameters),
+    _collections(collections),
+    _isModificationQuery(isModificationQuery),
+    _isCacheable(isCacheable) {
+
+  TRI_ASSERT(_plan != nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a plan cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCacheEntry::~QueryPlanCacheEntry () {
+  TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _plan);
+
+  if (_planParameters != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _planParameters);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the plan can be used with the bind parameters
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryPlanCacheEntry::matches (TRI_json_t const* bindParameters) const {
+  if (_planParameters == nullptr) {
+    return true;
+  }
+
+  size_t const n = TRI_LengthVector(&_planParameters->_value._objects);
+
+  if (n > 0 && ! TRI_IsObjectJson(bindParameters)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AddressVector(&_planParameters->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(TRI_AddressVector(&_planParameters->_value._objects, i + 1));
+    auto other = TRI_LookupObjectJson(bindParameters, key->_value._string.data);
+
+    if (other == nullptr || ! TRI_CheckSameValueJson(value, other)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              class QueryPlanCache
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCache::QueryPlanCache () 
+  : _lock(),
+    _entries(),
+    _maxPlans(128),
+    _hits(0),
+    _misses(0) {
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCache::~QueryPlanCache () {
+  invalidate();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the plan cache figures
+////////////////////////////////////////////////////////////////////////////////
+
+triagens::basics::Json QueryPlanCache::statistics () {
+  size_t plans = 0;
+
+  {
+    READ_LOCKER(_lock);
+
+    for (auto const& it : _entries) {
+      plans += it.second._entries.size();
+    }
+  }
+
+  triagens::basics::Json json(triagens::basics::Json::Object, 4);
+  json("maxPlans", triagens::basics::Json(static_cast<double>(maxPlans())));
+  json("plans", triagens::basics::Json(static_cast<double>(plans)));
+  json("hits", triagens::basics::Json(static_cast<double>(_hits.load())));
+  json("misses", triagens::basics::Json(static_cast<double>(_misses.load())));
+
+  return json;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the maximum number of plans per database
+////////////////////////////////////////////////////////////////////////////////
+
+size_t QueryPlanCache::maxPlans () const {
+  return _maxPlans.load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum number of plans per database
+/// a value of 0 turns the plan cache off
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::setMaxPlans (size_t value) {
+  WRITE_LOCKER(_lock);
+
+  _maxPlans.store(value, std::memory_order_release);
+
+  for (auto& it : _entries) {
+    auto& database = it.second;
+
+    while (database._list.size() > value) {
+      database._entries.erase(database._list.front()->_key);
+      database._list.pop_front();
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not plans may be stored in the cache
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryPlanCache::isActive () const {
+  return (maxPlans() > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lookup an execution plan in the cache
+/// returns a nullptr if there is no plan for the key and bind parameters.
+/// the generation of the database's plans is returned in the last parameter
+/// and must be passed to store() later
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<QueryPlanCacheEntry const> QueryPlanCache::lookup (TRI_vocbase_t* vocbase,
+                                                                   std::string const& key,
+                                                                   TRI_json_t const* bindParameters,
+                                                                   uint64_t& generation) {
+  {
+    // a hit moves the plan to the end of the list, so we need the write lock
+    WRITE_LOCKER(_lock);
+
+    auto& database = _entries[vocbase];
+    generation = database._generation;
+
+    auto it = database._entries.find(key);
+
+    if (it != database._entries.end() &&
+        (*((*it).second))->matches(bindParameters)) {
+      // the plan is now the most recently used one
+      database._list.splice(database._list.end(), database._list, (*it).second);
+      ++_hits;
+      return database._list.back();
+    }
+  }
+
+  ++_misses;
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store an execution plan in the cache
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::store (TRI_vocbase_t* vocbase,
+                            std::shared_ptr<QueryPlanCacheEntry const> entry,
+                            uint64_t generation) {
+  TRI_ASSERT(entry != nullptr);
+
+  WRITE_LOCKER(_lock);
+
+  size_t const max = maxPlans();
+
+  if (max == 0) {
+    return;
+  }
+
+  auto& database = _entries[vocbase];
+
+  if (database._generation != generation) {
+    // an index or collection was changed while the plan was built
+    return;
+  }
+  auto it = database._entries.find(entry->_key);
+
+  if (it != database._entries.end()) {
+    // another thread has stored a plan for the same query meanwhile
+    database._list.erase((*it).second);
+    database._entries.erase(it);
+  }
+
+  while (database._list.size() >= max) {
+    // remove the least recently used plan
+    database._entries.erase(database._list.front()->_key);
+    database._list.pop_front();
+  }
+
+  database._list.emplace_back(entry);
+  database._entries.emplace(entry->_key, --database._list.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans for the given collections
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::invalidate (TRI_vocbase_t* vocbase,
+                                 std::vector<char const*> const& collections) {
+  WRITE_LOCKER(_lock);
+
+  auto it = _entries.find(vocbase);
+
+  if (it == _entries.end()) {
+    // no plan was ever looked up for the database
+    return;
+  }
+
+  for (auto const& collection : collections) {
+    invalidate((*it).second, collection);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans for a particular collection
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::invalidate (TRI_vocbase_t* vocbase,
+                                 char const* collection) {
+  WRITE_LOCKER(_lock);
+
+  auto it = _entries.find(vocbase);
+
+  if (it == _entries.end()) {
+    // no plan was ever looked up for the database
+    return;
+  }
+
+  invalidate((*it).second, collection);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans for a particular database
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::invalidate (TRI_vocbase_t* vocbase) {
+  WRITE_LOCKER(_lock);
+
+  auto it = _entries.find(vocbase);
+
+  if (it == _entries.end()) {
+    // no plan was ever looked up for the database
+    return;
+  }
+
+  // keep the database entry so plans built meanwhile are not stored
+  (*it).second._entries.clear();
+  (*it).second._list.clear();
+  ++(*it).second._generation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::invalidate () {
+  WRITE_LOCKER(_lock);
+
+  for (auto& it : _entries) {
+    it.second._entries.clear();
+    it.second._list.clear();
+    ++it.second._generation;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the plan cache instance
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCache* QueryPlanCache::instance () {
+  return &Instance;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans that use the collection from the database entry
+/// note that the caller of this method must hold the write lock
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::invalidate (DatabaseEntry& database,
+                                 char const* collection) {
+  // plans for the collection that are currently being built must not be
+  // stored either
+  ++database._generation;
+
+  auto it = database._list.begin();
+
+  while (it != database._list.end()) {
+    auto const& names = (*it)->_collections;
+
+    if (std::find(names.begin(), names.end(), collection) != names.end()) {
+      database._entries.erase((*it)->_key);
+      it = database._list.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
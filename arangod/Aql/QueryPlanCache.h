@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, query plan cache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_QUERY_PLAN_CACHE_H
+#define ARANGODB_AQL_QUERY_PLAN_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/JsonHelper.h"
+#include "Basics/ReadWriteLock.h"
+
+struct TRI_json_t;
+struct TRI_vocbase_s;
+
+namespace triagens {
+  namespace aql {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        struct QueryPlanCacheEntry
+// -----------------------------------------------------------------------------
+
+    struct QueryPlanCacheEntry {
+      QueryPlanCacheEntry () = delete;
+      QueryPlanCacheEntry (QueryPlanCacheEntry const&) = delete;
+      QueryPlanCacheEntry& operator= (QueryPlanCacheEntry const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a plan cache entry
+/// the entry takes over ownership of the plan and the plan parameters
+////////////////////////////////////////////////////////////////////////////////
+
+      QueryPlanCacheEntry (std::string const&,
+                           struct TRI_json_t*,
+                           struct TRI_json_t*,
+                           std::vector<std::string> const&,
+                           bool,
+                           bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a plan cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+      ~QueryPlanCacheEntry ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the plan can be used with the bind parameters
+////////////////////////////////////////////////////////////////////////////////
+
+      bool matches (struct TRI_json_t const*) const;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  member variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cache key (query string, bind parameter names and types and
+/// planning options)
+////////////////////////////////////////////////////////////////////////////////
+
+      std::string const               _key;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the optimized execution plan, including its register plan, in the
+/// same JSON format that is sent to DB servers in a cluster
+////////////////////////////////////////////////////////////////////////////////
+
+      struct TRI_json_t*              _plan;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bind parameters whose values were injected when building the plan,
+/// e.g. LIMIT values or attribute names. all other bind parameters are kept
+/// as parameter nodes in the plan and get their values when the plan is
+/// instanciated
+////////////////////////////////////////////////////////////////////////////////
+
+      struct TRI_json_t*              _planParameters;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief names of the collections used by the plan
+////////////////////////////////////////////////////////////////////////////////
+
+      std::vector<std::string> const  _collections;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query modifies data
+////////////////////////////////////////////////////////////////////////////////
+
+      bool const                      _isModificationQuery;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query result may be stored in the query cache
+////////////////////////////////////////////////////////////////////////////////
+
+      bool const                      _isCacheable;
+
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              class QueryPlanCache
+// -----------------------------------------------------------------------------
+
+    class QueryPlanCache {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        QueryPlanCache (QueryPlanCache const&) = delete;
+        QueryPlanCache& operator= (QueryPlanCache const&) = delete;
+      
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        QueryPlanCache ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        ~QueryPlanCache ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the plan cache figures
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Json statistics ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the maximum number of plans per database
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t maxPlans () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum number of plans per database
+/// a value of 0 turns the plan cache off
+////////////////////////////////////////////////////////////////////////////////
+
+        void setMaxPlans (size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not plans may be stored in the cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool isActive () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lookup an execution plan in the cache
+/// returns a nullptr if there is no plan for the key and bind parameters.
+/// the generation of the database's plans is returned in the last parameter
+/// and must be passed to store() later
+////////////////////////////////////////////////////////////////////////////////
+
+        std::shared_ptr<QueryPlanCacheEntry const> lookup (struct TRI_vocbase_s*,
+                                                           std::string const&,
+                                                           struct TRI_json_t const*,
+                                                           uint64_t&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store an execution plan in the cache
+/// the plan is not stored if the database's plans were invalidated since
+/// the generation was fetched, because the plan may already be outdated
+////////////////////////////////////////////////////////////////////////////////
+
+        void store (struct TRI_vocbase_s*,
+                    std::shared_ptr<QueryPlanCacheEntry const>,
+                    uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans for the given collections
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate (struct TRI_vocbase_s*,
+                         std::vector<char const*> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans for a particular collection
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate (struct TRI_vocbase_s*,
+                         char const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans for a particular database
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate (struct TRI_vocbase_s*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the pointer to the global plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        static QueryPlanCache* instance ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+        typedef std::list<std::shared_ptr<QueryPlanCacheEntry const>> EntryList;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief plans of a single database, least recently used first. the
+/// generation is increased whenever plans of the database are invalidated
+////////////////////////////////////////////////////////////////////////////////
+
+        struct DatabaseEntry {
+          DatabaseEntry ()
+            : _list(),
+              _entries(),
+              _generation(0) {
+          }
+
+          EntryList                                              _list;
+          std::unordered_map<std::string, EntryList::iterator>   _entries;
+          uint64_t                                               _generation;
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans that use the collection from the database entry
+/// note that the caller of this method must hold the write lock
+////////////////////////////////////////////////////////////////////////////////
+
+        static void invalidate (DatabaseEntry&,
+                                char const*);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read-write lock for the cache
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::ReadWriteLock _lock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cached plans, organized per database
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<struct TRI_vocbase_s*, DatabaseEntry> _entries;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of plans per database
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _maxPlans;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of lookups that found a plan
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _hits;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of lookups that did not find a plan
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _misses;
+
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, memory accounting for a single query
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/ResourceUsage.h"
+#include "Basics/Exceptions.h"
+
+using namespace triagens::aql;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a monitor without a limit
+////////////////////////////////////////////////////////////////////////////////
+
+ResourceMonitor::ResourceMonitor () 
+  : _memoryLimit(0),
+    _currentMemoryUsage(0),
+    _peakMemoryUsage(0) {
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the monitor
+////////////////////////////////////////////////////////////////////////////////
+
+ResourceMonitor::~ResourceMonitor () {
+  // everything charged must have been released by now
+  TRI_ASSERT(_currentMemoryUsage.load() == 0);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief charge memory to the query, throws if this exceeds the limit.
+/// nothing is charged in this case
+////////////////////////////////////////////////////////////////////////////////
+
+void ResourceMonitor::increaseMemoryUsage (size_t value) {
+  size_t const now = _currentMemoryUsage.fetch_add(value, std::memory_order_relaxed) + value;
+
+  if (_memoryLimit > 0 && now > _memoryLimit) {
+    _currentMemoryUsage.fetch_sub(value, std::memory_order_relaxed);
+
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT, 
+                                   std::string("query would use more memory than allowed (limit: ") + 
+                                   std::to_string(_memoryLimit) + 
+                                   " bytes)");
+  }
+
+  size_t peak = _peakMemoryUsage.load(std::memory_order_relaxed);
+
+  while (now > peak && 
+         ! _peakMemoryUsage.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    // peak is updated by compare_exchange_weak on failure
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release memory previously charged to the query
+////////////////////////////////////////////////////////////////////////////////
+
+void ResourceMonitor::decreaseMemoryUsage (size_t value) {
+  TRI_ASSERT(_currentMemoryUsage.load(std::memory_order_relaxed) >= value);
+  _currentMemoryUsage.fetch_sub(value, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, memory accounting for a single query
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_RESOURCE_USAGE_H
+#define ARANGODB_AQL_RESOURCE_USAGE_H 1
+
+#include "Basics/Common.h"
+
+namespace triagens {
+  namespace aql {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                             class ResourceMonitor
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tracks the memory used by a query
+///
+/// Every query owns one monitor. AqlItemBlocks charge their registers and
+/// the values they are responsible for to it, and the blocks that buffer
+/// large amounts of data (SORT, hashed COLLECT, subqueries) charge what they
+/// keep around. Charging more than the configured limit fails with
+/// TRI_ERROR_RESOURCE_LIMIT, so a runaway query is aborted before it can
+/// exhaust the server's memory.
+///
+/// The counters are atomic because the list of running queries reads them
+/// from other threads.
+////////////////////////////////////////////////////////////////////////////////
+
+    class ResourceMonitor {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        ResourceMonitor (ResourceMonitor const&) = delete;
+        ResourceMonitor& operator= (ResourceMonitor const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a monitor without a limit
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceMonitor ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the monitor
+////////////////////////////////////////////////////////////////////////////////
+
+        ~ResourceMonitor ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum number of bytes the query may use. 0 means there
+/// is no limit
+////////////////////////////////////////////////////////////////////////////////
+
+        void setMemoryLimit (size_t value) {
+          _memoryLimit = value;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the maximum number of bytes the query may use
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t memoryLimit () const {
+          return _memoryLimit;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of bytes currently charged
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t currentMemoryUsage () const {
+          return _currentMemoryUsage.load(std::memory_order_relaxed);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the highest number of bytes charged at the same time
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t peakMemoryUsage () const {
+          return _peakMemoryUsage.load(std::memory_order_relaxed);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief charge memory to the query, throws if this exceeds the limit.
+/// nothing is charged in this case
+////////////////////////////////////////////////////////////////////////////////
+
+        void increaseMemoryUsage (size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release memory previously charged to the query
+////////////////////////////////////////////////////////////////////////////////
+
+        void decreaseMemoryUsage (size_t);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of bytes, 0 means unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _memoryLimit;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of bytes currently charged
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _currentMemoryUsage;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief highest value _currentMemoryUsage has had
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _peakMemoryUsage;
+
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          class ResourceUsageScope
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief charges memory to a resource monitor and releases everything it
+/// has charged when it goes out of scope. used for data a query keeps
+/// outside of AqlItemBlocks
+////////////////////////////////////////////////////////////////////////////////
+
+    class ResourceUsageScope {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        ResourceUsageScope (ResourceUsageScope const&) = delete;
+        ResourceUsageScope& operator= (ResourceUsageScope const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the scope, the monitor may be a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+        explicit ResourceUsageScope (ResourceMonitor* resourceMonitor) 
+          : _resourceMonitor(resourceMonitor),
+            _memoryUsage(0) {
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the scope, releasing all memory still charged
+////////////////////////////////////////////////////////////////////////////////
+
+        ~ResourceUsageScope () {
+          release();
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of bytes currently charged by the scope
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t memoryUsage () const {
+          return _memoryUsage;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief charge memory, throws if this exceeds the query's limit
+////////////////////////////////////////////////////////////////////////////////
+
+        void increase (size_t value) {
+          if (_resourceMonitor != nullptr && value > 0) {
+            _resourceMonitor->increaseMemoryUsage(value);
+            _memoryUsage += value;
+          }
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release part of the memory charged by the scope
+////////////////////////////////////////////////////////////////////////////////
+
+        void decrease (size_t value) {
+          if (value > _memoryUsage) {
+            value = _memoryUsage;
+          }
+          if (value > 0) {
+            _resourceMonitor->decreaseMemoryUsage(value);
+            _memoryUsage -= value;
+          }
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release all memory charged by the scope
+////////////////////////////////////////////////////////////////////////////////
+
+        void release () {
+          decrease(_memoryUsage);
+        }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the monitor memory is charged to
+////////////////////////////////////////////////////////////////////////////////
+
+        ResourceMonitor* _resourceMonitor;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of bytes charged by the scope
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _memoryUsage;
+
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestAqlHandler.h"
+#include "Aql/BinaryBlockFormat.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionBlock.h"
 #include "Basics/ConditionLocker.h"
@@ -346,7 +347,9 @@ void RestAqlHandler::createQueryFromString () {
 ///             left. However, the implementation may return fewer items
 ///             than "atLeast" for internal reasons, for example to avoid
 ///             excessive copying. The result is the JSON representation of an 
-///             AqlItemBlock.
+///             AqlItemBlock. If the request carries the header
+///             "x-arango-aql-format: binary", the result is sent in the
+///             binary format described in BinaryBlockFormat.h instead.
 ///             If "atLeast" is not given it defaults to 1, if "atMost" is not
 ///             given it defaults to ExecutionBlock::DefaultBatchSize.
 /// For the "skipSome" operation one has to give:
@@ -736,6 +739,26 @@ void RestAqlHandler::handleUseQuery (std::string const& operation,
       }
       items.reset(block->getSomeForShard(atLeast, atMost, shardId));
     }
+    char const* format = _request->header(BinaryBlockFormat::FormatHeader, found);
+
+    if (found && BinaryBlockFormat::isRequested(format)) {
+      // the caller can read the binary format, which is much cheaper to
+      // produce and to parse than JSON
+      try {
+        _response = createResponse(triagens::rest::HttpResponse::OK);
+        _response->setContentType(BinaryBlockFormat::ContentType);
+        BinaryBlockFormat::encodeGetSome(_response->body(), query->trx(), items.get(), query->executionStats());
+      }
+      catch (...) {
+        delete _response;
+        _response = nullptr;
+        LOG_ERROR("cannot transform AqlItemBlock to binary format");
+        generateError(HttpResponse::SERVER_ERROR, TRI_ERROR_HTTP_SERVER_ERROR,
+                      "cannot transform AqlItemBlock to binary format");
+      }
+      return;
+    }
+
     if (items.get() == nullptr) {
       answerBody("exhausted", Json(true))
         ("error", Json(false))
@@ -820,7 +843,7 @@ void RestAqlHandler::handleUseQuery (std::string const& operation,
         res = query->engine()->initializeCursor(nullptr, 0);
       }
       else {
-        items.reset(new AqlItemBlock(queryJson.get("items")));
+        items.reset(new AqlItemBlock(query->resourceMonitor(), queryJson.get("items")));
         res = query->engine()->initializeCursor(items.get(), pos);
       }
     }
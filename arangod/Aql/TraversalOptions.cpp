@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, options for graph traversals
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/TraversalOptions.h"
+#include "Basics/Exceptions.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+using JsonHelper = triagens::basics::JsonHelper;
+      
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor, using JSON
+////////////////////////////////////////////////////////////////////////////////
+
+TraversalOptions::TraversalOptions (Json const& json) {
+  Json obj = json.get("traversalOptions");
+
+  minDepth = JsonHelper::checkAndGetNumericValue<uint64_t>(obj.json(), "minDepth");
+  maxDepth = JsonHelper::checkAndGetNumericValue<uint64_t>(obj.json(), "maxDepth");
+  uniqueVertices = uniquenessFromString(JsonHelper::checkAndGetStringValue(obj.json(), "uniqueVertices"));
+  uniqueEdges = uniquenessFromString(JsonHelper::checkAndGetStringValue(obj.json(), "uniqueEdges"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the options to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalOptions::toJson (triagens::basics::Json& json,
+                               TRI_memory_zone_t* zone) const {
+  Json options;
+
+  options = Json(Json::Object, 4)
+    ("minDepth", Json(static_cast<double>(minDepth)))
+    ("maxDepth", Json(static_cast<double>(maxDepth)))
+    ("uniqueVertices", Json(uniquenessToString(uniqueVertices)))
+    ("uniqueEdges", Json(uniquenessToString(uniqueEdges)));
+
+  json("traversalOptions", options);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the uniqueness level from a string
+////////////////////////////////////////////////////////////////////////////////
+          
+TraversalOptions::UniquenessLevel TraversalOptions::uniquenessFromString (std::string const& value) {
+  if (value == "none") {
+    return UniquenessLevel::UNIQUENESS_NONE;
+  }
+  if (value == "path") {
+    return UniquenessLevel::UNIQUENESS_PATH;
+  }
+  if (value == "global") {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, "uniqueness value 'global' is not supported for depth-first traversals, expecting 'none' or 'path'");
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, "invalid uniqueness value '" + value + "', expecting 'none' or 'path'");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify the uniqueness level
+////////////////////////////////////////////////////////////////////////////////
+          
+std::string TraversalOptions::uniquenessToString (TraversalOptions::UniquenessLevel value) {
+  if (value == UniquenessLevel::UNIQUENESS_NONE) {
+    return std::string("none");
+  }
+  if (value == UniquenessLevel::UNIQUENESS_PATH) {
+    return std::string("path");
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "cannot stringify unknown uniqueness level");
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief AQL, options for graph traversals
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_TRAVERSAL_OPTIONS_H
+#define ARANGODB_AQL_TRAVERSAL_OPTIONS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/JsonHelper.h"
+
+namespace triagens {
+  namespace aql {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief TraversalOptions
+////////////////////////////////////////////////////////////////////////////////
+
+    struct TraversalOptions {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      public types
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uniqueness level for vertices or edges
+/// - none: vertices or edges may be visited multiple times
+/// - path: a vertex or edge is visited at most once per path
+/// there is no global uniqueness, because the traversal is depth-first: a
+/// vertex first visited at a high depth would not be expanded again when it
+/// is reached at a lower depth later, so vertices within the depth range
+/// would be missing from the result
+////////////////////////////////////////////////////////////////////////////////
+        
+      enum UniquenessLevel {
+        UNIQUENESS_NONE,
+        UNIQUENESS_PATH
+      };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+        
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor, using default values
+////////////////////////////////////////////////////////////////////////////////
+
+      TraversalOptions ()
+        : minDepth(1),
+          maxDepth(1),
+          uniqueVertices(UNIQUENESS_NONE),
+          uniqueEdges(UNIQUENESS_PATH) {
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor, using JSON
+////////////////////////////////////////////////////////////////////////////////
+      
+      TraversalOptions (triagens::basics::Json const&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the options to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+      void toJson (triagens::basics::Json&, 
+                   TRI_memory_zone_t*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the uniqueness level from a string
+////////////////////////////////////////////////////////////////////////////////
+          
+      static UniquenessLevel uniquenessFromString (std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify the uniqueness level
+////////////////////////////////////////////////////////////////////////////////
+          
+      static std::string uniquenessToString (UniquenessLevel);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public variables
+// -----------------------------------------------------------------------------
+
+      uint64_t        minDepth;
+      uint64_t        maxDepth;
+      UniquenessLevel uniqueVertices;
+      UniquenessLevel uniqueEdges;
+
+    };
+
+  }  // namespace triagens::aql
+}  // namespace triagens
+
+#endif
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
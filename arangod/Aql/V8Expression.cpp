@@ -30,6 +30,7 @@
 #include "Aql/V8Expression.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/Executor.h"
+#include "Aql/JsonArena.h"
 #include "Aql/Query.h"
 #include "Aql/Variable.h"
 #include "Basics/json.h"
@@ -79,6 +80,7 @@ V8Expression::~V8Expression () {
 
 AqlValue V8Expression::execute (v8::Isolate* isolate,
                                 Query* query,
+                                JsonArena* jsonArena,
                                 triagens::arango::AqlTransaction* trx,
                                 AqlItemBlock const* argv,
                                 size_t startPos,
@@ -185,29 +187,35 @@ AqlValue V8Expression::execute (v8::Isolate* isolate,
   }
 
   // no exception was thrown if we get here
+  if (result->IsUndefined() || result->IsNull()) {
+    // expression does not have any (defined) value. replace with null
+    return jsonArena->createNull();
+  }
+
+  // scalar results are stored in the arena directly without conversion
+  if (result->IsNumber()) {
+    return jsonArena->createNumber(result->ToNumber()->Value());
+  }
+  
+  if (result->IsBoolean()) {
+    return jsonArena->createBoolean(result->ToBoolean()->Value());
+  }
+
+  // expression had a result. convert it to JSON
   std::unique_ptr<TRI_json_t> json;
 
-  if (result->IsUndefined()) {
-    // expression does not have any (defined) value. replace with null
-    json.reset(TRI_CreateNullJson(TRI_UNKNOWN_MEM_ZONE));
+  if (_isSimple) { 
+    json.reset(TRI_ObjectToJsonSimple(isolate, result));
   }
   else {
-    // expression had a result. convert it to JSON
-    if (_isSimple) { 
-      json.reset(TRI_ObjectToJsonSimple(isolate, result));
-    }
-    else {
-      json.reset(TRI_ObjectToJson(isolate, result));
-    }
+    json.reset(TRI_ObjectToJson(isolate, result));
   }
 
   if (json.get() == nullptr) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
 
-  auto j = new triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, json.get());
-  json.release();
-  return AqlValue(j);
+  return jsonArena->createOwned(json.release());
 }
 
 // -----------------------------------------------------------------------------
@@ -39,6 +39,7 @@ namespace triagens {
   namespace aql {
 
     class AqlItemBlock;
+    class JsonArena;
     class Query;
     struct Variable;
 
@@ -89,6 +90,7 @@ namespace triagens {
 
       AqlValue execute (v8::Isolate* isolate,
                         Query* query,
+                        JsonArena*,
                         triagens::arango::AqlTransaction*,
                         AqlItemBlock const*,
                         size_t,
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,9 +71,8 @@
 #define yydebug         Aqldebug
 #define yynerrs         Aqlnerrs
 
-
-/* Copy the first part of user declarations.  */
-#line 9 "arangod/Aql/grammar.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 9 "arangod/Aql/grammar.y"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -81,143 +85,178 @@
 #include "Aql/Function.h"
 #include "Aql/Parser.h"
 
-#line 85 "arangod/Aql/grammar.cpp" /* yacc.c:339  */
+#line 89 "arangod/Aql/grammar.cpp"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "grammar.hpp".  */
-#ifndef YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED
-# define YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int Aqldebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    T_END = 0,
-    T_FOR = 258,
-    T_LET = 259,
-    T_FILTER = 260,
-    T_RETURN = 261,
-    T_COLLECT = 262,
-    T_SORT = 263,
-    T_LIMIT = 264,
-    T_ASC = 265,
-    T_DESC = 266,
-    T_IN = 267,
-    T_WITH = 268,
-    T_INTO = 269,
-    T_REMOVE = 270,
-    T_INSERT = 271,
-    T_UPDATE = 272,
-    T_REPLACE = 273,
-    T_UPSERT = 274,
-    T_NULL = 275,
-    T_TRUE = 276,
-    T_FALSE = 277,
-    T_STRING = 278,
-    T_QUOTED_STRING = 279,
-    T_INTEGER = 280,
-    T_DOUBLE = 281,
-    T_PARAMETER = 282,
-    T_ASSIGN = 283,
-    T_NOT = 284,
-    T_AND = 285,
-    T_OR = 286,
-    T_EQ = 287,
-    T_NE = 288,
-    T_LT = 289,
-    T_GT = 290,
-    T_LE = 291,
-    T_GE = 292,
-    T_PLUS = 293,
-    T_MINUS = 294,
-    T_TIMES = 295,
-    T_DIV = 296,
-    T_MOD = 297,
-    T_QUESTION = 298,
-    T_COLON = 299,
-    T_SCOPE = 300,
-    T_RANGE = 301,
-    T_COMMA = 302,
-    T_OPEN = 303,
-    T_CLOSE = 304,
-    T_OBJECT_OPEN = 305,
-    T_OBJECT_CLOSE = 306,
-    T_ARRAY_OPEN = 307,
-    T_ARRAY_CLOSE = 308,
-    T_NIN = 309,
-    UMINUS = 310,
-    UPLUS = 311,
-    FUNCCALL = 312,
-    REFERENCE = 313,
-    INDEXED = 314,
-    EXPANSION = 315
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
-union YYSTYPE
-{
-#line 22 "arangod/Aql/grammar.y" /* yacc.c:355  */
-
-  triagens::aql::AstNode*  node;
-  char*                    strval;
-  bool                     boolval;
-  int64_t                  intval;
-
-#line 194 "arangod/Aql/grammar.cpp" /* yacc.c:355  */
-};
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
+#include "grammar.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of query string"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_T_FOR = 3,                      /* "FOR declaration"  */
+  YYSYMBOL_T_LET = 4,                      /* "LET declaration"  */
+  YYSYMBOL_T_FILTER = 5,                   /* "FILTER declaration"  */
+  YYSYMBOL_T_RETURN = 6,                   /* "RETURN declaration"  */
+  YYSYMBOL_T_COLLECT = 7,                  /* "COLLECT declaration"  */
+  YYSYMBOL_T_SORT = 8,                     /* "SORT declaration"  */
+  YYSYMBOL_T_LIMIT = 9,                    /* "LIMIT declaration"  */
+  YYSYMBOL_T_ASC = 10,                     /* "ASC keyword"  */
+  YYSYMBOL_T_DESC = 11,                    /* "DESC keyword"  */
+  YYSYMBOL_T_IN = 12,                      /* "IN keyword"  */
+  YYSYMBOL_T_WITH = 13,                    /* "WITH keyword"  */
+  YYSYMBOL_T_INTO = 14,                    /* "INTO keyword"  */
+  YYSYMBOL_T_REMOVE = 15,                  /* "REMOVE command"  */
+  YYSYMBOL_T_INSERT = 16,                  /* "INSERT command"  */
+  YYSYMBOL_T_UPDATE = 17,                  /* "UPDATE command"  */
+  YYSYMBOL_T_REPLACE = 18,                 /* "REPLACE command"  */
+  YYSYMBOL_T_UPSERT = 19,                  /* "UPSERT command"  */
+  YYSYMBOL_T_NULL = 20,                    /* "null"  */
+  YYSYMBOL_T_TRUE = 21,                    /* "true"  */
+  YYSYMBOL_T_FALSE = 22,                   /* "false"  */
+  YYSYMBOL_T_STRING = 23,                  /* "identifier"  */
+  YYSYMBOL_T_QUOTED_STRING = 24,           /* "quoted string"  */
+  YYSYMBOL_T_INTEGER = 25,                 /* "integer number"  */
+  YYSYMBOL_T_DOUBLE = 26,                  /* "number"  */
+  YYSYMBOL_T_PARAMETER = 27,               /* "bind parameter"  */
+  YYSYMBOL_T_ASSIGN = 28,                  /* "assignment"  */
+  YYSYMBOL_T_NOT = 29,                     /* "not operator"  */
+  YYSYMBOL_T_AND = 30,                     /* "and operator"  */
+  YYSYMBOL_T_OR = 31,                      /* "or operator"  */
+  YYSYMBOL_T_EQ = 32,                      /* "== operator"  */
+  YYSYMBOL_T_NE = 33,                      /* "!= operator"  */
+  YYSYMBOL_T_LT = 34,                      /* "< operator"  */
+  YYSYMBOL_T_GT = 35,                      /* "> operator"  */
+  YYSYMBOL_T_LE = 36,                      /* "<= operator"  */
+  YYSYMBOL_T_GE = 37,                      /* ">= operator"  */
+  YYSYMBOL_T_PLUS = 38,                    /* "+ operator"  */
+  YYSYMBOL_T_MINUS = 39,                   /* "- operator"  */
+  YYSYMBOL_T_TIMES = 40,                   /* "* operator"  */
+  YYSYMBOL_T_DIV = 41,                     /* "/ operator"  */
+  YYSYMBOL_T_MOD = 42,                     /* "% operator"  */
+  YYSYMBOL_T_QUESTION = 43,                /* "?"  */
+  YYSYMBOL_T_COLON = 44,                   /* ":"  */
+  YYSYMBOL_T_SCOPE = 45,                   /* "::"  */
+  YYSYMBOL_T_RANGE = 46,                   /* ".."  */
+  YYSYMBOL_T_COMMA = 47,                   /* ","  */
+  YYSYMBOL_T_OPEN = 48,                    /* "("  */
+  YYSYMBOL_T_CLOSE = 49,                   /* ")"  */
+  YYSYMBOL_T_OBJECT_OPEN = 50,             /* "{"  */
+  YYSYMBOL_T_OBJECT_CLOSE = 51,            /* "}"  */
+  YYSYMBOL_T_ARRAY_OPEN = 52,              /* "["  */
+  YYSYMBOL_T_ARRAY_CLOSE = 53,             /* "]"  */
+  YYSYMBOL_T_NIN = 54,                     /* T_NIN  */
+  YYSYMBOL_UMINUS = 55,                    /* UMINUS  */
+  YYSYMBOL_UPLUS = 56,                     /* UPLUS  */
+  YYSYMBOL_FUNCCALL = 57,                  /* FUNCCALL  */
+  YYSYMBOL_REFERENCE = 58,                 /* REFERENCE  */
+  YYSYMBOL_INDEXED = 59,                   /* INDEXED  */
+  YYSYMBOL_EXPANSION = 60,                 /* EXPANSION  */
+  YYSYMBOL_61_ = 61,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 62,                  /* $accept  */
+  YYSYMBOL_query = 63,                     /* query  */
+  YYSYMBOL_optional_post_modification_lets = 64, /* optional_post_modification_lets  */
+  YYSYMBOL_optional_post_modification_block = 65, /* optional_post_modification_block  */
+  YYSYMBOL_optional_statement_block_statements = 66, /* optional_statement_block_statements  */
+  YYSYMBOL_statement_block_statement = 67, /* statement_block_statement  */
+  YYSYMBOL_for_statement = 68,             /* for_statement  */
+  YYSYMBOL_traversal_graph_info = 69,      /* traversal_graph_info  */
+  YYSYMBOL_traversal_edge_collection = 70, /* traversal_edge_collection  */
+  YYSYMBOL_filter_statement = 71,          /* filter_statement  */
+  YYSYMBOL_let_statement = 72,             /* let_statement  */
+  YYSYMBOL_let_list = 73,                  /* let_list  */
+  YYSYMBOL_let_element = 74,               /* let_element  */
+  YYSYMBOL_count_into = 75,                /* count_into  */
+  YYSYMBOL_collect_variable_list = 76,     /* collect_variable_list  */
+  YYSYMBOL_77_1 = 77,                      /* $@1  */
+  YYSYMBOL_collect_statement = 78,         /* collect_statement  */
+  YYSYMBOL_collect_list = 79,              /* collect_list  */
+  YYSYMBOL_collect_element = 80,           /* collect_element  */
+  YYSYMBOL_optional_into = 81,             /* optional_into  */
+  YYSYMBOL_variable_list = 82,             /* variable_list  */
+  YYSYMBOL_keep = 83,                      /* keep  */
+  YYSYMBOL_84_2 = 84,                      /* $@2  */
+  YYSYMBOL_sort_statement = 85,            /* sort_statement  */
+  YYSYMBOL_86_3 = 86,                      /* $@3  */
+  YYSYMBOL_sort_list = 87,                 /* sort_list  */
+  YYSYMBOL_sort_element = 88,              /* sort_element  */
+  YYSYMBOL_sort_direction = 89,            /* sort_direction  */
+  YYSYMBOL_limit_statement = 90,           /* limit_statement  */
+  YYSYMBOL_return_statement = 91,          /* return_statement  */
+  YYSYMBOL_in_or_into_collection = 92,     /* in_or_into_collection  */
+  YYSYMBOL_remove_statement = 93,          /* remove_statement  */
+  YYSYMBOL_insert_statement = 94,          /* insert_statement  */
+  YYSYMBOL_update_parameters = 95,         /* update_parameters  */
+  YYSYMBOL_update_statement = 96,          /* update_statement  */
+  YYSYMBOL_replace_parameters = 97,        /* replace_parameters  */
+  YYSYMBOL_replace_statement = 98,         /* replace_statement  */
+  YYSYMBOL_update_or_replace = 99,         /* update_or_replace  */
+  YYSYMBOL_upsert_statement = 100,         /* upsert_statement  */
+  YYSYMBOL_101_4 = 101,                    /* $@4  */
+  YYSYMBOL_expression = 102,               /* expression  */
+  YYSYMBOL_function_name = 103,            /* function_name  */
+  YYSYMBOL_function_call = 104,            /* function_call  */
+  YYSYMBOL_105_5 = 105,                    /* $@5  */
+  YYSYMBOL_operator_unary = 106,           /* operator_unary  */
+  YYSYMBOL_operator_binary = 107,          /* operator_binary  */
+  YYSYMBOL_operator_ternary = 108,         /* operator_ternary  */
+  YYSYMBOL_optional_function_call_arguments = 109, /* optional_function_call_arguments  */
+  YYSYMBOL_expression_or_query = 110,      /* expression_or_query  */
+  YYSYMBOL_111_6 = 111,                    /* $@6  */
+  YYSYMBOL_function_arguments_list = 112,  /* function_arguments_list  */
+  YYSYMBOL_compound_value = 113,           /* compound_value  */
+  YYSYMBOL_array = 114,                    /* array  */
+  YYSYMBOL_115_7 = 115,                    /* $@7  */
+  YYSYMBOL_optional_array_elements = 116,  /* optional_array_elements  */
+  YYSYMBOL_array_elements_list = 117,      /* array_elements_list  */
+  YYSYMBOL_options = 118,                  /* options  */
+  YYSYMBOL_object = 119,                   /* object  */
+  YYSYMBOL_120_8 = 120,                    /* $@8  */
+  YYSYMBOL_optional_object_elements = 121, /* optional_object_elements  */
+  YYSYMBOL_object_elements_list = 122,     /* object_elements_list  */
+  YYSYMBOL_object_element = 123,           /* object_element  */
+  YYSYMBOL_array_filter_operator = 124,    /* array_filter_operator  */
+  YYSYMBOL_optional_array_filter = 125,    /* optional_array_filter  */
+  YYSYMBOL_optional_array_limit = 126,     /* optional_array_limit  */
+  YYSYMBOL_optional_array_return = 127,    /* optional_array_return  */
+  YYSYMBOL_reference = 128,                /* reference  */
+  YYSYMBOL_129_9 = 129,                    /* $@9  */
+  YYSYMBOL_130_10 = 130,                   /* $@10  */
+  YYSYMBOL_simple_value = 131,             /* simple_value  */
+  YYSYMBOL_numeric_value = 132,            /* numeric_value  */
+  YYSYMBOL_value_literal = 133,            /* value_literal  */
+  YYSYMBOL_collection_name = 134,          /* collection_name  */
+  YYSYMBOL_bind_parameter = 135,           /* bind_parameter  */
+  YYSYMBOL_object_element_name = 136,      /* object_element_name  */
+  YYSYMBOL_variable_name = 137             /* variable_name  */
 };
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-
-int Aqlparse (triagens::aql::Parser* parser);
-
-#endif /* !YY_AQL_ARANGOD_AQL_GRAMMAR_HPP_INCLUDED  */
-
-/* Copy the second part of user declarations.  */
-#line 29 "arangod/Aql/grammar.y" /* yacc.c:358  */
+/* Second part of user prologue.  */
+#line 29 "arangod/Aql/grammar.y"
 
 
 using namespace triagens::aql;
@@ -251,34 +290,94 @@ void Aqlerror (YYLTYPE* locp,
 #define scanner parser->scanner()
 
 
-#line 255 "arangod/Aql/grammar.cpp" /* yacc.c:358  */
+#line 294 "arangod/Aql/grammar.cpp"
+
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -286,15 +385,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -308,47 +420,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -361,8 +469,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -427,8 +549,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -438,18 +559,19 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -462,11 +584,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -478,12 +600,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -495,28 +617,31 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   784
+#define YYLAST   867
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  62
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  74
+#define YYNNTS  76
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  160
+#define YYNRULES  167
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  274
+#define YYNSTATES  292
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   315
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -553,36 +678,43 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   204,   204,   206,   208,   210,   212,   214,   219,   221,
-     226,   230,   236,   238,   243,   245,   247,   249,   251,   253,
-     258,   267,   275,   280,   282,   287,   294,   304,   304,   318,
-     334,   361,   388,   420,   450,   452,   457,   464,   467,   473,
-     487,   504,   504,   518,   518,   529,   532,   538,   544,   547,
-     550,   553,   559,   564,   571,   579,   582,   588,   599,   610,
-     619,   631,   636,   645,   657,   662,   665,   671,   671,   723,
-     726,   729,   732,   735,   738,   744,   751,   768,   768,   780,
-     783,   786,   792,   795,   798,   801,   804,   807,   810,   813,
-     816,   819,   822,   825,   828,   831,   834,   840,   846,   848,
-     853,   856,   856,   875,   878,   884,   887,   893,   893,   902,
-     904,   909,   912,   918,   921,   935,   935,   944,   946,   951,
-     953,   958,   961,   964,   979,   982,   988,   991,   997,  1000,
-    1003,  1009,  1012,  1018,  1060,  1063,  1066,  1073,  1083,  1083,
-    1099,  1114,  1128,  1142,  1142,  1186,  1189,  1195,  1202,  1212,
-    1215,  1218,  1221,  1224,  1230,  1237,  1244,  1258,  1264,  1271,
-    1280
+       0,   206,   206,   208,   210,   212,   214,   216,   221,   223,
+     228,   232,   238,   240,   245,   247,   249,   251,   253,   255,
+     260,   266,   272,   278,   287,   315,   322,   329,   343,   351,
+     356,   358,   363,   370,   380,   380,   394,   410,   437,   464,
+     496,   526,   528,   533,   540,   543,   549,   563,   580,   580,
+     594,   594,   605,   608,   614,   620,   623,   626,   629,   635,
+     640,   647,   655,   658,   664,   675,   686,   695,   707,   712,
+     721,   733,   738,   741,   747,   747,   799,   802,   805,   808,
+     811,   814,   820,   827,   844,   844,   856,   859,   862,   868,
+     871,   874,   877,   880,   883,   886,   889,   892,   895,   898,
+     901,   904,   907,   910,   916,   922,   924,   929,   932,   932,
+     951,   954,   960,   963,   969,   969,   978,   980,   985,   988,
+     994,   997,  1011,  1011,  1020,  1022,  1027,  1029,  1034,  1037,
+    1040,  1055,  1058,  1064,  1067,  1073,  1076,  1079,  1085,  1088,
+    1094,  1136,  1139,  1142,  1149,  1159,  1159,  1175,  1190,  1204,
+    1218,  1218,  1262,  1265,  1271,  1278,  1288,  1291,  1294,  1297,
+    1300,  1306,  1313,  1320,  1334,  1340,  1347,  1356
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "\"end of query string\"", "error", "$undefined", "\"FOR declaration\"",
-  "\"LET declaration\"", "\"FILTER declaration\"",
+  "\"end of query string\"", "error", "\"invalid token\"",
+  "\"FOR declaration\"", "\"LET declaration\"", "\"FILTER declaration\"",
   "\"RETURN declaration\"", "\"COLLECT declaration\"",
   "\"SORT declaration\"", "\"LIMIT declaration\"", "\"ASC keyword\"",
   "\"DESC keyword\"", "\"IN keyword\"", "\"WITH keyword\"",
@@ -600,11 +732,12 @@ static const char *const yytname[] =
   "'.'", "$accept", "query", "optional_post_modification_lets",
   "optional_post_modification_block",
   "optional_statement_block_statements", "statement_block_statement",
-  "for_statement", "filter_statement", "let_statement", "let_list",
-  "let_element", "count_into", "collect_variable_list", "$@1",
-  "collect_statement", "collect_list", "collect_element", "optional_into",
-  "variable_list", "keep", "$@2", "sort_statement", "$@3", "sort_list",
-  "sort_element", "sort_direction", "limit_statement", "return_statement",
+  "for_statement", "traversal_graph_info", "traversal_edge_collection",
+  "filter_statement", "let_statement", "let_list", "let_element",
+  "count_into", "collect_variable_list", "$@1", "collect_statement",
+  "collect_list", "collect_element", "optional_into", "variable_list",
+  "keep", "$@2", "sort_statement", "$@3", "sort_list", "sort_element",
+  "sort_direction", "limit_statement", "return_statement",
   "in_or_into_collection", "remove_statement", "insert_statement",
   "update_parameters", "update_statement", "replace_parameters",
   "replace_statement", "update_or_replace", "upsert_statement", "$@4",
@@ -620,243 +753,248 @@ static const char *const yytname[] =
   "collection_name", "bind_parameter", "object_element_name",
   "variable_name", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,    46
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -109
+#define YYPACT_NINF (-233)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-109)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -157
+#define YYTABLE_NINF (-164)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-    -109,    12,   673,  -109,   -19,   -19,   712,   712,    14,  -109,
-     170,   712,   712,   712,   712,  -109,  -109,  -109,  -109,  -109,
-       9,  -109,  -109,  -109,  -109,    75,    75,    75,    75,    75,
-    -109,    24,     0,  -109,    16,  -109,  -109,  -109,    -2,  -109,
-    -109,  -109,  -109,   712,   712,   712,   712,  -109,  -109,   604,
-       7,  -109,  -109,  -109,  -109,  -109,  -109,  -109,   -26,  -109,
-    -109,  -109,   604,    64,    65,   -19,   712,    44,  -109,  -109,
-     475,   475,  -109,   375,  -109,   410,   712,   -19,    65,    84,
-     104,  -109,  -109,  -109,  -109,  -109,   712,   -19,   712,    83,
-      83,    83,   267,  -109,    -3,   712,   712,   101,   712,   712,
-     712,   712,   712,   712,   712,   712,   712,   712,   712,   712,
-     712,   712,   712,    91,    68,   646,    -8,   105,    72,  -109,
-      71,  -109,    98,    76,  -109,   307,   170,   732,    18,    65,
-      65,   712,    65,   712,    65,   507,   100,  -109,    72,    65,
-    -109,  -109,  -109,   604,  -109,   604,  -109,    90,  -109,  -109,
-     102,   712,    93,   106,  -109,   108,   604,    89,   114,   391,
-     712,    21,   619,   128,   128,   109,   109,   109,   109,    95,
-      95,    83,    83,    83,   539,   147,  -109,   679,  -109,   186,
-     137,  -109,  -109,   -19,  -109,   -19,   712,   712,  -109,  -109,
-    -109,  -109,  -109,   111,    25,    28,  -109,  -109,  -109,  -109,
-    -109,  -109,  -109,   475,  -109,   475,  -109,   712,   712,   -19,
-    -109,  -109,   712,   235,  -109,    -3,   712,  -109,   712,   391,
-     712,   604,   129,  -109,  -109,   132,  -109,  -109,   176,  -109,
-    -109,   604,  -109,    65,    65,   442,   572,   136,  -109,   604,
-     149,  -109,   604,   604,   604,  -109,  -109,   712,   712,   190,
-    -109,  -109,  -109,  -109,   712,  -109,   -19,   712,  -109,   604,
-     712,   197,   475,  -109,   604,   339,   712,   151,    65,   712,
-     604,  -109,  -109,   604
+    -233,    33,   756,  -233,    23,    23,   795,   795,    53,  -233,
+     115,   795,   795,   795,   795,  -233,  -233,  -233,  -233,  -233,
+      15,  -233,  -233,  -233,  -233,    30,    30,    30,    30,    30,
+    -233,    -3,    21,  -233,    41,  -233,  -233,  -233,   -25,  -233,
+    -233,  -233,  -233,   795,   795,   795,   795,  -233,  -233,   687,
+      34,  -233,  -233,  -233,  -233,  -233,  -233,  -233,   -34,  -233,
+    -233,  -233,   687,    59,    61,    23,   795,    38,  -233,  -233,
+     526,   526,  -233,   426,  -233,   461,   795,    23,    61,    64,
+      37,  -233,  -233,  -233,  -233,  -233,   795,    23,    23,   795,
+      60,    60,    60,   287,  -233,    -2,   795,   795,    76,   795,
+     795,   795,   795,   795,   795,   795,   795,   795,   795,   795,
+     795,   795,   795,   795,    69,    65,   729,     8,    95,    66,
+    -233,    71,  -233,    91,    74,  -233,   327,   115,   815,    54,
+      61,    61,   795,    61,   795,    61,   558,    96,  -233,    66,
+      61,  -233,  -233,  -233,   590,     0,  -233,   687,  -233,    78,
+    -233,  -233,    79,   795,    97,   103,  -233,    81,   687,   100,
+     107,   442,   795,   156,   702,   407,   407,    13,    13,    13,
+      13,    16,    16,    60,    60,    60,   622,   123,  -233,   762,
+    -233,   193,   119,  -233,  -233,    23,  -233,    23,   795,   795,
+    -233,  -233,  -233,  -233,  -233,    26,   108,   111,  -233,  -233,
+    -233,  -233,  -233,  -233,  -233,   526,  -233,   526,  -233,   795,
+     795,    23,  -233,   795,  -233,   795,    23,  -233,   795,   255,
+    -233,    -2,   795,  -233,   795,   442,   795,   687,   118,  -233,
+    -233,   122,  -233,  -233,   161,  -233,  -233,   687,  -233,    61,
+      61,   493,   655,   128,  -233,   391,   590,   158,   687,   132,
+    -233,   687,   687,   687,  -233,  -233,   795,   795,   168,  -233,
+    -233,  -233,  -233,   795,  -233,    23,  -233,  -233,  -233,    61,
+    -233,   795,   795,  -233,   687,   795,   172,   526,  -233,  -233,
+     590,   687,   359,   795,   126,    61,  -233,   795,   687,  -233,
+    -233,   687
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-      12,     0,     0,     1,     0,     0,     0,     0,    27,    43,
-       0,     0,     0,     0,     0,    67,    13,    14,    16,    15,
-      37,    17,    18,    19,     2,    10,    10,    10,    10,    10,
-     160,     0,    22,    23,     0,   151,   152,   153,   133,   149,
-     147,   148,   157,     0,     0,     0,   138,   115,   107,    21,
-      77,   136,    69,    70,    71,   134,   105,   106,    73,   150,
-      72,   135,    54,     0,   113,     0,     0,    52,   145,   146,
-       0,     0,    61,     0,    64,     0,     0,     0,   113,   113,
-       0,     3,     4,     5,     6,     7,     0,     0,     0,    81,
-      79,    80,     0,    12,   117,   109,     0,     0,     0,     0,
+      12,     0,     0,     1,     0,     0,     0,     0,    34,    50,
+       0,     0,     0,     0,     0,    74,    13,    14,    16,    15,
+      44,    17,    18,    19,     2,    10,    10,    10,    10,    10,
+     167,     0,    29,    30,     0,   158,   159,   160,   140,   156,
+     154,   155,   164,     0,     0,     0,   145,   122,   114,    28,
+      84,   143,    76,    77,    78,   141,   112,   113,    80,   157,
+      79,   142,    61,     0,   120,     0,     0,    59,   152,   153,
+       0,     0,    68,     0,    71,     0,     0,     0,   120,   120,
+       0,     3,     4,     5,     6,     7,     0,     0,     0,     0,
+      88,    86,    87,     0,    12,   124,   116,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    29,
-      28,    34,     0,    44,    45,    48,     0,     0,     0,   113,
-     113,     0,   113,     0,   113,     0,    38,    30,    41,   113,
-      31,     9,    11,    20,    24,    25,   137,     0,   158,   159,
-       0,     0,     0,   118,   119,     0,   111,     0,   110,    95,
-       0,    83,    82,    89,    90,    91,    92,    93,    94,    84,
-      85,    86,    87,    88,     0,    74,    76,   101,   124,     0,
-     143,   140,   141,     0,   114,     0,     0,     0,    49,    50,
-      47,    51,    53,   133,   149,   157,    55,   154,   155,   156,
-      56,    57,    58,     0,    59,     0,    62,     0,     0,     0,
-      32,   139,     0,     0,   116,     0,     0,   108,     0,    96,
-       0,   100,     0,   103,    12,    99,   142,   125,   126,    26,
-      35,    36,    46,   113,   113,     0,   113,    42,    39,   123,
-       0,   120,   121,   112,    97,    78,   102,   101,     0,   128,
-      60,    63,    65,    66,     0,    33,     0,     0,   104,   127,
-       0,   131,     0,    40,   122,   129,     0,     0,   113,     0,
-     132,   144,    68,   130
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      36,    35,    41,     0,    51,    52,    55,     0,     0,     0,
+     120,   120,     0,   120,     0,   120,     0,    45,    37,    48,
+     120,    38,     9,    11,    20,     0,    31,    32,   144,     0,
+     165,   166,     0,     0,     0,   125,   126,     0,   118,     0,
+     117,   102,     0,    90,    89,    96,    97,    98,    99,   100,
+     101,    91,    92,    93,    94,    95,     0,    81,    83,   108,
+     131,     0,   150,   147,   148,     0,   121,     0,     0,     0,
+      56,    57,    54,    58,    60,   140,   156,   164,    62,   161,
+     162,   163,    63,    64,    65,     0,    66,     0,    69,     0,
+       0,     0,    39,     0,    21,     0,     0,   146,     0,     0,
+     123,     0,     0,   115,     0,   103,     0,   107,     0,   110,
+      12,   106,   149,   132,   133,    33,    42,    43,    53,   120,
+     120,     0,   120,    49,    46,     0,     0,     0,   130,     0,
+     127,   128,   119,   104,    85,   109,   108,     0,   135,    67,
+      70,    72,    73,     0,    40,     0,    25,    26,    27,   120,
+      22,     0,     0,   111,   134,     0,   138,     0,    47,    24,
+       0,   129,   136,     0,     0,   120,    23,     0,   139,   151,
+      75,   137
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -109,   -91,  -109,    57,  -109,  -109,  -109,  -109,   125,  -109,
-     122,   191,  -109,  -109,  -109,  -109,    45,  -109,  -109,  -109,
-    -109,  -109,  -109,  -109,    26,  -109,  -109,   153,   -62,  -109,
-    -109,  -109,  -109,  -109,  -109,  -109,  -109,  -109,    -6,  -109,
-    -109,  -109,  -109,  -109,  -109,  -109,   -16,  -109,  -109,  -109,
-    -109,  -109,  -109,  -109,   -61,  -108,  -109,  -109,  -109,    19,
-    -109,  -109,  -109,  -109,  -109,  -109,  -109,   -60,  -109,     6,
-     107,     4,  -109,    -1
+    -233,   -92,  -233,   117,  -233,  -233,  -233,  -232,  -233,  -233,
+     101,  -233,    92,   163,  -233,  -233,  -233,  -233,    12,  -233,
+    -233,  -233,  -233,  -233,  -233,  -233,    11,  -233,  -233,   131,
+     -56,  -233,  -233,  -233,  -233,  -233,  -233,  -233,  -233,  -233,
+      -6,  -233,  -233,  -233,  -233,  -233,  -233,  -233,   -69,  -233,
+    -233,  -233,  -233,  -233,  -233,  -233,   -68,  -115,  -233,  -233,
+    -233,   -15,  -233,  -233,  -233,  -233,  -233,  -233,  -233,   -66,
+    -233,     6,    84,     3,  -233,    -1
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,     1,    80,    81,     2,    16,    17,    18,    19,    32,
-      33,    64,    20,    65,    21,   120,   121,    79,   237,   139,
-     209,    22,    66,   123,   124,   190,    23,    24,   129,    25,
-      26,    72,    27,    74,    28,   254,    29,    76,   125,    50,
-      51,   114,    52,    53,    54,   222,   223,   224,   225,    55,
-      56,    95,   157,   158,   119,    57,    94,   152,   153,   154,
-     180,   249,   261,   267,    58,    93,   228,    67,    59,    60,
-     196,    61,   155,    34
+       0,     1,    80,    81,     2,    16,    17,   214,   269,    18,
+      19,    32,    33,    64,    20,    65,    21,   121,   122,    79,
+     243,   140,   211,    22,    66,   124,   125,   192,    23,    24,
+     130,    25,    26,    72,    27,    74,    28,   263,    29,    76,
+     126,    50,    51,   115,    52,    53,    54,   228,   229,   230,
+     231,    55,    56,    96,   159,   160,   120,    57,    95,   154,
+     155,   156,   182,   258,   276,   284,    58,    94,   234,    67,
+      59,    60,   198,    61,   157,    34
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      49,    62,   147,    31,    30,    70,    71,    73,    75,   130,
-     184,   132,     3,   134,    69,   181,    68,   137,   140,    42,
-     148,   149,    63,    77,   150,  -155,   115,    63,  -156,  -155,
-     184,  -155,  -156,    96,  -156,   116,    86,    89,    90,    91,
-      92,   197,   198,   -75,    88,   199,   -75,    87,  -155,   151,
-      97,  -156,   113,   100,   101,   102,   103,   104,   105,   106,
-     107,   108,   109,   110,   122,   191,   192,   112,   201,   202,
-     135,   204,  -155,   206,  -155,  -156,   136,  -156,   210,    -8,
-     143,    -8,   145,    82,    83,    84,    85,   117,   118,   156,
-     159,   126,   161,   162,   163,   164,   165,   166,   167,   168,
-     169,   170,   171,   172,   173,   174,   175,   138,     5,   179,
-       7,  -154,    97,   160,   176,  -154,   177,  -154,   185,   183,
-     182,   159,    47,   187,    97,   203,   186,   205,   208,    69,
-      69,    68,    68,   246,  -154,   108,   109,   110,    97,   211,
-      96,   233,   217,   234,   214,   213,   212,   106,   107,   108,
-     109,   110,   216,   215,   219,   112,   -75,    97,  -154,   -75,
-    -154,   218,   102,   103,   104,   105,   106,   107,   108,   109,
-     110,   221,   250,   251,   112,   255,    97,   227,   245,   247,
-     231,   248,   229,   256,   122,   106,   107,   108,   109,   110,
-      35,    36,    37,   257,    39,    40,    41,    42,    96,   260,
-     268,   235,   236,   266,   271,   141,   239,   272,   238,   144,
-     242,    78,   243,   232,   244,    97,    98,    99,   100,   101,
+      49,    62,   149,    31,   186,    70,    71,    73,    75,    86,
+     138,   141,   215,    69,   270,   131,    68,   133,   116,   135,
+     -82,   150,   151,   -82,   186,   152,  -161,   117,    63,    77,
+    -161,   183,  -161,     3,    -8,    42,    -8,    90,    91,    92,
+      93,     5,    98,     7,    87,    98,    30,   216,   286,  -161,
+     153,   107,   108,   109,   110,   111,   109,   110,   111,   113,
+     193,   194,   203,   204,   123,   206,    63,   208,    88,    89,
+     136,   -82,   212,  -161,   -82,  -161,   137,   199,   200,   114,
+     144,   201,   118,   147,   119,   127,   145,   139,   162,    98,
+     158,   161,   178,   163,   164,   165,   166,   167,   168,   169,
+     170,   171,   172,   173,   174,   175,   176,   177,  -162,   185,
+     181,  -163,  -162,   179,  -162,  -163,    47,  -163,   187,   188,
+     184,   189,   161,   218,   210,   222,   205,   217,   207,    69,
+      69,  -162,    68,    68,  -163,    35,    36,    37,   255,    39,
+      40,    41,    42,    82,    83,    84,    85,   219,   220,   239,
+     221,   240,    98,   223,   224,  -162,   225,  -162,  -163,   233,
+    -163,   107,   108,   109,   110,   111,   257,   254,    97,   256,
+     271,   259,   260,   227,   264,   265,   272,   275,   283,   289,
+     146,   142,   237,    78,   235,    98,   123,   273,   101,   102,
+     103,   104,   105,   106,   107,   108,   109,   110,   111,   236,
+     238,   279,   113,   241,   242,    97,   250,   245,     0,   246,
+     244,   143,   248,   202,     0,   247,   251,   290,   252,     0,
+     253,   285,    98,    99,   100,   101,   102,   103,   104,   105,
+     106,   107,   108,   109,   110,   111,   112,     0,     0,   113,
+       0,     0,     0,     0,     0,     0,   232,     0,     0,     0,
+     227,   274,     0,     0,     0,     0,     0,   277,     0,     0,
+       0,     0,     0,     0,   278,   280,   281,    97,     0,   282,
+       0,     0,     0,     0,     0,     0,     0,   288,     0,     0,
+       0,   291,     0,     0,    98,    99,   100,   101,   102,   103,
+     104,   105,   106,   107,   108,   109,   110,   111,   112,    97,
+       0,   113,     0,     0,     0,     0,     0,     0,   249,     0,
+       0,     0,     0,     0,     0,     0,    98,    99,   100,   101,
      102,   103,   104,   105,   106,   107,   108,   109,   110,   111,
-     230,   258,   112,   142,   241,   200,     0,     0,     0,   226,
-       0,   221,   259,     0,     0,     0,     0,    96,   262,     0,
-       0,   264,     0,     0,   265,   263,     0,     0,     0,     0,
-     270,     0,     0,   273,    97,    98,    99,   100,   101,   102,
-     103,   104,   105,   106,   107,   108,   109,   110,   111,    96,
-       0,   112,     0,     0,     0,     0,     0,     0,   240,     0,
-       0,     0,     0,     0,     0,     0,    97,    98,    99,   100,
-     101,   102,   103,   104,   105,   106,   107,   108,   109,   110,
-     111,     0,     0,   112,     0,     0,   146,   188,   189,    96,
+     112,     0,     0,   113,     0,     0,   148,   190,   191,    97,
        0,     0,     0,     0,     0,     0,     0,    35,    36,    37,
-       0,    39,    40,    41,    42,     0,    97,    98,    99,   100,
-     101,   102,   103,   104,   105,   106,   107,   108,   109,   110,
-     111,    96,     0,   112,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    97,    98,
-      99,   100,   101,   102,   103,   104,   105,   106,   107,   108,
-     109,   110,   111,     0,     0,   112,   269,   127,   131,   128,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    97,    98,    99,   100,   101,   102,
-     103,   104,   105,   106,   107,   108,   109,   110,   111,     0,
-      97,   112,   127,   133,   128,   102,   103,   104,   105,   106,
-     107,   108,   109,   110,     0,     0,     0,   112,     0,    97,
+       0,    39,    40,    41,    42,     0,    98,    99,   100,   101,
+     102,   103,   104,   105,   106,   107,   108,   109,   110,   111,
+     112,    97,     0,   113,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    98,    99,
+     100,   101,   102,   103,   104,   105,   106,   107,   108,   109,
+     110,   111,   112,    97,     0,   113,   287,     0,     0,     0,
+       0,     0,     0,     0,   266,   267,     0,     0,   268,    97,
       98,    99,   100,   101,   102,   103,   104,   105,   106,   107,
-     108,   109,   110,   111,    96,     0,   112,     0,     0,   252,
-     253,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    97,    98,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,   111,     0,   127,   112,   128,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    97,    98,    99,   100,   101,   102,
-     103,   104,   105,   106,   107,   108,   109,   110,   111,    96,
-       0,   112,     0,   207,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    97,    98,    99,   100,
+     108,   109,   110,   111,   112,     0,    98,   113,   128,   132,
+     129,   103,   104,   105,   106,   107,   108,   109,   110,   111,
+       0,     0,     0,   113,     0,    98,    99,   100,   101,   102,
+     103,   104,   105,   106,   107,   108,   109,   110,   111,   112,
+       0,    98,   113,   128,   134,   129,   103,   104,   105,   106,
+     107,   108,   109,   110,   111,     0,     0,     0,   113,     0,
+      98,    99,   100,   101,   102,   103,   104,   105,   106,   107,
+     108,   109,   110,   111,   112,    97,     0,   113,     0,     0,
+     261,   262,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    98,    99,   100,   101,   102,   103,   104,   105,
+     106,   107,   108,   109,   110,   111,   112,     0,   128,   113,
+     129,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    98,    99,   100,   101,   102,
+     103,   104,   105,   106,   107,   108,   109,   110,   111,   112,
+      97,     0,   113,     0,   209,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    98,    99,   100,
      101,   102,   103,   104,   105,   106,   107,   108,   109,   110,
-     111,    96,     0,   112,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    97,    98,
+     111,   112,    97,     0,   113,     0,     0,     0,     0,     0,
+       0,     0,     0,   213,     0,     0,     0,     0,     0,    98,
       99,   100,   101,   102,   103,   104,   105,   106,   107,   108,
-     109,   110,   111,   220,    96,   112,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,   118,     0,     0,     0,     0,
-       0,    97,    98,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,   111,    96,     0,   112,     0,
+     109,   110,   111,   112,    97,     0,   113,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    96,     0,    97,    98,    99,   100,   101,   102,   103,
-     104,   105,   106,   107,   108,   109,   110,   111,    97,    98,
-     112,   100,   101,   102,   103,   104,   105,   106,   107,   108,
-     109,   110,     0,     0,     0,   112,    35,    36,    37,    38,
-      39,    40,    41,    42,     0,    43,     4,     5,     6,     7,
-       8,     9,    10,     0,    44,    45,   178,     0,    11,    12,
-      13,    14,    15,     0,    46,     0,    47,     0,    48,    35,
-      36,    37,    38,    39,    40,    41,    42,     0,    43,     0,
-       0,     0,     0,     0,     0,     0,     0,    44,    45,     0,
-       0,     0,     0,     0,     0,     0,     0,    46,   -98,    47,
+       0,    98,    99,   100,   101,   102,   103,   104,   105,   106,
+     107,   108,   109,   110,   111,   112,   226,    97,   113,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   119,     0,
+       0,     0,     0,     0,    98,    99,   100,   101,   102,   103,
+     104,   105,   106,   107,   108,   109,   110,   111,   112,    97,
+       0,   113,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    97,     0,    98,    99,   100,   101,
+     102,   103,   104,   105,   106,   107,   108,   109,   110,   111,
+     112,    98,    99,   113,   101,   102,   103,   104,   105,   106,
+     107,   108,   109,   110,   111,     0,     0,     0,   113,    35,
+      36,    37,    38,    39,    40,    41,    42,     0,    43,     4,
+       5,     6,     7,     8,     9,    10,     0,    44,    45,   180,
+       0,    11,    12,    13,    14,    15,     0,    46,     0,    47,
        0,    48,    35,    36,    37,    38,    39,    40,    41,    42,
        0,    43,     0,     0,     0,     0,     0,     0,     0,     0,
-      44,    45,    35,    36,    37,   193,   194,    40,    41,   195,
-      46,    43,    47,     0,    48,     0,     0,     0,     0,     0,
       44,    45,     0,     0,     0,     0,     0,     0,     0,     0,
-      46,     0,    47,     0,    48
+      46,  -105,    47,     0,    48,    35,    36,    37,    38,    39,
+      40,    41,    42,     0,    43,     0,     0,     0,     0,     0,
+       0,     0,     0,    44,    45,    35,    36,    37,   195,   196,
+      40,    41,   197,    46,    43,    47,     0,    48,     0,     0,
+       0,     0,     0,    44,    45,     0,     0,     0,     0,     0,
+       0,     0,     0,    46,     0,    47,     0,    48
 };
 
 static const yytype_int16 yycheck[] =
 {
-       6,     7,    93,     4,    23,    11,    12,    13,    14,    71,
-     118,    73,     0,    75,    10,    23,    10,    78,    79,    27,
-      23,    24,    13,    14,    27,     0,    52,    13,     0,     4,
-     138,     6,     4,    12,     6,    61,    12,    43,    44,    45,
-      46,    23,    24,    45,    28,    27,    48,    47,    23,    52,
-      29,    23,    45,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    65,   125,   126,    46,   129,   130,
-      76,   132,    47,   134,    49,    47,    77,    49,   139,     4,
-      86,     6,    88,    26,    27,    28,    29,    23,    23,    95,
-      96,    47,    98,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,   111,   112,    23,     4,   115,
-       6,     0,    29,    12,    23,     4,    48,     6,    47,    14,
-     116,   127,    50,    47,    29,   131,    28,   133,    28,   125,
-     126,   125,   126,   224,    23,    40,    41,    42,    29,    49,
-      12,   203,    53,   205,    51,   151,    44,    38,    39,    40,
-      41,    42,    44,    47,   160,    46,    45,    29,    47,    48,
-      49,    47,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,   177,   233,   234,    46,   236,    29,    40,    49,    47,
-     186,     5,   183,    47,   185,    38,    39,    40,    41,    42,
-      20,    21,    22,    44,    24,    25,    26,    27,    12,     9,
-     262,   207,   208,     6,    53,    80,   212,   268,   209,    87,
-     216,    20,   218,   187,   220,    29,    30,    31,    32,    33,
-      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
-     185,   247,    46,    80,   215,   128,    -1,    -1,    -1,    53,
-      -1,   247,   248,    -1,    -1,    -1,    -1,    12,   254,    -1,
-      -1,   257,    -1,    -1,   260,   256,    -1,    -1,    -1,    -1,
-     266,    -1,    -1,   269,    29,    30,    31,    32,    33,    34,
+       6,     7,    94,     4,   119,    11,    12,    13,    14,    12,
+      78,    79,    12,    10,   246,    71,    10,    73,    52,    75,
+      45,    23,    24,    48,   139,    27,     0,    61,    13,    14,
+       4,    23,     6,     0,     4,    27,     6,    43,    44,    45,
+      46,     4,    29,     6,    47,    29,    23,    47,   280,    23,
+      52,    38,    39,    40,    41,    42,    40,    41,    42,    46,
+     126,   127,   130,   131,    65,   133,    13,   135,    47,    28,
+      76,    45,   140,    47,    48,    49,    77,    23,    24,    45,
+      86,    27,    23,    89,    23,    47,    87,    23,    12,    29,
+      96,    97,    23,    99,   100,   101,   102,   103,   104,   105,
+     106,   107,   108,   109,   110,   111,   112,   113,     0,    14,
+     116,     0,     4,    48,     6,     4,    50,     6,    47,    28,
+     117,    47,   128,    44,    28,    44,   132,    49,   134,   126,
+     127,    23,   126,   127,    23,    20,    21,    22,   230,    24,
+      25,    26,    27,    26,    27,    28,    29,   153,    51,   205,
+      47,   207,    29,    53,    47,    47,   162,    49,    47,    40,
+      49,    38,    39,    40,    41,    42,     5,    49,    12,    47,
+      12,   239,   240,   179,   242,    47,    44,     9,     6,    53,
+      88,    80,   188,    20,   185,    29,   187,   256,    32,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,   187,
+     189,   269,    46,   209,   210,    12,   221,   213,    -1,   215,
+     211,    80,   218,   129,    -1,   216,   222,   285,   224,    -1,
+     226,   277,    29,    30,    31,    32,    33,    34,    35,    36,
+      37,    38,    39,    40,    41,    42,    43,    -1,    -1,    46,
+      -1,    -1,    -1,    -1,    -1,    -1,    53,    -1,    -1,    -1,
+     256,   257,    -1,    -1,    -1,    -1,    -1,   263,    -1,    -1,
+      -1,    -1,    -1,    -1,   265,   271,   272,    12,    -1,   275,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,   283,    -1,    -1,
+      -1,   287,    -1,    -1,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    12,
       -1,    46,    -1,    -1,    -1,    -1,    -1,    -1,    53,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    29,    30,    31,    32,
@@ -868,161 +1006,169 @@ static const yytype_int16 yycheck[] =
       43,    12,    -1,    46,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,    30,
       31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    43,    -1,    -1,    46,    47,    12,    13,    14,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    43,    -1,
-      29,    46,    12,    13,    14,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    -1,    -1,    -1,    46,    -1,    29,
+      41,    42,    43,    12,    -1,    46,    47,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    23,    24,    -1,    -1,    27,    12,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    -1,    29,    46,    12,    13,
+      14,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+      -1,    -1,    -1,    46,    -1,    29,    30,    31,    32,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
+      -1,    29,    46,    12,    13,    14,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    -1,    -1,    -1,    46,    -1,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    12,    -1,    46,    -1,    -1,
+      17,    18,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    29,    30,    31,    32,    33,    34,    35,    36,
+      37,    38,    39,    40,    41,    42,    43,    -1,    12,    46,
+      14,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
+      12,    -1,    46,    -1,    16,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,    30,    31,
+      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
+      42,    43,    12,    -1,    46,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    23,    -1,    -1,    -1,    -1,    -1,    29,
       30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
-      40,    41,    42,    43,    12,    -1,    46,    -1,    -1,    17,
-      18,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    29,    30,    31,    32,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,    43,    -1,    12,    46,    14,
+      40,    41,    42,    43,    12,    -1,    46,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    43,    44,    12,    46,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    23,    -1,
       -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    12,
-      -1,    46,    -1,    16,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    29,    30,    31,    32,
+      -1,    46,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    12,    -1,    29,    30,    31,    32,
       33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
-      43,    12,    -1,    46,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    29,    30,
-      31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    43,    44,    12,    46,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    23,    -1,    -1,    -1,    -1,
-      -1,    29,    30,    31,    32,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,    43,    12,    -1,    46,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    12,    -1,    29,    30,    31,    32,    33,    34,    35,
-      36,    37,    38,    39,    40,    41,    42,    43,    29,    30,
-      46,    32,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    -1,    -1,    -1,    46,    20,    21,    22,    23,
-      24,    25,    26,    27,    -1,    29,     3,     4,     5,     6,
-       7,     8,     9,    -1,    38,    39,    40,    -1,    15,    16,
-      17,    18,    19,    -1,    48,    -1,    50,    -1,    52,    20,
-      21,    22,    23,    24,    25,    26,    27,    -1,    29,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    38,    39,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    48,    49,    50,
+      43,    29,    30,    46,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    -1,    -1,    -1,    46,    20,
+      21,    22,    23,    24,    25,    26,    27,    -1,    29,     3,
+       4,     5,     6,     7,     8,     9,    -1,    38,    39,    40,
+      -1,    15,    16,    17,    18,    19,    -1,    48,    -1,    50,
       -1,    52,    20,    21,    22,    23,    24,    25,    26,    27,
       -1,    29,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      38,    39,    20,    21,    22,    23,    24,    25,    26,    27,
-      48,    29,    50,    -1,    52,    -1,    -1,    -1,    -1,    -1,
       38,    39,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      48,    -1,    50,    -1,    52
+      48,    49,    50,    -1,    52,    20,    21,    22,    23,    24,
+      25,    26,    27,    -1,    29,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    38,    39,    20,    21,    22,    23,    24,
+      25,    26,    27,    48,    29,    50,    -1,    52,    -1,    -1,
+      -1,    -1,    -1,    38,    39,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    48,    -1,    50,    -1,    52
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
        0,    63,    66,     0,     3,     4,     5,     6,     7,     8,
-       9,    15,    16,    17,    18,    19,    67,    68,    69,    70,
-      74,    76,    83,    88,    89,    91,    92,    94,    96,    98,
-      23,   135,    71,    72,   135,    20,    21,    22,    23,    24,
-      25,    26,    27,    29,    38,    39,    48,    50,    52,   100,
-     101,   102,   104,   105,   106,   111,   112,   117,   126,   130,
-     131,   133,   100,    13,    73,    75,    84,   129,   131,   133,
-     100,   100,    93,   100,    95,   100,    99,    14,    73,    79,
-      64,    65,    65,    65,    65,    65,    12,    47,    28,   100,
-     100,   100,   100,   127,   118,   113,    12,    29,    30,    31,
-      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    43,    46,    45,   103,    52,    61,    23,    23,   116,
-      77,    78,   135,    85,    86,   100,    47,    12,    14,    90,
-      90,    13,    90,    13,    90,   100,   135,   116,    23,    81,
-     116,    70,    89,   100,    72,   100,    49,    63,    23,    24,
-      27,    52,   119,   120,   121,   134,   100,   114,   115,   100,
-      12,   100,   100,   100,   100,   100,   100,   100,   100,   100,
-     100,   100,   100,   100,   100,   100,    23,    48,    40,   100,
-     122,    23,   133,    14,   117,    47,    28,    47,    10,    11,
-      87,   129,   129,    23,    24,    27,   132,    23,    24,    27,
-     132,   116,   116,   100,   116,   100,   116,    16,    28,    82,
-     116,    49,    44,   100,    51,    47,    44,    53,    47,   100,
-      44,   100,   107,   108,   109,   110,    53,    40,   128,   135,
-      78,   100,    86,    90,    90,   100,   100,    80,   135,   100,
-      53,   121,   100,   100,   100,    49,    63,    47,     5,   123,
-     116,   116,    17,    18,    97,   116,    47,    44,   108,   100,
-       9,   124,   100,   135,   100,   100,     6,   125,    90,    47,
-     100,    53,   116,   100
+       9,    15,    16,    17,    18,    19,    67,    68,    71,    72,
+      76,    78,    85,    90,    91,    93,    94,    96,    98,   100,
+      23,   137,    73,    74,   137,    20,    21,    22,    23,    24,
+      25,    26,    27,    29,    38,    39,    48,    50,    52,   102,
+     103,   104,   106,   107,   108,   113,   114,   119,   128,   132,
+     133,   135,   102,    13,    75,    77,    86,   131,   133,   135,
+     102,   102,    95,   102,    97,   102,   101,    14,    75,    81,
+      64,    65,    65,    65,    65,    65,    12,    47,    47,    28,
+     102,   102,   102,   102,   129,   120,   115,    12,    29,    30,
+      31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
+      41,    42,    43,    46,    45,   105,    52,    61,    23,    23,
+     118,    79,    80,   137,    87,    88,   102,    47,    12,    14,
+      92,    92,    13,    92,    13,    92,   102,   137,   118,    23,
+      83,   118,    72,    91,   102,   137,    74,   102,    49,    63,
+      23,    24,    27,    52,   121,   122,   123,   136,   102,   116,
+     117,   102,    12,   102,   102,   102,   102,   102,   102,   102,
+     102,   102,   102,   102,   102,   102,   102,   102,    23,    48,
+      40,   102,   124,    23,   135,    14,   119,    47,    28,    47,
+      10,    11,    89,   131,   131,    23,    24,    27,   134,    23,
+      24,    27,   134,   118,   118,   102,   118,   102,   118,    16,
+      28,    84,   118,    23,    69,    12,    47,    49,    44,   102,
+      51,    47,    44,    53,    47,   102,    44,   102,   109,   110,
+     111,   112,    53,    40,   130,   137,    80,   102,    88,    92,
+      92,   102,   102,    82,   137,   102,   102,   137,   102,    53,
+     123,   102,   102,   102,    49,    63,    47,     5,   125,   118,
+     118,    17,    18,    99,   118,    47,    23,    24,    27,    70,
+      69,    12,    44,   110,   102,     9,   126,   102,   137,   118,
+     102,   102,   102,     6,   127,    92,    69,    47,   102,    53,
+     118,   102
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_uint8 yyr1[] =
 {
        0,    62,    63,    63,    63,    63,    63,    63,    64,    64,
       65,    65,    66,    66,    67,    67,    67,    67,    67,    67,
-      68,    69,    70,    71,    71,    72,    73,    75,    74,    76,
-      76,    76,    76,    76,    77,    77,    78,    79,    79,    80,
-      80,    82,    81,    84,    83,    85,    85,    86,    87,    87,
-      87,    87,    88,    88,    89,    90,    90,    91,    92,    93,
-      93,    94,    95,    95,    96,    97,    97,    99,    98,   100,
-     100,   100,   100,   100,   100,   101,   101,   103,   102,   104,
-     104,   104,   105,   105,   105,   105,   105,   105,   105,   105,
-     105,   105,   105,   105,   105,   105,   105,   106,   107,   107,
-     108,   109,   108,   110,   110,   111,   111,   113,   112,   114,
-     114,   115,   115,   116,   116,   118,   117,   119,   119,   120,
-     120,   121,   121,   121,   122,   122,   123,   123,   124,   124,
-     124,   125,   125,   126,   126,   126,   126,   126,   127,   126,
-     126,   126,   126,   128,   126,   129,   129,   130,   130,   131,
-     131,   131,   131,   131,   132,   132,   132,   133,   134,   134,
-     135
+      68,    68,    68,    68,    69,    70,    70,    70,    71,    72,
+      73,    73,    74,    75,    77,    76,    78,    78,    78,    78,
+      78,    79,    79,    80,    81,    81,    82,    82,    84,    83,
+      86,    85,    87,    87,    88,    89,    89,    89,    89,    90,
+      90,    91,    92,    92,    93,    94,    95,    95,    96,    97,
+      97,    98,    99,    99,   101,   100,   102,   102,   102,   102,
+     102,   102,   103,   103,   105,   104,   106,   106,   106,   107,
+     107,   107,   107,   107,   107,   107,   107,   107,   107,   107,
+     107,   107,   107,   107,   108,   109,   109,   110,   111,   110,
+     112,   112,   113,   113,   115,   114,   116,   116,   117,   117,
+     118,   118,   120,   119,   121,   121,   122,   122,   123,   123,
+     123,   124,   124,   125,   125,   126,   126,   126,   127,   127,
+     128,   128,   128,   128,   128,   129,   128,   128,   128,   128,
+     130,   128,   131,   131,   132,   132,   133,   133,   133,   133,
+     133,   134,   134,   134,   135,   136,   136,   137
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     3,     3,     3,     3,     3,     0,     2,
        0,     2,     0,     2,     1,     1,     1,     1,     1,     1,
-       4,     2,     2,     1,     3,     3,     4,     0,     3,     3,
-       3,     3,     4,     6,     1,     3,     3,     0,     2,     1,
-       3,     0,     3,     0,     3,     1,     3,     2,     0,     1,
-       1,     1,     2,     4,     2,     2,     2,     4,     4,     3,
-       5,     2,     3,     5,     2,     1,     1,     0,     9,     1,
-       1,     1,     1,     1,     3,     1,     3,     0,     5,     2,
-       2,     2,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     4,     5,     0,     1,
-       1,     0,     2,     1,     3,     1,     1,     0,     4,     0,
-       1,     1,     3,     0,     2,     0,     4,     0,     1,     1,
-       3,     3,     5,     3,     1,     2,     0,     2,     0,     2,
-       4,     0,     2,     1,     1,     1,     1,     3,     0,     4,
-       3,     3,     4,     0,     8,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1
+       4,     5,     7,     9,     4,     1,     1,     1,     2,     2,
+       1,     3,     3,     4,     0,     3,     3,     3,     3,     4,
+       6,     1,     3,     3,     0,     2,     1,     3,     0,     3,
+       0,     3,     1,     3,     2,     0,     1,     1,     1,     2,
+       4,     2,     2,     2,     4,     4,     3,     5,     2,     3,
+       5,     2,     1,     1,     0,     9,     1,     1,     1,     1,
+       1,     3,     1,     3,     0,     5,     2,     2,     2,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     4,     5,     0,     1,     1,     0,     2,
+       1,     3,     1,     1,     0,     4,     0,     1,     1,     3,
+       0,     2,     0,     4,     0,     1,     1,     3,     3,     5,
+       3,     1,     2,     0,     2,     0,     2,     4,     0,     2,
+       1,     1,     1,     1,     3,     0,     4,     3,     3,     4,
+       0,     8,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (&yylloc, parser, YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, parser, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -1066,20 +1212,27 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
 YY_ATTRIBUTE_UNUSED
-static unsigned
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
@@ -1099,64 +1252,72 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
 
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location, parser); \
+                  Kind, Value, Location, parser); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, triagens::aql::Parser* parser)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, triagens::aql::Parser* parser)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (yylocationp);
-  YYUSE (parser);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (parser);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, triagens::aql::Parser* parser)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, triagens::aql::Parser* parser)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp, parser);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, parser);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1165,7 +1326,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYL
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1188,21 +1349,22 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule, triagens::aql::Parser* parser)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, triagens::aql::Parser* parser)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       , parser);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), parser);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1217,8 +1379,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1241,28 +1403,77 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1276,10 +1487,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1287,14 +1498,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1305,7 +1515,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -1320,36 +1533,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1373,63 +1570,78 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
+    default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
       YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1438,7 +1650,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1450,41 +1662,44 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, triagens::aql::Parser* parser)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, triagens::aql::Parser* parser)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-  YYUSE (parser);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (parser);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1492,7 +1707,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
 int
 yyparse (triagens::aql::Parser* parser)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1511,55 +1726,50 @@ static YYLTYPE yyloc_default
 YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1567,43 +1777,49 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
         YYLTYPE *yyls1 = yyls;
 
         /* Each stack pointer address is followed by the size of the
@@ -1611,32 +1827,29 @@ YYLTYPE yylloc = yyloc_default;
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yyls1, yysize * sizeof (*yylsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
                     &yystacksize);
-
-        yyls = yyls1;
         yyss = yyss1;
         yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1645,31 +1858,32 @@ YYLTYPE yylloc = yyloc_default;
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1680,18 +1894,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, &yylloc, scanner);
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= T_END)
     {
-      yychar = yytoken = YYEOF;
+      yychar = T_END;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1719,15 +1945,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1742,7 +1967,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1758,215 +1983,319 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 204 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 2: /* query: optional_statement_block_statements return_statement  */
+#line 206 "arangod/Aql/grammar.y"
+                                                         {
     }
-#line 1771 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 1997 "arangod/Aql/grammar.cpp"
     break;
 
-  case 3:
-#line 206 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 3: /* query: optional_statement_block_statements remove_statement optional_post_modification_block  */
+#line 208 "arangod/Aql/grammar.y"
+                                                                                          {
     }
-#line 1778 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2004 "arangod/Aql/grammar.cpp"
     break;
 
-  case 4:
-#line 208 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 4: /* query: optional_statement_block_statements insert_statement optional_post_modification_block  */
+#line 210 "arangod/Aql/grammar.y"
+                                                                                          {
     }
-#line 1785 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2011 "arangod/Aql/grammar.cpp"
     break;
 
-  case 5:
-#line 210 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 5: /* query: optional_statement_block_statements update_statement optional_post_modification_block  */
+#line 212 "arangod/Aql/grammar.y"
+                                                                                          {
     }
-#line 1792 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2018 "arangod/Aql/grammar.cpp"
     break;
 
-  case 6:
-#line 212 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 6: /* query: optional_statement_block_statements replace_statement optional_post_modification_block  */
+#line 214 "arangod/Aql/grammar.y"
+                                                                                           {
     }
-#line 1799 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2025 "arangod/Aql/grammar.cpp"
     break;
 
-  case 7:
-#line 214 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 7: /* query: optional_statement_block_statements upsert_statement optional_post_modification_block  */
+#line 216 "arangod/Aql/grammar.y"
+                                                                                          {
     }
-#line 1806 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2032 "arangod/Aql/grammar.cpp"
     break;
 
-  case 8:
-#line 219 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 8: /* optional_post_modification_lets: %empty  */
+#line 221 "arangod/Aql/grammar.y"
+                {
     }
-#line 1813 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2039 "arangod/Aql/grammar.cpp"
     break;
 
-  case 9:
-#line 221 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 9: /* optional_post_modification_lets: optional_post_modification_lets let_statement  */
+#line 223 "arangod/Aql/grammar.y"
+                                                  {
     }
-#line 1820 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2046 "arangod/Aql/grammar.cpp"
     break;
 
-  case 10:
-#line 226 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 10: /* optional_post_modification_block: %empty  */
+#line 228 "arangod/Aql/grammar.y"
+                {
       // still need to close the scope opened by the data-modification statement
       parser->ast()->scopes()->endNested();
     }
-#line 1829 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2055 "arangod/Aql/grammar.cpp"
     break;
 
-  case 11:
-#line 230 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 11: /* optional_post_modification_block: optional_post_modification_lets return_statement  */
+#line 232 "arangod/Aql/grammar.y"
+                                                     {
       // the RETURN statement will close the scope opened by the data-modification statement
     }
-#line 1837 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2063 "arangod/Aql/grammar.cpp"
     break;
 
-  case 12:
-#line 236 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 12: /* optional_statement_block_statements: %empty  */
+#line 238 "arangod/Aql/grammar.y"
+                {
     }
-#line 1844 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2070 "arangod/Aql/grammar.cpp"
     break;
 
-  case 13:
-#line 238 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 13: /* optional_statement_block_statements: optional_statement_block_statements statement_block_statement  */
+#line 240 "arangod/Aql/grammar.y"
+                                                                  {
     }
-#line 1851 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2077 "arangod/Aql/grammar.cpp"
     break;
 
-  case 14:
-#line 243 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 14: /* statement_block_statement: for_statement  */
+#line 245 "arangod/Aql/grammar.y"
+                  {
     }
-#line 1858 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2084 "arangod/Aql/grammar.cpp"
     break;
 
-  case 15:
-#line 245 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 15: /* statement_block_statement: let_statement  */
+#line 247 "arangod/Aql/grammar.y"
+                  {
     }
-#line 1865 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2091 "arangod/Aql/grammar.cpp"
     break;
 
-  case 16:
-#line 247 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 16: /* statement_block_statement: filter_statement  */
+#line 249 "arangod/Aql/grammar.y"
+                     {
     }
-#line 1872 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2098 "arangod/Aql/grammar.cpp"
     break;
 
-  case 17:
-#line 249 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 17: /* statement_block_statement: collect_statement  */
+#line 251 "arangod/Aql/grammar.y"
+                      {
     }
-#line 1879 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2105 "arangod/Aql/grammar.cpp"
     break;
 
-  case 18:
-#line 251 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 18: /* statement_block_statement: sort_statement  */
+#line 253 "arangod/Aql/grammar.y"
+                   {
     }
-#line 1886 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2112 "arangod/Aql/grammar.cpp"
     break;
 
-  case 19:
-#line 253 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 19: /* statement_block_statement: limit_statement  */
+#line 255 "arangod/Aql/grammar.y"
+                    {
     }
-#line 1893 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2119 "arangod/Aql/grammar.cpp"
     break;
 
-  case 20:
-#line 258 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 20: /* for_statement: "FOR declaration" variable_name "IN keyword" expression  */
+#line 260 "arangod/Aql/grammar.y"
+                                        {
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
      
       auto node = parser->ast()->createNodeFor((yyvsp[-2].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1904 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2130 "arangod/Aql/grammar.cpp"
     break;
 
-  case 21:
-#line 267 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 21: /* for_statement: "FOR declaration" variable_name "IN keyword" expression traversal_graph_info  */
+#line 266 "arangod/Aql/grammar.y"
+                                                             {
+      parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
+
+      auto node = parser->ast()->createNodeTraversal((yyvsp[-3].strval), nullptr, nullptr, (yyvsp[-1].node), (yyvsp[0].node));
+      parser->ast()->addOperation(node);
+    }
+#line 2141 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 22: /* for_statement: "FOR declaration" variable_name "," variable_name "IN keyword" expression traversal_graph_info  */
+#line 272 "arangod/Aql/grammar.y"
+                                                                                   {
+      parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
+
+      auto node = parser->ast()->createNodeTraversal((yyvsp[-5].strval), (yyvsp[-3].strval), nullptr, (yyvsp[-1].node), (yyvsp[0].node));
+      parser->ast()->addOperation(node);
+    }
+#line 2152 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 23: /* for_statement: "FOR declaration" variable_name "," variable_name "," variable_name "IN keyword" expression traversal_graph_info  */
+#line 278 "arangod/Aql/grammar.y"
+                                                                                                         {
+      parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
+
+      auto node = parser->ast()->createNodeTraversal((yyvsp[-7].strval), (yyvsp[-5].strval), (yyvsp[-3].strval), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->ast()->addOperation(node);
+    }
+#line 2163 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 24: /* traversal_graph_info: "identifier" expression traversal_edge_collection options  */
+#line 287 "arangod/Aql/grammar.y"
+                                                          {
+      if ((yyvsp[-3].strval) == nullptr) {
+        ABORT_OOM
+      }
+
+      auto direction = parser->ast()->createNodeTraversalDirection((yyvsp[-3].strval));
+
+      if (direction == nullptr) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'OUTBOUND', 'INBOUND' or 'ANY'", (yyvsp[-3].strval), yylloc.first_line, yylloc.first_column);
+      }
+
+      auto node = parser->ast()->createNodeArray();
+      node->addMember(direction);
+      node->addMember((yyvsp[-2].node));
+      node->addMember((yyvsp[-1].node));
+
+      if ((yyvsp[0].node) == nullptr) {
+        node->addMember(parser->ast()->createNodeNop());
+      }
+      else {
+        node->addMember((yyvsp[0].node));
+      }
+
+      (yyval.node) = node;
+    }
+#line 2193 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 25: /* traversal_edge_collection: "identifier"  */
+#line 315 "arangod/Aql/grammar.y"
+             {
+      if ((yyvsp[0].strval) == nullptr) {
+        ABORT_OOM
+      }
+
+      (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval), TRI_TRANSACTION_READ);
+    }
+#line 2205 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 26: /* traversal_edge_collection: "quoted string"  */
+#line 322 "arangod/Aql/grammar.y"
+                    {
+      if ((yyvsp[0].strval) == nullptr) {
+        ABORT_OOM
+      }
+
+      (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval), TRI_TRANSACTION_READ);
+    }
+#line 2217 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 27: /* traversal_edge_collection: "bind parameter"  */
+#line 329 "arangod/Aql/grammar.y"
+                {
+      if ((yyvsp[0].strval) == nullptr) {
+        ABORT_OOM
+      }
+      
+      if (strlen((yyvsp[0].strval)) < 2 || (yyvsp[0].strval)[0] != '@') {
+        parser->registerParseError(TRI_ERROR_QUERY_BIND_PARAMETER_TYPE, TRI_errno_string(TRI_ERROR_QUERY_BIND_PARAMETER_TYPE), (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
+      }
+
+      (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval));
+    }
+#line 2233 "arangod/Aql/grammar.cpp"
+    break;
+
+  case 28: /* filter_statement: "FILTER declaration" expression  */
+#line 343 "arangod/Aql/grammar.y"
+                        {
       // operand is a reference. can use it directly
       auto node = parser->ast()->createNodeFilter((yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1914 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2243 "arangod/Aql/grammar.cpp"
     break;
 
-  case 22:
-#line 275 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 29: /* let_statement: "LET declaration" let_list  */
+#line 351 "arangod/Aql/grammar.y"
+                   {
     }
-#line 1921 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2250 "arangod/Aql/grammar.cpp"
     break;
 
-  case 23:
-#line 280 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 30: /* let_list: let_element  */
+#line 356 "arangod/Aql/grammar.y"
+                {
     }
-#line 1928 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2257 "arangod/Aql/grammar.cpp"
     break;
 
-  case 24:
-#line 282 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 31: /* let_list: let_list "," let_element  */
+#line 358 "arangod/Aql/grammar.y"
+                                 {
     }
-#line 1935 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2264 "arangod/Aql/grammar.cpp"
     break;
 
-  case 25:
-#line 287 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 32: /* let_element: variable_name "assignment" expression  */
+#line 363 "arangod/Aql/grammar.y"
+                                      {
       auto node = parser->ast()->createNodeLet((yyvsp[-2].strval), (yyvsp[0].node), true);
       parser->ast()->addOperation(node);
     }
-#line 1944 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2273 "arangod/Aql/grammar.cpp"
     break;
 
-  case 26:
-#line 294 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 33: /* count_into: "WITH keyword" "identifier" "INTO keyword" variable_name  */
+#line 370 "arangod/Aql/grammar.y"
+                                         {
       if (! TRI_CaseEqualString((yyvsp[-2].strval), "COUNT")) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'COUNT'", (yyvsp[-2].strval), yylloc.first_line, yylloc.first_column);
       }
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 1956 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2285 "arangod/Aql/grammar.cpp"
     break;
 
-  case 27:
-#line 304 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 34: /* $@1: %empty  */
+#line 380 "arangod/Aql/grammar.y"
+              {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 1965 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2294 "arangod/Aql/grammar.cpp"
     break;
 
-  case 28:
-#line 307 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    { 
+  case 35: /* collect_variable_list: "COLLECT declaration" $@1 collect_list  */
+#line 383 "arangod/Aql/grammar.y"
+                   { 
       auto list = static_cast<AstNode*>(parser->popStack());
 
       if (list == nullptr) {
@@ -1974,12 +2303,12 @@ yyreduce:
       }
       (yyval.node) = list;
     }
-#line 1978 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2307 "arangod/Aql/grammar.cpp"
     break;
 
-  case 29:
-#line 318 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 36: /* collect_statement: "COLLECT declaration" count_into options  */
+#line 394 "arangod/Aql/grammar.y"
+                                 {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -1995,12 +2324,12 @@ yyreduce:
       auto node = parser->ast()->createNodeCollectCount(parser->ast()->createNodeArray(), (yyvsp[-1].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 1999 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2328 "arangod/Aql/grammar.cpp"
     break;
 
-  case 30:
-#line 334 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 37: /* collect_statement: collect_variable_list count_into options  */
+#line 410 "arangod/Aql/grammar.y"
+                                             {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -2027,12 +2356,12 @@ yyreduce:
       auto node = parser->ast()->createNodeCollectCount((yyvsp[-2].node), (yyvsp[-1].strval), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2031 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2360 "arangod/Aql/grammar.cpp"
     break;
 
-  case 31:
-#line 361 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 38: /* collect_statement: collect_variable_list optional_into options  */
+#line 437 "arangod/Aql/grammar.y"
+                                                {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -2059,12 +2388,12 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect((yyvsp[-2].node), (yyvsp[-1].strval), nullptr, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2063 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2392 "arangod/Aql/grammar.cpp"
     break;
 
-  case 32:
-#line 388 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 39: /* collect_statement: collect_variable_list optional_into keep options  */
+#line 464 "arangod/Aql/grammar.y"
+                                                     {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -2096,12 +2425,12 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect((yyvsp[-3].node), (yyvsp[-2].strval), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2100 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2429 "arangod/Aql/grammar.cpp"
     break;
 
-  case 33:
-#line 420 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 40: /* collect_statement: collect_variable_list "INTO keyword" variable_name "assignment" expression options  */
+#line 496 "arangod/Aql/grammar.y"
+                                                                           {
       auto scopes = parser->ast()->scopes();
 
       // check if we are in the main scope
@@ -2128,51 +2457,51 @@ yyreduce:
       auto node = parser->ast()->createNodeCollectExpression((yyvsp[-5].node), (yyvsp[-3].strval), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2132 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2461 "arangod/Aql/grammar.cpp"
     break;
 
-  case 34:
-#line 450 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 41: /* collect_list: collect_element  */
+#line 526 "arangod/Aql/grammar.y"
+                    {
     }
-#line 2139 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2468 "arangod/Aql/grammar.cpp"
     break;
 
-  case 35:
-#line 452 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 42: /* collect_list: collect_list "," collect_element  */
+#line 528 "arangod/Aql/grammar.y"
+                                         {
     }
-#line 2146 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2475 "arangod/Aql/grammar.cpp"
     break;
 
-  case 36:
-#line 457 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 43: /* collect_element: variable_name "assignment" expression  */
+#line 533 "arangod/Aql/grammar.y"
+                                      {
       auto node = parser->ast()->createNodeAssign((yyvsp[-2].strval), (yyvsp[0].node));
       parser->pushArrayElement(node);
     }
-#line 2155 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2484 "arangod/Aql/grammar.cpp"
     break;
 
-  case 37:
-#line 464 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 44: /* optional_into: %empty  */
+#line 540 "arangod/Aql/grammar.y"
+                {
       (yyval.strval) = nullptr;
     }
-#line 2163 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2492 "arangod/Aql/grammar.cpp"
     break;
 
-  case 38:
-#line 467 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 45: /* optional_into: "INTO keyword" variable_name  */
+#line 543 "arangod/Aql/grammar.y"
+                         {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 2171 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2500 "arangod/Aql/grammar.cpp"
     break;
 
-  case 39:
-#line 473 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 46: /* variable_list: variable_name  */
+#line 549 "arangod/Aql/grammar.y"
+                  {
       if (! parser->ast()->scopes()->existsVariable((yyvsp[0].strval))) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of unknown variable '%s' for KEEP", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
       }
@@ -2186,12 +2515,12 @@ yyreduce:
       node->setFlag(FLAG_KEEP_VARIABLENAME);
       parser->pushArrayElement(node);
     }
-#line 2190 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2519 "arangod/Aql/grammar.cpp"
     break;
 
-  case 40:
-#line 487 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 47: /* variable_list: variable_list "," variable_name  */
+#line 563 "arangod/Aql/grammar.y"
+                                        {
       if (! parser->ast()->scopes()->existsVariable((yyvsp[0].strval))) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of unknown variable '%s' for KEEP", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
       }
@@ -2205,12 +2534,12 @@ yyreduce:
       node->setFlag(FLAG_KEEP_VARIABLENAME);
       parser->pushArrayElement(node);
     }
-#line 2209 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2538 "arangod/Aql/grammar.cpp"
     break;
 
-  case 41:
-#line 504 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 48: /* $@2: %empty  */
+#line 580 "arangod/Aql/grammar.y"
+             {
       if (! TRI_CaseEqualString((yyvsp[0].strval), "KEEP")) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'KEEP'", (yyvsp[0].strval), yylloc.first_line, yylloc.first_column);
       }
@@ -2218,141 +2547,141 @@ yyreduce:
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2222 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2551 "arangod/Aql/grammar.cpp"
     break;
 
-  case 42:
-#line 511 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 49: /* keep: "identifier" $@2 variable_list  */
+#line 587 "arangod/Aql/grammar.y"
+                    {
       auto list = static_cast<AstNode*>(parser->popStack());
       (yyval.node) = list;
     }
-#line 2231 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2560 "arangod/Aql/grammar.cpp"
     break;
 
-  case 43:
-#line 518 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 50: /* $@3: %empty  */
+#line 594 "arangod/Aql/grammar.y"
+           {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2240 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2569 "arangod/Aql/grammar.cpp"
     break;
 
-  case 44:
-#line 521 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 51: /* sort_statement: "SORT declaration" $@3 sort_list  */
+#line 597 "arangod/Aql/grammar.y"
+                {
       auto list = static_cast<AstNode const*>(parser->popStack());
       auto node = parser->ast()->createNodeSort(list);
       parser->ast()->addOperation(node);
     }
-#line 2250 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2579 "arangod/Aql/grammar.cpp"
     break;
 
-  case 45:
-#line 529 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 52: /* sort_list: sort_element  */
+#line 605 "arangod/Aql/grammar.y"
+                 {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2258 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2587 "arangod/Aql/grammar.cpp"
     break;
 
-  case 46:
-#line 532 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 53: /* sort_list: sort_list "," sort_element  */
+#line 608 "arangod/Aql/grammar.y"
+                                   {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2266 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2595 "arangod/Aql/grammar.cpp"
     break;
 
-  case 47:
-#line 538 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 54: /* sort_element: expression sort_direction  */
+#line 614 "arangod/Aql/grammar.y"
+                              {
       (yyval.node) = parser->ast()->createNodeSortElement((yyvsp[-1].node), (yyvsp[0].node));
     }
-#line 2274 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2603 "arangod/Aql/grammar.cpp"
     break;
 
-  case 48:
-#line 544 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 55: /* sort_direction: %empty  */
+#line 620 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 2282 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2611 "arangod/Aql/grammar.cpp"
     break;
 
-  case 49:
-#line 547 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 56: /* sort_direction: "ASC keyword"  */
+#line 623 "arangod/Aql/grammar.y"
+          {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 2290 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2619 "arangod/Aql/grammar.cpp"
     break;
 
-  case 50:
-#line 550 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 57: /* sort_direction: "DESC keyword"  */
+#line 626 "arangod/Aql/grammar.y"
+           {
       (yyval.node) = parser->ast()->createNodeValueBool(false);
     }
-#line 2298 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2627 "arangod/Aql/grammar.cpp"
     break;
 
-  case 51:
-#line 553 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 58: /* sort_direction: simple_value  */
+#line 629 "arangod/Aql/grammar.y"
+                 {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2306 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2635 "arangod/Aql/grammar.cpp"
     break;
 
-  case 52:
-#line 559 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 59: /* limit_statement: "LIMIT declaration" simple_value  */
+#line 635 "arangod/Aql/grammar.y"
+                         {
       auto offset = parser->ast()->createNodeValueInt(0);
       auto node = parser->ast()->createNodeLimit(offset, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2316 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2645 "arangod/Aql/grammar.cpp"
     break;
 
-  case 53:
-#line 564 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 60: /* limit_statement: "LIMIT declaration" simple_value "," simple_value  */
+#line 640 "arangod/Aql/grammar.y"
+                                              {
       auto node = parser->ast()->createNodeLimit((yyvsp[-2].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2325 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2654 "arangod/Aql/grammar.cpp"
     break;
 
-  case 54:
-#line 571 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 61: /* return_statement: "RETURN declaration" expression  */
+#line 647 "arangod/Aql/grammar.y"
+                        {
       auto node = parser->ast()->createNodeReturn((yyvsp[0].node));
       parser->ast()->addOperation(node);
       parser->ast()->scopes()->endNested();
     }
-#line 2335 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2664 "arangod/Aql/grammar.cpp"
     break;
 
-  case 55:
-#line 579 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 62: /* in_or_into_collection: "IN keyword" collection_name  */
+#line 655 "arangod/Aql/grammar.y"
+                         {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2343 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2672 "arangod/Aql/grammar.cpp"
     break;
 
-  case 56:
-#line 582 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 63: /* in_or_into_collection: "INTO keyword" collection_name  */
+#line 658 "arangod/Aql/grammar.y"
+                           {
        (yyval.node) = (yyvsp[0].node);
      }
-#line 2351 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2680 "arangod/Aql/grammar.cpp"
     break;
 
-  case 57:
-#line 588 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 64: /* remove_statement: "REMOVE command" expression in_or_into_collection options  */
+#line 664 "arangod/Aql/grammar.y"
+                                                      {
       if (! parser->configureWriteQuery(AQL_QUERY_REMOVE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2360,12 +2689,12 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2364 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2693 "arangod/Aql/grammar.cpp"
     break;
 
-  case 58:
-#line 599 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 65: /* insert_statement: "INSERT command" expression in_or_into_collection options  */
+#line 675 "arangod/Aql/grammar.y"
+                                                      {
       if (! parser->configureWriteQuery(AQL_QUERY_INSERT, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2373,12 +2702,12 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2377 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2706 "arangod/Aql/grammar.cpp"
     break;
 
-  case 59:
-#line 610 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 66: /* update_parameters: expression in_or_into_collection options  */
+#line 686 "arangod/Aql/grammar.y"
+                                             {
       if (! parser->configureWriteQuery(AQL_QUERY_UPDATE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2387,12 +2716,12 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2391 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2720 "arangod/Aql/grammar.cpp"
     break;
 
-  case 60:
-#line 619 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 67: /* update_parameters: expression "WITH keyword" expression in_or_into_collection options  */
+#line 695 "arangod/Aql/grammar.y"
+                                                               {
       if (! parser->configureWriteQuery(AQL_QUERY_UPDATE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2401,19 +2730,19 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2405 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2734 "arangod/Aql/grammar.cpp"
     break;
 
-  case 61:
-#line 631 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 68: /* update_statement: "UPDATE command" update_parameters  */
+#line 707 "arangod/Aql/grammar.y"
+                               {
     }
-#line 2412 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2741 "arangod/Aql/grammar.cpp"
     break;
 
-  case 62:
-#line 636 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 69: /* replace_parameters: expression in_or_into_collection options  */
+#line 712 "arangod/Aql/grammar.y"
+                                             {
       if (! parser->configureWriteQuery(AQL_QUERY_REPLACE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2422,12 +2751,12 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2426 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2755 "arangod/Aql/grammar.cpp"
     break;
 
-  case 63:
-#line 645 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 70: /* replace_parameters: expression "WITH keyword" expression in_or_into_collection options  */
+#line 721 "arangod/Aql/grammar.y"
+                                                               {
       if (! parser->configureWriteQuery(AQL_QUERY_REPLACE, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2436,45 +2765,45 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2440 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2769 "arangod/Aql/grammar.cpp"
     break;
 
-  case 64:
-#line 657 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 71: /* replace_statement: "REPLACE command" replace_parameters  */
+#line 733 "arangod/Aql/grammar.y"
+                                 {
     }
-#line 2447 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2776 "arangod/Aql/grammar.cpp"
     break;
 
-  case 65:
-#line 662 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 72: /* update_or_replace: "UPDATE command"  */
+#line 738 "arangod/Aql/grammar.y"
+             {
       (yyval.intval) = static_cast<int64_t>(NODE_TYPE_UPDATE);
     }
-#line 2455 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2784 "arangod/Aql/grammar.cpp"
     break;
 
-  case 66:
-#line 665 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 73: /* update_or_replace: "REPLACE command"  */
+#line 741 "arangod/Aql/grammar.y"
+              {
       (yyval.intval) = static_cast<int64_t>(NODE_TYPE_REPLACE);
     }
-#line 2463 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2792 "arangod/Aql/grammar.cpp"
     break;
 
-  case 67:
-#line 671 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    { 
+  case 74: /* $@4: %empty  */
+#line 747 "arangod/Aql/grammar.y"
+             { 
       // reserve a variable named "$OLD", we might need it in the update expression
       // and in a later return thing
       parser->pushStack(parser->ast()->createNodeVariable(Variable::NAME_OLD, true));
     }
-#line 2473 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2802 "arangod/Aql/grammar.cpp"
     break;
 
-  case 68:
-#line 675 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 75: /* upsert_statement: "UPSERT command" $@4 expression "INSERT command" expression update_or_replace expression in_or_into_collection options  */
+#line 751 "arangod/Aql/grammar.y"
+                                                                                                {
       if (! parser->configureWriteQuery(AQL_QUERY_UPSERT, (yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
       }
@@ -2519,72 +2848,72 @@ yyreduce:
       parser->ast()->addOperation(node);
       parser->setWriteNode(node);
     }
-#line 2523 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2852 "arangod/Aql/grammar.cpp"
     break;
 
-  case 69:
-#line 723 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 76: /* expression: operator_unary  */
+#line 799 "arangod/Aql/grammar.y"
+                   {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2531 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2860 "arangod/Aql/grammar.cpp"
     break;
 
-  case 70:
-#line 726 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 77: /* expression: operator_binary  */
+#line 802 "arangod/Aql/grammar.y"
+                    {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2539 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2868 "arangod/Aql/grammar.cpp"
     break;
 
-  case 71:
-#line 729 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 78: /* expression: operator_ternary  */
+#line 805 "arangod/Aql/grammar.y"
+                     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2547 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2876 "arangod/Aql/grammar.cpp"
     break;
 
-  case 72:
-#line 732 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 79: /* expression: value_literal  */
+#line 808 "arangod/Aql/grammar.y"
+                  {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2555 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2884 "arangod/Aql/grammar.cpp"
     break;
 
-  case 73:
-#line 735 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 80: /* expression: reference  */
+#line 811 "arangod/Aql/grammar.y"
+              {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2563 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2892 "arangod/Aql/grammar.cpp"
     break;
 
-  case 74:
-#line 738 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 81: /* expression: expression ".." expression  */
+#line 814 "arangod/Aql/grammar.y"
+                                  {
       (yyval.node) = parser->ast()->createNodeRange((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2571 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2900 "arangod/Aql/grammar.cpp"
     break;
 
-  case 75:
-#line 744 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 82: /* function_name: "identifier"  */
+#line 820 "arangod/Aql/grammar.y"
+             {
       (yyval.strval) = (yyvsp[0].strval);
 
       if ((yyval.strval) == nullptr) {
         ABORT_OOM
       }
     }
-#line 2583 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2912 "arangod/Aql/grammar.cpp"
     break;
 
-  case 76:
-#line 751 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 83: /* function_name: function_name "::" "identifier"  */
+#line 827 "arangod/Aql/grammar.y"
+                                   {
       if ((yyvsp[-2].strval) == nullptr || (yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
@@ -2598,205 +2927,205 @@ yyreduce:
         ABORT_OOM
       }
     }
-#line 2602 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2931 "arangod/Aql/grammar.cpp"
     break;
 
-  case 77:
-#line 768 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 84: /* $@5: %empty  */
+#line 844 "arangod/Aql/grammar.y"
+                  {
       parser->pushStack((yyvsp[0].strval));
 
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2613 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2942 "arangod/Aql/grammar.cpp"
     break;
 
-  case 78:
-#line 773 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 85: /* function_call: function_name $@5 "(" optional_function_call_arguments ")"  */
+#line 849 "arangod/Aql/grammar.y"
+                                                                     {
       auto list = static_cast<AstNode const*>(parser->popStack());
       (yyval.node) = parser->ast()->createNodeFunctionCall(static_cast<char const*>(parser->popStack()), list);
     }
-#line 2622 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2951 "arangod/Aql/grammar.cpp"
     break;
 
-  case 79:
-#line 780 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 86: /* operator_unary: "+ operator" expression  */
+#line 856 "arangod/Aql/grammar.y"
+                                  {
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_PLUS, (yyvsp[0].node));
     }
-#line 2630 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2959 "arangod/Aql/grammar.cpp"
     break;
 
-  case 80:
-#line 783 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 87: /* operator_unary: "- operator" expression  */
+#line 859 "arangod/Aql/grammar.y"
+                                    {
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_MINUS, (yyvsp[0].node));
     }
-#line 2638 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2967 "arangod/Aql/grammar.cpp"
     break;
 
-  case 81:
-#line 786 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    { 
+  case 88: /* operator_unary: "not operator" expression  */
+#line 862 "arangod/Aql/grammar.y"
+                                 { 
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_NOT, (yyvsp[0].node));
     }
-#line 2646 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2975 "arangod/Aql/grammar.cpp"
     break;
 
-  case 82:
-#line 792 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 89: /* operator_binary: expression "or operator" expression  */
+#line 868 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_OR, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2654 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2983 "arangod/Aql/grammar.cpp"
     break;
 
-  case 83:
-#line 795 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 90: /* operator_binary: expression "and operator" expression  */
+#line 871 "arangod/Aql/grammar.y"
+                                {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2662 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2991 "arangod/Aql/grammar.cpp"
     break;
 
-  case 84:
-#line 798 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 91: /* operator_binary: expression "+ operator" expression  */
+#line 874 "arangod/Aql/grammar.y"
+                                 {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_PLUS, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2670 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 2999 "arangod/Aql/grammar.cpp"
     break;
 
-  case 85:
-#line 801 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 92: /* operator_binary: expression "- operator" expression  */
+#line 877 "arangod/Aql/grammar.y"
+                                  {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_MINUS, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2678 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3007 "arangod/Aql/grammar.cpp"
     break;
 
-  case 86:
-#line 804 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 93: /* operator_binary: expression "* operator" expression  */
+#line 880 "arangod/Aql/grammar.y"
+                                  {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_TIMES, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2686 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3015 "arangod/Aql/grammar.cpp"
     break;
 
-  case 87:
-#line 807 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 94: /* operator_binary: expression "/ operator" expression  */
+#line 883 "arangod/Aql/grammar.y"
+                                {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_DIV, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2694 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3023 "arangod/Aql/grammar.cpp"
     break;
 
-  case 88:
-#line 810 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 95: /* operator_binary: expression "% operator" expression  */
+#line 886 "arangod/Aql/grammar.y"
+                                {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_MOD, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2702 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3031 "arangod/Aql/grammar.cpp"
     break;
 
-  case 89:
-#line 813 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 96: /* operator_binary: expression "== operator" expression  */
+#line 889 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2710 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3039 "arangod/Aql/grammar.cpp"
     break;
 
-  case 90:
-#line 816 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 97: /* operator_binary: expression "!= operator" expression  */
+#line 892 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2718 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3047 "arangod/Aql/grammar.cpp"
     break;
 
-  case 91:
-#line 819 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 98: /* operator_binary: expression "< operator" expression  */
+#line 895 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LT, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2726 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3055 "arangod/Aql/grammar.cpp"
     break;
 
-  case 92:
-#line 822 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 99: /* operator_binary: expression "> operator" expression  */
+#line 898 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GT, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2734 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3063 "arangod/Aql/grammar.cpp"
     break;
 
-  case 93:
-#line 825 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 100: /* operator_binary: expression "<= operator" expression  */
+#line 901 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2742 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3071 "arangod/Aql/grammar.cpp"
     break;
 
-  case 94:
-#line 828 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 101: /* operator_binary: expression ">= operator" expression  */
+#line 904 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2750 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3079 "arangod/Aql/grammar.cpp"
     break;
 
-  case 95:
-#line 831 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 102: /* operator_binary: expression "IN keyword" expression  */
+#line 907 "arangod/Aql/grammar.y"
+                               {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_IN, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2758 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3087 "arangod/Aql/grammar.cpp"
     break;
 
-  case 96:
-#line 834 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 103: /* operator_binary: expression "not operator" "IN keyword" expression  */
+#line 910 "arangod/Aql/grammar.y"
+                                                 {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NIN, (yyvsp[-3].node), (yyvsp[0].node));
     }
-#line 2766 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3095 "arangod/Aql/grammar.cpp"
     break;
 
-  case 97:
-#line 840 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 104: /* operator_ternary: expression "?" expression ":" expression  */
+#line 916 "arangod/Aql/grammar.y"
+                                                        {
       (yyval.node) = parser->ast()->createNodeTernaryOperator((yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 2774 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3103 "arangod/Aql/grammar.cpp"
     break;
 
-  case 98:
-#line 846 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 105: /* optional_function_call_arguments: %empty  */
+#line 922 "arangod/Aql/grammar.y"
+                {
     }
-#line 2781 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3110 "arangod/Aql/grammar.cpp"
     break;
 
-  case 99:
-#line 848 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 106: /* optional_function_call_arguments: function_arguments_list  */
+#line 924 "arangod/Aql/grammar.y"
+                            {
     }
-#line 2788 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3117 "arangod/Aql/grammar.cpp"
     break;
 
-  case 100:
-#line 853 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 107: /* expression_or_query: expression  */
+#line 929 "arangod/Aql/grammar.y"
+               {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2796 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3125 "arangod/Aql/grammar.cpp"
     break;
 
-  case 101:
-#line 856 "arangod/Aql/grammar.y" /* yacc.c:1646  */
+  case 108: /* $@6: %empty  */
+#line 932 "arangod/Aql/grammar.y"
     {
       if (parser->isModificationQuery()) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected subquery after data-modification operation", yylloc.first_line, yylloc.first_column);
@@ -2804,12 +3133,12 @@ yyreduce:
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_SUBQUERY);
       parser->ast()->startSubQuery();
     }
-#line 2808 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3137 "arangod/Aql/grammar.cpp"
     break;
 
-  case 102:
-#line 862 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 109: /* expression_or_query: $@6 query  */
+#line 938 "arangod/Aql/grammar.y"
+            {
       AstNode* node = parser->ast()->endSubQuery();
       parser->ast()->scopes()->endCurrent();
 
@@ -2819,99 +3148,99 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeReference(variableName.c_str());
     }
-#line 2823 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3152 "arangod/Aql/grammar.cpp"
     break;
 
-  case 103:
-#line 875 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 110: /* function_arguments_list: expression_or_query  */
+#line 951 "arangod/Aql/grammar.y"
+                        {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2831 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3160 "arangod/Aql/grammar.cpp"
     break;
 
-  case 104:
-#line 878 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 111: /* function_arguments_list: function_arguments_list "," expression_or_query  */
+#line 954 "arangod/Aql/grammar.y"
+                                                        {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2839 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3168 "arangod/Aql/grammar.cpp"
     break;
 
-  case 105:
-#line 884 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 112: /* compound_value: array  */
+#line 960 "arangod/Aql/grammar.y"
+          {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2847 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3176 "arangod/Aql/grammar.cpp"
     break;
 
-  case 106:
-#line 887 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 113: /* compound_value: object  */
+#line 963 "arangod/Aql/grammar.y"
+           {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2855 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3184 "arangod/Aql/grammar.cpp"
     break;
 
-  case 107:
-#line 893 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 114: /* $@7: %empty  */
+#line 969 "arangod/Aql/grammar.y"
+                 {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2864 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3193 "arangod/Aql/grammar.cpp"
     break;
 
-  case 108:
-#line 896 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 115: /* array: "[" $@7 optional_array_elements "]"  */
+#line 972 "arangod/Aql/grammar.y"
+                                            {
       (yyval.node) = static_cast<AstNode*>(parser->popStack());
     }
-#line 2872 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3201 "arangod/Aql/grammar.cpp"
     break;
 
-  case 109:
-#line 902 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 116: /* optional_array_elements: %empty  */
+#line 978 "arangod/Aql/grammar.y"
+                {
     }
-#line 2879 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3208 "arangod/Aql/grammar.cpp"
     break;
 
-  case 110:
-#line 904 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 117: /* optional_array_elements: array_elements_list  */
+#line 980 "arangod/Aql/grammar.y"
+                        {
     }
-#line 2886 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3215 "arangod/Aql/grammar.cpp"
     break;
 
-  case 111:
-#line 909 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 118: /* array_elements_list: expression  */
+#line 985 "arangod/Aql/grammar.y"
+               {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2894 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3223 "arangod/Aql/grammar.cpp"
     break;
 
-  case 112:
-#line 912 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 119: /* array_elements_list: array_elements_list "," expression  */
+#line 988 "arangod/Aql/grammar.y"
+                                           {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2902 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3231 "arangod/Aql/grammar.cpp"
     break;
 
-  case 113:
-#line 918 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 120: /* options: %empty  */
+#line 994 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = nullptr;
     }
-#line 2910 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3239 "arangod/Aql/grammar.cpp"
     break;
 
-  case 114:
-#line 921 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 121: /* options: "identifier" object  */
+#line 997 "arangod/Aql/grammar.y"
+                    {
       if ((yyvsp[-1].strval) == nullptr || (yyvsp[0].node) == nullptr) {
         ABORT_OOM
       }
@@ -2922,73 +3251,73 @@ yyreduce:
 
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2926 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3255 "arangod/Aql/grammar.cpp"
     break;
 
-  case 115:
-#line 935 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 122: /* $@8: %empty  */
+#line 1011 "arangod/Aql/grammar.y"
+                  {
       auto node = parser->ast()->createNodeObject();
       parser->pushStack(node);
     }
-#line 2935 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3264 "arangod/Aql/grammar.cpp"
     break;
 
-  case 116:
-#line 938 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 123: /* object: "{" $@8 optional_object_elements "}"  */
+#line 1014 "arangod/Aql/grammar.y"
+                                              {
       (yyval.node) = static_cast<AstNode*>(parser->popStack());
     }
-#line 2943 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3272 "arangod/Aql/grammar.cpp"
     break;
 
-  case 117:
-#line 944 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 124: /* optional_object_elements: %empty  */
+#line 1020 "arangod/Aql/grammar.y"
+                {
     }
-#line 2950 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3279 "arangod/Aql/grammar.cpp"
     break;
 
-  case 118:
-#line 946 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 125: /* optional_object_elements: object_elements_list  */
+#line 1022 "arangod/Aql/grammar.y"
+                         {
     }
-#line 2957 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3286 "arangod/Aql/grammar.cpp"
     break;
 
-  case 119:
-#line 951 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 126: /* object_elements_list: object_element  */
+#line 1027 "arangod/Aql/grammar.y"
+                   {
     }
-#line 2964 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3293 "arangod/Aql/grammar.cpp"
     break;
 
-  case 120:
-#line 953 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 127: /* object_elements_list: object_elements_list "," object_element  */
+#line 1029 "arangod/Aql/grammar.y"
+                                                {
     }
-#line 2971 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3300 "arangod/Aql/grammar.cpp"
     break;
 
-  case 121:
-#line 958 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 128: /* object_element: object_element_name ":" expression  */
+#line 1034 "arangod/Aql/grammar.y"
+                                           {
       parser->pushObjectElement((yyvsp[-2].strval), (yyvsp[0].node));
     }
-#line 2979 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3308 "arangod/Aql/grammar.cpp"
     break;
 
-  case 122:
-#line 961 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 129: /* object_element: "[" expression "]" ":" expression  */
+#line 1037 "arangod/Aql/grammar.y"
+                                                             {
       parser->pushObjectElement((yyvsp[-3].node), (yyvsp[0].node));
     }
-#line 2987 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3316 "arangod/Aql/grammar.cpp"
     break;
 
-  case 123:
-#line 964 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 130: /* object_element: "bind parameter" ":" expression  */
+#line 1040 "arangod/Aql/grammar.y"
+                                   {
       if ((yyvsp[-2].strval) == nullptr) {
         ABORT_OOM
       }
@@ -3000,84 +3329,84 @@ yyreduce:
       auto param = parser->ast()->createNodeParameter((yyvsp[-2].strval));
       parser->pushObjectElement(param, (yyvsp[0].node));
     }
-#line 3004 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3333 "arangod/Aql/grammar.cpp"
     break;
 
-  case 124:
-#line 979 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 131: /* array_filter_operator: "* operator"  */
+#line 1055 "arangod/Aql/grammar.y"
+            {
       (yyval.intval) = 1;
     }
-#line 3012 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3341 "arangod/Aql/grammar.cpp"
     break;
 
-  case 125:
-#line 982 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 132: /* array_filter_operator: array_filter_operator "* operator"  */
+#line 1058 "arangod/Aql/grammar.y"
+                                  {
       (yyval.intval) = (yyvsp[-1].intval) + 1;
     }
-#line 3020 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3349 "arangod/Aql/grammar.cpp"
     break;
 
-  case 126:
-#line 988 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 133: /* optional_array_filter: %empty  */
+#line 1064 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = nullptr;
     }
-#line 3028 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3357 "arangod/Aql/grammar.cpp"
     break;
 
-  case 127:
-#line 991 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 134: /* optional_array_filter: "FILTER declaration" expression  */
+#line 1067 "arangod/Aql/grammar.y"
+                        {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3036 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3365 "arangod/Aql/grammar.cpp"
     break;
 
-  case 128:
-#line 997 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 135: /* optional_array_limit: %empty  */
+#line 1073 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = nullptr;
     }
-#line 3044 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3373 "arangod/Aql/grammar.cpp"
     break;
 
-  case 129:
-#line 1000 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 136: /* optional_array_limit: "LIMIT declaration" expression  */
+#line 1076 "arangod/Aql/grammar.y"
+                       {
       (yyval.node) = parser->ast()->createNodeArrayLimit(nullptr, (yyvsp[0].node));
     }
-#line 3052 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3381 "arangod/Aql/grammar.cpp"
     break;
 
-  case 130:
-#line 1003 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 137: /* optional_array_limit: "LIMIT declaration" expression "," expression  */
+#line 1079 "arangod/Aql/grammar.y"
+                                          {
       (yyval.node) = parser->ast()->createNodeArrayLimit((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3060 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3389 "arangod/Aql/grammar.cpp"
     break;
 
-  case 131:
-#line 1009 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 138: /* optional_array_return: %empty  */
+#line 1085 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = nullptr;
     }
-#line 3068 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3397 "arangod/Aql/grammar.cpp"
     break;
 
-  case 132:
-#line 1012 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 139: /* optional_array_return: "RETURN declaration" expression  */
+#line 1088 "arangod/Aql/grammar.y"
+                        {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3076 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3405 "arangod/Aql/grammar.cpp"
     break;
 
-  case 133:
-#line 1018 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 140: /* reference: "identifier"  */
+#line 1094 "arangod/Aql/grammar.y"
+             {
       // variable or collection
       auto ast = parser->ast();
       AstNode* node = nullptr;
@@ -3119,40 +3448,40 @@ yyreduce:
 
       (yyval.node) = node;
     }
-#line 3123 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3452 "arangod/Aql/grammar.cpp"
     break;
 
-  case 134:
-#line 1060 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 141: /* reference: compound_value  */
+#line 1136 "arangod/Aql/grammar.y"
+                   {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3131 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3460 "arangod/Aql/grammar.cpp"
     break;
 
-  case 135:
-#line 1063 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 142: /* reference: bind_parameter  */
+#line 1139 "arangod/Aql/grammar.y"
+                   {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3139 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3468 "arangod/Aql/grammar.cpp"
     break;
 
-  case 136:
-#line 1066 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 143: /* reference: function_call  */
+#line 1142 "arangod/Aql/grammar.y"
+                  {
       (yyval.node) = (yyvsp[0].node);
       
       if ((yyval.node) == nullptr) {
         ABORT_OOM
       }
     }
-#line 3151 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3480 "arangod/Aql/grammar.cpp"
     break;
 
-  case 137:
-#line 1073 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 144: /* reference: "(" expression ")"  */
+#line 1149 "arangod/Aql/grammar.y"
+                              {
       if ((yyvsp[-1].node)->type == NODE_TYPE_EXPANSION) {
         // create a dummy passthru node that reduces and evaluates the expansion first
         // and the expansion on top of the stack won't be chained with any other expansions
@@ -3162,24 +3491,24 @@ yyreduce:
         (yyval.node) = (yyvsp[-1].node);
       }
     }
-#line 3166 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3495 "arangod/Aql/grammar.cpp"
     break;
 
-  case 138:
-#line 1083 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 145: /* $@9: %empty  */
+#line 1159 "arangod/Aql/grammar.y"
+           {
       if (parser->isModificationQuery()) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected subquery after data-modification operation", yylloc.first_line, yylloc.first_column);
       }
       parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_SUBQUERY);
       parser->ast()->startSubQuery();
     }
-#line 3178 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3507 "arangod/Aql/grammar.cpp"
     break;
 
-  case 139:
-#line 1089 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 146: /* reference: "(" $@9 query ")"  */
+#line 1165 "arangod/Aql/grammar.y"
+                    {
       AstNode* node = parser->ast()->endSubQuery();
       parser->ast()->scopes()->endCurrent();
 
@@ -3189,12 +3518,12 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeReference(variableName.c_str());
     }
-#line 3193 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3522 "arangod/Aql/grammar.cpp"
     break;
 
-  case 140:
-#line 1099 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 147: /* reference: reference '.' "identifier"  */
+#line 1175 "arangod/Aql/grammar.y"
+                                           {
       // named variable access, e.g. variable.reference
       if ((yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
         // if left operand is an expansion already...
@@ -3209,12 +3538,12 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeAttributeAccess((yyvsp[-2].node), (yyvsp[0].strval));
       }
     }
-#line 3213 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3542 "arangod/Aql/grammar.cpp"
     break;
 
-  case 141:
-#line 1114 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 148: /* reference: reference '.' bind_parameter  */
+#line 1190 "arangod/Aql/grammar.y"
+                                                 {
       // named variable access, e.g. variable.@reference
       if ((yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
         // if left operand is an expansion already...
@@ -3228,12 +3557,12 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeBoundAttributeAccess((yyvsp[-2].node), (yyvsp[0].node));
       }
     }
-#line 3232 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3561 "arangod/Aql/grammar.cpp"
     break;
 
-  case 142:
-#line 1128 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 149: /* reference: reference "[" expression "]"  */
+#line 1204 "arangod/Aql/grammar.y"
+                                                                  {
       // indexed variable access, e.g. variable[index]
       if ((yyvsp[-3].node)->type == NODE_TYPE_EXPANSION) {
         // if left operand is an expansion already...
@@ -3247,12 +3576,12 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeIndexedAccess((yyvsp[-3].node), (yyvsp[-1].node));
       }
     }
-#line 3251 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3580 "arangod/Aql/grammar.cpp"
     break;
 
-  case 143:
-#line 1142 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 150: /* $@10: %empty  */
+#line 1218 "arangod/Aql/grammar.y"
+                                                 {
       // variable expansion, e.g. variable[*], with optional FILTER, LIMIT and RETURN clauses
       if ((yyvsp[0].intval) > 1 && (yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
         // create a dummy passthru node that reduces and evaluates the expansion first
@@ -3276,12 +3605,12 @@ yyreduce:
       auto scopes = parser->ast()->scopes();
       scopes->stackCurrentVariable(scopes->getVariable(iteratorName));
     }
-#line 3280 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3609 "arangod/Aql/grammar.cpp"
     break;
 
-  case 144:
-#line 1165 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 151: /* reference: reference "[" array_filter_operator $@10 optional_array_filter optional_array_limit optional_array_return "]"  */
+#line 1241 "arangod/Aql/grammar.y"
+                                                                                                     {
       auto scopes = parser->ast()->scopes();
       scopes->unstackCurrentVariable();
 
@@ -3299,116 +3628,116 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeExpansion((yyvsp[-5].intval), iterator, parser->ast()->createNodeReference(variable->name.c_str()), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node));
       }
     }
-#line 3303 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3632 "arangod/Aql/grammar.cpp"
     break;
 
-  case 145:
-#line 1186 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 152: /* simple_value: value_literal  */
+#line 1262 "arangod/Aql/grammar.y"
+                  {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3311 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3640 "arangod/Aql/grammar.cpp"
     break;
 
-  case 146:
-#line 1189 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 153: /* simple_value: bind_parameter  */
+#line 1265 "arangod/Aql/grammar.y"
+                   {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3319 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3648 "arangod/Aql/grammar.cpp"
     break;
 
-  case 147:
-#line 1195 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 154: /* numeric_value: "integer number"  */
+#line 1271 "arangod/Aql/grammar.y"
+              {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
       }
       
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3331 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3660 "arangod/Aql/grammar.cpp"
     break;
 
-  case 148:
-#line 1202 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 155: /* numeric_value: "number"  */
+#line 1278 "arangod/Aql/grammar.y"
+             {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3343 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3672 "arangod/Aql/grammar.cpp"
     break;
 
-  case 149:
-#line 1212 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 156: /* value_literal: "quoted string"  */
+#line 1288 "arangod/Aql/grammar.y"
+                    {
       (yyval.node) = parser->ast()->createNodeValueString((yyvsp[0].strval)); 
     }
-#line 3351 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3680 "arangod/Aql/grammar.cpp"
     break;
 
-  case 150:
-#line 1215 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 157: /* value_literal: numeric_value  */
+#line 1291 "arangod/Aql/grammar.y"
+                  {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3359 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3688 "arangod/Aql/grammar.cpp"
     break;
 
-  case 151:
-#line 1218 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 158: /* value_literal: "null"  */
+#line 1294 "arangod/Aql/grammar.y"
+           {
       (yyval.node) = parser->ast()->createNodeValueNull();
     }
-#line 3367 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3696 "arangod/Aql/grammar.cpp"
     break;
 
-  case 152:
-#line 1221 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 159: /* value_literal: "true"  */
+#line 1297 "arangod/Aql/grammar.y"
+           {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 3375 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3704 "arangod/Aql/grammar.cpp"
     break;
 
-  case 153:
-#line 1224 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 160: /* value_literal: "false"  */
+#line 1300 "arangod/Aql/grammar.y"
+            {
       (yyval.node) = parser->ast()->createNodeValueBool(false);
     }
-#line 3383 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3712 "arangod/Aql/grammar.cpp"
     break;
 
-  case 154:
-#line 1230 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 161: /* collection_name: "identifier"  */
+#line 1306 "arangod/Aql/grammar.y"
+             {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval), TRI_TRANSACTION_WRITE);
     }
-#line 3395 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3724 "arangod/Aql/grammar.cpp"
     break;
 
-  case 155:
-#line 1237 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 162: /* collection_name: "quoted string"  */
+#line 1313 "arangod/Aql/grammar.y"
+                    {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval), TRI_TRANSACTION_WRITE);
     }
-#line 3407 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3736 "arangod/Aql/grammar.cpp"
     break;
 
-  case 156:
-#line 1244 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 163: /* collection_name: "bind parameter"  */
+#line 1320 "arangod/Aql/grammar.y"
+                {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
@@ -3419,51 +3748,52 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval));
     }
-#line 3423 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3752 "arangod/Aql/grammar.cpp"
     break;
 
-  case 157:
-#line 1258 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 164: /* bind_parameter: "bind parameter"  */
+#line 1334 "arangod/Aql/grammar.y"
+                {
       (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval));
     }
-#line 3431 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3760 "arangod/Aql/grammar.cpp"
     break;
 
-  case 158:
-#line 1264 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 165: /* object_element_name: "identifier"  */
+#line 1340 "arangod/Aql/grammar.y"
+             {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3443 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3772 "arangod/Aql/grammar.cpp"
     break;
 
-  case 159:
-#line 1271 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 166: /* object_element_name: "quoted string"  */
+#line 1347 "arangod/Aql/grammar.y"
+                    {
       if ((yyvsp[0].strval) == nullptr) {
         ABORT_OOM
       }
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3455 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3784 "arangod/Aql/grammar.cpp"
     break;
 
-  case 160:
-#line 1280 "arangod/Aql/grammar.y" /* yacc.c:1646  */
-    {
+  case 167: /* variable_name: "identifier"  */
+#line 1356 "arangod/Aql/grammar.y"
+             {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3463 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3792 "arangod/Aql/grammar.cpp"
     break;
 
 
-#line 3467 "arangod/Aql/grammar.cpp" /* yacc.c:1646  */
+#line 3796 "arangod/Aql/grammar.cpp"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -3477,11 +3807,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -3489,14 +3818,13 @@ yyreduce:
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -3507,59 +3835,54 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, parser, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (&yylloc, parser, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
          error, discard it.  */
 
-      if (yychar <= YYEOF)
+      if (yychar <= T_END)
         {
           /* Return failure if at end of input.  */
-          if (yychar == YYEOF)
+          if (yychar == T_END)
             YYABORT;
         }
       else
@@ -3579,14 +3902,12 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[1] = yylsp[1-yylen];
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
@@ -3602,13 +3923,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -3622,7 +3944,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp, parser);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, parser);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -3633,13 +3955,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3650,26 +3970,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (&yylloc, parser, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -3685,16 +4009,15 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, yylsp, parser);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, parser);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
+
@@ -189,6 +189,8 @@ void Aqlerror (YYLTYPE* locp,
 %type <node> value_literal;
 %type <node> collection_name;
 %type <node> in_or_into_collection;
+%type <node> traversal_graph_info;
+%type <node> traversal_edge_collection;
 %type <node> bind_parameter;
 %type <strval> variable_name;
 %type <node> numeric_value;
@@ -261,6 +263,80 @@ for_statement:
       auto node = parser->ast()->createNodeFor($2, $4);
       parser->ast()->addOperation(node);
     }
+  | T_FOR variable_name T_IN expression traversal_graph_info {
+      parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
+
+      auto node = parser->ast()->createNodeTraversal($2, nullptr, nullptr, $4, $5);
+      parser->ast()->addOperation(node);
+    }
+  | T_FOR variable_name T_COMMA variable_name T_IN expression traversal_graph_info {
+      parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
+
+      auto node = parser->ast()->createNodeTraversal($2, $4, nullptr, $6, $7);
+      parser->ast()->addOperation(node);
+    }
+  | T_FOR variable_name T_COMMA variable_name T_COMMA variable_name T_IN expression traversal_graph_info {
+      parser->ast()->scopes()->start(triagens::aql::AQL_SCOPE_FOR);
+
+      auto node = parser->ast()->createNodeTraversal($2, $4, $6, $8, $9);
+      parser->ast()->addOperation(node);
+    }
+  ;
+
+traversal_graph_info:
+    T_STRING expression traversal_edge_collection options {
+      if ($1 == nullptr) {
+        ABORT_OOM
+      }
+
+      auto direction = parser->ast()->createNodeTraversalDirection($1);
+
+      if (direction == nullptr) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'OUTBOUND', 'INBOUND' or 'ANY'", $1, yylloc.first_line, yylloc.first_column);
+      }
+
+      auto node = parser->ast()->createNodeArray();
+      node->addMember(direction);
+      node->addMember($2);
+      node->addMember($3);
+
+      if ($4 == nullptr) {
+        node->addMember(parser->ast()->createNodeNop());
+      }
+      else {
+        node->addMember($4);
+      }
+
+      $$ = node;
+    }
+  ;
+
+traversal_edge_collection:
+    T_STRING {
+      if ($1 == nullptr) {
+        ABORT_OOM
+      }
+
+      $$ = parser->ast()->createNodeCollection($1, TRI_TRANSACTION_READ);
+    }
+  | T_QUOTED_STRING {
+      if ($1 == nullptr) {
+        ABORT_OOM
+      }
+
+      $$ = parser->ast()->createNodeCollection($1, TRI_TRANSACTION_READ);
+    }
+  | T_PARAMETER {
+      if ($1 == nullptr) {
+        ABORT_OOM
+      }
+      
+      if (strlen($1) < 2 || $1[0] != '@') {
+        parser->registerParseError(TRI_ERROR_QUERY_BIND_PARAMETER_TYPE, TRI_errno_string(TRI_ERROR_QUERY_BIND_PARAMETER_TYPE), $1, yylloc.first_line, yylloc.first_column);
+      }
+
+      $$ = parser->ast()->createNodeParameter($1);
+    }
   ;
 
 filter_statement:
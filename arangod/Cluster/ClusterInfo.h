@@ -156,6 +156,14 @@ namespace triagens {
           return triagens::basics::JsonHelper::getBooleanValue(_json, "doCompact", false);
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the compressdatafiles flag
+////////////////////////////////////////////////////////////////////////////////
+
+        bool compressDatafiles () const {
+          return triagens::basics::JsonHelper::getBooleanValue(_json, "compressDatafiles", false);
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the issystem flag
 ////////////////////////////////////////////////////////////////////////////////
@@ -541,14 +541,18 @@ int TRI_LookupByKeyHashArrayMulti (TRI_hash_array_multi_t const* array,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief lookups an element given a key and a state
+/// @brief lookups an element given a key and a state. if subObjects is not a
+/// nullptr, copies of the sub-objects of the found elements are appended to
+/// it, _numFields per element. the elements themselves may be freed by a
+/// later removal, so no pointers to them must be handed out
 ////////////////////////////////////////////////////////////////////////////////
 
 int TRI_LookupByKeyHashArrayMulti (TRI_hash_array_multi_t const* array,
                                    TRI_index_search_value_t const* key,
                                    std::vector<TRI_doc_mptr_copy_t>& result,
                                    TRI_hash_index_element_multi_t*& next,
-                                   size_t batchSize) {
+                                   size_t batchSize,
+                                   std::vector<TRI_shaped_sub_t>* subObjects) {
   size_t const initialSize = result.size();
   TRI_ASSERT_EXPENSIVE(array->_nrUsed < array->_nrAlloc);
   TRI_ASSERT(batchSize > 0);
@@ -569,6 +573,10 @@ int TRI_LookupByKeyHashArrayMulti (TRI_hash_array_multi_t const* array,
 
     if (array->_table[i]._document != nullptr) {
       result.emplace_back(*(array->_table[i]._document));
+
+      if (subObjects != nullptr) {
+        subObjects->insert(subObjects->end(), array->_table[i]._subObjects, array->_table[i]._subObjects + array->_numFields);
+      }
     }
     next = array->_table[i]._next;
   }
@@ -579,6 +587,10 @@ int TRI_LookupByKeyHashArrayMulti (TRI_hash_array_multi_t const* array,
 
     while (next != nullptr && total < batchSize) {
       result.emplace_back(*(next->_document));
+
+      if (subObjects != nullptr) {
+        subObjects->insert(subObjects->end(), next->_subObjects, next->_subObjects + array->_numFields);
+      }
       next = next->_next;
       ++total;
     }
@@ -44,6 +44,7 @@
 struct TRI_hash_index_element_overflow_s;
 struct TRI_hash_index_element_multi_s;
 struct TRI_index_search_value_s;
+struct TRI_shaped_sub_s;
 
 namespace triagens {
   namespace arango {
@@ -137,14 +138,16 @@ int TRI_LookupByKeyHashArrayMulti (TRI_hash_array_multi_t const*,
                                    std::vector<TRI_doc_mptr_copy_t>&);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief lookups an element given a key
+/// @brief lookups an element given a key and a state. if the last argument
+/// is not a nullptr, the sub-objects of the found elements are appended to it
 ////////////////////////////////////////////////////////////////////////////////
 
 int TRI_LookupByKeyHashArrayMulti (TRI_hash_array_multi_t const*,
                                    struct TRI_index_search_value_s const*,
                                    std::vector<TRI_doc_mptr_copy_t>&,
                                    struct TRI_hash_index_element_multi_s*&,
-                                   size_t);
+                                   size_t,
+                                   std::vector<struct TRI_shaped_sub_s>*);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief adds an element to the array
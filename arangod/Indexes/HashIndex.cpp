@@ -223,7 +223,8 @@ static TRI_vector_pointer_t HashIndex_find (TRI_hash_array_t const* hashArray,
 
 static int HashIndex_find (TRI_hash_array_t const* hashArray,
                            TRI_index_search_value_t* key,
-                           std::vector<TRI_doc_mptr_copy_t>& result) {
+                           std::vector<TRI_doc_mptr_copy_t>& result,
+                           std::vector<TRI_shaped_sub_t>* subObjects) {
 
   // .............................................................................
   // A find request means that a set of values for the "key" was sent. We need
@@ -235,6 +236,10 @@ static int HashIndex_find (TRI_hash_array_t const* hashArray,
   if (found != nullptr) {
     // unique hash index: maximum number is 1
     result.emplace_back(*(found->_document));
+
+    if (subObjects != nullptr) {
+      subObjects->insert(subObjects->end(), found->_subObjects, found->_subObjects + hashArray->_numFields);
+    }
   }
 
   return TRI_ERROR_NO_ERROR;
@@ -393,7 +398,7 @@ int HashIndex::lookup (TRI_index_search_value_t* searchValue,
                        std::vector<TRI_doc_mptr_copy_t>& documents) const {
 
   if (_unique) {
-    return HashIndex_find(&_hashArray, searchValue, documents);
+    return HashIndex_find(&_hashArray, searchValue, documents, nullptr);
   }
 
   return TRI_LookupByKeyHashArrayMulti(&_hashArrayMulti, searchValue, documents);
@@ -410,10 +415,31 @@ int HashIndex::lookup (TRI_index_search_value_t* searchValue,
 
   if (_unique) {
     next = nullptr;
-    return HashIndex_find(&_hashArray, searchValue, documents);
+    return HashIndex_find(&_hashArray, searchValue, documents, nullptr);
+  }
+
+  return TRI_LookupByKeyHashArrayMulti(&_hashArrayMulti, searchValue, documents, next, batchSize, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief locates entries in the hash index given shaped json objects, and
+/// also returns copies of the sub-objects of the found index elements, one
+/// per indexed field and element. the sub-objects hold the indexed attribute
+/// values of the documents
+////////////////////////////////////////////////////////////////////////////////
+
+int HashIndex::lookup (TRI_index_search_value_t* searchValue,
+                       std::vector<TRI_doc_mptr_copy_t>& documents,
+                       std::vector<TRI_shaped_sub_t>& subObjects,
+                       struct TRI_hash_index_element_multi_s*& next,
+                       size_t batchSize) const {
+
+  if (_unique) {
+    next = nullptr;
+    return HashIndex_find(&_hashArray, searchValue, documents, &subObjects);
   }
 
-  return TRI_LookupByKeyHashArrayMulti(&_hashArrayMulti, searchValue, documents, next, batchSize);
+  return TRI_LookupByKeyHashArrayMulti(&_hashArrayMulti, searchValue, documents, next, batchSize, &subObjects);
 }
 
 // -----------------------------------------------------------------------------
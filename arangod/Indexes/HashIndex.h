@@ -136,6 +136,17 @@ namespace triagens {
                     struct TRI_hash_index_element_multi_s*&,
                     size_t batchSize) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief locates entries in the hash index given shaped json objects, and
+/// returns copies of the sub-objects of the found index elements, too
+////////////////////////////////////////////////////////////////////////////////
+
+        int lookup (TRI_index_search_value_t*,
+                    std::vector<TRI_doc_mptr_copy_t>&,
+                    std::vector<TRI_shaped_sub_t>&,
+                    struct TRI_hash_index_element_multi_s*&,
+                    size_t batchSize) const;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -625,6 +625,7 @@ int ContinuousSyncer::changeCollection (TRI_json_t const* json) {
 
   bool waitForSync = JsonHelper::getBooleanValue(collectionJson, "waitForSync", false);
   bool doCompact   = JsonHelper::getBooleanValue(collectionJson, "doCompact", true);
+  bool compressDatafiles = JsonHelper::getBooleanValue(collectionJson, "compressDatafiles", false);
   int maximalSize  = JsonHelper::getNumericValue<int>(collectionJson, "maximalSize", TRI_JOURNAL_DEFAULT_MAXIMAL_SIZE);
 
   TRI_voc_cid_t cid = getCid(json);
@@ -639,10 +640,11 @@ int ContinuousSyncer::changeCollection (TRI_json_t const* json) {
 
     TRI_col_info_t parameters;
 
-    // only need to set these three properties as the others cannot be updated on the fly
+    // only need to set these properties as the others cannot be updated on the fly
     parameters._doCompact   = doCompact;
     parameters._maximalSize = maximalSize;
     parameters._waitForSync = waitForSync;
+    parameters._compressDatafiles = compressDatafiles;
 
     bool doSync = _vocbase->_settings.forceSyncProperties;
     return TRI_UpdateCollectionInfo(_vocbase, guard.collection()->_collection, &parameters, doSync);
@@ -139,6 +139,11 @@ void RestCursorHandler::processQuery (TRI_json_t const* json) {
   
   auto options = buildOptions(json);
 
+  if (triagens::basics::JsonHelper::getBooleanValue(options.json(), "stream", false)) {
+    processStreamingQuery(queryString, bindVars, options);
+    return;
+  }
+
   triagens::aql::Query query(_applicationV8, 
                              false, 
                              _vocbase, 
@@ -244,6 +249,66 @@ void RestCursorHandler::processQuery (TRI_json_t const* json) {
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepares a query and returns its results via a streaming cursor.
+/// the query is not executed completely upfront, but its results are produced
+/// batch by batch whenever the client requests more data
+////////////////////////////////////////////////////////////////////////////////
+
+void RestCursorHandler::processStreamingQuery (TRI_json_t const* queryString,
+                                               TRI_json_t const* bindVars,
+                                               triagens::basics::Json const& options) {
+  std::unique_ptr<triagens::aql::Query> query(new triagens::aql::Query(
+    _applicationV8, 
+    false, 
+    _vocbase, 
+    queryString->_value._string.data,
+    static_cast<size_t>(queryString->_value._string.length - 1),
+    (bindVars != nullptr ? TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, bindVars) : nullptr),
+    TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, options.json()), 
+    triagens::aql::PART_MAIN
+  ));
+
+  registerQuery(query.get()); 
+  auto queryResult = query->prepare(_queryRegistry);
+  unregisterQuery(); 
+
+  if (queryResult.code != TRI_ERROR_NO_ERROR) {
+    if (queryResult.code == TRI_ERROR_REQUEST_CANCELED ||
+        (queryResult.code == TRI_ERROR_QUERY_KILLED && wasCancelled())) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_REQUEST_CANCELED);
+    }
+
+    THROW_ARANGO_EXCEPTION_MESSAGE(queryResult.code, queryResult.details);
+  }
+
+  _response = createResponse(HttpResponse::CREATED);
+  _response->setContentType("application/json; charset=utf-8");
+
+  auto cursors = static_cast<triagens::arango::CursorRepository*>(_vocbase->_cursorRepository);
+  TRI_ASSERT(cursors != nullptr);
+
+  size_t batchSize = triagens::basics::JsonHelper::getNumericValue<size_t>(options.json(), "batchSize", 1000);
+  double ttl = triagens::basics::JsonHelper::getNumericValue<double>(options.json(), "ttl", 30);
+
+  // the cursor will take over the ownership of the query
+  triagens::arango::QueryStreamCursor* cursor = cursors->createFromQuery(query.release(), batchSize, ttl);
+
+  try {
+    _response->body().appendChar('{');
+    cursor->dump(_response->body());
+    _response->body().appendText(",\"error\":false,\"code\":");
+    _response->body().appendInteger(static_cast<uint32_t>(_response->responseCode()));
+    _response->body().appendChar('}');
+
+    cursors->release(cursor);
+  }
+  catch (...) {
+    cursors->release(cursor);
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief register the currently running query
 ////////////////////////////////////////////////////////////////////////////////
@@ -440,18 +505,49 @@ triagens::basics::Json RestCursorHandler::buildExtra (triagens::aql::QueryResult
 ///   be present in the result if the query has a LIMIT clause and the LIMIT clause is
 ///   actually used in the query.
 ///
+/// - *maxParallelism*: maximum number of threads a full collection scan may
+///   use for evaluating the *FILTER* conditions that directly follow it. The
+///   value is capped by the number of available processors. If not set or set to
+///   *1*, collection scans are performed by a single thread.
+///
 /// - *maxPlans*: limits the maximum number of plans that are created by the AQL
 ///   query optimizer.
 ///
+/// - *memoryLimit*: maximum number of bytes the query may use. The memory
+///   used by the query's intermediate results, its *SORT*, *COLLECT* and
+///   subquery buffers and the result is tracked, and the query is aborted with
+///   error *resource limit exceeded* as soon as it exceeds the limit. In a
+///   cluster, the limit applies to each part of the query separately. If not
+///   set or set to *0*, the memory usage is not limited.
+///
 /// - *optimizer.rules*: a list of to-be-included or to-be-excluded optimizer rules
 ///   can be put into this attribute, telling the optimizer to include or exclude
 ///   specific rules. To disable a rule, prefix its name with a `-`, to enable a rule, prefix it
 ///   with a `+`. There is also a pseudo-rule `all`, which will match all optimizer rules.
 ///
+/// - *planCache*: if set to *false*, the query will neither use nor populate the
+///   AQL plan cache, but will always be parsed and optimized. The plan cache keeps
+///   the optimized execution plans of queries with identical query strings, bind
+///   parameter values and optimizer options. It is enabled by default.
+///
 /// - *profile*: if set to *true*, then the additional query profiling information
 ///   will be returned in the *extra.stats* return attribute if the query result is not
 ///   served from the query cache.
 ///
+/// - *sortMemoryLimit*: maximum number of bytes a *SORT* operation may buffer in
+///   memory. If the limit is exceeded, the buffered data is sorted and written to a
+///   temporary file, and the sorted files are merged afterwards. If not set or set
+///   to *0*, sorting is always performed in memory.
+///
+/// - *stream*: if set to *true*, the query result is not computed completely
+///   upfront. Instead, the query is kept alive on the server and each batch is
+///   produced when it is requested by the client. This keeps the memory usage of
+///   queries with big results low. Streaming queries do not support the *count*
+///   option, are not served from or stored in the query cache, and return the
+///   *extra* attribute only with the last batch. The query's transaction and its
+///   collection locks are held until the cursor is exhausted, deleted or has
+///   expired.
+///
 /// If the result set can be created by the server, the server will respond with
 /// *HTTP 201*. The body of the response will contain a JSON object with the
 /// result set.
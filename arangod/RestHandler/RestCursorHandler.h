@@ -107,6 +107,14 @@ namespace triagens {
 
       private:
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepares a query and returns its results via a streaming cursor
+////////////////////////////////////////////////////////////////////////////////
+
+        void processStreamingQuery (struct TRI_json_t const*,
+                                    struct TRI_json_t const*,
+                                    triagens::basics::Json const&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief register the currently running query
 ////////////////////////////////////////////////////////////////////////////////
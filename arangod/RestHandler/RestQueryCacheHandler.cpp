@@ -30,6 +30,7 @@
 #include "RestQueryCacheHandler.h"
 
 #include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Rest/HttpRequest.h"
 
 using namespace std;
@@ -71,9 +72,13 @@ HttpHandler::status_t RestQueryCacheHandler::execute () {
   // extract the sub-request type
   HttpRequest::HttpRequestType type = _request->requestType();
 
+  // requests for the plan cache
+  auto const& suffix = _request->suffix();
+  bool const plans = (suffix.size() == 1 && suffix[0] == "plans");
+
   switch (type) {
-    case HttpRequest::HTTP_REQUEST_DELETE: clearCache(); break;
-    case HttpRequest::HTTP_REQUEST_GET:    readProperties(); break;
+    case HttpRequest::HTTP_REQUEST_DELETE: plans ? clearPlanCache() : clearCache(); break;
+    case HttpRequest::HTTP_REQUEST_GET:    plans ? readPlanCacheStatistics() : readProperties(); break;
     case HttpRequest::HTTP_REQUEST_PUT:    replaceProperties(); break;
 
     case HttpRequest::HTTP_REQUEST_POST:   
@@ -124,6 +129,92 @@ bool RestQueryCacheHandler::clearCache () {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clears the AQL plan cache
+/// @startDocuBlock DeleteApiQueryCachePlans
+/// @RESTHEADER{DELETE /_api/query-cache/plans, Clears all plans in the AQL plan cache}
+///
+/// Removes all optimized execution plans from the plan cache. The hit and miss
+/// counters are not reset.
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// The server will respond with *HTTP 200* when the plan cache was cleared
+/// successfully.
+///
+/// @RESTRETURNCODE{400}
+/// The server will respond with *HTTP 400* in case of a malformed request.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryCacheHandler::clearPlanCache () {
+  auto planCache = triagens::aql::QueryPlanCache::instance();
+  planCache->invalidate();
+
+  Json result(Json::Object, 2);
+
+  result
+  .set("error", Json(false))
+  .set("code", Json(HttpResponse::OK));
+
+  generateResult(HttpResponse::OK, result.json());
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the figures of the AQL plan cache
+/// @startDocuBlock GetApiQueryCachePlans
+/// @RESTHEADER{GET /_api/query-cache/plans, Returns the figures of the AQL plan cache}
+///
+/// Returns the figures of the AQL plan cache, which keeps optimized execution
+/// plans of queries so they can be reused when the same query is executed
+/// again with the same bind parameter names and optimizer options. The result
+/// is a JSON object with the following attributes:
+///
+/// - *maxPlans*: the maximum number of plans that will be stored per
+///   database. A value of *0* means the plan cache is turned off.
+///
+/// - *plans*: the number of plans currently stored for all databases.
+///
+/// - *hits*: the number of queries that used a cached plan.
+///
+/// - *misses*: the number of queries that had to be parsed and optimized
+///   because there was no cached plan.
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// Is returned if the figures can be retrieved successfully.
+///
+/// @RESTRETURNCODE{400}
+/// The server will respond with *HTTP 400* in case of a malformed request,
+///
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryCacheHandler::readPlanCacheStatistics () {
+  try {
+    auto planCache = triagens::aql::QueryPlanCache::instance();
+
+    Json result = planCache->statistics();
+    generateResult(HttpResponse::OK, result.json());
+  }
+  catch (Exception const& err) {
+    handleError(err);
+  }
+  catch (std::exception const& ex) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, ex.what(), __FILE__, __LINE__);
+    handleError(err);
+  }
+  catch (...) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, __FILE__, __LINE__);
+    handleError(err);
+  }
+
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the global configuration for the AQL query cache
 /// @startDocuBlock GetApiQueryCacheProperties
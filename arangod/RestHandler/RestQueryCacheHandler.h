@@ -100,6 +100,18 @@ namespace triagens {
 
         bool clearCache ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the figures of the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool readPlanCacheStatistics ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clears the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool clearPlanCache ();
+
     };
   }
 }
@@ -200,6 +200,9 @@ bool RestQueryHandler::readQueryProperties () {
 /// - *runTime*: the query's run time up to the point the list of queries was
 ///   queried
 ///
+/// - *peakMemoryUsage*: the highest amount of memory (in bytes) the query has
+///   used up to the point the list of queries was queried
+///
 /// @RESTRETURNCODES
 ///
 /// @RESTRETURNCODE{200}
@@ -235,6 +238,9 @@ bool RestQueryHandler::readQueryProperties () {
 /// - *runTime*: the query's run time up to the point the list of queries was
 ///   queried
 ///
+/// - *peakMemoryUsage*: the highest amount of memory (in bytes) the query has
+///   used
+///
 /// @RESTRETURNCODES
 ///
 /// @RESTRETURNCODE{200}
@@ -262,7 +268,8 @@ bool RestQueryHandler::readQuery (bool slow) {
       .set("id", Json(StringUtils::itoa(it.id)))
       .set("query", Json(queryString))
       .set("started", Json(timeString))
-      .set("runTime", Json(it.runTime));
+      .set("runTime", Json(it.runTime))
+      .set("peakMemoryUsage", Json(static_cast<double>(it.peakMemoryUsage)));
 
       result.add(entry);
     }
@@ -39,6 +39,7 @@
 #include "Admin/RestShutdownHandler.h"
 #include "Aql/Query.h"
 #include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Aql/RestAqlHandler.h"
 #include "Basics/FileUtils.h"
 #include "Basics/Nonce.h"
@@ -346,6 +347,7 @@ ArangoServer::ArangoServer (int argc, char** argv)
     _databasePath(),
     _queryCacheMode("off"),
     _queryCacheMaxResults(128),
+    _queryPlanCacheMaxPlans(128),
     _defaultMaximalSize(TRI_JOURNAL_DEFAULT_MAXIMAL_SIZE),
     _defaultWaitForSync(false),
     _forceSyncProperties(true),
@@ -600,6 +602,7 @@ void ArangoServer::buildApplicationServer () {
     ("database.disable-query-tracking", &_disableQueryTracking, "turn off AQL query tracking by default")
     ("database.query-cache-mode", &_queryCacheMode, "mode for the AQL query cache (on, off, demand)")
     ("database.query-cache-max-results", &_queryCacheMaxResults, "maximum number of results in query cache per database")
+    ("database.query-plan-cache-max-plans", &_queryPlanCacheMaxPlans, "maximum number of execution plans in plan cache per database (0 = disable)")
     ("database.index-threads", &_indexThreads, "threads to start for parallel background index creation")
   ;
 
@@ -761,6 +764,9 @@ void ArangoServer::buildApplicationServer () {
     triagens::aql::QueryCache::instance()->setProperties(cacheProperties);
   }
 
+  // configure the plan cache
+  triagens::aql::QueryPlanCache::instance()->setMaxPlans(static_cast<size_t>(_queryPlanCacheMaxPlans));
+
   // .............................................................................
   // now run arangod
   // .............................................................................
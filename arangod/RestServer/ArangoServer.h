@@ -436,6 +436,22 @@ namespace triagens {
 
         uint64_t _queryCacheMaxResults;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of execution plans in the plan cache per database
+/// @startDocuBlock queryPlanCacheMaxPlans
+/// `--database.query-plan-cache-max-plans`
+///
+/// Maximum number of optimized AQL execution plans that are kept per database.
+/// A query that is executed again with the same query string, bind parameter
+/// values and optimizer options reuses the cached plan instead of parsing and
+/// optimizing the query again. If the number of plans for the database is
+/// equal to this threshold value, the oldest plan will be removed from the
+/// cache. Setting this option to 0 turns the plan cache off.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _queryPlanCacheMaxPlans;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @startDocuBlock databaseMaximalJournalSize
 /// 
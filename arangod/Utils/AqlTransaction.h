@@ -147,6 +147,42 @@ namespace triagens {
           return res;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a collection for reading while the transaction is already
+/// running. this is needed for collections that are only known at runtime,
+/// e.g. the vertex collections visited by a graph traversal. returns a 
+/// nullptr if the collection cannot be added, e.g. because the transaction
+/// is embedded in another transaction
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_transaction_collection_t* trxCollectionAtRuntime (TRI_voc_cid_t cid) {
+          TRI_ASSERT(cid > 0);
+
+          auto trx = getInternals();
+          TRI_transaction_collection_t* trxCollection = TRI_GetCollectionTransaction(trx, cid, TRI_TRANSACTION_READ);
+
+          if (trxCollection == nullptr) {
+            if (this->isEmbeddedTransaction()) {
+              // cannot add collections to an embedded transaction
+              return nullptr;
+            }
+
+            int res = TRI_AddCollectionTransaction(trx, cid, TRI_TRANSACTION_READ, 0, true);
+
+            if (res == TRI_ERROR_NO_ERROR) {
+              res = TRI_EnsureCollectionsTransaction(trx);
+            }
+
+            if (res != TRI_ERROR_NO_ERROR) {
+              return nullptr;
+            }
+
+            trxCollection = TRI_GetCollectionTransaction(trx, cid, TRI_TRANSACTION_READ);
+          }
+
+          return trxCollection;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief ditch
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,10 +28,16 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Utils/Cursor.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
 #include "Basics/JsonHelper.h"
 #include "ShapedJson/shaped-json.h"
 #include "Utils/CollectionExport.h"
+#include "Utils/Transaction.h"
 #include "VocBase/document-collection.h"
+#include "VocBase/server.h"
 #include "VocBase/vocbase.h"
 #include "VocBase/voc-shaper.h"
 
@@ -423,6 +429,347 @@ void ExportCursor::dump (triagens::basics::StringBuffer& buffer) {
   }
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                           class QueryStreamCursor
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+QueryStreamCursor::QueryStreamCursor (TRI_vocbase_t* vocbase,
+                                      CursorId id,
+                                      triagens::aql::Query* query,
+                                      size_t batchSize,
+                                      double ttl)
+  : Cursor(id, batchSize, nullptr, ttl, false),
+    _vocbase(vocbase),
+    _query(query),
+    _isOpen(true),
+    _buffer(nullptr),
+    _bufferPosition(0),
+    _current(nullptr),
+    _size(0),
+    _resultRegister(query->engine()->resultRegister()) {
+
+  // the cursor owns the query between two batches. the query is not handed
+  // to the query registry, so it cannot be expired while the cursor (and
+  // the values it buffers) still refer to it. the cursor's lifetime is
+  // controlled by the cursor repository and the cursor ttl
+  closeQuery();
+
+  TRI_UseVocBase(vocbase);
+}
+        
+QueryStreamCursor::~QueryStreamCursor () {
+  if (_current != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _current);
+  }
+
+  destroyQuery(TRI_ERROR_TRANSACTION_ABORTED);
+
+  TRI_ReleaseVocBase(_vocbase);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the cursor contains more data
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryStreamCursor::hasNext () {
+  if (fetch(nullptr)) {
+    return true;
+  }
+
+  auto query = openQuery();
+
+  if (query == nullptr) {
+    return false;
+  }
+
+  try {
+    bool const result = fetch(query);
+    closeQuery();
+
+    return result;
+  }
+  catch (...) {
+    destroyQuery(TRI_ERROR_INTERNAL);
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next element
+/// the element is owned by the cursor and valid until the next call
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* QueryStreamCursor::next () {
+  if (_current != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _current);
+    _current = nullptr;
+  }
+
+  auto query = openQuery();
+
+  try {
+    if (fetch(query)) {
+      _current = nextRow(query);
+    }
+    closeQuery();
+  }
+  catch (...) {
+    destroyQuery(TRI_ERROR_INTERNAL);
+    throw;
+  }
+
+  return _current;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of elements returned so far
+/// the total number of results is unknown until the query is exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+size_t QueryStreamCursor::count () const {
+  return _size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dump the next batch of the query result into a string buffer
+////////////////////////////////////////////////////////////////////////////////
+        
+void QueryStreamCursor::dump (triagens::basics::StringBuffer& buffer) {
+  buffer.appendText("\"result\":[");
+
+  bool hasMore = false;
+
+  try {
+    auto query = openQuery();
+    size_t const n = batchSize();
+
+    for (size_t i = 0; i < n; ++i) {
+      if (! fetch(query)) {
+        break;
+      }
+
+      if (i > 0) {
+        buffer.appendChar(',');
+      }
+
+      triagens::basics::Json row(TRI_UNKNOWN_MEM_ZONE, nextRow(query));
+      int res = TRI_StringifyJson(buffer.stringBuffer(), row.json());
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(res);
+      }
+    }
+
+    // look ahead so we can tell the client whether there is more data. if the
+    // query is exhausted, this will also finalize it
+    hasMore = fetch(query);
+    closeQuery();
+  }
+  catch (...) {
+    destroyQuery(TRI_ERROR_INTERNAL);
+    this->deleted();
+    throw;
+  }
+
+  buffer.appendText("],\"hasMore\":");
+  buffer.appendText(hasMore ? "true" : "false");
+
+  if (hasMore) {
+    // only return cursor id if there are more documents
+    buffer.appendText(",\"id\":\"");
+    buffer.appendInteger(id());
+    buffer.appendText("\"");
+  }
+
+  TRI_json_t const* extraJson = extra();
+
+  if (TRI_IsObjectJson(extraJson)) {
+    // stats and warnings are only available with the last batch
+    buffer.appendText(",\"extra\":");
+    TRI_StringifyJson(buffer.stringBuffer(), extraJson);
+  }
+
+  buffer.appendText(",\"cached\":false");
+    
+  if (! hasMore) {
+    // mark the cursor as deleted
+    this->deleted();
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief attach the query to the current thread
+/// returns a nullptr if the query has already been finalized
+////////////////////////////////////////////////////////////////////////////////
+
+triagens::aql::Query* QueryStreamCursor::openQuery () {
+  if (_query == nullptr) {
+    return nullptr;
+  }
+
+  TRI_ASSERT(! _isOpen);
+
+  // the query's transaction is now running in this thread. this mirrors
+  // what the query registry does when opening a query
+  triagens::arango::TransactionBase::increaseNumbers(1, 1);
+
+  auto lockedShards = _query->engine()->lockedShards();
+
+  if (lockedShards != nullptr) {
+    if (triagens::arango::Transaction::_makeNolockHeaders == nullptr) {
+      triagens::arango::Transaction::_makeNolockHeaders = lockedShards;
+    }
+    else {
+      LOG_WARNING("Found strange lockedShards in thread, not overwriting!");
+    }
+  }
+
+  _isOpen = true;
+
+  return _query;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief detach the query from the current thread
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryStreamCursor::closeQuery () {
+  if (_query == nullptr) {
+    // query has been finalized meanwhile
+    return;
+  }
+
+  TRI_ASSERT(_isOpen);
+
+  triagens::arango::TransactionBase::increaseNumbers(-1, -1);
+
+  if (triagens::arango::Transaction::_makeNolockHeaders != nullptr &&
+      triagens::arango::Transaction::_makeNolockHeaders == _query->engine()->lockedShards()) {
+    triagens::arango::Transaction::_makeNolockHeaders = nullptr;
+  }
+
+  _isOpen = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the query, committing or aborting its transaction depending
+/// on the error code
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryStreamCursor::destroyQuery (int errorCode) {
+  // the buffered values refer to the query's resource monitor, so they must
+  // be freed before the query
+  delete _buffer;
+  _buffer = nullptr;
+  _bufferPosition = 0;
+
+  if (_query == nullptr) {
+    return;
+  }
+
+  if (! _isOpen) {
+    // the transaction must be registered with the current thread before
+    // it can be committed or aborted
+    openQuery();
+  }
+
+  std::unique_ptr<triagens::aql::Query> query(_query);
+  _query = nullptr;
+  _isOpen = false;
+
+  if (errorCode == TRI_ERROR_NO_ERROR) {
+    // commit the operation
+    query->trx()->commit();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief make sure the buffer contains a result row at the current position
+/// more rows are only produced if the query is passed in (and thus open).
+/// if the query is exhausted, it is finalized
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryStreamCursor::fetch (triagens::aql::Query* query) {
+  while (true) {
+    if (_buffer != nullptr) {
+      size_t const n = _buffer->size();
+
+      while (_bufferPosition < n) {
+        if (! _buffer->getValueReference(_bufferPosition, _resultRegister).isEmpty()) {
+          return true;
+        }
+        ++_bufferPosition;
+      }
+
+      delete _buffer;
+      _buffer = nullptr;
+      _bufferPosition = 0;
+    }
+
+    if (query == nullptr || _query == nullptr) {
+      return false;
+    }
+
+    _buffer = query->engine()->getSome(1, triagens::aql::ExecutionBlock::DefaultBatchSize);
+
+    if (_buffer == nullptr) {
+      finish(query);
+      return false;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finalize the exhausted query and commit its transaction
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryStreamCursor::finish (triagens::aql::Query* query) {
+  triagens::basics::Json extra(triagens::basics::Json::Object, 2);
+  extra.set("stats", query->executionStats().toJson());
+
+  TRI_json_t* warnings = query->warningsToJson(TRI_UNKNOWN_MEM_ZONE);
+
+  if (warnings == nullptr) {
+    extra.set("warnings", triagens::basics::Json(triagens::basics::Json::Array));
+  }
+  else {
+    extra.set("warnings", triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, warnings));
+  }
+
+  query->engine()->shutdown(TRI_ERROR_NO_ERROR);
+  destroyQuery(TRI_ERROR_NO_ERROR);
+
+  TRI_ASSERT(_extra == nullptr);
+  _extra = extra.steal();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert the result row at the current position into JSON
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* QueryStreamCursor::nextRow (triagens::aql::Query* query) {
+  TRI_ASSERT(_buffer != nullptr);
+  TRI_ASSERT(_bufferPosition < _buffer->size());
+
+  auto doc = _buffer->getDocumentCollection(_resultRegister);
+  auto const& val = _buffer->getValueReference(_bufferPosition++, _resultRegister);
+
+  ++_size;
+  return val.toJson(query->trx(), doc, true).steal();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
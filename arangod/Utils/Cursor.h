@@ -31,6 +31,7 @@
 #define ARANGODB_ARANGO_CURSOR_H 1
 
 #include "Basics/Common.h"
+#include "Aql/types.h"
 #include "Basics/StringBuffer.h"
 #include "VocBase/voc-types.h"
 
@@ -38,6 +39,11 @@ struct TRI_json_t;
 struct TRI_vocbase_s;
 
 namespace triagens {
+  namespace aql {
+    class AqlItemBlock;
+    class Query;
+  }
+
   namespace arango {
 
     class CollectionExport;
@@ -235,6 +241,69 @@ namespace triagens {
         size_t const                        _size;
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                           class QueryStreamCursor
+// -----------------------------------------------------------------------------
+    
+    class QueryStreamCursor : public Cursor {
+      public:
+
+        QueryStreamCursor (struct TRI_vocbase_s*,
+                           CursorId,
+                           triagens::aql::Query*,
+                           size_t,
+                           double);
+
+        ~QueryStreamCursor ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+      public:
+
+        bool hasNext () override final;
+
+        struct TRI_json_t* next () override final;
+        
+        size_t count () const override final;
+
+        void dump (triagens::basics::StringBuffer&) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+      private:
+
+        triagens::aql::Query* openQuery ();
+
+        void closeQuery ();
+
+        void destroyQuery (int);
+
+        bool fetch (triagens::aql::Query*);
+
+        void finish (triagens::aql::Query*);
+
+        struct TRI_json_t* nextRow (triagens::aql::Query*);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+        struct TRI_vocbase_s*               _vocbase;
+        triagens::aql::Query*               _query;
+        bool                                _isOpen;
+        triagens::aql::AqlItemBlock*        _buffer;
+        size_t                              _bufferPosition;
+        struct TRI_json_t*                  _current;
+        size_t                              _size;
+        triagens::aql::RegisterId           _resultRegister;
+    };
+
   }
 }
 
@@ -172,6 +172,43 @@ ExportCursor* CursorRepository::createFromExport (triagens::arango::CollectionEx
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a streaming cursor for a prepared query and stores it in 
+/// the registry
+/// the cursor will be returned with the usage flag set to true. it must be
+/// returned later using release() 
+/// the cursor will take ownership of the query
+////////////////////////////////////////////////////////////////////////////////
+
+QueryStreamCursor* CursorRepository::createFromQuery (triagens::aql::Query* query,
+                                                      size_t batchSize,
+                                                      double ttl) {
+  TRI_ASSERT(query != nullptr);
+
+  CursorId const id = TRI_NewTickServer();
+  triagens::arango::QueryStreamCursor* cursor = nullptr;
+
+  try {
+    cursor = new triagens::arango::QueryStreamCursor(_vocbase, id, query, batchSize, ttl);
+  }
+  catch (...) {
+    delete query;
+    throw;
+  }
+
+  cursor->use();
+
+  try {
+    MUTEX_LOCKER(_lock);
+    _cursors.emplace(std::make_pair(id, cursor));
+    return cursor;
+  }
+  catch (...) {
+    delete cursor;
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief remove a cursor by id
 ////////////////////////////////////////////////////////////////////////////////
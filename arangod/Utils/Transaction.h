@@ -50,6 +50,7 @@
 #include "Utils/CollectionNameResolver.h"
 #include "Utils/DocumentHelper.h"
 #include "Utils/TransactionContext.h"
+#include <functional>
 
 namespace triagens {
   namespace arango {
@@ -474,6 +475,70 @@ namespace triagens {
           return TRI_ERROR_NO_ERROR;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hand out a range of at most batchSize primary index slots to the
+/// callback, starting at the internal offset into the primary index. the
+/// callback is executed while the collection is read-locked. the slots
+/// may be empty. the internal offset is advanced past the range. if the end
+/// of the primary index is reached, the callback is not executed and the
+/// internal offset is left unchanged
+////////////////////////////////////////////////////////////////////////////////
+
+        int readSlots (TRI_transaction_collection_t* trxCollection,
+                       TRI_voc_size_t& internalSkip,
+                       TRI_voc_size_t batchSize,
+                       std::function<int(void**, void**)> const& callback,
+                       uint32_t* total) {
+
+          TRI_document_collection_t* document = documentCollection(trxCollection);
+
+          // READ-LOCK START
+          int res = this->lock(trxCollection, TRI_TRANSACTION_READ);
+
+          if (res != TRI_ERROR_NO_ERROR) {
+            return res;
+          }
+
+          auto primaryIndex = document->primaryIndex()->internals();
+          *total = (uint32_t) primaryIndex->_nrUsed;
+
+          if (primaryIndex->_nrUsed == 0 || 
+              internalSkip >= primaryIndex->_nrAlloc) {
+            // nothing to do
+            this->unlock(trxCollection, TRI_TRANSACTION_READ);
+
+            // READ-LOCK END
+            return TRI_ERROR_NO_ERROR;
+          }
+
+          if (orderDitch(trxCollection) == nullptr) {
+            this->unlock(trxCollection, TRI_TRANSACTION_READ);
+            return TRI_ERROR_OUT_OF_MEMORY;
+          }
+
+          void** beg = primaryIndex->_table + internalSkip;
+          void** end = primaryIndex->_table + primaryIndex->_nrAlloc;
+
+          if (static_cast<TRI_voc_size_t>(end - beg) > batchSize) {
+            end = beg + batchSize;
+          }
+
+          try {
+            res = callback(beg, end);
+          }
+          catch (...) {
+            this->unlock(trxCollection, TRI_TRANSACTION_READ);
+            throw;
+          }
+
+          this->unlock(trxCollection, TRI_TRANSACTION_READ);
+          // READ-LOCK END
+
+          internalSkip += static_cast<TRI_voc_size_t>(end - beg);
+
+          return res;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief read all master pointers, using skip and limit and an internal
 /// offset into the primary index. this can be used for incremental access to
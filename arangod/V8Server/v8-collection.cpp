@@ -2038,6 +2038,11 @@ static void JS_PlanIdVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& args
 ///   value. Changes (see below) are applied when the collection is
 ///   loaded the next time.
 ///
+/// * *compressDatafiles*: If *true* then the datafiles of the collection
+///   are compressed when the collection is unloaded, and uncompressed
+///   again when it is loaded. This reduces the disk space used by
+///   collections that are not in use, at the price of slower loading.
+///
 /// In a cluster setup, the result will also contain the following attributes:
 ///
 /// * *numberOfShards*: the number of shards of the collection.
@@ -2058,6 +2063,9 @@ static void JS_PlanIdVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& args
 /// * *indexBuckets* : See above, changes are only applied when the
 ///   collection is loaded the next time.
 ///
+/// * *compressDatafiles* : See above, changes are applied when the
+///   collection is unloaded the next time.
+///
 /// *Note*: it is not possible to change the journal size after the journal or
 /// datafile has been created. Changing this parameter will only effect newly
 /// created journals. Also note that you cannot lower the journal size to less
@@ -2162,6 +2170,10 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
           }
           info._indexBuckets = tmp;
         }
+
+        if (po->Has(TRI_V8_ASCII_STRING("compressDatafiles"))) {
+          info._compressDatafiles = TRI_ObjectToBoolean(po->Get(TRI_V8_ASCII_STRING("compressDatafiles")));
+        }
       }
 
       int res = ClusterInfo::instance()->setCollectionPropertiesCoordinator(databaseName, StringUtils::itoa(collection->_cid), &info);
@@ -2190,6 +2202,8 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
     result->Set(WaitForSyncKey, v8::Boolean::New(isolate, info._waitForSync));
     result->Set(TRI_V8_ASCII_STRING("indexBuckets"),
                 v8::Number::New(isolate, info._indexBuckets));
+    result->Set(TRI_V8_ASCII_STRING("compressDatafiles"),
+                v8::Boolean::New(isolate, info._compressDatafiles));
 
     shared_ptr<CollectionInfo> c = ClusterInfo::instance()->getCollection(databaseName, StringUtils::itoa(collection->_cid));
     v8::Handle<v8::Array> shardKeys = v8::Array::New(isolate);
@@ -2232,6 +2246,7 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
       bool doCompact     = base->_info._doCompact;
       bool waitForSync   = base->_info._waitForSync;
       uint32_t indexBuckets = base->_info._indexBuckets;
+      bool compressDatafiles = base->_info._compressDatafiles;
 
       TRI_UNLOCK_JOURNAL_ENTRIES_DOC_COLLECTION(document);
 
@@ -2281,6 +2296,10 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
         }
       }
 
+      if (po->Has(TRI_V8_ASCII_STRING("compressDatafiles"))) {
+        compressDatafiles = TRI_ObjectToBoolean(po->Get(TRI_V8_ASCII_STRING("compressDatafiles")));
+      }
+
       // update collection
       TRI_col_info_t newParameters;
 
@@ -2288,6 +2307,7 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
       newParameters._maximalSize = maximalSize;
       newParameters._waitForSync = waitForSync;
       newParameters._indexBuckets = indexBuckets;
+      newParameters._compressDatafiles = compressDatafiles;
 
       // try to write new parameter to file
       bool doSync = base->_vocbase->_settings.forceSyncProperties;
@@ -2340,6 +2360,8 @@ static void JS_PropertiesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>&
   result->Set(JournalSizeKey, v8::Number::New( isolate, base->_info._maximalSize));
   result->Set(TRI_V8_ASCII_STRING("indexBuckets"),
               v8::Number::New(isolate, document->_info._indexBuckets));
+  result->Set(TRI_V8_ASCII_STRING("compressDatafiles"),
+              v8::Boolean::New(isolate, document->_info._compressDatafiles));
 
   TRI_json_t* keyOptions = document->_keyGenerator->toJson(TRI_UNKNOWN_MEM_ZONE);
 
@@ -3424,7 +3446,10 @@ static void JS_TryRepairDatafileVocbaseCol (const v8::FunctionCallbackInfo<v8::V
     TRI_V8_THROW_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_UNLOADED);
   }
 
+  // the datafiles may still be compressed after the unload
+  TRI_LockMutex(&collection->_compressionLock);
   bool result = TRI_TryRepairDatafile(path.c_str());
+  TRI_UnlockMutex(&collection->_compressionLock);
 
   TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
 
@@ -4302,7 +4327,10 @@ static void JS_DatafilesVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& a
     TRI_V8_THROW_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_UNLOADED);
   }
 
+  // the datafiles may still be compressed after the unload
+  TRI_LockMutex(&collection->_compressionLock);
   TRI_col_file_structure_t structure = TRI_FileStructureCollectionDirectory(collection->_path);
+  TRI_UnlockMutex(&collection->_compressionLock);
 
   // release lock
   TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
@@ -4381,7 +4409,10 @@ static void JS_DatafileScanVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>
     TRI_V8_THROW_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_UNLOADED);
   }
 
+  // the datafiles may still be compressed after the unload
+  TRI_LockMutex(&collection->_compressionLock);
   TRI_df_scan_t scan = TRI_ScanDatafile(path.c_str());
+  TRI_UnlockMutex(&collection->_compressionLock);
 
   // build result
   v8::Handle<v8::Object> result = v8::Object::New(isolate);
@@ -416,6 +416,9 @@ static void JS_Transaction (const v8::FunctionCallbackInfo<v8::Value>& args) {
 ///   allocates in the background
 /// - *syncInterval*: the interval for automatic synchronization of not-yet
 ///   synchronized write-ahead log data (in milliseconds)
+/// - *groupCommitDelay*: the maximum time to wait for concurrent synchronous
+///   commits before syncing (in microseconds). A value of *0* means that
+///   group commit is turned off.
 /// - *throttleWait*: the maximum wait time that operations will wait before
 ///   they get aborted if case of write-throttling (in milliseconds)
 /// - *throttleWhenPending*: the number of unprocessed garbage-collection 
@@ -443,6 +446,9 @@ static void JS_Transaction (const v8::FunctionCallbackInfo<v8::Value>& args) {
 /// - *historicLogfiles*: the maximum number of historic logfiles to keep
 /// - *reserveLogfiles*: the maximum number of reserve logfiles that ArangoDB
 ///   allocates in the background
+/// - *groupCommitDelay*: the maximum time to wait for concurrent synchronous
+///   commits before syncing (in microseconds). A value of *0* turns group
+///   commit off.
 /// - *throttleWait*: the maximum wait time that operations will wait before
 ///   they get aborted if case of write-throttling (in milliseconds)
 /// - *throttleWhenPending*: the number of unprocessed garbage-collection 
@@ -493,6 +499,11 @@ static void JS_PropertiesWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
       l->reserveLogfiles(value);
     }
     
+    if (object->Has(TRI_V8_ASCII_STRING("groupCommitDelay"))) {
+      uint64_t value = TRI_ObjectToUInt64(object->Get(TRI_V8_ASCII_STRING("groupCommitDelay")), true);
+      l->groupCommitDelay(value);
+    }
+    
     if (object->Has(TRI_V8_ASCII_STRING("throttleWait"))) {
       uint64_t value = TRI_ObjectToUInt64(object->Get(TRI_V8_ASCII_STRING("throttleWait")), true);
       l->maxThrottleWait(value);
@@ -510,6 +521,7 @@ static void JS_PropertiesWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
   result->Set(TRI_V8_ASCII_STRING("historicLogfiles"),      v8::Number::New(isolate, l->historicLogfiles()));
   result->Set(TRI_V8_ASCII_STRING("reserveLogfiles"),       v8::Number::New(isolate, l->reserveLogfiles()));
   result->Set(TRI_V8_ASCII_STRING("syncInterval"),          v8::Number::New(isolate, (double) l->syncInterval()));
+  result->Set(TRI_V8_ASCII_STRING("groupCommitDelay"),      v8::Number::New(isolate, (double) l->groupCommitDelay()));
   result->Set(TRI_V8_ASCII_STRING("throttleWait"),          v8::Number::New(isolate, (double) l->maxThrottleWait()));
   result->Set(TRI_V8_ASCII_STRING("throttleWhenPending"),   v8::Number::New(isolate, (double) l->throttleWhenPending()));
 
@@ -517,6 +529,52 @@ static void JS_PropertiesWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
   TRI_V8_TRY_CATCH_END
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the statistics for synchronous commits
+/// @startDocuBlock walStatistics
+/// `internal.wal.statistics()`
+///
+/// Returns statistics about the disk syncs of the write-ahead log for
+/// operations executed with the *waitForSync* attribute. The result is a JSON
+/// object with the following attributes:
+/// - *syncs*: the number of disk syncs that included synchronous commits
+/// - *syncedCommits*: the number of synchronous commits synced
+/// - *commitsPerSync*: the average number of synchronous commits per sync
+/// - *recentCommitsPerSync*: the moving average of synchronous commits per
+///   sync over the most recent syncs. Group commit waits for this many commits
+///   if it is turned on
+///
+/// @EXAMPLES
+///
+/// @EXAMPLE_ARANGOSH_OUTPUT{WalStatistics}
+///   require("internal").wal.statistics();
+/// @END_EXAMPLE_ARANGOSH_OUTPUT
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+static void JS_StatisticsWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
+  TRI_V8_TRY_CATCH_BEGIN(isolate);
+  v8::HandleScope scope(isolate);
+
+  if (args.Length() != 0) {
+    TRI_V8_THROW_EXCEPTION_USAGE("statistics()");
+  }
+
+  uint64_t syncs;
+  uint64_t commits;
+  double recentCommitsPerSync;
+  triagens::wal::LogfileManager::instance()->syncStatistics(syncs, commits, recentCommitsPerSync);
+
+  v8::Handle<v8::Object> result = v8::Object::New(isolate);
+  result->Set(TRI_V8_ASCII_STRING("syncs"),                v8::Number::New(isolate, (double) syncs));
+  result->Set(TRI_V8_ASCII_STRING("syncedCommits"),        v8::Number::New(isolate, (double) commits));
+  result->Set(TRI_V8_ASCII_STRING("commitsPerSync"),       v8::Number::New(isolate, syncs > 0 ? (double) commits / (double) syncs : 0.0));
+  result->Set(TRI_V8_ASCII_STRING("recentCommitsPerSync"), v8::Number::New(isolate, recentCommitsPerSync));
+
+  TRI_V8_RETURN(result);
+  TRI_V8_TRY_CATCH_END
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief flushes the currently open WAL logfile
 /// @startDocuBlock walFlush
@@ -1418,6 +1476,7 @@ static void JS_QueriesCurrentAql (const v8::FunctionCallbackInfo<v8::Value>& arg
       obj->Set(TRI_V8_ASCII_STRING("query"), TRI_V8_STD_STRING(it.queryString));
       obj->Set(TRI_V8_ASCII_STRING("started"), TRI_V8_STD_STRING(timeString));
       obj->Set(TRI_V8_ASCII_STRING("runTime"), v8::Number::New(isolate, it.runTime));
+      obj->Set(TRI_V8_ASCII_STRING("peakMemoryUsage"), v8::Number::New(isolate, static_cast<double>(it.peakMemoryUsage)));
    
       result->Set(i++, obj);
     }
@@ -1470,6 +1529,7 @@ static void JS_QueriesSlowAql (const v8::FunctionCallbackInfo<v8::Value>& args)
       obj->Set(TRI_V8_ASCII_STRING("query"), TRI_V8_STD_STRING(it.queryString));
       obj->Set(TRI_V8_ASCII_STRING("started"), TRI_V8_STD_STRING(timeString));
       obj->Set(TRI_V8_ASCII_STRING("runTime"), v8::Number::New(isolate, it.runTime));
+      obj->Set(TRI_V8_ASCII_STRING("peakMemoryUsage"), v8::Number::New(isolate, static_cast<double>(it.peakMemoryUsage)));
    
       result->Set(i++, obj);
     }
@@ -3928,6 +3988,7 @@ void TRI_InitV8VocBridge (v8::Isolate* isolate,
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("TRANSACTION"), JS_Transaction, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("WAL_FLUSH"), JS_FlushWal, true);
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("WAL_PROPERTIES"), JS_PropertiesWal, true);
+  TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("WAL_STATISTICS"), JS_StatisticsWal, true);
   
   TRI_AddGlobalFunctionVocbase(isolate, context, TRI_V8_ASCII_STRING("ENABLE_NATIVE_BACKTRACES"), JS_EnableNativeBacktraces, true);
 
@@ -30,6 +30,7 @@
 #include "collection.h"
 
 #include <regex.h>
+#include <zlib.h>
 
 #include "Basics/conversions.h"
 #include "Basics/files.h"
@@ -408,6 +409,210 @@ static TRI_col_file_structure_t ScanCollectionDirectory (char const* path) {
   return structure;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief size of the buffers used for compressing and uncompressing datafiles
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const CompressionBufferSize = 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compresses or uncompresses a file into a new file
+///
+/// compressed files use the gzip format. the new file is synced to disk. if
+/// anything goes wrong, the new file is removed again
+////////////////////////////////////////////////////////////////////////////////
+
+static int TransformDatafile (char const* source,
+                              char const* target,
+                              bool compress) {
+  int fdin = TRI_OPEN(source, O_RDONLY);
+
+  if (fdin < 0) {
+    LOG_ERROR("cannot open file '%s': %s", source, strerror(errno));
+    return TRI_ERROR_SYS_ERROR;
+  }
+
+  // remove a left-over target file from an earlier attempt
+  TRI_UnlinkFile(target);
+
+  int fdout = TRI_CREATE(target, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+
+  if (fdout < 0) {
+    LOG_ERROR("cannot create file '%s': %s", target, strerror(errno));
+    TRI_CLOSE(fdin);
+    return TRI_ERROR_CANNOT_WRITE_FILE;
+  }
+
+  z_stream strm;
+  memset(&strm, 0, sizeof(z_stream));
+
+  // 15 + 16 selects the gzip format with the maximum window size
+  int res;
+  if (compress) {
+    res = deflateInit2(&strm, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  }
+  else {
+    res = inflateInit2(&strm, 15 + 16);
+  }
+
+  if (res != Z_OK) {
+    TRI_CLOSE(fdout);
+    TRI_CLOSE(fdin);
+    TRI_UnlinkFile(target);
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  char* in = static_cast<char*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, 2 * CompressionBufferSize, false));
+
+  if (in == nullptr) {
+    if (compress) {
+      (void) deflateEnd(&strm);
+    }
+    else {
+      (void) inflateEnd(&strm);
+    }
+    TRI_CLOSE(fdout);
+    TRI_CLOSE(fdin);
+    TRI_UnlinkFile(target);
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  char* out = in + CompressionBufferSize;
+  int zres = Z_OK;
+  res = TRI_ERROR_NO_ERROR;
+
+  while (res == TRI_ERROR_NO_ERROR && zres != Z_STREAM_END) {
+    ssize_t n = TRI_READ(fdin, in, static_cast<unsigned int>(CompressionBufferSize));
+
+    if (n < 0) {
+      LOG_ERROR("cannot read file '%s': %s", source, strerror(errno));
+      res = TRI_ERROR_SYS_ERROR;
+      break;
+    }
+
+    if (n == 0 && ! compress) {
+      // the compressed stream ended prematurely
+      res = TRI_ERROR_ARANGO_CORRUPTED_DATAFILE;
+      break;
+    }
+
+    strm.next_in = reinterpret_cast<unsigned char*>(in);
+    strm.avail_in = static_cast<uInt>(n);
+    int const flush = (n == 0 ? Z_FINISH : Z_NO_FLUSH);
+
+    do {
+      strm.next_out = reinterpret_cast<unsigned char*>(out);
+      strm.avail_out = static_cast<uInt>(CompressionBufferSize);
+
+      zres = (compress ? deflate(&strm, flush) : inflate(&strm, Z_NO_FLUSH));
+
+      if (zres != Z_OK && zres != Z_STREAM_END && zres != Z_BUF_ERROR) {
+        res = TRI_ERROR_ARANGO_CORRUPTED_DATAFILE;
+        break;
+      }
+
+      size_t const produced = CompressionBufferSize - strm.avail_out;
+
+      if (produced > 0 && ! TRI_WritePointer(fdout, out, produced)) {
+        LOG_ERROR("cannot write file '%s': %s", target, strerror(errno));
+        res = TRI_ERROR_CANNOT_WRITE_FILE;
+        break;
+      }
+    }
+    while (strm.avail_out == 0 && zres != Z_STREAM_END);
+  }
+
+  if (compress) {
+    (void) deflateEnd(&strm);
+  }
+  else {
+    (void) inflateEnd(&strm);
+  }
+
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, in);
+
+  if (res == TRI_ERROR_NO_ERROR && ! TRI_fsync(fdout)) {
+    LOG_ERROR("cannot sync file '%s': %s", target, strerror(errno));
+    res = TRI_ERROR_CANNOT_WRITE_FILE;
+  }
+
+  TRI_CLOSE(fdout);
+  TRI_CLOSE(fdin);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    TRI_UnlinkFile(target);
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uncompresses all compressed datafiles of a collection
+///
+/// a datafile-xxxx.db.gz file is first uncompressed into temp-xxxx.db, which
+/// is then renamed to datafile-xxxx.db, and the compressed file is removed
+/// last. if both datafile-xxxx.db and datafile-xxxx.db.gz exist, an earlier
+/// compression or uncompression was interrupted and the datafile is kept
+////////////////////////////////////////////////////////////////////////////////
+
+static int UncompressDatafiles (char const* path) {
+  regex_t re;
+
+  if (regcomp(&re, "^(temp|datafile)-([0-9][0-9]*)\\.db\\.gz$", REG_EXTENDED) != 0) {
+    LOG_ERROR("unable to compile regular expression");
+
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  int res = TRI_ERROR_NO_ERROR;
+  TRI_vector_string_t files = TRI_FilesDirectory(path);
+
+  for (size_t i = 0;  i < files._length;  ++i) {
+    char const* file = files._buffer[i];
+    regmatch_t matches[3];
+
+    if (regexec(&re, file, sizeof(matches) / sizeof(matches[0]), matches, 0) != 0) {
+      continue;
+    }
+
+    std::string const compressed = std::string(path) + TRI_DIR_SEPARATOR_STR + file;
+
+    if (TRI_EqualString2("temp", file + matches[1].rm_so, matches[1].rm_eo - matches[1].rm_so)) {
+      LOG_TRACE("found temporary file '%s', which is probably a left-over. deleting it", compressed.c_str());
+      TRI_UnlinkFile(compressed.c_str());
+      continue;
+    }
+
+    std::string const number(file + matches[2].rm_so, matches[2].rm_eo - matches[2].rm_so);
+    std::string const datafile = std::string(path) + TRI_DIR_SEPARATOR_STR + "datafile-" + number + ".db";
+
+    if (! TRI_ExistsFile(datafile.c_str())) {
+      std::string const temp = std::string(path) + TRI_DIR_SEPARATOR_STR + "temp-" + number + ".db";
+
+      LOG_TRACE("uncompressing datafile '%s'", compressed.c_str());
+
+      res = TransformDatafile(compressed.c_str(), temp.c_str(), false);
+
+      if (res == TRI_ERROR_NO_ERROR) {
+        res = TRI_RenameFile(temp.c_str(), datafile.c_str());
+      }
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        LOG_ERROR("cannot uncompress datafile '%s': %s", compressed.c_str(), TRI_errno_string(res));
+        TRI_UnlinkFile(temp.c_str());
+        break;
+      }
+    }
+
+    TRI_UnlinkFile(compressed.c_str());
+  }
+
+  TRI_DestroyVectorString(&files);
+  regfree(&re);
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checks a collection
 ///
@@ -855,7 +1060,10 @@ static void FillParametersFromJson (TRI_col_info_t* parameters,
       }
     }
     else if (value->_type == TRI_JSON_BOOLEAN) {
-      if (TRI_EqualString(key->_value._string.data, "deleted")) {
+      if (TRI_EqualString(key->_value._string.data, "compressDatafiles")) {
+        parameters->_compressDatafiles = value->_value._boolean;
+      }
+      else if (TRI_EqualString(key->_value._string.data, "deleted")) {
         parameters->_deleted = value->_value._boolean;
       }
       else if (TRI_EqualString(key->_value._string.data, "doCompact")) {
@@ -917,6 +1125,7 @@ void TRI_InitCollectionInfo (TRI_vocbase_t* vocbase,
     parameters->_keyOptions  = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, keyOptions);
   }
 
+  parameters->_compressDatafiles = false;
   parameters->_deleted       = false;
   parameters->_doCompact     = true;
   parameters->_isVolatile    = false;
@@ -960,6 +1169,7 @@ void TRI_CopyCollectionInfo (TRI_col_info_t* dst,
     dst->_keyOptions  = nullptr;
   }
 
+  dst->_compressDatafiles = src->_compressDatafiles;
   dst->_deleted       = src->_deleted;
   dst->_doCompact     = src->_doCompact;
   dst->_isSystem      = src->_isSystem;
@@ -1338,6 +1548,7 @@ TRI_json_t* TRI_CreateJsonCollectionInfo (TRI_col_info_t const* info) {
 
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "indexBuckets", TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, info->_indexBuckets));
 
+  TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "compressDatafiles", TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_compressDatafiles));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "deleted",      TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_deleted));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "doCompact",    TRI_CreateBooleanJson(TRI_CORE_MEM_ZONE, info->_doCompact));
   TRI_Insert3ObjectJson(TRI_CORE_MEM_ZONE, json, "maximalSize",  TRI_CreateNumberJson(TRI_CORE_MEM_ZONE, (double) info->_maximalSize));
@@ -1471,6 +1682,7 @@ int TRI_UpdateCollectionInfo (TRI_vocbase_t* vocbase,
     collection->_info._maximalSize = parameters->_maximalSize;
     collection->_info._waitForSync = parameters->_waitForSync;
     collection->_info._indexBuckets = parameters->_indexBuckets;
+    collection->_info._compressDatafiles = parameters->_compressDatafiles;
 
     // the following collection properties are intentionally not updated as updating
     // them would be very complicated:
@@ -1643,6 +1855,19 @@ TRI_collection_t* TRI_OpenCollection (TRI_vocbase_t* vocbase,
 
   TRI_FreeCollectionInfoOptions(&info);
 
+  // datafiles may have been compressed when the collection was unloaded
+  res = UncompressDatafiles(collection->_directory);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    collection->_lastError = TRI_set_errno(res);
+    LOG_ERROR("cannot uncompress datafiles of collection '%s'", collection->_directory);
+
+    TRI_FreeString(TRI_CORE_MEM_ZONE, collection->_directory);
+    collection->_directory = nullptr;
+
+    return nullptr;
+  }
+
   // check for journals and datafiles
   bool ok = CheckCollection(collection, ignoreErrors);
 
@@ -1795,8 +2020,10 @@ int TRI_UpgradeCollection20 (TRI_vocbase_t* vocbase,
         tick = TRI_NewTickServer();
 
         // datafile header
+        // the shape markers are copied as-is from the old datafiles, so the
+        // new datafile must keep their CRC32 checksums
         TRI_InitMarkerDatafile((char*) &header, TRI_DF_MARKER_HEADER, sizeof(TRI_df_header_marker_t));
-        header._version     = TRI_DF_VERSION;
+        header._version     = TRI_DF_VERSION_CRC32;
         header._maximalSize = 0; // TODO: seems ok to set this to 0, check if this is ok
         header._fid         = tick;
         header.base._tick   = tick;
@@ -1916,7 +2143,16 @@ bool TRI_IterateTicksCollection (const char* const path,
 
   if (structure._journals._length == 0) {
     // no journal found for collection. should not happen normally, but if
-    // it does, we need to grab the ticks from the datafiles, too
+    // it does, we need to grab the ticks from the datafiles, too. compressed
+    // datafiles must be uncompressed for this
+    if (UncompressDatafiles(path) != TRI_ERROR_NO_ERROR) {
+      TRI_DestroyFileStructureCollection(&structure);
+      return false;
+    }
+
+    TRI_DestroyFileStructureCollection(&structure);
+    structure = ScanCollectionDirectory(path);
+
     result = IterateFiles(&structure._datafiles, iterator, data);
   }
   else {
@@ -1930,6 +2166,62 @@ bool TRI_IterateTicksCollection (const char* const path,
   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compress the sealed datafiles of an unloaded collection
+///
+/// a datafile-xxxx.db file is compressed into temp-xxxx.db.gz, which is then
+/// renamed to datafile-xxxx.db.gz, and the datafile is removed last. journals
+/// and compactor files are left alone. if a datafile cannot be compressed, it
+/// is kept uncompressed. a datafile that already has a compressed copy (left
+/// behind by an interrupted compression or uncompression) is not compressed
+/// again, as both files have the same contents
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_CompressDatafilesCollection (char const* path) {
+  TRI_col_file_structure_t structure = ScanCollectionDirectory(path);
+
+  int res = TRI_ERROR_NO_ERROR;
+
+  for (size_t i = 0;  i < structure._datafiles._length;  ++i) {
+    char const* datafile = structure._datafiles._buffer[i];
+    char const* file = strrchr(datafile, TRI_DIR_SEPARATOR_CHAR);
+
+    if (file == nullptr || ! TRI_IsPrefixString(++file, "datafile-")) {
+      continue;
+    }
+
+    std::string const number(file + strlen("datafile-"));
+    std::string const temp = std::string(path) + TRI_DIR_SEPARATOR_STR + "temp-" + number + ".gz";
+    std::string const compressed = std::string(datafile) + ".gz";
+
+    if (TRI_ExistsFile(compressed.c_str())) {
+      LOG_TRACE("datafile '%s' is already compressed", datafile);
+      TRI_UnlinkFile(datafile);
+      continue;
+    }
+
+    LOG_TRACE("compressing datafile '%s'", datafile);
+
+    res = TransformDatafile(datafile, temp.c_str(), true);
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      res = TRI_RenameFile(temp.c_str(), compressed.c_str());
+    }
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_WARNING("cannot compress datafile '%s': %s", datafile, TRI_errno_string(res));
+      TRI_UnlinkFile(temp.c_str());
+      break;
+    }
+
+    TRI_UnlinkFile(datafile);
+  }
+
+  TRI_DestroyFileStructureCollection(&structure);
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief determine whether a collection name is a system collection name
 ////////////////////////////////////////////////////////////////////////////////
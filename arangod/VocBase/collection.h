@@ -181,6 +181,7 @@ typedef struct TRI_col_info_s {
   struct TRI_json_t* _keyOptions;      // options for key creation
 
   // flags
+  bool               _compressDatafiles; // if true, datafiles are compressed while unloaded
   bool               _deleted;         // if true, collection has been deleted
   bool               _doCompact;       // if true, collection will be compacted
   bool               _isSystem;        // if true, this is a system collection
@@ -424,6 +425,15 @@ bool TRI_IterateTicksCollection (const char* const,
                                  bool (*)(TRI_df_marker_t const*, void*, TRI_datafile_t*),
                                  void*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compress the sealed datafiles of an unloaded collection
+///
+/// each datafile is replaced by a gzip-compressed copy. the datafiles are
+/// uncompressed again when the collection is opened
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_CompressDatafilesCollection (char const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief determine whether a collection name is a system collection name
 ////////////////////////////////////////////////////////////////////////////////
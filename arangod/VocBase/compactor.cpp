@@ -204,6 +204,7 @@ static TRI_datafile_t* CreateCompactor (TRI_document_collection_t* document,
 
 static int CopyMarker (TRI_document_collection_t* document,
                        TRI_datafile_t* compactor,
+                       TRI_datafile_t const* datafile,
                        TRI_df_marker_t const* marker,
                        TRI_df_marker_t** result) {
   int res = TRI_ReserveElementDatafile(compactor, marker->_size, result, 0);
@@ -214,7 +215,15 @@ static int CopyMarker (TRI_document_collection_t* document,
     return TRI_ERROR_ARANGO_NO_JOURNAL;
   }
 
-  return TRI_WriteElementDatafile(compactor, *result, marker, false);
+  res = TRI_WriteElementDatafile(compactor, *result, marker, false);
+
+  if (res == TRI_ERROR_NO_ERROR &&
+      compactor->_crc32c != datafile->_crc32c) {
+    // the marker comes from a datafile with a different checksum algorithm
+    TRI_UpdateCrcMarkerDatafile(compactor, *result);
+  }
+
+  return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -472,7 +481,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
     context->_keepDeletions = true;
 
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(document, context->_compactor, datafile, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -521,7 +530,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   else if (marker->_type == TRI_DOC_MARKER_KEY_DELETION &&
            context->_keepDeletions) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(document, context->_compactor, datafile, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -535,7 +544,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   // shapes
   else if (marker->_type == TRI_DF_MARKER_SHAPE) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(document, context->_compactor, datafile, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -555,7 +564,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   // attributes
   else if (marker->_type == TRI_DF_MARKER_ATTRIBUTE) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(document, context->_compactor, datafile, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -583,7 +592,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
 
     if (document->_failedTransactions != nullptr) {
       // write to compactor files
-      res = CopyMarker(document, context->_compactor, marker, &result);
+      res = CopyMarker(document, context->_compactor, datafile, marker, &result);
 
       if (res != TRI_ERROR_NO_ERROR) {
         // TODO: dont fail but recover from this state
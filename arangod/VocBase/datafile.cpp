@@ -138,7 +138,8 @@ static int TruncateDatafile (TRI_datafile_t* const datafile, const off_t length)
 /// @brief calculates the actual CRC of a marker, without bounds checks
 ////////////////////////////////////////////////////////////////////////////////
 
-static TRI_voc_crc_t CalculateCrcValue (TRI_df_marker_t const* marker) {
+static TRI_voc_crc_t CalculateCrcValue (TRI_df_marker_t const* marker,
+                                         bool crc32c) {
   TRI_voc_size_t zero = 0;
   off_t o = offsetof(TRI_df_marker_t, _crc);
   size_t n = sizeof(TRI_voc_crc_t);
@@ -147,9 +148,9 @@ static TRI_voc_crc_t CalculateCrcValue (TRI_df_marker_t const* marker) {
 
   TRI_voc_crc_t crc = TRI_InitialCrc32();
 
-  crc = TRI_BlockCrc32(crc, ptr, o);
-  crc = TRI_BlockCrc32(crc, (char*) &zero, n);
-  crc = TRI_BlockCrc32(crc, ptr + o + n, marker->_size - o - n);
+  crc = TRI_BlockCrcDatafile(crc, ptr, o, crc32c);
+  crc = TRI_BlockCrcDatafile(crc, (char*) &zero, n, crc32c);
+  crc = TRI_BlockCrcDatafile(crc, ptr + o + n, marker->_size - o - n, crc32c);
 
   crc = TRI_FinalCrc32(crc);
 
@@ -161,7 +162,8 @@ static TRI_voc_crc_t CalculateCrcValue (TRI_df_marker_t const* marker) {
 ////////////////////////////////////////////////////////////////////////////////
 
 static std::string DiagnoseMarker (TRI_df_marker_t const* marker,
-                                   char const* end) {
+                                   char const* end,
+                                   bool crc32c) {
   std::ostringstream result;
 
   if (marker == nullptr) {
@@ -200,7 +202,7 @@ static std::string DiagnoseMarker (TRI_df_marker_t const* marker,
     return result.str();
   }
 
-  TRI_voc_crc_t crc = CalculateCrcValue(marker);
+  TRI_voc_crc_t crc = CalculateCrcValue(marker, crc32c);
     
   if (marker->_crc == crc) {
     result << "crc checksum is correct";
@@ -217,7 +219,8 @@ static std::string DiagnoseMarker (TRI_df_marker_t const* marker,
 ////////////////////////////////////////////////////////////////////////////////
 
 static bool CheckCrcMarker (TRI_df_marker_t const* marker,
-                            char const* end) {
+                            char const* end,
+                            bool crc32c) {
   if (marker->_size < sizeof(TRI_df_marker_t)) {
     return false;
   }
@@ -226,7 +229,7 @@ static bool CheckCrcMarker (TRI_df_marker_t const* marker,
     return false;
   }
 
-  auto expected = CalculateCrcValue(marker);
+  auto expected = CalculateCrcValue(marker, crc32c);
   return marker->_crc == expected;
 }
 
@@ -323,6 +326,7 @@ static void InitDatafile (TRI_datafile_t* datafile,
   datafile->_footerSize  = sizeof(TRI_df_footer_marker_t);
 
   datafile->_isSealed    = false;
+  datafile->_crc32c      = true; // new datafiles use TRI_DF_VERSION
   datafile->_lastError   = TRI_ERROR_NO_ERROR;
 
   datafile->_full        = false;
@@ -572,7 +576,7 @@ static TRI_df_scan_t ScanDatafile (TRI_datafile_t const* datafile) {
     if (marker->_size < sizeof(TRI_df_marker_t)) {
       entry._status = 4;
 
-      auto&& diagnosis = DiagnoseMarker(marker, end);
+      auto&& diagnosis = DiagnoseMarker(marker, end, datafile->_crc32c);
       entry._diagnosis = TRI_DuplicateString2Z(TRI_UNKNOWN_MEM_ZONE, diagnosis.c_str(), diagnosis.size());
 
       scan._endPosition = currentSize;
@@ -585,7 +589,7 @@ static TRI_df_scan_t ScanDatafile (TRI_datafile_t const* datafile) {
     if (! TRI_IsValidMarkerDatafile(marker)) {
       entry._status = 4;
 
-      auto&& diagnosis = DiagnoseMarker(marker, end);
+      auto&& diagnosis = DiagnoseMarker(marker, end, datafile->_crc32c);
       entry._diagnosis = TRI_DuplicateString2Z(TRI_UNKNOWN_MEM_ZONE, diagnosis.c_str(), diagnosis.size());
 
       scan._endPosition = currentSize;
@@ -595,12 +599,12 @@ static TRI_df_scan_t ScanDatafile (TRI_datafile_t const* datafile) {
       return scan;
     }
 
-    ok = CheckCrcMarker(marker, end);
+    ok = CheckCrcMarker(marker, end, datafile->_crc32c);
 
     if (! ok) {
       entry._status = 5;
       
-      auto&& diagnosis = DiagnoseMarker(marker, end);
+      auto&& diagnosis = DiagnoseMarker(marker, end, datafile->_crc32c);
       entry._diagnosis = TRI_DuplicateString2Z(TRI_UNKNOWN_MEM_ZONE, diagnosis.c_str(), diagnosis.size());
       
       scan._status = 4;
@@ -660,7 +664,7 @@ static bool TryRepairDatafile (TRI_datafile_t* datafile) {
     }
 
     if (marker->_type != 0) {
-      if (! CheckCrcMarker(marker, end)) {
+      if (! CheckCrcMarker(marker, end, datafile->_crc32c)) {
         // CRC mismatch!
         auto next = reinterpret_cast<char const*>(marker) + marker->_size;
         auto p = next;
@@ -696,7 +700,7 @@ static bool TryRepairDatafile (TRI_datafile_t* datafile) {
                 nextMarker->_size >= sizeof(TRI_df_marker_t) &&
                 next + nextMarker->_size <= end &&
                 TRI_IsValidMarkerDatafile(nextMarker) &&
-                CheckCrcMarker(nextMarker, end)) {
+                CheckCrcMarker(nextMarker, end, datafile->_crc32c)) {
               // next marker looks good.
 
               // create a temporary buffer
@@ -709,7 +713,7 @@ static bool TryRepairDatafile (TRI_datafile_t* datafile) {
               // create a new marker in the temporary buffer
               auto temp = reinterpret_cast<TRI_df_marker_t*>(buffer);
               TRI_InitMarkerDatafile(static_cast<char*>(buffer), TRI_DF_MARKER_BLANK, static_cast<TRI_voc_size_t>(marker->_size));
-              temp->_crc = CalculateCrcValue(temp);
+              temp->_crc = CalculateCrcValue(temp, datafile->_crc32c);
 
               // all done. now copy back the marker into the file
               memcpy(static_cast<void*>(ptr), buffer, static_cast<size_t>(marker->_size));
@@ -901,7 +905,7 @@ static bool CheckDatafile (TRI_datafile_t* datafile,
     }
 
     if (marker->_type != 0) {
-      bool ok = CheckCrcMarker(marker, end);
+      bool ok = CheckCrcMarker(marker, end, datafile->_crc32c);
 
       if (! ok) {
         // CRC mismatch!
@@ -939,7 +943,7 @@ static bool CheckDatafile (TRI_datafile_t* datafile,
                     nextMarker->_size >= sizeof(TRI_df_marker_t) &&
                     next + nextMarker->_size <= end &&
                     TRI_IsValidMarkerDatafile(nextMarker) &&
-                    CheckCrcMarker(nextMarker, end)) {
+                    CheckCrcMarker(nextMarker, end, datafile->_crc32c)) {
                   // next marker looks good.
                   nextMarkerOk = true;
                 }
@@ -964,7 +968,7 @@ static bool CheckDatafile (TRI_datafile_t* datafile,
           LOG_WARNING("crc mismatch found in datafile '%s' at position %lu. expected crc: %x, actual crc: %x", 
                       datafile->getName(datafile),
                       (unsigned long) currentSize,
-                      CalculateCrcValue(marker),
+                      CalculateCrcValue(marker, datafile->_crc32c),
                       marker->_crc);
           
           if (nextMarkerOk) {
@@ -1137,8 +1141,12 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
   
   char const* end = static_cast<char const*>(ptr) + len;
 
+  // the version determines the checksum algorithm of all markers,
+  // including the header marker itself
+  bool crc32c = (header._version == TRI_DF_VERSION_CRC32C);
+
   // check CRC
-  ok = CheckCrcMarker(&header.base, end);
+  ok = CheckCrcMarker(&header.base, end, crc32c);
 
   if (! ok) {
     TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
@@ -1153,7 +1161,8 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
 
   // check the datafile version
   if (ok) {
-    if (header._version != TRI_DF_VERSION) {
+    if (header._version != TRI_DF_VERSION_CRC32 &&
+        header._version != TRI_DF_VERSION_CRC32C) {
       TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
 
       LOG_ERROR("unknown datafile version '%u' in datafile '%s'",
@@ -1205,6 +1214,8 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
                fid,
                static_cast<char*>(data));
 
+  datafile->_crc32c = crc32c;
+
   return datafile;
 }
 
@@ -1796,6 +1807,15 @@ void TRI_UpdateTicksDatafile (TRI_datafile_t* datafile,
   */
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief recalculates the CRC of a marker contained in the datafile
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_UpdateCrcMarkerDatafile (TRI_datafile_t const* datafile,
+                                  TRI_df_marker_t* marker) {
+  marker->_crc = CalculateCrcValue(marker, datafile->_crc32c);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checksums and writes a marker to the datafile
 ////////////////////////////////////////////////////////////////////////////////
@@ -1809,7 +1829,7 @@ int TRI_WriteCrcElementDatafile (TRI_datafile_t* datafile,
   if (datafile->isPhysical(datafile)) {
     TRI_voc_crc_t crc = TRI_InitialCrc32();
 
-    crc = TRI_BlockCrc32(crc, (char const*) marker, marker->_size);
+    crc = TRI_BlockCrcDatafile(crc, (char const*) marker, marker->_size, datafile->_crc32c);
     marker->_crc = TRI_FinalCrc32(crc);
   }
 
@@ -31,6 +31,7 @@
 #define ARANGODB_VOC_BASE_DATAFILE_H 1
 
 #include "Basics/Common.h"
+#include "Basics/hashes.h"
 #include "Basics/locks.h"
 #include "ShapedJson/shaped-json.h"
 
@@ -96,10 +97,22 @@
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief datafile version
+/// @brief datafile version, markers are checksummed with CRC32
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_VERSION_CRC32    (1)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile version, markers are checksummed with CRC32C
 ////////////////////////////////////////////////////////////////////////////////
 
-#define TRI_DF_VERSION          (1)
+#define TRI_DF_VERSION_CRC32C   (2)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile version of new datafiles
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_VERSION          TRI_DF_VERSION_CRC32C
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief alignment in datafile blocks
@@ -286,6 +299,7 @@ typedef struct TRI_datafile_s {
   int _lastError;                // last (critical) error
   bool _full;                    // at least one request was rejected because there is not enough room
   bool _isSealed;                // true, if footer has been written
+  bool _crc32c;                  // true, if markers are checksummed with CRC32C
 
   // .............................................................................
   // access to the following attributes must be protected by a _lock
@@ -360,7 +374,11 @@ TRI_df_marker_t;
 ///   <tr>
 ///     <td>TRI_df_version_t</td>
 ///     <td>_version</td>
-///     <td>The version of a datafile, see @ref TRI_df_version_t.</td>
+///     <td>The version of a datafile, see @ref TRI_df_version_t. The
+///         version also determines the checksum algorithm of all markers
+///         in the datafile, including the header marker itself:
+///         TRI_DF_VERSION_CRC32 datafiles use CRC32, TRI_DF_VERSION_CRC32C
+///         datafiles use CRC32C.</td>
 ///   </tr>
 ///   <tr>
 ///     <td>TRI_voc_size_t</td>
@@ -636,6 +654,23 @@ static inline bool TRI_IsWalDataMarkerDatafile (void const* marker) {
   return (m->_type == TRI_WAL_MARKER_DOCUMENT || m->_type == TRI_WAL_MARKER_EDGE);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checksums a block of marker data
+///
+/// uses CRC32C if crc32c is true and CRC32 otherwise, see TRI_DF_VERSION
+////////////////////////////////////////////////////////////////////////////////
+
+static inline TRI_voc_crc_t TRI_BlockCrcDatafile (TRI_voc_crc_t value,
+                                                  char const* data,
+                                                  size_t length,
+                                                  bool crc32c) {
+  if (crc32c) {
+    return TRI_BlockCrc32C(value, data, length);
+  }
+
+  return TRI_BlockCrc32(value, data, length);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the name for a marker
 ////////////////////////////////////////////////////////////////////////////////
@@ -681,6 +716,16 @@ int TRI_WriteElementDatafile (TRI_datafile_t* datafile,
                               TRI_df_marker_t const* marker,
                               bool sync) TRI_WARN_UNUSED_RESULT;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief recalculates the CRC of a marker contained in the datafile
+///
+/// this is needed when a marker was copied as-is from a datafile with a
+/// different checksum algorithm
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_UpdateCrcMarkerDatafile (TRI_datafile_t const*,
+                                  TRI_df_marker_t*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checksums and writes a marker to the datafile
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 #include "document-collection.h"
 
 #include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Basics/Barrier.h"
 #include "Basics/conversions.h"
 #include "Basics/Exceptions.h"
@@ -3599,6 +3600,7 @@ bool TRI_DropIndexDocumentCollection (TRI_document_collection_t* document,
   TRI_WRITE_LOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
   
   triagens::aql::QueryCache::instance()->invalidate(vocbase, document->_info._name);
+  triagens::aql::QueryPlanCache::instance()->invalidate(vocbase, document->_info._name);
 
   triagens::arango::Index* found = document->removeIndex(iid);
   
@@ -3881,6 +3883,7 @@ triagens::arango::Index* TRI_EnsureCapConstraintDocumentCollection (TRI_document
   if (idx != nullptr) {
     if (created) {
       triagens::aql::QueryCache::instance()->invalidate(document->_vocbase, document->_info._name);
+      triagens::aql::QueryPlanCache::instance()->invalidate(document->_vocbase, document->_info._name);
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4219,6 +4222,7 @@ triagens::arango::Index* TRI_EnsureGeoIndex1DocumentCollection (TRI_document_col
   if (idx != nullptr) {
     if (created) {
       triagens::aql::QueryCache::instance()->invalidate(document->_vocbase, document->_info._name);
+      triagens::aql::QueryPlanCache::instance()->invalidate(document->_vocbase, document->_info._name);
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4260,6 +4264,7 @@ triagens::arango::Index* TRI_EnsureGeoIndex2DocumentCollection (TRI_document_col
   if (idx != nullptr) {
     if (created) {
       triagens::aql::QueryCache::instance()->invalidate(document->_vocbase, document->_info._name);
+      triagens::aql::QueryPlanCache::instance()->invalidate(document->_vocbase, document->_info._name);
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4437,6 +4442,7 @@ triagens::arango::Index* TRI_EnsureHashIndexDocumentCollection (TRI_document_col
   if (idx != nullptr) {
     if (created) {
       triagens::aql::QueryCache::instance()->invalidate(document->_vocbase, document->_info._name);
+      triagens::aql::QueryPlanCache::instance()->invalidate(document->_vocbase, document->_info._name);
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4611,6 +4617,7 @@ triagens::arango::Index* TRI_EnsureSkiplistIndexDocumentCollection (TRI_document
   if (idx != nullptr) {
     if (created) {
       triagens::aql::QueryCache::instance()->invalidate(document->_vocbase, document->_info._name);
+      triagens::aql::QueryPlanCache::instance()->invalidate(document->_vocbase, document->_info._name);
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4817,6 +4824,7 @@ triagens::arango::Index* TRI_EnsureFulltextIndexDocumentCollection (TRI_document
   if (idx != nullptr) {
     if (created) {
       triagens::aql::QueryCache::instance()->invalidate(document->_vocbase, document->_info._name);
+      triagens::aql::QueryPlanCache::instance()->invalidate(document->_vocbase, document->_info._name);
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
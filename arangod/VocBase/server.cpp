@@ -36,6 +36,7 @@
 #include <regex.h>
 
 #include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/conversions.h"
 #include "Basics/files.h"
@@ -2536,6 +2537,7 @@ int TRI_DropDatabaseServer (TRI_server_t* server,
 
   // invalidate all entries for the database
   triagens::aql::QueryCache::instance()->invalidate(vocbase);
+  triagens::aql::QueryPlanCache::instance()->invalidate(vocbase);
 
   if (TRI_DropVocBase(vocbase)) {
     if (triagens::wal::LogfileManager::instance()->isInRecovery()) {
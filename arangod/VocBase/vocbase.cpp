@@ -36,6 +36,7 @@
 #include <regex.h>
 
 #include "Aql/QueryCache.h"
+#include "Aql/QueryPlanCache.h"
 #include "Aql/QueryList.h"
 #include "Basics/conversions.h"
 #include "Basics/files.h"
@@ -283,13 +284,41 @@ static bool UnloadCollectionCallback (TRI_collection_t* col,
     return true;
   }
 
+  // all collections are unloaded when the database is destroyed, e.g. on
+  // server shutdown. compressing them all would delay the shutdown
+  bool const compress = (document->_info._compressDatafiles && 
+                         ! document->_info._isVolatile &&
+                         ! collection->_vocbase->_isShuttingDown);
+  std::string const directory(document->_directory);
+
   TRI_FreeDocumentCollection(document);
 
   collection->_status = TRI_VOC_COL_STATUS_UNLOADED;
   collection->_collection = nullptr;
 
+  if (! compress) {
+    TRI_WRITE_UNLOCK_STATUS_VOCBASE_COL(collection);
+    return true;
+  }
+
+  // compressing may take long, so it is done without holding the status
+  // lock. the compression lock is acquired before the status lock is
+  // released, so loading the collection waits until the compression is
+  // finished
+  TRI_LockMutex(&collection->_compressionLock);
   TRI_WRITE_UNLOCK_STATUS_VOCBASE_COL(collection);
 
+  res = TRI_CompressDatafilesCollection(directory.c_str());
+
+  TRI_UnlockMutex(&collection->_compressionLock);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    // the collection is still usable, its datafiles are just not compressed
+    LOG_WARNING("cannot compress datafiles of collection '%s': %s",
+                collection->_name,
+                TRI_errno_string(res));
+  }
+
   return true;
 }
 
@@ -582,6 +611,7 @@ static TRI_vocbase_col_t* AddCollection (TRI_vocbase_t* vocbase,
   TRI_ASSERT_EXPENSIVE(vocbase->_collectionsByName._nrUsed == vocbase->_collectionsById._nrUsed);
 
   TRI_InitReadWriteLock(&collection->_lock);
+  TRI_InitMutex(&collection->_compressionLock);
 
   // this needs TRI_WRITE_LOCK_COLLECTIONS_VOCBASE
   TRI_PushBackVectorPointer(&vocbase->_collections, collection);
@@ -821,6 +851,7 @@ static int RenameCollection (TRI_vocbase_t* vocbase,
 
   // invalidate all entries for the two collections
   triagens::aql::QueryCache::instance()->invalidate(vocbase, std::vector<char const*>{ oldName, newName });
+  triagens::aql::QueryPlanCache::instance()->invalidate(vocbase, std::vector<char const*>{ oldName, newName });
 
   TRI_WRITE_UNLOCK_STATUS_VOCBASE_COL(collection);
 
@@ -1177,7 +1208,11 @@ static int LoadCollectionVocBase (TRI_vocbase_t* vocbase,
     // disk activity, index creation etc.)
     TRI_WRITE_UNLOCK_STATUS_VOCBASE_COL(collection);
 
+    // datafiles that are compressed after an unload must not be opened
+    // before the compression is finished
+    TRI_LockMutex(&collection->_compressionLock);
     document = TRI_OpenDocumentCollection(vocbase, collection, IGNORE_DATAFILE_ERRORS);
+    TRI_UnlockMutex(&collection->_compressionLock);
 
     // lock again the adjust the status
     TRI_WRITE_LOCK_STATUS_VOCBASE_COL(collection);
@@ -1325,6 +1360,7 @@ static int ScanTrxCollection (TRI_vocbase_t* vocbase) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void TRI_FreeCollectionVocBase (TRI_vocbase_col_t* collection) {
+  TRI_DestroyMutex(&collection->_compressionLock);
   TRI_DestroyReadWriteLock(&collection->_lock);
 
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, collection);
@@ -1376,6 +1412,7 @@ TRI_vocbase_t* TRI_CreateInitialVocBase (TRI_server_t* server,
   vocbase->_authInfoLoaded     = false;
   vocbase->_hasCompactor       = false;
   vocbase->_isOwnAppsDirectory = true;
+  vocbase->_isShuttingDown     = false;
   vocbase->_replicationApplier = nullptr;
   vocbase->_userStructures     = nullptr;
   vocbase->_cursorRepository   = nullptr;
@@ -1579,6 +1616,9 @@ void TRI_DestroyVocBase (TRI_vocbase_t* vocbase) {
 
   TRI_WRITE_LOCK_COLLECTIONS_VOCBASE(vocbase);
 
+  // the collections unloaded below must not be compressed
+  vocbase->_isShuttingDown = true;
+
   // cannot use this vocbase from now on
   TRI_CopyDataVectorPointer(&collections, &vocbase->_collections);
   TRI_WRITE_UNLOCK_COLLECTIONS_VOCBASE(vocbase);
@@ -2082,6 +2122,7 @@ int TRI_DropCollectionVocBase (TRI_vocbase_t* vocbase,
   TRI_EVENTUAL_WRITE_LOCK_STATUS_VOCBASE_COL(collection);
 
   triagens::aql::QueryCache::instance()->invalidate(vocbase, collection->_name); 
+  triagens::aql::QueryPlanCache::instance()->invalidate(vocbase, collection->_name);
 
   // .............................................................................
   // collection already deleted
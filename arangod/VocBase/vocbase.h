@@ -321,6 +321,7 @@ typedef struct TRI_vocbase_s {
   bool                       _authInfoLoaded;     // flag indicating whether the authentication info was loaded successfully
   bool                       _hasCompactor;
   bool                       _isOwnAppsDirectory;
+  bool                       _isShuttingDown;     // set when the database is destroyed, no datafiles are compressed then
 
   std::set<TRI_voc_tid_t>*   _oldTransactions;
 
@@ -381,6 +382,8 @@ typedef struct TRI_vocbase_col_s {
   TRI_col_type_t                    _type;       // collection type
 
   TRI_read_write_lock_t             _lock;       // lock protecting the status and name
+  TRI_mutex_t                       _compressionLock; // held while the datafiles of an unloaded
+                                                 // collection are compressed
 
   uint32_t                          _internalVersion; // is incremented when a collection is renamed
                                                  // this is used to prevent caching of collection objects
@@ -874,7 +874,21 @@ int CollectorThread::transferMarkers (Logfile* logfile,
   int res = TRI_ERROR_INTERNAL;
 
   try {
-    res = executeTransferMarkers(document, cache, operations);
+    // markers of documents that have already been updated or removed again
+    // do not need to be copied into the datafiles at all
+    OperationsType survivors;
+    OperationsType const* toTransfer = &operations;
+
+    if (removeSupersededMarkers(document, totalOperationsCount, operations, survivors)) {
+      toTransfer = &survivors;
+    }
+
+    if (toTransfer->empty()) {
+      res = TRI_ERROR_NO_ERROR;
+    }
+    else {
+      res = executeTransferMarkers(document, cache, *toTransfer);
+    }
 
     if (res == TRI_ERROR_NO_ERROR && ! cache->operations->empty()) {
       // now sync the datafile
@@ -905,6 +919,106 @@ int CollectorThread::transferMarkers (Logfile* logfile,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove document and edge markers that have already been superseded
+/// by a newer revision or a removal. returns whether any marker was removed
+///
+/// a marker is superseded if the master pointer for its key does not point
+/// to it anymore. write transactions hold the collection's write lock until
+/// they commit or abort, so under the read lock all newer revisions found in
+/// the primary index are committed, and a superseded marker can never become
+/// visible again. the newer revision or removal is in a later logfile that
+/// is collected afterwards, and recovery replays it if the server crashes
+/// before.
+///
+/// recovery can only replay what was synced to disk, though. a marker is
+/// therefore only skipped if whatever superseded it is synced already: for
+/// a newer revision, its tick must not be above the last synced tick. the
+/// tick of a removal is unknown, but it is not above the last tick assigned
+/// to a WAL marker when the lock is acquired, so removed documents are only
+/// skipped if everything up to that tick is synced. if the lock cannot be
+/// acquired immediately, all markers are kept
+////////////////////////////////////////////////////////////////////////////////
+
+bool CollectorThread::removeSupersededMarkers (TRI_document_collection_t* document,
+                                               int64_t totalOperationsCount,
+                                               OperationsType const& operations,
+                                               OperationsType& survivors) {
+  // create a fake transaction while accessing the collection
+  triagens::arango::TransactionBase trx(true);
+
+  if (! TRI_TRY_READ_LOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document)) {
+    return false;
+  }
+
+  size_t removed = 0;
+
+  try {
+    // all removals visible under the lock were assigned a tick already
+    auto slots = _logfileManager->slots();
+    TRI_voc_tick_t const lockTick = static_cast<TRI_voc_tick_t>(slots->lastAssignedTick());
+    TRI_voc_tick_t const syncedTick = static_cast<TRI_voc_tick_t>(slots->lastCommittedTick());
+    bool const removalsSynced = (lockTick <= syncedTick);
+
+    auto primaryIndex = document->primaryIndex();
+    survivors.reserve(operations.size());
+
+    for (auto it = operations.begin(); it != operations.end(); ++it) {
+      TRI_df_marker_t const* source = (*it);
+      char const* key = nullptr;
+
+      if (source->_type == TRI_WAL_MARKER_DOCUMENT) {
+        key = reinterpret_cast<char const*>(source) + reinterpret_cast<document_marker_t const*>(source)->_offsetKey;
+      }
+      else if (source->_type == TRI_WAL_MARKER_EDGE) {
+        key = reinterpret_cast<char const*>(source) + reinterpret_cast<edge_marker_t const*>(source)->_offsetKey;
+      }
+
+      if (key != nullptr) {
+        auto found = static_cast<TRI_doc_mptr_t*>(primaryIndex->lookupKey(key));
+
+        if (found == nullptr) {
+          if (removalsSynced) {
+            ++removed;
+            continue;
+          }
+        }
+        else if (found->getDataPtr() != source &&
+                 static_cast<TRI_df_marker_t const*>(found->getDataPtr())->_tick <= syncedTick) {
+          ++removed;
+          continue;
+        }
+      }
+
+      survivors.push_back(source);
+    }
+
+    if (survivors.empty()) {
+      // nothing will be queued for this collection, so account for the
+      // collected operations here. writers are excluded by the lock
+      document->_uncollectedLogfileEntries -= totalOperationsCount;
+      if (document->_uncollectedLogfileEntries < 0) {
+        document->_uncollectedLogfileEntries = 0;
+      }
+    }
+  }
+  catch (...) {
+    TRI_READ_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
+    survivors.clear();
+    return false;
+  }
+
+  TRI_READ_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
+
+  if (removed > 0) {
+    LOG_TRACE("wal collector skips %llu superseded markers for collection '%s'",
+              (unsigned long long) removed,
+              document->_info._name);
+  }
+
+  return (removed > 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief transfer markers into a collection, actual work
 /// the collection must have been prepared to call this function
@@ -1401,14 +1515,14 @@ void CollectorThread::finishMarker (char const* walPosition,
   // re-use the original WAL marker's tick
   marker->_tick = tick;
 
-  // calculate the CRC
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-  crc = TRI_BlockCrc32(crc, const_cast<char*>(datafilePosition), marker->_size);
-  marker->_crc = TRI_FinalCrc32(crc);
-
   TRI_datafile_t* datafile = cache->lastDatafile;
   TRI_ASSERT(datafile != nullptr);
 
+  // calculate the CRC, using the checksum algorithm of the target datafile
+  TRI_voc_crc_t crc = TRI_InitialCrc32();
+  crc = TRI_BlockCrcDatafile(crc, const_cast<char*>(datafilePosition), marker->_size, datafile->_crc32c);
+  marker->_crc = TRI_FinalCrc32(crc);
+
   // update ticks
   TRI_UpdateTicksDatafile(datafile, marker);
 
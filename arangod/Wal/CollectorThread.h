@@ -318,6 +318,16 @@ namespace triagens {
                              int64_t,
                              OperationsType const&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove document and edge markers that have already been superseded
+/// by a newer revision or a removal. returns whether any marker was removed
+////////////////////////////////////////////////////////////////////////////////
+
+        bool removeSupersededMarkers (TRI_document_collection_t*,
+                                      int64_t,
+                                      OperationsType const&,
+                                      OperationsType&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief transfer markers into a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,7 +48,8 @@ Logfile::Logfile (Logfile::IdType id,
     _users(0),
     _df(df),
     _status(status),
-    _collectQueueSize(0) {
+    _collectQueueSize(0),
+    _reservedSize(df == nullptr ? 0 : df->_currentSize) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -190,6 +191,7 @@ char* Logfile::reserve (size_t size) {
 
   _df->_next += size;
   _df->_currentSize += (TRI_voc_size_t) size;
+  _reservedSize.store(_df->_currentSize, std::memory_order_release);
 
   return result;
 }
@@ -194,6 +194,15 @@ namespace triagens {
           return static_cast<uint64_t>(_df->_maximalSize);
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of bytes handed out to writers so far. unlike
+/// the datafile's _currentSize, this can be read while a writer reserves space
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t reservedSize () const {
+          return static_cast<uint64_t>(_reservedSize.load(std::memory_order_acquire));
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the size of the free space in the logfile
 ////////////////////////////////////////////////////////////////////////////////
@@ -460,6 +469,13 @@ namespace triagens {
 
         std::atomic<int64_t> _collectQueueSize;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copy of the datafile's _currentSize for readers that do not hold
+/// the write turn, e.g. the replication dumper
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<TRI_voc_size_t> _reservedSize;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -138,6 +138,7 @@ LogfileManager::LogfileManager (TRI_server_t* server,
     _maxOpenLogfiles(0),
     _numberOfSlots(1048576),
     _syncInterval(100),
+    _groupCommitDelay(0),
     _maxThrottleWait(15000),
     _throttleWhenPending(0),
     _allowOversizeEntries(true),
@@ -235,6 +236,7 @@ void LogfileManager::setupOptions (std::map<std::string, triagens::basics::Progr
   options["Write-ahead log options:help-wal"]
     ("wal.allow-oversize-entries", &_allowOversizeEntries, "allow entries that are bigger than --wal.logfile-size")
     ("wal.directory", &_directory, "logfile directory")
+    ("wal.group-commit-delay", &_groupCommitDelay, "maximum time to wait for concurrent synchronous commits before syncing (in microseconds, 0 disables group commit)")
     ("wal.historic-logfiles", &_historicLogfiles, "maximum number of historic logfiles to keep after collection")
     ("wal.ignore-logfile-errors", &_ignoreLogfileErrors, "ignore logfile errors. this will read recoverable data from corrupted logfiles but ignore any unrecoverable data")
     ("wal.ignore-recovery-errors", &_ignoreRecoveryErrors, "continue recovery even if re-applying operations fails")
@@ -378,11 +380,12 @@ bool LogfileManager::start () {
 
   started = true;
 
-  LOG_TRACE("WAL logfile manager configuration: historic logfiles: %lu, reserve logfiles: %lu, filesize: %lu, sync interval: %lu",
+  LOG_TRACE("WAL logfile manager configuration: historic logfiles: %lu, reserve logfiles: %lu, filesize: %lu, sync interval: %lu, group commit delay: %lu",
             (unsigned long) _historicLogfiles,
             (unsigned long) _reserveLogfiles,
             (unsigned long) _filesize,
-            (unsigned long) _syncInterval);
+            (unsigned long) _syncInterval,
+            (unsigned long) _groupCommitDelay);
 
   return true;
 }
@@ -739,8 +742,8 @@ bool LogfileManager::hasReserveLogfiles () {
 /// @brief signal that a sync operation is required
 ////////////////////////////////////////////////////////////////////////////////
 
-void LogfileManager::signalSync () {
-  _synchroniserThread->signalSync();
+void LogfileManager::signalSync (bool waitForSync) {
+  _synchroniserThread->signalSync(waitForSync);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1053,7 +1056,7 @@ void LogfileManager::setLogfileSealRequested (Logfile* logfile) {
 
   WRITE_LOCKER(_logfilesLock);
   logfile->setStatus(Logfile::StatusType::SEAL_REQUESTED);
-  signalSync();
+  signalSync(false);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1119,7 +1122,6 @@ int LogfileManager::getLogfileDescriptor (Logfile::IdType id) {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the current open region of a logfile
-/// this uses the slots lock
 ////////////////////////////////////////////////////////////////////////////////
 
 void LogfileManager::getActiveLogfileRegion (Logfile* logfile,
@@ -1462,6 +1464,16 @@ LogfileManagerState LogfileManager::state () {
   return state;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the statistics for synchronous commits
+////////////////////////////////////////////////////////////////////////////////
+
+void LogfileManager::syncStatistics (uint64_t& syncs,
+                                     uint64_t& commits,
+                                     double& recentCommitsPerSync) {
+  _synchroniserThread->statistics(syncs, commits, recentCommitsPerSync);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -197,6 +197,22 @@ namespace triagens {
           _syncInterval = value * 1000;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the maximum group commit delay (in microseconds)
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t groupCommitDelay () const {
+          return _groupCommitDelay;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum group commit delay (in microseconds)
+////////////////////////////////////////////////////////////////////////////////
+
+        inline void groupCommitDelay (uint64_t value) {
+          _groupCommitDelay = value;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the number of reserve logfiles
 ////////////////////////////////////////////////////////////////////////////////
@@ -419,7 +435,7 @@ namespace triagens {
 /// @brief signal that a sync operation is required
 ////////////////////////////////////////////////////////////////////////////////
 
-        void signalSync ();
+        void signalSync (bool);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief reserve space in a logfile
@@ -546,7 +562,6 @@ namespace triagens {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the current open region of a logfile
-/// this uses the slots lock
 ////////////////////////////////////////////////////////////////////////////////
 
         void getActiveLogfileRegion (Logfile*,
@@ -635,6 +650,14 @@ namespace triagens {
 
         LogfileManagerState state ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the statistics for synchronous commits
+////////////////////////////////////////////////////////////////////////////////
+
+        void syncStatistics (uint64_t&,
+                             uint64_t&,
+                             double&);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -912,6 +935,24 @@ namespace triagens {
 
         uint64_t _syncInterval;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum delay for group commits
+/// @startDocuBlock WalLogfileGroupCommitDelay
+/// `--wal.group-commit-delay`
+///
+/// The maximum time (in microseconds) the write-ahead log synchroniser will
+/// wait for concurrent synchronous commits before it syncs the logfile, so
+/// that they can share a single disk sync. Only operations executed with the
+/// *waitForSync* attribute are affected.
+/// The synchroniser only waits when recent syncs covered more than one
+/// synchronous commit on average, and it stops waiting as soon as that many
+/// commits are pending. A single synchronous writer is thus never delayed.
+/// A value of *0*, which is the default, disables group commit.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _groupCommitDelay;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief maximum wait time for write-throttling
 ////////////////////////////////////////////////////////////////////////////////
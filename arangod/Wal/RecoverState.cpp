@@ -1153,12 +1153,18 @@ bool RecoverState::ReplayMarker (TRI_df_marker_t const* marker,
       parameters._doCompact = true;
       parameters._waitForSync = vocbase->_settings.defaultWaitForSync;
       parameters._maximalSize = vocbase->_settings.defaultMaximalSize; 
+      parameters._compressDatafiles = false;
 
       value = TRI_LookupObjectJson(json, "doCompact");
       if (TRI_IsBooleanJson(value)) {
         parameters._doCompact = value->_value._boolean;
       }
       
+      value = TRI_LookupObjectJson(json, "compressDatafiles");
+      if (TRI_IsBooleanJson(value)) {
+        parameters._compressDatafiles = value->_value._boolean;
+      }
+      
       value = TRI_LookupObjectJson(json, "waitForSync");
       if (TRI_IsBooleanJson(value)) {
         parameters._waitForSync = value->_value._boolean;
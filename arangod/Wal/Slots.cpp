@@ -38,6 +38,54 @@
 
 using namespace triagens::wal;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private constants
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bit position of the slot counter in the reservation word
+///
+/// Writers reserve a slot and space in the current logfile with a single
+/// fetch-add on the reservation word, which contains the number of slots
+/// (upper 24 bits) and bytes (lower 40 bits) handed out in the current
+/// reservation window. A window covers the free space of one logfile.
+/// Reservations that end after the window end are invalid. As both counters
+/// only grow, the valid reservations form a prefix, and the first invalid
+/// reservation is responsible for switching the logfile and opening the next
+/// window. All other invalid reservations wait for the switch and try again.
+///
+/// Reserved slots are published in the order of their sequence numbers: the
+/// writer waits until all slots before its own have been published, then
+/// takes the memory from the logfile, assigns the tick and passes the turn on.
+/// This is the only serialised part, and it keeps ticks, slots and logfile
+/// positions in the same order as before, which the synchroniser and the
+/// collector rely on.
+////////////////////////////////////////////////////////////////////////////////
+
+static int const CountShift = 40;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief mask for the byte counter in the reservation word
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t const OffsetMask = (static_cast<uint64_t>(1) << CountShift) - 1;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of slots in one reservation window
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t const MaxWindowSlots = static_cast<uint64_t>(1) << 22;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief end of a reservation window
+///
+/// the byte counter of a new window starts at WindowEnd minus the free size
+/// of the logfile. this leaves enough room above WindowEnd for the invalid
+/// reservations made while the logfile is switched
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t const WindowEnd = static_cast<uint64_t>(1) << 38;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -54,13 +102,17 @@ Slots::Slots (LogfileManager* logfileManager,
     _lock(),
     _slots(new Slot[numberOfSlots]),
     _numberOfSlots(numberOfSlots),
-    _freeSlots(numberOfSlots),
+    _reservation(WindowEnd),
+    _windowStart(0),
+    _handoutTurn(0),
+    _turnCondition(),
+    _turnWaiters(0),
+    _recycled(0),
+    _generation(0),
     _waiting(0),
-    _handoutIndex(0),
-    _recycleIndex(0),
     _logfile(nullptr),
-    _lastAssignedTick(0),
     _lastCommittedTick(0),
+    _lastAssignedTick(0),
     _lastCommittedDataTick(0),
     _numEvents(0)  {
 }
@@ -87,9 +139,9 @@ void Slots::statistics (Slot::TickType& lastTick,
                         Slot::TickType& lastDataTick,
                         uint64_t& numEvents) {
   MUTEX_LOCKER(_lock);
-  lastTick     = _lastCommittedTick;
+  lastTick     = _lastCommittedTick.load();
   lastDataTick = _lastCommittedDataTick;
-  numEvents    = _numEvents;
+  numEvents    = _numEvents.load();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -103,7 +155,7 @@ int Slots::flush (bool waitForSync) {
   int res = closeLogfile(lastTick, worked);
 
   if (res == TRI_ERROR_NO_ERROR) {
-    _logfileManager->signalSync();
+    _logfileManager->signalSync(false);
 
     if (waitForSync) {
       // wait until data has been committed to disk
@@ -127,119 +179,23 @@ int Slots::flush (bool waitForSync) {
 ////////////////////////////////////////////////////////////////////////////////
 
 Slot::TickType Slots::lastCommittedTick () {
-  MUTEX_LOCKER(_lock);
-  return _lastCommittedTick;
+  return _lastCommittedTick.load(std::memory_order_acquire);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief return the next unused slot
+/// @brief return the tick of the last marker published by a writer
 ////////////////////////////////////////////////////////////////////////////////
 
-SlotInfo Slots::nextUnused (uint32_t size) {
-  // we need to use the aligned size for writing
-  uint32_t alignedSize = TRI_DF_ALIGN_BLOCK(size);
-  int iterations = 0;
-  bool hasWaited = false;
-
-  TRI_ASSERT(size > 0);
-
-  while (++iterations < 1000) {
-    {
-      MUTEX_LOCKER(_lock);
-
-      Slot* slot = &_slots[_handoutIndex];
-      TRI_ASSERT(slot != nullptr);
-
-      if (slot->isUnused()) {
-        if (hasWaited) {
-          CONDITION_LOCKER(guard, _condition);
-          TRI_ASSERT(_waiting > 0);
-          --_waiting;
-          hasWaited = false;
-        }
-
-        // cycle until we have a valid logfile
-        while (_logfile == nullptr ||
-               _logfile->freeSize() < static_cast<uint64_t>(alignedSize)) {
-
-          if (_logfile != nullptr) {
-            // seal existing logfile by creating a footer marker
-            int res = writeFooter(slot);
-
-            if (res != TRI_ERROR_NO_ERROR) {
-              return SlotInfo(res);
-            }
-
-            // advance to next slot
-            slot = &_slots[_handoutIndex];
-            _logfileManager->setLogfileSealRequested(_logfile);
-
-            _logfile = nullptr;
-          }
-
-          // fetch the next free logfile (this may create a new one)
-          Logfile::StatusType status = newLogfile(alignedSize);
-
-          if (_logfile == nullptr) {
-            usleep(10 * 1000);
-
-            TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
-              return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
-            }
-
-            // try again in next iteration
-          }
-          else if (status == Logfile::StatusType::EMPTY) {
-            // inititialise the empty logfile by writing a header marker
-            int res = writeHeader(slot);
-
-            if (res != TRI_ERROR_NO_ERROR) {
-              return SlotInfo(res);
-            }
-
-            // advance to next slot
-            slot = &_slots[_handoutIndex];
-            _logfileManager->setLogfileOpen(_logfile);
-          }
-          else {
-            TRI_ASSERT(status == Logfile::StatusType::OPEN);
-          }
-        }
-
-        // if we get here, we got a free slot for the actual data...
-
-        char* mem = _logfile->reserve(alignedSize);
-
-        if (mem == nullptr) {
-          return SlotInfo(TRI_ERROR_INTERNAL);
-        }
-
-        // only in this case we return a valid slot
-        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
-
-        return SlotInfo(slot);
-      }
-    }
-
-    // if we get here, all slots are busy
-    CONDITION_LOCKER(guard, _condition);
-    if (! hasWaited) {
-      ++_waiting;
-      hasWaited = true;
-    }
-
-    bool mustWait;
-    {
-      MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
-    }
+Slot::TickType Slots::lastAssignedTick () {
+  return _lastAssignedTick.load(std::memory_order_acquire);
+}
 
-    if (mustWait) {
-      guard.wait(10 * 1000);
-    }
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next unused slot
+////////////////////////////////////////////////////////////////////////////////
 
-  return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
+SlotInfo Slots::nextUnused (uint32_t size) {
+  return allocate(size, 0, 0, 0, nullptr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -255,125 +211,7 @@ SlotInfo Slots::nextUnused (uint32_t size,
                             uint32_t legendOffset,
                             void*& oldLegend) {
                             // legendOffset 0 means no legend included
-  // we need to use the aligned size for writing
-  uint32_t alignedSize = TRI_DF_ALIGN_BLOCK(size);
-  int iterations = 0;
-  bool hasWaited = false;
-
-  TRI_ASSERT(size > 0);
-
-  while (++iterations < 1000) {
-    {
-      MUTEX_LOCKER(_lock);
-
-      Slot* slot = &_slots[_handoutIndex];
-      TRI_ASSERT(slot != nullptr);
-
-      if (slot->isUnused()) {
-        if (hasWaited) {
-          CONDITION_LOCKER(guard, _condition);
-          TRI_ASSERT(_waiting > 0);
-          --_waiting;
-          hasWaited = false;
-        }
-
-        // cycle until we have a valid logfile
-        while (_logfile == nullptr ||
-               _logfile->freeSize() < static_cast<uint64_t>(alignedSize)) {
-
-          if (_logfile != nullptr) {
-            // seal existing logfile by creating a footer marker
-            int res = writeFooter(slot);
-
-            if (res != TRI_ERROR_NO_ERROR) {
-              return SlotInfo(res);
-            }
-
-            // advance to next slot
-            slot = &_slots[_handoutIndex];
-            _logfileManager->setLogfileSealRequested(_logfile);
-
-            _logfile = nullptr;
-          }
-
-          // fetch the next free logfile (this may create a new one)
-          Logfile::StatusType status = newLogfile(alignedSize);
-
-          if (_logfile == nullptr) {
-            usleep(10 * 1000);
-
-            TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
-              return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
-            }
-
-            // try again in next iteration
-          }
-          else if (status == Logfile::StatusType::EMPTY) {
-            // inititialise the empty logfile by writing a header marker
-            int res = writeHeader(slot);
-
-            if (res != TRI_ERROR_NO_ERROR) {
-              return SlotInfo(res);
-            }
-
-            // advance to next slot
-            slot = &_slots[_handoutIndex];
-            _logfileManager->setLogfileOpen(_logfile);
-          }
-          else {
-            TRI_ASSERT(status == Logfile::StatusType::OPEN);
-          }
-        }
-
-        // if we get here, we got a free slot for the actual data...
-        
-        // Now sort out the legend business:
-        if (legendOffset == 0) {
-          void* legend = _logfile->lookupLegend(cid, sid);
-          if (nullptr == legend) {
-            // Bad, we would need a legend for this marker
-            return SlotInfo(TRI_ERROR_LEGEND_NOT_IN_WAL_FILE);
-          }
-          oldLegend = legend;
-        }
-
-        char* mem = _logfile->reserve(alignedSize);
-
-        if (mem == nullptr) {
-          return SlotInfo(TRI_ERROR_INTERNAL);
-        }
-
-        if (legendOffset != 0) {
-          void* legend = static_cast<void*>(mem + legendOffset);
-          _logfile->cacheLegend(cid, sid, legend);
-        }
-
-        // only in this case we return a valid slot
-        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
-
-        return SlotInfo(slot);
-      }
-    }
-
-    // if we get here, all slots are busy
-    CONDITION_LOCKER(guard, _condition);
-    if (! hasWaited) {
-      ++_waiting;
-      hasWaited = true;
-    }
-
-    bool mustWait;
-    {
-      MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
-    }
-
-    if (mustWait) {
-      guard.wait(10 * 1000);
-    }
-  }
-
-  return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
+  return allocate(size, cid, sid, legendOffset, &oldLegend);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -387,13 +225,10 @@ void Slots::returnUsed (SlotInfo& slotInfo,
 
   TRI_ASSERT(tick > 0);
 
-  {
-    MUTEX_LOCKER(_lock);
-    slotInfo.slot->setReturned(waitForSync);
-    ++_numEvents;
-  }
+  slotInfo.slot->setReturned(waitForSync);
+  ++_numEvents;
 
-  _logfileManager->signalSync();
+  _logfileManager->signalSync(waitForSync);
 
   if (waitForSync) {
     waitForTick(tick);
@@ -409,7 +244,8 @@ SyncRegion Slots::getSyncRegion () {
 
   MUTEX_LOCKER(_lock);
 
-  size_t slotIndex = _recycleIndex;
+  size_t const recycleIndex = static_cast<size_t>(_recycled.load() % _numberOfSlots);
+  size_t slotIndex = recycleIndex;
 
   while (true) {
     Slot const* slot = &_slots[slotIndex];
@@ -457,11 +293,17 @@ SyncRegion Slots::getSyncRegion () {
       region.waitForSync |= slot->waitForSync();
     }
 
+    if (slot->waitForSync() &&
+        static_cast<TRI_df_marker_t const*>(slot->mem())->_type != TRI_DF_MARKER_FOOTER) {
+      // a synchronous commit
+      ++region.waitForSyncCount;
+    }
+
     if (++slotIndex >= _numberOfSlots) {
       slotIndex = 0;
     }
 
-    if (slotIndex == _recycleIndex) {
+    if (slotIndex == recycleIndex) {
       // one full loop
       break;
     }
@@ -488,13 +330,14 @@ void Slots::returnSyncRegion (SyncRegion const& region) {
 
       // note last tick
       Slot::TickType tick = slot->tick();
-      TRI_ASSERT(tick >= _lastCommittedTick);
-      _lastCommittedTick = tick;
+      TRI_ASSERT(tick >= _lastCommittedTick.load());
+      _lastCommittedTick.store(tick, std::memory_order_release);
 
       // update the data tick
       TRI_df_marker_t const* m = static_cast<TRI_df_marker_t const*>(slot->mem());
       if (m->_type != TRI_DF_MARKER_HEADER && 
           m->_type != TRI_DF_MARKER_FOOTER && 
+          m->_type != TRI_DF_MARKER_BLANK &&
           m->_type != TRI_WAL_MARKER_ATTRIBUTE &&
           m->_type != TRI_WAL_MARKER_SHAPE) {
         _lastCommittedDataTick = tick;
@@ -503,12 +346,9 @@ void Slots::returnSyncRegion (SyncRegion const& region) {
       region.logfile->update(m);
 
       slot->setUnused();
-      ++_freeSlots;
 
-      // update recycle index, too
-      if (++_recycleIndex >= _numberOfSlots) {
-        _recycleIndex = 0;
-      }
+      // the slot can now be handed out again
+      _recycled.store(_recycled.load() + 1, std::memory_order_release);
 
       if (slotIndex == region.lastSlotIndex) {
         break;
@@ -530,23 +370,24 @@ void Slots::returnSyncRegion (SyncRegion const& region) {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the current open region of a logfile
-/// this uses the slots lock
+/// this does not use the slots lock. writers reserve logfile space without
+/// it, so the end is taken from the logfile's atomic copy of the datafile
+/// size and not from the datafile itself
 ////////////////////////////////////////////////////////////////////////////////
 
 void Slots::getActiveLogfileRegion (Logfile* logfile,
                                     char const*& begin,
                                     char const*& end) {
-  MUTEX_LOCKER(_lock);
-
   TRI_datafile_t* datafile = logfile->df();
 
   begin = datafile->_data;
-  end   = begin + datafile->_currentSize;
+  end   = begin + logfile->reservedSize();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the current tick range of a logfile
-/// this uses the slots lock
+/// this uses the slots lock, which returnSyncRegion holds when it updates
+/// the tick range
 ////////////////////////////////////////////////////////////////////////////////
 
 void Slots::getActiveTickRange (Logfile* logfile,
@@ -565,6 +406,283 @@ void Slots::getActiveTickRange (Logfile* logfile,
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next unused slot, optionally handling legends
+///
+/// legends are only handled if oldLegend is not a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+SlotInfo Slots::allocate (uint32_t size,
+                          TRI_voc_cid_t cid,
+                          TRI_shape_sid_t sid,
+                          uint32_t legendOffset,
+                          void** oldLegend) {
+  // we need to use the aligned size for writing
+  uint32_t alignedSize = TRI_DF_ALIGN_BLOCK(size);
+  int iterations = 0;
+  bool hasWaited = false;
+
+  TRI_ASSERT(size > 0);
+
+  while (++iterations < 1000) {
+    if (waitWhileFull(hasWaited)) {
+      // all slots are busy
+      continue;
+    }
+
+    uint64_t sequence;
+    uint64_t generation;
+    ReservationType type = reserve(alignedSize, sequence, generation);
+
+    if (type == ReservationType::MUST_WAIT) {
+      // another writer is switching the logfile
+      waitForSwitch(generation);
+      continue;
+    }
+
+    if (type == ReservationType::MUST_SWITCH) {
+      // the marker does not fit into the current logfile and we are the
+      // first one to notice
+      int res = switchLogfile(sequence, alignedSize);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return SlotInfo(res);
+      }
+    }
+
+    // if we get here, we got a slot for the actual data...
+    return publish(sequence, size, cid, sid, legendOffset, oldLegend);
+  }
+
+  return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reserve a slot sequence number and space in the current logfile
+///
+/// a size of 0 closes the current window, so that the caller can switch the
+/// logfile. the generation is returned so that callers which must wait know
+/// which switch to wait for
+////////////////////////////////////////////////////////////////////////////////
+
+Slots::ReservationType Slots::reserve (uint64_t size,
+                                       uint64_t& sequence,
+                                       uint64_t& generation) {
+  uint64_t const one = static_cast<uint64_t>(1) << CountShift;
+
+  generation = _generation.load(std::memory_order_acquire);
+
+  uint64_t old;
+
+  if (size > 0) {
+    old = _reservation.fetch_add(one + size, std::memory_order_acq_rel);
+  }
+  else {
+    // move the byte counter past the window end, so no later reservation
+    // will be valid
+    old = _reservation.load(std::memory_order_relaxed);
+    uint64_t value;
+
+    do {
+      uint64_t offset = old & OffsetMask;
+      value = old + one;
+
+      if (offset <= WindowEnd) {
+        value += WindowEnd + 1 - offset;
+      }
+    }
+    while (! _reservation.compare_exchange_weak(old, value, std::memory_order_acq_rel, std::memory_order_relaxed));
+  }
+
+  uint64_t const count  = old >> CountShift;
+  uint64_t const offset = old & OffsetMask;
+
+  if (size > 0 && 
+      count < MaxWindowSlots && 
+      offset + size <= WindowEnd) {
+    // the window start cannot change before we have published our slot
+    sequence = _windowStart + count;
+    return ReservationType::RESERVED;
+  }
+
+  if (count == 0 || 
+      (count <= MaxWindowSlots && offset <= WindowEnd)) {
+    // the previous reservation was still valid, so this is the first
+    // invalid one
+    sequence = _windowStart + count;
+    return ReservationType::MUST_SWITCH;
+  }
+
+  return ReservationType::MUST_WAIT;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief publish a reserved slot in the current logfile
+///
+/// the slot is always published, even if an error is returned, because the
+/// following slots cannot be published before it
+////////////////////////////////////////////////////////////////////////////////
+
+SlotInfo Slots::publish (uint64_t sequence,
+                         uint32_t size,
+                         TRI_voc_cid_t cid,
+                         TRI_shape_sid_t sid,
+                         uint32_t legendOffset,
+                         void** oldLegend) {
+  waitForTurn(sequence);
+
+  Slot* slot = waitForSlot(sequence);
+  TRI_ASSERT(_logfile != nullptr);
+
+  // Now sort out the legend business:
+  if (oldLegend != nullptr && legendOffset == 0) {
+    void* legend = _logfile->lookupLegend(cid, sid);
+
+    if (nullptr == legend) {
+      // Bad, we would need a legend for this marker. the space is already
+      // reserved, so fill the slot with a blank marker instead
+      writeBlank(slot);
+      passTurn(sequence + 1);
+
+      return SlotInfo(TRI_ERROR_LEGEND_NOT_IN_WAL_FILE);
+    }
+
+    *oldLegend = legend;
+  }
+
+  char* mem = _logfile->reserve(size);
+  TRI_ASSERT(mem != nullptr);
+
+  if (oldLegend != nullptr && legendOffset != 0) {
+    void* legend = static_cast<void*>(mem + legendOffset);
+    _logfile->cacheLegend(cid, sid, legend);
+  }
+
+  Slot::TickType const tick = static_cast<Slot::TickType>(TRI_NewTickServer());
+  slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), tick);
+  _lastAssignedTick.store(tick, std::memory_order_release);
+  SlotInfo result(slot);
+
+  // let the next writer publish its slot
+  passTurn(sequence + 1);
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief switch to a logfile that can hold a marker of the specified size
+///
+/// sequence must be the first invalid reservation of the current window. on
+/// success, it contains the sequence number of the slot reserved for the
+/// marker in the next window
+////////////////////////////////////////////////////////////////////////////////
+
+int Slots::switchLogfile (uint64_t& sequence,
+                          uint32_t size) {
+  // when it is our turn, all valid reservations of the window have been
+  // published and no one else can publish until we open the next window
+  waitForTurn(sequence);
+
+  uint64_t next = sequence;
+  int res = TRI_ERROR_NO_ERROR;
+
+  // cycle until we have a valid logfile
+  while (_logfile == nullptr ||
+         _logfile->freeSize() < static_cast<uint64_t>(size)) {
+
+    if (_logfile != nullptr) {
+      // seal existing logfile by creating a footer marker
+      res = writeFooter(waitForSlot(next));
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        break;
+      }
+
+      // advance to next slot
+      ++next;
+      _logfileManager->setLogfileSealRequested(_logfile);
+
+      _logfile = nullptr;
+    }
+
+    // fetch the next free logfile (this may create a new one)
+    Logfile::StatusType status = newLogfile(size);
+
+    if (_logfile == nullptr) {
+      usleep(10 * 1000);
+
+      TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
+        res = TRI_ERROR_ARANGO_NO_JOURNAL;
+        break;
+      }
+
+      // try again in next iteration
+    }
+    else if (status == Logfile::StatusType::EMPTY) {
+      // inititialise the empty logfile by writing a header marker
+      res = writeHeader(waitForSlot(next));
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        break;
+      }
+
+      // advance to next slot
+      ++next;
+      _logfileManager->setLogfileOpen(_logfile);
+    }
+    else {
+      TRI_ASSERT(status == Logfile::StatusType::OPEN);
+    }
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    // hand over to the next writer, which will try the switch again
+    openWindow(next, 0);
+    return res;
+  }
+
+  // the first slot of the new window belongs to us
+  sequence = next;
+  openWindow(next, size);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief open a new reservation window in the current logfile
+///
+/// the window starts at the specified sequence number. if size is not 0, the
+/// first slot of the window and the specified number of bytes are already
+/// taken by the caller. without a logfile, the window is opened closed, so
+/// the next writer will switch the logfile
+////////////////////////////////////////////////////////////////////////////////
+
+void Slots::openWindow (uint64_t start,
+                        uint32_t size) {
+  uint64_t count  = 0;
+  uint64_t offset = WindowEnd;
+
+  if (_logfile != nullptr) {
+    uint64_t const freeSize = _logfile->freeSize();
+    TRI_ASSERT(freeSize >= static_cast<uint64_t>(size));
+
+    offset = WindowEnd - freeSize + size;
+  }
+
+  if (size > 0) {
+    count = 1;
+  }
+
+  _windowStart = start;
+  _reservation.store((count << CountShift) | offset, std::memory_order_release);
+  passTurn(start);
+  ++_generation;
+
+  // wake up the writers waiting for the switch
+  CONDITION_LOCKER(guard, _condition);
+  _condition.broadcast();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief close a logfile
 ////////////////////////////////////////////////////////////////////////////////
@@ -576,98 +694,93 @@ int Slots::closeLogfile (Slot::TickType& lastCommittedTick,
   worked = false;
 
   while (++iterations < 1000) {
-    {
-      MUTEX_LOCKER(_lock);
+    lastCommittedTick = _lastCommittedTick.load();
 
-      lastCommittedTick = _lastCommittedTick;
+    if (waitWhileFull(hasWaited)) {
+      // all slots are busy
+      continue;
+    }
 
-      Slot* slot = &_slots[_handoutIndex];
-      TRI_ASSERT(slot != nullptr);
+    uint64_t sequence;
+    uint64_t generation;
+    ReservationType type = reserve(0, sequence, generation);
 
-      if (slot->isUnused()) {
-        if (hasWaited) {
-          CONDITION_LOCKER(guard, _condition);
-          TRI_ASSERT(_waiting > 0);
-          --_waiting;
-          hasWaited = false;
-        }
-
-        if (_logfile != nullptr) {
-          if (_logfile->status() == Logfile::StatusType::EMPTY) {
-            // no need to seal a still-empty logfile
-            return TRI_ERROR_NO_ERROR;
-          }
-
-          // seal existing logfile by creating a footer marker
-          int res = writeFooter(slot);
-
-          if (res != TRI_ERROR_NO_ERROR) {
-            LOG_ERROR("could not write logfile footer: %s", TRI_errno_string(res));
-            return res;
-          }
-
-          _logfileManager->setLogfileSealRequested(_logfile);
-
-          // advance to next slot
-          slot = &_slots[_handoutIndex];
-
-          // invalidate the logfile so for the next write we'll use a
-          // new one
-          _logfile = nullptr;
-
-          // fall-through intentional
-        }
-
-        TRI_ASSERT(_logfile == nullptr);
-        // fetch the next free logfile (this may create a new one)
-        // note: as we don't have a real marker to write the size does
-        // not matter (we use a size of 1 as  it must be > 0)
-        Logfile::StatusType status = newLogfile(1);
-
-        if (_logfile == nullptr) {
-          TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
-            return TRI_ERROR_ARANGO_NO_JOURNAL;
-          }
-
-          usleep(10 * 1000);
-          // try again in next iteration
-        }
-        else if (status == Logfile::StatusType::EMPTY) {
-          // inititialise the empty logfile by writing a header marker
-          int res = writeHeader(slot);
-
-          if (res != TRI_ERROR_NO_ERROR) {
-            LOG_ERROR("could not write logfile header: %s", TRI_errno_string(res));
-            return res;
-          }
-
-          _logfileManager->setLogfileOpen(_logfile);
-          worked = true;
-          return TRI_ERROR_NO_ERROR;
-        }
-        else {
-          TRI_ASSERT(status == Logfile::StatusType::OPEN);
-          worked = false;
-          return TRI_ERROR_NO_ERROR;
-        }
-      }
+    if (type == ReservationType::MUST_WAIT) {
+      // another writer is switching the logfile. close the one it
+      // switches to
+      waitForSwitch(generation);
+      continue;
     }
 
-    // if we get here, all slots are busy
-    CONDITION_LOCKER(guard, _condition);
-    if (! hasWaited) {
-      ++_waiting;
-      hasWaited = true;
+    TRI_ASSERT(type == ReservationType::MUST_SWITCH);
+    waitForTurn(sequence);
+
+    uint64_t next = sequence;
+
+    if (_logfile != nullptr) {
+      if (_logfile->status() == Logfile::StatusType::EMPTY) {
+        // no need to seal a still-empty logfile
+        openWindow(next, 0);
+        return TRI_ERROR_NO_ERROR;
+      }
+
+      // seal existing logfile by creating a footer marker
+      int res = writeFooter(waitForSlot(next));
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        LOG_ERROR("could not write logfile footer: %s", TRI_errno_string(res));
+        openWindow(next, 0);
+        return res;
+      }
+
+      _logfileManager->setLogfileSealRequested(_logfile);
+
+      // advance to next slot
+      ++next;
+
+      // invalidate the logfile so for the next write we'll use a
+      // new one
+      _logfile = nullptr;
+
+      // fall-through intentional
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
+    TRI_ASSERT(_logfile == nullptr);
+    // fetch the next free logfile (this may create a new one)
+    // note: as we don't have a real marker to write the size does
+    // not matter (we use a size of 1 as  it must be > 0)
+    Logfile::StatusType status = newLogfile(1);
+
+    if (_logfile == nullptr) {
+      openWindow(next, 0);
+
+      TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
+        return TRI_ERROR_ARANGO_NO_JOURNAL;
+      }
+
+      usleep(10 * 1000);
+      // try again in next iteration
     }
+    else if (status == Logfile::StatusType::EMPTY) {
+      // inititialise the empty logfile by writing a header marker
+      int res = writeHeader(waitForSlot(next));
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        LOG_ERROR("could not write logfile header: %s", TRI_errno_string(res));
+        openWindow(next, 0);
+        return res;
+      }
 
-    if (mustWait) {
-      guard.wait(10 * 1000);
+      _logfileManager->setLogfileOpen(_logfile);
+      openWindow(next + 1, 0);
+      worked = true;
+      return TRI_ERROR_NO_ERROR;
+    }
+    else {
+      TRI_ASSERT(status == Logfile::StatusType::OPEN);
+      openWindow(next, 0);
+      worked = false;
+      return TRI_ERROR_NO_ERROR;
     }
   }
 
@@ -685,7 +798,7 @@ int Slots::writeHeader (Slot* slot) {
   TRI_df_marker_t* mem = reinterpret_cast<TRI_df_marker_t*>(_logfile->reserve(size));
   TRI_ASSERT(mem != nullptr);
 
-  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout());
+  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), static_cast<Slot::TickType>(TRI_NewTickServer()));
   slot->fill(&header.base, size);
   slot->setReturned(false); // sync
 
@@ -705,7 +818,7 @@ int Slots::writeFooter (Slot* slot) {
   TRI_df_marker_t* mem = reinterpret_cast<TRI_df_marker_t*>(_logfile->reserve(size));
   TRI_ASSERT(mem != nullptr);
 
-  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout());
+  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), static_cast<Slot::TickType>(TRI_NewTickServer()));
   slot->fill(&footer.base, size);
   slot->setReturned(true); // sync
 
@@ -713,20 +826,150 @@ int Slots::writeFooter (Slot* slot) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief handout a region and advance the handout index
+/// @brief write a blank marker into a slot that cannot be used otherwise
+////////////////////////////////////////////////////////////////////////////////
+
+void Slots::writeBlank (Slot* slot) {
+  TRI_ASSERT(_logfile != nullptr);
+
+  TRI_df_marker_t blank;
+  size_t const size = sizeof(TRI_df_marker_t);
+  TRI_InitMarkerDatafile(reinterpret_cast<char*>(&blank), TRI_DF_MARKER_BLANK, static_cast<TRI_voc_size_t>(size));
+
+  TRI_df_marker_t* mem = reinterpret_cast<TRI_df_marker_t*>(_logfile->reserve(size));
+  TRI_ASSERT(mem != nullptr);
+
+  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), static_cast<Slot::TickType>(TRI_NewTickServer()));
+  slot->fill(&blank, size);
+  slot->setReturned(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until all slots with lower sequence numbers were published
+///
+/// only the writer that is next in line spins for a short while. all others,
+/// and the next writer if the one before it is switching the logfile or was
+/// descheduled, sleep until their turn is passed on to them. otherwise all
+/// waiting writers would compete for the CPU with the one they wait for
+////////////////////////////////////////////////////////////////////////////////
+
+void Slots::waitForTurn (uint64_t sequence) {
+  uint64_t const turn = _handoutTurn.load(std::memory_order_acquire);
+
+  if (turn == sequence) {
+    return;
+  }
+
+  if (sequence - turn == 1) {
+    for (int iterations = 0; iterations < 100; ++iterations) {
+      std::this_thread::yield();
+
+      if (_handoutTurn.load(std::memory_order_acquire) == sequence) {
+        return;
+      }
+    }
+  }
+
+  CONDITION_LOCKER(guard, _turnCondition);
+  ++_turnWaiters;
+
+  // passTurn stores the turn before it checks for waiters, and we register
+  // before we check the turn, so one of us sees the other
+  while (_handoutTurn.load() != sequence) {
+    guard.wait(10 * 1000);
+  }
+
+  --_turnWaiters;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief let the writer with the specified sequence number publish its slot
+////////////////////////////////////////////////////////////////////////////////
+
+void Slots::passTurn (uint64_t sequence) {
+  _handoutTurn.store(sequence);
+
+  if (_turnWaiters.load() > 0) {
+    CONDITION_LOCKER(guard, _turnCondition);
+    guard.broadcast();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until the slot for a sequence number has been recycled
+////////////////////////////////////////////////////////////////////////////////
+
+Slot* Slots::waitForSlot (uint64_t sequence) {
+  if (sequence >= _recycled.load(std::memory_order_acquire) + _numberOfSlots) {
+    CONDITION_LOCKER(guard, _condition);
+    ++_waiting;
+
+    while (sequence >= _recycled.load(std::memory_order_acquire) + _numberOfSlots) {
+      guard.wait(10 * 1000);
+    }
+
+    TRI_ASSERT(_waiting > 0);
+    --_waiting;
+  }
+
+  Slot* slot = &_slots[sequence % _numberOfSlots];
+  TRI_ASSERT(slot->isUnused());
+
+  return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait while all slots are in use
+///
+/// returns true if the caller had to wait. hasWaited is kept by the caller
+/// across calls, so the number of waiting writers is tracked correctly
+////////////////////////////////////////////////////////////////////////////////
+
+bool Slots::waitWhileFull (bool& hasWaited) {
+  // the recycled counter must be read first, as it never overtakes the
+  // handout turn
+  uint64_t recycled = _recycled.load(std::memory_order_acquire);
+
+  if (! hasWaited &&
+      _handoutTurn.load(std::memory_order_acquire) - recycled < _numberOfSlots) {
+    return false;
+  }
+
+  CONDITION_LOCKER(guard, _condition);
+
+  recycled = _recycled.load(std::memory_order_acquire);
+
+  if (_handoutTurn.load(std::memory_order_acquire) - recycled < _numberOfSlots) {
+    if (hasWaited) {
+      TRI_ASSERT(_waiting > 0);
+      --_waiting;
+      hasWaited = false;
+    }
+
+    return false;
+  }
+
+  // if we get here, all slots are busy
+  if (! hasWaited) {
+    ++_waiting;
+    hasWaited = true;
+  }
+
+  guard.wait(10 * 1000);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until the logfile switch of a generation has finished
 ////////////////////////////////////////////////////////////////////////////////
 
-Slot::TickType Slots::handout () {
-  TRI_ASSERT(_freeSlots > 0);
-  _freeSlots--;
+void Slots::waitForSwitch (uint64_t generation) {
+  CONDITION_LOCKER(guard, _condition);
 
-  if (++_handoutIndex ==_numberOfSlots) {
-    // wrap around
-    _handoutIndex = 0;
+  while (_generation.load(std::memory_order_acquire) == generation) {
+    guard.wait(10 * 1000);
   }
- 
-  _lastAssignedTick = static_cast<Slot::TickType>(TRI_NewTickServer());
-  return _lastAssignedTick;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
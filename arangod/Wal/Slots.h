@@ -156,6 +156,13 @@ namespace triagens {
 
         Slot::TickType lastCommittedTick ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the tick of the last marker published by a writer. header,
+/// footer and blank markers are not included
+////////////////////////////////////////////////////////////////////////////////
+
+        Slot::TickType lastAssignedTick ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the next unused slot
 ////////////////////////////////////////////////////////////////////////////////
@@ -193,7 +200,8 @@ namespace triagens {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the current open region of a logfile
-/// this uses the slots lock
+/// this does not use the slots lock, the writers advance the region's end
+/// without it
 ////////////////////////////////////////////////////////////////////////////////
 
         void getActiveLogfileRegion (Logfile*,
@@ -202,17 +210,79 @@ namespace triagens {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the current tick range of a logfile
-/// this uses the slots lock
+/// this uses the slots lock, which returnSyncRegion holds when it updates
+/// the tick range
 ////////////////////////////////////////////////////////////////////////////////
 
         void getActiveTickRange (Logfile*,
                                  TRI_voc_tick_t&,
                                  TRI_voc_tick_t&);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief result of a reservation attempt
+////////////////////////////////////////////////////////////////////////////////
+
+        enum class ReservationType {
+          RESERVED,     // got a slot and space in the current logfile
+          MUST_SWITCH,  // first reservation that did not fit. caller switches
+          MUST_WAIT     // did not fit. caller waits for the switch
+        };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
 
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next unused slot, optionally handling legends
+////////////////////////////////////////////////////////////////////////////////
+
+        SlotInfo allocate (uint32_t,
+                           TRI_voc_cid_t,
+                           TRI_shape_sid_t,
+                           uint32_t,
+                           void**);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reserve a slot sequence number and space in the current logfile
+////////////////////////////////////////////////////////////////////////////////
+
+        ReservationType reserve (uint64_t,
+                                 uint64_t&,
+                                 uint64_t&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief publish a reserved slot in the current logfile
+////////////////////////////////////////////////////////////////////////////////
+
+        SlotInfo publish (uint64_t,
+                          uint32_t,
+                          TRI_voc_cid_t,
+                          TRI_shape_sid_t,
+                          uint32_t,
+                          void**);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief switch to a logfile that can hold a marker of the specified size
+////////////////////////////////////////////////////////////////////////////////
+
+        int switchLogfile (uint64_t&,
+                           uint32_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief open a new reservation window in the current logfile
+////////////////////////////////////////////////////////////////////////////////
+
+        void openWindow (uint64_t,
+                         uint32_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief close a logfile
 ////////////////////////////////////////////////////////////////////////////////
@@ -233,10 +303,40 @@ namespace triagens {
         int writeFooter (Slot*);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief handout a region and advance the handout index
+/// @brief write a blank marker into a slot that cannot be used otherwise
 ////////////////////////////////////////////////////////////////////////////////
 
-        Slot::TickType handout ();
+        void writeBlank (Slot*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until all slots with lower sequence numbers were published
+////////////////////////////////////////////////////////////////////////////////
+
+        void waitForTurn (uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief let the writer with the specified sequence number publish its slot
+////////////////////////////////////////////////////////////////////////////////
+
+        void passTurn (uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until the slot for a sequence number has been recycled
+////////////////////////////////////////////////////////////////////////////////
+
+        Slot* waitForSlot (uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait while all slots are in use
+////////////////////////////////////////////////////////////////////////////////
+
+        bool waitWhileFull (bool&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until the logfile switch of a generation has finished
+////////////////////////////////////////////////////////////////////////////////
+
+        void waitForSwitch (uint64_t);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief wait until all data has been synced up to a certain marker
@@ -270,7 +370,8 @@ namespace triagens {
         basics::ConditionVariable _condition;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief mutex protecting the slots interface
+/// @brief mutex protecting the synchronisation state and the statistics.
+/// writers do not acquire it
 ////////////////////////////////////////////////////////////////////////////////
 
         basics::Mutex _lock;
@@ -288,28 +389,56 @@ namespace triagens {
         size_t const _numberOfSlots;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief the number of currently free slots
+/// @brief the current reservation window
+///
+/// the upper bits contain the number of slots, the lower bits the number of
+/// bytes handed out since the window was opened. the byte counter starts at
+/// a value that makes every reservation ending after the window end invalid
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _freeSlots;
+        std::atomic<uint64_t> _reservation;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief whether or not someone is waiting for a slot
+/// @brief sequence number of the first slot in the current window
 ////////////////////////////////////////////////////////////////////////////////
 
-        uint32_t _waiting;
+        uint64_t _windowStart;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief the index of the slot to hand out next
+/// @brief sequence number of the slot to publish next
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _handoutIndex;
+        std::atomic<uint64_t> _handoutTurn;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief the index of the slot to recycle
+/// @brief condition variable for writers sleeping until it is their turn
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _recycleIndex;
+        basics::ConditionVariable _turnCondition;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of writers sleeping on _turnCondition
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint32_t> _turnWaiters;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sequence number of the slot to recycle next
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _recycled;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of reservation windows opened so far
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _generation;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not someone is waiting for a slot
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t _waiting;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the current logfile to write into
@@ -318,16 +447,16 @@ namespace triagens {
         Logfile* _logfile;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief last assigned tick value
+/// @brief last committed tick value
 ////////////////////////////////////////////////////////////////////////////////
 
-        Slot::TickType _lastAssignedTick;
+        std::atomic<Slot::TickType> _lastCommittedTick;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief last committed tick value
+/// @brief tick of the last marker published by a writer
 ////////////////////////////////////////////////////////////////////////////////
 
-        Slot::TickType _lastCommittedTick;
+        std::atomic<Slot::TickType> _lastAssignedTick;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief last committed data tick value
@@ -339,8 +468,7 @@ namespace triagens {
 /// @brief number of log events handled
 ////////////////////////////////////////////////////////////////////////////////
 
-        uint64_t _numEvents;
-
+        std::atomic<uint64_t> _numEvents;
     };
 
   }
@@ -47,6 +47,7 @@ namespace triagens {
           firstSlotIndex(0),
           lastSlotIndex(0),
           waitForSync(false),
+          waitForSyncCount(0),
           checkMore(false),
           canSeal(false) {
       }
@@ -62,6 +63,7 @@ namespace triagens {
       size_t               firstSlotIndex;
       size_t               lastSlotIndex;
       bool                 waitForSync;
+      uint32_t             waitForSyncCount;
       bool                 checkMore;
       bool                 canSeal;
     };
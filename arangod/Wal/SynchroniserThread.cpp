@@ -32,6 +32,7 @@
 #include "Basics/logging.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/Exceptions.h"
+#include "Basics/system-functions.h"
 #include "VocBase/server.h"
 #include "Wal/LogfileManager.h"
 #include "Wal/Slots.h"
@@ -57,6 +58,10 @@ SynchroniserThread::SynchroniserThread (LogfileManager* logfileManager,
     _logfileManager(logfileManager),
     _condition(),
     _waiting(0),
+    _waitingWithSync(0),
+    _numSyncs(0),
+    _numSyncedCommits(0),
+    _recentCommitsPerSync(1.0),
     _stop(0),
     _syncInterval(syncInterval),
     _logfileCache() {
@@ -96,12 +101,29 @@ void SynchroniserThread::stop () {
 /// @brief signal that we need a sync
 ////////////////////////////////////////////////////////////////////////////////
 
-void SynchroniserThread::signalSync () {
+void SynchroniserThread::signalSync (bool waitForSync) {
   CONDITION_LOCKER(guard, _condition);
   ++_waiting;
+
+  if (waitForSync) {
+    ++_waitingWithSync;
+  }
+
   _condition.signal();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the statistics for synchronous commits
+////////////////////////////////////////////////////////////////////////////////
+
+void SynchroniserThread::statistics (uint64_t& syncs,
+                                     uint64_t& commits,
+                                     double& recentCommitsPerSync) {
+  syncs                = _numSyncs.load();
+  commits              = _numSyncedCommits.load();
+  recentCommitsPerSync = _recentCommitsPerSync.load();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    Thread methods
 // -----------------------------------------------------------------------------
@@ -119,6 +141,30 @@ void SynchroniserThread::run () {
 
     {
       CONDITION_LOCKER(guard, _condition);
+
+      if (_waitingWithSync > 0 && stop == 0) {
+        uint64_t const maxDelay = _logfileManager->groupCommitDelay();
+        uint32_t const target   = groupCommitTarget();
+
+        if (maxDelay > 0 && _waitingWithSync < target) {
+          // group commit: give concurrent synchronous commits the chance to
+          // join this sync, but do not wait longer than configured
+          double const end = TRI_microtime() + static_cast<double>(maxDelay) / 1000000.0;
+
+          while (_waitingWithSync < target && _stop == 0) {
+            double const now = TRI_microtime();
+
+            if (now >= end) {
+              break;
+            }
+
+            guard.wait(static_cast<uint64_t>((end - now) * 1000000.0) + 1);
+          }
+        }
+
+        _waitingWithSync = 0;
+      }
+
       waiting = _waiting;
     }
 
@@ -216,6 +262,14 @@ int SynchroniserThread::doSync (bool& checkMore) {
 
   // all ok
 
+  if (region.waitForSyncCount > 0) {
+    uint64_t const commits = region.waitForSyncCount;
+
+    ++_numSyncs;
+    _numSyncedCommits += commits;
+    _recentCommitsPerSync.store(_recentCommitsPerSync.load() * 0.8 + static_cast<double>(commits) * 0.2);
+  }
+
   if (status == Logfile::StatusType::SEAL_REQUESTED) {
     // we might not yet be able to seal the logfile yet, for example in
     // the following situation when multi-threading:
@@ -251,6 +305,26 @@ int SynchroniserThread::doSync (bool& checkMore) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of synchronous commits a group commit waits for
+///
+/// this is the number of synchronous commits recent syncs covered on average.
+/// as long as syncs only cover single commits, there is no concurrency to
+/// exploit and waiting would only add latency. commits arriving while a sync
+/// is in progress are covered by the next sync anyway, so the average grows
+/// with the number of concurrent synchronous writers
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t SynchroniserThread::groupCommitTarget () const {
+  double const average = _recentCommitsPerSync.load();
+
+  if (average < 1.5) {
+    return 0;
+  }
+
+  return static_cast<uint32_t>(average + 0.5);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a logfile descriptor (it caches the descriptor for performance)
 ////////////////////////////////////////////////////////////////////////////////
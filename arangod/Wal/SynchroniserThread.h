@@ -90,7 +90,15 @@ namespace triagens {
 /// @brief signal that a sync is needed
 ////////////////////////////////////////////////////////////////////////////////
 
-        void signalSync ();
+        void signalSync (bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the statistics for synchronous commits
+////////////////////////////////////////////////////////////////////////////////
+
+        void statistics (uint64_t&,
+                         uint64_t&,
+                         double&);
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    Thread methods
@@ -116,6 +124,12 @@ namespace triagens {
 
         int doSync (bool&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of synchronous commits a group commit waits for
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t groupCommitTarget () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a logfile descriptor (it caches the descriptor for performance)
 ////////////////////////////////////////////////////////////////////////////////
@@ -146,6 +160,30 @@ namespace triagens {
 
         uint32_t _waiting;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of synchronous commits waiting
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t _waitingWithSync;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of syncs that included synchronous commits
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _numSyncs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of synchronous commits synced
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _numSyncedCommits;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief moving average of the synchronous commits per sync
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<double> _recentCommitsPerSync;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief stop flag
 ////////////////////////////////////////////////////////////////////////////////
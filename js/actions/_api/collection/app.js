@@ -70,6 +70,7 @@ function collectionRepresentation (collection, showProperties, showCount, showFi
     result.keyOptions    = properties.keyOptions;
     result.waitForSync   = properties.waitForSync;
     result.indexBuckets  = properties.indexBuckets;
+    result.compressDatafiles = properties.compressDatafiles;
 
     if (cluster.isCoordinator()) {
       result.shardKeys = properties.shardKeys;
@@ -141,6 +142,10 @@ function parseBodyForCreateCollection (req, res) {
     r.parameter.indexBuckets = body.indexBuckets;
   }
 
+  if (body.hasOwnProperty("compressDatafiles")) {
+    r.parameter.compressDatafiles = body.compressDatafiles;
+  }
+
   if (body.hasOwnProperty("keyOptions")) {
     r.parameter.keyOptions = body.keyOptions;
   }
@@ -190,6 +195,10 @@ function parseBodyForCreateCollection (req, res) {
 /// - *doCompact* (optional, default is *true*): whether or not the collection
 ///   will be compacted.
 ///
+/// - *compressDatafiles* (optional, default is *false*): whether or not the
+///   datafiles of the collection are stored compressed while the collection
+///   is unloaded.
+///
 /// - *journalSize* (optional, default is a configuration parameter): The 
 ///   maximal size of a journal or datafile in bytes. The value 
 ///   must be at least `1048576` (1 MiB).
@@ -478,6 +487,9 @@ function get_api_collections (req, res) {
 ///
 /// - *doCompact*: Whether or not the collection will be compacted.
 ///
+/// - *compressDatafiles*: Whether or not the datafiles of the collection
+///   are stored compressed while the collection is unloaded.
+///
 /// - *journalSize*: The maximal size setting for journals / datafiles
 ///   in bytes.
 ///
@@ -1227,6 +1239,10 @@ function put_api_collection_truncate (req, res, collection) {
 ///   additional journals or datafiles that are created. Already
 ///   existing journals or datafiles will not be affected.
 ///
+/// - *compressDatafiles*: If *true* then the datafiles of the collection
+///   are compressed when the collection is unloaded, and uncompressed again
+///   when it is loaded.
+///
 /// On success an object with the following attributes is returned:
 ///
 /// - *id*: The identifier of the collection.
@@ -335,7 +335,8 @@ ArangoCollection.prototype.properties = function (properties) {
     "shardKeys": false,
     "numberOfShards": false,
     "keyOptions": false,
-    "indexBuckets": true
+    "indexBuckets": true,
+    "compressDatafiles": true
   };
   var a;
 
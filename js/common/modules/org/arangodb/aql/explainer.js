@@ -479,9 +479,28 @@ function processQuery (query, explain) {
         return keyword("EMPTY") + "   " + annotation("/* empty result set */");
       case "EnumerateCollectionNode":
         collectionVariables[node.outVariable.id] = node.collection;
-        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* full collection scan" + (node.random ? ", random order" : "") + " */");
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* full collection scan" + (node.random ? ", random order" : "") + (node.projection ? ", projection: " + node.projection.join(", ") : "") + " */");
       case "EnumerateListNode":
         return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + variableName(node.inVariable) + "   " + annotation("/* list iteration */");
+      case "HashJoinNode":
+        collectionVariables[node.outVariable.id] = node.collection;
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + " " + keyword("FILTER") + " " + variableName(node.outVariable) + "." + node.attribute.join(".") + " == " + variableName(node.inVariable) + "   " + annotation("/* hash join */");
+      case "TraversalNode":
+        var directions = [ "ANY", "INBOUND", "OUTBOUND" ];
+        var traversalOptions = node.traversalOptions;
+        var depth = (traversalOptions.minDepth === traversalOptions.maxDepth ? String(traversalOptions.minDepth) : traversalOptions.minDepth + ".." + traversalOptions.maxDepth);
+        var traversalVariables = [ variableName(node.vertexOutVariable) ];
+        if (node.hasOwnProperty("edgeOutVariable")) {
+          traversalVariables.push(variableName(node.edgeOutVariable));
+        }
+        if (node.hasOwnProperty("pathOutVariable")) {
+          traversalVariables.push(variableName(node.pathOutVariable));
+        }
+        var pruned = "";
+        if (node.hasOwnProperty("pathConditions")) {
+          pruned = ", " + node.pathConditions.length + " path condition(s)";
+        }
+        return keyword("FOR") + " " + traversalVariables.join(", ") + " " + keyword("IN") + " " + value(depth) + " " + keyword(directions[node.direction]) + " " + variableName(node.inVariable) + " " + collection(node.edgeCollection) + "   " + annotation("/* traversal" + pruned + " */");
       case "IndexRangeNode":
         collectionVariables[node.outVariable.id] = node.collection;
         var index = node.index;
@@ -489,7 +508,7 @@ function processQuery (query, explain) {
         index.collection = node.collection;
         index.node = node.id;
         indexes.push(index);
-        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* " + (node.reverse ? "reverse " : "") + node.index.type + " index scan */");
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* " + (node.reverse ? "reverse " : "") + node.index.type + " index scan" + (node.covering ? ", covering" : "") + (node.projection ? ", projection: " + node.projection.join(", ") : "") + " */");
       case "CalculationNode":
         return keyword("LET") + " " + variableName(node.outVariable) + " = " + buildExpression(node.expression) + "   " + annotation("/* " + node.expressionType + " expression */");
       case "FilterNode":
@@ -498,6 +517,9 @@ function processQuery (query, explain) {
         return keyword("COLLECT") + " " + node.aggregates.map(function(node) {
           return variableName(node.outVariable) + " = " + variableName(node.inVariable);
         }).join(", ") + 
+                 (node.aggregateFunctions ? " " + keyword("AGGREGATE") + " " + node.aggregateFunctions.map(function(node) {
+                   return variableName(node.outVariable) + " = " + func(node.type) + "(" + (node.inVariable ? variableName(node.inVariable) : "") + ")";
+                 }).join(", ") : "") +
                  (node.count ? " " + keyword("WITH COUNT") : "") + 
                  (node.outVariable ? " " + keyword("INTO") + " " + variableName(node.outVariable) : "") +
                  (node.keepVariables ? " " + keyword("KEEP") + " " + node.keepVariables.map(function(variable) { return variableName(variable); }).join(", ") : "") + 
@@ -505,13 +527,14 @@ function processQuery (query, explain) {
       case "SortNode":
         return keyword("SORT") + " " + node.elements.map(function(node) {
           return variableName(node.inVariable) + " " + keyword(node.ascending ? "ASC" : "DESC"); 
-        }).join(", ");
+        }).join(", ") +
+                 (node.limit ? "   " + annotation("/* top " + node.limit + " */") : "");
       case "LimitNode":
         return keyword("LIMIT") + " " + value(JSON.stringify(node.offset)) + ", " + value(JSON.stringify(node.limit)); 
       case "ReturnNode":
         return keyword("RETURN") + " " + variableName(node.inVariable);
       case "SubqueryNode":
-        return keyword("LET") + " " + variableName(node.outVariable) + " = ...   " + annotation("/* subquery */");
+        return keyword("LET") + " " + variableName(node.outVariable) + " = ...   " + annotation("/* " + (node.isConst ? "const " : "") + "subquery */");
       case "InsertNode":
         modificationFlags = node.modificationFlags;
         return keyword("INSERT") + " " + variableName(node.inVariable) + " " + keyword("IN") + " " + collection(node.collection);
@@ -562,7 +585,9 @@ function processQuery (query, explain) {
   var postHandle = function (node) {
     if ([ "EnumerateCollectionNode",
           "EnumerateListNode",
+          "HashJoinNode",
           "IndexRangeNode",
+          "TraversalNode",
           "SubqueryNode" ].indexOf(node.type) !== -1) {
       level++;
     }
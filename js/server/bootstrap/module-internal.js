@@ -122,6 +122,10 @@ exports.wal = {
 
   properties: function () {
     return global.WAL_PROPERTIES.apply(null, arguments);
+  },
+
+  statistics: function () {
+    return global.WAL_STATISTICS.apply(null, arguments);
   }
 };
 
@@ -442,6 +442,9 @@ function getQueryMultiplePlansAndExecutions (query, bindVars, testObject, debug)
     delete results[i].stats.scannedFull;
     delete results[i].stats.scannedIndex;
     delete results[i].stats.filtered;
+    delete results[i].stats.peakMemoryUsage;
+    delete results[i].stats.spilledRuns;
+    delete results[i].stats.spilledBytes;
 
     if (debug) {
       require("internal").print("\n" + i + " DONE\n");
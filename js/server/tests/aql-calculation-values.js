@@ -0,0 +1,152 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for the values created by AQL calculations
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlCalculationValuesTestSuite () {
+  var cn = "UnitTestsAhuacatlCalculationValues";
+  var en = "UnitTestsAhuacatlCalculationEdges";
+  var c, e;
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      db._drop(en);
+      c = db._create(cn);
+      e = db._createEdgeCollection(en);
+
+      AQL_EXECUTE("FOR i IN 0..1999 INSERT { _key: CONCAT('test', i), value: i, name: CONCAT('name', i), sub: { value: i } } IN " + cn);
+      c.ensureSkiplist("value");
+
+      for (var i = 0; i < 100; ++i) {
+        e.save(cn + "/test" + i, cn + "/test" + (i + 1), { value: i });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(en);
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test extracting system attributes
+////////////////////////////////////////////////////////////////////////////////
+
+    testSystemAttributes : function () {
+      var actual = AQL_EXECUTE("FOR doc IN " + en + " SORT doc.value RETURN [ doc._key, doc._id, doc._rev, doc._from, doc._to, doc.missing ]").json;
+
+      assertEqual(100, actual.length);
+      actual.forEach(function (row, i) {
+        var doc = e.document(row[0]);
+        assertEqual(doc._key, row[0]);
+        assertEqual(doc._id, row[1]);
+        assertEqual(doc._rev, row[2]);
+        assertEqual(cn + "/test" + i, row[3]);
+        assertEqual(cn + "/test" + (i + 1), row[4]);
+        assertEqual(null, row[5]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that calculated values stay intact while other values of the
+/// query are created and destroyed
+////////////////////////////////////////////////////////////////////////////////
+
+    testValuesKeptWhileOthersAreDestroyed : function () {
+      var query = "FOR doc IN " + cn + " LET a = doc.value LET b = doc.value * 2 LET s = doc.sub.value LET t = doc.value >= 1000 LET n = doc.missing SORT a DESC RETURN [ a, b, s, t, n, doc.name ]";
+      var actual = AQL_EXECUTE(query).json;
+
+      assertEqual(2000, actual.length);
+      actual.forEach(function (row, i) {
+        var value = 1999 - i;
+        assertEqual([ value, value * 2, value, value >= 1000, null, "name" + value ], row);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test attribute access on calculated objects
+////////////////////////////////////////////////////////////////////////////////
+
+    testCalculatedObjects : function () {
+      var query = "FOR i IN 1..1000 LET o = { a: { b: i, s: CONCAT('x', i) }, l: [ i, i + 1 ] } COLLECT b = o.a.b, s = o.a.s, l = o.l[1], m = o.a.missing RETURN [ b, s, l, m ]";
+      var actual = AQL_EXECUTE(query).json;
+
+      assertEqual(1000, actual.length);
+      actual.forEach(function (row, i) {
+        assertEqual([ i + 1, "x" + (i + 1), i + 2, null ], row);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test calculated values used as index bounds
+////////////////////////////////////////////////////////////////////////////////
+
+    testCalculatedIndexBounds : function () {
+      var query = "FOR i IN 0..19 LET lo = i * 100 LET hi = lo + 2 FOR doc IN " + cn + " FILTER doc.value >= lo && doc.value < hi SORT doc.value RETURN doc.value";
+      var actual = AQL_EXECUTE(query).json;
+      var expected = [ ];
+
+      for (var i = 0; i < 20; ++i) {
+        expected.push(i * 100);
+        expected.push(i * 100 + 1);
+      }
+      assertEqual(expected, actual);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(ahuacatlCalculationValuesTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
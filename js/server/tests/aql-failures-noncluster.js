@@ -510,6 +510,125 @@ function ahuacatlFailureSuite () {
 
   };
 }
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               binary block format
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the binary transfer format of AQL item blocks. the
+/// failure point passes every block through the format, as a RemoteBlock
+/// would do in a cluster
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlBinaryBlockFormatSuite () {
+  'use strict';
+  var cn = "UnitTestsAhuacatlBinaryBlockFormat";
+  var c;
+
+  var assertRoundTrip = function (query) {
+    var expected = AQL_EXECUTE(query).json;
+
+    internal.debugSetFailAt("BinaryBlockFormat::roundTrip");
+    var actual = AQL_EXECUTE(query).json;
+    internal.debugClearFailAt();
+
+    assertEqual(expected, actual);
+  };
+        
+  var assertInvalidBlock = function (query) {
+    try {
+      AQL_EXECUTE(query);
+      fail();
+    }
+    catch (err) {
+      assertEqual(internal.errors.ERROR_CLUSTER_AQL_COMMUNICATION.code, err.errorNum);
+    }
+  };
+
+  return {
+
+    setUp: function () {
+      internal.debugClearFailAt();
+      db._drop(cn);
+      c = db._create(cn);
+      for (var i = 0; i < 2000; ++i) {
+        c.save({ value: i, text: "test" + i, values: [ i, { sub: i % 10 } ] });
+      }
+    },
+
+    tearDown: function () {
+      internal.debugClearFailAt();
+      db._drop(cn);
+      c = null;
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test empty values and runs of empty values
+////////////////////////////////////////////////////////////////////////////////
+
+    testRoundTripEmpty : function () {
+      assertRoundTrip("FOR i IN 1..2500 LET a = i * 2 LET b = a + 1 FILTER b % 3 != 0 RETURN b");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test shaped documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testRoundTripShaped : function () {
+      assertRoundTrip("FOR d IN " + cn + " SORT d.value RETURN d");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test ranges
+////////////////////////////////////////////////////////////////////////////////
+
+    testRoundTripRange : function () {
+      assertRoundTrip("FOR i IN 1..100 LET r = i..(i + 3) FOR j IN r RETURN [ i, j ]");
+      assertRoundTrip("FOR i IN 1..100 LET r = -i..i RETURN r");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test subquery results
+////////////////////////////////////////////////////////////////////////////////
+
+    testRoundTripDocvec : function () {
+      assertRoundTrip("FOR i IN 1..100 LET s = (FOR j IN 1..i RETURN j * 2) RETURN s");
+      assertRoundTrip("FOR i IN 1..10 LET s = (FOR d IN " + cn + " FILTER d.value < i RETURN d) RETURN s");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test JSON values, including values repeated within a block
+////////////////////////////////////////////////////////////////////////////////
+
+    testRoundTripJson : function () {
+      assertRoundTrip("FOR i IN 1..1500 LET x = { a: [ 1, 2.5, null, true, false ], b: \"foo\" } RETURN [ x, i, CONCAT('x', i) ]");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that truncated data is rejected
+////////////////////////////////////////////////////////////////////////////////
+
+    testTruncated : function () {
+      internal.debugSetFailAt("BinaryBlockFormat::roundTrip");
+      internal.debugSetFailAt("BinaryBlockFormat::truncated");
+      assertInvalidBlock("FOR d IN " + cn + " RETURN d");
+      assertInvalidBlock("FOR i IN 1..100 LET r = -i..i RETURN r");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that an invalid value tag is rejected
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalidTag : function () {
+      internal.debugSetFailAt("BinaryBlockFormat::roundTrip");
+      internal.debugSetFailAt("BinaryBlockFormat::invalidTag");
+      assertInvalidBlock("FOR d IN " + cn + " RETURN d");
+      assertInvalidBlock("FOR i IN 1..100 LET a = i * 2 RETURN a");
+    }
+
+  };
+}
  
 // -----------------------------------------------------------------------------
 // --SECTION--                                                              main
@@ -521,6 +640,7 @@ function ahuacatlFailureSuite () {
 
 if (internal.debugCanUseFailAt()) {
   jsunity.run(ahuacatlFailureSuite);
+  jsunity.run(ahuacatlBinaryBlockFormatSuite);
 }
 
 return jsunity.done();
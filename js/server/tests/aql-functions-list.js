@@ -598,6 +598,60 @@ function ahuacatlListTestSuite () {
       assertQueryError(errors.ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH.code, "RETURN REMOVE_NTH()"); 
       assertQueryError(errors.ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH.code, "RETURN REMOVE_NTH([ ])"); 
       assertQueryError(errors.ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH.code, "RETURN REMOVE_NTH([ ], 1, true)"); 
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test C++ implementations of list functions against the 
+/// JavaScript implementations
+////////////////////////////////////////////////////////////////////////////////
+
+    testListFunctionsCxx : function () {
+      var values = [ null, false, 1, "foo", { }, [ ], [ null ], [ 1 ], [ 3, 1, 2 ], 
+                     [ 1, 2, 3, 4 ], [ 1, null, 4, null, 9, 16 ], [ -5.5, 3, 1e6, 0, 2.25, -1 ],
+                     [ 1, "2", 3 ], [ [ 1, [ 2, [ 3, [ 4 ] ] ] ], 5, [ ] ], 
+                     [ "a", "b", "a" ], [ { a: 1 }, [ 2 ], "c" ] ];
+
+      var queries = [
+        "FIRST(@value)",
+        "LAST(@value)",
+        "NTH(@value, 0)",
+        "NTH(@value, 2)",
+        "NTH(@value, -1)",
+        "NTH(@value, 1.5)",
+        "SLICE(@value, 1)",
+        "SLICE(@value, 1, 2)",
+        "SLICE(@value, -2)",
+        "SLICE(@value, -3, 2)",
+        "SLICE(@value, 0, -1)",
+        "SLICE(@value, 1, null)",
+        "FLATTEN(@value)",
+        "FLATTEN(@value, 2)",
+        "FLATTEN(@value, 10)",
+        "MEDIAN(@value)",
+        "PERCENTILE(@value, 50)",
+        "PERCENTILE(@value, 1, 'interpolation')",
+        "PERCENTILE(@value, 75, 'interpolation')",
+        "PERCENTILE(@value, 100, 'rank')",
+        "PERCENTILE(@value, 0)",
+        "PERCENTILE(@value, 50, 'foo')",
+        "VARIANCE_SAMPLE(@value)",
+        "VARIANCE_POPULATION(@value)",
+        "STDDEV_SAMPLE(@value)",
+        "STDDEV_POPULATION(@value)",
+        "ZIP(@value, @value)",
+        "ZIP(@value, [ 1 ])",
+        "TRANSLATE(@value, { foo: 'bar', '1': 'one' })",
+        "TRANSLATE(@value, { foo: 'bar' }, null)",
+        "TRANSLATE('foo', @value, 'default')"
+      ];
+
+      queries.forEach(function (query) {
+        values.forEach(function (value) {
+          var expected = getQueryResults("RETURN V8(" + query + ")", { value: value });
+          var actual = getQueryResults("RETURN NOOPT(" + query + ")", { value: value });
+          assertEqual(expected, actual, query + ", value: " + JSON.stringify(value));
+        });
+      });
     }
 
   };
@@ -1199,6 +1199,103 @@ function ahuacatlStringFunctionsTestSuite () {
       assertEqual([ "888227c44807b86059eb36f9fe0fc602a9b16fab" ], getQueryResults("RETURN NOOPT(SHA1('[1,2,4,7,11,16,22,29,37,46,56,67,79,92,106,121,137,154,172,191,211,232,254,277,301,326,352,379,407,436,466,497,529,562,596,631,667,704,742,781,821,862,904,947,991,1036,1082,1129,1177,1226,1276,1327,1379,1432,1486,1541,1597,1654,1712,1771,1831,1892,1954,2017,2081,2146,2212,2279,2347,2416,2486,2557,2629,2702,2776,2851,2927,3004,3082,3161,3241,3322,3404,3487,3571,3656,3742,3829,3917,4006,4096,4187,4279,4372,4466,4561,4657,4754,4852,4951]'))"));
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test C++ implementations of string functions against the 
+/// JavaScript implementations
+////////////////////////////////////////////////////////////////////////////////
+
+    testStringFunctionsCxx : function () {
+      var values = [ null, false, true, 0, -1, 42.5, "", " ", "foo", "  foo bar  ", 
+                     "\t\r\nfoo\n", "FooBar", "aBcAbC", "アボカド名称について", "der Äpfel", 
+                     "a,b,,c", "foo%bar", "foo_bar", "foo\\bar", "line1\nline2", 
+                     [ ], [ 1, 2 ], { } ];
+
+      var queries = [
+        "CHAR_LENGTH(@value)",
+        "LOWER(@value)",
+        "UPPER(@value)",
+        "SUBSTRING(@value, 1)",
+        "SUBSTRING(@value, -3, 2)",
+        "SUBSTRING(@value, 2, -1)",
+        "SUBSTRING(@value, 'x', 'y')",
+        "LEFT(@value, 3)",
+        "LEFT(@value, -1)",
+        "RIGHT(@value, 3)",
+        "RIGHT(@value, 100)",
+        "CONTAINS(@value, 'a')",
+        "CONTAINS(@value, 'bar', true)",
+        "CONTAINS(@value, '', true)",
+        "CONTAINS(@value, '名称', true)",
+        "LIKE(@value, 'foo%')",
+        "LIKE(@value, '%bar')",
+        "LIKE(@value, '_oo%')",
+        "LIKE(@value, 'foo\\\\%bar')",
+        "LIKE(@value, 'foo\\\\_bar')",
+        "LIKE(@value, 'foo\\\\\\\\bar')",
+        "LIKE(@value, 'line%')",
+        "LIKE(@value, 'FOO%', true)",
+        "LIKE(@value, '%アボ%')",
+        "TRIM(@value)",
+        "TRIM(@value, 1)",
+        "TRIM(@value, 2)",
+        "TRIM(@value, 'fo ')",
+        "LTRIM(@value)",
+        "LTRIM(@value, 'f ')",
+        "RTRIM(@value)",
+        "RTRIM(@value, 'or ')",
+        "SPLIT(@value)",
+        "SPLIT(@value, '')",
+        "SPLIT(@value, ',')",
+        "SPLIT(@value, ',', 2)",
+        "SPLIT(@value, [ ',', ' ' ])",
+        "SPLIT(@value, [ 'o', '' ])",
+        "SPLIT(@value, 'o', 0)",
+        "CONCAT_SEPARATOR('-', @value, 'foo', null, [ 1, null, 2 ], [ ], 'bar')",
+        "CONCAT_SEPARATOR(@value, [ 'a', 'b' ], 'c')"
+      ];
+
+      queries.forEach(function (query) {
+        values.forEach(function (value) {
+          var expected = getQueryResults("RETURN V8(" + query + ")", { value: value });
+          var actual = getQueryResults("RETURN NOOPT(" + query + ")", { value: value });
+          assertEqual(expected, actual, query + ", value: " + JSON.stringify(value));
+        });
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test string functions with characters outside the BMP. positions
+/// are counted in UTF-16 code units, as in JavaScript
+////////////////////////////////////////////////////////////////////////////////
+
+    testStringFunctionsSurrogatePairs : function () {
+      var value = "a\ud83d\ude00b\ud83d\udc4dc";
+
+      var queries = [
+        [ "CHAR_LENGTH(@value)", 7 ],
+        [ "SUBSTRING(@value, 1, 2)", "\ud83d\ude00" ],
+        [ "SUBSTRING(@value, 3)", "b\ud83d\udc4dc" ],
+        [ "SUBSTRING(@value, -3, 2)", "\ud83d\udc4d" ],
+        [ "LEFT(@value, 3)", "a\ud83d\ude00" ],
+        [ "LEFT(@value, 4)", "a\ud83d\ude00b" ],
+        [ "RIGHT(@value, 1)", "c" ],
+        [ "RIGHT(@value, 3)", "\ud83d\udc4dc" ],
+        [ "CONTAINS(@value, 'b', true)", 3 ],
+        [ "CONTAINS(@value, 'c', true)", 6 ]
+      ];
+
+      queries.forEach(function (query) {
+        var expected = getQueryResults("RETURN V8(" + query[0] + ")", { value: value });
+        var actual = getQueryResults("RETURN NOOPT(" + query[0] + ")", { value: value });
+        assertEqual([ query[1] ], expected, query[0]);
+        assertEqual([ query[1] ], actual, query[0]);
+      });
+
+      // a split surrogate pair cannot be encoded in UTF-8
+      assertEqual([ "a\ufffd" ], getQueryResults("RETURN NOOPT(LEFT(@value, 2))", { value: value }));
+      assertEqual([ "\ufffdb" ], getQueryResults("RETURN NOOPT(SUBSTRING(@value, 2, 2))", { value: value }));
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test random_token function
 ////////////////////////////////////////////////////////////////////////////////
@@ -333,6 +333,72 @@ function gatherBlockTestSuite () {
       var actual = AQL_EXECUTE(query).json;
 
       assertEqual(expected, actual, query);
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief sorted gather over several batches per shard, so that the
+    /// RemoteBlocks read ahead while the GatherBlock merges
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testSortedGatherReadAhead : function () {
+      var query = "FOR d IN " + cn1 + " SORT d.Hallo DESC RETURN d.Hallo";
+      
+      // check the GatherNode is in the plan!
+      assertTrue(explain(AQL_EXPLAIN(query)).indexOf("GatherNode") !== -1, query);
+
+      var expected = [ ];
+      for (var k = 9; k >= 0; k--) {
+        for (var j = 0; j < 400; j++) {
+          expected.push(k);
+        }
+      }
+      
+      for (var i = 0; i < 3; ++i) {
+        var actual = AQL_EXECUTE(query).json;
+        assertEqual(expected, actual, query);
+      }
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief shutdown of the query while read-ahead requests are outstanding
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testShutdownWithPrefetch : function () {
+      var queries = [
+        "FOR d IN " + cn1 + " SORT d.Hallo LIMIT 5 RETURN d.Hallo",
+        "FOR d IN " + cn1 + " LIMIT 5 RETURN 0"
+      ];
+
+      queries.forEach(function (query) {
+        for (var i = 0; i < 20; ++i) {
+          var actual = AQL_EXECUTE(query).json;
+          assertEqual([ 0, 0, 0, 0, 0 ], actual, query);
+        }
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief initializeCursor while read-ahead requests are outstanding. the
+    /// subquery is stopped by its LIMIT and re-initialized for each outer row
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testInitializeCursorWithPrefetch : function () {
+      var queries = [
+        [ "FOR i IN 1..5 LET s = (FOR d IN " + cn1 + " SORT d.Hallo LIMIT 2 RETURN d.Hallo) RETURN s", 
+          [ 0, 0 ] ],
+        [ "FOR i IN 1..5 LET s = (FOR d IN " + cn1 + " SORT d.Hallo DESC LIMIT 1500, 2 RETURN d.Hallo) RETURN s", 
+          [ 6, 6 ] ],
+        [ "FOR i IN 1..5 LET s = (FOR d IN " + cn1 + " LIMIT 2 RETURN 1) RETURN s", 
+          [ 1, 1 ] ]
+      ];
+
+      queries.forEach(function (query) {
+        var actual = AQL_EXECUTE(query[0]).json;
+        assertEqual(5, actual.length, query[0]);
+        actual.forEach(function (value) {
+          assertEqual(query[1], value, query[0]);
+        });
+      });
     }
 
   };
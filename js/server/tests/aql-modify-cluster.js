@@ -41,6 +41,9 @@ var sanitizeStats = function (stats) {
   delete stats.scannedFull;
   delete stats.scannedIndex;
   delete stats.filtered;
+  delete stats.peakMemoryUsage;
+  delete stats.spilledRuns;
+  delete stats.spilledBytes;
   return stats;
 };
 
@@ -4109,6 +4109,157 @@ function optimizerIndexesSortTestSuite () {
   };
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for index lookups with variable bounds
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerIndexesJoinTestSuite () {
+  var c;
+  var e;
+
+  var getIndexNodes = function (query, bindVars) {
+    var plan = AQL_EXPLAIN(query, bindVars || { }).plan;
+    return plan.nodes.filter(function(node) {
+      return node.type === "IndexRangeNode";
+    });
+  };
+
+  return {
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      db._drop("UnitTestsEdgeCollection");
+      c = db._create("UnitTestsCollection");
+      e = db._createEdgeCollection("UnitTestsEdgeCollection");
+
+      var i;
+      for (i = 0; i < 50; ++i) {
+        c.save({ _key: "test" + i, value: i, group: i % 10 });
+      }
+      c.save({ _key: "nullgroup", value: -1, group: null });
+
+      c.ensureHashIndex("group");
+
+      for (i = 0; i < 10; ++i) {
+        for (var j = 0; j < i; ++j) {
+          e.save("UnitTestsCollection/test" + i, "UnitTestsCollection/test" + j, { value: i + "-" + j });
+        }
+      }
+    },
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+      db._drop("UnitTestsEdgeCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test hash index lookups with repeated lookup values
+////////////////////////////////////////////////////////////////////////////////
+
+    testHashIndexJoinDuplicateKeys : function () {
+      var query = "FOR i IN 0..2499 FOR doc IN " + c.name() + " FILTER doc.group == i % 10 RETURN [ i, doc.value ]";
+
+      var nodes = getIndexNodes(query);
+      assertEqual(1, nodes.length);
+      assertEqual("hash", nodes[0].index.type);
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(2500 * 5, results.json.length);
+
+      var counts = { };
+      results.json.forEach(function(pair) {
+        assertEqual(pair[0] % 10, pair[1] % 10);
+        counts[pair[0]] = (counts[pair[0]] || 0) + 1;
+      });
+
+      for (var i = 0; i < 2500; ++i) {
+        assertEqual(5, counts[i]);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test hash index lookups with values that do not match
+////////////////////////////////////////////////////////////////////////////////
+
+    testHashIndexJoinMissingKeys : function () {
+      var query = "FOR i IN @values FOR doc IN " + c.name() + " FILTER doc.group == i SORT doc.value RETURN [ i, doc.value ]";
+      var values = [ 1, "foo", 99, 2, 1, null, { }, 2 ];
+
+      assertEqual(1, getIndexNodes(query, { values: values }).length);
+
+      var results = AQL_EXECUTE(query, { values: values });
+      var expected = [ ];
+      values.forEach(function(v) {
+        if (v === null) {
+          expected.push([ null, -1 ]);
+        }
+        else if (typeof v === "number" && v < 10) {
+          for (var j = v; j < 50; j += 10) {
+            expected.push([ v, j ]);
+          }
+        }
+      });
+      expected.sort(function(l, r) {
+        return l[1] - r[1];
+      });
+
+      assertEqual(expected.length, results.json.length);
+      assertEqual(expected.map(function(pair) { return pair[1]; }),
+                  results.json.map(function(pair) { return pair[1]; }));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test hash index lookups with IN lists
+////////////////////////////////////////////////////////////////////////////////
+
+    testHashIndexJoinInList : function () {
+      var query = "FOR i IN [ 1, 2, 1, 3, 2 ] FOR doc IN " + c.name() + " FILTER doc.group IN [ i, i + 5 ] RETURN [ i, doc.value ]";
+
+      assertEqual(1, getIndexNodes(query).length);
+
+      var results = AQL_EXECUTE(query);
+      assertEqual(5 * 10, results.json.length);
+      results.json.forEach(function(pair) {
+        assertEqual(pair[0], pair[1] % 5);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test edge index lookups with repeated lookup values
+////////////////////////////////////////////////////////////////////////////////
+
+    testEdgeIndexJoinDuplicateKeys : function () {
+      var query = "FOR v IN @vertices FOR edge IN " + e.name() + " FILTER edge._from == v RETURN edge.value";
+      var vertices = [ ];
+      var expected = 0;
+
+      for (var i = 0; i < 1500; ++i) {
+        vertices.push("UnitTestsCollection/test" + (i % 12));
+        expected += (i % 12) < 10 ? (i % 12) : 0;
+      }
+
+      var nodes = getIndexNodes(query, { vertices: vertices });
+      assertEqual(1, nodes.length);
+      assertEqual("edge", nodes[0].index.type);
+
+      var results = AQL_EXECUTE(query, { vertices: vertices });
+      assertEqual(expected, results.json.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test edge index lookups with invalid lookup values
+////////////////////////////////////////////////////////////////////////////////
+
+    testEdgeIndexJoinInvalidKeys : function () {
+      var query = "FOR v IN @vertices FOR edge IN " + e.name() + " FILTER edge._to == v SORT edge.value RETURN edge.value";
+      var vertices = [ "UnitTestsCollection/test8", 1, "UnitTestsCollection/test8", "foo", null, "UnitTestsCollection/test7" ];
+
+      var results = AQL_EXECUTE(query, { vertices: vertices });
+      assertEqual([ "8-7", "9-7", "9-8", "9-8" ], results.json);
+    }
+
+  };
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief executes the test suites
 ////////////////////////////////////////////////////////////////////////////////
@@ -4118,6 +4269,7 @@ jsunity.run(optimizerEdgeIndexTestSuite);
 jsunity.run(optimizerIndexesInOrTestSuite);
 jsunity.run(optimizerIndexesRangesTestSuite);
 jsunity.run(optimizerIndexesSortTestSuite);
+jsunity.run(optimizerIndexesJoinTestSuite);
 
 return jsunity.done();
 
@@ -0,0 +1,170 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertTrue, assertFalse, assertEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2014 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author 
+/// @author Copyright 2014, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("org/arangodb").db;
+var jsunity = require("jsunity");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "reduce-extraction-to-projection";
+  // various choices to control the optimizer: 
+  var rulesNone        = { optimizer: { rules: [ "-all" ] } };
+  var thisRuleDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+
+  var cn = "UnitTestsAqlOptimizerRuleReduceExtractionToProjection";
+  var c;
+
+  var findScans = function (result) {
+    return result.plan.nodes.filter(function(node) {
+      return (node.type === "EnumerateCollectionNode" || node.type === "IndexRangeNode");
+    });
+  };
+
+  return {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief set up
+    ////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      var i;
+      db._drop(cn);
+      c = db._create(cn, { numberOfShards: 4 });
+      for (i = 0; i < 100; ++i) {
+        c.save({ _key: "test" + i, value: i, name: "name" + i, other: { a: i, b: "foo" + i } });
+      }
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief tear down
+    ////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that rule does not fire when all rules are disabled
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testRulesNone : function () {
+      var query = "FOR doc IN " + cn + " SORT doc.value RETURN doc.name";
+      var result = AQL_EXPLAIN(query, { }, rulesNone);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that rule does not fire when it is disabled
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testThisRuleDisabled : function () {
+      var query = "FOR doc IN " + cn + " SORT doc.value RETURN doc.name";
+      var result = AQL_EXPLAIN(query, { }, thisRuleDisabled);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      findScans(result).forEach(function(node) {
+        assertFalse(node.hasOwnProperty("projection"), query);
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that rule has no effect if the documents are used as a whole
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [ 
+        "FOR doc IN " + cn + " RETURN doc",
+        "FOR doc IN " + cn + " SORT doc.value RETURN [ doc.name, doc ]",
+        "FOR doc IN " + cn + " SORT doc.value RETURN doc['name']",
+        "FOR doc IN " + cn + " SORT doc.value RETURN ATTRIBUTES(doc)",
+        "FOR doc IN " + cn + " SORT doc RETURN doc.name",
+        // the attribute accesses are all moved to the DB servers
+        "FOR doc IN " + cn + " RETURN doc.name",
+        "FOR doc IN " + cn + " FILTER doc.value > 10 RETURN doc.name"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test that rule has an effect
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [ 
+        [ "FOR doc IN " + cn + " SORT doc.value RETURN doc.name", [ "name", "value" ] ],
+        [ "FOR doc IN " + cn + " SORT doc.value RETURN { key: doc._key, a: doc.other.a }", [ "_key", "other", "value" ] ],
+        [ "FOR doc IN " + cn + " FILTER doc.value > 10 SORT doc.value LIMIT 10 RETURN doc.name", [ "name", "value" ] ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0]);
+        assertTrue(result.plan.rules.indexOf(ruleName) !== -1, query[0]);
+
+        var scans = findScans(result);
+        assertEqual(1, scans.length, query[0]);
+        assertEqual(query[1], scans[0].projection, query[0]);
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief test results
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [ 
+        "FOR doc IN " + cn + " SORT doc.value RETURN doc.name",
+        "FOR doc IN " + cn + " SORT doc.value RETURN { key: doc._key, id: doc._id, a: doc.other.a, missing: doc.missing }",
+        "FOR doc IN " + cn + " FILTER doc.value >= 90 SORT doc.value DESC RETURN doc.other.b",
+        "FOR doc IN " + cn + " COLLECT v = doc.value % 10 INTO g RETURN { v: v, n: LENGTH(g) }"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, thisRuleDisabled).json;
+        var actual = AQL_EXECUTE(query).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
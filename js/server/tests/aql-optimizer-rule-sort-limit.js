@@ -0,0 +1,183 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+var db = require("org/arangodb").db;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "sort-limit";
+  // various choices to control the optimizer: 
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c;
+
+  var findSortNode = function (plan) {
+    var nodes = plan.nodes.filter(function(node) { return node.type === "SortNode"; });
+    assertEqual(1, nodes.length);
+    return nodes[0];
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 3000; ++i) {
+        c.save({ value: i, group: i % 13 });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [ 
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i",
+        "FOR i IN " + c.name() + " SORT i.value DESC LIMIT 5, 10 RETURN i"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [ 
+        "FOR i IN " + c.name() + " SORT i.value RETURN i", // no limit
+        "FOR i IN " + c.name() + " LIMIT 10 SORT i.value RETURN i", // limit before sort
+        "FOR i IN " + c.name() + " SORT i.value FILTER i.group == 1 LIMIT 10 RETURN i", // filter in between
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 0 RETURN i", // limit 0
+        "FOR i IN " + c.name() + " SORT i.value FOR j IN 1..2 LIMIT 10 RETURN i" // enumeration in between
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect if the limit needs a full count
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffectFullCount : function () {
+      var query = "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i";
+      var result = AQL_EXPLAIN(query, { }, { fullCount: true, optimizer: { rules: [ "-all", "+" + ruleName ] } });
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+
+      var actual = AQL_EXECUTE(query, { }, { fullCount: true });
+      assertEqual(10, actual.json.length);
+      assertEqual(3000, actual.stats.fullCount);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [ 
+        [ "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i", 10 ],
+        [ "FOR i IN " + c.name() + " SORT i.value DESC LIMIT 5, 10 RETURN i", 15 ],
+        [ "FOR i IN " + c.name() + " SORT i.group, i.value LIMIT 100, 1 RETURN i", 101 ],
+        [ "FOR i IN " + c.name() + " SORT i.value LET x = CONCAT('x', i.value) LIMIT 3 RETURN x", 3 ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+        assertEqual(query[1], findSortNode(result.plan).limit, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [ 
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.value DESC LIMIT 5, 10 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.group, i.value LIMIT 100, 1 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.group DESC, i.value LIMIT 1500 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.group, i.value DESC LIMIT 2990, 100 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 5000 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.value LET x = CONCAT('x', i.value) LIMIT 3 RETURN x",
+        "FOR i IN 1..10 LET x = (FOR j IN " + c.name() + " SORT j.value DESC LIMIT 7 RETURN j.value) RETURN x",
+        "FOR i IN 1..5000 SORT i % 13, i DESC LIMIT 2500, 10 RETURN i"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramDisabled).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
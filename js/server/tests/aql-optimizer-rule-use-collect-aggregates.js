@@ -0,0 +1,194 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+var isEqual = helper.isEqual;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-collect-aggregates";
+  // various choices to control the optimizer: 
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [ 
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN SUM(g[*].i)",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN LENGTH(g)"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], result.plan.rules);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [ 
+        "FOR i IN 1..10 COLLECT a = i % 2 RETURN a",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN g",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN { a: a, s: SUM(g[*].i), g: g }",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN SUM(g[* FILTER CURRENT.i > 2].i)",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN SUM(g[* LIMIT 2].i)",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN SUM(g[*].j)",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN SUM(g[*])",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN LENGTH(UNIQUE(g))",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN FIRST(g[*].i)",
+        "FOR i IN 1..10 LET j = i * 2 COLLECT a = i % 2 INTO g KEEP j RETURN SUM(g[*].i)"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertTrue(result.plan.rules.indexOf(ruleName) === -1, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [ 
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN SUM(g[*].i)",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN LENGTH(g)",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN LENGTH(g[*].i)",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN LENGTH(UNIQUE(g[*].i))",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN { a: a, min: MIN(g[*].i), max: MAX(g[*].i), avg: AVERAGE(g[*].i) }",
+        "FOR i IN 1..10 LET j = i * 2 COLLECT a = i % 2 INTO g KEEP j RETURN SUM(g[*].j)",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g = i * 2 RETURN SUM(g[*])",
+        "FOR i IN 1..10 COLLECT a = i % 2 INTO g = { value: i } RETURN SUM(g[*].value)"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test generated plans
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlans : function () {
+      var query = "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN { a: a, s: SUM(g[*].i), l: LENGTH(g) }";
+      var result = AQL_EXPLAIN(query, { }, paramEnabled);
+      assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+
+      var nodes = helper.getCompactPlan(result).map(function(node) { return node.type; });
+      assertEqual([ "SingletonNode", "CalculationNode", "EnumerateListNode", "CalculationNode", "CalculationNode", "SortNode", "AggregateNode", "CalculationNode", "ReturnNode" ], nodes, query);
+
+      var collectNode = result.plan.nodes.filter(function(node) { return node.type === "AggregateNode"; })[0];
+      assertTrue(collectNode.outVariable === undefined, query);
+      assertEqual([ "LENGTH", "SUM" ], collectNode.aggregateFunctions.map(function(f) { return f.type; }).sort());
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [ 
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN SUM(g[*].i)", [ 30, 25 ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN LENGTH(g)", [ 5, 5 ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN LENGTH(g[*].i)", [ 5, 5 ] ],
+        [ "FOR i IN 1..10 LET m = i % 3 COLLECT a = i % 2 INTO g RETURN LENGTH(UNIQUE(g[*].m))", [ 3, 3 ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g FILTER LENGTH(g) > 1 RETURN a", [ 0, 1 ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN [ MIN(g[*].i), MAX(g[*].i) ]", [ [ 2, 10 ], [ 1, 9 ] ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g RETURN AVERAGE(g[*].i)", [ 6, 5 ] ],
+        [ "FOR i IN [ 1, null, 3, 'foo' ] COLLECT a = 1 INTO g RETURN [ MIN(g[*].i), MAX(g[*].i) ]", [ [ 1, 'foo' ] ] ],
+        [ "FOR i IN [ 1, null, 3 ] COLLECT a = 1 INTO g RETURN [ SUM(g[*].i), AVERAGE(g[*].i), LENGTH(g) ]", [ [ 4, 2, 3 ] ] ],
+        [ "FOR i IN [ null, null ] COLLECT a = 1 INTO g RETURN [ SUM(g[*].i), AVERAGE(g[*].i), MIN(g[*].i) ]", [ [ 0, null, null ] ] ],
+        [ "FOR i IN 1..10 LET j = i * 2 COLLECT a = i % 2 INTO g KEEP j RETURN SUM(g[*].j)", [ 60, 50 ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g = i * 2 RETURN SUM(g[*])", [ 60, 50 ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g = { value: i } RETURN { a: a, s: SUM(g[*].value), l: LENGTH(g) }", [ { a: 0, s: 30, l: 5 }, { a: 1, s: 25, l: 5 } ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g OPTIONS { method: 'hash' } SORT a RETURN SUM(g[*].i)", [ 30, 25 ] ],
+        [ "FOR i IN 1..10 COLLECT a = i % 2 INTO g OPTIONS { method: 'sorted' } RETURN SUM(g[*].i)", [ 30, 25 ] ]
+      ];
+
+      queries.forEach(function(query) {
+        var planDisabled   = AQL_EXPLAIN(query[0], { }, paramDisabled);
+        var planEnabled    = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        var resultDisabled = AQL_EXECUTE(query[0], { }, paramDisabled).json;
+        var resultEnabled  = AQL_EXECUTE(query[0], { }, paramEnabled).json;
+
+        assertTrue(isEqual(resultDisabled, resultEnabled), query[0]);
+
+        assertEqual(-1, planDisabled.plan.rules.indexOf(ruleName), query[0]);
+        assertNotEqual(-1, planEnabled.plan.rules.indexOf(ruleName), query[0]);
+
+        assertEqual(resultDisabled, query[1], query[0]);
+        assertEqual(resultEnabled, query[1], query[0]);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
@@ -0,0 +1,174 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, assertTrue, assertFalse, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-covering-index";
+  // various choices to control the optimizer: 
+  var rulesNone        = { optimizer: { rules: [ "-all" ] } };
+  var thisRuleDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var cn = "UnitTestsAqlOptimizerRuleUseCoveringIndex";
+  var c;
+
+  var findIndexNode = function (plan) {
+    var nodes = plan.nodes.filter(function(node) { return node.type === "IndexRangeNode"; });
+    assertEqual(1, nodes.length);
+    return nodes[0];
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn, { numberOfShards: 4 });
+
+      for (var i = 0; i < 1000; ++i) {
+        var doc = { _key: "test" + i, value: i, group: i % 13, name: "this is a long name " + i, other: i };
+        if (i % 7 === 0) {
+          delete doc.name;
+        }
+        c.save(doc);
+      }
+
+      c.ensureSkiplist("value", "name");
+      c.ensureHashIndex("group");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var query = "FOR i IN " + cn + " FILTER i.value > 10 SORT i.value LIMIT 10 RETURN i.name";
+
+      var result = AQL_EXPLAIN(query, { }, rulesNone);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      
+      result = AQL_EXPLAIN(query, { }, thisRuleDisabled);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      assertFalse(findIndexNode(result.plan).hasOwnProperty("covering"), query);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [ 
+        "FOR i IN " + cn + " FILTER i.value > 10 SORT i.value LIMIT 10 RETURN i", // whole document
+        "FOR i IN " + cn + " FILTER i.value > 10 SORT i.value LIMIT 10 RETURN i.other", // not indexed
+        "FOR i IN " + cn + " FILTER i.value > 10 SORT i.value LIMIT 10 RETURN [ i.value, i.other ]", // not indexed
+        "FOR i IN " + cn + " FILTER i.value > 10 SORT i.value LIMIT 10 RETURN i._id", // _id not covered
+        "FOR i IN " + cn + " FILTER i.group == 3 SORT i.group LIMIT 10 RETURN i.value", // different index
+        // the attribute accesses are all moved to the DB servers
+        "FOR i IN " + cn + " FILTER i.value > 10 RETURN i.value",
+        "FOR i IN " + cn + " FILTER i.group == 3 RETURN i._key"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [ 
+        [ "FOR i IN " + cn + " FILTER i.value > 10 SORT i.value LIMIT 10 RETURN i.name", [ "name", "value" ] ],
+        [ "FOR i IN " + cn + " FILTER i.value > 10 SORT i.value LIMIT 10 RETURN { key: i._key, name: i.name }", [ "_key", "name", "value" ] ],
+        [ "FOR i IN " + cn + " FILTER i.group == 3 SORT i._key LIMIT 10 RETURN [ i._rev, i.group ]", [ "_key", "_rev", "group" ] ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0]);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+        var node = findIndexNode(result.plan);
+        assertTrue(node.covering, query[0]);
+        assertEqual(query[1], node.projection, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [ 
+        "FOR i IN " + cn + " FILTER i.value > 10 SORT i.value LIMIT 100 RETURN i.name",
+        "FOR i IN " + cn + " FILTER i.value > 990 SORT i.value LIMIT 5 RETURN { key: i._key, name: i.name, value: i.value }",
+        "FOR i IN " + cn + " FILTER i.value < 30 || i.value > 970 SORT i._key LIMIT 50 RETURN [ i._key, i.name ]",
+        "FOR i IN " + cn + " FILTER i.group == 3 SORT i._key LIMIT 20 RETURN [ i._key, i.group ]",
+        "FOR i IN " + cn + " FILTER i.group IN [ 1, 2 ] SORT i._key LIMIT 20 RETURN i.group",
+        "FOR i IN " + cn + " FILTER i.value >= 500 SORT i.value LIMIT 10 RETURN i._rev == DOCUMENT(CONCAT('" + cn + "/', i._key))._rev"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, thisRuleDisabled).json;
+        var actual = AQL_EXECUTE(query).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
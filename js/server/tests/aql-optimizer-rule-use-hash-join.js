@@ -0,0 +1,214 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+var db = require("org/arangodb").db;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-hash-join";
+  // various choices to control the optimizer: 
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c1, c2;
+
+  var nodeTypes = function (plan) {
+    return plan.nodes.map(function(node) { return node.type; });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection1");
+      db._drop("UnitTestsCollection2");
+      c1 = db._create("UnitTestsCollection1");
+      c2 = db._create("UnitTestsCollection2");
+
+      var i;
+      for (i = 0; i < 200; ++i) {
+        c1.save({ value: i, sub: { value: i % 10 } });
+      }
+      for (i = 0; i < 500; ++i) {
+        c2.save({ value: i % 50, other: (i % 3 === 0) ? String(i % 50) : i % 50 });
+      }
+      c2.save({ });
+      c2.save({ value: null });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection1");
+      db._drop("UnitTestsCollection2");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [ 
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER i.value == j.value RETURN [ i, j ]"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [ 
+        "FOR j IN " + c2.name() + " FILTER j.value == 1 RETURN j", // no join
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER i.value != j.value RETURN [ i, j ]", // no equality
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER i.value == j.value || i.value == 1 RETURN [ i, j ]", // or
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER j.value == RAND() RETURN [ i, j ]", // non-deterministic
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER j.value == j.other RETURN [ i, j ]", // no outer value
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " LIMIT 10 FILTER i.value == j.value RETURN [ i, j ]", // limit in between
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER i.value == j.value UPDATE j WITH { joined: true } IN " + c2.name(), // modification
+        "LET v = 1 LET x = (FOR j IN " + c2.name() + " FILTER j.value == v RETURN j) RETURN x" // subquery not executed in a loop
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect if an index can be used
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffectIndex : function () {
+      c2.ensureHashIndex("value");
+
+      var query = "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER i.value == j.value RETURN [ i, j ]";
+      var result = AQL_EXPLAIN(query);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      assertNotEqual(-1, nodeTypes(result.plan).indexOf("IndexRangeNode"), query);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [ 
+        [ "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER i.value == j.value RETURN [ i, j ]", [ "value" ] ],
+        [ "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER j.value == i.value RETURN [ i, j ]", [ "value" ] ],
+        [ "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER j.value == i.sub.value + 1 RETURN [ i, j ]", [ "value" ] ],
+        [ "FOR i IN " + c2.name() + " FOR j IN " + c1.name() + " FILTER i.value == j.sub.value RETURN [ i, j ]", [ "sub", "value" ] ],
+        [ "FOR i IN 1..10 FOR j IN " + c2.name() + " FILTER j.value == i RETURN j", [ "value" ] ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+        var nodes = result.plan.nodes.filter(function(node) { return node.type === "HashJoinNode"; });
+        assertEqual(1, nodes.length, query[0]);
+        assertEqual(query[1], nodes[0].attribute, query[0]);
+        assertEqual(-1, nodeTypes(result.plan).indexOf("EnumerateCollectionNode", nodeTypes(result.plan).indexOf("HashJoinNode")), query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect in correlated subqueries
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffectSubquery : function () {
+      var queries = [ 
+        "FOR i IN " + c1.name() + " LET x = (FOR j IN " + c2.name() + " FILTER j.value == i.value RETURN j) RETURN x",
+        "FOR i IN 1..10 LET x = (FOR j IN " + c2.name() + " FILTER j.value == i FILTER j.other != null RETURN j) RETURN x",
+        "FOR i IN " + c1.name() + " LET x = (FOR k IN 1..2 LET y = (FOR j IN " + c2.name() + " FILTER j.value == i.value RETURN j) RETURN y) RETURN x"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(1, helper.findExecutionNodes(result, "HashJoinNode").length, query);
+        assertEqual(0, helper.findExecutionNodes(result, "EnumerateCollectionNode").length, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [ 
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER i.value == j.value SORT i.value, j._key RETURN [ i.value, j._key ]",
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER j.value == i.sub.value SORT i.value, j._key RETURN [ i.value, j._key ]",
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER j.other == i.value SORT i.value, j._key RETURN [ i.value, j._key ]",
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER j.value == i.missing SORT i.value, j._key RETURN [ i.value, j._key ]",
+        "FOR i IN " + c1.name() + " FOR j IN " + c2.name() + " FILTER i.value == j.value FILTER i.value < 10 SORT i.value, j._key LIMIT 5, 20 RETURN [ i.value, j._key ]",
+        "FOR i IN [ 1, 1.0, '1', null, [ 1 ] ] FOR j IN " + c2.name() + " FILTER j.other == i SORT j._key RETURN [ i, j._key ]",
+        "FOR i IN " + c1.name() + " FILTER i.value < 5 LET x = (FOR j IN " + c2.name() + " FILTER j.value == i.value RETURN j._key) RETURN LENGTH(x)",
+        "FOR i IN " + c1.name() + " LET x = (FOR j IN " + c2.name() + " FILTER j.value == i.sub.value SORT j._key RETURN j._key) SORT i.value RETURN [ i.value, x ]",
+        "FOR i IN " + c1.name() + " LET x = (FOR k IN 1..2 LET y = (FOR j IN " + c2.name() + " FILTER j.other == i.value + k SORT j._key RETURN j._key) RETURN y) SORT i.value RETURN x"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramDisabled).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
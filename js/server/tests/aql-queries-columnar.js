@@ -0,0 +1,225 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for column-wise evaluation of conditions
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlColumnarTestSuite () {
+  var cn = "UnitTestsAhuacatlColumnar";
+  var c;
+
+  var values = [ null, false, true, -1, 0, 1, 2.5, 5, 100, "", "a", "abc", "5", [ ], [ 1 ], { }, { a: 1 } ];
+
+  var conditions = [
+    "d.value == 5",
+    "d.value != 5",
+    "d.value < 5",
+    "d.value <= 5",
+    "d.value > 5",
+    "d.value >= 5",
+    "d.value == 2.5",
+    "d.value == null",
+    "d.value != null",
+    "d.value < null",
+    "d.value > null",
+    "d.value == true",
+    "d.value < true",
+    "d.value >= false",
+    "d.value == 'abc'",
+    "d.value != 'abc'",
+    "d.value == ''",
+    "5 > d.value",
+    "null == d.value",
+    "d.value > 0 && d.value < 10",
+    "d.value < 0 || d.value > 10",
+    "! (d.value == 5)",
+    "! (d.value > 0 && d.value <= 5) || d.value == 'a'",
+    "d.sub.value == 1",
+    "d.sub.value < 2",
+    "d.missing == null",
+    "d.missing.value >= 0",
+    "d.value > 0 && d.sub.value == 1 && d.value != 'abc'",
+    "(d.value < 0 || d.value > 10) && d.sub.value != 2",
+    "d.sub.value == 0 && d.missing == null && ! (d.value == null)",
+    "d.value == 'no match' && d.sub.value == 1"
+  ];
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn);
+
+      values.forEach(function (value, i) {
+        c.save({ _key: "test" + i, value: value, sub: { value: i % 3 } });
+      });
+      c.save({ _key: "novalue" });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test conditions on documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testColumnarDocuments : function () {
+      conditions.forEach(function (condition) {
+        var query = "FOR d IN " + cn + " SORT d._key FILTER " + condition + " RETURN d._key";
+        var expected = AQL_EXECUTE(query.replace("FILTER " + condition, "FILTER V8(" + condition + ")")).json;
+        var actual = AQL_EXECUTE(query).json;
+        assertEqual(expected, actual, condition);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test conditions on documents, without sorting
+////////////////////////////////////////////////////////////////////////////////
+
+    testColumnarDocumentsUnsorted : function () {
+      conditions.forEach(function (condition) {
+        var query = "FOR d IN " + cn + " FILTER " + condition + " RETURN d._key";
+        var expected = AQL_EXECUTE(query.replace("FILTER " + condition, "FILTER V8(" + condition + ")")).json;
+        var actual = AQL_EXECUTE(query).json;
+        assertEqual(expected.sort(), actual.sort(), condition);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test condition results on documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testColumnarDocumentsResults : function () {
+      conditions.forEach(function (condition) {
+        var query = "FOR d IN " + cn + " SORT d._key LET r = " + condition + " RETURN [ d._key, r ]";
+        var expected = AQL_EXECUTE(query.replace("LET r = " + condition, "LET r = V8(" + condition + ")")).json;
+        var actual = AQL_EXECUTE(query).json;
+        assertEqual(expected, actual, condition);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test conditions on key
+////////////////////////////////////////////////////////////////////////////////
+
+    testColumnarKey : function () {
+      var actual = AQL_EXECUTE("FOR d IN " + cn + " FILTER d._key == 'test3' RETURN d.value").json;
+      assertEqual([ -1 ], actual);
+
+      actual = AQL_EXECUTE("FOR d IN " + cn + " FILTER d._key != 'test3' RETURN d.value").json;
+      assertEqual(values.length, actual.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test conditions on JSON values
+////////////////////////////////////////////////////////////////////////////////
+
+    testColumnarJson : function () {
+      var docs = values.map(function (value, i) {
+        return { value: value, sub: { value: i % 3 } };
+      });
+      docs.push({ }, null, 1, "foo", [ 1, 2 ]);
+
+      conditions.forEach(function (condition) {
+        var query = "FOR d IN @docs FILTER " + condition + " RETURN d";
+        var expected = AQL_EXECUTE(query.replace("FILTER " + condition, "FILTER V8(" + condition + ")"), { docs: docs }).json;
+        var actual = AQL_EXECUTE(query, { docs: docs }).json;
+        assertEqual(expected, actual, condition);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test conditions on many documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testColumnarManyDocuments : function () {
+      for (var i = 0; i < 5000; ++i) {
+        c.save({ value: i % 10 === 0 ? String(i) : i });
+      }
+
+      var actual = AQL_EXECUTE("FOR d IN " + cn + " FILTER d.value >= 4990 && d.value < 5000 RETURN d.value").json;
+      assertEqual([ 4991, 4992, 4993, 4994, 4995, 4996, 4997, 4998, 4999 ], actual.sort());
+
+      actual = AQL_EXECUTE("FOR d IN " + cn + " FILTER d.value == '4990' RETURN d.value").json;
+      assertEqual([ "4990" ], actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test conjunctions on many documents with different shapes
+////////////////////////////////////////////////////////////////////////////////
+
+    testColumnarConjunctionsShapes : function () {
+      for (var i = 0; i < 3000; ++i) {
+        if (i % 3 === 0) {
+          c.save({ value: i, group: i % 7 });
+        }
+        else if (i % 3 === 1) {
+          c.save({ group: i % 7, value: i, extra: true });
+        }
+        else {
+          c.save({ other: i, group: String(i % 7) });
+        }
+      }
+
+      var query = "FOR d IN " + cn + " FILTER d.group == 3 && d.value >= 100 && d.value < 200 RETURN d.value";
+      var expected = AQL_EXECUTE(query.replace("FILTER ", "FILTER V8(").replace(" RETURN", ") RETURN")).json;
+      var actual = AQL_EXECUTE(query).json;
+      assertEqual(expected.sort(), actual.sort());
+      assertEqual(10, actual.length);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(ahuacatlColumnarTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
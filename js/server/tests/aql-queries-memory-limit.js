@@ -0,0 +1,175 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertFalse, fail, AQL_EXECUTE, AQL_QUERIES_SLOW, AQL_QUERIES_PROPERTIES */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for query memory accounting and limits
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+var errors = require("internal").errors;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlMemoryLimitTestSuite () {
+  var cn = "UnitTestsAhuacatlMemoryLimit";
+  var c;
+
+  var assertLimitExceeded = function (query, options) {
+    try {
+      AQL_EXECUTE(query, { }, options);
+      fail();
+    }
+    catch (err) {
+      assertEqual(errors.ERROR_RESOURCE_LIMIT.code, err.errorNum, query);
+    }
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn);
+
+      AQL_EXECUTE("FOR i IN 0..9999 INSERT { _key: CONCAT('test', i), value: i, group: i % 13, name: CONCAT('this is a somewhat longer name ', i) } IN " + cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the peak memory usage is reported
+////////////////////////////////////////////////////////////////////////////////
+
+    testPeakMemoryUsage : function () {
+      var small = AQL_EXECUTE("RETURN 1");
+      assertTrue(small.stats.peakMemoryUsage > 0);
+
+      var big = AQL_EXECUTE("FOR doc IN " + cn + " SORT doc.name RETURN doc.name");
+      assertEqual(10000, big.json.length);
+      assertTrue(big.stats.peakMemoryUsage > small.stats.peakMemoryUsage);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that queries below the limit succeed
+////////////////////////////////////////////////////////////////////////////////
+
+    testBelowLimit : function () {
+      var query = "FOR doc IN " + cn + " COLLECT g = doc.group INTO x RETURN { g: g, n: LENGTH(x) }";
+      var expected = AQL_EXECUTE(query);
+      var actual = AQL_EXECUTE(query, { }, { memoryLimit: expected.stats.peakMemoryUsage * 2 });
+
+      assertEqual(expected.json, actual.json);
+      assertTrue(actual.stats.peakMemoryUsage <= expected.stats.peakMemoryUsage * 2);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that a limit of 0 means unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+    testNoLimit : function () {
+      var actual = AQL_EXECUTE("FOR doc IN " + cn + " RETURN doc", { }, { memoryLimit: 0 });
+
+      assertEqual(10000, actual.json.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that queries exceeding the limit fail
+////////////////////////////////////////////////////////////////////////////////
+
+    testAboveLimit : function () {
+      var limit = { memoryLimit: 100000 };
+
+      // result
+      assertLimitExceeded("FOR doc IN " + cn + " RETURN doc", limit);
+      // sort
+      assertLimitExceeded("FOR doc IN " + cn + " SORT doc.name LIMIT 1 RETURN doc.name", limit);
+      // collect
+      assertLimitExceeded("FOR doc IN " + cn + " COLLECT name = doc.name RETURN 1", limit);
+      // subquery
+      assertLimitExceeded("LET x = (FOR doc IN " + cn + " RETURN doc.name) RETURN LENGTH(x)", limit);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that a failed query leaves the collection usable
+////////////////////////////////////////////////////////////////////////////////
+
+    testAfterLimit : function () {
+      assertLimitExceeded("FOR doc IN " + cn + " SORT doc.name RETURN doc", { memoryLimit: 10000 });
+
+      var actual = AQL_EXECUTE("FOR doc IN " + cn + " FILTER doc.value < 10 RETURN doc.value");
+      assertEqual(10, actual.json.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the slow query log contains the peak memory usage
+////////////////////////////////////////////////////////////////////////////////
+
+    testSlowQueries : function () {
+      var properties = AQL_QUERIES_PROPERTIES();
+
+      try {
+        AQL_QUERIES_PROPERTIES({ enabled: true, trackSlowQueries: true, slowQueryThreshold: 0 });
+        AQL_QUERIES_SLOW(true);
+
+        AQL_EXECUTE("FOR doc IN " + cn + " SORT doc.name RETURN doc.name");
+
+        var slow = AQL_QUERIES_SLOW();
+        assertTrue(slow.length > 0);
+        assertTrue(slow[slow.length - 1].peakMemoryUsage > 0);
+      }
+      finally {
+        AQL_QUERIES_SLOW(true);
+        AQL_QUERIES_PROPERTIES(properties);
+      }
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(ahuacatlMemoryLimitTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
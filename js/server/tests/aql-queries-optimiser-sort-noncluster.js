@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false, maxlen: 500 */
-/*global assertEqual, AQL_EXPLAIN */
+/*global assertEqual, assertTrue, assertFalse, AQL_EXPLAIN, AQL_EXECUTE */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tests for query language, sort optimisations
@@ -428,6 +428,88 @@ function ahuacatlQueryOptimiserSortTestSuite () {
       assertEqual(99, actual[99].value);
       
       assertEqual([ "SingletonNode", "IndexRangeNode", "CalculationNode", "FilterNode", "CalculationNode", "SortNode", "ReturnNode" ], explain(query));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check sort with spilling to disk
+////////////////////////////////////////////////////////////////////////////////
+
+    testSpillToDisk1 : function () {
+      var query = "FOR i IN 1..5000 SORT (i * 7) % 5000 RETURN i";
+
+      var expected = AQL_EXECUTE(query).json;
+      var result = AQL_EXECUTE(query, { }, { sortMemoryLimit: 1 });
+      assertEqual(5000, result.json.length);
+      assertEqual(expected, result.json);
+      assertEqual(5, result.stats.spilledRuns);
+      assertTrue(result.stats.spilledBytes > 0);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check sort with spilling to disk, multiple fields and documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testSpillToDisk2 : function () {
+      var query = "FOR c IN " + cn + " FOR i IN 1..30 SORT c.value % 10 DESC, i RETURN { value: c.value, i: i }";
+
+      var expected = AQL_EXECUTE(query).json;
+      var result = AQL_EXECUTE(query, { }, { sortMemoryLimit: 1 });
+      assertEqual(3000, result.json.length);
+      assertEqual(expected, result.json);
+      assertTrue(result.stats.spilledRuns > 1);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check sort with spilling to disk, followed by a limit
+////////////////////////////////////////////////////////////////////////////////
+
+    testSpillToDiskLimit : function () {
+      var query = "FOR i IN 1..5000 SORT i DESC LIMIT 1500, 10 RETURN i";
+
+      var result = AQL_EXECUTE(query, { }, { sortMemoryLimit: 1 });
+      assertEqual([ 3500, 3499, 3498, 3497, 3496, 3495, 3494, 3493, 3492, 3491 ], result.json);
+      assertEqual(5, result.stats.spilledRuns);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check sort with spilling to disk, caused by document payloads
+////////////////////////////////////////////////////////////////////////////////
+
+    testSpillToDiskDocuments : function () {
+      var other = internal.db._create(cn + "Documents");
+      var payload = new Array(10001).join("x");
+
+      try {
+        for (var i = 0; i < 1000; ++i) {
+          other.save({ value: (i * 7) % 1000, payload: payload });
+        }
+
+        var query = "FOR d IN " + other.name() + " SORT d.value RETURN d";
+        var values = function (docs) {
+          return docs.map(function (doc) { return doc.value; });
+        };
+        var expected = values(AQL_EXECUTE(query).json);
+
+        // the rows alone fit into the limit, the documents do not
+        var result = AQL_EXECUTE(query, { }, { sortMemoryLimit: 1024 * 1024 });
+        assertEqual(1000, result.json.length);
+        assertEqual(expected, values(result.json));
+        assertTrue(result.stats.spilledRuns > 1);
+      }
+      finally {
+        internal.db._drop(other.name());
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check that the default sort does not spill
+////////////////////////////////////////////////////////////////////////////////
+
+    testNoSpillToDisk : function () {
+      var result = AQL_EXECUTE("FOR i IN 1..5000 SORT i DESC RETURN i");
+      assertEqual(5000, result.json.length);
+      assertFalse(result.stats.hasOwnProperty("spilledRuns"));
+      assertFalse(result.stats.hasOwnProperty("spilledBytes"));
     }
 
   };
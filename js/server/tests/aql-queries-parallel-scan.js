@@ -0,0 +1,191 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for parallel collection scans
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlParallelScanTestSuite () {
+  var cn = "UnitTestsAhuacatlParallelScan";
+  var n = 20000;
+  var parallel = { maxParallelism: 4 };
+  var c;
+
+  var compare = function (query, bindVars) {
+    var expected = AQL_EXECUTE(query, bindVars || { });
+    var actual = AQL_EXECUTE(query, bindVars || { }, parallel);
+
+    assertEqual(expected.json, actual.json);
+    assertEqual(expected.stats.scannedFull, actual.stats.scannedFull);
+    assertEqual(expected.stats.filtered, actual.stats.filtered);
+
+    return actual;
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn);
+
+      AQL_EXECUTE("FOR i IN 0.." + (n - 1) + " INSERT { _key: CONCAT('test', i), value: i, group: i % 13, name: CONCAT('name', i) } IN " + cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter on a document attribute
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilter : function () {
+      var result = compare("FOR doc IN " + cn + " FILTER doc.group == 3 RETURN doc.value");
+      assertEqual(1539, result.json.length);
+      assertEqual(n, result.stats.scannedFull);
+      assertEqual(n - 1539, result.stats.filtered);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter that returns all documents, in scan order
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilterAll : function () {
+      var result = compare("FOR doc IN " + cn + " FILTER doc.value >= 0 RETURN doc._key");
+      assertEqual(n, result.json.length);
+      assertEqual(0, result.stats.filtered);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter that returns no documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilterNone : function () {
+      var result = compare("FOR doc IN " + cn + " FILTER doc.value < 0 RETURN doc");
+      assertEqual([ ], result.json);
+      assertEqual(n, result.stats.scannedFull);
+      assertEqual(n, result.stats.filtered);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter with multiple calculations and functions
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilterFunctions : function () {
+      var result = compare("FOR doc IN " + cn + " LET name = UPPER(doc.name) FILTER LIKE(name, 'NAME1%') && doc.group IN [ 1, 2, 3 ] RETURN { key: doc._key, name: name }");
+      assertTrue(result.json.length > 0);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter on the _id attribute
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilterId : function () {
+      var result = compare("FOR doc IN " + cn + " FILTER doc._id == @id RETURN doc.value", { id: cn + "/test1234" });
+      assertEqual([ 1234 ], result.json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter that depends on an outer variable
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilterOuterVariable : function () {
+      var result = compare("FOR i IN [ 1, 5, 12 ] FOR doc IN " + cn + " FILTER doc.group == i && doc.value < 1000 RETURN [ i, doc.value ]");
+      assertEqual(230, result.json.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter followed by a limit
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilterLimit : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.group == 4 LIMIT 10, 5 RETURN doc.value";
+      // the parallel scan may inspect more documents than needed for the limit
+      var expected = AQL_EXECUTE(query).json;
+      var result = AQL_EXECUTE(query, { }, parallel);
+      assertEqual(expected, result.json);
+      assertEqual(5, result.json.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter that produces warnings in multiple threads
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilterWarnings : function () {
+      var query = "FOR doc IN " + cn + " FILTER SUM(doc.value) == 1 RETURN doc";
+      var result = AQL_EXECUTE(query, { }, parallel);
+      assertEqual([ ], result.json);
+      assertTrue(result.warnings.length > 0);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test filter that cannot be evaluated in parallel
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelFilterV8 : function () {
+      var result = compare("FOR doc IN " + cn + " FILTER V8(doc.value % 1000 == 0) RETURN doc.value");
+      assertEqual(20, result.json.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test a scan without a filter
+////////////////////////////////////////////////////////////////////////////////
+
+    testParallelNoFilter : function () {
+      var result = compare("FOR doc IN " + cn + " RETURN doc.value");
+      assertEqual(n, result.json.length);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(ahuacatlParallelScanTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
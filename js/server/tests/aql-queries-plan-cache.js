@@ -0,0 +1,274 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for the AQL plan cache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlPlanCacheTestSuite () {
+  var cn = "UnitTestsAhuacatlPlanCache";
+  var c;
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn);
+
+      for (var i = 0; i < 100; ++i) {
+        c.save({ _key: "test" + i, value: i });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test repeated execution with different bind parameter values
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheBindParameters : function () {
+      var query = "FOR doc IN @@cn FILTER doc.value == @value RETURN doc._key";
+
+      for (var j = 0; j < 3; ++j) {
+        for (var i = 0; i < 10; ++i) {
+          var result = AQL_EXECUTE(query, { "@cn": cn, value: i * 7 }).json;
+          assertEqual([ "test" + (i * 7) ], result);
+        }
+      }
+
+      assertEqual([ ], AQL_EXECUTE(query, { "@cn": cn, value: "7" }).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that a cached plan uses an index for other bind parameter values
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheBindParametersIndex : function () {
+      var query = "FOR doc IN @@cn FILTER doc.value == @value RETURN doc._key";
+      c.ensureHashIndex("value");
+
+      for (var j = 0; j < 2; ++j) {
+        for (var i = 0; i < 10; ++i) {
+          var result = AQL_EXECUTE(query, { "@cn": cn, value: i * 11 });
+          assertEqual([ "test" + (i * 11) ], result.json);
+          assertEqual(0, result.stats.scannedFull);
+          assertEqual(1, result.stats.scannedIndex);
+        }
+      }
+
+      assertEqual([ "test1", "test2" ], AQL_EXECUTE("FOR doc IN @@cn FILTER doc.value IN @value SORT doc.value RETURN doc._key", { "@cn": cn, value: [ 1, 2 ] }).json);
+      assertEqual([ "test3" ], AQL_EXECUTE("FOR doc IN @@cn FILTER doc.value IN @value SORT doc.value RETURN doc._key", { "@cn": cn, value: [ 3 ] }).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bind parameters whose values are needed to build the plan
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCachePlanParameters : function () {
+      var i;
+
+      for (i = 0; i < 2; ++i) {
+        assertEqual([ 0 ], AQL_EXECUTE("FOR doc IN @@cn SORT doc.value LIMIT @limit RETURN doc.value", { "@cn": cn, limit: 1 }).json);
+        assertEqual([ 0, 1, 2 ], AQL_EXECUTE("FOR doc IN @@cn SORT doc.value LIMIT @limit RETURN doc.value", { "@cn": cn, limit: 3 }).json);
+
+        assertEqual([ 99, 98 ], AQL_EXECUTE("FOR doc IN @@cn SORT doc.value @dir LIMIT 2 RETURN doc.value", { "@cn": cn, dir: "DESC" }).json);
+        assertEqual([ 0, 1 ], AQL_EXECUTE("FOR doc IN @@cn SORT doc.value @dir LIMIT 2 RETURN doc.value", { "@cn": cn, dir: "ASC" }).json);
+
+        assertEqual([ 5 ], AQL_EXECUTE("FOR doc IN @@cn FILTER doc.@attr == @value RETURN doc.value", { "@cn": cn, attr: "value", value: 5 }).json);
+        assertEqual([ 7 ], AQL_EXECUTE("FOR doc IN @@cn FILTER doc.@attr == @value RETURN doc.value", { "@cn": cn, attr: "_key", value: "test7" }).json);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test an UPSERT with different bind parameter values
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheUpsert : function () {
+      var query = "UPSERT { value: @value } INSERT { value: @value, inserted: true } UPDATE { updated: true } IN @@cn";
+
+      for (var i = 98; i < 102; ++i) {
+        AQL_EXECUTE(query, { "@cn": cn, value: i });
+      }
+
+      assertEqual(102, c.count());
+      assertEqual([ 98, 99 ], AQL_EXECUTE("FOR doc IN @@cn FILTER doc.updated SORT doc.value RETURN doc.value", { "@cn": cn }).json);
+      assertEqual([ 100, 101 ], AQL_EXECUTE("FOR doc IN @@cn FILTER doc.inserted SORT doc.value RETURN doc.value", { "@cn": cn }).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that index creation and removal invalidate the plan
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheIndexInvalidation : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.value == 42 RETURN doc._key";
+      var result, i;
+
+      for (i = 0; i < 2; ++i) {
+        result = AQL_EXECUTE(query);
+        assertEqual([ "test42" ], result.json);
+        assertEqual(100, result.stats.scannedFull);
+        assertEqual(0, result.stats.scannedIndex);
+      }
+
+      var idx = c.ensureHashIndex("value");
+
+      for (i = 0; i < 2; ++i) {
+        result = AQL_EXECUTE(query);
+        assertEqual([ "test42" ], result.json);
+        assertEqual(0, result.stats.scannedFull);
+        assertEqual(1, result.stats.scannedIndex);
+      }
+
+      c.dropIndex(idx);
+
+      for (i = 0; i < 2; ++i) {
+        result = AQL_EXECUTE(query);
+        assertEqual([ "test42" ], result.json);
+        assertEqual(100, result.stats.scannedFull);
+        assertEqual(0, result.stats.scannedIndex);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the optimizer options are part of the cache key
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheOptimizerRules : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.value == 42 RETURN doc._key";
+      var noIndex = { optimizer: { rules: [ "-use-index-range" ] } };
+      var result, i;
+
+      c.ensureHashIndex("value");
+
+      for (i = 0; i < 2; ++i) {
+        result = AQL_EXECUTE(query);
+        assertEqual([ "test42" ], result.json);
+        assertEqual(1, result.stats.scannedIndex);
+
+        result = AQL_EXECUTE(query, { }, noIndex);
+        assertEqual([ "test42" ], result.json);
+        assertEqual(100, result.stats.scannedFull);
+        assertEqual(0, result.stats.scannedIndex);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that dropping and recreating a collection invalidates the plan
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheCollectionRecreated : function () {
+      var query = "FOR doc IN " + cn + " SORT doc.value LIMIT 2 RETURN doc.value";
+
+      assertEqual([ 0, 1 ], AQL_EXECUTE(query).json);
+      assertEqual([ 0, 1 ], AQL_EXECUTE(query).json);
+
+      c.ensureSkiplist("value");
+      assertEqual([ 0, 1 ], AQL_EXECUTE(query).json);
+
+      db._drop(cn);
+      c = db._create(cn);
+      c.save({ value: 23 });
+      c.save({ value: 17 });
+
+      assertEqual([ 17, 23 ], AQL_EXECUTE(query).json);
+      assertEqual([ 17, 23 ], AQL_EXECUTE(query).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test repeated execution of a data modification query
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheModification : function () {
+      var query = "FOR i IN 1..10 INSERT { value: i } INTO " + cn;
+
+      for (var i = 0; i < 3; ++i) {
+        var result = AQL_EXECUTE(query);
+        assertEqual([ ], result.json);
+        assertEqual(10, result.stats.writesExecuted);
+      }
+
+      assertEqual(130, c.count());
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test repeated execution of a query with warnings
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheWarnings : function () {
+      var query = "RETURN 1 / 0";
+
+      for (var i = 0; i < 2; ++i) {
+        var result = AQL_EXECUTE(query);
+        assertEqual([ null ], result.json);
+        assertEqual(1, result.warnings.length);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test turning off the plan cache for a query
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlanCacheDisabled : function () {
+      var query = "FOR doc IN " + cn + " FILTER doc.value < 3 SORT doc.value RETURN doc.value";
+
+      for (var i = 0; i < 2; ++i) {
+        assertEqual([ 0, 1, 2 ], AQL_EXECUTE(query, { }, { planCache: false }).json);
+        assertEqual([ 0, 1, 2 ], AQL_EXECUTE(query).json);
+      }
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(ahuacatlPlanCacheTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
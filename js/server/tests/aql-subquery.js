@@ -314,6 +314,50 @@ function ahuacatlSubqueryTestSuite () {
 
       var actual = getQueryResults("LET a = (FOR i IN 1..2000 RETURN i) FOR i IN 1..10000 FILTER i IN a RETURN i");
       assertEqual(expected, actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test detection of constant subqueries
+////////////////////////////////////////////////////////////////////////////////
+
+    testConstSubqueries: function () {
+      var queries = [
+        [ "FOR i IN 1..10 LET a = (FOR j IN 1..5 RETURN j) RETURN a", true ],
+        [ "FOR i IN 1..10 LET a = (FOR j IN 1..5 LET b = (FOR k IN 1..2 RETURN j + k) RETURN b) RETURN a", true ],
+        [ "FOR i IN 1..10 LET a = (FOR j IN 1..5 RETURN i + j) RETURN a", false ],
+        [ "FOR i IN 1..10 LET a = (FOR j IN 1..5 RETURN RAND()) RETURN a", false ],
+        [ "FOR i IN 1..10 LET a = (FOR j IN 1..5 LET b = (RETURN i) RETURN b) RETURN a", false ]
+      ];
+
+      queries.forEach(function(query) {
+        var nodes = findExecutionNodes(AQL_EXPLAIN(query[0]), "SubqueryNode");
+        assertEqual(query[1], nodes[0].isConst, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results of constant subqueries, spanning multiple blocks
+////////////////////////////////////////////////////////////////////////////////
+
+    testConstSubqueryResults: function () {
+      var expected = [ ];
+      for (var i = 1; i <= 2500; ++i) {
+        expected.push([ i, [ 2, 4, 6 ] ]);
+      }
+
+      var actual = getQueryResults("FOR i IN 1..2500 LET a = (FOR j IN 1..3 RETURN j * 2) RETURN [ i, a ]");
+      assertEqual(expected, actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results of subqueries that use outer variables in a nested
+/// subquery only
+////////////////////////////////////////////////////////////////////////////////
+
+    testNestedDependentSubqueryResults: function () {
+      var expected = [ [ 1, 2 ], [ 2, 4 ], [ 3, 6 ] ];
+      var actual = getQueryResults("FOR i IN 1..3 LET a = (FOR j IN 1..2 LET b = (RETURN i * j) RETURN b[0]) RETURN a");
+      assertEqual(expected, actual);
     }
 
   };
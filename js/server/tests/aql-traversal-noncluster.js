@@ -0,0 +1,279 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for native AQL graph traversals
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var errors = require("internal").errors;
+var helper = require("org/arangodb/aql-helper");
+var db = require("org/arangodb").db;
+var getQueryResults = helper.getQueryResults;
+var assertQueryError = helper.assertQueryError;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function traversalTestSuite () {
+  var vn = "UnitTestsTraversalVertices";
+  var en = "UnitTestsTraversalEdges";
+  var vertices, edges;
+
+  var start = function (key) {
+    return "'" + vn + "/" + key + "'";
+  };
+
+  var sorted = function (query, bindVars) {
+    return getQueryResults(query, bindVars || { }).sort();
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+/// A -> B -> C -> D, A -> E -> C, C -> A
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(vn);
+      db._drop(en);
+      vertices = db._create(vn);
+      edges = db._createEdgeCollection(en);
+
+      [ "A", "B", "C", "D", "E" ].forEach(function (key) {
+        vertices.save({ _key: key, name: key.toLowerCase() });
+      });
+
+      var connect = function (from, to, type) {
+        edges.save(vn + "/" + from, vn + "/" + to, { type: type });
+      };
+
+      connect("A", "B", "friend");
+      connect("B", "C", "friend");
+      connect("C", "D", "friend");
+      connect("A", "E", "colleague");
+      connect("E", "C", "friend");
+      connect("C", "A", "colleague");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(vn);
+      db._drop(en);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test fixed depths
+////////////////////////////////////////////////////////////////////////////////
+
+    testFixedDepth : function () {
+      assertEqual([ "B", "E" ], sorted("FOR v IN 1 OUTBOUND " + start("A") + " " + en + " RETURN v._key"));
+      assertEqual([ "C", "C" ], sorted("FOR v IN 2 OUTBOUND " + start("A") + " " + en + " RETURN v._key"));
+      assertEqual([ "A", "A", "D", "D" ], sorted("FOR v IN 3 OUTBOUND " + start("A") + " " + en + " RETURN v._key"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test depth ranges
+////////////////////////////////////////////////////////////////////////////////
+
+    testDepthRange : function () {
+      assertEqual([ "A", "B", "E" ], sorted("FOR v IN 0..1 OUTBOUND " + start("A") + " " + en + " RETURN v._key"));
+      assertEqual([ "A", "A", "B", "C", "C", "D", "D", "E" ], sorted("FOR v IN 1..3 OUTBOUND " + start("A") + " " + en + " RETURN v._key"));
+      assertEqual([ "A" ], sorted("FOR v IN 0 OUTBOUND " + start("A") + " " + en + " RETURN v._key"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test directions
+////////////////////////////////////////////////////////////////////////////////
+
+    testDirections : function () {
+      assertEqual([ "D" ], sorted("FOR v IN 1 OUTBOUND " + start("C") + " " + en + " FILTER v._key != 'A' RETURN v._key"));
+      assertEqual([ "B", "E" ], sorted("FOR v IN 1 INBOUND " + start("C") + " " + en + " RETURN v._key"));
+      assertEqual([ "A", "B", "D", "E" ], sorted("FOR v IN 1 ANY " + start("C") + " " + en + " RETURN v._key"));
+      assertEqual([ "B", "E" ], sorted("FOR v IN 1 outbound " + start("A") + " " + en + " RETURN v._key"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test uniqueness options
+////////////////////////////////////////////////////////////////////////////////
+
+    testUniqueness : function () {
+      var query = "FOR v IN 1..3 OUTBOUND " + start("A") + " " + en + " OPTIONS { uniqueVertices: @uniqueness } RETURN v._key";
+      assertEqual([ "B", "C", "C", "D", "D", "E" ], sorted(query, { uniqueness: "path" }));
+      assertQueryError(errors.ERROR_BAD_PARAMETER.code, query, { uniqueness: "global" });
+
+      query = "FOR v IN 1..6 OUTBOUND " + start("A") + " " + en + " OPTIONS { uniqueEdges: 'path' } RETURN v._key";
+      assertEqual(14, getQueryResults(query).length);
+      assertQueryError(errors.ERROR_BAD_PARAMETER.code, "FOR v IN 1..3 OUTBOUND " + start("A") + " " + en + " OPTIONS { uniqueEdges: 'global' } RETURN v");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that a vertex first reached at the maximum depth is still
+/// expanded when it is reached at a lower depth later
+/// A -> B -> C -> D, A -> C
+////////////////////////////////////////////////////////////////////////////////
+
+    testUniquenessShorterPath : function () {
+      edges.truncate();
+      [ [ "A", "B" ], [ "B", "C" ], [ "A", "C" ], [ "C", "D" ] ].forEach(function (edge) {
+        edges.save(vn + "/" + edge[0], vn + "/" + edge[1], { });
+      });
+
+      var query = "FOR v IN 1..2 OUTBOUND " + start("A") + " " + en + " OPTIONS { uniqueVertices: @uniqueness } RETURN v._key";
+      assertEqual([ "B", "C", "C", "D" ], sorted(query, { uniqueness: "path" }));
+      assertEqual([ "B", "C", "C", "D" ], sorted(query, { uniqueness: "none" }));
+      assertQueryError(errors.ERROR_BAD_PARAMETER.code, query, { uniqueness: "global" });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test edge and path variables
+////////////////////////////////////////////////////////////////////////////////
+
+    testEdgeAndPath : function () {
+      var actual = getQueryResults("FOR v, e, p IN 0..2 OUTBOUND " + start("A") + " " + en + " SORT v._key, e.type RETURN { v: v._key, e: e.type, edges: LENGTH(p.edges), first: p.vertices[0]._key, last: p.vertices[LENGTH(p.vertices) - 1]._key }");
+      assertEqual([ 
+        { v: "A", e: null, edges: 0, first: "A", last: "A" },
+        { v: "B", e: "friend", edges: 1, first: "A", last: "B" },
+        { v: "C", e: "friend", edges: 2, first: "A", last: "C" },
+        { v: "C", e: "friend", edges: 2, first: "A", last: "C" },
+        { v: "E", e: "colleague", edges: 1, first: "A", last: "E" }
+      ], actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test start vertices from documents and other expressions
+////////////////////////////////////////////////////////////////////////////////
+
+    testStartVertices : function () {
+      assertEqual([ "B", "C", "E" ], sorted("FOR s IN " + vn + " FILTER s._key IN [ 'A', 'B' ] FOR v IN 1 OUTBOUND s " + en + " RETURN v._key"));
+      assertEqual([ "B", "E" ], sorted("FOR v IN 1 OUTBOUND CONCAT(@vn, '/A') " + en + " RETURN v._key", { vn: vn }));
+      assertEqual([ ], sorted("FOR v IN 1 OUTBOUND 'foo' " + en + " RETURN v"));
+      assertEqual([ ], sorted("FOR v IN 1 OUTBOUND null " + en + " RETURN v"));
+      assertEqual([ ], sorted("FOR v IN 1 OUTBOUND " + start("D") + " " + en + " RETURN v"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bind parameters
+////////////////////////////////////////////////////////////////////////////////
+
+    testBindParameters : function () {
+      assertEqual([ "C", "C" ], sorted("FOR v IN @min..@max OUTBOUND @start @@edges RETURN v._key", { min: 2, max: 2, start: vn + "/A", "@edges": en }));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test dangling edges
+////////////////////////////////////////////////////////////////////////////////
+
+    testDanglingEdge : function () {
+      vertices.remove("D");
+      assertEqual([ null ], getQueryResults("FOR v IN 1 OUTBOUND " + start("C") + " " + en + " FILTER v == null || v._key != 'A' RETURN v"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test path conditions
+////////////////////////////////////////////////////////////////////////////////
+
+    testPathConditions : function () {
+      var ruleName = "move-filters-into-traversal";
+      var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+      var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+
+      var queries = [ 
+        "FOR v, e, p IN 1..3 OUTBOUND " + start("A") + " " + en + " FILTER p.edges[0].type == 'friend' SORT v._key RETURN v._key",
+        "FOR v, e, p IN 1..3 OUTBOUND " + start("A") + " " + en + " FILTER p.edges[1].type == 'friend' SORT v._key RETURN v._key",
+        "FOR v, e, p IN 1..3 OUTBOUND " + start("A") + " " + en + " FILTER p.vertices[1].name != 'b' LET x = 1 FILTER p.edges[2].type == 'colleague' SORT v._key RETURN v._key",
+        "FOR v, e, p IN 0..3 ANY " + start("C") + " " + en + " FILTER p.vertices[0]._key == 'C' SORT v._key RETURN v._key"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+
+        var expected = AQL_EXECUTE(query, { }, paramDisabled).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+      });
+
+      var noEffect = [
+        "FOR v, e, p IN 1..3 OUTBOUND " + start("A") + " " + en + " FILTER LENGTH(p.edges) == 2 RETURN v._key",
+        "FOR v, e, p IN 1..3 OUTBOUND " + start("A") + " " + en + " FILTER p.edges[0].type == v.name RETURN v._key",
+        "FOR v, e, p IN 1..3 OUTBOUND " + start("A") + " " + en + " FILTER p.edges[5].type == 'friend' RETURN v._key",
+        "FOR v, e IN 1..3 OUTBOUND " + start("A") + " " + en + " FILTER e.type == 'friend' RETURN v._key"
+      ];
+
+      noEffect.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the execution plan
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlan : function () {
+      var result = AQL_EXPLAIN("FOR v IN 1..2 OUTBOUND " + start("A") + " " + en + " RETURN v");
+      var nodes = result.plan.nodes.filter(function (node) {
+        return node.type === "TraversalNode";
+      });
+      assertEqual(1, nodes.length);
+      assertEqual(en, nodes[0].edgeCollection);
+      assertEqual(1, nodes[0].traversalOptions.minDepth);
+      assertEqual(2, nodes[0].traversalOptions.maxDepth);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test invalid queries
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalid : function () {
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR v IN 1 SIDEWAYS " + start("A") + " " + en + " RETURN v");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR v IN 3..1 OUTBOUND " + start("A") + " " + en + " RETURN v");
+      assertQueryError(errors.ERROR_QUERY_PARSE.code, "FOR x IN [ 1 ] FOR v IN x OUTBOUND " + start("A") + " " + en + " RETURN v");
+      assertQueryError(errors.ERROR_BAD_PARAMETER.code, "FOR v IN 1 OUTBOUND " + start("A") + " " + en + " OPTIONS { uniqueVertices: 'foo' } RETURN v");
+      assertQueryError(errors.ERROR_ARANGO_COLLECTION_TYPE_INVALID.code, "FOR v IN 1 OUTBOUND " + start("A") + " " + vn + " RETURN v");
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(traversalTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
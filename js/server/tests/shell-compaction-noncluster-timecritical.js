@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false, sub: true */
-/*global fail, assertEqual, assertTrue, assertFalse */
+/*global fail, assertEqual, assertTrue, assertFalse, assertNotEqual */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test the compaction
@@ -315,6 +315,52 @@ function CompactionSuite () {
       internal.db._drop(cn);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test compressed datafiles
+////////////////////////////////////////////////////////////////////////////////
+
+    testCompressedDatafilesUnloadReload : function () {
+      var cn = "example";
+      internal.db._drop(cn);
+      var c1 = internal.db._create(cn, { "journalSize" : 1048576, "compressDatafiles" : true });
+
+      assertTrue(c1.properties().compressDatafiles);
+
+      var i, doc;
+      var payload = "the quick brown fox jumped over the lazy dog. a quick dog jumped over the lazy fox.";
+
+      for (i = 0; i < 1000; ++i) {
+        c1.save({ _key: "test" + i, value: i, payload: payload });
+      }
+
+      testHelper.rotate(c1);
+      testHelper.waitUnload(c1);
+
+      c1 = internal.db._collection(cn);
+
+      // the sealed datafiles are now compressed
+      assertEqual(0, c1.datafiles().datafiles.length);
+
+      // loading the collection uncompresses them again
+      assertEqual(1000, c1.count());
+      for (i = 0; i < 1000; ++i) {
+        doc = c1.document("test" + i);
+        assertEqual(i, doc.value);
+        assertEqual(payload, doc.payload);
+      }
+
+      c1.properties({ compressDatafiles: false });
+      assertFalse(c1.properties().compressDatafiles);
+
+      testHelper.waitUnload(c1);
+      c1 = internal.db._collection(cn);
+
+      assertNotEqual(0, c1.datafiles().datafiles.length);
+      assertEqual(1000, c1.count());
+
+      internal.db._drop(cn);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test journals
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,6 +89,57 @@ function walFailureSuite () {
       assertEqual(1000, c.count());
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that superseded documents are not copied into the datafiles
+////////////////////////////////////////////////////////////////////////////////
+
+    testCollectorSkipsSupersededMarkers : function () {
+      internal.wal.flush(true, true);
+      internal.debugSetFailAt("CollectorThreadCollect");
+
+      var i;
+      for (i = 0; i < 1000; ++i) {
+        c.save({ _key: "test" + i, value: i });
+      }
+      internal.wal.flush(true, false);
+
+      // update and remove the documents in a later logfile
+      for (i = 0; i < 500; ++i) {
+        c.update("test" + i, { value: i + 1 });
+      }
+      for (i = 500; i < 1000; ++i) {
+        c.remove("test" + i);
+      }
+      internal.wal.flush(true, false);
+
+      internal.debugClearFailAt();
+      internal.wal.flush(true, true);
+
+      var fig, tries = 0;
+      while (++tries < 20) {
+        fig = c.figures();
+        if (fig.uncollectedLogfileEntries === 0) {
+          break;
+        }
+        internal.wait(1, false);
+      }
+
+      assertEqual(0, fig.uncollectedLogfileEntries);
+      assertEqual(500, fig.alive.count);
+      // the original revisions were never written into the datafiles
+      assertEqual(0, fig.dead.count);
+      assertEqual(500, fig.dead.deletion);
+
+      assertEqual(500, c.count());
+      assertEqual(1, c.document("test0").value);
+      assertEqual(500, c.document("test499").value);
+
+      testHelper.waitUnload(c);
+
+      assertEqual(500, c.count());
+      assertEqual(1, c.document("test0").value);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test no more available logfiles
 ////////////////////////////////////////////////////////////////////////////////
@@ -205,17 +256,22 @@ function walSuite () {
   var cn = "UnitTestsWal";
   var c;
   var props;
+  var groupCommitDelay;
 
   return {
 
     setUp: function () {
       props = internal.wal.properties();
+      groupCommitDelay = props.groupCommitDelay;
 
       db._drop(cn);
       c = db._create(cn);
     },
 
     tearDown: function () {
+      // restore the group commit delay separately, so a failure when
+      // restoring the other properties cannot leave it modified
+      internal.wal.properties({ groupCommitDelay: groupCommitDelay });
       internal.wal.properties(props);
       db._drop(cn);
       c = null;
@@ -233,6 +289,7 @@ function walSuite () {
       assertTrue(p.hasOwnProperty("historicLogfiles"));
       assertTrue(p.hasOwnProperty("reserveLogfiles"));
       assertTrue(p.hasOwnProperty("syncInterval"));
+      assertTrue(p.hasOwnProperty("groupCommitDelay"));
       assertTrue(p.hasOwnProperty("throttleWait"));
       assertTrue(p.hasOwnProperty("throttleWhenPending"));
     },
@@ -250,6 +307,7 @@ function walSuite () {
         historicLogfiles: 4, 
         reserveLogfiles: 4,
         syncInterval: 200,
+        groupCommitDelay: 500,
         throttleWait: 10000,
         throttleWhenPending: 10000
       };
@@ -261,6 +319,7 @@ function walSuite () {
       assertEqual(p.historicLogfiles, result.historicLogfiles);
       assertEqual(p.reserveLogfiles, result.reserveLogfiles);
       assertEqual(initial.syncInterval, result.syncInterval);
+      assertEqual(p.groupCommitDelay, result.groupCommitDelay);
       assertEqual(p.throttleWait, result.throttleWait);
       assertEqual(p.throttleWhenPending, result.throttleWhenPending);
       
@@ -270,10 +329,83 @@ function walSuite () {
       assertEqual(p.historicLogfiles, result2.historicLogfiles);
       assertEqual(p.reserveLogfiles, result2.reserveLogfiles);
       assertEqual(initial.syncInterval, result2.syncInterval);
+      assertEqual(p.groupCommitDelay, result2.groupCommitDelay);
       assertEqual(p.throttleWait, result2.throttleWait);
       assertEqual(p.throttleWhenPending, result2.throttleWhenPending);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test sync statistics
+////////////////////////////////////////////////////////////////////////////////
+
+    testSyncStatistics : function () {
+      var initial = internal.wal.statistics();
+
+      assertTrue(initial.hasOwnProperty("syncs"));
+      assertTrue(initial.hasOwnProperty("syncedCommits"));
+      assertTrue(initial.hasOwnProperty("commitsPerSync"));
+      assertTrue(initial.hasOwnProperty("recentCommitsPerSync"));
+
+      var i;
+      for (i = 0; i < 10; ++i) {
+        c.save({ test: i }, { waitForSync: true });
+      }
+
+      var s = internal.wal.statistics();
+      assertTrue(s.syncs > initial.syncs);
+      assertTrue(s.syncedCommits >= initial.syncedCommits + 10);
+      assertEqual(s.syncedCommits / s.syncs, s.commitsPerSync);
+      assertTrue(s.commitsPerSync >= 1);
+      assertTrue(s.recentCommitsPerSync >= 1);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test group commit
+////////////////////////////////////////////////////////////////////////////////
+
+    testGroupCommit : function () {
+      var tasks = require("org/arangodb/tasks");
+      var writers = 8, n = 200, i;
+
+      internal.wal.properties({ groupCommitDelay: 1000 });
+      var initial = internal.wal.statistics();
+
+      // synchronous writers running concurrently in the server
+      for (i = 0; i < writers; ++i) {
+        tasks.register({
+          id: "UnitTestsWalGroupCommit" + i,
+          command: function (params) {
+            var c = require("internal").db._collection(params.cn);
+            var i;
+            for (i = 0; i < params.n; ++i) {
+              c.save({ writer: params.writer, value: i }, { waitForSync: true });
+            }
+          },
+          offset: 0,
+          params: { cn: cn, n: n, writer: i }
+        });
+      }
+
+      // the moving average drops again when the writers finish, so sample it
+      // while they run
+      var maxRecent = 0, s, tries = 0;
+      while (++tries < 600) {
+        s = internal.wal.statistics();
+        maxRecent = Math.max(maxRecent, s.recentCommitsPerSync);
+        if (c.count() === writers * n) {
+          break;
+        }
+        internal.wait(0.1, false);
+      }
+
+      assertEqual(writers * n, c.count());
+      s = internal.wal.statistics();
+      assertTrue(s.syncedCommits - initial.syncedCommits >= writers * n);
+      // syncs covered more than one commit each
+      assertTrue(s.syncs - initial.syncs < s.syncedCommits - initial.syncedCommits);
+      assertTrue(maxRecent > 1);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test max tick
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +29,15 @@
 
 #include "hashes.h"
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <cpuid.h>
+#define TRI_HAVE_HARDWARE_CRC32C 1
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#include <nmmintrin.h>
+#define TRI_HAVE_HARDWARE_CRC32C 1
+#endif
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                               FNV
 // -----------------------------------------------------------------------------
@@ -396,6 +405,23 @@ static const uint32_t Crc32Lookup[8][256] = {
     0x2C8E0FFF,0xE0240F61,0x6EAB0882,0xA201081C,0xA8C40105,0x646E019B,0xEAE10678,0x264B06E6 }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief precomputed lookup values for crc32c 8 bytes-at-a-time calculation
+///
+/// the tables are generated by TRI_InitialiseHashes
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t Crc32CLookup[8][256];
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C implementation used by TRI_BlockCrc32C
+///
+/// this is the software implementation by default. TRI_InitialiseHashes
+/// switches to the SSE4.2 implementation if the CPU supports it
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t (*BlockCrc32C) (uint32_t, char const*, size_t) = nullptr;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -446,6 +472,155 @@ static void GenerateCrc32Polynomial (void) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generates the CRC32C lookup tables
+///
+/// Crc32CLookup[0] is the byte-wise table for the reflected Castagnoli
+/// polynomial, the other tables are derived from it in the same way as the
+/// ones in Crc32Lookup
+////////////////////////////////////////////////////////////////////////////////
+
+static void GenerateCrc32CLookup (void) {
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t value = i;
+
+    for (int j = 0; j < 8; ++j) {
+      value = (value >> 1) ^ ((value & 1) ? 0x82F63B78 : 0);
+    }
+
+    Crc32CLookup[0][i] = value;
+  }
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    for (int k = 1; k < 8; ++k) {
+      uint32_t previous = Crc32CLookup[k - 1][i];
+      Crc32CLookup[k][i] = (previous >> 8) ^ Crc32CLookup[0][previous & 0xFF];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, software implementation
+///
+/// same slicing-by-8 algorithm as TRI_BlockCrc32, but with the CRC32C tables
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_SoftwareBlockCrc32C (uint32_t value, char const* data, size_t length) {
+  uint32_t* current = (uint32_t*) data;
+  uint8_t* currentChar;
+
+  // process eight bytes at once
+  while (length >= 8) {
+    uint32_t one = *current++ ^ value;
+    uint32_t two = *current++;
+
+    value = Crc32CLookup[0][(two>>24) & 0xFF] ^
+            Crc32CLookup[1][(two>>16) & 0xFF] ^
+            Crc32CLookup[2][(two>> 8) & 0xFF] ^
+            Crc32CLookup[3][ two      & 0xFF] ^
+            Crc32CLookup[4][(one>>24) & 0xFF] ^
+            Crc32CLookup[5][(one>>16) & 0xFF] ^
+            Crc32CLookup[6][(one>> 8) & 0xFF] ^
+            Crc32CLookup[7][ one      & 0xFF];
+    length -= 8;
+  }
+
+  currentChar = (uint8_t*) current;
+  // remaining 1 to 7 bytes (standard CRC table-based algorithm)
+  while (length--) {
+    value = (value >> 8) ^ Crc32CLookup[0][(value & 0xFF) ^ *currentChar++];
+  }
+
+  return value;
+}
+
+#ifdef TRI_HAVE_HARDWARE_CRC32C
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the CPU supports the SSE4.2 crc32 instruction
+////////////////////////////////////////////////////////////////////////////////
+
+static bool HasHardwareCrc32C (void) {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 1);
+
+  return (info[2] & (1 << 20)) != 0;
+#else
+  unsigned int eax, ebx, ecx, edx;
+
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+
+  return (ecx & bit_SSE4_2) != 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C of a single byte, using the SSE4.2 crc32 instruction
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t HardwareCrc32CByte (uint32_t value, uint8_t data) {
+#ifdef _MSC_VER
+  return _mm_crc32_u8(value, data);
+#else
+  __asm__ ("crc32b %1, %0" : "+r" (value) : "rm" (data));
+  return value;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C of eight bytes, using the SSE4.2 crc32 instruction
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint64_t HardwareCrc32CWord (uint64_t value, uint64_t data) {
+#ifdef _MSC_VER
+  return _mm_crc32_u64(value, data);
+#else
+  __asm__ ("crc32q %1, %0" : "+r" (value) : "rm" (data));
+  return value;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, SSE4.2 implementation
+///
+/// processes single bytes until the data is 8-byte aligned, and then eight
+/// bytes per instruction
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t HardwareBlockCrc32C (uint32_t value, char const* data, size_t length) {
+  uint8_t const* current = (uint8_t const*) data;
+
+  while (length > 0 && (((uintptr_t) current) & 7) != 0) {
+    value = HardwareCrc32CByte(value, *current++);
+    --length;
+  }
+
+  uint64_t value64 = value;
+
+  while (length >= 8) {
+    uint64_t word;
+    memcpy(&word, current, sizeof(uint64_t));
+
+    value64 = HardwareCrc32CWord(value64, word);
+    current += 8;
+    length -= 8;
+  }
+
+  value = (uint32_t) value64;
+
+  while (length > 0) {
+    value = HardwareCrc32CByte(value, *current++);
+    --length;
+  }
+
+  return value;
+}
+
+#endif
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  public functions
 // -----------------------------------------------------------------------------
@@ -505,6 +680,28 @@ uint32_t TRI_BlockCrc32 (uint32_t value, char const* data, size_t length) {
   return value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32C (uint32_t value, char const* data, size_t length) {
+  TRI_ASSERT(BlockCrc32C != nullptr);
+
+  return BlockCrc32C(value, data, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether TRI_BlockCrc32C uses the SSE4.2 crc32 instruction
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HasHardwareCrc32C () {
+#ifdef TRI_HAVE_HARDWARE_CRC32C
+  return HasHardwareCrc32C();
+#else
+  return false;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief CRC32 value of data block ended by 0
 ////////////////////////////////////////////////////////////////////////////////
@@ -594,6 +791,15 @@ void TRI_InitialiseHashes () {
   }
 
   GenerateCrc32Polynomial();
+  GenerateCrc32CLookup();
+
+  BlockCrc32C = &TRI_SoftwareBlockCrc32C;
+
+#ifdef TRI_HAVE_HARDWARE_CRC32C
+  if (HasHardwareCrc32C()) {
+    BlockCrc32C = &HardwareBlockCrc32C;
+  }
+#endif
 
   Initialised = true;
 }
@@ -96,6 +96,32 @@ uint32_t TRI_FinalCrc32 (uint32_t);
 
 uint32_t TRI_BlockCrc32 (uint32_t, char const* data, size_t length);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block
+///
+/// computes the CRC32C (Castagnoli) checksum, using the SSE4.2 crc32
+/// instruction if the CPU supports it. Note that the result differs from
+/// the one of TRI_BlockCrc32. TRI_InitialCrc32 and TRI_FinalCrc32 are used
+/// to start and finish the calculation
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32C (uint32_t, char const* data, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, software implementation
+///
+/// this is the implementation TRI_BlockCrc32C falls back to if the CPU does
+/// not support SSE4.2. it is only exposed to test it on all CPUs
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_SoftwareBlockCrc32C (uint32_t, char const* data, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether TRI_BlockCrc32C uses the SSE4.2 crc32 instruction
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HasHardwareCrc32C (void);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief CRC32 value of data block ended by 0
 ////////////////////////////////////////////////////////////////////////////////
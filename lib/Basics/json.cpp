@@ -600,6 +600,44 @@ size_t TRI_LengthVectorJson (TRI_json_t const* json) {
   return TRI_LengthVector(&json->_value._objects);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimates the number of bytes occupied by a json value and all of
+/// its sub-values
+/// string references are not counted because they do not own their data
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_MemoryUsageJson (TRI_json_t const* json) {
+  if (json == nullptr) {
+    return 0;
+  }
+
+  size_t total = sizeof(TRI_json_t);
+
+  switch (json->_type) {
+    case TRI_JSON_STRING:
+      total += json->_value._string.length;
+      break;
+
+    case TRI_JSON_ARRAY:
+    case TRI_JSON_OBJECT: {
+      size_t const n = TRI_LengthVector(&json->_value._objects);
+
+      for (size_t i = 0; i < n; ++i) {
+        auto sub = static_cast<TRI_json_t const*>(TRI_AddressVector(&json->_value._objects, i));
+        // sub-values are stored inline in the vector, so their own
+        // sizeof(TRI_json_t) accounts for the vector slot
+        total += TRI_MemoryUsageJson(sub);
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  return total;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief determines whether the JSON passed is of type string
 ////////////////////////////////////////////////////////////////////////////////
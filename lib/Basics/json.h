@@ -216,6 +216,13 @@ size_t TRI_LengthArrayJson (TRI_json_t const*);
 
 size_t TRI_LengthVectorJson (TRI_json_t const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimates the number of bytes occupied by a json value and all of
+/// its sub-values
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_MemoryUsageJson (TRI_json_t const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief determines whether the JSON passed is of type object
 ////////////////////////////////////////////////////////////////////////////////
@@ -66,6 +66,9 @@
 ///   the user.
 /// - 27: @LIT{file exists}
 ///   Will be raised when a file already exists.
+/// - 28: @LIT{resource limit exceeded}
+///   Will be raised when the resources used by an operation exceed the
+///   configured maximum value.
 /// - 400: @LIT{bad parameter}
 ///   Will be raised when the HTTP request does not fulfill the requirements.
 /// - 401: @LIT{unauthorized}
@@ -951,6 +954,17 @@ void TRI_InitialiseErrorMessages ();
 
 #define TRI_ERROR_FILE_EXISTS                                             (27)
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief 28: ERROR_RESOURCE_LIMIT
+///
+/// resource limit exceeded
+///
+/// Will be raised when the resources used by an operation exceed the
+/// configured maximum value.
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_ERROR_RESOURCE_LIMIT                                          (28)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief 400: ERROR_HTTP_BAD_PARAMETER
 ///
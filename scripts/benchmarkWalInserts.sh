@@ -0,0 +1,38 @@
+#!/bin/bash
+# Measures document inserts per second against a running server for an
+# increasing number of client threads. All arguments are passed on to arangob,
+# e.g. --server.endpoint tcp://127.0.0.1:8529 --server.password ""
+#
+# THREADS and REQUESTS can be set in the environment to change the thread
+# counts and the number of inserts per run.
+
+if [ ! -d arangod ] || [ ! -d arangosh ] || [ ! -d UnitTests ] ; then
+    echo Must be started in the main ArangoDB source directory.
+    exit 1
+fi
+
+if [ "$THREADS" == "" ] ; then
+    THREADS="1 2 4 8 16 32"
+fi
+if [ "$REQUESTS" == "" ] ; then
+    REQUESTS=200000
+fi
+
+printf "%8s %14s\n" threads "inserts/s"
+
+for t in $THREADS ; do
+    rate=`bin/arangob --test-case document \
+                      --complexity 1 \
+                      --requests $REQUESTS \
+                      --concurrency $t \
+                      --keep-alive true \
+                      --collection BenchmarkWalInserts \
+                      "$@" 2>/dev/null | grep "Operations per second rate" | sed 's/.*: //'`
+
+    if [ "$rate" == "" ] ; then
+        echo "arangob failed for $t threads"
+        exit 1
+    fi
+
+    printf "%8d %14.0f\n" $t $rate
+done
@@ -32,3 +32,13 @@ test -f ${PREFIX}.hpp || exit 1
 test -f ${PREFIX}.cpp || exit 1
 
 cp ${PREFIX}.hpp ${PREFIX}.h
+
+#############################################################################
+## newer versions of bison include the generated header file in the parser,
+## but only the .h file is kept
+#############################################################################
+
+BASENAME=`basename ${PREFIX}`
+
+sed -e "s:#include \"${BASENAME}\.hpp\":#include \"${BASENAME}.h\":" ${PREFIX}.cpp > ${PREFIX}.cpp.tmp || exit 1
+mv ${PREFIX}.cpp.tmp ${PREFIX}.cpp